@@ -106,10 +106,57 @@ typedef bool (*scc_nearest_neighbor_search) (iscc_NNSearchObject*,
 typedef bool (*scc_close_nn_search_object) (iscc_NNSearchObject**);
 
 
+// =============================================================================
+// Distance function table
+// =============================================================================
+
+/** Distance search functions of a custom data set.
+ *
+ *  All members must be set. The functions are called with the context
+ *  supplied to #scc_init_custom_data_set as their data set argument.
+ */
+typedef struct scc_DistFunctions {
+	scc_check_data_set check_data_set;
+	scc_num_data_points num_data_points;
+	scc_get_dist_matrix get_dist_matrix;
+	scc_get_dist_rows get_dist_rows;
+	scc_init_max_dist_object init_max_dist_object;
+	scc_get_max_dist get_max_dist;
+	scc_close_max_dist_object close_max_dist_object;
+	scc_init_nn_search_object init_nn_search_object;
+	scc_nearest_neighbor_search nearest_neighbor_search;
+	scc_close_nn_search_object close_nn_search_object;
+} scc_DistFunctions;
+
+
 // =============================================================================
 // SPI functions
 // =============================================================================
 
+/** Creates a data set that uses custom distance search functions.
+ *
+ *  The function table is copied into the data set, and `dist_context` is passed to the
+ *  functions in place of a data set. Unlike #scc_set_dist_functions, this changes no
+ *  global state, so clustering functions can be called concurrently on data sets with
+ *  different distance functions.
+ *
+ *  \param[in] dist_functions the distance search functions.
+ *  \param[in] dist_context the context passed to the functions. It is not freed by scclust.
+ *  \param[out] out_data_set a #scc_DataSet object to be freed with #scc_free_data_set.
+ *
+ *  \return #SCC_ER_OK if the data set was successfully created, otherwise an error code.
+ *
+ *  \note
+ *  Functions attached to a data set take precedence over functions set with
+ *  #scc_set_dist_functions, which only apply to other data sets. If the `check_data_set`
+ *  function has been replaced with #scc_set_dist_functions, data sets might not be
+ *  #scc_DataSet objects, and all data sets use the replaced functions instead.
+ */
+scc_ErrorCode scc_init_custom_data_set(const scc_DistFunctions* dist_functions,
+                                       void* dist_context,
+                                       scc_DataSet** out_data_set);
+
+
 bool scc_reset_dist_functions(void);
 
 
@@ -0,0 +1,173 @@
+/* =============================================================================
+ * scclust -- A C library for size-constrained clustering
+ * https://github.com/fsavje/scclust
+ *
+ * Copyright (C) 2015-2017  Fredrik Savje -- http://fredriksavje.com
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see http://www.gnu.org/licenses/
+ * ========================================================================== */
+
+#ifndef SCC_BITSET_HG
+#define SCC_BITSET_HG
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+
+// =============================================================================
+// Types & macros
+// =============================================================================
+
+/* Word-packed bit arrays used for vertex and data point marks.
+ *
+ * A bitset with `num_bits` bits is an array of `iscc_bitset_num_words(num_bits)` words
+ * where bit `i` is bit `i % ISCC_BITSET_WORD_BITS` of word `i / ISCC_BITSET_WORD_BITS`.
+ * The bits past `num_bits` in the last word must be zero; `iscc_bitset_next_set` and
+ * `iscc_bitset_count` rely on it.
+ *
+ * Bits in the same word cannot be written concurrently from different threads.
+ */
+typedef uint64_t iscc_BitsetWord;
+
+#define ISCC_BITSET_WORD_BITS 64
+
+
+// =============================================================================
+// Inline functions
+// =============================================================================
+
+static inline size_t iscc_bitset_num_words(const size_t num_bits)
+{
+	return (num_bits + ISCC_BITSET_WORD_BITS - 1) / ISCC_BITSET_WORD_BITS;
+}
+
+
+// Allocates a bitset with all bits cleared. Returns NULL if allocation fails.
+static inline iscc_BitsetWord* iscc_bitset_alloc(const size_t num_bits)
+{
+	const size_t num_words = iscc_bitset_num_words(num_bits);
+	return calloc((num_words > 0) ? num_words : 1, sizeof(iscc_BitsetWord));
+}
+
+
+static inline bool iscc_bitset_test(const iscc_BitsetWord bitset[const],
+                                    const size_t i)
+{
+	return (bitset[i / ISCC_BITSET_WORD_BITS] >> (i % ISCC_BITSET_WORD_BITS)) & 1u;
+}
+
+
+static inline void iscc_bitset_set(iscc_BitsetWord bitset[const],
+                                   const size_t i)
+{
+	bitset[i / ISCC_BITSET_WORD_BITS] |= (UINT64_C(1) << (i % ISCC_BITSET_WORD_BITS));
+}
+
+
+static inline void iscc_bitset_clear(iscc_BitsetWord bitset[const],
+                                     const size_t i)
+{
+	bitset[i / ISCC_BITSET_WORD_BITS] &= ~(UINT64_C(1) << (i % ISCC_BITSET_WORD_BITS));
+}
+
+
+static inline void iscc_bitset_assign(iscc_BitsetWord bitset[const],
+                                      const size_t i,
+                                      const bool value)
+{
+	const iscc_BitsetWord mask = UINT64_C(1) << (i % ISCC_BITSET_WORD_BITS);
+	const iscc_BitsetWord value_mask = (iscc_BitsetWord) 0 - (iscc_BitsetWord) value;
+	iscc_BitsetWord* const word = bitset + i / ISCC_BITSET_WORD_BITS;
+	*word = (*word & ~mask) | (value_mask & mask);
+}
+
+
+// Number of trailing zeros in a non-zero word
+static inline size_t iscc_bitset_ctz(iscc_BitsetWord word)
+{
+	assert(word != 0);
+	#if defined(__GNUC__) || defined(__clang__)
+		return (size_t) __builtin_ctzll(word);
+	#else
+		size_t count = 0;
+		for (; (word & 1u) == 0; word >>= 1) ++count;
+		return count;
+	#endif
+}
+
+
+static inline size_t iscc_bitset_popcount(iscc_BitsetWord word)
+{
+	#if defined(__GNUC__) || defined(__clang__)
+		return (size_t) __builtin_popcountll(word);
+	#else
+		size_t count = 0;
+		for (; word != 0; word &= word - 1) ++count;
+		return count;
+	#endif
+}
+
+
+// Number of set bits
+static inline size_t iscc_bitset_count(const iscc_BitsetWord bitset[const],
+                                       const size_t num_bits)
+{
+	size_t count = 0;
+	const size_t num_words = iscc_bitset_num_words(num_bits);
+	for (size_t w = 0; w < num_words; ++w) {
+		count += iscc_bitset_popcount(bitset[w]);
+	}
+	return count;
+}
+
+
+// First set bit at or after `from`, or `num_bits` if there is none
+static inline size_t iscc_bitset_next_set(const iscc_BitsetWord bitset[const],
+                                          const size_t num_bits,
+                                          const size_t from)
+{
+	if (from >= num_bits) return num_bits;
+	const size_t num_words = iscc_bitset_num_words(num_bits);
+	size_t w = from / ISCC_BITSET_WORD_BITS;
+	iscc_BitsetWord word = bitset[w] & (~UINT64_C(0) << (from % ISCC_BITSET_WORD_BITS));
+	while (word == 0) {
+		if (++w == num_words) return num_bits;
+		word = bitset[w];
+	}
+	return w * ISCC_BITSET_WORD_BITS + iscc_bitset_ctz(word);
+}
+
+
+// First cleared bit at or after `from`, or `num_bits` if there is none
+static inline size_t iscc_bitset_next_clear(const iscc_BitsetWord bitset[const],
+                                            const size_t num_bits,
+                                            const size_t from)
+{
+	if (from >= num_bits) return num_bits;
+	const size_t num_words = iscc_bitset_num_words(num_bits);
+	size_t w = from / ISCC_BITSET_WORD_BITS;
+	iscc_BitsetWord word = ~bitset[w] & (~UINT64_C(0) << (from % ISCC_BITSET_WORD_BITS));
+	while (word == 0) {
+		if (++w == num_words) return num_bits;
+		word = ~bitset[w];
+	}
+	const size_t next = w * ISCC_BITSET_WORD_BITS + iscc_bitset_ctz(word);
+	return (next < num_bits) ? next : num_bits;
+}
+
+
+#endif // ifndef SCC_BITSET_HG
@@ -0,0 +1,81 @@
+/* =============================================================================
+ * scclust -- A C library for size-constrained clustering
+ * https://github.com/fsavje/scclust
+ *
+ * Copyright (C) 2015-2017  Fredrik Savje -- http://fredriksavje.com
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see http://www.gnu.org/licenses/
+ * ========================================================================== */
+
+#ifndef SCC_CLUSTER_TREE_STRUCT_HG
+#define SCC_CLUSTER_TREE_STRUCT_HG
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "../include/scclust.h"
+
+
+// =============================================================================
+// Macros, structs and variables
+// =============================================================================
+
+/// Macro for internal cluster tree checks.
+#define iscc_check_cluster_tree(tree) scc_is_initialized_cluster_tree(tree)
+
+
+/** Cluster tree struct.
+ *
+ *  This struct describes the splits made by #scc_hierarchical_clustering_tree. The nodes are
+ *  clusters, and the members of node `i` are `pointindex_store[node_first[i]]` to
+ *  `pointindex_store[node_first[i] + node_size[i] - 1]`. The first #num_roots nodes are the
+ *  clusters the splitting started from. When a node is split, its two children are given the
+ *  next two node indices, so the nodes are ordered by the split that made them. The children
+ *  partition the parent's members, with the first child holding the lower positions.
+ */
+struct scc_ClusterTree {
+	/// Version of the struct.
+	int32_t cluster_tree_version;
+
+	/// Number of data points in the clustering problem.
+	size_t num_data_points;
+
+	/// Size constraint the tree was built with.
+	uint32_t size_constraint;
+
+	/// Number of root nodes.
+	size_t num_roots;
+
+	/// Number of nodes.
+	size_t num_nodes;
+
+	/// Array of length #num_nodes with the position of the nodes' first member in #pointindex_store.
+	size_t* node_first;
+
+	/// Array of length #num_nodes with the nodes' sizes.
+	size_t* node_size;
+
+	/// Array of length #num_nodes with the index of the nodes' first child. Unsplit nodes have zero.
+	size_t* node_child;
+
+	/// Array of length #num_data_points with the members of the nodes.
+	scc_PointIndex* pointindex_store;
+};
+
+
+/// Current version of the cluster tree struct.
+static const int32_t ISCC_CLUSTER_TREE_STRUCT_VERSION = 722591001;
+
+
+#endif // ifndef SCC_CLUSTER_TREE_STRUCT_HG
@@ -19,6 +19,7 @@
  * ========================================================================== */
 
 #include "../include/scclust.h"
+#include "../include/scclust_spi.h"
 
 #include <assert.h>
 #include <stdbool.h>
@@ -31,6 +32,32 @@
 #include "scclust_types.h"
 
 
+// =============================================================================
+// Internal structs
+// =============================================================================
+
+typedef struct iscc_BlockVariance iscc_BlockVariance;
+struct iscc_BlockVariance {
+	double variance;
+	uint_fast16_t block;
+};
+
+
+// =============================================================================
+// Static function prototypes
+// =============================================================================
+
+static scc_ErrorCode iscc_init_data_set(uint64_t num_data_points,
+                                        uint32_t num_dimensions,
+                                        size_t len_data_matrix,
+                                        const double data_matrix[],
+                                        const float data_matrix_f32[],
+                                        scc_DataSet** out_data_set);
+
+static int iscc_compare_block_variance(const void* a,
+                                       const void* b);
+
+
 // =============================================================================
 // Public function implementations
 // =============================================================================
@@ -41,6 +68,170 @@ scc_ErrorCode scc_init_data_set(const uint64_t num_data_points,
                                 const double data_matrix[const],
                                 scc_DataSet** const out_data_set)
 {
+	return iscc_init_data_set(num_data_points,
+	                          num_dimensions,
+	                          len_data_matrix,
+	                          data_matrix,
+	                          NULL,
+	                          out_data_set);
+}
+
+
+scc_ErrorCode scc_init_data_set_f32(const uint64_t num_data_points,
+                                    const uint32_t num_dimensions,
+                                    const size_t len_data_matrix,
+                                    const float data_matrix[const],
+                                    scc_DataSet** const out_data_set)
+{
+	return iscc_init_data_set(num_data_points,
+	                          num_dimensions,
+	                          len_data_matrix,
+	                          NULL,
+	                          data_matrix,
+	                          out_data_set);
+}
+
+
+scc_ErrorCode scc_init_custom_data_set(const scc_DistFunctions* const dist_functions,
+                                       void* const dist_context,
+                                       scc_DataSet** const out_data_set)
+{
+	if (out_data_set == NULL) {
+		return iscc_make_error_msg(SCC_ER_INVALID_INPUT, "Output parameter may not be NULL.");
+	}
+	*out_data_set = NULL;
+
+	if ((dist_functions == NULL) ||
+			(dist_functions->check_data_set == NULL) ||
+			(dist_functions->num_data_points == NULL) ||
+			(dist_functions->get_dist_matrix == NULL) ||
+			(dist_functions->get_dist_rows == NULL) ||
+			(dist_functions->init_max_dist_object == NULL) ||
+			(dist_functions->get_max_dist == NULL) ||
+			(dist_functions->close_max_dist_object == NULL) ||
+			(dist_functions->init_nn_search_object == NULL) ||
+			(dist_functions->nearest_neighbor_search == NULL) ||
+			(dist_functions->close_nn_search_object == NULL)) {
+		return iscc_make_error_msg(SCC_ER_INVALID_INPUT, "Invalid distance functions.");
+	}
+
+	scc_DataSet* tmp_dso = malloc(sizeof(scc_DataSet));
+	if (tmp_dso == NULL) return iscc_make_error(SCC_ER_NO_MEMORY);
+
+	*tmp_dso = (scc_DataSet) {
+		.data_set_version = ISCC_DATASET_STRUCT_VERSION,
+		.num_data_points = 0,
+		.num_dimensions = 0,
+		.data_matrix = NULL,
+		.data_matrix_f32 = NULL,
+		.sq_norms = NULL,
+		.dist_functions = malloc(sizeof(scc_DistFunctions)),
+		.dist_context = dist_context,
+	};
+
+	if (tmp_dso->dist_functions == NULL) {
+		free(tmp_dso);
+		return iscc_make_error(SCC_ER_NO_MEMORY);
+	}
+	*(tmp_dso->dist_functions) = *dist_functions;
+
+	*out_data_set = tmp_dso;
+
+	return iscc_no_error();
+}
+
+
+void scc_free_data_set(scc_DataSet** const data_set)
+{
+	if ((data_set != NULL) && (*data_set != NULL)) {
+		free((*data_set)->sq_norms);
+		free((*data_set)->dist_functions);
+		free(*data_set);
+		*data_set = NULL;
+	}
+}
+
+
+bool scc_is_initialized_data_set(const scc_DataSet* const data_set)
+{
+	if (data_set == NULL) return false;
+	if (data_set->data_set_version != ISCC_DATASET_STRUCT_VERSION) return false;
+	if (data_set->dist_functions != NULL) return true;
+	if (data_set->num_data_points == 0) return false;
+	if (data_set->num_dimensions == 0) return false;
+	if ((data_set->data_matrix == NULL) == (data_set->data_matrix_f32 == NULL)) return false;
+	return true;
+}
+
+
+// =============================================================================
+// External function implementations
+// =============================================================================
+
+uint_fast16_t* iscc_make_block_order(const scc_DataSet* const data_set,
+                                     const size_t len_point_indices,
+                                     const scc_PointIndex point_indices[const])
+{
+	assert(data_set->num_dimensions >= ISCC_DATASET_BLOCK_ORDER_MIN_DIMENSIONS);
+	assert(len_point_indices > 0);
+	const uint_fast16_t num_dimensions = data_set->num_dimensions;
+	const uint_fast16_t num_blocks = (uint_fast16_t) ((num_dimensions + ISCC_DATASET_DIMENSION_BLOCK - 1) / ISCC_DATASET_DIMENSION_BLOCK);
+
+	uint_fast16_t* const block_order = malloc(sizeof(uint_fast16_t[num_blocks]));
+	double* const means = calloc(num_dimensions, sizeof(double));
+	iscc_BlockVariance* const variances = calloc(num_blocks, sizeof(iscc_BlockVariance));
+	if ((block_order == NULL) || (means == NULL) || (variances == NULL)) {
+		free(block_order);
+		free(means);
+		free(variances);
+		return NULL;
+	}
+
+	for (size_t i = 0; i < len_point_indices; ++i) {
+		const size_t point = (point_indices == NULL) ? i : (size_t) point_indices[i];
+		for (uint_fast16_t d = 0; d < num_dimensions; ++d) {
+			means[d] += iscc_data_set_coord(data_set, point, d);
+		}
+	}
+	for (uint_fast16_t d = 0; d < num_dimensions; ++d) {
+		means[d] /= (double) len_point_indices;
+	}
+	for (uint_fast16_t b = 0; b < num_blocks; ++b) {
+		variances[b].block = b;
+	}
+	for (size_t i = 0; i < len_point_indices; ++i) {
+		const size_t point = (point_indices == NULL) ? i : (size_t) point_indices[i];
+		for (uint_fast16_t d = 0; d < num_dimensions; ++d) {
+			const double deviation = iscc_data_set_coord(data_set, point, d) - means[d];
+			variances[d / ISCC_DATASET_DIMENSION_BLOCK].variance += deviation * deviation;
+		}
+	}
+
+	qsort(variances, num_blocks, sizeof(iscc_BlockVariance), iscc_compare_block_variance);
+	for (uint_fast16_t b = 0; b < num_blocks; ++b) {
+		block_order[b] = variances[b].block;
+	}
+
+	free(means);
+	free(variances);
+
+	return block_order;
+}
+
+
+// =============================================================================
+// Static function implementations
+// =============================================================================
+
+static scc_ErrorCode iscc_init_data_set(const uint64_t num_data_points,
+                                        const uint32_t num_dimensions,
+                                        const size_t len_data_matrix,
+                                        const double data_matrix[const],
+                                        const float data_matrix_f32[const],
+                                        scc_DataSet** const out_data_set)
+{
+	assert((data_matrix == NULL) || (data_matrix_f32 == NULL));
+
 	if (out_data_set == NULL) {
 		return iscc_make_error_msg(SCC_ER_INVALID_INPUT, "Output parameter may not be NULL.");
 	}
@@ -66,7 +257,7 @@ scc_ErrorCode scc_init_data_set(const uint64_t num_data_points,
 	if (len_data_matrix < num_data_points * num_dimensions) {
 		return iscc_make_error_msg(SCC_ER_INVALID_INPUT, "Invalid data matrix.");
 	}
-	if (data_matrix == NULL) {
+	if ((data_matrix == NULL) && (data_matrix_f32 == NULL)) {
 		return iscc_make_error_msg(SCC_ER_INVALID_INPUT, "Invalid data matrix.");
 	}
 
@@ -78,29 +269,41 @@ scc_ErrorCode scc_init_data_set(const uint64_t num_data_points,
 		.num_data_points = (size_t) num_data_points,
 		.num_dimensions = (uint_fast16_t) num_dimensions,
 		.data_matrix = data_matrix,
+		.data_matrix_f32 = data_matrix_f32,
+		.sq_norms = NULL,
+		.dist_functions = NULL,
+		.dist_context = NULL,
 	};
 
+	if (num_dimensions >= ISCC_DATASET_SQ_NORMS_MIN_DIMENSIONS) {
+		tmp_dso->sq_norms = malloc(sizeof(double[tmp_dso->num_data_points]));
+		if (tmp_dso->sq_norms == NULL) {
+			free(tmp_dso);
+			return iscc_make_error(SCC_ER_NO_MEMORY);
+		}
+		for (size_t i = 0; i < tmp_dso->num_data_points; ++i) {
+			double sq_norm = 0.0;
+			for (uint_fast16_t d = 0; d < tmp_dso->num_dimensions; ++d) {
+				const double value = iscc_data_set_coord(tmp_dso, i, d);
+				sq_norm += value * value;
+			}
+			tmp_dso->sq_norms[i] = sq_norm;
+		}
+	}
+
 	*out_data_set = tmp_dso;
 
 	return iscc_no_error();
 }
 
 
-void scc_free_data_set(scc_DataSet** const data_set)
+// Decreasing variance, ties by block index
+static int iscc_compare_block_variance(const void* const a,
+                                       const void* const b)
 {
-	if ((data_set != NULL) && (*data_set != NULL)) {
-		free(*data_set);
-		*data_set = NULL;
-	}
-}
-
-
-bool scc_is_initialized_data_set(const scc_DataSet* const data_set)
-{
-	if (data_set == NULL) return false;
-	if (data_set->data_set_version != ISCC_DATASET_STRUCT_VERSION) return false;
-	if (data_set->num_data_points == 0) return false;
-	if (data_set->num_dimensions == 0) return false;
-	if (data_set->data_matrix == NULL) return false;
-	return true;
+	const iscc_BlockVariance* const block_a = (const iscc_BlockVariance*) a;
+	const iscc_BlockVariance* const block_b = (const iscc_BlockVariance*) b;
+	if (block_a->variance > block_b->variance) return -1;
+	if (block_a->variance < block_b->variance) return 1;
+	return (block_a->block > block_b->block) - (block_a->block < block_b->block);
 }
@@ -25,6 +25,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "../include/scclust.h"
+#include "../include/scclust_spi.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -39,13 +40,50 @@ struct scc_DataSet {
 	int32_t data_set_version;
 	size_t num_data_points;
 	uint_fast16_t num_dimensions;
+	// Exactly one of `data_matrix` and `data_matrix_f32` is set for built-in data sets
 	const double* data_matrix;
+	const float* data_matrix_f32;
+	double* sq_norms;
+	// Set for data sets made by `scc_init_custom_data_set`, which hold no data matrix
+	scc_DistFunctions* dist_functions;
+	void* dist_context;
 };
 
 
 static const int32_t ISCC_DATASET_STRUCT_VERSION = 722328001;
 
 
+// Squared norms of the data points are cached for data sets with
+// at least this many dimensions; `sq_norms` is NULL otherwise.
+#define ISCC_DATASET_SQ_NORMS_MIN_DIMENSIONS 16
+
+// Dimensions are split into consecutive blocks of this size (the last block
+// may be shorter). Brute-force searches in data sets with at least two blocks
+// visit the blocks by decreasing total variance (see `iscc_make_block_order`),
+// so that the running sum grows quickly and far-away points are rejected early.
+#define ISCC_DATASET_DIMENSION_BLOCK 16
+#define ISCC_DATASET_BLOCK_ORDER_MIN_DIMENSIONS (2 * ISCC_DATASET_DIMENSION_BLOCK)
+
+
+// Orders the blocks of dimensions by decreasing total variance among the points in
+// `point_indices` (all points if NULL). The data set must have at least
+// `ISCC_DATASET_BLOCK_ORDER_MIN_DIMENSIONS` dimensions. Returns an array with one
+// entry per block, to be freed with `free`, or NULL if memory could not be allocated.
+uint_fast16_t* iscc_make_block_order(const scc_DataSet* data_set,
+                                     size_t len_point_indices,
+                                     const scc_PointIndex point_indices[]);
+
+
+static inline double iscc_data_set_coord(const scc_DataSet* const data_set,
+                                         const size_t point,
+                                         const uint_fast16_t dimension)
+{
+	const size_t index = point * data_set->num_dimensions + dimension;
+	if (data_set->data_matrix_f32 != NULL) return (double) data_set->data_matrix_f32[index];
+	return data_set->data_matrix[index];
+}
+
+
 #ifdef __cplusplus
 }
 #endif
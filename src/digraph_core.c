@@ -30,6 +30,28 @@
 #include "scclust_types.h"
 
 
+// =============================================================================
+// Static function prototypes
+// =============================================================================
+
+static bool iscc_compressed_digraph_is_valid(const iscc_Digraph* dg);
+
+
+static size_t iscc_varint_length(uint64_t value);
+
+
+static uint8_t* iscc_varint_write(uint8_t* pos,
+                                  uint64_t value);
+
+
+static void iscc_sort_row(scc_PointIndex* row,
+                          size_t len_row);
+
+
+static int iscc_compare_heads(const void* a,
+                              const void* b);
+
+
 // =============================================================================
 // External function implementations
 // =============================================================================
@@ -39,6 +61,11 @@ void iscc_free_digraph(iscc_Digraph* const dg)
 	if (dg != NULL) {
 		free(dg->head);
 		free(dg->tail_ptr);
+		free(dg->segment_ptr);
+		free(dg->valid_tails);
+		free(dg->tail_rank);
+		free(dg->packed_rows);
+		free(dg->packed_ptr);
 		*dg = ISCC_NULL_DIGRAPH;
 	}
 }
@@ -46,8 +73,24 @@ void iscc_free_digraph(iscc_Digraph* const dg)
 
 bool iscc_digraph_is_initialized(const iscc_Digraph* const dg)
 {
-	if ((dg == NULL) || (dg->tail_ptr == NULL)) return false;
-	if ((dg->vertices > ISCC_POINTINDEX_MAX) || (dg->max_arcs > ISCC_ARCINDEX_MAX)) return false;
+	if (dg == NULL) return false;
+	if ((dg->packed_rows == NULL) != (dg->packed_ptr == NULL)) return false;
+	if (dg->packed_rows != NULL) {
+		if ((dg->head != NULL) || (dg->tail_ptr != NULL) || (dg->segment_ptr != NULL)) return false;
+		if ((dg->fixed_degree > 0) || (dg->valid_tails != NULL) || (dg->tail_rank != NULL)) return false;
+		if (dg->vertices > ISCC_POINTINDEX_MAX) return false;
+		return true;
+	}
+	if (dg->max_out_degree > 0) return false;
+	if (dg->fixed_degree > 0) {
+		if ((dg->tail_ptr != NULL) || (dg->segment_ptr != NULL)) return false;
+		if ((dg->valid_tails == NULL) != (dg->tail_rank == NULL)) return false;
+	} else {
+		if (dg->tail_ptr == NULL) return false;
+		if ((dg->max_arcs > ISCC_ARCINDEX_MAX) && (dg->segment_ptr == NULL)) return false;
+		if ((dg->valid_tails != NULL) || (dg->tail_rank != NULL)) return false;
+	}
+	if (dg->vertices > ISCC_POINTINDEX_MAX) return false;
 	if ((dg->max_arcs == 0) && (dg->head != NULL)) return false;
 	if ((dg->max_arcs > 0) && (dg->head == NULL)) return false;
 	return true;
@@ -57,15 +100,37 @@ bool iscc_digraph_is_initialized(const iscc_Digraph* const dg)
 bool iscc_digraph_is_valid(const iscc_Digraph* const dg)
 {
 	if (!iscc_digraph_is_initialized(dg)) return false;
-	if (dg->tail_ptr[0] != 0) return false;
-	if (dg->tail_ptr[dg->vertices] > dg->max_arcs) return false;
-	for (size_t i = 0; i < dg->vertices; ++i) {
-		if (dg->tail_ptr[i] > dg->tail_ptr[i + 1]) return false;
+	if (iscc_digraph_is_compressed(dg)) return iscc_compressed_digraph_is_valid(dg);
+	if (iscc_digraph_is_fixed(dg)) {
+		if (dg->valid_tails != NULL) {
+			const size_t num_words = iscc_bitset_num_words(dg->vertices + 1);
+			if (iscc_bitset_test(dg->valid_tails, dg->vertices)) return false;
+			if (dg->tail_rank[0] != 0) return false;
+			for (size_t w = 1; w < num_words; ++w) {
+				if ((size_t) dg->tail_rank[w] != (size_t) dg->tail_rank[w - 1] + iscc_bitset_popcount(dg->valid_tails[w - 1])) return false;
+			}
+		}
+	} else {
+		if (dg->tail_ptr[0] != 0) return false;
+		if (dg->segment_ptr != NULL) {
+			for (size_t s = 0; s <= dg->vertices / ISCC_DIGRAPH_SEGMENT_ROWS; ++s) {
+				if ((iscc_ArcIndex) dg->segment_ptr[s] != dg->tail_ptr[s * ISCC_DIGRAPH_SEGMENT_ROWS]) return false;
+			}
+			if (dg->segment_ptr[0] != 0) return false;
+		}
+		for (size_t i = 0; i < dg->vertices; ++i) {
+			const size_t row_end = iscc_digraph_row_end(dg, i);
+			if (iscc_digraph_row_begin(dg, i) > row_end) return false;
+			if ((dg->segment_ptr != NULL) &&
+			        (row_end - dg->segment_ptr[i / ISCC_DIGRAPH_SEGMENT_ROWS] > ISCC_ARCINDEX_MAX)) return false;
+		}
 	}
-	if (dg->tail_ptr[dg->vertices] > 0) {
+	const size_t num_arcs = iscc_digraph_num_arcs(dg);
+	if (num_arcs > dg->max_arcs) return false;
+	if (num_arcs > 0) {
 		assert(dg->vertices <= ISCC_POINTINDEX_MAX);
 		scc_PointIndex vertices = (scc_PointIndex) dg->vertices; // If `scc_PointIndex` is signed.
-		const scc_PointIndex* const arc_stop = dg->head + dg->tail_ptr[dg->vertices];
+		const scc_PointIndex* const arc_stop = dg->head + num_arcs;
 		for (const scc_PointIndex* arc = dg->head; arc != arc_stop; ++arc) {
 			if (*arc >= vertices) return false;
 		}
@@ -77,7 +142,7 @@ bool iscc_digraph_is_valid(const iscc_Digraph* const dg)
 bool iscc_digraph_is_empty(const iscc_Digraph* const dg)
 {
 	assert(iscc_digraph_is_initialized(dg));
-	return (dg->tail_ptr[dg->vertices] == 0);
+	return (iscc_digraph_num_arcs(dg) == 0);
 }
 
 
@@ -89,8 +154,8 @@ scc_ErrorCode iscc_init_digraph(const size_t vertices,
 	assert(vertices <= ISCC_POINTINDEX_MAX);
 	assert(vertices < SIZE_MAX);
 	assert(out_dg != NULL);
-	if ((max_arcs > ISCC_ARCINDEX_MAX) || (max_arcs > SIZE_MAX)) {
-		return iscc_make_error_msg(SCC_ER_TOO_LARGE_PROBLEM, "Too many arcs in graph (adjust the `iscc_ArcIndex` type).");
+	if (max_arcs > SIZE_MAX / sizeof(scc_PointIndex)) {
+		return iscc_make_error_msg(SCC_ER_TOO_LARGE_PROBLEM, "Too many arcs in graph.");
 	}
 
 	*out_dg = (iscc_Digraph) {
@@ -98,9 +163,18 @@ scc_ErrorCode iscc_init_digraph(const size_t vertices,
 		.max_arcs = (size_t) max_arcs,
 		.head = NULL,
 		.tail_ptr = malloc(sizeof(iscc_ArcIndex[vertices + 1])),
+		.segment_ptr = NULL,
 	};
 	if (out_dg->tail_ptr == NULL) return iscc_make_error(SCC_ER_NO_MEMORY);
 
+	if (max_arcs > ISCC_ARCINDEX_MAX) {
+		out_dg->segment_ptr = malloc(sizeof(size_t[vertices / ISCC_DIGRAPH_SEGMENT_ROWS + 1]));
+		if (out_dg->segment_ptr == NULL) {
+			iscc_free_digraph(out_dg);
+			return iscc_make_error(SCC_ER_NO_MEMORY);
+		}
+	}
+
 	if (max_arcs > 0) {
 		out_dg->head = malloc(sizeof(scc_PointIndex[max_arcs]));
 		if (out_dg->head == NULL) {
@@ -123,8 +197,8 @@ scc_ErrorCode iscc_empty_digraph(const size_t vertices,
 	assert(vertices <= ISCC_POINTINDEX_MAX);
 	assert(vertices < SIZE_MAX);
 	assert(out_dg != NULL);
-	if ((max_arcs > ISCC_ARCINDEX_MAX) || (max_arcs > SIZE_MAX)) {
-		return iscc_make_error_msg(SCC_ER_TOO_LARGE_PROBLEM, "Too many arcs in graph (adjust the `iscc_ArcIndex` type).");
+	if (max_arcs > SIZE_MAX / sizeof(scc_PointIndex)) {
+		return iscc_make_error_msg(SCC_ER_TOO_LARGE_PROBLEM, "Too many arcs in graph.");
 	}
 
 	*out_dg = (iscc_Digraph) {
@@ -132,9 +206,18 @@ scc_ErrorCode iscc_empty_digraph(const size_t vertices,
 		.max_arcs = (size_t) max_arcs,
 		.head = NULL,
 		.tail_ptr = calloc(vertices + 1, sizeof(iscc_ArcIndex)),
+		.segment_ptr = NULL,
 	};
 	if (out_dg->tail_ptr == NULL) return iscc_make_error(SCC_ER_NO_MEMORY);
 
+	if (max_arcs > ISCC_ARCINDEX_MAX) {
+		out_dg->segment_ptr = calloc(vertices / ISCC_DIGRAPH_SEGMENT_ROWS + 1, sizeof(size_t));
+		if (out_dg->segment_ptr == NULL) {
+			iscc_free_digraph(out_dg);
+			return iscc_make_error(SCC_ER_NO_MEMORY);
+		}
+	}
+
 	if (max_arcs > 0) {
 		out_dg->head = malloc(sizeof(scc_PointIndex[max_arcs]));
 		if (out_dg->head == NULL) {
@@ -153,10 +236,23 @@ scc_ErrorCode iscc_change_arc_storage(iscc_Digraph* const dg,
                                       const uintmax_t new_max_arcs)
 {
 	assert(iscc_digraph_is_initialized(dg));
-	assert(dg->tail_ptr[dg->vertices] <= new_max_arcs);
-	if ((new_max_arcs > ISCC_ARCINDEX_MAX) || (new_max_arcs > SIZE_MAX)) {
-		return iscc_make_error_msg(SCC_ER_TOO_LARGE_PROBLEM, "Too many arcs in graph (adjust the `iscc_ArcIndex` type).");
+	assert(!iscc_digraph_is_compressed(dg));
+	if (new_max_arcs > SIZE_MAX / sizeof(scc_PointIndex)) {
+		return iscc_make_error_msg(SCC_ER_TOO_LARGE_PROBLEM, "Too many arcs in graph.");
 	}
+
+	// The segments are updated first, as `tail_ptr` might have been written since they were derived
+	if (!iscc_digraph_is_fixed(dg)) {
+		if (new_max_arcs > ISCC_ARCINDEX_MAX) {
+			scc_ErrorCode ec;
+			if ((ec = iscc_digraph_segment(dg)) != SCC_ER_OK) return ec;
+		} else {
+			free(dg->segment_ptr);
+			dg->segment_ptr = NULL;
+		}
+	}
+
+	assert(iscc_digraph_num_arcs(dg) <= new_max_arcs);
 	if (dg->max_arcs == new_max_arcs) return iscc_no_error();
 
 	if (new_max_arcs == 0) {
@@ -172,3 +268,376 @@ scc_ErrorCode iscc_change_arc_storage(iscc_Digraph* const dg,
 
 	return iscc_no_error();
 }
+
+
+scc_ErrorCode iscc_digraph_segment(iscc_Digraph* const dg)
+{
+	assert(dg != NULL);
+	assert(dg->tail_ptr != NULL);
+	assert(dg->tail_ptr[0] == 0);
+	assert(!iscc_digraph_is_fixed(dg));
+	assert(!iscc_digraph_is_compressed(dg));
+
+	if (dg->segment_ptr == NULL) {
+		dg->segment_ptr = malloc(sizeof(size_t[dg->vertices / ISCC_DIGRAPH_SEGMENT_ROWS + 1]));
+		if (dg->segment_ptr == NULL) return iscc_make_error(SCC_ER_NO_MEMORY);
+	}
+
+	// Rows are shorter than a segment, so their lengths are the differences of `tail_ptr` modulo `ISCC_ARCINDEX_MAX + 1`
+	size_t row_begin = 0;
+	size_t segment_begin = 0;
+	for (size_t v = 0; v < dg->vertices; ++v) {
+		if ((v % ISCC_DIGRAPH_SEGMENT_ROWS) == 0) {
+			segment_begin = row_begin;
+			dg->segment_ptr[v / ISCC_DIGRAPH_SEGMENT_ROWS] = row_begin;
+		}
+		row_begin += (iscc_ArcIndex) (dg->tail_ptr[v + 1] - dg->tail_ptr[v]);
+		if (row_begin - segment_begin > ISCC_ARCINDEX_MAX) {
+			return iscc_make_error_msg(SCC_ER_TOO_LARGE_PROBLEM, "Too many arcs in digraph segment (adjust the `iscc_ArcIndex` type).");
+		}
+	}
+	if ((dg->vertices % ISCC_DIGRAPH_SEGMENT_ROWS) == 0) {
+		dg->segment_ptr[dg->vertices / ISCC_DIGRAPH_SEGMENT_ROWS] = row_begin;
+	}
+
+	return iscc_no_error();
+}
+
+
+scc_ErrorCode iscc_init_fixed_digraph(const size_t vertices,
+                                      const uint32_t fixed_degree,
+                                      const bool all_tails,
+                                      const uintmax_t max_arcs,
+                                      iscc_Digraph* const out_dg)
+{
+	assert(vertices > 0);
+	assert(vertices <= ISCC_POINTINDEX_MAX);
+	assert(vertices < SIZE_MAX);
+	assert(fixed_degree > 0);
+	assert(out_dg != NULL);
+	if (max_arcs > SIZE_MAX / sizeof(scc_PointIndex)) {
+		return iscc_make_error_msg(SCC_ER_TOO_LARGE_PROBLEM, "Too many arcs in graph.");
+	}
+
+	*out_dg = (iscc_Digraph) {
+		.vertices = vertices,
+		.max_arcs = (size_t) max_arcs,
+		.head = NULL,
+		.tail_ptr = NULL,
+		.segment_ptr = NULL,
+		.fixed_degree = fixed_degree,
+		.valid_tails = NULL,
+		.tail_rank = NULL,
+	};
+
+	if (!all_tails) {
+		out_dg->valid_tails = iscc_bitset_alloc(vertices + 1);
+		out_dg->tail_rank = calloc(iscc_bitset_num_words(vertices + 1), sizeof(scc_PointIndex));
+		if ((out_dg->valid_tails == NULL) || (out_dg->tail_rank == NULL)) {
+			iscc_free_digraph(out_dg);
+			return iscc_make_error(SCC_ER_NO_MEMORY);
+		}
+	}
+
+	if (max_arcs > 0) {
+		out_dg->head = malloc(sizeof(scc_PointIndex[max_arcs]));
+		if (out_dg->head == NULL) {
+			iscc_free_digraph(out_dg);
+			return iscc_make_error(SCC_ER_NO_MEMORY);
+		}
+	}
+
+	assert(iscc_digraph_is_initialized(out_dg));
+
+	return iscc_no_error();
+}
+
+
+void iscc_rank_fixed_digraph(iscc_Digraph* const dg)
+{
+	assert(iscc_digraph_is_initialized(dg));
+	assert(iscc_digraph_is_fixed(dg));
+	if (dg->valid_tails == NULL) return;
+
+	assert(!iscc_bitset_test(dg->valid_tails, dg->vertices));
+	const size_t num_words = iscc_bitset_num_words(dg->vertices + 1);
+	size_t rank = 0;
+	for (size_t w = 0; w < num_words; ++w) {
+		dg->tail_rank[w] = (scc_PointIndex) rank;
+		rank += iscc_bitset_popcount(dg->valid_tails[w]);
+	}
+}
+
+
+scc_ErrorCode iscc_digraph_make_csr(iscc_Digraph* const dg)
+{
+	assert(iscc_digraph_is_initialized(dg));
+	if (iscc_digraph_is_compressed(dg)) {
+		scc_ErrorCode ec;
+		iscc_Digraph tmp_dg;
+		if ((ec = iscc_init_digraph(dg->vertices, dg->max_arcs, &tmp_dg)) != SCC_ER_OK) return ec;
+
+		iscc_DigraphRowReader reader;
+		if ((ec = iscc_init_row_reader(dg, &reader)) != SCC_ER_OK) {
+			iscc_free_digraph(&tmp_dg);
+			return ec;
+		}
+
+		size_t num_arcs = 0;
+		tmp_dg.tail_ptr[0] = 0;
+		for (size_t v = 0; v < dg->vertices; ++v) {
+			size_t len_row;
+			const scc_PointIndex* const row = iscc_digraph_read_row(dg, v, &reader, &len_row);
+			for (size_t i = 0; i < len_row; ++i) {
+				tmp_dg.head[num_arcs + i] = row[i];
+			}
+			num_arcs += len_row;
+			tmp_dg.tail_ptr[v + 1] = (iscc_ArcIndex) num_arcs;
+		}
+
+		iscc_free_row_reader(&reader);
+		if ((ec = iscc_change_arc_storage(&tmp_dg, num_arcs)) != SCC_ER_OK) {
+			iscc_free_digraph(&tmp_dg);
+			return ec;
+		}
+		iscc_free_digraph(dg);
+		*dg = tmp_dg;
+		return iscc_no_error();
+	}
+	if (!iscc_digraph_is_fixed(dg)) return iscc_no_error();
+
+	iscc_ArcIndex* const tail_ptr = malloc(sizeof(iscc_ArcIndex[dg->vertices + 1]));
+	if (tail_ptr == NULL) return iscc_make_error(SCC_ER_NO_MEMORY);
+
+	for (size_t v = 0; v <= dg->vertices; ++v) {
+		tail_ptr[v] = (iscc_ArcIndex) iscc_digraph_row_begin(dg, v);
+	}
+
+	free(dg->valid_tails);
+	free(dg->tail_rank);
+	dg->tail_ptr = tail_ptr;
+	dg->fixed_degree = 0;
+	dg->valid_tails = NULL;
+	dg->tail_rank = NULL;
+
+	return iscc_change_arc_storage(dg, dg->max_arcs);
+}
+
+
+scc_ErrorCode iscc_digraph_compress(iscc_Digraph* const dg)
+{
+	assert(iscc_digraph_is_valid(dg));
+	if (iscc_digraph_is_compressed(dg)) return iscc_no_error();
+
+	const size_t vertices = dg->vertices;
+	const size_t num_arcs = iscc_digraph_num_arcs(dg);
+	const size_t num_strides = (vertices + ISCC_DIGRAPH_PACKED_STRIDE - 1) / ISCC_DIGRAPH_PACKED_STRIDE;
+
+	// The rows are sorted in place, as the uncompressed arcs are freed below
+	size_t len_packed = 0;
+	size_t max_out_degree = 0;
+	for (size_t v = 0; v < vertices; ++v) {
+		const size_t begin = iscc_digraph_row_begin(dg, v);
+		const size_t len_row = iscc_digraph_row_end(dg, v) - begin;
+		if (max_out_degree < len_row) max_out_degree = len_row;
+		len_packed += iscc_varint_length((uint64_t) len_row);
+		if (len_row == 0) continue;
+
+		scc_PointIndex* const row = dg->head + begin;
+		iscc_sort_row(row, len_row);
+		const uint64_t first = (uint64_t) row[0];
+		len_packed += iscc_varint_length((first >= v) ? ((first - v) << 1) : (((v - first) << 1) - 1u));
+		for (size_t i = 1; i < len_row; ++i) {
+			len_packed += iscc_varint_length((uint64_t) (row[i] - row[i - 1]));
+		}
+	}
+
+	uint8_t* const packed_rows = malloc(len_packed);
+	size_t* const packed_ptr = malloc(sizeof(size_t[num_strides + 1]));
+	if ((packed_rows == NULL) || (packed_ptr == NULL)) {
+		free(packed_rows);
+		free(packed_ptr);
+		return iscc_make_error(SCC_ER_NO_MEMORY);
+	}
+
+	uint8_t* pos = packed_rows;
+	for (size_t v = 0; v < vertices; ++v) {
+		if ((v % ISCC_DIGRAPH_PACKED_STRIDE) == 0) {
+			packed_ptr[v / ISCC_DIGRAPH_PACKED_STRIDE] = (size_t) (pos - packed_rows);
+		}
+		const size_t begin = iscc_digraph_row_begin(dg, v);
+		const size_t len_row = iscc_digraph_row_end(dg, v) - begin;
+		pos = iscc_varint_write(pos, (uint64_t) len_row);
+		if (len_row == 0) continue;
+
+		const scc_PointIndex* const row = dg->head + begin;
+		const uint64_t first = (uint64_t) row[0];
+		pos = iscc_varint_write(pos, (first >= v) ? ((first - v) << 1) : (((v - first) << 1) - 1u));
+		for (size_t i = 1; i < len_row; ++i) {
+			pos = iscc_varint_write(pos, (uint64_t) (row[i] - row[i - 1]));
+		}
+	}
+	assert(((size_t) (pos - packed_rows)) == len_packed);
+	packed_ptr[num_strides] = len_packed;
+
+	free(dg->head);
+	free(dg->tail_ptr);
+	free(dg->segment_ptr);
+	free(dg->valid_tails);
+	free(dg->tail_rank);
+	*dg = (iscc_Digraph) {
+		.vertices = vertices,
+		.max_arcs = num_arcs,
+		.head = NULL,
+		.tail_ptr = NULL,
+		.segment_ptr = NULL,
+		.fixed_degree = 0,
+		.valid_tails = NULL,
+		.tail_rank = NULL,
+		.packed_rows = packed_rows,
+		.packed_ptr = packed_ptr,
+		.max_out_degree = max_out_degree,
+	};
+
+	assert(iscc_digraph_is_valid(dg));
+
+	return iscc_no_error();
+}
+
+
+scc_ErrorCode iscc_init_row_reader(const iscc_Digraph* const dg,
+                                   iscc_DigraphRowReader* const out_reader)
+{
+	assert(iscc_digraph_is_initialized(dg));
+	assert(out_reader != NULL);
+
+	*out_reader = (iscc_DigraphRowReader) {
+		.next_vertex = 0,
+		.next_row = NULL,
+		.row = NULL,
+	};
+
+	if (iscc_digraph_is_compressed(dg) && (dg->max_out_degree > 0)) {
+		out_reader->row = malloc(sizeof(scc_PointIndex[dg->max_out_degree]));
+		if (out_reader->row == NULL) return iscc_make_error(SCC_ER_NO_MEMORY);
+	}
+
+	return iscc_no_error();
+}
+
+
+void iscc_free_row_reader(iscc_DigraphRowReader* const reader)
+{
+	if (reader != NULL) {
+		free(reader->row);
+		reader->row = NULL;
+		reader->next_row = NULL;
+	}
+}
+
+
+iscc_BitsetWord* iscc_digraph_tails_with_arcs(const iscc_Digraph* const dg)
+{
+	assert(iscc_digraph_is_initialized(dg));
+
+	iscc_BitsetWord* const tails = iscc_bitset_alloc(dg->vertices);
+	if (tails == NULL) return NULL;
+
+	if (iscc_digraph_is_compressed(dg)) {
+		// Rows are stored back to back, so they can be walked without seeking
+		const uint8_t* pos = dg->packed_rows;
+		for (size_t v = 0; v < dg->vertices; ++v) {
+			const size_t degree = (size_t) iscc_varint_read(&pos);
+			if (degree > 0) iscc_bitset_set(tails, v);
+			pos = iscc_varint_skip(pos, degree);
+		}
+	} else {
+		for (size_t v = 0; v < dg->vertices; ++v) {
+			if (iscc_digraph_out_degree(dg, v) > 0) iscc_bitset_set(tails, v);
+		}
+	}
+
+	return tails;
+}
+
+
+// =============================================================================
+// Static function implementations
+// =============================================================================
+
+static bool iscc_compressed_digraph_is_valid(const iscc_Digraph* const dg)
+{
+	assert(iscc_digraph_is_compressed(dg));
+
+	const size_t num_strides = (dg->vertices + ISCC_DIGRAPH_PACKED_STRIDE - 1) / ISCC_DIGRAPH_PACKED_STRIDE;
+	const uint8_t* const packed_end = dg->packed_rows + dg->packed_ptr[num_strides];
+	const uint8_t* pos = dg->packed_rows;
+	size_t num_arcs = 0;
+	for (size_t v = 0; v < dg->vertices; ++v) {
+		if (((v % ISCC_DIGRAPH_PACKED_STRIDE) == 0) &&
+		        (pos != dg->packed_rows + dg->packed_ptr[v / ISCC_DIGRAPH_PACKED_STRIDE])) return false;
+		if (pos >= packed_end) return false;
+		const size_t degree = (size_t) iscc_varint_read(&pos);
+		if (degree > dg->max_out_degree) return false;
+		if (degree == 0) continue;
+
+		const uint64_t first = iscc_varint_read(&pos);
+		if (((first & 1u) && ((first >> 1) >= v)) || (first >= 2 * (uint64_t) dg->vertices)) return false;
+		uint64_t head = (first & 1u) ? ((uint64_t) v - (first >> 1) - 1u) : ((uint64_t) v + (first >> 1));
+		for (size_t i = 1; i < degree; ++i) {
+			if (pos >= packed_end) return false;
+			head += iscc_varint_read(&pos);
+		}
+		if (head >= dg->vertices) return false;
+		num_arcs += degree;
+	}
+
+	return (pos == packed_end) && (num_arcs == dg->max_arcs);
+}
+
+
+static size_t iscc_varint_length(uint64_t value)
+{
+	size_t length = 1;
+	for (; value >= 0x80u; value >>= 7) ++length;
+	return length;
+}
+
+
+static uint8_t* iscc_varint_write(uint8_t* pos,
+                                  uint64_t value)
+{
+	for (; value >= 0x80u; value >>= 7) {
+		*pos = (uint8_t) ((value & 0x7Fu) | 0x80u);
+		++pos;
+	}
+	*pos = (uint8_t) value;
+	return pos + 1;
+}
+
+
+static void iscc_sort_row(scc_PointIndex* const row,
+                          const size_t len_row)
+{
+	if (len_row > 32) {
+		qsort(row, len_row, sizeof(scc_PointIndex), iscc_compare_heads);
+		return;
+	}
+	for (size_t i = 1; i < len_row; ++i) {
+		const scc_PointIndex tmp = row[i];
+		size_t j = i;
+		for (; (j > 0) && (row[j - 1] > tmp); --j) {
+			row[j] = row[j - 1];
+		}
+		row[j] = tmp;
+	}
+}
+
+
+static int iscc_compare_heads(const void* const a,
+                              const void* const b)
+{
+	const scc_PointIndex arg1 = *(const scc_PointIndex* const) a;
+	const scc_PointIndex arg2 = *(const scc_PointIndex* const) b;
+	return (arg1 > arg2) - (arg1 < arg2);
+}
@@ -33,6 +33,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "../include/scclust.h"
+#include "bitset.h"
 #include "scclust_types.h"
 
 
@@ -49,6 +50,23 @@
  *  `i` is the tail, and `#head[#tail_ptr[i+1]-1]` is the last.
  *
  *  In other words, if there is an arc `i` -> `j`, there exists some `k` such that `#tail_ptr[i] <= k < #tail_ptr[i+1]` and `#head[k]==j`.
+ *
+ *  Digraphs where all tails have the same number of arcs can instead be stored in fixed-degree
+ *  format. In that case, #fixed_degree is the number of arcs of each tail and #tail_ptr is `NULL`.
+ *  The arcs of the tails are stored consecutively in #head in vertex order, so the arcs of the `r`th
+ *  tail (counting from zero) are `#head[r * #fixed_degree]` to `#head[(r + 1) * #fixed_degree - 1]`.
+ *  If some vertices are not tails (e.g., queries dropped by a radius constraint), #valid_tails
+ *  marks the vertices that are, and #tail_rank is used to find the rank of a tail in constant time.
+ *
+ *  Digraphs with more arcs than `iscc_ArcIndex` can index are segmented (see #segment_ptr), so that
+ *  `iscc_ArcIndex` can stay small for ordinary digraphs.
+ *
+ *  Code that reads digraphs that may be in fixed-degree format or segmented should use #iscc_digraph_row_begin
+ *  and #iscc_digraph_row_end rather than #tail_ptr.
+ *
+ *  Digraphs can also be compressed (see #iscc_digraph_compress). The rows are then sorted and stored
+ *  delta and varint encoded in #packed_rows, and #head, #tail_ptr, #valid_tails and #tail_rank are `NULL`.
+ *  Code that reads digraphs that may be compressed should use #iscc_digraph_read_row.
  */
 typedef struct iscc_Digraph {
 	/** Number of vertices in the digraph. May not be greater than `ISCC_POINTINDEX_MAX`.
@@ -71,20 +89,106 @@ typedef struct iscc_Digraph {
 
 	/** Array of arc indices indicating arcs for which a vertex is the tail.
 	 *
-	 *  #tail_ptr may never be `NULL` and must point a memory area of length `#vertices + 1`.
+	 *  Unless the digraph is in fixed-degree format, #tail_ptr may never be `NULL` and must point
+	 *  a memory area of length `#vertices + 1`.
 	 *
 	 *  The first element of #tail_ptr must be zero (`#tail_ptr[0] == 0`). For all `i < #vertices`,
 	 *  we must have `#tail_ptr[i] <= #tail_ptr[i+1] <= #max_arcs`.
 	 */
 	iscc_ArcIndex* tail_ptr;
+
+	/** Arc indices of the first row of each segment in digraphs with more than `ISCC_ARCINDEX_MAX` arcs.
+	 *
+	 *  The rows are grouped in segments of `ISCC_DIGRAPH_SEGMENT_ROWS` vertices. When #segment_ptr is
+	 *  not `NULL`, #tail_ptr holds the arc indices modulo `ISCC_ARCINDEX_MAX + 1`, and `#segment_ptr[s]`
+	 *  is the full index of the first arc of vertex `s * ISCC_DIGRAPH_SEGMENT_ROWS`. The index of vertex `i`
+	 *  is recovered as the offset of its segment plus the difference, modulo `ISCC_ARCINDEX_MAX + 1`, between
+	 *  `#tail_ptr[i]` and the offset. No segment may therefore contain more than `ISCC_ARCINDEX_MAX` arcs.
+	 *
+	 *  If not `NULL`, #segment_ptr points a memory area of length `#vertices / ISCC_DIGRAPH_SEGMENT_ROWS + 1`.
+	 *  It may only be `NULL` if `#max_arcs <= ISCC_ARCINDEX_MAX`, and must be `NULL` unless the digraph is
+	 *  in sparse matrix format.
+	 */
+	size_t* segment_ptr;
+
+	/** Number of arcs of each tail in fixed-degree digraphs.
+	 *
+	 *  Zero for digraphs stored in the sparse matrix format. When non-zero, #tail_ptr must be `NULL`.
+	 */
+	uint32_t fixed_degree;
+
+	/** Bitset of length `#vertices + 1` marking the tails in a fixed-degree digraph.
+	 *
+	 *  `NULL` if all vertices are tails or if #fixed_degree is zero. The last bit is never set.
+	 */
+	iscc_BitsetWord* valid_tails;
+
+	/** Number of tails before each word of #valid_tails.
+	 *
+	 *  `#tail_rank[w]` is the number of set bits in words `0` to `w - 1` of #valid_tails.
+	 *  Must be `NULL` if and only if #valid_tails is `NULL`.
+	 */
+	scc_PointIndex* tail_rank;
+
+	/** Encoded rows of a compressed digraph.
+	 *
+	 *  `NULL` unless the digraph is compressed. Each row is stored as the number of arcs followed by the
+	 *  heads in ascending order. The first head is stored as its zigzag encoded difference to the tail,
+	 *  and the remaining heads as the difference to the previous head. All numbers are varint encoded
+	 *  (seven bits per byte, with the high bit set on all but the last byte).
+	 *
+	 *  In compressed digraphs, #max_arcs is the number of arcs and #fixed_degree is zero.
+	 */
+	uint8_t* packed_rows;
+
+	/** Offsets of every `ISCC_DIGRAPH_PACKED_STRIDE`th row in #packed_rows.
+	 *
+	 *  `#packed_ptr[b]` is the offset of the row of vertex `b * ISCC_DIGRAPH_PACKED_STRIDE`, and the
+	 *  last element is the length of #packed_rows. Must be `NULL` if and only if #packed_rows is `NULL`.
+	 */
+	size_t* packed_ptr;
+
+	/// Largest number of arcs of any tail in a compressed digraph. Zero if the digraph is not compressed.
+	size_t max_out_degree;
 } iscc_Digraph;
 
 
+/** Number of rows between the offsets stored in scc_Digraph::packed_ptr.
+ *
+ *  Longer strides save memory but make random access to rows slower.
+ */
+#define ISCC_DIGRAPH_PACKED_STRIDE 16
+
+
+/// Number of rows in each segment of scc_Digraph::segment_ptr.
+#define ISCC_DIGRAPH_SEGMENT_ROWS 1024
+
+
+/** Reader for rows of digraphs in any format.
+ *
+ *  Rows of compressed digraphs are decoded to #row. A reader remembers where the last
+ *  row it read ended, so reading rows in ascending vertex order decodes each row only once.
+ *  Rows of other digraphs are read directly from scc_Digraph::head.
+ *
+ *  A reader may only be used with the digraph it was initialized for, and only by one thread at a time.
+ */
+typedef struct iscc_DigraphRowReader {
+	/// Vertex whose row starts at #next_row.
+	size_t next_vertex;
+
+	/// Position after the last decoded row. `NULL` if no row has been decoded.
+	const uint8_t* next_row;
+
+	/// Buffer of length scc_Digraph::max_out_degree for decoded rows. `NULL` if the digraph is not compressed.
+	scc_PointIndex* row;
+} iscc_DigraphRowReader;
+
+
 /** The null digraph.
  *
  *  The null digraph is an easily detectable invalid digraph.
  */
-static const iscc_Digraph ISCC_NULL_DIGRAPH = { 0, 0, NULL, NULL };
+static const iscc_Digraph ISCC_NULL_DIGRAPH = { 0, 0, NULL, NULL, NULL, 0, NULL, NULL, NULL, NULL, 0 };
 
 
 // =============================================================================
@@ -177,6 +281,10 @@ scc_ErrorCode iscc_empty_digraph(size_t vertices,
  *  Requires that the number of arcs in \p dg is less or equally to \p new_max_arcs.
  *  If `new_max_arcs == 0`, the memory space is deallocated and scc_Digraph::head is set to `NULL`.
  *
+ *  Digraphs in sparse matrix format are segmented by #iscc_digraph_segment if \p new_max_arcs is
+ *  greater than `ISCC_ARCINDEX_MAX`, and their segments are removed otherwise. Functions that write
+ *  scc_Digraph::tail_ptr directly call this function when done, also if the arc memory is unchanged.
+ *
  *  \param[in,out] dg digraph to reallocate arc memory for.
  *  \param         new_max_arcs new size of memory.
  */
@@ -184,4 +292,260 @@ scc_ErrorCode iscc_change_arc_storage(iscc_Digraph* dg,
                                       uintmax_t new_max_arcs);
 
 
+/** Segments digraph.
+ *
+ *  Derives scc_Digraph::segment_ptr from scc_Digraph::tail_ptr, allocating it if needed. The elements
+ *  of scc_Digraph::tail_ptr must be the arc indices modulo `ISCC_ARCINDEX_MAX + 1`, as written by
+ *  casting the indices to `iscc_ArcIndex`. Fails with #SCC_ER_TOO_LARGE_PROBLEM if some segment
+ *  has more than `ISCC_ARCINDEX_MAX` arcs.
+ *
+ *  \param[in,out] dg digraph in sparse matrix format to segment.
+ */
+scc_ErrorCode iscc_digraph_segment(iscc_Digraph* dg);
+
+
+/** Constructor for fixed-degree digraphs.
+ *
+ *  Initializes a digraph in fixed-degree format where each tail has \p fixed_degree arcs.
+ *  If \p all_tails is \c true, all vertices are tails. Otherwise, no vertex is a tail
+ *  until it is marked in scc_Digraph::valid_tails and #iscc_rank_fixed_digraph is called.
+ *  The memory space pointed to by scc_Digraph::head is left uninitialized.
+ *
+ *  \param vertices number of vertices that can be represented in the digraph.
+ *  \param fixed_degree number of arcs of each tail. Must be positive.
+ *  \param all_tails indicate whether all vertices are tails.
+ *  \param max_arcs memory space to be allocated for arcs.
+ *  \param[out] out_dg a scc_Digraph with allocated memory.
+ */
+scc_ErrorCode iscc_init_fixed_digraph(size_t vertices,
+                                      uint32_t fixed_degree,
+                                      bool all_tails,
+                                      uintmax_t max_arcs,
+                                      iscc_Digraph* out_dg);
+
+
+/** Recomputes tail ranks of a fixed-degree digraph.
+ *
+ *  Must be called after scc_Digraph::valid_tails has been changed.
+ *
+ *  \param[in,out] dg fixed-degree digraph to update.
+ */
+void iscc_rank_fixed_digraph(iscc_Digraph* dg);
+
+
+/** Converts digraph to sparse matrix format.
+ *
+ *  Allocates scc_Digraph::tail_ptr for a fixed-degree digraph and frees the fixed-degree
+ *  bookkeeping. The arcs are not moved. Compressed digraphs are decoded, so their rows
+ *  are sorted in the output. Digraphs already in sparse matrix format are left unchanged.
+ *
+ *  \param[in,out] dg digraph to convert.
+ */
+scc_ErrorCode iscc_digraph_make_csr(iscc_Digraph* dg);
+
+
+/** Compresses digraph.
+ *
+ *  Sorts the rows of \p dg and encodes them as described for scc_Digraph::packed_rows. The
+ *  uncompressed arc storage is freed. With `k` arcs per tail and heads close to their
+ *  tails in vertex order, this typically uses one to two bytes per arc instead of
+ *  `sizeof(scc_PointIndex)`, and needs no scc_Digraph::tail_ptr. Digraphs already compressed
+ *  are left unchanged.
+ *
+ *  Compressed digraphs can be read with #iscc_digraph_read_row and transposed with
+ *  #iscc_digraph_transpose. Other digraph operations require uncompressed input.
+ *
+ *  \param[in,out] dg digraph to compress.
+ */
+scc_ErrorCode iscc_digraph_compress(iscc_Digraph* dg);
+
+
+/** Constructor for row readers.
+ *
+ *  \param[in] dg digraph to read.
+ *  \param[out] out_reader a row reader for \p dg. Must be freed with #iscc_free_row_reader.
+ */
+scc_ErrorCode iscc_init_row_reader(const iscc_Digraph* dg,
+                                   iscc_DigraphRowReader* out_reader);
+
+
+/// Destructor for row readers.
+void iscc_free_row_reader(iscc_DigraphRowReader* reader);
+
+
+/** Finds the vertices with arcs.
+ *
+ *  Reads each row once, so this is cheaper than calling #iscc_digraph_out_degree for every
+ *  vertex of a compressed digraph, where each call decodes part of a stride.
+ *
+ *  \param[in] dg digraph to read.
+ *
+ *  \return a bitset of length scc_Digraph::vertices with the bits of vertices with arcs set,
+ *          to be freed with `free`. `NULL` if memory could not be allocated.
+ */
+iscc_BitsetWord* iscc_digraph_tails_with_arcs(const iscc_Digraph* dg);
+
+
+// =============================================================================
+// Inline functions
+// =============================================================================
+
+static inline bool iscc_digraph_is_fixed(const iscc_Digraph* const dg)
+{
+	return (dg->fixed_degree > 0);
+}
+
+
+static inline bool iscc_digraph_is_compressed(const iscc_Digraph* const dg)
+{
+	return (dg->packed_rows != NULL);
+}
+
+
+static inline uint64_t iscc_varint_read(const uint8_t** const pos)
+{
+	uint64_t value = 0;
+	unsigned shift = 0;
+	uint8_t byte;
+	do {
+		byte = **pos;
+		++(*pos);
+		value |= ((uint64_t) (byte & 0x7Fu)) << shift;
+		shift += 7;
+	} while (byte & 0x80u);
+	return value;
+}
+
+
+// Skips `count` varints starting at `pos`
+static inline const uint8_t* iscc_varint_skip(const uint8_t* pos,
+                                              size_t count)
+{
+	for (; count > 0; ++pos) {
+		count -= ((*pos & 0x80u) == 0);
+	}
+	return pos;
+}
+
+
+/* Finds the row of `v` in a compressed digraph. When `reader` is not NULL and its last
+ * row ended in the same stride as `v`, before `v`, decoding continues from there.
+ */
+static inline const uint8_t* iscc_digraph_seek_row(const iscc_Digraph* const dg,
+                                                   const size_t v,
+                                                   const iscc_DigraphRowReader* const reader)
+{
+	const size_t stride_start = v - (v % ISCC_DIGRAPH_PACKED_STRIDE);
+	size_t u = stride_start;
+	const uint8_t* pos = dg->packed_rows + dg->packed_ptr[v / ISCC_DIGRAPH_PACKED_STRIDE];
+	if ((reader != NULL) && (reader->next_row != NULL) &&
+	        (reader->next_vertex >= stride_start) && (reader->next_vertex <= v)) {
+		u = reader->next_vertex;
+		pos = reader->next_row;
+	}
+	for (; u < v; ++u) {
+		const size_t degree = (size_t) iscc_varint_read(&pos);
+		pos = iscc_varint_skip(pos, degree);
+	}
+	return pos;
+}
+
+
+/** Index in scc_Digraph::head of the arc index \p stored in the segment of vertex \p v.
+ *
+ *  Returns \p stored unless the digraph is segmented (see scc_Digraph::segment_ptr).
+ */
+static inline size_t iscc_digraph_unwrap_arc(const iscc_Digraph* const dg,
+                                             const size_t v,
+                                             const iscc_ArcIndex stored)
+{
+	if (dg->segment_ptr == NULL) return stored;
+	const size_t offset = dg->segment_ptr[v / ISCC_DIGRAPH_SEGMENT_ROWS];
+	return offset + (iscc_ArcIndex) (stored - (iscc_ArcIndex) offset);
+}
+
+
+/** Index in scc_Digraph::head of the first arc of vertex \p v.
+ *
+ *  Equals `dg->tail_ptr[v]` for unsegmented digraphs in sparse matrix format. May be called with `v == dg->vertices`,
+ *  in which case the number of arcs in the digraph is returned.
+ */
+static inline size_t iscc_digraph_row_begin(const iscc_Digraph* const dg,
+                                            const size_t v)
+{
+	if (dg->fixed_degree == 0) return iscc_digraph_unwrap_arc(dg, v, dg->tail_ptr[v]);
+	if (dg->valid_tails == NULL) return v * dg->fixed_degree;
+	const size_t w = v / ISCC_BITSET_WORD_BITS;
+	const iscc_BitsetWord before = dg->valid_tails[w] & ((UINT64_C(1) << (v % ISCC_BITSET_WORD_BITS)) - 1u);
+	return ((size_t) dg->tail_rank[w] + iscc_bitset_popcount(before)) * dg->fixed_degree;
+}
+
+
+/// Index in scc_Digraph::head one past the last arc of vertex \p v. Equals `dg->tail_ptr[v + 1]` for unsegmented sparse matrices.
+static inline size_t iscc_digraph_row_end(const iscc_Digraph* const dg,
+                                          const size_t v)
+{
+	if (dg->fixed_degree == 0) return iscc_digraph_unwrap_arc(dg, v + 1, dg->tail_ptr[v + 1]);
+	const size_t begin = iscc_digraph_row_begin(dg, v);
+	if ((dg->valid_tails != NULL) && !iscc_bitset_test(dg->valid_tails, v)) return begin;
+	return begin + dg->fixed_degree;
+}
+
+
+static inline size_t iscc_digraph_out_degree(const iscc_Digraph* const dg,
+                                             const size_t v)
+{
+	if (dg->packed_rows != NULL) {
+		const uint8_t* pos = iscc_digraph_seek_row(dg, v, NULL);
+		return (size_t) iscc_varint_read(&pos);
+	}
+	if (dg->fixed_degree == 0) return (iscc_ArcIndex) (dg->tail_ptr[v + 1] - dg->tail_ptr[v]);
+	if ((dg->valid_tails != NULL) && !iscc_bitset_test(dg->valid_tails, v)) return 0;
+	return dg->fixed_degree;
+}
+
+
+static inline size_t iscc_digraph_num_arcs(const iscc_Digraph* const dg)
+{
+	if (dg->packed_rows != NULL) return dg->max_arcs;
+	return iscc_digraph_row_begin(dg, dg->vertices);
+}
+
+
+/** Reads the row of vertex \p v.
+ *
+ *  Returns the heads of the arcs of \p v and writes their number to \p out_len. For compressed
+ *  digraphs, the row is decoded to the buffer of \p reader and is valid until the reader is
+ *  used again. Otherwise, the returned pointer points into scc_Digraph::head.
+ */
+static inline const scc_PointIndex* iscc_digraph_read_row(const iscc_Digraph* const dg,
+                                                          const size_t v,
+                                                          iscc_DigraphRowReader* const reader,
+                                                          size_t* const out_len)
+{
+	if (dg->packed_rows == NULL) {
+		const size_t begin = iscc_digraph_row_begin(dg, v);
+		*out_len = iscc_digraph_row_end(dg, v) - begin;
+		return dg->head + begin;
+	}
+
+	const uint8_t* pos = iscc_digraph_seek_row(dg, v, reader);
+	const size_t degree = (size_t) iscc_varint_read(&pos);
+	if (degree > 0) {
+		const uint64_t first = iscc_varint_read(&pos);
+		uint64_t head = (first & 1u) ? ((uint64_t) v - (first >> 1) - 1u) : ((uint64_t) v + (first >> 1));
+		reader->row[0] = (scc_PointIndex) head;
+		for (size_t i = 1; i < degree; ++i) {
+			head += iscc_varint_read(&pos);
+			reader->row[i] = (scc_PointIndex) head;
+		}
+	}
+	reader->next_vertex = v + 1;
+	reader->next_row = pos;
+
+	*out_len = degree;
+	return reader->row;
+}
+
+
 #endif // ifndef SCC_DIGRAPH_CORE_HG
@@ -42,7 +42,7 @@ bool iscc_is_balanced_digraph(const iscc_Digraph* const dg,
 	if (!iscc_digraph_is_valid(dg)) return false;
 
 	for (size_t i = 0; i <= dg->vertices; ++i) {
-		if (dg->tail_ptr[i] != i * arcs_per_vertex) return false;
+		if (iscc_digraph_row_begin(dg, i) != i * arcs_per_vertex) return false;
 	}
 
 	return true;
@@ -55,39 +55,41 @@ bool iscc_digraphs_equal(const iscc_Digraph* const dg_a,
 	assert(iscc_digraph_is_valid(dg_a));
 	assert(iscc_digraph_is_valid(dg_b));
 	if (dg_a->vertices != dg_b->vertices) return false;
-	if ((dg_a->tail_ptr[dg_a->vertices] == 0) && (dg_b->tail_ptr[dg_b->vertices] == 0)) return true;
+	if ((iscc_digraph_num_arcs(dg_a) == 0) && (iscc_digraph_num_arcs(dg_b) == 0)) return true;
 
 	int_fast8_t* const single_row = calloc(dg_a->vertices, sizeof(int_fast8_t));
-
-	for (size_t v = 0; v < dg_a->vertices; ++v) {
-		const scc_PointIndex* const arc_a_stop = dg_a->head + dg_a->tail_ptr[v + 1];
-		for (const scc_PointIndex* arc_a = dg_a->head + dg_a->tail_ptr[v];
-		        arc_a != arc_a_stop; ++arc_a) {
-			single_row[*arc_a] = 1;
+	iscc_DigraphRowReader reader_a, reader_b;
+	iscc_init_row_reader(dg_a, &reader_a);
+	iscc_init_row_reader(dg_b, &reader_b);
+
+	bool equal = true;
+	for (size_t v = 0; equal && (v < dg_a->vertices); ++v) {
+		size_t len_a, len_b;
+		const scc_PointIndex* const row_a = iscc_digraph_read_row(dg_a, v, &reader_a, &len_a);
+		for (size_t i = 0; i < len_a; ++i) {
+			single_row[row_a[i]] = 1;
 		}
 
-		const scc_PointIndex* const arc_b_stop = dg_b->head + dg_b->tail_ptr[v + 1];
-		for (const scc_PointIndex* arc_b = dg_b->head + dg_b->tail_ptr[v];
-		        arc_b != arc_b_stop; ++arc_b) {
-			if (single_row[*arc_b] == 0) {
-				free(single_row);
-				return false;
+		const scc_PointIndex* const row_b = iscc_digraph_read_row(dg_b, v, &reader_b, &len_b);
+		for (size_t i = 0; i < len_b; ++i) {
+			if (single_row[row_b[i]] == 0) {
+				equal = false;
+				break;
 			}
-			single_row[*arc_b] = 2;
+			single_row[row_b[i]] = 2;
 		}
 
 		for (size_t i = 0; i < dg_a->vertices; ++i) {
-			if (single_row[i] == 1) {
-				free(single_row);
-				return false;
-			}
+			if (single_row[i] == 1) equal = false;
 			single_row[i] = 0;
 		}
 	}
 
+	iscc_free_row_reader(&reader_a);
+	iscc_free_row_reader(&reader_b);
 	free(single_row);
 
-	return true;
+	return equal;
 }
 
 
@@ -172,14 +174,34 @@ scc_ErrorCode iscc_copy_digraph(const iscc_Digraph* const in_dg,
 	if (in_dg->vertices == 0) return iscc_empty_digraph(0, 0, out_dg);
 
 	const size_t num_vertices = in_dg->vertices;
-	const uintmax_t num_arcs = in_dg->tail_ptr[in_dg->vertices];
+	const uintmax_t num_arcs = iscc_digraph_num_arcs(in_dg);
+
+	if (iscc_digraph_is_compressed(in_dg)) {
+		const size_t num_strides = (num_vertices + ISCC_DIGRAPH_PACKED_STRIDE - 1) / ISCC_DIGRAPH_PACKED_STRIDE;
+		const size_t len_packed = in_dg->packed_ptr[num_strides];
+		*out_dg = *in_dg;
+		out_dg->packed_rows = malloc(len_packed + 1);
+		out_dg->packed_ptr = malloc(sizeof(size_t[num_strides + 1]));
+		if ((out_dg->packed_rows == NULL) || (out_dg->packed_ptr == NULL)) {
+			iscc_free_digraph(out_dg);
+			return iscc_make_error(SCC_ER_NO_MEMORY);
+		}
+		memcpy(out_dg->packed_rows, in_dg->packed_rows, len_packed);
+		memcpy(out_dg->packed_ptr, in_dg->packed_ptr, (num_strides + 1) * sizeof(size_t));
+		return iscc_no_error();
+	}
 
 	if ((ec = iscc_init_digraph(num_vertices, num_arcs, out_dg)) != SCC_ER_OK) return ec;
 
-	memcpy(out_dg->tail_ptr, in_dg->tail_ptr, (num_vertices + 1) * sizeof(iscc_ArcIndex));
+	for (size_t v = 0; v <= num_vertices; ++v) {
+		out_dg->tail_ptr[v] = (iscc_ArcIndex) iscc_digraph_row_begin(in_dg, v);
+	}
 	if (num_arcs > 0) {
 		memcpy(out_dg->head, in_dg->head, num_arcs * sizeof(scc_PointIndex));
 	}
+	if (out_dg->segment_ptr != NULL) {
+		memcpy(out_dg->segment_ptr, in_dg->segment_ptr, (num_vertices / ISCC_DIGRAPH_SEGMENT_ROWS + 1) * sizeof(size_t));
+	}
 
 	return iscc_no_error();
 }
@@ -200,11 +222,18 @@ void iscc_print_digraph(const iscc_Digraph* const dg)
 		return;
 	}
 
+	iscc_DigraphRowReader reader;
+	if (iscc_init_row_reader(dg, &reader) != SCC_ER_OK) {
+		free(single_row);
+		printf("Out of memory.\n\n");
+		return;
+	}
+
 	for (size_t v = 0; v < dg->vertices; ++v) {
-		const scc_PointIndex* const a_stop = dg->head + dg->tail_ptr[v + 1];
-		for (const scc_PointIndex* a = dg->head + dg->tail_ptr[v];
-		        a != a_stop; ++a) {
-			single_row[*a] = true;
+		size_t len_row;
+		const scc_PointIndex* const row = iscc_digraph_read_row(dg, v, &reader, &len_row);
+		for (size_t i = 0; i < len_row; ++i) {
+			single_row[row[i]] = true;
 		}
 
 		for (size_t i = 0; i < dg->vertices; ++i) {
@@ -220,5 +249,6 @@ void iscc_print_digraph(const iscc_Digraph* const dg)
 	}
 	putchar('\n');
 
+	iscc_free_row_reader(&reader);
 	free(single_row);
 }
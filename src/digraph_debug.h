@@ -121,6 +121,7 @@ scc_ErrorCode iscc_digraph_from_string(const char dg_str[],
  *
  *  \note This function allocates memory space to fit the arcs actually in \p dg. If \p dg
  *        contains excess space, scc_Digraph::max_arcs will differ between the original and copy.
+ *        The copy of a fixed-degree digraph is in sparse matrix format.
  */
 scc_ErrorCode iscc_copy_digraph(const iscc_Digraph* in_dg,
                                 iscc_Digraph* out_dg);
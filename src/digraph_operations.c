@@ -21,6 +21,7 @@
 #include "digraph_operations.h"
 
 #include <assert.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -29,11 +30,88 @@
 #include "error.h"
 #include "scclust_types.h"
 
+#ifdef _OPENMP
+	#include <omp.h>
+#endif // ifdef _OPENMP
+
+
+// =============================================================================
+// Internal variables
+// =============================================================================
+
+// Minimum number of rows per thread in the parallel operations
+static const size_t ISCC_DG_MIN_ROWS_PER_THREAD = 1024;
+
+// Threads always allowed by the scratch limit in the parallel operations
+static const size_t ISCC_DG_MIN_SCRATCH_THREADS = 2;
+
+// Rows handed out to threads at a time in the parallel operations
+#define ISCC_DG_ROW_CHUNK 64
+
 
 // =============================================================================
 // Static function prototypes
 // =============================================================================
 
+static inline size_t iscc_dg_use_threads(uint32_t num_threads,
+                                         size_t rows,
+                                         size_t vertices,
+                                         uintmax_t input_arcs);
+
+
+static scc_ErrorCode iscc_parallel_union_and_delete(uint_fast16_t num_dgs,
+                                                    const iscc_Digraph dgs[static num_dgs],
+                                                    size_t len_tails_to_keep,
+                                                    const scc_PointIndex tails_to_keep[],
+                                                    bool keep_self_loops,
+                                                    size_t use_threads,
+                                                    iscc_Digraph* out_dg);
+
+
+static scc_ErrorCode iscc_parallel_transpose(const iscc_Digraph* in_dg,
+                                             size_t use_threads,
+                                             iscc_Digraph* out_dg);
+
+
+static scc_ErrorCode iscc_parallel_adjacency_product(const iscc_Digraph* dg_a,
+                                                     const iscc_Digraph* dg_b,
+                                                     bool force_loops,
+                                                     size_t use_threads,
+                                                     iscc_Digraph* out_dg);
+
+
+static scc_ErrorCode iscc_compressed_transpose(const iscc_Digraph* in_dg,
+                                               iscc_Digraph* out_dg);
+
+
+static scc_ErrorCode iscc_dg_allocate_rows(iscc_Digraph* out_dg);
+
+
+static scc_ErrorCode iscc_dg_allocate_transpose_rows(iscc_Digraph* out_dg);
+
+
+static bool iscc_fixed_digraph_has_one_loop(const iscc_Digraph* dg);
+
+
+static scc_ErrorCode iscc_delete_fixed_loops(iscc_Digraph* dg);
+
+
+static inline size_t iscc_union_row(uint_fast16_t num_dgs,
+                                    const iscc_Digraph dgs[restrict static num_dgs],
+                                    scc_PointIndex v,
+                                    bool keep_self_loops,
+                                    scc_PointIndex row_markers[restrict],
+                                    scc_PointIndex out_row[restrict]);
+
+
+static inline size_t iscc_adjacency_product_row(const iscc_Digraph* dg_a,
+                                                const iscc_Digraph* dg_b,
+                                                scc_PointIndex v,
+                                                bool force_loops,
+                                                scc_PointIndex row_markers[restrict],
+                                                scc_PointIndex out_row[restrict]);
+
+
 static inline uintmax_t iscc_do_union_and_delete(uint_fast16_t num_dgs,
                                                  const iscc_Digraph dgs[restrict static num_dgs],
                                                  scc_PointIndex row_markers[restrict],
@@ -65,13 +143,19 @@ scc_ErrorCode iscc_delete_loops(iscc_Digraph* const dg)
 	if (iscc_digraph_is_empty(dg)) return iscc_no_error();
 	assert(dg->head != NULL);
 
-	iscc_ArcIndex head_write = 0;
+	scc_ErrorCode ec;
+	if (iscc_digraph_is_fixed(dg)) {
+		if (iscc_fixed_digraph_has_one_loop(dg)) return iscc_delete_fixed_loops(dg);
+		if ((ec = iscc_digraph_make_csr(dg)) != SCC_ER_OK) return ec;
+	}
+
+	size_t head_write = 0;
 	assert(dg->vertices <= ISCC_POINTINDEX_MAX);
 	const scc_PointIndex vertices = (scc_PointIndex) dg->vertices; // If `scc_PointIndex` is signed
 	for (scc_PointIndex v = 0; v < vertices; ++v) {
-		const scc_PointIndex* v_arc = dg->head + dg->tail_ptr[v];
-		const scc_PointIndex* const v_arc_stop = dg->head + dg->tail_ptr[v + 1];
-		dg->tail_ptr[v] = head_write;
+		const scc_PointIndex* v_arc = dg->head + iscc_digraph_row_begin(dg, v);
+		const scc_PointIndex* const v_arc_stop = dg->head + iscc_digraph_row_end(dg, v);
+		dg->tail_ptr[v] = (iscc_ArcIndex) head_write;
 
 		for (; v_arc != v_arc_stop; ++v_arc) {
 			if (*v_arc != v) {
@@ -80,7 +164,7 @@ scc_ErrorCode iscc_delete_loops(iscc_Digraph* const dg)
 			}
 		}
 	}
-	dg->tail_ptr[vertices] = head_write;
+	dg->tail_ptr[vertices] = (iscc_ArcIndex) head_write;
 
 	return iscc_change_arc_storage(dg, head_write);
 }
@@ -91,6 +175,7 @@ scc_ErrorCode iscc_digraph_union_and_delete(const uint_fast16_t num_in_dgs,
                                             const size_t len_tails_to_keep,
                                             const scc_PointIndex tails_to_keep[const],
                                             const bool keep_self_loops,
+                                            const uint32_t num_threads,
                                             iscc_Digraph* const out_dg)
 {
 	assert(num_in_dgs > 0);
@@ -105,7 +190,16 @@ scc_ErrorCode iscc_digraph_union_and_delete(const uint_fast16_t num_in_dgs,
 	for (uint_fast16_t i = 0; i < num_in_dgs; ++i) {
 		assert(iscc_digraph_is_valid(&in_dgs[i]));
 		assert(in_dgs[i].vertices == vertices);
-		out_arcs_write += in_dgs[i].tail_ptr[vertices];
+		out_arcs_write += iscc_digraph_num_arcs(&in_dgs[i]);
+	}
+
+	const size_t use_threads = iscc_dg_use_threads(num_threads,
+	                                               (tails_to_keep == NULL) ? vertices : len_tails_to_keep,
+	                                               vertices,
+	                                               out_arcs_write);
+	if (use_threads > 1) {
+		return iscc_parallel_union_and_delete(num_in_dgs, in_dgs, len_tails_to_keep, tails_to_keep,
+		                                      keep_self_loops, use_threads, out_dg);
 	}
 
 	scc_PointIndex* const row_markers = malloc(sizeof(scc_PointIndex[vertices]));
@@ -152,12 +246,16 @@ scc_ErrorCode iscc_digraph_difference(iscc_Digraph* const minuend_dg,
 	assert(iscc_digraph_is_valid(subtrahend_dg));
 	assert(minuend_dg->vertices > 0);
 	assert(minuend_dg->vertices == subtrahend_dg->vertices);
-	assert((subtrahend_dg->tail_ptr[minuend_dg->vertices] == 0) || (subtrahend_dg->head != NULL));
+	assert(iscc_digraph_is_empty(subtrahend_dg) || (subtrahend_dg->head != NULL));
 	assert(max_out_degree > 0);
 
 	if (iscc_digraph_is_empty(minuend_dg)) return iscc_no_error();
 	assert(minuend_dg->head != NULL);
 
+	// Rows change length, so fixed-degree minuends are converted
+	scc_ErrorCode ec;
+	if ((ec = iscc_digraph_make_csr(minuend_dg)) != SCC_ER_OK) return ec;
+
 	scc_PointIndex* const row_markers = malloc(sizeof(scc_PointIndex[minuend_dg->vertices]));
 	if (row_markers == NULL) return iscc_make_error(SCC_ER_NO_MEMORY);
 
@@ -166,20 +264,20 @@ scc_ErrorCode iscc_digraph_difference(iscc_Digraph* const minuend_dg,
 	}
 
 	uint32_t row_counter;
-	iscc_ArcIndex out_arcs_write = 0;
+	size_t out_arcs_write = 0;
 	assert(minuend_dg->vertices <= ISCC_POINTINDEX_MAX);
 	const scc_PointIndex vertices = (scc_PointIndex) minuend_dg->vertices; // If `scc_PointIndex` is signed
 	for (scc_PointIndex v = 0; v < vertices; ++v) {
-		const scc_PointIndex* const v_arc_s_stop = subtrahend_dg->head + subtrahend_dg->tail_ptr[v + 1];
-		for (const scc_PointIndex* v_arc_s = subtrahend_dg->head + subtrahend_dg->tail_ptr[v];
+		const scc_PointIndex* const v_arc_s_stop = subtrahend_dg->head + iscc_digraph_row_end(subtrahend_dg, v);
+		for (const scc_PointIndex* v_arc_s = subtrahend_dg->head + iscc_digraph_row_begin(subtrahend_dg, v);
 		        v_arc_s != v_arc_s_stop; ++v_arc_s) {
 			row_markers[*v_arc_s] = v;
 		}
 
 		row_counter = 0;
-		const scc_PointIndex* arc_m = minuend_dg->head + minuend_dg->tail_ptr[v];
-		const scc_PointIndex* const arc_m_stop = minuend_dg->head + minuend_dg->tail_ptr[v + 1];
-		minuend_dg->tail_ptr[v] = out_arcs_write;
+		const scc_PointIndex* arc_m = minuend_dg->head + iscc_digraph_row_begin(minuend_dg, v);
+		const scc_PointIndex* const arc_m_stop = minuend_dg->head + iscc_digraph_row_end(minuend_dg, v);
+		minuend_dg->tail_ptr[v] = (iscc_ArcIndex) out_arcs_write;
 		for (; ((row_counter < max_out_degree) && (arc_m != arc_m_stop)); ++arc_m) {
 			if (row_markers[*arc_m] != v) {
 				minuend_dg->head[out_arcs_write] = *arc_m;
@@ -188,7 +286,7 @@ scc_ErrorCode iscc_digraph_difference(iscc_Digraph* const minuend_dg,
 			}
 		}
 	}
-	minuend_dg->tail_ptr[vertices] = out_arcs_write;
+	minuend_dg->tail_ptr[vertices] = (iscc_ArcIndex) out_arcs_write;
 
 	free(row_markers);
 
@@ -197,39 +295,47 @@ scc_ErrorCode iscc_digraph_difference(iscc_Digraph* const minuend_dg,
 
 
 scc_ErrorCode iscc_digraph_transpose(const iscc_Digraph* const in_dg,
+                                     const uint32_t num_threads,
                                      iscc_Digraph* const out_dg)
 {
 	assert(iscc_digraph_is_valid(in_dg));
 	assert(in_dg->vertices > 0);
 	assert(out_dg != NULL);
 
-	scc_ErrorCode ec;
-	if ((ec = iscc_empty_digraph(in_dg->vertices, in_dg->tail_ptr[in_dg->vertices], out_dg)) != SCC_ER_OK) {
-		return ec;
+	const size_t use_threads = iscc_dg_use_threads(num_threads,
+	                                               in_dg->vertices,
+	                                               in_dg->vertices,
+	                                               iscc_digraph_num_arcs(in_dg));
+	if ((use_threads > 1) && !iscc_digraph_is_compressed(in_dg)) {
+		return iscc_parallel_transpose(in_dg, use_threads, out_dg);
 	}
 
+	scc_ErrorCode ec;
+	if ((ec = iscc_empty_digraph(in_dg->vertices, 0, out_dg)) != SCC_ER_OK) return ec;
+
 	if (iscc_digraph_is_empty(in_dg)) return iscc_no_error();
+	if (iscc_digraph_is_compressed(in_dg)) return iscc_compressed_transpose(in_dg, out_dg);
 	assert(in_dg->head != NULL);
-	assert(out_dg->head != NULL);
 
-	const scc_PointIndex* const arc_c_stop = in_dg->head + in_dg->tail_ptr[in_dg->vertices];
+	const scc_PointIndex* const arc_c_stop = in_dg->head + iscc_digraph_row_begin(in_dg, in_dg->vertices);
 	for (const scc_PointIndex* arc_c = in_dg->head;
 	        arc_c != arc_c_stop; ++arc_c) {
-		++out_dg->tail_ptr[*arc_c];
+		++out_dg->tail_ptr[*arc_c + 1];
 	}
 
-	for (size_t v = 0; v < in_dg->vertices; ++v) {
-		out_dg->tail_ptr[v + 1] += out_dg->tail_ptr[v];
+	if ((ec = iscc_dg_allocate_transpose_rows(out_dg)) != SCC_ER_OK) {
+		iscc_free_digraph(out_dg);
+		return ec;
 	}
 
 	assert(in_dg->vertices <= ISCC_POINTINDEX_MAX);
 	const scc_PointIndex vertices = (scc_PointIndex) in_dg->vertices; // If `scc_PointIndex` is signed
 	for (scc_PointIndex v = 0; v < vertices; ++v) {
-		const scc_PointIndex* const arc_stop = in_dg->head + in_dg->tail_ptr[v + 1];
-		for (const scc_PointIndex* arc = in_dg->head + in_dg->tail_ptr[v];
+		const scc_PointIndex* const arc_stop = in_dg->head + iscc_digraph_row_end(in_dg, v);
+		for (const scc_PointIndex* arc = in_dg->head + iscc_digraph_row_begin(in_dg, v);
 		        arc != arc_stop; ++arc) {
 			--out_dg->tail_ptr[*arc];
-			out_dg->head[out_dg->tail_ptr[*arc]] = v;
+			out_dg->head[iscc_digraph_unwrap_arc(out_dg, *arc, out_dg->tail_ptr[*arc])] = v;
 		}
 	}
 
@@ -240,6 +346,7 @@ scc_ErrorCode iscc_digraph_transpose(const iscc_Digraph* const in_dg,
 scc_ErrorCode iscc_adjacency_product(const iscc_Digraph* const in_dg_a,
                                      const iscc_Digraph* const in_dg_b,
                                      const bool force_loops,
+                                     const uint32_t num_threads,
                                      iscc_Digraph* const out_dg)
 {
 	assert(iscc_digraph_is_valid(in_dg_a));
@@ -252,16 +359,24 @@ scc_ErrorCode iscc_adjacency_product(const iscc_Digraph* const in_dg_a,
 
 	const size_t vertices = in_dg_a->vertices;
 
+	const size_t use_threads = iscc_dg_use_threads(num_threads,
+	                                               vertices,
+	                                               vertices,
+	                                               iscc_digraph_num_arcs(in_dg_a) + iscc_digraph_num_arcs(in_dg_b));
+	if (use_threads > 1) {
+		return iscc_parallel_adjacency_product(in_dg_a, in_dg_b, force_loops, use_threads, out_dg);
+	}
+
 	scc_PointIndex* const row_markers = malloc(sizeof(scc_PointIndex[vertices]));
 	if (row_markers == NULL) return iscc_make_error(SCC_ER_NO_MEMORY);
 
 	// Try greedy memory count first
 	uintmax_t out_arcs_write = 0;
-	const scc_PointIndex* const arc_a_stop = in_dg_a->head + in_dg_a->tail_ptr[vertices];
+	const scc_PointIndex* const arc_a_stop = in_dg_a->head + iscc_digraph_num_arcs(in_dg_a);
 	for (const scc_PointIndex* arc_a = in_dg_a->head; arc_a != arc_a_stop; ++arc_a) {
-		out_arcs_write += in_dg_b->tail_ptr[*arc_a + 1] - in_dg_b->tail_ptr[*arc_a];
+		out_arcs_write += iscc_digraph_out_degree(in_dg_b, (size_t) *arc_a);
 	}
-	if (force_loops) out_arcs_write += in_dg_b->tail_ptr[vertices];
+	if (force_loops) out_arcs_write += iscc_digraph_num_arcs(in_dg_b);
 
 	scc_ErrorCode ec;
 	if (iscc_init_digraph(vertices, out_arcs_write, out_dg) != SCC_ER_OK) {
@@ -335,8 +450,8 @@ static inline uintmax_t iscc_do_union_and_delete(const uint_fast16_t num_dgs,
 		for (scc_PointIndex v = 0; v < vertices; ++v) {
 			if (!keep_self_loops) row_markers[v] = v;
 			for (uint_fast16_t i = 0; i < num_dgs; ++i) {
-				const scc_PointIndex* const arc_i_stop = dgs[i].head + dgs[i].tail_ptr[v + 1];
-				for (const scc_PointIndex* arc_i = dgs[i].head + dgs[i].tail_ptr[v];
+				const scc_PointIndex* const arc_i_stop = dgs[i].head + iscc_digraph_row_end(&dgs[i], v);
+				for (const scc_PointIndex* arc_i = dgs[i].head + iscc_digraph_row_begin(&dgs[i], v);
 				        arc_i != arc_i_stop; ++arc_i) {
 					if (row_markers[*arc_i] != v) {
 						row_markers[*arc_i] = v;
@@ -350,8 +465,8 @@ static inline uintmax_t iscc_do_union_and_delete(const uint_fast16_t num_dgs,
 		for (size_t v = 0; v < len_tails_to_keep; ++v) {
 			if (!keep_self_loops) row_markers[tails_to_keep[v]] = tails_to_keep[v];
 			for (uint_fast16_t i = 0; i < num_dgs; ++i) {
-				const scc_PointIndex* const arc_i_stop = dgs[i].head + dgs[i].tail_ptr[tails_to_keep[v] + 1];
-				for (const scc_PointIndex* arc_i = dgs[i].head + dgs[i].tail_ptr[tails_to_keep[v]];
+				const scc_PointIndex* const arc_i_stop = dgs[i].head + iscc_digraph_row_end(&dgs[i], tails_to_keep[v]);
+				for (const scc_PointIndex* arc_i = dgs[i].head + iscc_digraph_row_begin(&dgs[i], tails_to_keep[v]);
 				        arc_i != arc_i_stop; ++arc_i) {
 					if (row_markers[*arc_i] != tails_to_keep[v]) {
 						row_markers[*arc_i] = tails_to_keep[v];
@@ -367,8 +482,8 @@ static inline uintmax_t iscc_do_union_and_delete(const uint_fast16_t num_dgs,
 		for (scc_PointIndex v = 0; v < vertices; ++v) {
 			if (!keep_self_loops) row_markers[v] = v;
 			for (uint_fast16_t i = 0; i < num_dgs; ++i) {
-				const scc_PointIndex* const arc_i_stop = dgs[i].head + dgs[i].tail_ptr[v + 1];
-				for (const scc_PointIndex* arc_i = dgs[i].head + dgs[i].tail_ptr[v];
+				const scc_PointIndex* const arc_i_stop = dgs[i].head + iscc_digraph_row_end(&dgs[i], v);
+				for (const scc_PointIndex* arc_i = dgs[i].head + iscc_digraph_row_begin(&dgs[i], v);
 				        arc_i != arc_i_stop; ++arc_i) {
 					if (row_markers[*arc_i] != v) {
 						row_markers[*arc_i] = v;
@@ -391,8 +506,8 @@ static inline uintmax_t iscc_do_union_and_delete(const uint_fast16_t num_dgs,
 				++next_tail_to_keep;
 				if (!keep_self_loops) row_markers[v] = v;
 				for (uint_fast16_t i = 0; i < num_dgs; ++i) {
-					const scc_PointIndex* const arc_i_stop = dgs[i].head + dgs[i].tail_ptr[v + 1];
-					for (const scc_PointIndex* arc_i = dgs[i].head + dgs[i].tail_ptr[v];
+					const scc_PointIndex* const arc_i_stop = dgs[i].head + iscc_digraph_row_end(&dgs[i], v);
+					for (const scc_PointIndex* arc_i = dgs[i].head + iscc_digraph_row_begin(&dgs[i], v);
 					        arc_i != arc_i_stop; ++arc_i) {
 						if (row_markers[*arc_i] != v) {
 							row_markers[*arc_i] = v;
@@ -431,9 +546,7 @@ static inline uintmax_t iscc_do_adjacency_product(const iscc_Digraph* const dg_a
 	assert(dg_a->vertices <= ISCC_POINTINDEX_MAX);
 	const scc_PointIndex vertices = (scc_PointIndex) dg_a->vertices; // If `scc_PointIndex` is signed
 
-	const iscc_ArcIndex* const dg_a_tail_ptr = dg_a->tail_ptr;
 	const scc_PointIndex* const dg_a_head = dg_a->head;
-	const iscc_ArcIndex* const dg_b_tail_ptr = dg_b->tail_ptr;
 	const scc_PointIndex* const dg_b_head = dg_b->head;
 
 	for (scc_PointIndex v = 0; v < vertices; ++v) {
@@ -444,8 +557,8 @@ static inline uintmax_t iscc_do_adjacency_product(const iscc_Digraph* const dg_a
 		for (scc_PointIndex v = 0; v < vertices; ++v) {
 			row_markers[v] = v;
 			if (force_loops) {
-				const scc_PointIndex* const v_arc_b_stop = dg_b_head + dg_b_tail_ptr[v + 1];
-				for (const scc_PointIndex* v_arc_b = dg_b_head + dg_b_tail_ptr[v];
+				const scc_PointIndex* const v_arc_b_stop = dg_b_head + iscc_digraph_row_end(dg_b, v);
+				for (const scc_PointIndex* v_arc_b = dg_b_head + iscc_digraph_row_begin(dg_b, v);
 				        v_arc_b != v_arc_b_stop; ++v_arc_b) {
 					if (row_markers[*v_arc_b] != v) {
 						row_markers[*v_arc_b] = v;
@@ -453,11 +566,11 @@ static inline uintmax_t iscc_do_adjacency_product(const iscc_Digraph* const dg_a
 					}
 				}
 			}
-			const scc_PointIndex* const arc_a_stop = dg_a_head + dg_a_tail_ptr[v + 1];
-			for (const scc_PointIndex* arc_a = dg_a_head + dg_a_tail_ptr[v];
+			const scc_PointIndex* const arc_a_stop = dg_a_head + iscc_digraph_row_end(dg_a, v);
+			for (const scc_PointIndex* arc_a = dg_a_head + iscc_digraph_row_begin(dg_a, v);
 			        arc_a != arc_a_stop; ++arc_a) {
-				const scc_PointIndex* const arc_b_stop = dg_b_head + dg_b_tail_ptr[*arc_a + 1];
-				for (const scc_PointIndex* arc_b = dg_b_head + dg_b_tail_ptr[*arc_a];
+				const scc_PointIndex* const arc_b_stop = dg_b_head + iscc_digraph_row_end(dg_b, *arc_a);
+				for (const scc_PointIndex* arc_b = dg_b_head + iscc_digraph_row_begin(dg_b, *arc_a);
 				        arc_b != arc_b_stop; ++arc_b) {
 					if (row_markers[*arc_b] != v) {
 						row_markers[*arc_b] = v;
@@ -475,8 +588,8 @@ static inline uintmax_t iscc_do_adjacency_product(const iscc_Digraph* const dg_a
 		for (scc_PointIndex v = 0; v < vertices; ++v) {
 			row_markers[v] = v;
 			if (force_loops) {
-				const scc_PointIndex* const v_arc_b_stop = dg_b_head + dg_b_tail_ptr[v + 1];
-				for (const scc_PointIndex* v_arc_b = dg_b_head + dg_b_tail_ptr[v];
+				const scc_PointIndex* const v_arc_b_stop = dg_b_head + iscc_digraph_row_end(dg_b, v);
+				for (const scc_PointIndex* v_arc_b = dg_b_head + iscc_digraph_row_begin(dg_b, v);
 				        v_arc_b != v_arc_b_stop; ++v_arc_b) {
 					if (row_markers[*v_arc_b] != v) {
 						row_markers[*v_arc_b] = v;
@@ -485,11 +598,11 @@ static inline uintmax_t iscc_do_adjacency_product(const iscc_Digraph* const dg_a
 					}
 				}
 			}
-			const scc_PointIndex* const arc_a_stop = dg_a_head + dg_a_tail_ptr[v + 1];
-			for (const scc_PointIndex* arc_a = dg_a_head + dg_a_tail_ptr[v];
+			const scc_PointIndex* const arc_a_stop = dg_a_head + iscc_digraph_row_end(dg_a, v);
+			for (const scc_PointIndex* arc_a = dg_a_head + iscc_digraph_row_begin(dg_a, v);
 			        arc_a != arc_a_stop; ++arc_a) {
-				const scc_PointIndex* const arc_b_stop = dg_b_head + dg_b_tail_ptr[*arc_a + 1];
-				for (const scc_PointIndex* arc_b = dg_b_head + dg_b_tail_ptr[*arc_a];
+				const scc_PointIndex* const arc_b_stop = dg_b_head + iscc_digraph_row_end(dg_b, *arc_a);
+				for (const scc_PointIndex* arc_b = dg_b_head + iscc_digraph_row_begin(dg_b, *arc_a);
 				        arc_b != arc_b_stop; ++arc_b) {
 					if (row_markers[*arc_b] != v) {
 						row_markers[*arc_b] = v;
@@ -504,3 +617,479 @@ static inline uintmax_t iscc_do_adjacency_product(const iscc_Digraph* const dg_a
 
 	return counter;
 }
+
+
+/* The parallel operations use `vertices` elements of scratch per thread. Beyond
+ * #ISCC_DG_MIN_SCRATCH_THREADS, threads are only added while the total scratch stays
+ * within the number of arcs in the inputs, so the scratch is O(vertices + arcs)
+ * rather than O(threads * vertices) when the digraphs are sparse.
+ */
+static inline size_t iscc_dg_use_threads(const uint32_t num_threads,
+                                         const size_t rows,
+                                         const size_t vertices,
+                                         const uintmax_t input_arcs)
+{
+	size_t use_threads = num_threads;
+	#ifdef _OPENMP
+		if (use_threads == 0) use_threads = (size_t) omp_get_max_threads();
+		if (use_threads > INT_MAX) use_threads = INT_MAX;
+	#endif // ifdef _OPENMP
+
+	const size_t max_threads = rows / ISCC_DG_MIN_ROWS_PER_THREAD;
+	if (use_threads > max_threads) use_threads = max_threads;
+
+	if ((use_threads > ISCC_DG_MIN_SCRATCH_THREADS) && (vertices > 0)) {
+		const uintmax_t scratch_threads = input_arcs / vertices;
+		if (scratch_threads < use_threads) {
+			use_threads = (scratch_threads > ISCC_DG_MIN_SCRATCH_THREADS) ? (size_t) scratch_threads : ISCC_DG_MIN_SCRATCH_THREADS;
+		}
+	}
+
+	return (use_threads > 1) ? use_threads : 1;
+}
+
+
+/* The parallel union and product make two passes. The first writes the length of each
+ * row to `out_dg->tail_ptr`, and the second writes the rows themselves at the offsets
+ * given by the prefix sum of the lengths. Each thread has its own `row_markers`, so the
+ * scratch is `use_threads * vertices` (bounded by #iscc_dg_use_threads). As rows are
+ * derived in the same way as in the serial functions, the output is identical.
+ */
+static scc_ErrorCode iscc_parallel_union_and_delete(const uint_fast16_t num_dgs,
+                                                    const iscc_Digraph dgs[const static num_dgs],
+                                                    const size_t len_tails_to_keep,
+                                                    const scc_PointIndex tails_to_keep[const],
+                                                    const bool keep_self_loops,
+                                                    const size_t use_threads,
+                                                    iscc_Digraph* const out_dg)
+{
+	assert(num_dgs > 0);
+	assert(use_threads > 1);
+	assert(out_dg != NULL);
+
+	const size_t vertices = dgs[0].vertices;
+	const size_t num_rows = (tails_to_keep == NULL) ? vertices : len_tails_to_keep;
+	assert(num_rows <= ISCC_POINTINDEX_MAX);
+
+	#ifndef NDEBUG
+		for (uint_fast16_t i = 0; i < num_dgs; ++i) {
+			assert(iscc_digraph_is_valid(&dgs[i]));
+			assert(dgs[i].vertices == vertices);
+		}
+		for (size_t r = 1; (tails_to_keep != NULL) && (r < len_tails_to_keep); ++r) {
+			assert(tails_to_keep[r - 1] < tails_to_keep[r]);
+		}
+	#endif
+
+	scc_ErrorCode ec;
+	if ((ec = iscc_empty_digraph(vertices, 0, out_dg)) != SCC_ER_OK) return ec;
+
+	scc_PointIndex* const row_markers = malloc(sizeof(scc_PointIndex[use_threads * vertices]));
+	if (row_markers == NULL) {
+		iscc_free_digraph(out_dg);
+		return iscc_make_error(SCC_ER_NO_MEMORY);
+	}
+
+	for (int pass = 0; pass < 2; ++pass) {
+		if (pass == 1) {
+			if ((ec = iscc_dg_allocate_rows(out_dg)) != SCC_ER_OK) break;
+			if (iscc_digraph_is_empty(out_dg)) break;
+		}
+		iscc_ArcIndex* const tail_ptr = out_dg->tail_ptr;
+		scc_PointIndex* const head = out_dg->head;
+
+		#ifdef _OPENMP
+			#pragma omp parallel num_threads((int) use_threads)
+		#endif // ifdef _OPENMP
+		{
+			#ifdef _OPENMP
+				scc_PointIndex* const thread_markers = row_markers + ((size_t) omp_get_thread_num()) * vertices;
+			#else
+				scc_PointIndex* const thread_markers = row_markers;
+			#endif // ifdef _OPENMP
+			for (size_t v = 0; v < vertices; ++v) {
+				thread_markers[v] = ISCC_POINTINDEX_MAX_PI;
+			}
+
+			#ifdef _OPENMP
+				#pragma omp for schedule(dynamic, ISCC_DG_ROW_CHUNK)
+			#endif // ifdef _OPENMP
+			for (size_t r = 0; r < num_rows; ++r) {
+				const scc_PointIndex v = (tails_to_keep == NULL) ? (scc_PointIndex) r : tails_to_keep[r];
+				if (pass == 0) {
+					tail_ptr[v + 1] = (iscc_ArcIndex) iscc_union_row(num_dgs, dgs, v, keep_self_loops, thread_markers, NULL);
+				} else {
+					iscc_union_row(num_dgs, dgs, v, keep_self_loops, thread_markers, head + iscc_digraph_row_begin(out_dg, v));
+				}
+			}
+		}
+	}
+
+	free(row_markers);
+
+	if (ec != SCC_ER_OK) {
+		iscc_free_digraph(out_dg);
+		return ec;
+	}
+
+	return iscc_no_error();
+}
+
+
+/* Counting sort over blocks of tails. Each block counts its arcs per head, and writes
+ * them to its own segment of the head's row. Blocks with larger tails get segments
+ * earlier in the row, and each block fills its segments backwards, so that rows are
+ * ordered by descending tail as in the serial transpose. The counts take
+ * `use_threads * vertices` arc indices (bounded by #iscc_dg_use_threads).
+ */
+static scc_ErrorCode iscc_parallel_transpose(const iscc_Digraph* const in_dg,
+                                             const size_t use_threads,
+                                             iscc_Digraph* const out_dg)
+{
+	assert(iscc_digraph_is_valid(in_dg));
+	assert(use_threads > 1);
+	assert(out_dg != NULL);
+
+	const size_t vertices = in_dg->vertices;
+
+	scc_ErrorCode ec;
+	if ((ec = iscc_empty_digraph(vertices, 0, out_dg)) != SCC_ER_OK) return ec;
+
+	if (iscc_digraph_is_empty(in_dg)) return iscc_no_error();
+	assert(in_dg->head != NULL);
+
+	// `block_counts[b * vertices + h]` is the number of arcs to `h` from tails in block `b`
+	iscc_ArcIndex* const block_counts = calloc(use_threads * vertices, sizeof(iscc_ArcIndex));
+	if (block_counts == NULL) {
+		iscc_free_digraph(out_dg);
+		return iscc_make_error(SCC_ER_NO_MEMORY);
+	}
+
+	const scc_PointIndex* const in_head = in_dg->head;
+	iscc_ArcIndex* const out_tail_ptr = out_dg->tail_ptr;
+
+	#ifdef _OPENMP
+		#pragma omp parallel for schedule(static) num_threads((int) use_threads)
+	#endif // ifdef _OPENMP
+	for (size_t b = 0; b < use_threads; ++b) {
+		iscc_ArcIndex* const counts = block_counts + b * vertices;
+		const scc_PointIndex* const arc_stop = in_head + iscc_digraph_row_begin(in_dg, ((b + 1) * vertices) / use_threads);
+		for (const scc_PointIndex* arc = in_head + iscc_digraph_row_begin(in_dg, (b * vertices) / use_threads);
+		        arc != arc_stop; ++arc) {
+			++counts[*arc];
+		}
+	}
+
+	// Turn counts into the end of each block's segment, relative to the start of the row
+	#ifdef _OPENMP
+		#pragma omp parallel for schedule(static) num_threads((int) use_threads)
+	#endif // ifdef _OPENMP
+	for (size_t h = 0; h < vertices; ++h) {
+		iscc_ArcIndex row_count = 0;
+		for (size_t b = use_threads; b > 0; --b) {
+			row_count += block_counts[(b - 1) * vertices + h];
+			block_counts[(b - 1) * vertices + h] = row_count;
+		}
+		out_tail_ptr[h + 1] = row_count;
+	}
+
+	if ((ec = iscc_dg_allocate_rows(out_dg)) != SCC_ER_OK) {
+		free(block_counts);
+		iscc_free_digraph(out_dg);
+		return ec;
+	}
+	scc_PointIndex* const out_head = out_dg->head;
+
+	#ifdef _OPENMP
+		#pragma omp parallel for schedule(static) num_threads((int) use_threads)
+	#endif // ifdef _OPENMP
+	for (size_t b = 0; b < use_threads; ++b) {
+		iscc_ArcIndex* const counts = block_counts + b * vertices;
+		const scc_PointIndex block_stop = (scc_PointIndex) (((b + 1) * vertices) / use_threads);
+		for (scc_PointIndex v = (scc_PointIndex) ((b * vertices) / use_threads); v < block_stop; ++v) {
+			const scc_PointIndex* const arc_stop = in_head + iscc_digraph_row_end(in_dg, v);
+			for (const scc_PointIndex* arc = in_head + iscc_digraph_row_begin(in_dg, v);
+			        arc != arc_stop; ++arc) {
+				--counts[*arc];
+				out_head[iscc_digraph_row_begin(out_dg, *arc) + counts[*arc]] = v;
+			}
+		}
+	}
+
+	free(block_counts);
+
+	return iscc_no_error();
+}
+
+
+static scc_ErrorCode iscc_parallel_adjacency_product(const iscc_Digraph* const dg_a,
+                                                     const iscc_Digraph* const dg_b,
+                                                     const bool force_loops,
+                                                     const size_t use_threads,
+                                                     iscc_Digraph* const out_dg)
+{
+	assert(iscc_digraph_is_valid(dg_a));
+	assert(iscc_digraph_is_valid(dg_b));
+	assert(dg_a->vertices == dg_b->vertices);
+	assert(use_threads > 1);
+	assert(out_dg != NULL);
+
+	const size_t vertices = dg_a->vertices;
+	assert(vertices <= ISCC_POINTINDEX_MAX);
+
+	scc_ErrorCode ec;
+	if ((ec = iscc_empty_digraph(vertices, 0, out_dg)) != SCC_ER_OK) return ec;
+
+	scc_PointIndex* const row_markers = malloc(sizeof(scc_PointIndex[use_threads * vertices]));
+	if (row_markers == NULL) {
+		iscc_free_digraph(out_dg);
+		return iscc_make_error(SCC_ER_NO_MEMORY);
+	}
+
+	for (int pass = 0; pass < 2; ++pass) {
+		if (pass == 1) {
+			if ((ec = iscc_dg_allocate_rows(out_dg)) != SCC_ER_OK) break;
+			if (iscc_digraph_is_empty(out_dg)) break;
+		}
+		iscc_ArcIndex* const tail_ptr = out_dg->tail_ptr;
+		scc_PointIndex* const head = out_dg->head;
+
+		#ifdef _OPENMP
+			#pragma omp parallel num_threads((int) use_threads)
+		#endif // ifdef _OPENMP
+		{
+			#ifdef _OPENMP
+				scc_PointIndex* const thread_markers = row_markers + ((size_t) omp_get_thread_num()) * vertices;
+			#else
+				scc_PointIndex* const thread_markers = row_markers;
+			#endif // ifdef _OPENMP
+			for (size_t v = 0; v < vertices; ++v) {
+				thread_markers[v] = ISCC_POINTINDEX_MAX_PI;
+			}
+
+			#ifdef _OPENMP
+				#pragma omp for schedule(dynamic, ISCC_DG_ROW_CHUNK)
+			#endif // ifdef _OPENMP
+			for (size_t r = 0; r < vertices; ++r) {
+				const scc_PointIndex v = (scc_PointIndex) r;
+				if (pass == 0) {
+					tail_ptr[v + 1] = (iscc_ArcIndex) iscc_adjacency_product_row(dg_a, dg_b, v, force_loops, thread_markers, NULL);
+				} else {
+					iscc_adjacency_product_row(dg_a, dg_b, v, force_loops, thread_markers, head + iscc_digraph_row_begin(out_dg, v));
+				}
+			}
+		}
+	}
+
+	free(row_markers);
+
+	if (ec != SCC_ER_OK) {
+		iscc_free_digraph(out_dg);
+		return ec;
+	}
+
+	return iscc_no_error();
+}
+
+
+static scc_ErrorCode iscc_compressed_transpose(const iscc_Digraph* const in_dg,
+                                               iscc_Digraph* const out_dg)
+{
+	assert(iscc_digraph_is_compressed(in_dg));
+
+	// Rows are decoded twice, first to count arcs and then to fill the transpose
+	scc_ErrorCode ec;
+	iscc_DigraphRowReader reader;
+	if ((ec = iscc_init_row_reader(in_dg, &reader)) != SCC_ER_OK) {
+		iscc_free_digraph(out_dg);
+		return ec;
+	}
+
+	for (size_t v = 0; v < in_dg->vertices; ++v) {
+		size_t len_row;
+		const scc_PointIndex* const row = iscc_digraph_read_row(in_dg, v, &reader, &len_row);
+		for (size_t i = 0; i < len_row; ++i) {
+			++out_dg->tail_ptr[row[i] + 1];
+		}
+	}
+
+	if ((ec = iscc_dg_allocate_transpose_rows(out_dg)) != SCC_ER_OK) {
+		iscc_free_row_reader(&reader);
+		iscc_free_digraph(out_dg);
+		return ec;
+	}
+
+	for (size_t v = 0; v < in_dg->vertices; ++v) {
+		size_t len_row;
+		const scc_PointIndex* const row = iscc_digraph_read_row(in_dg, v, &reader, &len_row);
+		for (size_t i = 0; i < len_row; ++i) {
+			--out_dg->tail_ptr[row[i]];
+			out_dg->head[iscc_digraph_unwrap_arc(out_dg, row[i], out_dg->tail_ptr[row[i]])] = (scc_PointIndex) v;
+		}
+	}
+
+	iscc_free_row_reader(&reader);
+
+	return iscc_no_error();
+}
+
+
+// Turns the row lengths in `out_dg->tail_ptr[v + 1]` into row offsets and allocates the arcs
+static scc_ErrorCode iscc_dg_allocate_rows(iscc_Digraph* const out_dg)
+{
+	assert(iscc_digraph_is_initialized(out_dg));
+	assert(out_dg->tail_ptr[0] == 0);
+
+	// Offsets are stored modulo `ISCC_ARCINDEX_MAX + 1`, and `iscc_change_arc_storage` segments the digraph if needed
+	uintmax_t num_arcs = 0;
+	for (size_t v = 0; v < out_dg->vertices; ++v) {
+		num_arcs += out_dg->tail_ptr[v + 1];
+		out_dg->tail_ptr[v + 1] = (iscc_ArcIndex) num_arcs;
+	}
+
+	return iscc_change_arc_storage(out_dg, num_arcs);
+}
+
+
+/* Allocates the rows of a transpose from the in-degrees in `out_dg->tail_ptr[h + 1]`, and
+ * moves the end of each row to `out_dg->tail_ptr[h]`. The rows are then filled backwards
+ * by decrementing `out_dg->tail_ptr[h]`, which leaves it at the start of the row.
+ */
+static scc_ErrorCode iscc_dg_allocate_transpose_rows(iscc_Digraph* const out_dg)
+{
+	scc_ErrorCode ec;
+	if ((ec = iscc_dg_allocate_rows(out_dg)) != SCC_ER_OK) return ec;
+
+	for (size_t v = 0; v < out_dg->vertices; ++v) {
+		out_dg->tail_ptr[v] = out_dg->tail_ptr[v + 1];
+	}
+
+	return iscc_no_error();
+}
+
+
+// Checks whether each tail in a fixed-degree digraph has exactly one self-loop
+static bool iscc_fixed_digraph_has_one_loop(const iscc_Digraph* const dg)
+{
+	assert(iscc_digraph_is_valid(dg));
+	assert(iscc_digraph_is_fixed(dg));
+
+	assert(dg->vertices <= ISCC_POINTINDEX_MAX);
+	const scc_PointIndex vertices = (scc_PointIndex) dg->vertices; // If `scc_PointIndex` is signed
+	for (scc_PointIndex v = 0; v < vertices; ++v) {
+		if (iscc_digraph_out_degree(dg, v) == 0) continue;
+		size_t loops = 0;
+		const scc_PointIndex* const v_arc_stop = dg->head + iscc_digraph_row_end(dg, v);
+		for (const scc_PointIndex* v_arc = dg->head + iscc_digraph_row_begin(dg, v);
+		        v_arc != v_arc_stop; ++v_arc) {
+			if (*v_arc == v) ++loops;
+		}
+		if (loops != 1) return false;
+	}
+
+	return true;
+}
+
+
+// Deletes the self-loops of a fixed-degree digraph where each tail has exactly one
+static scc_ErrorCode iscc_delete_fixed_loops(iscc_Digraph* const dg)
+{
+	assert(iscc_fixed_digraph_has_one_loop(dg));
+
+	const size_t fixed_degree = dg->fixed_degree;
+	if (fixed_degree == 1) {
+		// No arcs left, fall back to an empty sparse matrix
+		iscc_ArcIndex* const tail_ptr = calloc(dg->vertices + 1, sizeof(iscc_ArcIndex));
+		if (tail_ptr == NULL) return iscc_make_error(SCC_ER_NO_MEMORY);
+		free(dg->valid_tails);
+		free(dg->tail_rank);
+		dg->tail_ptr = tail_ptr;
+		dg->fixed_degree = 0;
+		dg->valid_tails = NULL;
+		dg->tail_rank = NULL;
+		return iscc_change_arc_storage(dg, 0);
+	}
+
+	// Tails are stored in vertex order, so writing behind the read position is safe
+	scc_PointIndex* head_write = dg->head;
+	assert(dg->vertices <= ISCC_POINTINDEX_MAX);
+	const scc_PointIndex vertices = (scc_PointIndex) dg->vertices; // If `scc_PointIndex` is signed
+	for (scc_PointIndex v = 0; v < vertices; ++v) {
+		const scc_PointIndex* const v_arc_stop = dg->head + iscc_digraph_row_end(dg, v);
+		for (const scc_PointIndex* v_arc = dg->head + iscc_digraph_row_begin(dg, v);
+		        v_arc != v_arc_stop; ++v_arc) {
+			if (*v_arc != v) {
+				*head_write = *v_arc;
+				++head_write;
+			}
+		}
+	}
+
+	dg->fixed_degree = (uint32_t) (fixed_degree - 1);
+	assert((size_t) (head_write - dg->head) == iscc_digraph_num_arcs(dg));
+
+	return iscc_change_arc_storage(dg, (size_t) (head_write - dg->head));
+}
+
+
+// Writes the row of `v` in the union to `out_row` (if not NULL) and returns its length
+static inline size_t iscc_union_row(const uint_fast16_t num_dgs,
+                                    const iscc_Digraph dgs[restrict const static num_dgs],
+                                    const scc_PointIndex v,
+                                    const bool keep_self_loops,
+                                    scc_PointIndex row_markers[restrict const],
+                                    scc_PointIndex out_row[restrict const])
+{
+	size_t counter = 0;
+	if (!keep_self_loops) row_markers[v] = v;
+	for (uint_fast16_t i = 0; i < num_dgs; ++i) {
+		const scc_PointIndex* const arc_i_stop = dgs[i].head + iscc_digraph_row_end(&dgs[i], v);
+		for (const scc_PointIndex* arc_i = dgs[i].head + iscc_digraph_row_begin(&dgs[i], v);
+		        arc_i != arc_i_stop; ++arc_i) {
+			if (row_markers[*arc_i] != v) {
+				row_markers[*arc_i] = v;
+				if (out_row != NULL) out_row[counter] = *arc_i;
+				++counter;
+			}
+		}
+	}
+	return counter;
+}
+
+
+// Writes the row of `v` in the product to `out_row` (if not NULL) and returns its length
+static inline size_t iscc_adjacency_product_row(const iscc_Digraph* const dg_a,
+                                                const iscc_Digraph* const dg_b,
+                                                const scc_PointIndex v,
+                                                const bool force_loops,
+                                                scc_PointIndex row_markers[restrict const],
+                                                scc_PointIndex out_row[restrict const])
+{
+	size_t counter = 0;
+	row_markers[v] = v;
+	if (force_loops) {
+		const scc_PointIndex* const v_arc_b_stop = dg_b->head + iscc_digraph_row_end(dg_b, v);
+		for (const scc_PointIndex* v_arc_b = dg_b->head + iscc_digraph_row_begin(dg_b, v);
+		        v_arc_b != v_arc_b_stop; ++v_arc_b) {
+			if (row_markers[*v_arc_b] != v) {
+				row_markers[*v_arc_b] = v;
+				if (out_row != NULL) out_row[counter] = *v_arc_b;
+				++counter;
+			}
+		}
+	}
+	const scc_PointIndex* const arc_a_stop = dg_a->head + iscc_digraph_row_end(dg_a, v);
+	for (const scc_PointIndex* arc_a = dg_a->head + iscc_digraph_row_begin(dg_a, v);
+	        arc_a != arc_a_stop; ++arc_a) {
+		const scc_PointIndex* const arc_b_stop = dg_b->head + iscc_digraph_row_end(dg_b, *arc_a);
+		for (const scc_PointIndex* arc_b = dg_b->head + iscc_digraph_row_begin(dg_b, *arc_a);
+		        arc_b != arc_b_stop; ++arc_b) {
+			if (row_markers[*arc_b] != v) {
+				row_markers[*arc_b] = v;
+				if (out_row != NULL) out_row[counter] = *arc_b;
+				++counter;
+			}
+		}
+	}
+	return counter;
+}
@@ -45,6 +45,9 @@
  *  \note Arc memory space that is freed due to the deletion is deallocated.
  *
  *  \note The deletion is stable so that the internal ordering of remaining arcs in \p dg->head is unchanged.
+ *
+ *  \note A fixed-degree digraph where every tail has exactly one self-loop stays in fixed-degree format
+ *        with one arc less per tail. Other fixed-degree digraphs are converted to sparse matrix format.
  */
 scc_ErrorCode iscc_delete_loops(iscc_Digraph* dg);
 
@@ -87,16 +90,22 @@ scc_ErrorCode iscc_delete_loops(iscc_Digraph* dg);
  *  \param[in] len_tails_to_keep length of \p tails_to_keep.
  *  \param[in] tails_to_keep indices of tails for which the arcs should be *kept*.
  *                           If `NULL` no arcs (except self-loops) are deleted.
+ *  \param     num_threads number of threads to use. Zero uses the OpenMP default.
  *  \param[out] out_dg the union of \p dgs.
  *
  *  \note All digraphs in \p dgs must contain equally many vertices.
  *  \note All self-loops in the digraphs will be ignored.
+ *  \note \p tails_to_keep must be sorted and without duplicates.
+ *  \note The output does not depend on \p num_threads.
+ *  \note Each thread uses scratch of the size of the vertex set. Threads beyond two are
+ *        only used while the total scratch is within the number of arcs in the input.
  */
 scc_ErrorCode iscc_digraph_union_and_delete(uint_fast16_t num_in_dgs,
                                             const iscc_Digraph in_dgs[static num_in_dgs],
                                             size_t len_tails_to_keep,
                                             const scc_PointIndex tails_to_keep[],
                                             bool keep_self_loops,
+                                            uint32_t num_threads,
                                             iscc_Digraph* out_dg);
 
 
@@ -128,9 +137,16 @@ scc_ErrorCode iscc_digraph_difference(iscc_Digraph* minuend_dg,
  *  \enddot
  *
  *  \param[in] dg digraph to transpose.
+ *  \param     num_threads number of threads to use. Zero uses the OpenMP default.
  *  \param[out] out_dg the transpose of \p dg.
+ *
+ *  \note The output does not depend on \p num_threads.
+ *
+ *  \note Each thread uses scratch of the size of the vertex set. Threads beyond two are
+ *        only used while the total scratch is within the number of arcs in the input.
  */
 scc_ErrorCode iscc_digraph_transpose(const iscc_Digraph* in_dg,
+                                     uint32_t num_threads,
                                      iscc_Digraph* out_dg);
 
 
@@ -172,15 +188,22 @@ scc_ErrorCode iscc_digraph_transpose(const iscc_Digraph* in_dg,
  *  \param[in] dg_a the first digraph of the product.
  *  \param[in] dg_b the second digraph of the product.
  *  \param     force_loops when \c true, forces self-loops in \p dg_a (i.e., all vertices have an arc to themselves).
+ *  \param     num_threads number of threads to use. Zero uses the OpenMP default.
  *  \param[out] out_dg the digraph described by the product of the adjacency matrices of \p dg_a and \p dg_b.
  *
  *  \note \p dg_a and \p dg_b must contain equally many vertices.
  *
  *  \note The output digraph will never have self-loops (independently of \p force_loops).
+ *
+ *  \note The output does not depend on \p num_threads.
+ *
+ *  \note Each thread uses scratch of the size of the vertex set. Threads beyond two are
+ *        only used while the total scratch is within the number of arcs in the input.
  */
 scc_ErrorCode iscc_adjacency_product(const iscc_Digraph* in_dg_a,
                                      const iscc_Digraph* in_dg_b,
                                      bool force_loops,
+                                     uint32_t num_threads,
                                      iscc_Digraph* out_dg);
 
 
@@ -0,0 +1,506 @@
+/* =============================================================================
+ * scclust -- A C library for size-constrained clustering
+ * https://github.com/fsavje/scclust
+ *
+ * Copyright (C) 2015-2017  Fredrik Savje -- http://fredriksavje.com
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see http://www.gnu.org/licenses/
+ * ========================================================================== */
+
+#include "dist_kernels.h"
+
+#include <stddef.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#define ISCC_X86_DISPATCH
+	#include <immintrin.h>
+#endif
+
+
+// =============================================================================
+// Sequential kernel
+// =============================================================================
+
+double iscc_sq_dist_sequential(const double data1[const],
+                               const double data2[const],
+                               const size_t num_dimensions)
+{
+	double tmp_dist = 0.0;
+	for (size_t d = 0; d < num_dimensions; ++d) {
+		const double value_diff = (data1[d] - data2[d]);
+		tmp_dist += value_diff * value_diff;
+	}
+	return tmp_dist;
+}
+
+void iscc_dot_block_sequential(const double* const rows1[const static ISCC_DOT_BLOCK],
+                               const double* const rows2[const static ISCC_DOT_BLOCK],
+                               const size_t num_dimensions,
+                               double out_dots[const static ISCC_DOT_BLOCK][ISCC_DOT_BLOCK])
+{
+	for (size_t i = 0; i < ISCC_DOT_BLOCK; ++i) {
+		for (size_t j = 0; j < ISCC_DOT_BLOCK; ++j) {
+			double tmp_dot = 0.0;
+			for (size_t d = 0; d < num_dimensions; ++d) {
+				tmp_dot += rows1[i][d] * rows2[j][d];
+			}
+			out_dots[i][j] = tmp_dot;
+		}
+	}
+}
+
+
+double iscc_sq_dist_sequential_f32(const float data1[const],
+                                   const float data2[const],
+                                   const size_t num_dimensions)
+{
+	double tmp_dist = 0.0;
+	for (size_t d = 0; d < num_dimensions; ++d) {
+		const double value_diff = ((double) data1[d] - (double) data2[d]);
+		tmp_dist += value_diff * value_diff;
+	}
+	return tmp_dist;
+}
+
+void iscc_dot_block_sequential_f32(const float* const rows1[const static ISCC_DOT_BLOCK],
+                                   const float* const rows2[const static ISCC_DOT_BLOCK],
+                                   const size_t num_dimensions,
+                                   double out_dots[const static ISCC_DOT_BLOCK][ISCC_DOT_BLOCK])
+{
+	for (size_t i = 0; i < ISCC_DOT_BLOCK; ++i) {
+		for (size_t j = 0; j < ISCC_DOT_BLOCK; ++j) {
+			double tmp_dot = 0.0;
+			for (size_t d = 0; d < num_dimensions; ++d) {
+				tmp_dot += (double) rows1[i][d] * (double) rows2[j][d];
+			}
+			out_dots[i][j] = tmp_dot;
+		}
+	}
+}
+
+
+#ifdef ISCC_X86_DISPATCH
+
+// =============================================================================
+// x86 kernels
+// =============================================================================
+
+// Each kernel keeps several independent accumulators to break the dependency
+// chain of the additions. Remaining dimensions are added sequentially.
+
+__attribute__((target("sse2")))
+static double iscc_sq_dist_sse2(const double* const data1,
+                                const double* const data2,
+                                const size_t num_dimensions)
+{
+	__m128d acc1 = _mm_setzero_pd();
+	__m128d acc2 = _mm_setzero_pd();
+	size_t d = 0;
+	for (; d + 4 <= num_dimensions; d += 4) {
+		const __m128d diff1 = _mm_sub_pd(_mm_loadu_pd(data1 + d), _mm_loadu_pd(data2 + d));
+		const __m128d diff2 = _mm_sub_pd(_mm_loadu_pd(data1 + d + 2), _mm_loadu_pd(data2 + d + 2));
+		acc1 = _mm_add_pd(acc1, _mm_mul_pd(diff1, diff1));
+		acc2 = _mm_add_pd(acc2, _mm_mul_pd(diff2, diff2));
+	}
+	acc1 = _mm_add_pd(acc1, acc2);
+	double tmp_dist = _mm_cvtsd_f64(_mm_add_sd(acc1, _mm_unpackhi_pd(acc1, acc1)));
+	for (; d < num_dimensions; ++d) {
+		const double value_diff = (data1[d] - data2[d]);
+		tmp_dist += value_diff * value_diff;
+	}
+	return tmp_dist;
+}
+
+
+__attribute__((target("avx2,fma")))
+static double iscc_sq_dist_avx2(const double* const data1,
+                                const double* const data2,
+                                const size_t num_dimensions)
+{
+	__m256d acc1 = _mm256_setzero_pd();
+	__m256d acc2 = _mm256_setzero_pd();
+	__m256d acc3 = _mm256_setzero_pd();
+	__m256d acc4 = _mm256_setzero_pd();
+	size_t d = 0;
+	for (; d + 16 <= num_dimensions; d += 16) {
+		const __m256d diff1 = _mm256_sub_pd(_mm256_loadu_pd(data1 + d), _mm256_loadu_pd(data2 + d));
+		const __m256d diff2 = _mm256_sub_pd(_mm256_loadu_pd(data1 + d + 4), _mm256_loadu_pd(data2 + d + 4));
+		const __m256d diff3 = _mm256_sub_pd(_mm256_loadu_pd(data1 + d + 8), _mm256_loadu_pd(data2 + d + 8));
+		const __m256d diff4 = _mm256_sub_pd(_mm256_loadu_pd(data1 + d + 12), _mm256_loadu_pd(data2 + d + 12));
+		acc1 = _mm256_fmadd_pd(diff1, diff1, acc1);
+		acc2 = _mm256_fmadd_pd(diff2, diff2, acc2);
+		acc3 = _mm256_fmadd_pd(diff3, diff3, acc3);
+		acc4 = _mm256_fmadd_pd(diff4, diff4, acc4);
+	}
+	for (; d + 4 <= num_dimensions; d += 4) {
+		const __m256d diff1 = _mm256_sub_pd(_mm256_loadu_pd(data1 + d), _mm256_loadu_pd(data2 + d));
+		acc1 = _mm256_fmadd_pd(diff1, diff1, acc1);
+	}
+	acc1 = _mm256_add_pd(_mm256_add_pd(acc1, acc2), _mm256_add_pd(acc3, acc4));
+	__m128d acc_half = _mm_add_pd(_mm256_castpd256_pd128(acc1), _mm256_extractf128_pd(acc1, 1));
+	double tmp_dist = _mm_cvtsd_f64(_mm_add_sd(acc_half, _mm_unpackhi_pd(acc_half, acc_half)));
+	for (; d < num_dimensions; ++d) {
+		const double value_diff = (data1[d] - data2[d]);
+		tmp_dist += value_diff * value_diff;
+	}
+	return tmp_dist;
+}
+
+
+__attribute__((target("avx512f")))
+static double iscc_sq_dist_avx512(const double* const data1,
+                                  const double* const data2,
+                                  const size_t num_dimensions)
+{
+	__m512d acc1 = _mm512_setzero_pd();
+	__m512d acc2 = _mm512_setzero_pd();
+	size_t d = 0;
+	for (; d + 16 <= num_dimensions; d += 16) {
+		const __m512d diff1 = _mm512_sub_pd(_mm512_loadu_pd(data1 + d), _mm512_loadu_pd(data2 + d));
+		const __m512d diff2 = _mm512_sub_pd(_mm512_loadu_pd(data1 + d + 8), _mm512_loadu_pd(data2 + d + 8));
+		acc1 = _mm512_fmadd_pd(diff1, diff1, acc1);
+		acc2 = _mm512_fmadd_pd(diff2, diff2, acc2);
+	}
+	if (d < num_dimensions) {
+		// Masked loads read zeros beyond the last dimension
+		for (; d < num_dimensions; d += 8) {
+			const size_t remaining = num_dimensions - d;
+			const __mmask8 mask = (remaining >= 8) ? (__mmask8) 0xFF : (__mmask8) ((1u << remaining) - 1u);
+			const __m512d diff1 = _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, data1 + d), _mm512_maskz_loadu_pd(mask, data2 + d));
+			acc1 = _mm512_fmadd_pd(diff1, diff1, acc1);
+		}
+	}
+	return _mm512_reduce_add_pd(_mm512_add_pd(acc1, acc2));
+}
+
+
+__attribute__((target("avx2,fma")))
+static void iscc_dot_block_avx2(const double* const rows1[const static ISCC_DOT_BLOCK],
+                                const double* const rows2[const static ISCC_DOT_BLOCK],
+                                const size_t num_dimensions,
+                                double out_dots[const static ISCC_DOT_BLOCK][ISCC_DOT_BLOCK])
+{
+	__m256d acc[ISCC_DOT_BLOCK][ISCC_DOT_BLOCK];
+	for (size_t i = 0; i < ISCC_DOT_BLOCK; ++i) {
+		for (size_t j = 0; j < ISCC_DOT_BLOCK; ++j) {
+			acc[i][j] = _mm256_setzero_pd();
+		}
+	}
+	size_t d = 0;
+	for (; d + 4 <= num_dimensions; d += 4) {
+		__m256d values2[ISCC_DOT_BLOCK];
+		for (size_t j = 0; j < ISCC_DOT_BLOCK; ++j) {
+			values2[j] = _mm256_loadu_pd(rows2[j] + d);
+		}
+		for (size_t i = 0; i < ISCC_DOT_BLOCK; ++i) {
+			const __m256d values1 = _mm256_loadu_pd(rows1[i] + d);
+			for (size_t j = 0; j < ISCC_DOT_BLOCK; ++j) {
+				acc[i][j] = _mm256_fmadd_pd(values1, values2[j], acc[i][j]);
+			}
+		}
+	}
+	for (size_t i = 0; i < ISCC_DOT_BLOCK; ++i) {
+		for (size_t j = 0; j < ISCC_DOT_BLOCK; ++j) {
+			const __m128d acc_half = _mm_add_pd(_mm256_castpd256_pd128(acc[i][j]), _mm256_extractf128_pd(acc[i][j], 1));
+			double tmp_dot = _mm_cvtsd_f64(_mm_add_sd(acc_half, _mm_unpackhi_pd(acc_half, acc_half)));
+			for (size_t dd = d; dd < num_dimensions; ++dd) {
+				tmp_dot += rows1[i][dd] * rows2[j][dd];
+			}
+			out_dots[i][j] = tmp_dot;
+		}
+	}
+}
+
+
+__attribute__((target("avx512f")))
+static void iscc_dot_block_avx512(const double* const rows1[const static ISCC_DOT_BLOCK],
+                                  const double* const rows2[const static ISCC_DOT_BLOCK],
+                                  const size_t num_dimensions,
+                                  double out_dots[const static ISCC_DOT_BLOCK][ISCC_DOT_BLOCK])
+{
+	__m512d acc[ISCC_DOT_BLOCK][ISCC_DOT_BLOCK];
+	for (size_t i = 0; i < ISCC_DOT_BLOCK; ++i) {
+		for (size_t j = 0; j < ISCC_DOT_BLOCK; ++j) {
+			acc[i][j] = _mm512_setzero_pd();
+		}
+	}
+	for (size_t d = 0; d < num_dimensions; d += 8) {
+		// Masked loads read zeros beyond the last dimension
+		const size_t remaining = num_dimensions - d;
+		const __mmask8 mask = (remaining >= 8) ? (__mmask8) 0xFF : (__mmask8) ((1u << remaining) - 1u);
+		__m512d values2[ISCC_DOT_BLOCK];
+		for (size_t j = 0; j < ISCC_DOT_BLOCK; ++j) {
+			values2[j] = _mm512_maskz_loadu_pd(mask, rows2[j] + d);
+		}
+		for (size_t i = 0; i < ISCC_DOT_BLOCK; ++i) {
+			const __m512d values1 = _mm512_maskz_loadu_pd(mask, rows1[i] + d);
+			for (size_t j = 0; j < ISCC_DOT_BLOCK; ++j) {
+				acc[i][j] = _mm512_fmadd_pd(values1, values2[j], acc[i][j]);
+			}
+		}
+	}
+	for (size_t i = 0; i < ISCC_DOT_BLOCK; ++i) {
+		for (size_t j = 0; j < ISCC_DOT_BLOCK; ++j) {
+			out_dots[i][j] = _mm512_reduce_add_pd(acc[i][j]);
+		}
+	}
+}
+
+
+// =============================================================================
+// x86 single-precision kernels
+// =============================================================================
+
+// These mirror the double-precision kernels above, converting each loaded
+// vector of floats to doubles.
+
+__attribute__((target("sse2")))
+static double iscc_sq_dist_sse2_f32(const float* const data1,
+                                    const float* const data2,
+                                    const size_t num_dimensions)
+{
+	__m128d acc1 = _mm_setzero_pd();
+	__m128d acc2 = _mm_setzero_pd();
+	size_t d = 0;
+	for (; d + 4 <= num_dimensions; d += 4) {
+		const __m128 values1 = _mm_loadu_ps(data1 + d);
+		const __m128 values2 = _mm_loadu_ps(data2 + d);
+		const __m128d diff1 = _mm_sub_pd(_mm_cvtps_pd(values1), _mm_cvtps_pd(values2));
+		const __m128d diff2 = _mm_sub_pd(_mm_cvtps_pd(_mm_movehl_ps(values1, values1)), _mm_cvtps_pd(_mm_movehl_ps(values2, values2)));
+		acc1 = _mm_add_pd(acc1, _mm_mul_pd(diff1, diff1));
+		acc2 = _mm_add_pd(acc2, _mm_mul_pd(diff2, diff2));
+	}
+	acc1 = _mm_add_pd(acc1, acc2);
+	double tmp_dist = _mm_cvtsd_f64(_mm_add_sd(acc1, _mm_unpackhi_pd(acc1, acc1)));
+	for (; d < num_dimensions; ++d) {
+		const double value_diff = ((double) data1[d] - (double) data2[d]);
+		tmp_dist += value_diff * value_diff;
+	}
+	return tmp_dist;
+}
+
+
+__attribute__((target("avx2,fma")))
+static inline __m256d iscc_load_f32_avx2(const float* const data)
+{
+	return _mm256_cvtps_pd(_mm_loadu_ps(data));
+}
+
+
+__attribute__((target("avx2,fma")))
+static double iscc_sq_dist_avx2_f32(const float* const data1,
+                                    const float* const data2,
+                                    const size_t num_dimensions)
+{
+	__m256d acc1 = _mm256_setzero_pd();
+	__m256d acc2 = _mm256_setzero_pd();
+	__m256d acc3 = _mm256_setzero_pd();
+	__m256d acc4 = _mm256_setzero_pd();
+	size_t d = 0;
+	for (; d + 16 <= num_dimensions; d += 16) {
+		const __m256d diff1 = _mm256_sub_pd(iscc_load_f32_avx2(data1 + d), iscc_load_f32_avx2(data2 + d));
+		const __m256d diff2 = _mm256_sub_pd(iscc_load_f32_avx2(data1 + d + 4), iscc_load_f32_avx2(data2 + d + 4));
+		const __m256d diff3 = _mm256_sub_pd(iscc_load_f32_avx2(data1 + d + 8), iscc_load_f32_avx2(data2 + d + 8));
+		const __m256d diff4 = _mm256_sub_pd(iscc_load_f32_avx2(data1 + d + 12), iscc_load_f32_avx2(data2 + d + 12));
+		acc1 = _mm256_fmadd_pd(diff1, diff1, acc1);
+		acc2 = _mm256_fmadd_pd(diff2, diff2, acc2);
+		acc3 = _mm256_fmadd_pd(diff3, diff3, acc3);
+		acc4 = _mm256_fmadd_pd(diff4, diff4, acc4);
+	}
+	for (; d + 4 <= num_dimensions; d += 4) {
+		const __m256d diff1 = _mm256_sub_pd(iscc_load_f32_avx2(data1 + d), iscc_load_f32_avx2(data2 + d));
+		acc1 = _mm256_fmadd_pd(diff1, diff1, acc1);
+	}
+	acc1 = _mm256_add_pd(_mm256_add_pd(acc1, acc2), _mm256_add_pd(acc3, acc4));
+	__m128d acc_half = _mm_add_pd(_mm256_castpd256_pd128(acc1), _mm256_extractf128_pd(acc1, 1));
+	double tmp_dist = _mm_cvtsd_f64(_mm_add_sd(acc_half, _mm_unpackhi_pd(acc_half, acc_half)));
+	for (; d < num_dimensions; ++d) {
+		const double value_diff = ((double) data1[d] - (double) data2[d]);
+		tmp_dist += value_diff * value_diff;
+	}
+	return tmp_dist;
+}
+
+
+// Loads up to eight floats as doubles; masked lanes read zeros
+__attribute__((target("avx512f")))
+static inline __m512d iscc_load_f32_avx512(const __mmask8 mask,
+                                           const float* const data)
+{
+	return _mm512_cvtps_pd(_mm512_castps512_ps256(_mm512_maskz_loadu_ps((__mmask16) mask, data)));
+}
+
+
+__attribute__((target("avx512f")))
+static double iscc_sq_dist_avx512_f32(const float* const data1,
+                                      const float* const data2,
+                                      const size_t num_dimensions)
+{
+	__m512d acc1 = _mm512_setzero_pd();
+	__m512d acc2 = _mm512_setzero_pd();
+	size_t d = 0;
+	for (; d + 16 <= num_dimensions; d += 16) {
+		const __m512d diff1 = _mm512_sub_pd(_mm512_cvtps_pd(_mm256_loadu_ps(data1 + d)), _mm512_cvtps_pd(_mm256_loadu_ps(data2 + d)));
+		const __m512d diff2 = _mm512_sub_pd(_mm512_cvtps_pd(_mm256_loadu_ps(data1 + d + 8)), _mm512_cvtps_pd(_mm256_loadu_ps(data2 + d + 8)));
+		acc1 = _mm512_fmadd_pd(diff1, diff1, acc1);
+		acc2 = _mm512_fmadd_pd(diff2, diff2, acc2);
+	}
+	for (; d < num_dimensions; d += 8) {
+		const size_t remaining = num_dimensions - d;
+		const __mmask8 mask = (remaining >= 8) ? (__mmask8) 0xFF : (__mmask8) ((1u << remaining) - 1u);
+		const __m512d diff1 = _mm512_sub_pd(iscc_load_f32_avx512(mask, data1 + d), iscc_load_f32_avx512(mask, data2 + d));
+		acc1 = _mm512_fmadd_pd(diff1, diff1, acc1);
+	}
+	return _mm512_reduce_add_pd(_mm512_add_pd(acc1, acc2));
+}
+
+
+__attribute__((target("avx2,fma")))
+static void iscc_dot_block_avx2_f32(const float* const rows1[const static ISCC_DOT_BLOCK],
+                                    const float* const rows2[const static ISCC_DOT_BLOCK],
+                                    const size_t num_dimensions,
+                                    double out_dots[const static ISCC_DOT_BLOCK][ISCC_DOT_BLOCK])
+{
+	__m256d acc[ISCC_DOT_BLOCK][ISCC_DOT_BLOCK];
+	for (size_t i = 0; i < ISCC_DOT_BLOCK; ++i) {
+		for (size_t j = 0; j < ISCC_DOT_BLOCK; ++j) {
+			acc[i][j] = _mm256_setzero_pd();
+		}
+	}
+	size_t d = 0;
+	for (; d + 4 <= num_dimensions; d += 4) {
+		__m256d values2[ISCC_DOT_BLOCK];
+		for (size_t j = 0; j < ISCC_DOT_BLOCK; ++j) {
+			values2[j] = iscc_load_f32_avx2(rows2[j] + d);
+		}
+		for (size_t i = 0; i < ISCC_DOT_BLOCK; ++i) {
+			const __m256d values1 = iscc_load_f32_avx2(rows1[i] + d);
+			for (size_t j = 0; j < ISCC_DOT_BLOCK; ++j) {
+				acc[i][j] = _mm256_fmadd_pd(values1, values2[j], acc[i][j]);
+			}
+		}
+	}
+	for (size_t i = 0; i < ISCC_DOT_BLOCK; ++i) {
+		for (size_t j = 0; j < ISCC_DOT_BLOCK; ++j) {
+			const __m128d acc_half = _mm_add_pd(_mm256_castpd256_pd128(acc[i][j]), _mm256_extractf128_pd(acc[i][j], 1));
+			double tmp_dot = _mm_cvtsd_f64(_mm_add_sd(acc_half, _mm_unpackhi_pd(acc_half, acc_half)));
+			for (size_t dd = d; dd < num_dimensions; ++dd) {
+				tmp_dot += (double) rows1[i][dd] * (double) rows2[j][dd];
+			}
+			out_dots[i][j] = tmp_dot;
+		}
+	}
+}
+
+
+__attribute__((target("avx512f")))
+static void iscc_dot_block_avx512_f32(const float* const rows1[const static ISCC_DOT_BLOCK],
+                                      const float* const rows2[const static ISCC_DOT_BLOCK],
+                                      const size_t num_dimensions,
+                                      double out_dots[const static ISCC_DOT_BLOCK][ISCC_DOT_BLOCK])
+{
+	__m512d acc[ISCC_DOT_BLOCK][ISCC_DOT_BLOCK];
+	for (size_t i = 0; i < ISCC_DOT_BLOCK; ++i) {
+		for (size_t j = 0; j < ISCC_DOT_BLOCK; ++j) {
+			acc[i][j] = _mm512_setzero_pd();
+		}
+	}
+	for (size_t d = 0; d < num_dimensions; d += 8) {
+		const size_t remaining = num_dimensions - d;
+		const __mmask8 mask = (remaining >= 8) ? (__mmask8) 0xFF : (__mmask8) ((1u << remaining) - 1u);
+		__m512d values2[ISCC_DOT_BLOCK];
+		for (size_t j = 0; j < ISCC_DOT_BLOCK; ++j) {
+			values2[j] = iscc_load_f32_avx512(mask, rows2[j] + d);
+		}
+		for (size_t i = 0; i < ISCC_DOT_BLOCK; ++i) {
+			const __m512d values1 = iscc_load_f32_avx512(mask, rows1[i] + d);
+			for (size_t j = 0; j < ISCC_DOT_BLOCK; ++j) {
+				acc[i][j] = _mm512_fmadd_pd(values1, values2[j], acc[i][j]);
+			}
+		}
+	}
+	for (size_t i = 0; i < ISCC_DOT_BLOCK; ++i) {
+		for (size_t j = 0; j < ISCC_DOT_BLOCK; ++j) {
+			out_dots[i][j] = _mm512_reduce_add_pd(acc[i][j]);
+		}
+	}
+}
+
+
+// =============================================================================
+// x86 kernel selection
+// =============================================================================
+
+static iscc_SqDistKernel iscc_select_sq_dist_kernel(void)
+{
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) return iscc_sq_dist_avx512;
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return iscc_sq_dist_avx2;
+	if (__builtin_cpu_supports("sse2")) return iscc_sq_dist_sse2;
+	return iscc_sq_dist_sequential;
+}
+
+
+static iscc_DotBlockKernel iscc_select_dot_block_kernel(void)
+{
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) return iscc_dot_block_avx512;
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return iscc_dot_block_avx2;
+	return iscc_dot_block_sequential;
+}
+
+
+static iscc_SqDistKernelF32 iscc_select_sq_dist_kernel_f32(void)
+{
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) return iscc_sq_dist_avx512_f32;
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return iscc_sq_dist_avx2_f32;
+	if (__builtin_cpu_supports("sse2")) return iscc_sq_dist_sse2_f32;
+	return iscc_sq_dist_sequential_f32;
+}
+
+
+static iscc_DotBlockKernelF32 iscc_select_dot_block_kernel_f32(void)
+{
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) return iscc_dot_block_avx512_f32;
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return iscc_dot_block_avx2_f32;
+	return iscc_dot_block_sequential_f32;
+}
+
+
+__attribute__((constructor))
+static void iscc_init_dist_kernels(void)
+{
+	iscc_sq_dist_kernel = iscc_select_sq_dist_kernel();
+	iscc_dot_block_kernel = iscc_select_dot_block_kernel();
+	iscc_sq_dist_kernel_f32 = iscc_select_sq_dist_kernel_f32();
+	iscc_dot_block_kernel_f32 = iscc_select_dot_block_kernel_f32();
+}
+
+#endif // ifdef ISCC_X86_DISPATCH
+
+
+// =============================================================================
+// Kernel pointers
+// =============================================================================
+
+// Replaced at startup by `iscc_init_dist_kernels` when dispatching is available
+iscc_SqDistKernel iscc_sq_dist_kernel = iscc_sq_dist_sequential;
+
+iscc_DotBlockKernel iscc_dot_block_kernel = iscc_dot_block_sequential;
+
+iscc_SqDistKernelF32 iscc_sq_dist_kernel_f32 = iscc_sq_dist_sequential_f32;
+
+iscc_DotBlockKernelF32 iscc_dot_block_kernel_f32 = iscc_dot_block_sequential_f32;
@@ -0,0 +1,106 @@
+/* =============================================================================
+ * scclust -- A C library for size-constrained clustering
+ * https://github.com/fsavje/scclust
+ *
+ * Copyright (C) 2015-2017  Fredrik Savje -- http://fredriksavje.com
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see http://www.gnu.org/licenses/
+ * ========================================================================== */
+
+#ifndef SCC_DIST_KERNELS_HG
+#define SCC_DIST_KERNELS_HG
+
+#include <stddef.h>
+
+
+// =============================================================================
+// Structs, types and variables
+// =============================================================================
+
+typedef double (*iscc_SqDistKernel)(const double* data1,
+                                    const double* data2,
+                                    size_t num_dimensions);
+
+
+// Squared Euclidean distance kernel, chosen once at startup using cpuid (x86 with
+// GCC or Clang). Other platforms use `iscc_sq_dist_sequential`.
+// The vectorized kernels sum in a different order than `iscc_sq_dist_sequential`;
+// their results differ by a relative error of at most `num_dimensions * DBL_EPSILON`.
+extern iscc_SqDistKernel iscc_sq_dist_kernel;
+
+
+// Number of points in each set of `iscc_dot_block_kernel`
+#define ISCC_DOT_BLOCK 4
+
+typedef void (*iscc_DotBlockKernel)(const double* const rows1[static ISCC_DOT_BLOCK],
+                                    const double* const rows2[static ISCC_DOT_BLOCK],
+                                    size_t num_dimensions,
+                                    double out_dots[static ISCC_DOT_BLOCK][ISCC_DOT_BLOCK]);
+
+
+// Dot products between all pairs of two sets of `ISCC_DOT_BLOCK` points, chosen
+// in the same way as `iscc_sq_dist_kernel`. The relative difference to
+// `iscc_dot_block_sequential` is at most `num_dimensions * DBL_EPSILON`
+// with respect to the sum of the absolute values of the products.
+extern iscc_DotBlockKernel iscc_dot_block_kernel;
+
+
+typedef double (*iscc_SqDistKernelF32)(const float* data1,
+                                       const float* data2,
+                                       size_t num_dimensions);
+
+
+typedef void (*iscc_DotBlockKernelF32)(const float* const rows1[static ISCC_DOT_BLOCK],
+                                       const float* const rows2[static ISCC_DOT_BLOCK],
+                                       size_t num_dimensions,
+                                       double out_dots[static ISCC_DOT_BLOCK][ISCC_DOT_BLOCK]);
+
+
+// Kernels for single-precision data, chosen in the same way as the kernels above.
+// Values are converted to double before any arithmetic, and each kernel sums in the
+// same order as its double-precision counterpart. The results are therefore
+// identical to those of `iscc_sq_dist_kernel` and `iscc_dot_block_kernel` on the
+// converted data.
+extern iscc_SqDistKernelF32 iscc_sq_dist_kernel_f32;
+
+extern iscc_DotBlockKernelF32 iscc_dot_block_kernel_f32;
+
+
+// =============================================================================
+// Function prototypes
+// =============================================================================
+
+double iscc_sq_dist_sequential(const double data1[],
+                               const double data2[],
+                               size_t num_dimensions);
+
+
+void iscc_dot_block_sequential(const double* const rows1[static ISCC_DOT_BLOCK],
+                               const double* const rows2[static ISCC_DOT_BLOCK],
+                               size_t num_dimensions,
+                               double out_dots[static ISCC_DOT_BLOCK][ISCC_DOT_BLOCK]);
+
+
+double iscc_sq_dist_sequential_f32(const float data1[],
+                                   const float data2[],
+                                   size_t num_dimensions);
+
+
+void iscc_dot_block_sequential_f32(const float* const rows1[static ISCC_DOT_BLOCK],
+                                   const float* const rows2[static ISCC_DOT_BLOCK],
+                                   size_t num_dimensions,
+                                   double out_dots[static ISCC_DOT_BLOCK][ISCC_DOT_BLOCK]);
+
+
+#endif // ifndef SCC_DIST_KERNELS_HG
@@ -21,31 +21,40 @@
 #ifndef SCC_DIST_SEARCH_HG
 #define SCC_DIST_SEARCH_HG
 
+#include <assert.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include "../include/scclust_spi.h"
+#include "bitset.h"
+#include "data_set_struct.h"
+#include "dist_search_imp.h"
 
 
 // =============================================================================
 // Structs and variables
 // =============================================================================
 
-typedef struct iscc_dist_functions_struct {
-	scc_check_data_set check_data_set;
-	scc_num_data_points num_data_points;
-	scc_get_dist_matrix get_dist_matrix;
-	scc_get_dist_rows get_dist_rows;
-	scc_init_max_dist_object init_max_dist_object;
-	scc_get_max_dist get_max_dist;
-	scc_close_max_dist_object close_max_dist_object;
-	scc_init_nn_search_object init_nn_search_object;
-	scc_nearest_neighbor_search nearest_neighbor_search;
-	scc_close_nn_search_object close_nn_search_object;
-} iscc_dist_functions_struct;
+extern scc_DistFunctions iscc_dist_functions;
 
 
-extern iscc_dist_functions_struct iscc_dist_functions;
+// Finds the distance functions for `data_set`. Data sets made by `scc_init_custom_data_set`
+// carry their own functions, which are called with the data set's context. Other data sets
+// use `iscc_dist_functions`, which can be changed with `scc_set_dist_functions`. Data sets
+// are only known to be `scc_DataSet` objects while `iscc_dist_functions` checks them with
+// `iscc_imp_check_data_set`; otherwise they might be of any type and are not inspected.
+static inline const scc_DistFunctions* iscc_resolve_dist_functions(void** const data_set)
+{
+	if ((iscc_dist_functions.check_data_set == iscc_imp_check_data_set) && (*data_set != NULL)) {
+		const scc_DataSet* const data_set_cast = (const scc_DataSet*) *data_set;
+		if ((data_set_cast->data_set_version == ISCC_DATASET_STRUCT_VERSION) &&
+		        (data_set_cast->dist_functions != NULL)) {
+			*data_set = data_set_cast->dist_context;
+			return data_set_cast->dist_functions;
+		}
+	}
+	return &iscc_dist_functions;
+}
 
 
 // =============================================================================
@@ -54,13 +63,13 @@ extern iscc_dist_functions_struct iscc_dist_functions;
 
 static inline bool iscc_check_data_set(void* data_set)
 {
-	return iscc_dist_functions.check_data_set(data_set);
+	return iscc_resolve_dist_functions(&data_set)->check_data_set(data_set);
 }
 
 
 static inline size_t iscc_num_data_points(void* data_set)
 {
-	return iscc_dist_functions.num_data_points(data_set);
+	return iscc_resolve_dist_functions(&data_set)->num_data_points(data_set);
 }
 
 
@@ -69,10 +78,10 @@ static inline bool iscc_get_dist_matrix(void* data_set,
                                         const scc_PointIndex point_indices[],
                                         double output_dists[])
 {
-	return iscc_dist_functions.get_dist_matrix(data_set,
-	                                           len_point_indices,
-	                                           point_indices,
-	                                           output_dists);
+	return iscc_resolve_dist_functions(&data_set)->get_dist_matrix(data_set,
+	                                                               len_point_indices,
+	                                                               point_indices,
+	                                                               output_dists);
 }
 
 
@@ -83,12 +92,12 @@ static inline bool iscc_get_dist_rows(void* data_set,
                                       const scc_PointIndex column_indices[],
                                       double output_dists[])
 {
-	return iscc_dist_functions.get_dist_rows(data_set,
-	                                         len_query_indices,
-	                                         query_indices,
-	                                         len_column_indices,
-	                                         column_indices,
-	                                         output_dists);
+	return iscc_resolve_dist_functions(&data_set)->get_dist_rows(data_set,
+	                                                             len_query_indices,
+	                                                             query_indices,
+	                                                             len_column_indices,
+	                                                             column_indices,
+	                                                             output_dists);
 }
 
 
@@ -101,30 +110,44 @@ static inline bool iscc_init_max_dist_object(void* data_set,
                                              const scc_PointIndex search_indices[],
                                              iscc_MaxDistObject** out_max_dist_object)
 {
-	return iscc_dist_functions.init_max_dist_object(data_set,
-	                                                len_search_indices,
-	                                                search_indices,
-	                                                out_max_dist_object);
+	return iscc_resolve_dist_functions(&data_set)->init_max_dist_object(data_set,
+	                                                                    len_search_indices,
+	                                                                    search_indices,
+	                                                                    out_max_dist_object);
 }
 
 
-static inline bool iscc_get_max_dist(iscc_MaxDistObject* max_dist_object,
+static inline bool iscc_get_max_dist(void* data_set,
+                                     iscc_MaxDistObject* max_dist_object,
                                      size_t len_query_indices,
                                      const scc_PointIndex query_indices[],
                                      scc_PointIndex out_max_indices[],
                                      double out_max_dists[])
 {
-	return iscc_dist_functions.get_max_dist(max_dist_object,
-	                                        len_query_indices,
-	                                        query_indices,
-	                                        out_max_indices,
-	                                        out_max_dists);
+	return iscc_resolve_dist_functions(&data_set)->get_max_dist(max_dist_object,
+	                                                            len_query_indices,
+	                                                            query_indices,
+	                                                            out_max_indices,
+	                                                            out_max_dists);
+}
+
+
+static inline bool iscc_close_max_dist_object(void* data_set,
+                                              iscc_MaxDistObject** max_dist_object)
+{
+	return iscc_resolve_dist_functions(&data_set)->close_max_dist_object(max_dist_object);
 }
 
 
-static inline bool iscc_close_max_dist_object(iscc_MaxDistObject** max_dist_object)
+// The built-in distance and max dist functions can be called from several threads at once,
+// each with its own max dist object. Custom functions are not assumed to be reentrant.
+static inline bool iscc_dist_functions_are_reentrant(void* data_set)
 {
-	return iscc_dist_functions.close_max_dist_object(max_dist_object);
+	const scc_DistFunctions* const dist_functions = iscc_resolve_dist_functions(&data_set);
+	return (dist_functions->get_dist_rows == iscc_imp_get_dist_rows) &&
+	       (dist_functions->init_max_dist_object == iscc_imp_init_max_dist_object) &&
+	       (dist_functions->get_max_dist == iscc_imp_get_max_dist) &&
+	       (dist_functions->close_max_dist_object == iscc_imp_close_max_dist_object);
 }
 
 
@@ -137,14 +160,15 @@ static inline bool iscc_init_nn_search_object(void* data_set,
                                               const scc_PointIndex search_indices[],
                                               iscc_NNSearchObject** out_nn_search_object)
 {
-	return iscc_dist_functions.init_nn_search_object(data_set,
-	                                                 len_search_indices,
-	                                                 search_indices,
-	                                                 out_nn_search_object);
+	return iscc_resolve_dist_functions(&data_set)->init_nn_search_object(data_set,
+	                                                                     len_search_indices,
+	                                                                     search_indices,
+	                                                                     out_nn_search_object);
 }
 
 
-static inline bool iscc_nearest_neighbor_search(iscc_NNSearchObject* nn_search_object,
+static inline bool iscc_nearest_neighbor_search(void* data_set,
+                                                iscc_NNSearchObject* nn_search_object,
                                                 size_t len_query_indices,
                                                 const scc_PointIndex query_indices[],
                                                 uint32_t k,
@@ -154,7 +178,161 @@ static inline bool iscc_nearest_neighbor_search(iscc_NNSearchObject* nn_search_o
                                                 scc_PointIndex out_query_indices[],
                                                 scc_PointIndex out_nn_indices[])
 {
-	return iscc_dist_functions.nearest_neighbor_search(nn_search_object,
+	return iscc_resolve_dist_functions(&data_set)->nearest_neighbor_search(nn_search_object,
+	                                                                       len_query_indices,
+	                                                                       query_indices,
+	                                                                       k,
+	                                                                       radius_search,
+	                                                                       radius,
+	                                                                       out_num_ok_queries,
+	                                                                       out_query_indices,
+	                                                                       out_nn_indices);
+}
+
+
+static inline bool iscc_close_nn_search_object(void* data_set,
+                                               iscc_NNSearchObject** nn_search_object)
+{
+	return iscc_resolve_dist_functions(&data_set)->close_nn_search_object(nn_search_object);
+}
+
+
+// The built-in search can be called concurrently on the same search object. Custom
+// search functions are not assumed to be reentrant.
+static inline bool iscc_nn_search_is_reentrant(void* data_set)
+{
+	return iscc_resolve_dist_functions(&data_set)->nearest_neighbor_search == iscc_imp_nearest_neighbor_search;
+}
+
+
+// Filtered searches let one search object over all data points stand in for search
+// objects over subsets of the points, by only considering the search points in a
+// `iscc_SearchSubset`. They are only available with the built-in search, and only
+// worthwhile when its search objects are backed by search trees. Data sets that support
+// filtered searches also support typed searches (see `iscc_nn_search_supports_types`).
+static inline bool iscc_nn_search_supports_filter(void* data_set)
+{
+	const scc_DistFunctions* const dist_functions = iscc_resolve_dist_functions(&data_set);
+	if ((dist_functions->init_nn_search_object != iscc_imp_init_nn_search_object) ||
+	        (dist_functions->nearest_neighbor_search != iscc_imp_nearest_neighbor_search) ||
+	        (dist_functions->close_nn_search_object != iscc_imp_close_nn_search_object)) {
+		return false;
+	}
+	if (!iscc_imp_check_data_set(data_set)) return false;
+	return iscc_imp_nn_search_uses_tree(data_set, iscc_imp_num_data_points(data_set));
+}
+
+
+static inline bool iscc_filtered_nearest_neighbor_search(void* data_set,
+                                                         iscc_NNSearchObject* nn_search_object,
+                                                         const iscc_SearchSubset* search_subset,
+                                                         size_t len_query_indices,
+                                                         const scc_PointIndex query_indices[],
+                                                         uint32_t k,
+                                                         bool radius_search,
+                                                         double radius,
+                                                         size_t* out_num_ok_queries,
+                                                         scc_PointIndex out_query_indices[],
+                                                         scc_PointIndex out_nn_indices[])
+{
+	if (search_subset == NULL) {
+		return iscc_nearest_neighbor_search(data_set,
+		                                    nn_search_object,
+		                                    len_query_indices,
+		                                    query_indices,
+		                                    k,
+		                                    radius_search,
+		                                    radius,
+		                                    out_num_ok_queries,
+		                                    out_query_indices,
+		                                    out_nn_indices);
+	}
+	assert(iscc_nn_search_supports_filter(data_set));
+	return iscc_imp_filtered_nearest_neighbor_search(nn_search_object,
+	                                                 search_subset,
+	                                                 len_query_indices,
+	                                                 query_indices,
+	                                                 k,
+	                                                 radius_search,
+	                                                 radius,
+	                                                 out_num_ok_queries,
+	                                                 out_query_indices,
+	                                                 out_nn_indices);
+}
+
+
+// Typed searches find the nearest neighbors of several types with one search per query.
+// They are only available with the built-in search.
+static inline bool iscc_nn_search_supports_types(void* data_set)
+{
+	const scc_DistFunctions* const dist_functions = iscc_resolve_dist_functions(&data_set);
+	return (dist_functions->init_nn_search_object == iscc_imp_init_nn_search_object) &&
+	       (dist_functions->nearest_neighbor_search == iscc_imp_nearest_neighbor_search) &&
+	       (dist_functions->close_nn_search_object == iscc_imp_close_nn_search_object) &&
+	       iscc_imp_check_data_set(data_set);
+}
+
+
+static inline bool iscc_typed_nearest_neighbor_search(void* data_set,
+                                                      iscc_NNSearchObject* nn_search_object,
+                                                      const iscc_TypedNNQuery* typed_query,
+                                                      size_t len_query_indices,
+                                                      const scc_PointIndex query_indices[],
+                                                      bool radius_search,
+                                                      double radius,
+                                                      size_t* out_num_ok_queries,
+                                                      scc_PointIndex out_query_indices[],
+                                                      scc_PointIndex out_nn_indices[])
+{
+	assert(iscc_nn_search_supports_types(data_set));
+	(void) data_set; // Only used in the assertion
+	return iscc_imp_typed_nearest_neighbor_search(nn_search_object,
+	                                              typed_query,
+	                                              len_query_indices,
+	                                              query_indices,
+	                                              radius_search,
+	                                              radius,
+	                                              out_num_ok_queries,
+	                                              out_query_indices,
+	                                              out_nn_indices);
+}
+
+
+// Tombstoned searches reject queries with tombstoned points among their nearest neighbors
+// without searching past those points. As typed searches, they need the built-in search.
+static inline bool iscc_nn_search_supports_tombstones(void* data_set)
+{
+	return iscc_nn_search_supports_types(data_set);
+}
+
+
+static inline bool iscc_tombstoned_nearest_neighbor_search(void* data_set,
+                                                           iscc_NNSearchObject* nn_search_object,
+                                                           const iscc_BitsetWord tombstones[],
+                                                           size_t len_query_indices,
+                                                           const scc_PointIndex query_indices[],
+                                                           uint32_t k,
+                                                           bool radius_search,
+                                                           double radius,
+                                                           size_t* out_num_ok_queries,
+                                                           scc_PointIndex out_query_indices[],
+                                                           scc_PointIndex out_nn_indices[])
+{
+	if (tombstones == NULL) {
+		return iscc_nearest_neighbor_search(data_set,
+		                                    nn_search_object,
+		                                    len_query_indices,
+		                                    query_indices,
+		                                    k,
+		                                    radius_search,
+		                                    radius,
+		                                    out_num_ok_queries,
+		                                    out_query_indices,
+		                                    out_nn_indices);
+	}
+	assert(iscc_nn_search_supports_tombstones(data_set));
+	return iscc_imp_tombstoned_nearest_neighbor_search(nn_search_object,
+	                                                   tombstones,
 	                                                   len_query_indices,
 	                                                   query_indices,
 	                                                   k,
@@ -166,10 +344,4 @@ static inline bool iscc_nearest_neighbor_search(iscc_NNSearchObject* nn_search_o
 }
 
 
-static inline bool iscc_close_nn_search_object(iscc_NNSearchObject** nn_search_object)
-{
-	return iscc_dist_functions.close_nn_search_object(nn_search_object);
-}
-
-
 #endif // ifndef SCC_DIST_SEARCH_HG
@@ -26,7 +26,9 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include "../include/scclust.h"
+#include "bitset.h"
 #include "data_set_struct.h"
+#include "dist_kernels.h"
 #include "scclust_types.h"
 
 
@@ -34,6 +36,10 @@
 // Distance calculations
 // =============================================================================
 
+// Data with fewer dimensions than this use an inlined sequential loop
+// as the vectorized kernels do not make up for the function call.
+#define ISCC_SQ_DIST_KERNEL_MIN_DIMENSIONS 8
+
 static inline double iscc_get_sq_dist(const scc_DataSet* const data_set,
                                       const size_t index1,
                                       const size_t index2)
@@ -41,10 +47,28 @@ static inline double iscc_get_sq_dist(const scc_DataSet* const data_set,
 	assert(index1 < data_set->num_data_points);
 	assert(index2 < data_set->num_data_points);
 
+	if (data_set->data_matrix_f32 != NULL) {
+		const float* data1 = &data_set->data_matrix_f32[index1 * data_set->num_dimensions];
+		const float* data2 = &data_set->data_matrix_f32[index2 * data_set->num_dimensions];
+		if (data_set->num_dimensions >= ISCC_SQ_DIST_KERNEL_MIN_DIMENSIONS) {
+			return iscc_sq_dist_kernel_f32(data1, data2, data_set->num_dimensions);
+		}
+		double tmp_dist = 0.0;
+		for (size_t d = 0; d < data_set->num_dimensions; ++d) {
+			const double value_diff = ((double) data1[d] - (double) data2[d]);
+			tmp_dist += value_diff * value_diff;
+		}
+		return tmp_dist;
+	}
+
 	const double* data1 = &data_set->data_matrix[index1 * data_set->num_dimensions];
-	const double* const data1_stop = data1 + data_set->num_dimensions;
 	const double* data2 = &data_set->data_matrix[index2 * data_set->num_dimensions];
 
+	if (data_set->num_dimensions >= ISCC_SQ_DIST_KERNEL_MIN_DIMENSIONS) {
+		return iscc_sq_dist_kernel(data1, data2, data_set->num_dimensions);
+	}
+
+	const double* const data1_stop = data1 + data_set->num_dimensions;
 	double tmp_dist = 0.0;
 	while (data1 != data1_stop) {
 		const double value_diff = (*data1 - *data2);
@@ -56,6 +80,231 @@ static inline double iscc_get_sq_dist(const scc_DataSet* const data_set,
 }
 
 
+// Sums squared distances block by block in the order of `block_order` (natural order
+// if NULL), and returns early as soon as the sum exceeds `bound`.
+static double iscc_get_sq_dist_by_blocks(const scc_DataSet* const data_set,
+                                         const uint_fast16_t block_order[const],
+                                         const size_t index1,
+                                         const size_t index2,
+                                         const double bound)
+{
+	const uint_fast16_t num_dimensions = data_set->num_dimensions;
+	const uint_fast16_t num_blocks = (uint_fast16_t) ((num_dimensions + ISCC_DATASET_DIMENSION_BLOCK - 1) / ISCC_DATASET_DIMENSION_BLOCK);
+	double partial_dist = 0.0;
+	for (uint_fast16_t b = 0; b < num_blocks; ++b) {
+		const uint_fast16_t block = (block_order == NULL) ? b : block_order[b];
+		const size_t block_start = (size_t) block * ISCC_DATASET_DIMENSION_BLOCK;
+		const size_t block_size = (num_dimensions - block_start > ISCC_DATASET_DIMENSION_BLOCK) ? ISCC_DATASET_DIMENSION_BLOCK : (num_dimensions - block_start);
+		if (data_set->data_matrix_f32 != NULL) {
+			partial_dist += iscc_sq_dist_kernel_f32(&data_set->data_matrix_f32[index1 * num_dimensions + block_start],
+			                                        &data_set->data_matrix_f32[index2 * num_dimensions + block_start],
+			                                        block_size);
+		} else {
+			partial_dist += iscc_sq_dist_kernel(&data_set->data_matrix[index1 * num_dimensions + block_start],
+			                                    &data_set->data_matrix[index2 * num_dimensions + block_start],
+			                                    block_size);
+		}
+		if (partial_dist > bound) return partial_dist;
+	}
+	return partial_dist;
+}
+
+
+// Returns the squared distance when it is at most `bound`. Otherwise, it may
+// return any value larger than `bound`, after visiting only some dimensions.
+// Partial sums never decrease, so no point within `bound` is rejected early.
+// Data with more than one block of dimensions are summed block by block, which
+// may round differently than `iscc_get_sq_dist` and the distance matrices and rows.
+// Searches therefore compute all their distances with this function (with
+// `bound = HUGE_VAL` if unbounded), so that they compare consistently among themselves.
+static inline double iscc_get_sq_dist_bounded(const scc_DataSet* const data_set,
+                                              const uint_fast16_t block_order[const],
+                                              const size_t index1,
+                                              const size_t index2,
+                                              const double bound)
+{
+	assert(index1 < data_set->num_data_points);
+	assert(index2 < data_set->num_data_points);
+
+	const size_t num_dimensions = data_set->num_dimensions;
+	if (num_dimensions > ISCC_DATASET_DIMENSION_BLOCK) {
+		return iscc_get_sq_dist_by_blocks(data_set, block_order, index1, index2, bound);
+	}
+	if (num_dimensions >= ISCC_SQ_DIST_KERNEL_MIN_DIMENSIONS) {
+		return iscc_get_sq_dist(data_set, index1, index2);
+	}
+
+	// Same sequential sum as in `iscc_get_sq_dist`
+	double tmp_dist = 0.0;
+	if (data_set->data_matrix_f32 != NULL) {
+		const float* const data1 = &data_set->data_matrix_f32[index1 * num_dimensions];
+		const float* const data2 = &data_set->data_matrix_f32[index2 * num_dimensions];
+		for (size_t d = 0; (d < num_dimensions) && !(tmp_dist > bound); ++d) {
+			const double value_diff = ((double) data1[d] - (double) data2[d]);
+			tmp_dist += value_diff * value_diff;
+		}
+	} else {
+		const double* const data1 = &data_set->data_matrix[index1 * num_dimensions];
+		const double* const data2 = &data_set->data_matrix[index2 * num_dimensions];
+		for (size_t d = 0; (d < num_dimensions) && !(tmp_dist > bound); ++d) {
+			const double value_diff = (data1[d] - data2[d]);
+			tmp_dist += value_diff * value_diff;
+		}
+	}
+	return tmp_dist;
+}
+
+
+// =============================================================================
+// Blocked distance calculations
+// =============================================================================
+
+// Data sets with cached squared norms compute distances as `|x|^2 + |y|^2 - 2 x.y`.
+// Points are processed in blocks of `ISCC_DIST_BLOCK` query and column points, so
+// each loaded coordinate is used `ISCC_DIST_BLOCK` times, and columns are tiled in
+// groups of `ISCC_DIST_COLUMN_TILE` points that stay in cache while all queries are
+// processed.
+#define ISCC_DIST_BLOCK ISCC_DOT_BLOCK
+#define ISCC_DIST_COLUMN_TILE 64
+
+// Squared distances smaller than this fraction of `|x|^2 + |y|^2` have lost most of
+// their precision to cancellation (e.g., for near-duplicates) and are recomputed directly.
+static const double ISCC_DIST_CANCELLATION_GUARD = 1e-6;
+
+
+static inline size_t iscc_dist_point(const scc_PointIndex point_indices[const],
+                                     const size_t position)
+{
+	if (point_indices == NULL) return position;
+	return (size_t) point_indices[position];
+}
+
+
+// Blocks with fewer than `ISCC_DIST_BLOCK` points are padded by repeating the last point.
+static inline void iscc_fill_dist_block(const scc_DataSet* const data_set,
+                                        const scc_PointIndex point_indices[const],
+                                        const size_t block_start,
+                                        const size_t block_size,
+                                        size_t out_points[const static ISCC_DIST_BLOCK])
+{
+	assert(block_size > 0);
+	for (size_t i = 0; i < ISCC_DIST_BLOCK; ++i) {
+		const size_t position = block_start + ((i < block_size) ? i : (block_size - 1));
+		out_points[i] = iscc_dist_point(point_indices, position);
+		assert(out_points[i] < data_set->num_data_points);
+	}
+	(void) data_set; // Only used in the assertion
+}
+
+
+static inline void iscc_get_dot_block(const scc_DataSet* const data_set,
+                                      const size_t points1[const static ISCC_DIST_BLOCK],
+                                      const size_t points2[const static ISCC_DIST_BLOCK],
+                                      double out_dots[const static ISCC_DIST_BLOCK][ISCC_DIST_BLOCK])
+{
+	const size_t num_dimensions = data_set->num_dimensions;
+	if (data_set->data_matrix_f32 != NULL) {
+		const float* rows1[ISCC_DIST_BLOCK];
+		const float* rows2[ISCC_DIST_BLOCK];
+		for (size_t i = 0; i < ISCC_DIST_BLOCK; ++i) {
+			rows1[i] = &data_set->data_matrix_f32[points1[i] * num_dimensions];
+			rows2[i] = &data_set->data_matrix_f32[points2[i] * num_dimensions];
+		}
+		iscc_dot_block_kernel_f32(rows1, rows2, num_dimensions, out_dots);
+	} else {
+		const double* rows1[ISCC_DIST_BLOCK];
+		const double* rows2[ISCC_DIST_BLOCK];
+		for (size_t i = 0; i < ISCC_DIST_BLOCK; ++i) {
+			rows1[i] = &data_set->data_matrix[points1[i] * num_dimensions];
+			rows2[i] = &data_set->data_matrix[points2[i] * num_dimensions];
+		}
+		iscc_dot_block_kernel(rows1, rows2, num_dimensions, out_dots);
+	}
+}
+
+
+static inline double iscc_dist_from_dot(const scc_DataSet* const data_set,
+                                        const size_t index1,
+                                        const size_t index2,
+                                        const double dot)
+{
+	const double sum_sq_norms = data_set->sq_norms[index1] + data_set->sq_norms[index2];
+	double tmp_dist = sum_sq_norms - 2.0 * dot;
+	if (tmp_dist < ISCC_DIST_CANCELLATION_GUARD * sum_sq_norms) {
+		tmp_dist = iscc_get_sq_dist(data_set, index1, index2);
+	}
+	return sqrt(tmp_dist);
+}
+
+
+static void iscc_get_dist_matrix_blocked(const scc_DataSet* const data_set,
+                                         const size_t len_point_indices,
+                                         const scc_PointIndex point_indices[const],
+                                         double output_dists[const])
+{
+	assert(data_set->sq_norms != NULL);
+
+	size_t points1[ISCC_DIST_BLOCK];
+	size_t points2[ISCC_DIST_BLOCK];
+	double dots[ISCC_DIST_BLOCK][ISCC_DIST_BLOCK];
+
+	for (size_t tile = 0; tile < len_point_indices; tile += ISCC_DIST_COLUMN_TILE) {
+		const size_t tile_end = (len_point_indices - tile > ISCC_DIST_COLUMN_TILE) ? (tile + ISCC_DIST_COLUMN_TILE) : len_point_indices;
+		for (size_t p1 = 0; p1 + 1 < tile_end; p1 += ISCC_DIST_BLOCK) {
+			const size_t size1 = (tile_end - 1 - p1 > ISCC_DIST_BLOCK) ? ISCC_DIST_BLOCK : (tile_end - 1 - p1);
+			iscc_fill_dist_block(data_set, point_indices, p1, size1, points1);
+			for (size_t p2 = ((tile > p1 + 1) ? tile : (p1 + 1)); p2 < tile_end; p2 += ISCC_DIST_BLOCK) {
+				const size_t size2 = (tile_end - p2 > ISCC_DIST_BLOCK) ? ISCC_DIST_BLOCK : (tile_end - p2);
+				iscc_fill_dist_block(data_set, point_indices, p2, size2, points2);
+				iscc_get_dot_block(data_set, points1, points2, dots);
+				for (size_t i = 0; i < size1; ++i) {
+					const size_t row = p1 + i;
+					// Distance between `row` and `col` is at `row_start + col - 1` in the upper triangle
+					const size_t row_start = row * len_point_indices - (row * (row + 3)) / 2;
+					for (size_t j = 0; j < size2; ++j) {
+						if (p2 + j <= row) continue;
+						output_dists[row_start + p2 + j - 1] = iscc_dist_from_dot(data_set, points1[i], points2[j], dots[i][j]);
+					}
+				}
+			}
+		}
+	}
+}
+
+
+static void iscc_get_dist_rows_blocked(const scc_DataSet* const data_set,
+                                       const size_t len_query_indices,
+                                       const scc_PointIndex query_indices[const],
+                                       const size_t len_column_indices,
+                                       const scc_PointIndex column_indices[const],
+                                       double output_dists[const])
+{
+	assert(data_set->sq_norms != NULL);
+
+	size_t points1[ISCC_DIST_BLOCK];
+	size_t points2[ISCC_DIST_BLOCK];
+	double dots[ISCC_DIST_BLOCK][ISCC_DIST_BLOCK];
+
+	for (size_t tile = 0; tile < len_column_indices; tile += ISCC_DIST_COLUMN_TILE) {
+		const size_t tile_end = (len_column_indices - tile > ISCC_DIST_COLUMN_TILE) ? (tile + ISCC_DIST_COLUMN_TILE) : len_column_indices;
+		for (size_t q = 0; q < len_query_indices; q += ISCC_DIST_BLOCK) {
+			const size_t size1 = (len_query_indices - q > ISCC_DIST_BLOCK) ? ISCC_DIST_BLOCK : (len_query_indices - q);
+			iscc_fill_dist_block(data_set, query_indices, q, size1, points1);
+			for (size_t c = tile; c < tile_end; c += ISCC_DIST_BLOCK) {
+				const size_t size2 = (tile_end - c > ISCC_DIST_BLOCK) ? ISCC_DIST_BLOCK : (tile_end - c);
+				iscc_fill_dist_block(data_set, column_indices, c, size2, points2);
+				iscc_get_dot_block(data_set, points1, points2, dots);
+				for (size_t i = 0; i < size1; ++i) {
+					for (size_t j = 0; j < size2; ++j) {
+						output_dists[(q + i) * len_column_indices + c + j] = iscc_dist_from_dot(data_set, points1[i], points2[j], dots[i][j]);
+					}
+				}
+			}
+		}
+	}
+}
+
+
 // =============================================================================
 // Miscellaneous functions implementations
 // =============================================================================
@@ -65,6 +314,7 @@ bool iscc_imp_check_data_set(void* const data_set)
 	if (data_set == NULL) return false;
 	const scc_DataSet* const data_set_cast = (const scc_DataSet*) data_set;
 	if (!scc_is_initialized_data_set(data_set_cast)) return false;
+	if (data_set_cast->dist_functions != NULL) return false;
 	return true;
 }
 
@@ -87,6 +337,11 @@ bool iscc_imp_get_dist_matrix(void* const data_set,
 	assert(len_point_indices > 1);
 	assert(output_dists != NULL);
 
+	if (((const scc_DataSet*) data_set)->sq_norms != NULL) {
+		iscc_get_dist_matrix_blocked(data_set, len_point_indices, point_indices, output_dists);
+		return true;
+	}
+
 	if (point_indices == NULL) {
 		for (size_t p1 = 0; p1 < len_point_indices; ++p1) {
 			for (size_t p2 = p1 + 1; p2 < len_point_indices; ++p2) {
@@ -119,6 +374,11 @@ bool iscc_imp_get_dist_rows(void* const data_set,
 	assert(len_column_indices > 0);
 	assert(output_dists != NULL);
 
+	if (((const scc_DataSet*) data_set)->sq_norms != NULL) {
+		iscc_get_dist_rows_blocked(data_set, len_query_indices, query_indices, len_column_indices, column_indices, output_dists);
+		return true;
+	}
+
 	if ((query_indices != NULL) && (column_indices != NULL)) {
 		for (size_t q = 0; q < len_query_indices; ++q) {
 			for (size_t c = 0; c < len_column_indices; ++c) {
@@ -287,11 +547,84 @@ bool iscc_imp_close_max_dist_object(iscc_MaxDistObject** const max_dist_object)
 // Nearest neighbor search functions implementations
 // =============================================================================
 
+// Search sets with at most this many points are searched by brute force,
+// and tree leaves contain at most this many points.
+#define ISCC_KD_LEAF_SIZE 8
+
+// Search trees are not built for data with more dimensions than this
+// as they rarely prune any subtrees in high-dimensional spaces.
+#define ISCC_KD_MAX_DIMENSIONS 16
+
+// Relative slack when comparing the distance to a tree cell with the search bound. The cell
+// distance is summed in another order than the distances to points, so the two can differ by
+// rounding even when a point on the cell boundary ties with the bound.
+#define ISCC_KD_BOUND_SLACK 1e-9
+
+// Candidate lists for at least this many neighbors are kept as binary max-heaps
+// rather than sorted arrays, so that accepting a candidate costs O(log k) rather
+// than O(k). The heap is sorted once the search of a query is done.
+#define ISCC_NN_HEAP_MIN_K 128
+
+
+typedef struct iscc_KDNode iscc_KDNode;
+struct iscc_KDNode {
+	uint_fast16_t split_dimension;
+	double lower_max;
+	double upper_min;
+};
+
+
+// The `k` best candidates by distance and, for equal distances, by search position.
+// `bound` is the largest accepted distance.
+typedef struct iscc_NNCandidates iscc_NNCandidates;
+struct iscc_NNCandidates {
+	uint32_t k;
+	uint32_t found;
+	bool use_heap;
+	double bound;
+	double* dists;
+	size_t* positions;
+};
+
+
+// Candidate lists of a typed search. `lists[t]` holds the nearest points of type `t` and
+// `lists[num_types]` the nearest points of any type. Unused lists have `k == 0` and a negative
+// bound so that they accept no candidates. `bound` is the largest bound of all lists.
+typedef struct iscc_TypedCandidates iscc_TypedCandidates;
+struct iscc_TypedCandidates {
+	const iscc_TypedNNQuery* typed_query;
+	double bound;
+	iscc_NNCandidates* lists;
+};
+
+
+// `typed` is NULL unless the query is part of a typed search, in which case `candidates` is unused.
+// Candidates are keyed by search position, or by rank in `search_subset` when it is not NULL.
+// `tombstone_dist` and `tombstone_position` hold the nearest tombstoned point found so far; no
+// candidate after it can be among the query's nearest neighbors, so it bounds the search.
+typedef struct iscc_KDQuery iscc_KDQuery;
+struct iscc_KDQuery {
+	const iscc_SearchSubset* search_subset;
+	const iscc_BitsetWord* tombstones;
+	double tombstone_dist;
+	size_t tombstone_position;
+	double* query_point;
+	size_t query;
+	double* offsets;
+	iscc_NNCandidates candidates;
+	iscc_TypedCandidates* typed;
+};
+
+
 struct iscc_NNSearchObject {
 	int32_t nn_search_version;
 	scc_DataSet* data_set;
 	size_t len_search_indices;
 	const scc_PointIndex* search_indices;
+	scc_PointIndex* kd_order;
+	iscc_KDNode* kd_nodes;
+	// Order of the dimension blocks in brute-force searches, NULL means natural order
+	uint_fast16_t* block_order;
 };
 
 
@@ -317,6 +650,649 @@ static inline void iscc_add_dist_to_list(const double add_dist,
 }
 
 
+static bool iscc_init_nn_candidates(const uint32_t k,
+                                    iscc_NNCandidates* const out_candidates)
+{
+	*out_candidates = (iscc_NNCandidates) {
+		.k = k,
+		.found = 0,
+		.use_heap = (k >= ISCC_NN_HEAP_MIN_K),
+		.bound = HUGE_VAL,
+		.dists = malloc(sizeof(double[k])),
+		.positions = malloc(sizeof(size_t[k])),
+	};
+	if ((out_candidates->dists == NULL) || (out_candidates->positions == NULL)) {
+		free(out_candidates->dists);
+		free(out_candidates->positions);
+		return false;
+	}
+	return true;
+}
+
+
+static void iscc_free_nn_candidates(iscc_NNCandidates* const candidates)
+{
+	free(candidates->dists);
+	free(candidates->positions);
+}
+
+
+static inline bool iscc_nn_candidate_before(const double dist1,
+                                            const size_t position1,
+                                            const double dist2,
+                                            const size_t position2)
+{
+	return (dist1 < dist2) || (!(dist1 > dist2) && (position1 < position2));
+}
+
+
+static inline void iscc_nn_heap_sift_down(iscc_NNCandidates* const candidates,
+                                          size_t node,
+                                          const size_t heap_size)
+{
+	double* const dists = candidates->dists;
+	size_t* const positions = candidates->positions;
+	const double node_dist = dists[node];
+	const size_t node_position = positions[node];
+	for (size_t child = 2 * node + 1; child < heap_size; child = 2 * node + 1) {
+		if ((child + 1 < heap_size) &&
+		        iscc_nn_candidate_before(dists[child], positions[child], dists[child + 1], positions[child + 1])) {
+			++child;
+		}
+		if (!iscc_nn_candidate_before(node_dist, node_position, dists[child], positions[child])) break;
+		dists[node] = dists[child];
+		positions[node] = positions[child];
+		node = child;
+	}
+	dists[node] = node_dist;
+	positions[node] = node_position;
+}
+
+
+static inline void iscc_add_nn_candidate(iscc_NNCandidates* const candidates,
+                                         const double add_dist,
+                                         const size_t add_position)
+{
+	if (add_dist > candidates->bound) return;
+
+	double* const dists = candidates->dists;
+	size_t* const positions = candidates->positions;
+	const uint32_t k = candidates->k;
+
+	if (candidates->use_heap) {
+		// Max-heap with the worst candidate at the root
+		if (candidates->found == k) {
+			if (!iscc_nn_candidate_before(add_dist, add_position, dists[0], positions[0])) return;
+			dists[0] = add_dist;
+			positions[0] = add_position;
+			iscc_nn_heap_sift_down(candidates, 0, k);
+		} else {
+			size_t node = candidates->found;
+			++candidates->found;
+			for (; node > 0; node = (node - 1) / 2) {
+				const size_t parent = (node - 1) / 2;
+				if (!iscc_nn_candidate_before(dists[parent], positions[parent], add_dist, add_position)) break;
+				dists[node] = dists[parent];
+				positions[node] = positions[parent];
+			}
+			dists[node] = add_dist;
+			positions[node] = add_position;
+		}
+		if (candidates->found == k) {
+			candidates->bound = dists[0];
+		}
+		return;
+	}
+
+	uint32_t i = candidates->found;
+	if (i == k) {
+		if (!iscc_nn_candidate_before(add_dist, add_position, dists[i - 1], positions[i - 1])) return;
+		--i;
+	} else {
+		++candidates->found;
+	}
+
+	for (; (i > 0) && iscc_nn_candidate_before(add_dist, add_position, dists[i - 1], positions[i - 1]); --i) {
+		dists[i] = dists[i - 1];
+		positions[i] = positions[i - 1];
+	}
+	dists[i] = add_dist;
+	positions[i] = add_position;
+
+	if (candidates->found == k) {
+		candidates->bound = dists[k - 1];
+	}
+}
+
+
+// Orders the candidates from nearest to farthest
+static inline void iscc_sort_nn_candidates(iscc_NNCandidates* const candidates)
+{
+	if (!candidates->use_heap) return;
+	assert(candidates->found == candidates->k);
+	for (size_t heap_size = candidates->found; heap_size > 1; ) {
+		--heap_size;
+		const double tmp_dist = candidates->dists[0];
+		const size_t tmp_position = candidates->positions[0];
+		candidates->dists[0] = candidates->dists[heap_size];
+		candidates->positions[0] = candidates->positions[heap_size];
+		candidates->dists[heap_size] = tmp_dist;
+		candidates->positions[heap_size] = tmp_position;
+		iscc_nn_heap_sift_down(candidates, 0, heap_size);
+	}
+}
+
+
+static bool iscc_init_typed_candidates(const iscc_TypedNNQuery* const typed_query,
+                                       iscc_TypedCandidates* const out_typed)
+{
+	const uint_fast16_t num_types = typed_query->num_types;
+	*out_typed = (iscc_TypedCandidates) {
+		.typed_query = typed_query,
+		.bound = HUGE_VAL,
+		.lists = malloc(sizeof(iscc_NNCandidates[num_types + 1])),
+	};
+	if (out_typed->lists == NULL) return false;
+
+	for (uint_fast16_t t = 0; t <= num_types; ++t) {
+		const uint32_t k = (t < num_types) ? typed_query->type_ks[t] : typed_query->k_all;
+		if (k == 0) {
+			out_typed->lists[t] = (iscc_NNCandidates) {
+				.k = 0,
+				.found = 0,
+				.use_heap = false,
+				.bound = -HUGE_VAL,
+				.dists = NULL,
+				.positions = NULL,
+			};
+		} else if (!iscc_init_nn_candidates(k, &out_typed->lists[t])) {
+			for (uint_fast16_t i = 0; i < t; ++i) iscc_free_nn_candidates(&out_typed->lists[i]);
+			free(out_typed->lists);
+			return false;
+		}
+	}
+	return true;
+}
+
+
+static void iscc_free_typed_candidates(iscc_TypedCandidates* const typed)
+{
+	for (uint_fast16_t t = 0; t <= typed->typed_query->num_types; ++t) {
+		iscc_free_nn_candidates(&typed->lists[t]);
+	}
+	free(typed->lists);
+}
+
+
+static inline void iscc_reset_typed_candidates(iscc_TypedCandidates* const typed,
+                                               const double bound)
+{
+	typed->bound = bound;
+	for (uint_fast16_t t = 0; t <= typed->typed_query->num_types; ++t) {
+		if (typed->lists[t].k > 0) {
+			typed->lists[t].found = 0;
+			typed->lists[t].bound = bound;
+		}
+	}
+}
+
+
+static inline void iscc_update_typed_bound(iscc_TypedCandidates* const typed)
+{
+	double bound = -HUGE_VAL;
+	for (uint_fast16_t t = 0; t <= typed->typed_query->num_types; ++t) {
+		if (typed->lists[t].bound > bound) bound = typed->lists[t].bound;
+	}
+	typed->bound = bound;
+}
+
+
+// The distance is computed once and offered to both the list of the point's type and the list of any type.
+// Lists of a type are keyed by reversed search position so that their ties go to the latest position.
+static inline void iscc_add_typed_candidate(iscc_TypedCandidates* const typed,
+                                            const iscc_NNSearchObject* const nn_search_object,
+                                            const size_t query,
+                                            const size_t point,
+                                            const size_t position)
+{
+	iscc_NNCandidates* const type_list = &typed->lists[typed->typed_query->type_labels[point]];
+	iscc_NNCandidates* const all_list = &typed->lists[typed->typed_query->num_types];
+	const double point_bound = (type_list->bound > all_list->bound) ? type_list->bound : all_list->bound;
+	if (point_bound < 0.0) return;
+	const double tmp_dist = iscc_get_sq_dist_bounded(nn_search_object->data_set,
+	                                                 nn_search_object->block_order,
+	                                                 query,
+	                                                 point,
+	                                                 point_bound);
+	iscc_add_nn_candidate(type_list, tmp_dist, nn_search_object->len_search_indices - 1 - position);
+	iscc_add_nn_candidate(all_list, tmp_dist, position);
+}
+
+
+static inline double iscc_kd_query_bound(const iscc_KDQuery* const kd_query)
+{
+	if (kd_query->typed != NULL) return kd_query->typed->bound;
+	return (kd_query->tombstone_dist < kd_query->candidates.bound) ? kd_query->tombstone_dist : kd_query->candidates.bound;
+}
+
+
+// Keeps the nearest tombstoned point. Points beyond the candidate bound are never among the
+// nearest neighbors, so they are ignored just as live points would be.
+static inline void iscc_add_tombstone(const iscc_NNCandidates* const candidates,
+                                      const double add_dist,
+                                      const size_t add_position,
+                                      double* const tombstone_dist,
+                                      size_t* const tombstone_position)
+{
+	if (add_dist > candidates->bound) return;
+	if (iscc_nn_candidate_before(add_dist, add_position, *tombstone_dist, *tombstone_position)) {
+		*tombstone_dist = add_dist;
+		*tombstone_position = add_position;
+	}
+}
+
+
+// A query with `k` sorted candidates is ok unless a tombstoned point precedes its farthest candidate
+static inline bool iscc_tombstone_before_kth(const iscc_NNCandidates* const candidates,
+                                             const double tombstone_dist,
+                                             const size_t tombstone_position)
+{
+	assert(candidates->found == candidates->k);
+	const uint32_t last = candidates->k - 1;
+	return iscc_nn_candidate_before(tombstone_dist, tombstone_position,
+	                                candidates->dists[last], candidates->positions[last]);
+}
+
+
+static inline bool iscc_kd_within_bound(const double rd,
+                                        const double bound)
+{
+	return rd <= bound + bound * ISCC_KD_BOUND_SLACK;
+}
+
+
+static inline size_t iscc_kd_point(const iscc_NNSearchObject* const nn_search_object,
+                                   const size_t position)
+{
+	assert(position < nn_search_object->len_search_indices);
+	if (nn_search_object->search_indices == NULL) return position;
+	return (size_t) nn_search_object->search_indices[position];
+}
+
+
+// The key of `position` in a search on `search_subset`, or `SIZE_MAX` if it is not in the subset
+static inline size_t iscc_subset_key(const iscc_NNSearchObject* const nn_search_object,
+                                     const iscc_SearchSubset* const search_subset,
+                                     const size_t position)
+{
+	if (search_subset == NULL) return position;
+	const scc_PointIndex rank = search_subset->ranks[iscc_kd_point(nn_search_object, position)];
+	if (rank == ISCC_POINTINDEX_MAX_PI) return SIZE_MAX;
+	return (size_t) rank;
+}
+
+
+static inline size_t iscc_subset_point(const iscc_NNSearchObject* const nn_search_object,
+                                       const iscc_SearchSubset* const search_subset,
+                                       const size_t key)
+{
+	if (search_subset == NULL) return iscc_kd_point(nn_search_object, key);
+	return (size_t) search_subset->points[key];
+}
+
+
+static inline double iscc_kd_coord(const iscc_NNSearchObject* const nn_search_object,
+                                   const scc_PointIndex position,
+                                   const uint_fast16_t dimension)
+{
+	return iscc_data_set_coord(nn_search_object->data_set,
+	                           iscc_kd_point(nn_search_object, (size_t) position),
+	                           dimension);
+}
+
+
+static inline void iscc_kd_swap(scc_PointIndex* const a,
+                                scc_PointIndex* const b)
+{
+	const scc_PointIndex tmp = *a;
+	*a = *b;
+	*b = tmp;
+}
+
+
+// Rearranges `kd_order[begin:end]` so that `kd_order[nth]` is the point that
+// would be in that position if the range were sorted along `dimension`.
+static void iscc_kd_select(const iscc_NNSearchObject* const nn_search_object,
+                           const uint_fast16_t dimension,
+                           size_t begin,
+                           size_t end,
+                           const size_t nth)
+{
+	scc_PointIndex* const order = nn_search_object->kd_order;
+	assert(begin <= nth);
+	assert(nth < end);
+
+	while (end - begin > 1) {
+		// Median of three
+		double pivot = iscc_kd_coord(nn_search_object, order[begin], dimension);
+		double tmp_mid = iscc_kd_coord(nn_search_object, order[begin + (end - begin) / 2], dimension);
+		double tmp_last = iscc_kd_coord(nn_search_object, order[end - 1], dimension);
+		if (tmp_mid < pivot) {
+			const double tmp = pivot;
+			pivot = tmp_mid;
+			tmp_mid = tmp;
+		}
+		if (tmp_last < tmp_mid) tmp_mid = (tmp_last < pivot) ? pivot : tmp_last;
+		pivot = tmp_mid;
+
+		// Three-way partition: [begin, lt) < pivot, [lt, gt) == pivot, [gt, end) > pivot
+		size_t lt = begin;
+		size_t gt = end;
+		for (size_t i = begin; i < gt; ) {
+			const double value = iscc_kd_coord(nn_search_object, order[i], dimension);
+			if (value < pivot) {
+				iscc_kd_swap(&order[lt], &order[i]);
+				++lt;
+				++i;
+			} else if (value > pivot) {
+				--gt;
+				iscc_kd_swap(&order[i], &order[gt]);
+			} else {
+				++i;
+			}
+		}
+
+		if (nth < lt) {
+			end = lt;
+		} else if (nth >= gt) {
+			begin = gt;
+		} else {
+			return;
+		}
+	}
+}
+
+
+static void iscc_kd_build_tree(iscc_NNSearchObject* const nn_search_object,
+                               const size_t node,
+                               const size_t begin,
+                               const size_t end)
+{
+	if (end - begin <= ISCC_KD_LEAF_SIZE) return;
+
+	const scc_PointIndex* const order = nn_search_object->kd_order;
+	const uint_fast16_t num_dimensions = nn_search_object->data_set->num_dimensions;
+
+	// Split along the dimension with largest spread
+	uint_fast16_t split_dimension = 0;
+	double max_spread = -1.0;
+	for (uint_fast16_t d = 0; d < num_dimensions; ++d) {
+		double min_value = iscc_kd_coord(nn_search_object, order[begin], d);
+		double max_value = min_value;
+		for (size_t i = begin + 1; i < end; ++i) {
+			const double value = iscc_kd_coord(nn_search_object, order[i], d);
+			if (value < min_value) min_value = value;
+			if (value > max_value) max_value = value;
+		}
+		if (max_value - min_value > max_spread) {
+			max_spread = max_value - min_value;
+			split_dimension = d;
+		}
+	}
+
+	const size_t mid = begin + (end - begin) / 2;
+	iscc_kd_select(nn_search_object, split_dimension, begin, end, mid);
+
+	double lower_max = iscc_kd_coord(nn_search_object, order[begin], split_dimension);
+	for (size_t i = begin + 1; i < mid; ++i) {
+		const double value = iscc_kd_coord(nn_search_object, order[i], split_dimension);
+		if (value > lower_max) lower_max = value;
+	}
+
+	nn_search_object->kd_nodes[node] = (iscc_KDNode) {
+		.split_dimension = split_dimension,
+		.lower_max = lower_max,
+		.upper_min = iscc_kd_coord(nn_search_object, order[mid], split_dimension),
+	};
+
+	iscc_kd_build_tree(nn_search_object, 2 * node + 1, begin, mid);
+	iscc_kd_build_tree(nn_search_object, 2 * node + 2, mid, end);
+}
+
+
+// `rd` is the squared distance between the query and the cell of `node`.
+// Subtrees are pruned only when farther away than the current bound, with
+// `ISCC_KD_BOUND_SLACK` for rounding, so that ties are resolved exactly as in
+// the brute-force search.
+static void iscc_kd_search_tree(const iscc_NNSearchObject* const nn_search_object,
+                                iscc_KDQuery* const kd_query,
+                                const size_t node,
+                                const size_t begin,
+                                const size_t end,
+                                const double rd)
+{
+	if (end - begin <= ISCC_KD_LEAF_SIZE) {
+		if (kd_query->typed != NULL) {
+			for (size_t i = begin; i < end; ++i) {
+				const size_t position = (size_t) nn_search_object->kd_order[i];
+				iscc_add_typed_candidate(kd_query->typed,
+				                         nn_search_object,
+				                         kd_query->query,
+				                         iscc_kd_point(nn_search_object, position),
+				                         position);
+			}
+			iscc_update_typed_bound(kd_query->typed);
+			return;
+		}
+		for (size_t i = begin; i < end; ++i) {
+			const size_t position = (size_t) nn_search_object->kd_order[i];
+			const size_t key = iscc_subset_key(nn_search_object, kd_query->search_subset, position);
+			if (key == SIZE_MAX) continue;
+			const size_t point = iscc_kd_point(nn_search_object, position);
+			const double tmp_dist = iscc_get_sq_dist_bounded(nn_search_object->data_set,
+			                                                 nn_search_object->block_order,
+			                                                 kd_query->query,
+			                                                 point,
+			                                                 iscc_kd_query_bound(kd_query));
+			if ((kd_query->tombstones != NULL) && iscc_bitset_test(kd_query->tombstones, point)) {
+				iscc_add_tombstone(&kd_query->candidates, tmp_dist, key,
+				                   &kd_query->tombstone_dist, &kd_query->tombstone_position);
+			} else {
+				iscc_add_nn_candidate(&kd_query->candidates, tmp_dist, key);
+			}
+		}
+		return;
+	}
+
+	const iscc_KDNode* const kd_node = &nn_search_object->kd_nodes[node];
+	const size_t mid = begin + (end - begin) / 2;
+	const uint_fast16_t dim = kd_node->split_dimension;
+	const double value = kd_query->query_point[dim];
+	const double old_offset = kd_query->offsets[dim];
+
+	double lower_offset = value - kd_node->lower_max;
+	if (lower_offset < old_offset) lower_offset = old_offset;
+	double upper_offset = kd_node->upper_min - value;
+	if (upper_offset < old_offset) upper_offset = old_offset;
+
+	const double lower_rd = rd - old_offset * old_offset + lower_offset * lower_offset;
+	const double upper_rd = rd - old_offset * old_offset + upper_offset * upper_offset;
+
+	if (lower_rd <= upper_rd) {
+		kd_query->offsets[dim] = lower_offset;
+		iscc_kd_search_tree(nn_search_object, kd_query, 2 * node + 1, begin, mid, lower_rd);
+		if (iscc_kd_within_bound(upper_rd, iscc_kd_query_bound(kd_query))) {
+			kd_query->offsets[dim] = upper_offset;
+			iscc_kd_search_tree(nn_search_object, kd_query, 2 * node + 2, mid, end, upper_rd);
+		}
+	} else {
+		kd_query->offsets[dim] = upper_offset;
+		iscc_kd_search_tree(nn_search_object, kd_query, 2 * node + 2, mid, end, upper_rd);
+		if (iscc_kd_within_bound(lower_rd, iscc_kd_query_bound(kd_query))) {
+			kd_query->offsets[dim] = lower_offset;
+			iscc_kd_search_tree(nn_search_object, kd_query, 2 * node + 1, begin, mid, lower_rd);
+		}
+	}
+
+	kd_query->offsets[dim] = old_offset;
+}
+
+
+static bool iscc_kd_nearest_neighbor_search(const iscc_NNSearchObject* const nn_search_object,
+                                            const iscc_SearchSubset* const search_subset,
+                                            const iscc_BitsetWord tombstones[const],
+                                            const size_t len_query_indices,
+                                            const scc_PointIndex query_indices[const],
+                                            const uint32_t k,
+                                            const bool radius_search,
+                                            const double radius,
+                                            size_t* const out_num_ok_queries,
+                                            scc_PointIndex out_query_indices[const],
+                                            scc_PointIndex out_nn_indices[const])
+{
+	assert(nn_search_object->kd_order != NULL);
+	const scc_DataSet* const data_set = nn_search_object->data_set;
+
+	iscc_KDQuery kd_query = {
+		.search_subset = search_subset,
+		.tombstones = tombstones,
+		.query_point = malloc(sizeof(double[data_set->num_dimensions])),
+		.offsets = malloc(sizeof(double[data_set->num_dimensions])),
+		.typed = NULL,
+	};
+	if ((kd_query.query_point == NULL) || (kd_query.offsets == NULL)) {
+		free(kd_query.query_point);
+		free(kd_query.offsets);
+		return false;
+	}
+	if (!iscc_init_nn_candidates(k, &kd_query.candidates)) {
+		free(kd_query.query_point);
+		free(kd_query.offsets);
+		return false;
+	}
+
+	size_t num_ok_queries = 0;
+	scc_PointIndex* index_write = out_nn_indices;
+	const double radius_sq = radius * radius;
+
+	for (size_t q = 0; q < len_query_indices; ++q) {
+		size_t query = q;
+		if (query_indices != NULL) {
+			query = (size_t) query_indices[q];
+		}
+		assert(query < data_set->num_data_points);
+
+		kd_query.query = query;
+		kd_query.candidates.found = 0;
+		kd_query.candidates.bound = radius_search ? radius_sq : HUGE_VAL;
+		kd_query.tombstone_dist = HUGE_VAL;
+		kd_query.tombstone_position = SIZE_MAX;
+		for (uint_fast16_t d = 0; d < data_set->num_dimensions; ++d) {
+			kd_query.query_point[d] = iscc_data_set_coord(data_set, query, d);
+			kd_query.offsets[d] = 0.0;
+		}
+
+		iscc_kd_search_tree(nn_search_object, &kd_query, 0, 0, nn_search_object->len_search_indices, 0.0);
+
+		assert(kd_query.candidates.found == k || radius_search || (tombstones != NULL));
+		if (kd_query.candidates.found == k) {
+			iscc_sort_nn_candidates(&kd_query.candidates);
+		}
+		if ((kd_query.candidates.found == k) &&
+		        !iscc_tombstone_before_kth(&kd_query.candidates, kd_query.tombstone_dist, kd_query.tombstone_position)) {
+			for (uint32_t i = 0; i < k; ++i) {
+				index_write[i] = (scc_PointIndex) iscc_subset_point(nn_search_object, search_subset, kd_query.candidates.positions[i]);
+			}
+			if (out_query_indices != NULL) {
+				out_query_indices[num_ok_queries] = (scc_PointIndex) query;
+			}
+			++num_ok_queries;
+			index_write += k;
+		}
+	}
+
+	*out_num_ok_queries = num_ok_queries;
+
+	free(kd_query.query_point);
+	free(kd_query.offsets);
+	iscc_free_nn_candidates(&kd_query.candidates);
+
+	return true;
+}
+
+
+// Scans all search points with a candidate list. Used for large `k` and for filtered or tombstoned searches.
+static bool iscc_scan_nearest_neighbor_search(const iscc_NNSearchObject* const nn_search_object,
+                                              const iscc_SearchSubset* const search_subset,
+                                              const iscc_BitsetWord tombstones[const],
+                                              const size_t len_query_indices,
+                                              const scc_PointIndex query_indices[const],
+                                              const uint32_t k,
+                                              const bool radius_search,
+                                              const double radius,
+                                              size_t* const out_num_ok_queries,
+                                              scc_PointIndex out_query_indices[const],
+                                              scc_PointIndex out_nn_indices[const])
+{
+	const scc_DataSet* const data_set = nn_search_object->data_set;
+	const size_t len_search_indices = nn_search_object->len_search_indices;
+
+	iscc_NNCandidates candidates;
+	if (!iscc_init_nn_candidates(k, &candidates)) return false;
+
+	size_t num_ok_queries = 0;
+	scc_PointIndex* index_write = out_nn_indices;
+	const double radius_sq = radius * radius;
+
+	for (size_t q = 0; q < len_query_indices; ++q) {
+		size_t query = q;
+		if (query_indices != NULL) {
+			query = (size_t) query_indices[q];
+		}
+		assert(query < data_set->num_data_points);
+
+		candidates.found = 0;
+		candidates.bound = radius_search ? radius_sq : HUGE_VAL;
+		double tombstone_dist = HUGE_VAL;
+		size_t tombstone_position = SIZE_MAX;
+		for (size_t s = 0; s < len_search_indices; ++s) {
+			const size_t key = iscc_subset_key(nn_search_object, search_subset, s);
+			if (key == SIZE_MAX) continue;
+			const size_t point = iscc_kd_point(nn_search_object, s);
+			const double bound = (tombstone_dist < candidates.bound) ? tombstone_dist : candidates.bound;
+			const double tmp_dist = iscc_get_sq_dist_bounded(data_set, nn_search_object->block_order, query, point, bound);
+			if ((tombstones != NULL) && iscc_bitset_test(tombstones, point)) {
+				iscc_add_tombstone(&candidates, tmp_dist, key, &tombstone_dist, &tombstone_position);
+			} else {
+				iscc_add_nn_candidate(&candidates, tmp_dist, key);
+			}
+		}
+
+		assert(candidates.found == k || radius_search || (tombstones != NULL));
+		if (candidates.found == k) {
+			iscc_sort_nn_candidates(&candidates);
+		}
+		if ((candidates.found == k) &&
+		        !iscc_tombstone_before_kth(&candidates, tombstone_dist, tombstone_position)) {
+			for (uint32_t i = 0; i < k; ++i) {
+				index_write[i] = (scc_PointIndex) iscc_subset_point(nn_search_object, search_subset, candidates.positions[i]);
+			}
+			if (out_query_indices != NULL) {
+				out_query_indices[num_ok_queries] = (scc_PointIndex) query;
+			}
+			++num_ok_queries;
+			index_write += k;
+		}
+	}
+
+	*out_num_ok_queries = num_ok_queries;
+
+	iscc_free_nn_candidates(&candidates);
+
+	return true;
+}
+
+
 bool iscc_imp_init_nn_search_object(void* const data_set,
                                     const size_t len_search_indices,
                                     const scc_PointIndex search_indices[const],
@@ -334,8 +1310,41 @@ bool iscc_imp_init_nn_search_object(void* const data_set,
 		.data_set = data_set,
 		.len_search_indices = len_search_indices,
 		.search_indices = search_indices,
+		.kd_order = NULL,
+		.kd_nodes = NULL,
+		.block_order = NULL,
 	};
 
+	if (iscc_imp_nn_search_uses_tree(data_set, len_search_indices)) {
+		// Internal nodes of a complete tree where all leaves have at most `ISCC_KD_LEAF_SIZE` points
+		size_t num_nodes = 1;
+		for (size_t leaf_size = len_search_indices; leaf_size > ISCC_KD_LEAF_SIZE; leaf_size = leaf_size - leaf_size / 2) {
+			num_nodes *= 2;
+		}
+		--num_nodes;
+
+		iscc_NNSearchObject* const nn_search_object = *out_nn_search_object;
+		nn_search_object->kd_order = malloc(sizeof(scc_PointIndex[len_search_indices]));
+		nn_search_object->kd_nodes = malloc(sizeof(iscc_KDNode[num_nodes]));
+		if ((nn_search_object->kd_order == NULL) || (nn_search_object->kd_nodes == NULL)) {
+			iscc_imp_close_nn_search_object(out_nn_search_object);
+			return false;
+		}
+
+		for (size_t i = 0; i < len_search_indices; ++i) {
+			nn_search_object->kd_order[i] = (scc_PointIndex) i;
+		}
+		iscc_kd_build_tree(nn_search_object, 0, 0, len_search_indices);
+
+	} else if (((scc_DataSet*) data_set)->num_dimensions >= ISCC_DATASET_BLOCK_ORDER_MIN_DIMENSIONS) {
+		// Only brute-force searches visit the blocks of wide data sets
+		(*out_nn_search_object)->block_order = iscc_make_block_order(data_set, len_search_indices, search_indices);
+		if ((*out_nn_search_object)->block_order == NULL) {
+			iscc_imp_close_nn_search_object(out_nn_search_object);
+			return false;
+		}
+	}
+
 	return true;
 }
 
@@ -355,6 +1364,7 @@ bool iscc_imp_nearest_neighbor_search(iscc_NNSearchObject* const nn_search_objec
 	scc_DataSet* const data_set = nn_search_object->data_set;
 	const size_t len_search_indices = nn_search_object->len_search_indices;
 	const scc_PointIndex* const search_indices = nn_search_object->search_indices;
+	const uint_fast16_t* const block_order = nn_search_object->block_order;
 
 	assert(iscc_imp_check_data_set(data_set));
 	assert(len_search_indices > 0);
@@ -365,6 +1375,34 @@ bool iscc_imp_nearest_neighbor_search(iscc_NNSearchObject* const nn_search_objec
 	assert(out_num_ok_queries != NULL);
 	assert(out_nn_indices != NULL);
 
+	if (nn_search_object->kd_order != NULL) {
+		return iscc_kd_nearest_neighbor_search(nn_search_object,
+		                                       NULL,
+		                                       NULL,
+		                                       len_query_indices,
+		                                       query_indices,
+		                                       k,
+		                                       radius_search,
+		                                       radius,
+		                                       out_num_ok_queries,
+		                                       out_query_indices,
+		                                       out_nn_indices);
+	}
+
+	if (k >= ISCC_NN_HEAP_MIN_K) {
+		return iscc_scan_nearest_neighbor_search(nn_search_object,
+		                                         NULL,
+		                                         NULL,
+		                                         len_query_indices,
+		                                         query_indices,
+		                                         k,
+		                                         radius_search,
+		                                         radius,
+		                                         out_num_ok_queries,
+		                                         out_query_indices,
+		                                         out_nn_indices);
+	}
+
 	double tmp_dist;
 	size_t num_ok_queries = 0;
 	scc_PointIndex* index_write = out_nn_indices;
@@ -386,14 +1424,14 @@ bool iscc_imp_nearest_neighbor_search(iscc_NNSearchObject* const nn_search_objec
 			if (radius_search) {
 				found = 0;
 				for (; (s < len_search_indices) && (found < k); ++s) {
-					tmp_dist = iscc_get_sq_dist(data_set, query, s);
+					tmp_dist = iscc_get_sq_dist_bounded(data_set, block_order, query, s, radius_sq);
 					if (tmp_dist > radius_sq) continue;
 					iscc_add_dist_to_list(tmp_dist, (scc_PointIndex) s, sort_scratch + found, index_write + found, sort_scratch);
 					++found;
 				}
 			} else {
 				for (; s < k; ++s) {
-					tmp_dist = iscc_get_sq_dist(data_set, query, s);
+					tmp_dist = iscc_get_sq_dist_bounded(data_set, block_order, query, s, HUGE_VAL);
 					iscc_add_dist_to_list(tmp_dist, (scc_PointIndex) s, sort_scratch + s, index_write + s, sort_scratch);
 				}
 				found = k;
@@ -401,7 +1439,7 @@ bool iscc_imp_nearest_neighbor_search(iscc_NNSearchObject* const nn_search_objec
 
 			for (; s < len_search_indices; ++s) {
 				assert(found == k);
-				tmp_dist = iscc_get_sq_dist(data_set, query, s);
+				tmp_dist = iscc_get_sq_dist_bounded(data_set, block_order, query, s, *sort_scratch_end);
 				if (tmp_dist >= *sort_scratch_end) continue;
 				iscc_add_dist_to_list(tmp_dist, (scc_PointIndex) s, sort_scratch_end, index_write_end, sort_scratch);
 			}
@@ -429,14 +1467,14 @@ bool iscc_imp_nearest_neighbor_search(iscc_NNSearchObject* const nn_search_objec
 			if (radius_search) {
 				found = 0;
 				for (; (s < len_search_indices) && (found < k); ++s) {
-					tmp_dist = iscc_get_sq_dist(data_set, query, (size_t) search_indices[s]);
+					tmp_dist = iscc_get_sq_dist_bounded(data_set, block_order, query, (size_t) search_indices[s], radius_sq);
 					if (tmp_dist > radius_sq) continue;
 					iscc_add_dist_to_list(tmp_dist, search_indices[s], sort_scratch + found, index_write + found, sort_scratch);
 					++found;
 				}
 			} else {
 				for (; s < k; ++s) {
-					tmp_dist = iscc_get_sq_dist(data_set, query, (size_t) search_indices[s]);
+					tmp_dist = iscc_get_sq_dist_bounded(data_set, block_order, query, (size_t) search_indices[s], HUGE_VAL);
 					iscc_add_dist_to_list(tmp_dist, search_indices[s], sort_scratch + s, index_write + s, sort_scratch);
 				}
 				found = k;
@@ -444,7 +1482,7 @@ bool iscc_imp_nearest_neighbor_search(iscc_NNSearchObject* const nn_search_objec
 
 			for (; s < len_search_indices; ++s) {
 				assert(found == k);
-				tmp_dist = iscc_get_sq_dist(data_set, query, (size_t) search_indices[s]);
+				tmp_dist = iscc_get_sq_dist_bounded(data_set, block_order, query, (size_t) search_indices[s], *sort_scratch_end);
 				if (tmp_dist >= *sort_scratch_end) continue;
 				iscc_add_dist_to_list(tmp_dist, search_indices[s], sort_scratch_end, index_write_end, sort_scratch);
 			}
@@ -468,10 +1506,223 @@ bool iscc_imp_nearest_neighbor_search(iscc_NNSearchObject* const nn_search_objec
 }
 
 
+bool iscc_imp_filtered_nearest_neighbor_search(iscc_NNSearchObject* const nn_search_object,
+                                               const iscc_SearchSubset* const search_subset,
+                                               const size_t len_query_indices,
+                                               const scc_PointIndex query_indices[const],
+                                               const uint32_t k,
+                                               const bool radius_search,
+                                               const double radius,
+                                               size_t* const out_num_ok_queries,
+                                               scc_PointIndex out_query_indices[const],
+                                               scc_PointIndex out_nn_indices[const])
+{
+	assert(nn_search_object != NULL);
+	assert(nn_search_object->nn_search_version == ISCC_NN_SEARCH_STRUCT_VERSION);
+	assert(search_subset != NULL);
+	assert(search_subset->points != NULL);
+	assert(search_subset->ranks != NULL);
+	assert(len_query_indices > 0);
+	assert(k > 0);
+	assert(!radius_search || (radius > 0.0));
+	assert(out_num_ok_queries != NULL);
+	assert(out_nn_indices != NULL);
+
+	if (nn_search_object->kd_order != NULL) {
+		return iscc_kd_nearest_neighbor_search(nn_search_object,
+		                                       search_subset,
+		                                       NULL,
+		                                       len_query_indices,
+		                                       query_indices,
+		                                       k,
+		                                       radius_search,
+		                                       radius,
+		                                       out_num_ok_queries,
+		                                       out_query_indices,
+		                                       out_nn_indices);
+	}
+
+	return iscc_scan_nearest_neighbor_search(nn_search_object,
+	                                         search_subset,
+	                                         NULL,
+	                                         len_query_indices,
+	                                         query_indices,
+	                                         k,
+	                                         radius_search,
+	                                         radius,
+	                                         out_num_ok_queries,
+	                                         out_query_indices,
+	                                         out_nn_indices);
+}
+
+
+bool iscc_imp_tombstoned_nearest_neighbor_search(iscc_NNSearchObject* const nn_search_object,
+                                                 const iscc_BitsetWord tombstones[const],
+                                                 const size_t len_query_indices,
+                                                 const scc_PointIndex query_indices[const],
+                                                 const uint32_t k,
+                                                 const bool radius_search,
+                                                 const double radius,
+                                                 size_t* const out_num_ok_queries,
+                                                 scc_PointIndex out_query_indices[const],
+                                                 scc_PointIndex out_nn_indices[const])
+{
+	assert(nn_search_object != NULL);
+	assert(nn_search_object->nn_search_version == ISCC_NN_SEARCH_STRUCT_VERSION);
+	assert(tombstones != NULL);
+	assert(len_query_indices > 0);
+	assert(k > 0);
+	assert(k <= nn_search_object->len_search_indices);
+	assert(!radius_search || (radius > 0.0));
+	assert(out_num_ok_queries != NULL);
+	assert(out_query_indices != NULL);
+	assert(out_nn_indices != NULL);
+
+	if (nn_search_object->kd_order != NULL) {
+		return iscc_kd_nearest_neighbor_search(nn_search_object,
+		                                       NULL,
+		                                       tombstones,
+		                                       len_query_indices,
+		                                       query_indices,
+		                                       k,
+		                                       radius_search,
+		                                       radius,
+		                                       out_num_ok_queries,
+		                                       out_query_indices,
+		                                       out_nn_indices);
+	}
+
+	return iscc_scan_nearest_neighbor_search(nn_search_object,
+	                                         NULL,
+	                                         tombstones,
+	                                         len_query_indices,
+	                                         query_indices,
+	                                         k,
+	                                         radius_search,
+	                                         radius,
+	                                         out_num_ok_queries,
+	                                         out_query_indices,
+	                                         out_nn_indices);
+}
+
+
+bool iscc_imp_typed_nearest_neighbor_search(iscc_NNSearchObject* const nn_search_object,
+                                            const iscc_TypedNNQuery* const typed_query,
+                                            const size_t len_query_indices,
+                                            const scc_PointIndex query_indices[const],
+                                            const bool radius_search,
+                                            const double radius,
+                                            size_t* const out_num_ok_queries,
+                                            scc_PointIndex out_query_indices[const],
+                                            scc_PointIndex out_nn_indices[const])
+{
+	assert(nn_search_object != NULL);
+	assert(nn_search_object->nn_search_version == ISCC_NN_SEARCH_STRUCT_VERSION);
+	assert(typed_query != NULL);
+	assert(typed_query->type_labels != NULL);
+	assert(len_query_indices > 0);
+	assert(!radius_search || (radius > 0.0));
+	assert(out_num_ok_queries != NULL);
+	assert(out_nn_indices != NULL);
+
+	const scc_DataSet* const data_set = nn_search_object->data_set;
+	const size_t len_search_indices = nn_search_object->len_search_indices;
+
+	iscc_TypedCandidates typed;
+	if (!iscc_init_typed_candidates(typed_query, &typed)) return false;
+
+	iscc_KDQuery kd_query = {
+		.search_subset = NULL,
+		.query_point = NULL,
+		.offsets = NULL,
+		.typed = &typed,
+	};
+	if (nn_search_object->kd_order != NULL) {
+		kd_query.query_point = malloc(sizeof(double[data_set->num_dimensions]));
+		kd_query.offsets = malloc(sizeof(double[data_set->num_dimensions]));
+		if ((kd_query.query_point == NULL) || (kd_query.offsets == NULL)) {
+			free(kd_query.query_point);
+			free(kd_query.offsets);
+			iscc_free_typed_candidates(&typed);
+			return false;
+		}
+	}
+
+	size_t num_ok_queries = 0;
+	scc_PointIndex* index_write = out_nn_indices;
+	const double radius_sq = radius * radius;
+
+	for (size_t q = 0; q < len_query_indices; ++q) {
+		size_t query = q;
+		if (query_indices != NULL) {
+			query = (size_t) query_indices[q];
+		}
+		assert(query < data_set->num_data_points);
+
+		iscc_reset_typed_candidates(&typed, radius_search ? radius_sq : HUGE_VAL);
+		if (nn_search_object->kd_order != NULL) {
+			kd_query.query = query;
+			for (uint_fast16_t d = 0; d < data_set->num_dimensions; ++d) {
+				kd_query.query_point[d] = iscc_data_set_coord(data_set, query, d);
+				kd_query.offsets[d] = 0.0;
+			}
+			iscc_kd_search_tree(nn_search_object, &kd_query, 0, 0, len_search_indices, 0.0);
+		} else {
+			for (size_t s = 0; s < len_search_indices; ++s) {
+				iscc_add_typed_candidate(&typed, nn_search_object, query, iscc_kd_point(nn_search_object, s), s);
+			}
+		}
+
+		bool query_ok = true;
+		for (uint_fast16_t t = 0; t <= typed_query->num_types; ++t) {
+			if (typed.lists[t].found < typed.lists[t].k) query_ok = false;
+		}
+		assert(query_ok || radius_search);
+		if (query_ok) {
+			for (uint_fast16_t t = 0; t <= typed_query->num_types; ++t) {
+				iscc_NNCandidates* const list = &typed.lists[t];
+				if (list->k == 0) continue;
+				iscc_sort_nn_candidates(list);
+				for (uint32_t i = 0; i < list->k; ++i) {
+					size_t position = list->positions[i];
+					if (t < typed_query->num_types) position = len_search_indices - 1 - position;
+					index_write[i] = (scc_PointIndex) iscc_kd_point(nn_search_object, position);
+				}
+				index_write += list->k;
+			}
+			if (out_query_indices != NULL) {
+				out_query_indices[num_ok_queries] = (scc_PointIndex) query;
+			}
+			++num_ok_queries;
+		}
+	}
+
+	*out_num_ok_queries = num_ok_queries;
+
+	free(kd_query.query_point);
+	free(kd_query.offsets);
+	iscc_free_typed_candidates(&typed);
+
+	return true;
+}
+
+
+bool iscc_imp_nn_search_uses_tree(void* const data_set,
+                                  const size_t len_search_indices)
+{
+	assert(iscc_imp_check_data_set(data_set));
+	return (len_search_indices > ISCC_KD_LEAF_SIZE) &&
+	       (((scc_DataSet*) data_set)->num_dimensions <= ISCC_KD_MAX_DIMENSIONS);
+}
+
+
 bool iscc_imp_close_nn_search_object(iscc_NNSearchObject** const nn_search_object)
 {
 	if (nn_search_object != NULL && *nn_search_object != NULL) {
 		assert((*nn_search_object)->nn_search_version == ISCC_NN_SEARCH_STRUCT_VERSION);
+		free((*nn_search_object)->kd_order);
+		free((*nn_search_object)->kd_nodes);
+		free((*nn_search_object)->block_order);
 		free(*nn_search_object);
 		*nn_search_object = NULL;
 	}
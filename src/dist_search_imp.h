@@ -26,6 +26,7 @@
 #include <stdint.h>
 #include "../include/scclust.h"
 #include "../include/scclust_spi.h"
+#include "bitset.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -42,6 +43,12 @@ bool iscc_imp_check_data_set(void* data_set);
 size_t iscc_imp_num_data_points(void* data_set);
 
 
+// Distances reported by `iscc_imp_get_dist_matrix` and `iscc_imp_get_dist_rows` are summed over
+// all dimensions at once, or derived from dot products and cached norms in wide data. Nearest
+// neighbor searches in data with more than `ISCC_DATASET_DIMENSION_BLOCK` dimensions sum blocks of
+// dimensions in their own order, so the distance between the same pair of points may differ by
+// rounding between the two. Distances from the two should not be compared for exact ties.
+
 // `output_dists` must be of length `(len_point_indices - 1) len_point_indices / 2`
 bool iscc_imp_get_dist_matrix(void* data_set,
                               size_t len_point_indices,
@@ -101,6 +108,78 @@ bool iscc_imp_nearest_neighbor_search(iscc_NNSearchObject* nn_search_object,
                                       scc_PointIndex out_nn_indices[]);
 
 
+// A subset of the search points of a search object. `points` lists the subset and `ranks[p]` is
+// the position of data point `p` in `points`, or `ISCC_POINTINDEX_MAX_PI` if `p` is not in the subset.
+typedef struct iscc_SearchSubset {
+	const scc_PointIndex* points;
+	const scc_PointIndex* ranks;
+} iscc_SearchSubset;
+
+
+// As `iscc_imp_nearest_neighbor_search` but only search points in `search_subset` are considered,
+// and ties are broken by position in `search_subset->points` as if the search object had been
+// built on those points. The subset must hold at least `k` points unless `radius_search`.
+bool iscc_imp_filtered_nearest_neighbor_search(iscc_NNSearchObject* nn_search_object,
+                                               const iscc_SearchSubset* search_subset,
+                                               size_t len_query_indices,
+                                               const scc_PointIndex query_indices[],
+                                               uint32_t k,
+                                               bool radius_search,
+                                               double radius,
+                                               size_t* out_num_ok_queries,
+                                               scc_PointIndex out_query_indices[],
+                                               scc_PointIndex out_nn_indices[]);
+
+
+// As `iscc_imp_nearest_neighbor_search` but queries that have a point whose bit is set in
+// `tombstones` among their `k` nearest search points are not ok. Tombstoned points are never
+// reported, and the search around a query stops at the nearest tombstoned point, so queries
+// surrounded by tombstones are rejected early. `out_query_indices` cannot be NULL.
+bool iscc_imp_tombstoned_nearest_neighbor_search(iscc_NNSearchObject* nn_search_object,
+                                                 const iscc_BitsetWord tombstones[],
+                                                 size_t len_query_indices,
+                                                 const scc_PointIndex query_indices[],
+                                                 uint32_t k,
+                                                 bool radius_search,
+                                                 double radius,
+                                                 size_t* out_num_ok_queries,
+                                                 scc_PointIndex out_query_indices[],
+                                                 scc_PointIndex out_nn_indices[]);
+
+
+// Neighbors to find for each query in a typed search. `type_labels` has the type of each data point,
+// and `type_ks[t]` is the number of nearest search points to find of type `t`. `k_all` is the number
+// of nearest search points to find regardless of type. Any of these numbers may be zero, but not all.
+typedef struct iscc_TypedNNQuery {
+	uint_fast16_t num_types;
+	const scc_TypeLabel* type_labels;
+	const uint32_t* type_ks;
+	uint32_t k_all;
+} iscc_TypedNNQuery;
+
+
+// Finds the neighbors in `typed_query` with one search per query. The row of each ok query in
+// `out_nn_indices` holds the neighbors of each type in type order, followed by the neighbors of any
+// type, each list sorted by distance. Ties are broken by search position, latest first in the lists of
+// each type and earliest first in the list of any type. With `radius_search`, queries are dropped unless
+// all lists can be filled within the radius. `out_nn_indices` must be of length
+// `(sum(type_ks) + k_all) * len_query_indices`
+bool iscc_imp_typed_nearest_neighbor_search(iscc_NNSearchObject* nn_search_object,
+                                            const iscc_TypedNNQuery* typed_query,
+                                            size_t len_query_indices,
+                                            const scc_PointIndex query_indices[],
+                                            bool radius_search,
+                                            double radius,
+                                            size_t* out_num_ok_queries,
+                                            scc_PointIndex out_query_indices[],
+                                            scc_PointIndex out_nn_indices[]);
+
+
+// True if search objects with `len_search_indices` points are backed by a search tree
+bool iscc_imp_nn_search_uses_tree(void* data_set,
+                                  size_t len_search_indices);
+
+
 bool iscc_imp_close_nn_search_object(iscc_NNSearchObject** nn_search_object);
 
 
@@ -29,10 +29,26 @@
 // Static variables
 // =============================================================================
 
-static scc_ErrorCode iscc_error_code = SCC_ER_OK;
-static const char* iscc_error_msg = NULL;
-static const char* iscc_error_file = "unknown file";
-static int iscc_error_line = -1;
+// The error state is kept per thread, so that concurrent clustering
+// calls report their own errors. Compilers without a known thread-local
+// storage class must define `ISCC_THREAD_LOCAL` (defining it as empty
+// gives a shared error state, which is only safe without threads).
+#ifndef ISCC_THREAD_LOCAL
+	#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+		#define ISCC_THREAD_LOCAL _Thread_local
+	#elif defined(__GNUC__) || defined(__clang__)
+		#define ISCC_THREAD_LOCAL __thread
+	#elif defined(_MSC_VER)
+		#define ISCC_THREAD_LOCAL __declspec(thread)
+	#else
+		#error "No thread-local storage class known for this compiler. Define ISCC_THREAD_LOCAL."
+	#endif
+#endif
+
+static ISCC_THREAD_LOCAL scc_ErrorCode iscc_error_code = SCC_ER_OK;
+static ISCC_THREAD_LOCAL const char* iscc_error_msg = NULL;
+static ISCC_THREAD_LOCAL const char* iscc_error_file = "unknown file";
+static ISCC_THREAD_LOCAL int iscc_error_line = -1;
 
 
 // =============================================================================
@@ -64,6 +80,28 @@ void iscc_reset_error(void)
 }
 
 
+iscc_ErrorState iscc_get_error_state(void)
+{
+	return (iscc_ErrorState) {
+		.ec = iscc_error_code,
+		.msg = iscc_error_msg,
+		.file = iscc_error_file,
+		.line = iscc_error_line,
+	};
+}
+
+
+scc_ErrorCode iscc_restore_error_state(const iscc_ErrorState state)
+{
+	iscc_error_code = state.ec;
+	iscc_error_msg = state.msg;
+	iscc_error_file = state.file;
+	iscc_error_line = state.line;
+
+	return state.ec;
+}
+
+
 bool scc_get_latest_error(const size_t len_error_message_buffer,
                           char error_message_buffer[const])
 {
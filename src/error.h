@@ -35,6 +35,20 @@
 #define iscc_no_error() (SCC_ER_OK)
 
 
+// =============================================================================
+// Structs
+// =============================================================================
+
+// A copy of a thread's error state, used to move errors made in worker threads
+// to the calling thread.
+typedef struct iscc_ErrorState {
+	scc_ErrorCode ec;
+	const char* msg;
+	const char* file;
+	int line;
+} iscc_ErrorState;
+
+
 // =============================================================================
 // Function prototypes
 // =============================================================================
@@ -48,4 +62,10 @@ scc_ErrorCode iscc_make_error__(scc_ErrorCode ec,
 void iscc_reset_error(void);
 
 
+iscc_ErrorState iscc_get_error_state(void);
+
+
+scc_ErrorCode iscc_restore_error_state(iscc_ErrorState state);
+
+
 #endif // ifndef SCC_ERROR_HG
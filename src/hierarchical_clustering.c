@@ -21,36 +21,55 @@
 #include "../include/scclust.h"
 
 #include <assert.h>
+#include <limits.h>
 #include <math.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include "dist_search.h"
+#include "cluster_tree_struct.h"
 #include "clustering_struct.h"
 #include "error.h"
 #include "scclust_types.h"
 
+#ifdef _OPENMP
+	#include <omp.h>
+#endif // ifdef _OPENMP
+
 // Maximum number of data points to check when finding centers.
 static const uint_fast16_t ISCC_HI_NUM_TO_CHECK = 100;
 
+// Smallest cluster that is split in a task of its own when splitting in parallel.
+// Smaller clusters are split by the task that made them.
+static const size_t ISCC_HI_MIN_TASK_SIZE = 4096;
+
+// Edge lists shorter than this are sorted by insertion rather than by radix.
+static const size_t ISCC_HI_RADIX_SORT_MIN = 64;
+
 
 // =============================================================================
 // Internal structs
 // =============================================================================
 
-typedef struct iscc_hi_DistanceEdge iscc_hi_DistanceEdge;
-struct iscc_hi_DistanceEdge {
-	scc_PointIndex head;
-	double distance;
-	iscc_hi_DistanceEdge* next_dist;
-};
+// The points of a cluster, except a center, in order of distance to the center. The points
+// before `first` have been assigned. Assigned points at or after `first` are skipped, and
+// removed when they are passed over while looking for several points.
+typedef struct iscc_hi_EdgeList {
+	size_t first;
+	size_t len;
+	scc_PointIndex* heads;
+	double* dists;
+} iscc_hi_EdgeList;
 
 
+// `node` is the cluster's node in the tree when the splits are recorded.
 typedef struct iscc_hi_ClusterItem {
 	size_t size;
-	uint_fast16_t marker;
+	uint16_t marker;
 	scc_PointIndex* members;
+	size_t node;
 } iscc_hi_ClusterItem;
 
 
@@ -62,20 +81,55 @@ typedef struct iscc_hi_ClusterStack {
 } iscc_hi_ClusterStack;
 
 
+// `capacity` is the largest cluster that `dist_array`, the edge lists and the sort scratch
+// can hold. It is only used by `iscc_hi_reserve_work_area`. `vertex_markers` has one entry per data point,
+// so the markers are kept to 16 bits (see `iscc_hi_get_next_marker`).
 typedef struct iscc_hi_WorkArea {
-	scc_PointIndex* const pointindex_array1;
-	scc_PointIndex* const pointindex_array2;
-	double* const dist_array;
-	uint_fast16_t* const vertex_markers;
-	iscc_hi_DistanceEdge* const edge_store1;
-	iscc_hi_DistanceEdge* const edge_store2;
+	scc_PointIndex* pointindex_array1;
+	scc_PointIndex* pointindex_array2;
+	double* dist_array;
+	uint16_t* vertex_markers;
+	iscc_hi_EdgeList edge_list1;
+	iscc_hi_EdgeList edge_list2;
+	scc_PointIndex* heads_scratch;
+	double* dists_scratch;
+	size_t capacity;
 } iscc_hi_WorkArea;
 
 
+// Shared by the tasks of a parallel run. Each thread has its own work area, but
+// `vertex_markers` is shared as the clusters being split are disjoint.
+typedef struct iscc_hi_TaskState {
+	void* data_set;
+	uint32_t size_constraint;
+	bool batch_assign;
+	iscc_hi_WorkArea* work_areas;
+	size_t num_leaves;
+	iscc_hi_ClusterItem* leaves;
+	const scc_PointIndex* pointindex_store;
+	scc_ClusterTree* tree;
+	scc_ErrorCode ec;
+	iscc_ErrorState error;
+} iscc_hi_TaskState;
+
+
 // =============================================================================
 // Static function prototypes
 // =============================================================================
 
+static scc_ErrorCode iscc_hi_hierarchical_clustering(void* data_set,
+                                                     uint32_t size_constraint,
+                                                     bool batch_assign,
+                                                     scc_Clustering* out_clustering,
+                                                     scc_ClusterTree** out_tree);
+
+
+static scc_ErrorCode iscc_hi_finish_run(scc_ErrorCode ec,
+                                        iscc_hi_ClusterStack* cl_stack,
+                                        scc_ClusterTree* tree,
+                                        scc_ClusterTree** out_tree);
+
+
 static scc_ErrorCode iscc_hi_empty_cl_stack(size_t num_data_points,
                                             iscc_hi_ClusterStack* out_cl_stack);
 
@@ -85,12 +139,50 @@ static scc_ErrorCode iscc_hi_init_cl_stack(const scc_Clustering* in_cl,
                                            size_t* out_size_largest_cluster);
 
 
+static scc_ErrorCode iscc_hi_init_cluster_tree(iscc_hi_ClusterStack* cl_stack,
+                                               size_t num_data_points,
+                                               uint32_t size_constraint,
+                                               scc_ClusterTree** out_tree);
+
+
 static scc_ErrorCode iscc_hi_run_hierarchical_clustering(iscc_hi_ClusterStack* cl_stack,
                                                          scc_Clustering* cl,
                                                          void* data_set,
                                                          iscc_hi_WorkArea* work_area,
                                                          uint32_t size_constraint,
-                                                         bool batch_assign);
+                                                         bool batch_assign,
+                                                         scc_ClusterTree* tree);
+
+
+static scc_ErrorCode iscc_hi_run_parallel_hierarchical_clustering(iscc_hi_ClusterStack* cl_stack,
+                                                                  scc_Clustering* cl,
+                                                                  void* data_set,
+                                                                  uint32_t size_constraint,
+                                                                  bool batch_assign,
+                                                                  size_t use_threads,
+                                                                  scc_ClusterTree* tree);
+
+
+static void iscc_hi_split_in_tasks(iscc_hi_ClusterItem cluster,
+                                   iscc_hi_TaskState* task_state);
+
+
+static scc_ErrorCode iscc_hi_reserve_work_area(iscc_hi_WorkArea* work_area,
+                                               size_t cluster_size);
+
+
+static int iscc_hi_compare_leaf_members(const void* a,
+                                        const void* b);
+
+
+static inline void iscc_hi_record_split(scc_ClusterTree* tree,
+                                        const scc_PointIndex* pointindex_store,
+                                        size_t first_child,
+                                        iscc_hi_ClusterItem* cluster1,
+                                        iscc_hi_ClusterItem* cluster2);
+
+
+static scc_ErrorCode iscc_hi_order_tree_nodes(scc_ClusterTree* tree);
 
 
 static scc_ErrorCode iscc_hi_push_to_stack(iscc_hi_ClusterStack* cl_stack,
@@ -105,46 +197,46 @@ static scc_ErrorCode iscc_hi_break_cluster_into_two(iscc_hi_ClusterItem* cluster
                                                     iscc_hi_ClusterItem* out_new_cluster);
 
 
-static inline uint_fast16_t iscc_hi_get_next_marker(iscc_hi_ClusterItem* cl,
-                                                    uint_fast16_t vertex_markers[]);
+static inline uint16_t iscc_hi_get_next_marker(iscc_hi_ClusterItem* cl,
+                                               uint16_t vertex_markers[]);
 
 
-static inline iscc_hi_DistanceEdge* iscc_hi_get_next_k_nn(iscc_hi_DistanceEdge* prev_dist,
-                                                          uint32_t k,
-                                                          const uint_fast16_t vertex_markers[],
-                                                          uint_fast16_t curr_marker,
-                                                          scc_PointIndex out_dist_array[static k]);
+static inline size_t iscc_hi_get_next_k_nn(iscc_hi_EdgeList* edge_list,
+                                           uint32_t k,
+                                           const uint16_t vertex_markers[],
+                                           uint16_t curr_marker,
+                                           scc_PointIndex out_dist_array[static k]);
 
 
-static inline iscc_hi_DistanceEdge* iscc_hi_get_next_dist(iscc_hi_DistanceEdge* prev_dist,
-                                                          const uint_fast16_t vertex_markers[],
-                                                          uint_fast16_t curr_marker);
+static inline size_t iscc_hi_get_next_dist(iscc_hi_EdgeList* edge_list,
+                                           const uint16_t vertex_markers[],
+                                           uint16_t curr_marker);
 
 
 static inline void iscc_hi_move_point_to_cluster1(scc_PointIndex id,
                                                   iscc_hi_ClusterItem* cl,
-                                                  uint_fast16_t vertex_markers[],
-                                                  uint_fast16_t curr_marker);
+                                                  uint16_t vertex_markers[],
+                                                  uint16_t curr_marker);
 
 
 static inline void iscc_hi_move_point_to_cluster2(scc_PointIndex id,
                                                   iscc_hi_ClusterItem* cl,
-                                                  uint_fast16_t vertex_markers[],
-                                                  uint_fast16_t curr_marker);
+                                                  uint16_t vertex_markers[],
+                                                  uint16_t curr_marker);
 
 
 static inline void iscc_hi_move_array_to_cluster1(uint32_t len_ids,
                                                   const scc_PointIndex ids[static len_ids],
                                                   iscc_hi_ClusterItem* cl,
-                                                  uint_fast16_t vertex_markers[],
-                                                  uint_fast16_t curr_marker);
+                                                  uint16_t vertex_markers[],
+                                                  uint16_t curr_marker);
 
 
 static inline void iscc_hi_move_array_to_cluster2(uint32_t len_ids,
                                                   const scc_PointIndex ids[static len_ids],
                                                   iscc_hi_ClusterItem* cl,
-                                                  uint_fast16_t vertex_markers[],
-                                                  uint_fast16_t curr_marker);
+                                                  uint16_t vertex_markers[],
+                                                  uint16_t curr_marker);
 
 
 static scc_ErrorCode iscc_hi_find_centers(iscc_hi_ClusterItem* cl,
@@ -164,11 +256,19 @@ static scc_ErrorCode iscc_hi_populate_edge_lists(const iscc_hi_ClusterItem* cl,
 static inline void iscc_hi_sort_edge_list(const iscc_hi_ClusterItem* cl,
                                           scc_PointIndex center,
                                           const double row_dists[static cl->size],
-                                          iscc_hi_DistanceEdge edge_store[static cl->size]);
+                                          iscc_hi_EdgeList* edge_list,
+                                          scc_PointIndex heads_scratch[],
+                                          double dists_scratch[]);
+
+
+static inline uint64_t iscc_hi_dist_key(double distance);
 
 
-static int iscc_hi_compare_dist_edges(const void* a,
-                                      const void* b);
+static void iscc_hi_radix_sort_edges(size_t len_edges,
+                                     scc_PointIndex heads[static len_edges],
+                                     double dists[static len_edges],
+                                     scc_PointIndex heads_scratch[static len_edges],
+                                     double dists_scratch[static len_edges]);
 
 
 // =============================================================================
@@ -179,6 +279,156 @@ scc_ErrorCode scc_hierarchical_clustering(void* const data_set,
                                           const uint32_t size_constraint,
                                           const bool batch_assign,
                                           scc_Clustering* const out_clustering)
+{
+	return iscc_hi_hierarchical_clustering(data_set,
+	                                       size_constraint,
+	                                       batch_assign,
+	                                       out_clustering,
+	                                       NULL);
+}
+
+
+scc_ErrorCode scc_hierarchical_clustering_tree(void* const data_set,
+                                               const uint32_t size_constraint,
+                                               const bool batch_assign,
+                                               scc_Clustering* const out_clustering,
+                                               scc_ClusterTree** const out_tree)
+{
+	if (out_tree == NULL) {
+		return iscc_make_error_msg(SCC_ER_INVALID_INPUT, "Output parameter may not be NULL.");
+	}
+	// Initialize to null, so subsequent functions detect invalid tree
+	// if user doesn't check for errors.
+	*out_tree = NULL;
+
+	return iscc_hi_hierarchical_clustering(data_set,
+	                                       size_constraint,
+	                                       batch_assign,
+	                                       out_clustering,
+	                                       out_tree);
+}
+
+
+scc_ErrorCode scc_cut_cluster_tree(const scc_ClusterTree* const tree,
+                                   const uint32_t size_constraint,
+                                   scc_Clustering* const out_clustering)
+{
+	if (!iscc_check_cluster_tree(tree)) {
+		return iscc_make_error_msg(SCC_ER_INVALID_INPUT, "Invalid cluster tree object.");
+	}
+	if (!iscc_check_input_clustering(out_clustering)) {
+		return iscc_make_error_msg(SCC_ER_INVALID_INPUT, "Invalid clustering object.");
+	}
+	if (tree->num_data_points != out_clustering->num_data_points) {
+		return iscc_make_error_msg(SCC_ER_INVALID_INPUT, "Number of data points in cluster tree does not match clustering object.");
+	}
+	if (size_constraint < 2) {
+		return iscc_make_error_msg(SCC_ER_INVALID_INPUT, "Size constraint must be 2 or greater.");
+	}
+	if (out_clustering->num_data_points < size_constraint) {
+		return iscc_make_error_msg(SCC_ER_NO_SOLUTION, "Fewer data points than size constraint.");
+	}
+	// Roots are never merged, so no cut satisfies the constraint if a root is too small
+	for (size_t r = 0; r < tree->num_roots; ++r) {
+		if ((tree->node_size[r] > 0) && (tree->node_size[r] < size_constraint)) {
+			return iscc_make_error_msg(SCC_ER_INVALID_INPUT, "Cluster tree has roots smaller than size constraint.");
+		}
+	}
+
+	// The stack never holds more than one node per root and split
+	size_t* const node_stack = malloc(sizeof(size_t[tree->num_nodes]));
+	if (node_stack == NULL) return iscc_make_error(SCC_ER_NO_MEMORY);
+
+	if (out_clustering->cluster_label == NULL) {
+		out_clustering->external_labels = false;
+		out_clustering->cluster_label = malloc(sizeof(scc_Clabel[out_clustering->num_data_points]));
+		if (out_clustering->cluster_label == NULL) {
+			free(node_stack);
+			return iscc_make_error(SCC_ER_NO_MEMORY);
+		}
+	}
+
+	size_t num_in_tree = 0;
+	for (size_t r = 0; r < tree->num_roots; ++r) {
+		num_in_tree += tree->node_size[r];
+		node_stack[r] = r;
+	}
+	if (num_in_tree < out_clustering->num_data_points) {
+		for (size_t i = 0; i < out_clustering->num_data_points; ++i) {
+			out_clustering->cluster_label[i] = SCC_CLABEL_NA;
+		}
+	}
+
+	// Nodes are visited in the order the splits were made, so the
+	// labels are the same as when the tree was built
+	scc_Clabel current_label = 0;
+	size_t stack_items = tree->num_roots;
+	while (stack_items > 0) {
+		const size_t node = node_stack[--stack_items];
+		const size_t child = tree->node_child[node];
+		if ((child != 0) &&
+		        (tree->node_size[child] >= size_constraint) &&
+		        (tree->node_size[child + 1] >= size_constraint)) {
+			node_stack[stack_items++] = child;
+			node_stack[stack_items++] = child + 1;
+		} else if (tree->node_size[node] > 0) {
+			if (current_label == SCC_CLABEL_MAX) {
+				free(node_stack);
+				return iscc_make_error_msg(SCC_ER_TOO_LARGE_PROBLEM, "Too many clusters (adjust the `scc_Clabel` type).");
+			}
+			const scc_PointIndex* const members = tree->pointindex_store + tree->node_first[node];
+			for (size_t v = 0; v < tree->node_size[node]; ++v) {
+				out_clustering->cluster_label[members[v]] = current_label;
+			}
+			++current_label;
+		}
+	}
+
+	out_clustering->num_clusters = (size_t) current_label;
+
+	free(node_stack);
+
+	return iscc_no_error();
+}
+
+
+void scc_free_cluster_tree(scc_ClusterTree** const tree)
+{
+	if ((tree != NULL) && (*tree != NULL)) {
+		free((*tree)->node_first);
+		free((*tree)->node_size);
+		free((*tree)->node_child);
+		free((*tree)->pointindex_store);
+		free(*tree);
+		*tree = NULL;
+	}
+}
+
+
+bool scc_is_initialized_cluster_tree(const scc_ClusterTree* const tree)
+{
+	if (tree == NULL) return false;
+	if (tree->cluster_tree_version != ISCC_CLUSTER_TREE_STRUCT_VERSION) return false;
+	if (tree->num_data_points == 0) return false;
+	if (tree->num_data_points > ISCC_POINTINDEX_MAX) return false;
+	if (tree->size_constraint < 2) return false;
+	if ((tree->num_roots == 0) || (tree->num_nodes < tree->num_roots)) return false;
+	if ((tree->node_first == NULL) || (tree->node_size == NULL) || (tree->node_child == NULL)) return false;
+	if (tree->pointindex_store == NULL) return false;
+
+	return true;
+}
+
+
+// =============================================================================
+// Static function implementations
+// =============================================================================
+
+static scc_ErrorCode iscc_hi_hierarchical_clustering(void* const data_set,
+                                                     const uint32_t size_constraint,
+                                                     const bool batch_assign,
+                                                     scc_Clustering* const out_clustering,
+                                                     scc_ClusterTree** const out_tree)
 {
 	if (!iscc_check_input_clustering(out_clustering)) {
 		return iscc_make_error_msg(SCC_ER_INVALID_INPUT, "Invalid clustering object.");
@@ -220,20 +470,63 @@ scc_ErrorCode scc_hierarchical_clustering(void* const data_set,
 	assert(cl_stack.clusters != NULL);
 	assert(cl_stack.pointindex_store != NULL);
 
+	scc_ClusterTree* tree = NULL;
+	if (out_tree != NULL) {
+		if ((ec = iscc_hi_init_cluster_tree(&cl_stack,
+		                                    out_clustering->num_data_points,
+		                                    size_constraint,
+		                                    &tree)) != SCC_ER_OK) {
+			free(cl_stack.clusters);
+			free(cl_stack.pointindex_store);
+			return ec;
+		}
+	}
+
+	// Clusters are split in parallel when the distance functions are reentrant
+	size_t use_threads = 1;
+	#ifdef _OPENMP
+		use_threads = (size_t) omp_get_max_threads();
+		if (!iscc_dist_functions_are_reentrant(data_set)) use_threads = 1;
+	#endif // ifdef _OPENMP
+	if (out_clustering->num_data_points < 2 * ISCC_HI_MIN_TASK_SIZE) use_threads = 1;
+
+	if (use_threads > 1) {
+		ec = iscc_hi_run_parallel_hierarchical_clustering(&cl_stack,
+		                                                  out_clustering,
+		                                                  data_set,
+		                                                  size_constraint,
+		                                                  batch_assign,
+		                                                  use_threads,
+		                                                  tree);
+		if ((ec == SCC_ER_OK) && (tree != NULL)) ec = iscc_hi_order_tree_nodes(tree);
+		return iscc_hi_finish_run(ec, &cl_stack, tree, out_tree);
+	}
+
 	const size_t size_pointindex_array = (size_constraint > ISCC_HI_NUM_TO_CHECK) ? size_constraint : ISCC_HI_NUM_TO_CHECK;
 	const size_t size_dist_array = ((2 * size_largest_cluster) > ISCC_HI_NUM_TO_CHECK) ? (2 * size_largest_cluster) : ISCC_HI_NUM_TO_CHECK;
 	iscc_hi_WorkArea work_area = {
 		.pointindex_array1 = malloc(sizeof(scc_PointIndex[size_pointindex_array])),
 		.pointindex_array2 = malloc(sizeof(scc_PointIndex[size_pointindex_array])),
 		.dist_array = malloc(sizeof(double[size_dist_array])),
-		.vertex_markers = calloc(out_clustering->num_data_points, sizeof(uint_fast16_t)),
-		.edge_store1 = malloc(sizeof(iscc_hi_DistanceEdge[size_largest_cluster])),
-		.edge_store2 = malloc(sizeof(iscc_hi_DistanceEdge[size_largest_cluster])),
+		.vertex_markers = calloc(out_clustering->num_data_points, sizeof(uint16_t)),
+		.edge_list1 = {
+			.heads = malloc(sizeof(scc_PointIndex[size_largest_cluster])),
+			.dists = malloc(sizeof(double[size_largest_cluster])),
+		},
+		.edge_list2 = {
+			.heads = malloc(sizeof(scc_PointIndex[size_largest_cluster])),
+			.dists = malloc(sizeof(double[size_largest_cluster])),
+		},
+		.heads_scratch = malloc(sizeof(scc_PointIndex[size_largest_cluster])),
+		.dists_scratch = malloc(sizeof(double[size_largest_cluster])),
+		.capacity = size_largest_cluster,
 	};
 
 	if ((work_area.pointindex_array1 == NULL) || (work_area.pointindex_array2 == NULL) ||
 	        (work_area.dist_array == NULL) || (work_area.vertex_markers == NULL) ||
-	        (work_area.edge_store1 == NULL) || (work_area.edge_store2 == NULL)) {
+	        (work_area.edge_list1.heads == NULL) || (work_area.edge_list1.dists == NULL) ||
+	        (work_area.edge_list2.heads == NULL) || (work_area.edge_list2.dists == NULL) ||
+	        (work_area.heads_scratch == NULL) || (work_area.dists_scratch == NULL)) {
 		ec = iscc_make_error(SCC_ER_NO_MEMORY);
 	}
 
@@ -243,26 +536,57 @@ scc_ErrorCode scc_hierarchical_clustering(void* const data_set,
 		                                         data_set,
 		                                         &work_area,
 		                                         size_constraint,
-		                                         batch_assign);
+		                                         batch_assign,
+		                                         tree);
 	}
 
 	free(work_area.pointindex_array1);
 	free(work_area.pointindex_array2);
 	free(work_area.dist_array);
 	free(work_area.vertex_markers);
-	free(work_area.edge_store1);
-	free(work_area.edge_store2);
-	free(cl_stack.clusters);
-	free(cl_stack.pointindex_store);
+	free(work_area.edge_list1.heads);
+	free(work_area.edge_list1.dists);
+	free(work_area.edge_list2.heads);
+	free(work_area.edge_list2.dists);
+	free(work_area.heads_scratch);
+	free(work_area.dists_scratch);
+
+	return iscc_hi_finish_run(ec, &cl_stack, tree, out_tree);
+}
+
+
+// Hands the tree, which takes over `pointindex_store`, to the caller if the run succeeded
+static scc_ErrorCode iscc_hi_finish_run(const scc_ErrorCode ec,
+                                        iscc_hi_ClusterStack* const cl_stack,
+                                        scc_ClusterTree* tree,
+                                        scc_ClusterTree** const out_tree)
+{
+	assert(cl_stack != NULL);
+	assert((tree == NULL) || (out_tree != NULL));
+
+	if ((ec == SCC_ER_OK) && (tree != NULL)) {
+		tree->pointindex_store = cl_stack->pointindex_store;
+		cl_stack->pointindex_store = NULL;
+
+		// The node arrays were allocated for as many splits as possible
+		size_t* tmp_ptr;
+		if ((tmp_ptr = realloc(tree->node_first, sizeof(size_t[tree->num_nodes]))) != NULL) tree->node_first = tmp_ptr;
+		if ((tmp_ptr = realloc(tree->node_size, sizeof(size_t[tree->num_nodes]))) != NULL) tree->node_size = tmp_ptr;
+		if ((tmp_ptr = realloc(tree->node_child, sizeof(size_t[tree->num_nodes]))) != NULL) tree->node_child = tmp_ptr;
+
+		assert(iscc_check_cluster_tree(tree));
+		*out_tree = tree;
+	} else {
+		scc_free_cluster_tree(&tree);
+	}
+
+	free(cl_stack->clusters);
+	free(cl_stack->pointindex_store);
 
 	return ec;
 }
 
 
-// =============================================================================
-// Static function implementations
-// =============================================================================
-
 static scc_ErrorCode iscc_hi_empty_cl_stack(const size_t num_data_points,
                                             iscc_hi_ClusterStack* const out_cl_stack)
 {
@@ -332,7 +656,7 @@ static scc_ErrorCode iscc_hi_init_cl_stack(const scc_Clustering* const in_cl,
 		}
 	}
 
-	size_t size_largest_cluster = 0;
+	size_t size_largest_cluster = clusters[0].size;
 	clusters[0].members = out_cl_stack->pointindex_store + clusters[0].size;
 	for (size_t c = 1; c < in_cl->num_clusters; ++c) {
 		clusters[c].members = clusters[c - 1].members + clusters[c].size;
@@ -353,12 +677,66 @@ static scc_ErrorCode iscc_hi_init_cl_stack(const scc_Clustering* const in_cl,
 }
 
 
+// The clusters on the stack become the roots of the tree
+static scc_ErrorCode iscc_hi_init_cluster_tree(iscc_hi_ClusterStack* const cl_stack,
+                                               const size_t num_data_points,
+                                               const uint32_t size_constraint,
+                                               scc_ClusterTree** const out_tree)
+{
+	assert(cl_stack != NULL);
+	assert(cl_stack->items > 0);
+	assert(cl_stack->clusters != NULL);
+	assert(cl_stack->pointindex_store != NULL);
+	assert(num_data_points >= 2);
+	assert(size_constraint >= 2);
+	assert(out_tree != NULL);
+
+	// Each split adds two nodes, and there are at most `num_data_points / size_constraint`
+	// splits as every split makes a leaf with at least `size_constraint` points
+	const uintmax_t max_nodes = ((uintmax_t) cl_stack->items) + 2 * ((uintmax_t) (num_data_points / size_constraint));
+	if (max_nodes > SIZE_MAX / sizeof(size_t)) {
+		return iscc_make_error_msg(SCC_ER_TOO_LARGE_PROBLEM, "Too many data points.");
+	}
+
+	scc_ClusterTree* tmp_tree = malloc(sizeof(scc_ClusterTree));
+	if (tmp_tree == NULL) return iscc_make_error(SCC_ER_NO_MEMORY);
+
+	*tmp_tree = (scc_ClusterTree) {
+		.cluster_tree_version = ISCC_CLUSTER_TREE_STRUCT_VERSION,
+		.num_data_points = num_data_points,
+		.size_constraint = size_constraint,
+		.num_roots = cl_stack->items,
+		.num_nodes = cl_stack->items,
+		.node_first = malloc(sizeof(size_t[(size_t) max_nodes])),
+		.node_size = malloc(sizeof(size_t[(size_t) max_nodes])),
+		.node_child = malloc(sizeof(size_t[(size_t) max_nodes])),
+		.pointindex_store = NULL,
+	};
+	if ((tmp_tree->node_first == NULL) || (tmp_tree->node_size == NULL) || (tmp_tree->node_child == NULL)) {
+		scc_free_cluster_tree(&tmp_tree);
+		return iscc_make_error(SCC_ER_NO_MEMORY);
+	}
+
+	for (size_t c = 0; c < cl_stack->items; ++c) {
+		tmp_tree->node_first[c] = (size_t) (cl_stack->clusters[c].members - cl_stack->pointindex_store);
+		tmp_tree->node_size[c] = cl_stack->clusters[c].size;
+		tmp_tree->node_child[c] = 0;
+		cl_stack->clusters[c].node = c;
+	}
+
+	*out_tree = tmp_tree;
+
+	return iscc_no_error();
+}
+
+
 static scc_ErrorCode iscc_hi_run_hierarchical_clustering(iscc_hi_ClusterStack* const cl_stack,
                                                          scc_Clustering* const cl,
                                                          void* const data_set,
                                                          iscc_hi_WorkArea* const work_area,
                                                          const uint32_t size_constraint,
-                                                         const bool batch_assign)
+                                                         const bool batch_assign,
+                                                         scc_ClusterTree* const tree)
 {
 	assert(cl_stack != NULL);
 	assert(cl_stack->items > 0);
@@ -392,6 +770,8 @@ static scc_ErrorCode iscc_hi_run_hierarchical_clustering(iscc_hi_ClusterStack* c
 			if ((ec = iscc_hi_push_to_stack(cl_stack, &new_cluster)) != SCC_ER_OK) {
 				return ec;
 			}
+			// The push might have moved the stack
+			current_cluster = new_cluster - 1;
 			if ((ec = iscc_hi_break_cluster_into_two(current_cluster,
 			                                         data_set,
 			                                         work_area,
@@ -400,6 +780,10 @@ static scc_ErrorCode iscc_hi_run_hierarchical_clustering(iscc_hi_ClusterStack* c
 			                                         new_cluster)) != SCC_ER_OK) {
 				return ec;
 			}
+			if (tree != NULL) {
+				tree->num_nodes += 2;
+				iscc_hi_record_split(tree, cl_stack->pointindex_store, tree->num_nodes - 2, current_cluster, new_cluster);
+			}
 		}
 	}
 
@@ -411,6 +795,342 @@ static scc_ErrorCode iscc_hi_run_hierarchical_clustering(iscc_hi_ClusterStack* c
 }
 
 
+/* Clusters are split in OpenMP tasks, and the threads take over each other's tasks when they
+ * run out of work. A cluster is split by one thread, which hands one of the two new clusters to
+ * a new task and goes on to split the other. Clusters that cannot be split are collected as
+ * leaves. Splits do not depend on the thread or the order, and the serial run labels the leaves
+ * in decreasing order of their position in `pointindex_store`, so the leaves are sorted by
+ * position before labeling to give the same clustering as `iscc_hi_run_hierarchical_clustering`.
+ */
+static scc_ErrorCode iscc_hi_run_parallel_hierarchical_clustering(iscc_hi_ClusterStack* const cl_stack,
+                                                                  scc_Clustering* const cl,
+                                                                  void* const data_set,
+                                                                  const uint32_t size_constraint,
+                                                                  const bool batch_assign,
+                                                                  const size_t use_threads,
+                                                                  scc_ClusterTree* const tree)
+{
+	assert(cl_stack != NULL);
+	assert(cl_stack->items > 0);
+	assert(cl_stack->items <= cl_stack->capacity);
+	assert(cl_stack->clusters != NULL);
+	assert(cl_stack->pointindex_store != NULL);
+	assert(iscc_check_input_clustering(cl));
+	assert(iscc_check_data_set(data_set));
+	assert(iscc_num_data_points(data_set) == cl->num_data_points);
+	assert(size_constraint >= 2);
+	assert(use_threads > 0);
+	assert(use_threads <= INT_MAX);
+
+	// All leaves made by splits have at least `size_constraint` points
+	const size_t max_leaves = cl_stack->items + cl->num_data_points / size_constraint;
+	const size_t size_pointindex_array = (size_constraint > ISCC_HI_NUM_TO_CHECK) ? size_constraint : ISCC_HI_NUM_TO_CHECK;
+
+	iscc_hi_TaskState task_state = {
+		.data_set = data_set,
+		.size_constraint = size_constraint,
+		.batch_assign = batch_assign,
+		.work_areas = calloc(use_threads, sizeof(iscc_hi_WorkArea)),
+		.num_leaves = 0,
+		.leaves = malloc(sizeof(iscc_hi_ClusterItem[max_leaves])),
+		.pointindex_store = cl_stack->pointindex_store,
+		.tree = tree,
+		.ec = SCC_ER_OK,
+		.error = { .ec = SCC_ER_OK },
+	};
+	uint16_t* const vertex_markers = calloc(cl->num_data_points, sizeof(uint16_t));
+
+	scc_ErrorCode ec = SCC_ER_OK;
+	if ((task_state.work_areas == NULL) || (task_state.leaves == NULL) || (vertex_markers == NULL)) {
+		ec = iscc_make_error(SCC_ER_NO_MEMORY);
+	} else {
+		for (size_t t = 0; t < use_threads; ++t) {
+			task_state.work_areas[t].pointindex_array1 = malloc(sizeof(scc_PointIndex[size_pointindex_array]));
+			task_state.work_areas[t].pointindex_array2 = malloc(sizeof(scc_PointIndex[size_pointindex_array]));
+			task_state.work_areas[t].vertex_markers = vertex_markers;
+			if ((task_state.work_areas[t].pointindex_array1 == NULL) ||
+			        (task_state.work_areas[t].pointindex_array2 == NULL)) {
+				ec = iscc_make_error(SCC_ER_NO_MEMORY);
+			}
+		}
+	}
+
+	if (ec == SCC_ER_OK) {
+		iscc_hi_TaskState* const task_state_ptr = &task_state;
+		#ifdef _OPENMP
+			#pragma omp parallel num_threads((int) use_threads)
+			#pragma omp single
+		#endif // ifdef _OPENMP
+		{
+			for (size_t c = 0; c < cl_stack->items; ++c) {
+				const iscc_hi_ClusterItem cluster = cl_stack->clusters[c];
+				#ifdef _OPENMP
+					#pragma omp task if(cluster.size >= 2 * size_constraint)
+				#endif // ifdef _OPENMP
+				iscc_hi_split_in_tasks(cluster, task_state_ptr);
+			}
+		}
+		cl_stack->items = 0;
+		ec = task_state.ec;
+		if (ec != SCC_ER_OK) {
+			// The error was made in the thread that ran the failing task
+			ec = iscc_restore_error_state(task_state.error);
+		}
+	}
+
+	if (ec == SCC_ER_OK) {
+		assert(task_state.num_leaves <= max_leaves);
+		qsort(task_state.leaves, task_state.num_leaves, sizeof(iscc_hi_ClusterItem), iscc_hi_compare_leaf_members);
+
+		scc_Clabel current_label = 0;
+		for (size_t l = 0; (l < task_state.num_leaves) && (ec == SCC_ER_OK); ++l) {
+			if (current_label == SCC_CLABEL_MAX) {
+				ec = iscc_make_error_msg(SCC_ER_TOO_LARGE_PROBLEM, "Too many clusters (adjust the `scc_Clabel` type).");
+				break;
+			}
+			const iscc_hi_ClusterItem* const leaf = &task_state.leaves[l];
+			for (size_t v = 0; v < leaf->size; ++v) {
+				cl->cluster_label[leaf->members[v]] = current_label;
+			}
+			++current_label;
+		}
+		if (ec == SCC_ER_OK) cl->num_clusters = (size_t) current_label;
+	}
+
+	if (task_state.work_areas != NULL) {
+		for (size_t t = 0; t < use_threads; ++t) {
+			free(task_state.work_areas[t].pointindex_array1);
+			free(task_state.work_areas[t].pointindex_array2);
+			free(task_state.work_areas[t].dist_array);
+			free(task_state.work_areas[t].edge_list1.heads);
+			free(task_state.work_areas[t].edge_list1.dists);
+			free(task_state.work_areas[t].edge_list2.heads);
+			free(task_state.work_areas[t].edge_list2.dists);
+			free(task_state.work_areas[t].heads_scratch);
+			free(task_state.work_areas[t].dists_scratch);
+		}
+	}
+	free(task_state.work_areas);
+	free(task_state.leaves);
+	free(vertex_markers);
+
+	return ec;
+}
+
+
+static void iscc_hi_split_in_tasks(iscc_hi_ClusterItem cluster,
+                                   iscc_hi_TaskState* const task_state)
+{
+	assert(task_state != NULL);
+
+	const uint32_t size_constraint = task_state->size_constraint;
+	while (cluster.size >= 2 * size_constraint) {
+		scc_ErrorCode ec;
+		#ifdef _OPENMP
+			#pragma omp atomic read
+		#endif // ifdef _OPENMP
+		ec = task_state->ec;
+		if (ec != SCC_ER_OK) return;
+
+		size_t thread = 0;
+		#ifdef _OPENMP
+			thread = (size_t) omp_get_thread_num();
+		#endif // ifdef _OPENMP
+		iscc_hi_WorkArea* const work_area = &task_state->work_areas[thread];
+
+		iscc_hi_ClusterItem new_cluster;
+		if (((ec = iscc_hi_reserve_work_area(work_area, cluster.size)) != SCC_ER_OK) ||
+		        ((ec = iscc_hi_break_cluster_into_two(&cluster,
+		                                              task_state->data_set,
+		                                              work_area,
+		                                              size_constraint,
+		                                              task_state->batch_assign,
+		                                              &new_cluster)) != SCC_ER_OK)) {
+			// Only the first error is kept, together with the failing thread's error state
+			#ifdef _OPENMP
+				#pragma omp critical(iscc_hi_task_error)
+			#endif // ifdef _OPENMP
+			{
+				if (task_state->error.ec == SCC_ER_OK) {
+					task_state->error = iscc_get_error_state();
+					#ifdef _OPENMP
+						#pragma omp atomic write
+					#endif // ifdef _OPENMP
+					task_state->ec = ec;
+				}
+			}
+			return;
+		}
+
+		if (task_state->tree != NULL) {
+			size_t first_child;
+			#ifdef _OPENMP
+				#pragma omp atomic capture
+			#endif // ifdef _OPENMP
+			{ first_child = task_state->tree->num_nodes; task_state->tree->num_nodes += 2; }
+			iscc_hi_record_split(task_state->tree, task_state->pointindex_store, first_child, &cluster, &new_cluster);
+		}
+
+		#ifdef _OPENMP
+			#pragma omp task if(new_cluster.size >= ISCC_HI_MIN_TASK_SIZE)
+		#endif // ifdef _OPENMP
+		iscc_hi_split_in_tasks(new_cluster, task_state);
+	}
+
+	if (cluster.size > 0) {
+		size_t leaf;
+		#ifdef _OPENMP
+			#pragma omp atomic capture
+		#endif // ifdef _OPENMP
+		leaf = task_state->num_leaves++;
+		task_state->leaves[leaf] = cluster;
+	}
+}
+
+
+// The distance array, the edge lists and the sort scratch grow with the clusters the thread splits
+static scc_ErrorCode iscc_hi_reserve_work_area(iscc_hi_WorkArea* const work_area,
+                                               const size_t cluster_size)
+{
+	assert(work_area != NULL);
+
+	if (cluster_size <= work_area->capacity) return iscc_no_error();
+
+	free(work_area->dist_array);
+	free(work_area->edge_list1.heads);
+	free(work_area->edge_list1.dists);
+	free(work_area->edge_list2.heads);
+	free(work_area->edge_list2.dists);
+	free(work_area->heads_scratch);
+	free(work_area->dists_scratch);
+
+	const size_t size_dist_array = ((2 * cluster_size) > ISCC_HI_NUM_TO_CHECK) ? (2 * cluster_size) : ISCC_HI_NUM_TO_CHECK;
+	work_area->dist_array = malloc(sizeof(double[size_dist_array]));
+	work_area->edge_list1.heads = malloc(sizeof(scc_PointIndex[cluster_size]));
+	work_area->edge_list1.dists = malloc(sizeof(double[cluster_size]));
+	work_area->edge_list2.heads = malloc(sizeof(scc_PointIndex[cluster_size]));
+	work_area->edge_list2.dists = malloc(sizeof(double[cluster_size]));
+	work_area->heads_scratch = malloc(sizeof(scc_PointIndex[cluster_size]));
+	work_area->dists_scratch = malloc(sizeof(double[cluster_size]));
+	if ((work_area->dist_array == NULL) ||
+	        (work_area->edge_list1.heads == NULL) || (work_area->edge_list1.dists == NULL) ||
+	        (work_area->edge_list2.heads == NULL) || (work_area->edge_list2.dists == NULL) ||
+	        (work_area->heads_scratch == NULL) || (work_area->dists_scratch == NULL)) {
+		work_area->capacity = 0;
+		return iscc_make_error(SCC_ER_NO_MEMORY);
+	}
+
+	work_area->capacity = cluster_size;
+	return iscc_no_error();
+}
+
+
+// Orders leaves by decreasing position in `pointindex_store`
+static int iscc_hi_compare_leaf_members(const void* const a,
+                                        const void* const b)
+{
+	const scc_PointIndex* const members_a = ((const iscc_hi_ClusterItem*)a)->members;
+	const scc_PointIndex* const members_b = ((const iscc_hi_ClusterItem*)b)->members;
+	return (members_a < members_b) - (members_a > members_b);
+}
+
+
+// `cluster1` is the cluster that was split, and `cluster2` the new cluster
+static inline void iscc_hi_record_split(scc_ClusterTree* const tree,
+                                        const scc_PointIndex* const pointindex_store,
+                                        const size_t first_child,
+                                        iscc_hi_ClusterItem* const cluster1,
+                                        iscc_hi_ClusterItem* const cluster2)
+{
+	assert(tree != NULL);
+	assert(pointindex_store != NULL);
+	// `tree->num_nodes` is updated concurrently in parallel runs, so check against the
+	// allocated number of nodes, which only depends on fields that are fixed during the run
+	assert(first_child >= tree->num_roots);
+	assert(first_child + 1 < tree->num_roots + 2 * (tree->num_data_points / tree->size_constraint));
+	assert(cluster1 != NULL);
+	assert(cluster2 != NULL);
+	assert(cluster1->members < cluster2->members);
+
+	tree->node_child[cluster1->node] = first_child;
+
+	tree->node_first[first_child] = (size_t) (cluster1->members - pointindex_store);
+	tree->node_size[first_child] = cluster1->size;
+	tree->node_child[first_child] = 0;
+	cluster1->node = first_child;
+
+	tree->node_first[first_child + 1] = (size_t) (cluster2->members - pointindex_store);
+	tree->node_size[first_child + 1] = cluster2->size;
+	tree->node_child[first_child + 1] = 0;
+	cluster2->node = first_child + 1;
+}
+
+
+// Splits are recorded in the order the threads make them. This renumbers the nodes in
+// the order `iscc_hi_run_hierarchical_clustering` makes the splits: the clusters are
+// split depth first, starting with the last root and the second child of each split.
+static scc_ErrorCode iscc_hi_order_tree_nodes(scc_ClusterTree* const tree)
+{
+	assert(tree != NULL);
+	assert(tree->num_nodes >= tree->num_roots);
+
+	const size_t num_nodes = tree->num_nodes;
+	size_t* const node_first = malloc(sizeof(size_t[num_nodes]));
+	size_t* const node_size = malloc(sizeof(size_t[num_nodes]));
+	size_t* const node_child = malloc(sizeof(size_t[num_nodes]));
+	size_t* const stack_old = malloc(sizeof(size_t[num_nodes]));
+	size_t* const stack_new = malloc(sizeof(size_t[num_nodes]));
+	if ((node_first == NULL) || (node_size == NULL) || (node_child == NULL) ||
+	        (stack_old == NULL) || (stack_new == NULL)) {
+		free(node_first);
+		free(node_size);
+		free(node_child);
+		free(stack_old);
+		free(stack_new);
+		return iscc_make_error(SCC_ER_NO_MEMORY);
+	}
+
+	size_t stack_items = 0;
+	for (; stack_items < tree->num_roots; ++stack_items) {
+		stack_old[stack_items] = stack_items;
+		stack_new[stack_items] = stack_items;
+	}
+
+	size_t next_node = tree->num_roots;
+	while (stack_items > 0) {
+		--stack_items;
+		const size_t old_node = stack_old[stack_items];
+		const size_t new_node = stack_new[stack_items];
+		node_first[new_node] = tree->node_first[old_node];
+		node_size[new_node] = tree->node_size[old_node];
+		node_child[new_node] = 0;
+		if (tree->node_child[old_node] != 0) {
+			node_child[new_node] = next_node;
+			stack_old[stack_items] = tree->node_child[old_node];
+			stack_new[stack_items] = next_node;
+			stack_old[stack_items + 1] = tree->node_child[old_node] + 1;
+			stack_new[stack_items + 1] = next_node + 1;
+			stack_items += 2;
+			next_node += 2;
+		}
+	}
+
+	assert(next_node == num_nodes);
+
+	free(tree->node_first);
+	free(tree->node_size);
+	free(tree->node_child);
+	tree->node_first = node_first;
+	tree->node_size = node_size;
+	tree->node_child = node_child;
+
+	free(stack_old);
+	free(stack_new);
+
+	return iscc_no_error();
+}
+
+
 static scc_ErrorCode iscc_hi_push_to_stack(iscc_hi_ClusterStack* const cl_stack,
                                            iscc_hi_ClusterItem** const cl)
 {
@@ -452,8 +1172,8 @@ static scc_ErrorCode iscc_hi_break_cluster_into_two(iscc_hi_ClusterItem* const c
 	assert(work_area->pointindex_array1 != NULL);
 	assert(work_area->pointindex_array2 != NULL);
 	assert(work_area->vertex_markers != NULL);
-	assert(work_area->edge_store1 != NULL);
-	assert(work_area->edge_store2 != NULL);
+	assert(work_area->edge_list1.heads != NULL);
+	assert(work_area->edge_list2.heads != NULL);
 	assert(size_constraint >= 2);
 	assert(out_new_cluster != NULL);
 
@@ -479,17 +1199,17 @@ static scc_ErrorCode iscc_hi_break_cluster_into_two(iscc_hi_ClusterItem* const c
 
 	scc_PointIndex* const k_nn_array1 = work_area->pointindex_array1;
 	scc_PointIndex* const k_nn_array2 = work_area->pointindex_array2;
-	uint_fast16_t* const vertex_markers = work_area->vertex_markers;
+	uint16_t* const vertex_markers = work_area->vertex_markers;
 
-	// `edge_store1` and `edge_store2` have been populated by `iscc_hi_populate_edge_lists`
-	iscc_hi_DistanceEdge* last_assigned_edge1 = work_area->edge_store1;
-	iscc_hi_DistanceEdge* last_assigned_edge2 = work_area->edge_store2;
+	// `edge_list1` and `edge_list2` have been populated by `iscc_hi_populate_edge_lists`
+	iscc_hi_EdgeList* const edge_list1 = &work_area->edge_list1;
+	iscc_hi_EdgeList* const edge_list2 = &work_area->edge_list2;
 
-	iscc_hi_DistanceEdge* temp_edge1;
-	iscc_hi_DistanceEdge* temp_edge2;
+	size_t temp_edge1;
+	size_t temp_edge2;
 
 	size_t num_unassigned = cluster_to_break->size;
-	const uint_fast16_t curr_marker = iscc_hi_get_next_marker(cluster_to_break, vertex_markers);
+	const uint16_t curr_marker = iscc_hi_get_next_marker(cluster_to_break, vertex_markers);
 
 	*out_new_cluster = (iscc_hi_ClusterItem) {
 		.size = 0,
@@ -504,20 +1224,19 @@ static scc_ErrorCode iscc_hi_break_cluster_into_two(iscc_hi_ClusterItem* const c
 	iscc_hi_move_point_to_cluster1(center1, cluster1, vertex_markers, curr_marker);
 	iscc_hi_move_point_to_cluster2(center2, cluster2, vertex_markers, curr_marker);
 
-	temp_edge1 = iscc_hi_get_next_k_nn(last_assigned_edge1, size_constraint - 1, vertex_markers, curr_marker, k_nn_array1);
-	temp_edge2 = iscc_hi_get_next_k_nn(last_assigned_edge2, size_constraint - 1, vertex_markers, curr_marker, k_nn_array2);
+	// Assigned points are skipped in the lists, so they need not be advanced after assignments
+	temp_edge1 = iscc_hi_get_next_k_nn(edge_list1, size_constraint - 1, vertex_markers, curr_marker, k_nn_array1);
+	temp_edge2 = iscc_hi_get_next_k_nn(edge_list2, size_constraint - 1, vertex_markers, curr_marker, k_nn_array2);
 
-	if (temp_edge1->distance >= temp_edge2->distance) {
+	if (edge_list1->dists[temp_edge1] >= edge_list2->dists[temp_edge2]) {
 		iscc_hi_move_array_to_cluster1(size_constraint - 1, k_nn_array1, cluster1, vertex_markers, curr_marker);
-		last_assigned_edge1 = temp_edge1;
 
-		last_assigned_edge2 = iscc_hi_get_next_k_nn(last_assigned_edge2, size_constraint - 1, vertex_markers, curr_marker, k_nn_array2);
+		iscc_hi_get_next_k_nn(edge_list2, size_constraint - 1, vertex_markers, curr_marker, k_nn_array2);
 		iscc_hi_move_array_to_cluster2(size_constraint - 1, k_nn_array2, cluster2, vertex_markers, curr_marker);
 	} else {
 		iscc_hi_move_array_to_cluster2(size_constraint - 1, k_nn_array2, cluster2, vertex_markers, curr_marker);
-		last_assigned_edge2 = temp_edge2;
 
-		last_assigned_edge1 = iscc_hi_get_next_k_nn(last_assigned_edge1, size_constraint - 1, vertex_markers, curr_marker, k_nn_array1);
+		iscc_hi_get_next_k_nn(edge_list1, size_constraint - 1, vertex_markers, curr_marker, k_nn_array1);
 		iscc_hi_move_array_to_cluster1(size_constraint - 1, k_nn_array1, cluster1, vertex_markers, curr_marker);
 	}
 
@@ -531,29 +1250,25 @@ static scc_ErrorCode iscc_hi_break_cluster_into_two(iscc_hi_ClusterItem* const c
 
 			if (num_assign_in_batch > num_unassigned) num_assign_in_batch = (uint32_t) num_unassigned;
 
-			temp_edge1 = iscc_hi_get_next_k_nn(last_assigned_edge1, num_assign_in_batch, vertex_markers, curr_marker, k_nn_array1);
-			temp_edge2 = iscc_hi_get_next_k_nn(last_assigned_edge2, num_assign_in_batch, vertex_markers, curr_marker, k_nn_array2);
+			temp_edge1 = iscc_hi_get_next_k_nn(edge_list1, num_assign_in_batch, vertex_markers, curr_marker, k_nn_array1);
+			temp_edge2 = iscc_hi_get_next_k_nn(edge_list2, num_assign_in_batch, vertex_markers, curr_marker, k_nn_array2);
 
-			if (temp_edge1->distance <= temp_edge2->distance) {
+			if (edge_list1->dists[temp_edge1] <= edge_list2->dists[temp_edge2]) {
 				iscc_hi_move_array_to_cluster1(num_assign_in_batch, k_nn_array1, cluster1, vertex_markers, curr_marker);
-				last_assigned_edge1 = temp_edge1;
 			} else {
 				iscc_hi_move_array_to_cluster2(num_assign_in_batch, k_nn_array2, cluster2, vertex_markers, curr_marker);
-				last_assigned_edge2 = temp_edge2;
 			}
 		}
 
 	} else {
 		for (; num_unassigned > 0; --num_unassigned) {
-			temp_edge1 = iscc_hi_get_next_dist(last_assigned_edge1, vertex_markers, curr_marker);
-			temp_edge2 = iscc_hi_get_next_dist(last_assigned_edge2, vertex_markers, curr_marker);
+			temp_edge1 = iscc_hi_get_next_dist(edge_list1, vertex_markers, curr_marker);
+			temp_edge2 = iscc_hi_get_next_dist(edge_list2, vertex_markers, curr_marker);
 
-			if (temp_edge1->distance <= temp_edge2->distance) {
-				iscc_hi_move_point_to_cluster1(temp_edge1->head, cluster1, vertex_markers, curr_marker);
-				last_assigned_edge1 = temp_edge1;
+			if (edge_list1->dists[temp_edge1] <= edge_list2->dists[temp_edge2]) {
+				iscc_hi_move_point_to_cluster1(edge_list1->heads[temp_edge1], cluster1, vertex_markers, curr_marker);
 			} else {
-				iscc_hi_move_point_to_cluster2(temp_edge2->head, cluster2, vertex_markers, curr_marker);
-				last_assigned_edge2 = temp_edge2;
+				iscc_hi_move_point_to_cluster2(edge_list2->heads[temp_edge2], cluster2, vertex_markers, curr_marker);
 			}
 		}
 	}
@@ -567,15 +1282,18 @@ static scc_ErrorCode iscc_hi_break_cluster_into_two(iscc_hi_ClusterItem* const c
 }
 
 
-static inline uint_fast16_t iscc_hi_get_next_marker(iscc_hi_ClusterItem* const cl,
-                                                    uint_fast16_t vertex_markers[const])
+// A point is marked when its marker equals the marker of its cluster. Clusters inherit the
+// marker of the cluster they were split from, and only the members of a cluster are reset
+// when its marker wraps, which happens at most once per 65535 markers along a branch.
+static inline uint16_t iscc_hi_get_next_marker(iscc_hi_ClusterItem* const cl,
+                                               uint16_t vertex_markers[const])
 {
 	assert(cl != NULL);
 	assert(cl->size > 0);
 	assert(cl->members != NULL);
 	assert(vertex_markers != NULL);
 
-	if (cl->marker == UINT_FAST16_MAX) {
+	if (cl->marker == UINT16_MAX) {
 		cl->marker = 0;
 		for (size_t i = 0; i < cl->size; ++i) {
 			vertex_markers[cl->members[i]] = 0;
@@ -587,49 +1305,75 @@ static inline uint_fast16_t iscc_hi_get_next_marker(iscc_hi_ClusterItem* const c
 }
 
 
-static inline iscc_hi_DistanceEdge* iscc_hi_get_next_k_nn(iscc_hi_DistanceEdge* prev_dist,
-                                                          const uint32_t k,
-                                                          const uint_fast16_t vertex_markers[const],
-                                                          const uint_fast16_t curr_marker,
-                                                          scc_PointIndex out_dist_array[const static k])
+// Finds the next `k` unassigned points in `edge_list` and returns the position of the last of
+// them. Assigned points passed over are removed by moving the found points past them, so the
+// list stays in order and the points are not visited again if the list is searched anew.
+static inline size_t iscc_hi_get_next_k_nn(iscc_hi_EdgeList* const edge_list,
+                                           const uint32_t k,
+                                           const uint16_t vertex_markers[const],
+                                           const uint16_t curr_marker,
+                                           scc_PointIndex out_dist_array[const static k])
 {
-	assert(prev_dist != NULL);
-	assert(prev_dist->next_dist != NULL); // We should never reach the end!
+	assert(edge_list != NULL);
 	assert(k > 0);
 	assert(vertex_markers != NULL);
 	assert(out_dist_array != NULL);
 
-	for (uint32_t found = 0; found < k; ++found) {
-		prev_dist = iscc_hi_get_next_dist(prev_dist, vertex_markers, curr_marker);
-		out_dist_array[found] = prev_dist->head;
+	const size_t first = iscc_hi_get_next_dist(edge_list, vertex_markers, curr_marker);
+	scc_PointIndex* const heads = edge_list->heads;
+	double* const dists = edge_list->dists;
+
+	size_t end = first;
+	for (uint32_t found = 0; found < k; ++end) {
+		assert(end < edge_list->len); // We should never reach the end!
+		if (vertex_markers[heads[end]] != curr_marker) {
+			out_dist_array[found] = heads[end];
+			++found;
+		}
 	}
 
-	return prev_dist;
+	if (end - first > k) {
+		size_t write = end;
+		for (size_t read = end; read > first; ) {
+			--read;
+			if (vertex_markers[heads[read]] != curr_marker) {
+				--write;
+				heads[write] = heads[read];
+				dists[write] = dists[read];
+			}
+		}
+		assert(write == end - k);
+		edge_list->first = write;
+	}
+
+	return end - 1;
 }
 
 
-static inline iscc_hi_DistanceEdge* iscc_hi_get_next_dist(iscc_hi_DistanceEdge* const prev_dist,
-                                                          const uint_fast16_t vertex_markers[const],
-                                                          const uint_fast16_t curr_marker)
+// Skips assigned points at the start of `edge_list` and returns the position of the next unassigned point
+static inline size_t iscc_hi_get_next_dist(iscc_hi_EdgeList* const edge_list,
+                                           const uint16_t vertex_markers[const],
+                                           const uint16_t curr_marker)
 {
-	assert(prev_dist != NULL);
-	assert(prev_dist->next_dist != NULL); // We should never reach the end!
+	assert(edge_list != NULL);
 	assert(vertex_markers != NULL);
 
-	while(vertex_markers[prev_dist->next_dist->head] == curr_marker) {
+	size_t first = edge_list->first;
+	while (vertex_markers[edge_list->heads[first]] == curr_marker) {
 		// Vertex has already been assigned to a new cluster, skip it
-		prev_dist->next_dist = prev_dist->next_dist->next_dist;
-		assert(prev_dist->next_dist != NULL); // We should never reach the end!
+		++first;
+		assert(first < edge_list->len); // We should never reach the end!
 	}
+	edge_list->first = first;
 
-	return prev_dist->next_dist;
+	return first;
 }
 
 
 static inline void iscc_hi_move_point_to_cluster1(const scc_PointIndex id,
                                                   iscc_hi_ClusterItem* const cl,
-                                                  uint_fast16_t vertex_markers[const],
-                                                  const uint_fast16_t curr_marker)
+                                                  uint16_t vertex_markers[const],
+                                                  const uint16_t curr_marker)
 {
 	assert(cl != NULL);
 	assert(cl->members != NULL);
@@ -645,8 +1389,8 @@ static inline void iscc_hi_move_point_to_cluster1(const scc_PointIndex id,
 
 static inline void iscc_hi_move_point_to_cluster2(const scc_PointIndex id,
                                                   iscc_hi_ClusterItem* const cl,
-                                                  uint_fast16_t vertex_markers[const],
-                                                  const uint_fast16_t curr_marker)
+                                                  uint16_t vertex_markers[const],
+                                                  const uint16_t curr_marker)
 {
 	assert(cl != NULL);
 	assert(cl->members != NULL);
@@ -664,8 +1408,8 @@ static inline void iscc_hi_move_point_to_cluster2(const scc_PointIndex id,
 static inline void iscc_hi_move_array_to_cluster1(const uint32_t len_ids,
                                                   const scc_PointIndex ids[static len_ids],
                                                   iscc_hi_ClusterItem* const cl,
-                                                  uint_fast16_t vertex_markers[const],
-                                                  const uint_fast16_t curr_marker)
+                                                  uint16_t vertex_markers[const],
+                                                  const uint16_t curr_marker)
 {
 	assert(len_ids > 0);
 	assert(ids != NULL);
@@ -689,8 +1433,8 @@ static inline void iscc_hi_move_array_to_cluster1(const uint32_t len_ids,
 static inline void iscc_hi_move_array_to_cluster2(const uint32_t len_ids,
                                                   const scc_PointIndex ids[static len_ids],
                                                   iscc_hi_ClusterItem* const cl,
-                                                  uint_fast16_t vertex_markers[const],
-                                                  const uint_fast16_t curr_marker)
+                                                  uint16_t vertex_markers[const],
+                                                  const uint16_t curr_marker)
 {
 	assert(len_ids > 0);
 	assert(ids != NULL);
@@ -732,9 +1476,9 @@ static scc_ErrorCode iscc_hi_find_centers(iscc_hi_ClusterItem* const cl,
 	scc_PointIndex* const to_check = work_area->pointindex_array1;
 	scc_PointIndex* const max_indices = work_area->pointindex_array2;
 	double* const max_dists = work_area->dist_array;
-	uint_fast16_t* const vertex_markers = work_area->vertex_markers;
+	uint16_t* const vertex_markers = work_area->vertex_markers;
 
-	const uint_fast16_t curr_marker = iscc_hi_get_next_marker(cl, vertex_markers);
+	const uint16_t curr_marker = iscc_hi_get_next_marker(cl, vertex_markers);
 
 	size_t step = cl->size / ISCC_HI_NUM_TO_CHECK;
 	if (step < 2) step = 2;
@@ -755,8 +1499,8 @@ static scc_ErrorCode iscc_hi_find_centers(iscc_hi_ClusterItem* const cl,
 
 	double max_dist = -1.0;
 	while (num_to_check > 0) {
-		if (!iscc_get_max_dist(max_dist_object, num_to_check, to_check, max_indices, max_dists)) {
-			iscc_close_max_dist_object(&max_dist_object);
+		if (!iscc_get_max_dist(data_set, max_dist_object, num_to_check, to_check, max_indices, max_dists)) {
+			iscc_close_max_dist_object(data_set, &max_dist_object);
 			return iscc_make_error(SCC_ER_DIST_SEARCH_ERROR);
 		}
 
@@ -778,7 +1522,7 @@ static scc_ErrorCode iscc_hi_find_centers(iscc_hi_ClusterItem* const cl,
 		num_to_check = write_in_to_check;
 	}
 
-	if (!iscc_close_max_dist_object(&max_dist_object)) {
+	if (!iscc_close_max_dist_object(data_set, &max_dist_object)) {
 		return iscc_make_error(SCC_ER_DIST_SEARCH_ERROR);
 	}
 
@@ -799,8 +1543,10 @@ static scc_ErrorCode iscc_hi_populate_edge_lists(const iscc_hi_ClusterItem* cons
 	assert(iscc_check_data_set(data_set));
 	assert(work_area != NULL);
 	assert(work_area->dist_array != NULL);
-	assert(work_area->edge_store1 != NULL);
-	assert(work_area->edge_store2 != NULL);
+	assert(work_area->edge_list1.heads != NULL);
+	assert(work_area->edge_list2.heads != NULL);
+	assert(work_area->heads_scratch != NULL);
+	assert(work_area->dists_scratch != NULL);
 
 	double* const row_dists = work_area->dist_array;
 	const scc_PointIndex query_indices[2] = { center1, center2 };
@@ -814,51 +1560,131 @@ static scc_ErrorCode iscc_hi_populate_edge_lists(const iscc_hi_ClusterItem* cons
 		return iscc_make_error(SCC_ER_DIST_SEARCH_ERROR);
 	}
 
-	iscc_hi_sort_edge_list(cl, center1, row_dists, work_area->edge_store1);
-	iscc_hi_sort_edge_list(cl, center2, row_dists + cl->size, work_area->edge_store2);
+	iscc_hi_sort_edge_list(cl, center1, row_dists, &work_area->edge_list1,
+	                       work_area->heads_scratch, work_area->dists_scratch);
+	iscc_hi_sort_edge_list(cl, center2, row_dists + cl->size, &work_area->edge_list2,
+	                       work_area->heads_scratch, work_area->dists_scratch);
 
 	return iscc_no_error();
 }
 
 
+// Edges are sorted by distance, and edges with equal distances keep the order of `cl->members`.
+// The scratch arrays must hold `cl->size - 1` edges unless the list is shorter than `ISCC_HI_RADIX_SORT_MIN`.
 static inline void iscc_hi_sort_edge_list(const iscc_hi_ClusterItem* const cl,
                                           const scc_PointIndex center,
                                           const double row_dists[const static cl->size],
-                                          iscc_hi_DistanceEdge edge_store[const static cl->size])
+                                          iscc_hi_EdgeList* const edge_list,
+                                          scc_PointIndex heads_scratch[const],
+                                          double dists_scratch[const])
 {
 	assert(cl != NULL);
 	assert(cl->size >= 4);
 	assert(cl->members != NULL);
 	assert(row_dists != NULL);
-	assert(edge_store != NULL);
+	assert(edge_list != NULL);
+	assert(edge_list->heads != NULL);
+	assert(edge_list->dists != NULL);
 
-	iscc_hi_DistanceEdge* write_edge = edge_store + 1;
+	scc_PointIndex* const heads = edge_list->heads;
+	double* const dists = edge_list->dists;
+	size_t len_edges = 0;
 	for (size_t i = 0; i < cl->size; ++i) {
 		if (cl->members[i] == center) continue;
-		write_edge->head = cl->members[i];
-		write_edge->distance = row_dists[i];
-		++write_edge;
+		heads[len_edges] = cl->members[i];
+		dists[len_edges] = row_dists[i];
+		++len_edges;
 	}
 
-	assert(write_edge == (edge_store + cl->size));
-
-	qsort(edge_store + 1, cl->size - 1, sizeof(iscc_hi_DistanceEdge), iscc_hi_compare_dist_edges);
+	assert(len_edges == cl->size - 1);
 
-	iscc_hi_DistanceEdge* const edge_stop = edge_store + cl->size - 1;
-	for (iscc_hi_DistanceEdge* edge = edge_store; edge != edge_stop; ++edge) {
-		edge->next_dist = edge + 1;
+	if (len_edges >= ISCC_HI_RADIX_SORT_MIN) {
+		assert((heads_scratch != NULL) && (dists_scratch != NULL));
+		iscc_hi_radix_sort_edges(len_edges, heads, dists, heads_scratch, dists_scratch);
+	} else {
+		for (size_t i = 1; i < len_edges; ++i) {
+			const scc_PointIndex tmp_head = heads[i];
+			const double tmp_dist = dists[i];
+			size_t j = i;
+			for (; (j > 0) && (dists[j - 1] > tmp_dist); --j) {
+				heads[j] = heads[j - 1];
+				dists[j] = dists[j - 1];
+			}
+			heads[j] = tmp_head;
+			dists[j] = tmp_dist;
+		}
 	}
-	edge_stop->next_dist = NULL;
+
+	edge_list->first = 0;
+	edge_list->len = len_edges;
 }
 
 
-static int iscc_hi_compare_dist_edges(const void* const a,
-                                      const void* const b)
+// Maps distances to keys that order as the distances do. Non-negative doubles
+// order as their bit patterns, and negative ones in reverse. Adding zero turns
+// -0.0 into 0.0, which compares equal to it.
+static inline uint64_t iscc_hi_dist_key(const double distance)
 {
-	const double dist_a = ((const iscc_hi_DistanceEdge*)a)->distance;
-	const double dist_b = ((const iscc_hi_DistanceEdge*)b)->distance;
+	const double tmp_distance = distance + 0.0;
+	uint64_t key;
+	memcpy(&key, &tmp_distance, sizeof(uint64_t));
+	return (key & UINT64_C(0x8000000000000000)) ? ~key : (key | UINT64_C(0x8000000000000000));
+}
+
+
+// Stable LSD radix sort on the distance keys, one byte per pass. Bytes that are
+// the same for all keys (e.g., the sign and most of the exponent) are skipped.
+static void iscc_hi_radix_sort_edges(const size_t len_edges,
+                                     scc_PointIndex heads[const static len_edges],
+                                     double dists[const static len_edges],
+                                     scc_PointIndex heads_scratch[const static len_edges],
+                                     double dists_scratch[const static len_edges])
+{
+	assert(len_edges > 0);
+	assert((heads != NULL) && (dists != NULL));
+	assert((heads_scratch != NULL) && (dists_scratch != NULL));
+
+	size_t counts[8][256] = { { 0 } };
+	for (size_t i = 0; i < len_edges; ++i) {
+		const uint64_t key = iscc_hi_dist_key(dists[i]);
+		for (uint_fast16_t b = 0; b < 8; ++b) {
+			++counts[b][(key >> (8 * b)) & 0xFF];
+		}
+	}
 
-	if (dist_a < dist_b) return -1;
-	if (dist_a > dist_b) return 1;
-	return 0;
+	scc_PointIndex* from_heads = heads;
+	double* from_dists = dists;
+	scc_PointIndex* to_heads = heads_scratch;
+	double* to_dists = dists_scratch;
+	const uint64_t first_key = iscc_hi_dist_key(dists[0]);
+	for (uint_fast16_t b = 0; b < 8; ++b) {
+		size_t* const count = counts[b];
+		if (count[(first_key >> (8 * b)) & 0xFF] == len_edges) continue;
+
+		size_t offset = 0;
+		for (size_t d = 0; d < 256; ++d) {
+			const size_t tmp_count = count[d];
+			count[d] = offset;
+			offset += tmp_count;
+		}
+
+		for (size_t i = 0; i < len_edges; ++i) {
+			const uint64_t key = iscc_hi_dist_key(from_dists[i]);
+			const size_t to = count[(key >> (8 * b)) & 0xFF]++;
+			to_heads[to] = from_heads[i];
+			to_dists[to] = from_dists[i];
+		}
+
+		scc_PointIndex* const tmp_heads = from_heads;
+		from_heads = to_heads;
+		to_heads = tmp_heads;
+		double* const tmp_dists = from_dists;
+		from_dists = to_dists;
+		to_dists = tmp_dists;
+	}
+
+	if (from_heads != heads) {
+		memcpy(heads, from_heads, sizeof(scc_PointIndex[len_edges]));
+		memcpy(dists, from_dists, sizeof(double[len_edges]));
+	}
 }
@@ -21,16 +21,35 @@
 #include "nng_batch_clustering.h"
 
 #include <assert.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include "../include/scclust.h"
+#include "bitset.h"
 #include "clustering_struct.h"
 #include "dist_search.h"
 #include "error.h"
 #include "scclust_types.h"
 
+#ifdef _OPENMP
+	#include <omp.h>
+#endif // ifdef _OPENMP
+
+
+// =============================================================================
+// Internal variables
+// =============================================================================
+
+// Smallest number of queries in each chunk when a batch is searched by several threads
+static const size_t ISCC_BATCH_MIN_QUERY_CHUNK = 16;
+
+// Number of chunks per thread, so that the thread that assigns can take the remaining chunks
+static const size_t ISCC_BATCH_CHUNKS_PER_THREAD = 4;
+
+
 
 // =============================================================================
 // Static function prototypes
@@ -44,16 +63,55 @@ static int iscc_compare_PointIndex(const void* a, const void* b);
 
 
 static scc_ErrorCode iscc_run_nng_batches(scc_Clustering* clustering,
+                                          void* data_set,
                                           iscc_NNSearchObject* nn_search_object,
                                           uint32_t size_constraint,
                                           bool ignore_unassigned,
                                           bool radius_constraint,
                                           double radius,
-                                          const bool primary_data_points[],
+                                          const iscc_BitsetWord primary_data_points[],
                                           uint32_t batch_size,
                                           scc_PointIndex* batch_indices,
                                           scc_PointIndex* out_indices,
-                                          bool* assigned);
+                                          iscc_BitsetWord* assigned);
+
+
+static scc_ErrorCode iscc_run_pipelined_nng_batches(scc_Clustering* clustering,
+                                                    void* data_set,
+                                                    iscc_NNSearchObject* nn_search_object,
+                                                    uint32_t size_constraint,
+                                                    bool ignore_unassigned,
+                                                    bool radius_constraint,
+                                                    double radius,
+                                                    const iscc_BitsetWord primary_data_points[],
+                                                    uint32_t batch_size,
+                                                    size_t use_threads,
+                                                    scc_PointIndex* batch_indices,
+                                                    scc_PointIndex* out_indices,
+                                                    iscc_BitsetWord* assigned);
+
+
+static size_t iscc_gather_batch(scc_Clustering* clustering,
+                                const iscc_BitsetWord assigned[],
+                                const iscc_BitsetWord primary_data_points[],
+                                uint32_t batch_size,
+                                scc_PointIndex* curr_point,
+                                scc_PointIndex batch_indices[]);
+
+
+static scc_ErrorCode iscc_assign_batch(scc_Clustering* clustering,
+                                       uint32_t size_constraint,
+                                       bool ignore_unassigned,
+                                       size_t num_ok_in_batch,
+                                       const scc_PointIndex batch_indices[],
+                                       scc_PointIndex out_indices[],
+                                       iscc_BitsetWord* assigned,
+                                       scc_Clabel* next_cluster_label);
+
+
+static scc_ErrorCode iscc_finish_nng_batches(scc_Clustering* clustering,
+                                             bool search_done,
+                                             scc_Clabel next_cluster_label);
 
 
 // =============================================================================
@@ -68,7 +126,8 @@ scc_ErrorCode scc_nng_clustering_batches(scc_Clustering* const clustering,
                                          const double radius,
                                          const size_t len_primary_data_points,
                                          const scc_PointIndex primary_data_points[const],
-                                         uint32_t batch_size)
+                                         uint32_t batch_size,
+                                         const uint32_t num_threads)
 {
 	if (!iscc_check_input_clustering(clustering)) {
 		return iscc_make_error_msg(SCC_ER_INVALID_INPUT, "Invalid clustering object.");
@@ -106,6 +165,17 @@ scc_ErrorCode scc_nng_clustering_batches(scc_Clustering* const clustering,
 		batch_size = (uint32_t) clustering->num_data_points;
 	}
 
+	// The next batch is searched while the current is assigned, which needs a reentrant search
+	size_t use_threads = 1;
+	#ifdef _OPENMP
+		use_threads = (num_threads == 0) ? (size_t) omp_get_max_threads() : num_threads;
+		if (use_threads > INT_MAX) use_threads = INT_MAX;
+		if (!iscc_nn_search_is_reentrant(data_set)) use_threads = 1;
+	#else
+		(void) num_threads;
+	#endif // ifdef _OPENMP
+	const size_t num_buffers = (use_threads > 1) ? 2 : 1;
+
 	iscc_NNSearchObject* nn_search_object;
 	if (!iscc_init_nn_search_object(data_set,
 	                                clustering->num_data_points,
@@ -114,14 +184,14 @@ scc_ErrorCode scc_nng_clustering_batches(scc_Clustering* const clustering,
 		return iscc_make_error(SCC_ER_DIST_SEARCH_ERROR);
 	}
 
-	scc_PointIndex* const batch_indices = malloc(sizeof(scc_PointIndex[batch_size]));
-	scc_PointIndex* const out_indices = malloc(sizeof(scc_PointIndex[size_constraint * batch_size]));
-	bool* const assigned = calloc(clustering->num_data_points, sizeof(bool));
+	scc_PointIndex* const batch_indices = malloc(sizeof(scc_PointIndex[num_buffers * batch_size]));
+	scc_PointIndex* const out_indices = malloc(sizeof(scc_PointIndex[num_buffers * batch_size * size_constraint]));
+	iscc_BitsetWord* const assigned = iscc_bitset_alloc(clustering->num_data_points);
 	if ((batch_indices == NULL) || (out_indices == NULL) || (assigned == NULL)) {
 		free(batch_indices);
 		free(out_indices);
 		free(assigned);
-		iscc_close_nn_search_object(&nn_search_object);
+		iscc_close_nn_search_object(data_set, &nn_search_object);
 		return iscc_make_error(SCC_ER_NO_MEMORY);
 	}
 
@@ -133,36 +203,61 @@ scc_ErrorCode scc_nng_clustering_batches(scc_Clustering* const clustering,
 			free(batch_indices);
 			free(out_indices);
 			free(assigned);
-			iscc_close_nn_search_object(&nn_search_object);
+			iscc_close_nn_search_object(data_set, &nn_search_object);
 			return iscc_make_error(SCC_ER_NO_MEMORY);
 		}
 	}
 
-	bool* tmp_primary_data_points = NULL;
+	iscc_BitsetWord* tmp_primary_data_points = NULL;
 	if (primary_data_points != NULL) {
-		tmp_primary_data_points = calloc(clustering->num_data_points, sizeof(bool));
+		tmp_primary_data_points = iscc_bitset_alloc(clustering->num_data_points);
+		if (tmp_primary_data_points == NULL) {
+			free(batch_indices);
+			free(out_indices);
+			free(assigned);
+			iscc_close_nn_search_object(data_set, &nn_search_object);
+			return iscc_make_error(SCC_ER_NO_MEMORY);
+		}
 		for (size_t i = 0; i < len_primary_data_points; ++i) {
-			tmp_primary_data_points[primary_data_points[i]] = true;
+			iscc_bitset_set(tmp_primary_data_points, (size_t) primary_data_points[i]);
 		}
 	}
 
-	scc_ErrorCode ec = iscc_run_nng_batches(clustering,
-	                                        nn_search_object,
-	                                        size_constraint,
-	                                        (unassigned_method == SCC_UM_IGNORE),
-	                                        radius_constraint,
-	                                        radius,
-	                                        tmp_primary_data_points,
-	                                        batch_size,
-	                                        batch_indices,
-	                                        out_indices,
-	                                        assigned);
+	scc_ErrorCode ec;
+	if (use_threads > 1) {
+		ec = iscc_run_pipelined_nng_batches(clustering,
+		                                    data_set,
+		                                    nn_search_object,
+		                                    size_constraint,
+		                                    (unassigned_method == SCC_UM_IGNORE),
+		                                    radius_constraint,
+		                                    radius,
+		                                    tmp_primary_data_points,
+		                                    batch_size,
+		                                    use_threads,
+		                                    batch_indices,
+		                                    out_indices,
+		                                    assigned);
+	} else {
+		ec = iscc_run_nng_batches(clustering,
+		                          data_set,
+		                          nn_search_object,
+		                          size_constraint,
+		                          (unassigned_method == SCC_UM_IGNORE),
+		                          radius_constraint,
+		                          radius,
+		                          tmp_primary_data_points,
+		                          batch_size,
+		                          batch_indices,
+		                          out_indices,
+		                          assigned);
+	}
 
 	free(batch_indices);
 	free(out_indices);
 	free(assigned);
 	free(tmp_primary_data_points);
-	iscc_close_nn_search_object(&nn_search_object);
+	iscc_close_nn_search_object(data_set, &nn_search_object);
 
 	return ec;
 }
@@ -185,16 +280,17 @@ static int iscc_compare_PointIndex(const void* const a, const void* const b)
 
 
 static scc_ErrorCode iscc_run_nng_batches(scc_Clustering* const clustering,
+                                          void* const data_set,
                                           iscc_NNSearchObject* const nn_search_object,
                                           const uint32_t size_constraint,
                                           const bool ignore_unassigned,
                                           const bool radius_constraint,
                                           const double radius,
-                                          const bool primary_data_points[const],
+                                          const iscc_BitsetWord primary_data_points[const],
                                           const uint32_t batch_size,
                                           scc_PointIndex* const batch_indices,
                                           scc_PointIndex* const out_indices,
-                                          bool* const assigned)
+                                          iscc_BitsetWord* const assigned)
 {
 	assert(iscc_check_input_clustering(clustering));
 	assert(clustering->cluster_label != NULL);
@@ -208,33 +304,22 @@ static scc_ErrorCode iscc_run_nng_batches(scc_Clustering* const clustering,
 	assert(out_indices != NULL);
 	assert(assigned != NULL);
 
+	// When unassigned points are ignored, queries with assigned neighbors cannot be seeds and
+	// are not needed, so assigned points are tombstoned in the search
+	const iscc_BitsetWord* const tombstones = (ignore_unassigned && iscc_nn_search_supports_tombstones(data_set)) ? assigned : NULL;
+
 	bool search_done = false;
 	scc_Clabel next_cluster_label = 0;
 	assert(clustering->num_data_points <= ISCC_POINTINDEX_MAX);
 	const scc_PointIndex num_data_points = (scc_PointIndex) clustering->num_data_points; // If `scc_PointIndex` is signed
 
 	for (scc_PointIndex curr_point = 0; curr_point < num_data_points; ) {
-
-		size_t in_batch = 0;
-		if (primary_data_points == NULL) {
-			for (; (in_batch < batch_size) && (curr_point < num_data_points); ++curr_point) {
-				if (!assigned[curr_point]) {
-					clustering->cluster_label[curr_point] = SCC_CLABEL_NA;
-					batch_indices[in_batch] = curr_point;
-					++in_batch;
-				}
-			}
-		} else {
-			for (; (in_batch < batch_size) && (curr_point < num_data_points); ++curr_point) {
-				if (!assigned[curr_point]) {
-					clustering->cluster_label[curr_point] = SCC_CLABEL_NA;
-					if (primary_data_points[curr_point]) {
-						batch_indices[in_batch] = curr_point;
-						++in_batch;
-					}
-				}
-			}
-		}
+		const size_t in_batch = iscc_gather_batch(clustering,
+		                                          assigned,
+		                                          primary_data_points,
+		                                          batch_size,
+		                                          &curr_point,
+		                                          batch_indices);
 
 		if (in_batch == 0) {
 			assert(curr_point == num_data_points);
@@ -243,81 +328,321 @@ static scc_ErrorCode iscc_run_nng_batches(scc_Clustering* const clustering,
 
 		size_t num_ok_in_batch = 0;
 		search_done = true;
-		if (!iscc_nearest_neighbor_search(nn_search_object,
-		                                  in_batch,
-		                                  batch_indices,
-		                                  size_constraint,
-		                                  radius_constraint,
-		                                  radius,
-		                                  &num_ok_in_batch,
-		                                  batch_indices,
-		                                  out_indices)) {
+		if (!iscc_tombstoned_nearest_neighbor_search(data_set,
+		                                             nn_search_object,
+		                                             tombstones,
+		                                             in_batch,
+		                                             batch_indices,
+		                                             size_constraint,
+		                                             radius_constraint,
+		                                             radius,
+		                                             &num_ok_in_batch,
+		                                             batch_indices,
+		                                             out_indices)) {
 			return iscc_make_error(SCC_ER_DIST_SEARCH_ERROR);
 		}
 
-		#ifdef SCC_STABLE_NNG
-		for (size_t i = 0; i < num_ok_in_batch; ++i) {
-			qsort(out_indices + i * size_constraint, size_constraint, sizeof(scc_PointIndex), iscc_compare_PointIndex);
+		scc_ErrorCode ec;
+		if ((ec = iscc_assign_batch(clustering,
+		                            size_constraint,
+		                            ignore_unassigned,
+		                            num_ok_in_batch,
+		                            batch_indices,
+		                            out_indices,
+		                            assigned,
+		                            &next_cluster_label)) != SCC_ER_OK) {
+			return ec;
 		}
-		#endif // ifdef SCC_STABLE_NNG
-
-		const scc_PointIndex* check_indices = out_indices;
-		for (size_t i = 0; i < num_ok_in_batch; ++i) {
-			const scc_PointIndex* const stop_check_indices = check_indices + size_constraint;
-			if (!assigned[batch_indices[i]]) {
-				for (; (check_indices != stop_check_indices) && !assigned[*check_indices]; ++check_indices) {}
-				if (check_indices == stop_check_indices) {
-					// `i` has no assigned neighbors and can be seed
-					if (next_cluster_label == SCC_CLABEL_MAX) {
-						return iscc_make_error_msg(SCC_ER_TOO_LARGE_PROBLEM, "Too many clusters (adjust the `scc_Clabel` type).");
-					}
+	}
 
-					assert(!assigned[batch_indices[i]]);
-					const scc_PointIndex* const stop_assign_indices = stop_check_indices - 1;
-					for (check_indices -= size_constraint; check_indices != stop_assign_indices; ++check_indices) {
-						assert(!assigned[*check_indices]);
-						assigned[*check_indices] = true;
-						clustering->cluster_label[*check_indices] = next_cluster_label;
-					}
-					if (assigned[batch_indices[i]]) {
-						// Self-loop from `batch_indices[i]` to `batch_indices[i]` existed among NN
-						assert(!assigned[*check_indices]);
-						assigned[*check_indices] = true;
-						clustering->cluster_label[*check_indices] = next_cluster_label;
-					} else {
-						// Self-loop did not exist
-						assert(!assigned[batch_indices[i]]);
-						assigned[batch_indices[i]] = true;
-						clustering->cluster_label[batch_indices[i]] = next_cluster_label;
+	return iscc_finish_nng_batches(clustering, search_done, next_cluster_label);
+}
+
+
+/* The next batch is gathered before the current batch is assigned, and it is then searched by
+ * the worker threads while one thread assigns. Points in the next batch may therefore be assigned
+ * by the time their batch is assigned; `iscc_assign_batch` skips such points. Search results do
+ * not depend on `assigned`, and batches are assigned in order, so the clustering is the same as
+ * with `iscc_run_nng_batches`. `batch_indices` and `out_indices` hold two batches each.
+ *
+ * Tombstoned searches cannot read `assigned` while it is written, so they use a copy that is
+ * updated with the points assigned in each batch. The copy lags one batch behind, which only
+ * means that some queries that cannot be seeds are searched in full.
+ */
+static scc_ErrorCode iscc_run_pipelined_nng_batches(scc_Clustering* const clustering,
+                                                    void* const data_set,
+                                                    iscc_NNSearchObject* const nn_search_object,
+                                                    const uint32_t size_constraint,
+                                                    const bool ignore_unassigned,
+                                                    const bool radius_constraint,
+                                                    const double radius,
+                                                    const iscc_BitsetWord primary_data_points[const],
+                                                    const uint32_t batch_size,
+                                                    const size_t use_threads,
+                                                    scc_PointIndex* const batch_indices,
+                                                    scc_PointIndex* const out_indices,
+                                                    iscc_BitsetWord* const assigned)
+{
+	assert(iscc_check_input_clustering(clustering));
+	assert(clustering->cluster_label != NULL);
+	assert(clustering->num_clusters == 0);
+	assert(nn_search_object != NULL);
+	assert(size_constraint >= 2);
+	assert(clustering->num_data_points >= size_constraint);
+	assert(!radius_constraint || (radius > 0.0));
+	assert(batch_size > 0);
+	assert(use_threads > 1);
+	assert(use_threads <= INT_MAX);
+	assert(batch_indices != NULL);
+	assert(out_indices != NULL);
+	assert(assigned != NULL);
+
+	const size_t max_chunks = use_threads * ISCC_BATCH_CHUNKS_PER_THREAD;
+	size_t* const chunk_num_ok = malloc(sizeof(size_t[max_chunks]));
+	if (chunk_num_ok == NULL) return iscc_make_error(SCC_ER_NO_MEMORY);
+
+	iscc_BitsetWord* tombstones = NULL;
+	if (ignore_unassigned && iscc_nn_search_supports_tombstones(data_set)) {
+		tombstones = iscc_bitset_alloc(clustering->num_data_points);
+		if (tombstones == NULL) {
+			free(chunk_num_ok);
+			return iscc_make_error(SCC_ER_NO_MEMORY);
+		}
+	}
+
+	scc_PointIndex* curr_batch = batch_indices;
+	scc_PointIndex* curr_out = out_indices;
+	scc_PointIndex* next_batch = batch_indices + batch_size;
+	scc_PointIndex* next_out = out_indices + ((size_t) batch_size) * size_constraint;
+
+	bool search_done = false;
+	scc_Clabel next_cluster_label = 0;
+	size_t num_ok_in_curr = 0;
+	scc_PointIndex curr_point = 0;
+	assert(clustering->num_data_points <= ISCC_POINTINDEX_MAX);
+
+	size_t in_next;
+	do {
+		in_next = iscc_gather_batch(clustering,
+		                            assigned,
+		                            primary_data_points,
+		                            batch_size,
+		                            &curr_point,
+		                            next_batch);
+
+		size_t num_chunks = 0;
+		size_t chunk_size = 1;
+		if (in_next > 0) {
+			search_done = true;
+			num_chunks = 1 + (in_next - 1) / ISCC_BATCH_MIN_QUERY_CHUNK;
+			if (num_chunks > max_chunks) num_chunks = max_chunks;
+			chunk_size = 1 + (in_next - 1) / num_chunks;
+			num_chunks = 1 + (in_next - 1) / chunk_size;
+		}
+
+		// Chunks write their results into their own slices of the next batch's arrays
+		scc_ErrorCode assign_ec = SCC_ER_OK;
+		size_t num_failed_chunks = 0;
+		#ifdef _OPENMP
+			#pragma omp parallel num_threads((int) use_threads) reduction(+:num_failed_chunks)
+		#endif // ifdef _OPENMP
+		{
+			// The calling thread assigns, so that errors are raised in its error state
+			#ifdef _OPENMP
+				#pragma omp master
+			#endif // ifdef _OPENMP
+			{
+				assign_ec = iscc_assign_batch(clustering,
+				                              size_constraint,
+				                              ignore_unassigned,
+				                              num_ok_in_curr,
+				                              curr_batch,
+				                              curr_out,
+				                              assigned,
+				                              &next_cluster_label);
+			}
+
+			#ifdef _OPENMP
+				#pragma omp for schedule(dynamic) nowait
+			#endif // ifdef _OPENMP
+			for (size_t c = 0; c < num_chunks; ++c) {
+				const size_t chunk_start = c * chunk_size;
+				size_t chunk_len = in_next - chunk_start;
+				if (chunk_len > chunk_size) chunk_len = chunk_size;
+				chunk_num_ok[c] = 0;
+				if (!iscc_tombstoned_nearest_neighbor_search(data_set,
+				                                             nn_search_object,
+				                                             tombstones,
+				                                             chunk_len,
+				                                             next_batch + chunk_start,
+				                                             size_constraint,
+				                                             radius_constraint,
+				                                             radius,
+				                                             &chunk_num_ok[c],
+				                                             next_batch + chunk_start,
+				                                             next_out + chunk_start * size_constraint)) {
+					++num_failed_chunks;
+				}
+			}
+		}
+
+		if ((assign_ec != SCC_ER_OK) || (num_failed_chunks > 0)) {
+			free(chunk_num_ok);
+			free(tombstones);
+			return (assign_ec != SCC_ER_OK) ? assign_ec : iscc_make_error(SCC_ER_DIST_SEARCH_ERROR);
+		}
+
+		// Points are only assigned as seeds or as neighbors of seeds in the current batch
+		if (tombstones != NULL) {
+			const scc_PointIndex* row = curr_out;
+			for (size_t i = 0; i < num_ok_in_curr; ++i) {
+				if (iscc_bitset_test(assigned, (size_t) curr_batch[i])) {
+					iscc_bitset_set(tombstones, (size_t) curr_batch[i]);
+				}
+				for (uint32_t j = 0; j < size_constraint; ++j, ++row) {
+					if (iscc_bitset_test(assigned, (size_t) *row)) {
+						iscc_bitset_set(tombstones, (size_t) *row);
 					}
+				}
+			}
+		}
+
+		// Compact the chunks so that the ok queries of the next batch are contiguous
+		num_ok_in_curr = 0;
+		for (size_t c = 0; c < num_chunks; ++c) {
+			const size_t chunk_start = c * chunk_size;
+			if ((num_ok_in_curr < chunk_start) && (chunk_num_ok[c] > 0)) {
+				memmove(next_out + num_ok_in_curr * size_constraint,
+				        next_out + chunk_start * size_constraint,
+				        sizeof(scc_PointIndex[chunk_num_ok[c] * size_constraint]));
+				memmove(next_batch + num_ok_in_curr,
+				        next_batch + chunk_start,
+				        sizeof(scc_PointIndex[chunk_num_ok[c]]));
+			}
+			num_ok_in_curr += chunk_num_ok[c];
+		}
+
+		scc_PointIndex* const tmp_batch = curr_batch;
+		curr_batch = next_batch;
+		next_batch = tmp_batch;
+		scc_PointIndex* const tmp_out = curr_out;
+		curr_out = next_out;
+		next_out = tmp_out;
+	} while (in_next > 0);
+
+	free(chunk_num_ok);
+	free(tombstones);
 
-					assert(clustering->cluster_label[batch_indices[i]] == next_cluster_label);
-					++next_cluster_label;
+	return iscc_finish_nng_batches(clustering, search_done, next_cluster_label);
+}
+
+
+// Visited unassigned points are labeled `SCC_CLABEL_NA` until they are assigned
+static size_t iscc_gather_batch(scc_Clustering* const clustering,
+                                const iscc_BitsetWord assigned[const],
+                                const iscc_BitsetWord primary_data_points[const],
+                                const uint32_t batch_size,
+                                scc_PointIndex* const curr_point,
+                                scc_PointIndex batch_indices[const])
+{
+	const scc_PointIndex num_data_points = (scc_PointIndex) clustering->num_data_points; // If `scc_PointIndex` is signed
+	scc_PointIndex point = *curr_point;
+
+	// Only unassigned points are visited; assigned ones are skipped a word at a time
+	size_t in_batch = 0;
+	while ((in_batch < batch_size) && (point < num_data_points)) {
+		point = (scc_PointIndex) iscc_bitset_next_clear(assigned, (size_t) num_data_points, (size_t) point);
+		if (point == num_data_points) break;
+		clustering->cluster_label[point] = SCC_CLABEL_NA;
+		if ((primary_data_points == NULL) || iscc_bitset_test(primary_data_points, (size_t) point)) {
+			batch_indices[in_batch] = point;
+			++in_batch;
+		}
+		++point;
+	}
+
+	*curr_point = point;
+	return in_batch;
+}
+
+
+static scc_ErrorCode iscc_assign_batch(scc_Clustering* const clustering,
+                                       const uint32_t size_constraint,
+                                       const bool ignore_unassigned,
+                                       const size_t num_ok_in_batch,
+                                       const scc_PointIndex batch_indices[const],
+                                       scc_PointIndex out_indices[const],
+                                       iscc_BitsetWord* const assigned,
+                                       scc_Clabel* const next_cluster_label)
+{
+	#ifdef SCC_STABLE_NNG
+	for (size_t i = 0; i < num_ok_in_batch; ++i) {
+		qsort(out_indices + i * size_constraint, size_constraint, sizeof(scc_PointIndex), iscc_compare_PointIndex);
+	}
+	#endif // ifdef SCC_STABLE_NNG
+
+	const scc_PointIndex* check_indices = out_indices;
+	for (size_t i = 0; i < num_ok_in_batch; ++i) {
+		const scc_PointIndex* const stop_check_indices = check_indices + size_constraint;
+		if (!iscc_bitset_test(assigned, (size_t) batch_indices[i])) {
+			for (; (check_indices != stop_check_indices) && !iscc_bitset_test(assigned, (size_t) *check_indices); ++check_indices) {}
+			if (check_indices == stop_check_indices) {
+				// `i` has no assigned neighbors and can be seed
+				if (*next_cluster_label == SCC_CLABEL_MAX) {
+					return iscc_make_error_msg(SCC_ER_TOO_LARGE_PROBLEM, "Too many clusters (adjust the `scc_Clabel` type).");
+				}
+
+				assert(!iscc_bitset_test(assigned, (size_t) batch_indices[i]));
+				const scc_PointIndex* const stop_assign_indices = stop_check_indices - 1;
+				for (check_indices -= size_constraint; check_indices != stop_assign_indices; ++check_indices) {
+					assert(!iscc_bitset_test(assigned, (size_t) *check_indices));
+					iscc_bitset_set(assigned, (size_t) *check_indices);
+					clustering->cluster_label[*check_indices] = *next_cluster_label;
+				}
+				if (iscc_bitset_test(assigned, (size_t) batch_indices[i])) {
+					// Self-loop from `batch_indices[i]` to `batch_indices[i]` existed among NN
+					assert(!iscc_bitset_test(assigned, (size_t) *check_indices));
+					iscc_bitset_set(assigned, (size_t) *check_indices);
+					clustering->cluster_label[*check_indices] = *next_cluster_label;
 				} else {
-					// `i` has assigned neighbors and cannot be seed
-					if (!ignore_unassigned) {
-						// Assign `batch_indices[i]` to a preliminary cluster.
-						// If a future seed wants it as neighbor, it switches cluster.
-						assert(assigned[*check_indices]);
-						assert(clustering->cluster_label[batch_indices[i]] == SCC_CLABEL_NA);
-						assert(clustering->cluster_label[*check_indices] != SCC_CLABEL_NA);
-						assert(!assigned[batch_indices[i]]);
-						clustering->cluster_label[batch_indices[i]] = clustering->cluster_label[*check_indices];
-					}
+					// Self-loop did not exist
+					assert(!iscc_bitset_test(assigned, (size_t) batch_indices[i]));
+					iscc_bitset_set(assigned, (size_t) batch_indices[i]);
+					clustering->cluster_label[batch_indices[i]] = *next_cluster_label;
+				}
+
+				assert(clustering->cluster_label[batch_indices[i]] == *next_cluster_label);
+				++(*next_cluster_label);
+			} else {
+				// `i` has assigned neighbors and cannot be seed
+				if (!ignore_unassigned) {
+					// Assign `batch_indices[i]` to a preliminary cluster.
+					// If a future seed wants it as neighbor, it switches cluster.
+					assert(iscc_bitset_test(assigned, (size_t) *check_indices));
+					assert(clustering->cluster_label[batch_indices[i]] == SCC_CLABEL_NA);
+					assert(clustering->cluster_label[*check_indices] != SCC_CLABEL_NA);
+					assert(!iscc_bitset_test(assigned, (size_t) batch_indices[i]));
+					clustering->cluster_label[batch_indices[i]] = clustering->cluster_label[*check_indices];
 				}
 			}
-			check_indices = stop_check_indices;
-		} // Loop in batch
-	} // Loop between batches
+		}
+		check_indices = stop_check_indices;
+	}
+
+	return iscc_no_error();
+}
+
 
+static scc_ErrorCode iscc_finish_nng_batches(scc_Clustering* const clustering,
+                                             const bool search_done,
+                                             const scc_Clabel next_cluster_label)
+{
 	if (next_cluster_label == 0) {
 		if (!search_done) {
 			// Never did search, i.e., primary_data_points are all false
-			assert(primary_data_points != NULL);
 			return iscc_make_error_msg(SCC_ER_NO_SOLUTION, "No primary data points.");
 		} else {
 			// Did search but still no clusters, i.e., too tight radius constraint
-			assert(radius_constraint);
 			return iscc_make_error_msg(SCC_ER_NO_SOLUTION, "Infeasible radius constraint.");
 		}
 	}
@@ -39,7 +39,8 @@ scc_ErrorCode scc_nng_clustering_batches(scc_Clustering* clustering,
                                          double radius,
                                          size_t len_primary_data_points,
                                          const scc_PointIndex primary_data_points[],
-                                         uint32_t batch_size);
+                                         uint32_t batch_size,
+                                         uint32_t num_threads);
 
 
 #endif // ifndef SCC_BATCH_CLUSTERING_HG
@@ -42,7 +42,8 @@
 static scc_ErrorCode iscc_make_clustering_from_nng(scc_Clustering* clustering,
                                                    void* data_set,
                                                    iscc_Digraph* nng,
-                                                   const scc_ClusterOptions* options);
+                                                   const scc_ClusterOptions* options,
+                                                   iscc_NNSearchObject* shared_search_object);
 
 
 // =============================================================================
@@ -79,7 +80,19 @@ scc_ErrorCode scc_sc_clustering(void* const data_set,
 		                                  options->seed_supplied_radius,
 		                                  options->len_primary_data_points,
 		                                  options->primary_data_points,
-		                                  options->batch_size);
+		                                  options->batch_size,
+		                                  options->num_threads);
+	}
+
+	// Use one search object for all phases when subsets can be searched with filters
+	iscc_NNSearchObject* shared_search_object = NULL;
+	if (iscc_nn_search_supports_filter(data_set)) {
+		if (!iscc_init_nn_search_object(data_set,
+		                                out_clustering->num_data_points,
+		                                NULL,
+		                                &shared_search_object)) {
+			return iscc_make_error(SCC_ER_DIST_SEARCH_ERROR);
+		}
 	}
 
 	iscc_Digraph nng;
@@ -91,7 +104,10 @@ scc_ErrorCode scc_sc_clustering(void* const data_set,
 		                                            options->primary_data_points,
 		                                            (options->seed_radius == SCC_RM_USE_SUPPLIED),
 		                                            options->seed_supplied_radius,
+		                                            options->num_threads,
+		                                            shared_search_object,
 		                                            &nng)) != SCC_ER_OK) {
+			if (shared_search_object != NULL) iscc_close_nn_search_object(data_set, &shared_search_object);
 			return ec;
 		}
 	} else {
@@ -106,19 +122,34 @@ scc_ErrorCode scc_sc_clustering(void* const data_set,
 		                                            options->primary_data_points,
 		                                            (options->seed_radius == SCC_RM_USE_SUPPLIED),
 		                                            options->seed_supplied_radius,
+		                                            options->num_threads,
+		                                            shared_search_object,
 		                                            &nng)) != SCC_ER_OK) {
+			if (shared_search_object != NULL) iscc_close_nn_search_object(data_set, &shared_search_object);
 			return ec;
 		}
 	}
 
 	assert(!iscc_digraph_is_empty(&nng));
 
+	if (options->compress_digraphs && ((ec = iscc_digraph_compress(&nng)) != SCC_ER_OK)) {
+		iscc_free_digraph(&nng);
+		if (shared_search_object != NULL) iscc_close_nn_search_object(data_set, &shared_search_object);
+		return ec;
+	}
+
 	ec = iscc_make_clustering_from_nng(out_clustering,
 	                                   data_set,
 	                                   &nng,
-	                                   options);
+	                                   options,
+	                                   shared_search_object);
 
 	iscc_free_digraph(&nng);
+	if ((shared_search_object != NULL) &&
+	        !iscc_close_nn_search_object(data_set, &shared_search_object) &&
+	        (ec == SCC_ER_OK)) {
+		ec = iscc_make_error(SCC_ER_DIST_SEARCH_ERROR);
+	}
 
 	return ec;
 }
@@ -131,7 +162,8 @@ scc_ErrorCode scc_sc_clustering(void* const data_set,
 static scc_ErrorCode iscc_make_clustering_from_nng(scc_Clustering* const clustering,
                                                    void* const data_set,
                                                    iscc_Digraph* const nng,
-                                                   const scc_ClusterOptions* options)
+                                                   const scc_ClusterOptions* options,
+                                                   iscc_NNSearchObject* const shared_search_object)
 {
 	assert(iscc_check_input_clustering(clustering));
 	assert(iscc_check_data_set(data_set));
@@ -146,7 +178,7 @@ static scc_ErrorCode iscc_make_clustering_from_nng(scc_Clustering* const cluster
 	};
 
 	scc_ErrorCode ec;
-	if ((ec = iscc_find_seeds(nng, options->seed_method, &seed_result)) != SCC_ER_OK) {
+	if ((ec = iscc_find_seeds(nng, options->seed_method, options->num_threads, &seed_result)) != SCC_ER_OK) {
 		return ec;
 	}
 
@@ -216,7 +248,7 @@ static scc_ErrorCode iscc_make_clustering_from_nng(scc_Clustering* const cluster
 	                                       data_set,
 	                                       &seed_result,
 	                                       nng,
-	                                       (options->num_types < 2),
+	                                       (options->num_types < 2) && !iscc_digraph_is_compressed(nng), // Compressed rows are sorted by ID
 	                                       options->primary_unassigned_method,
 	                                       (primary_radius == SCC_RM_USE_SUPPLIED),
 	                                       primary_supplied_radius,
@@ -224,7 +256,8 @@ static scc_ErrorCode iscc_make_clustering_from_nng(scc_Clustering* const cluster
 	                                       options->primary_data_points,
 	                                       options->secondary_unassigned_method,
 	                                       (secondary_radius == SCC_RM_USE_SUPPLIED),
-	                                       secondary_supplied_radius);
+	                                       secondary_supplied_radius,
+	                                       shared_search_object);
 
 	free(seed_result.seeds);
 	return ec;
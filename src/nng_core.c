@@ -21,12 +21,14 @@
 #include "nng_core.h"
 
 #include <assert.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include "../include/scclust.h"
+#include "bitset.h"
 #include "clustering_struct.h"
 #include "digraph_core.h"
 #include "digraph_operations.h"
@@ -35,6 +37,10 @@
 #include "nng_findseeds.h"
 #include "scclust_types.h"
 
+#ifdef _OPENMP
+	#include <omp.h>
+#endif // ifdef _OPENMP
+
 
 // =============================================================================
 // Internal structs & variables
@@ -48,8 +54,24 @@ typedef struct iscc_TypeCount {
 } iscc_TypeCount;
 
 
+// Search for unassigned points, either with its own search object or with a subset
+// of the shared search object
+typedef struct iscc_AssignSearch {
+	iscc_NNSearchObject* nn_search_object;
+	iscc_SearchSubset* search_subset;
+	scc_PointIndex* search_indices;
+	scc_PointIndex* search_ranks;
+} iscc_AssignSearch;
+
+
 static const size_t ISCC_ESTIMATE_AVG_MAX_SAMPLE = 1000;
 
+// Smallest number of queries in each chunk when the nearest neighbor search is split
+static const size_t ISCC_NNG_MIN_QUERY_CHUNK = 16;
+
+// Number of chunks per thread, so that threads that finish early can take more work
+static const size_t ISCC_NNG_CHUNKS_PER_THREAD = 4;
+
 
 // =============================================================================
 // Static function prototypes
@@ -59,28 +81,64 @@ static scc_ErrorCode iscc_make_nng(void* data_set,
                                    size_t num_data_points,
                                    size_t len_search_indices,
                                    const scc_PointIndex search_indices[],
+                                   iscc_NNSearchObject* shared_search_object,
+                                   const iscc_SearchSubset* search_subset,
                                    size_t len_query_indices,
                                    const scc_PointIndex query_indices[],
                                    uint32_t k,
                                    bool radius_search,
                                    double radius,
+                                   uint32_t num_threads,
                                    size_t* out_len_query_indices,
                                    scc_PointIndex out_query_indices[],
                                    iscc_Digraph* out_nng);
 
 
-static scc_ErrorCode iscc_make_nng_from_search_object(iscc_NNSearchObject* nn_search_object,
+static scc_ErrorCode iscc_make_nng_from_search_object(void* data_set,
+                                                      iscc_NNSearchObject* nn_search_object,
+                                                      const iscc_SearchSubset* search_subset,
                                                       size_t num_data_points,
                                                       size_t len_query_indices,
                                                       const scc_PointIndex query_indices[],
                                                       uint32_t k,
                                                       bool radius_search,
                                                       double radius,
+                                                      uint32_t num_threads,
                                                       size_t* out_len_query_indices,
                                                       scc_PointIndex out_query_indices[],
                                                       iscc_Digraph* out_nng);
 
 
+static scc_ErrorCode iscc_make_typed_nng(void* data_set,
+                                         size_t num_data_points,
+                                         uint32_t size_constraint,
+                                         uint_fast16_t num_types,
+                                         const uint32_t type_constraints[],
+                                         const scc_TypeLabel type_labels[],
+                                         size_t len_primary_data_points,
+                                         const scc_PointIndex primary_data_points[],
+                                         bool radius_constraint,
+                                         double radius,
+                                         uint32_t num_threads,
+                                         iscc_NNSearchObject* shared_search_object,
+                                         iscc_Digraph* out_nng);
+
+
+static scc_ErrorCode iscc_chunked_nn_search(void* data_set,
+                                            iscc_NNSearchObject* nn_search_object,
+                                            const iscc_SearchSubset* search_subset,
+                                            const iscc_TypedNNQuery* typed_query,
+                                            size_t len_query_indices,
+                                            const scc_PointIndex query_indices[],
+                                            uint32_t k,
+                                            bool radius_search,
+                                            double radius,
+                                            uint32_t num_threads,
+                                            size_t* out_num_ok_queries,
+                                            scc_PointIndex out_query_indices[],
+                                            scc_PointIndex out_nn_indices[]);
+
+
 static inline void iscc_ensure_self_match(iscc_Digraph* nng,
                                           size_t len_search_indices,
                                           const scc_PointIndex search_indices[]);
@@ -96,15 +154,32 @@ static scc_ErrorCode iscc_type_count(size_t num_data_points,
 
 static size_t iscc_assign_seeds_and_neighbors(scc_Clustering* clustering,
                                               const iscc_SeedResult* seed_result,
-                                              iscc_Digraph* nng);
+                                              iscc_Digraph* nng,
+                                              iscc_DigraphRowReader* nng_reader);
 
 
 static size_t iscc_assign_by_nng(scc_Clustering* clustering,
-                                 iscc_Digraph* nng);
+                                 iscc_Digraph* nng,
+                                 iscc_DigraphRowReader* nng_reader);
+
+
+static scc_ErrorCode iscc_init_assign_search(void* data_set,
+                                             size_t num_data_points,
+                                             size_t len_search_points,
+                                             const scc_PointIndex search_points[static len_search_points],
+                                             iscc_NNSearchObject* shared_search_object,
+                                             iscc_AssignSearch* out_assign_search);
+
+
+static void iscc_close_assign_search(void* data_set,
+                                     iscc_NNSearchObject* shared_search_object,
+                                     iscc_AssignSearch* assign_search);
 
 
 static scc_ErrorCode iscc_assign_by_nn_search(scc_Clustering* clustering,
+                                              void* data_set,
                                               iscc_NNSearchObject* nn_search_object,
+                                              const iscc_SearchSubset* search_subset,
                                               size_t num_to_assign,
                                               scc_PointIndex to_assign[restrict static num_to_assign],
                                               bool radius_constraint,
@@ -129,6 +204,8 @@ scc_ErrorCode iscc_get_nng_with_size_constraint(void* const data_set,
                                                 const scc_PointIndex primary_data_points[],
                                                 const bool radius_constraint,
                                                 const double radius,
+                                                const uint32_t num_threads,
+                                                iscc_NNSearchObject* const shared_search_object,
                                                 iscc_Digraph* const out_nng)
 {
 	assert(iscc_check_data_set(data_set));
@@ -151,11 +228,14 @@ scc_ErrorCode iscc_get_nng_with_size_constraint(void* const data_set,
 	                        num_data_points,
 	                        num_data_points,
 	                        NULL,
+	                        shared_search_object,
+	                        NULL,
 	                        num_queries,
 	                        primary_data_points,
 	                        size_constraint,
 	                        radius_constraint,
 	                        radius,
+	                        num_threads,
 	                        NULL,
 	                        NULL,
 	                        out_nng)) != SCC_ER_OK) {
@@ -192,6 +272,8 @@ scc_ErrorCode iscc_get_nng_with_type_constraint(void* const data_set,
                                                 const scc_PointIndex primary_data_points[],
                                                 const bool radius_constraint,
                                                 const double radius,
+                                                const uint32_t num_threads,
+                                                iscc_NNSearchObject* const shared_search_object,
                                                 iscc_Digraph* const out_nng)
 {
 	assert(iscc_check_data_set(data_set));
@@ -206,6 +288,25 @@ scc_ErrorCode iscc_get_nng_with_type_constraint(void* const data_set,
 	assert(!radius_constraint || (radius > 0.0));
 	assert(out_nng != NULL);
 
+	if (iscc_nn_search_supports_types(data_set)) {
+		return iscc_make_typed_nng(data_set,
+		                           num_data_points,
+		                           size_constraint,
+		                           num_types,
+		                           type_constraints,
+		                           type_labels,
+		                           len_primary_data_points,
+		                           primary_data_points,
+		                           radius_constraint,
+		                           radius,
+		                           num_threads,
+		                           shared_search_object,
+		                           out_nng);
+	}
+
+	// Custom search functions: one search per type, and one over all points for the remaining size constraint.
+	// Search objects are only shared when filtered searches are supported, which implies typed searches.
+	assert(shared_search_object == NULL);
 	size_t num_queries;
 	if (primary_data_points == NULL) {
 		num_queries = num_data_points;
@@ -257,11 +358,14 @@ scc_ErrorCode iscc_get_nng_with_type_constraint(void* const data_set,
 			                        num_data_points,
 			                        tc.type_group_size[i],
 			                        tc.type_groups[i],
+			                        NULL,
+			                        NULL,
 			                        num_queries,
 			                        seedable_const,
 			                        type_constraints[i],
 			                        radius_constraint,
 			                        radius,
+			                        num_threads,
 			                        &num_queries,
 			                        seedable,
 			                        &nng_by_type[num_non_zero_type_constraints])) != SCC_ER_OK) {
@@ -285,9 +389,9 @@ scc_ErrorCode iscc_get_nng_with_type_constraint(void* const data_set,
 	if (ec == SCC_ER_OK) {
 		if (size_constraint > tc.sum_type_constraints) {
 			// If general size constaint (besides type constraints), we need to keep self-loops
-			ec = iscc_digraph_union_and_delete(num_non_zero_type_constraints, nng_by_type, num_queries, seedable_const, true, out_nng);
+			ec = iscc_digraph_union_and_delete(num_non_zero_type_constraints, nng_by_type, num_queries, seedable_const, true, num_threads, out_nng);
 		} else {
-			ec = iscc_digraph_union_and_delete(num_non_zero_type_constraints, nng_by_type, num_queries, seedable_const, false, out_nng);
+			ec = iscc_digraph_union_and_delete(num_non_zero_type_constraints, nng_by_type, num_queries, seedable_const, false, num_threads, out_nng);
 		}
 	}
 
@@ -311,11 +415,14 @@ scc_ErrorCode iscc_get_nng_with_type_constraint(void* const data_set,
 		                        num_data_points,
 		                        num_data_points,
 		                        NULL,
+		                        NULL,
+		                        NULL,
 		                        num_queries,
 		                        seedable_const,
 		                        size_constraint,
 		                        radius_constraint,
 		                        radius,
+		                        num_threads,
 		                        &num_queries,
 		                        seedable,
 		                        &nng_sum[1])) != SCC_ER_OK) {
@@ -331,7 +438,7 @@ scc_ErrorCode iscc_get_nng_with_type_constraint(void* const data_set,
 		}
 
 		if (ec == SCC_ER_OK) {
-			ec = iscc_digraph_union_and_delete(2, nng_sum, num_queries, seedable_const, false, out_nng);
+			ec = iscc_digraph_union_and_delete(2, nng_sum, num_queries, seedable_const, false, num_threads, out_nng);
 		}
 
 		iscc_free_digraph(&nng_sum[0]);
@@ -373,13 +480,19 @@ scc_ErrorCode iscc_estimate_avg_seed_dist(void* const data_set,
 
 	size_t sampled = 0;
 	double sum_dist = 0.0;
+	iscc_DigraphRowReader reader;
+	scc_ErrorCode ec;
+	if ((ec = iscc_init_row_reader(nng, &reader)) != SCC_ER_OK) return ec;
 	double* const dist_scratch = malloc(sizeof(double[size_constraint]));
-	if (dist_scratch == NULL) return iscc_make_error(SCC_ER_NO_MEMORY);
+	if (dist_scratch == NULL) {
+		iscc_free_row_reader(&reader);
+		return iscc_make_error(SCC_ER_NO_MEMORY);
+	}
 
 	for (size_t s = 0; s < seed_result->count; s += step) {
 		const scc_PointIndex seed = seed_result->seeds[s];
-		const size_t num_neighbors = (nng->tail_ptr[seed + 1] - nng->tail_ptr[seed]);
-		const scc_PointIndex* const neighbors = nng->head + nng->tail_ptr[seed];
+		size_t num_neighbors;
+		const scc_PointIndex* const neighbors = iscc_digraph_read_row(nng, (size_t) seed, &reader, &num_neighbors);
 
 		// Either zero or one self-loops
 		assert((num_neighbors == size_constraint) ||
@@ -391,6 +504,7 @@ scc_ErrorCode iscc_estimate_avg_seed_dist(void* const data_set,
 		                        num_neighbors,
 		                        neighbors,
 		                        dist_scratch)) {
+			iscc_free_row_reader(&reader);
 			free(dist_scratch);
 			return iscc_make_error(SCC_ER_DIST_SEARCH_ERROR);
 		}
@@ -410,6 +524,7 @@ scc_ErrorCode iscc_estimate_avg_seed_dist(void* const data_set,
 		sum_dist += tmp_dist / ((double) num_non_self_loops);
 	}
 
+	iscc_free_row_reader(&reader);
 	free(dist_scratch);
 
 	*out_avg_seed_dist = sum_dist / ((double) sampled);
@@ -430,7 +545,8 @@ scc_ErrorCode iscc_make_nng_clusters_from_seeds(scc_Clustering* const clustering
                                                 const scc_PointIndex primary_data_points[],
                                                 scc_UnassignedMethod secondary_unassigned_method,
                                                 const bool secondary_radius_constraint,
-                                                const double secondary_radius)
+                                                const double secondary_radius,
+                                                iscc_NNSearchObject* const shared_search_object)
 {
 	assert(iscc_check_input_clustering(clustering));
 	assert(iscc_check_data_set(data_set));
@@ -449,13 +565,18 @@ scc_ErrorCode iscc_make_nng_clusters_from_seeds(scc_Clustering* const clustering
 	       (secondary_unassigned_method == SCC_UM_CLOSEST_SEED));
 	assert(!secondary_radius_constraint || (secondary_radius > 0.0));
 
+	scc_ErrorCode ec;
+	iscc_DigraphRowReader nng_reader;
+	if ((ec = iscc_init_row_reader(nng, &nng_reader)) != SCC_ER_OK) return ec;
+
 	// Assign seeds and their neighbors
-	const size_t num_assigned_as_seed_or_neighbor = iscc_assign_seeds_and_neighbors(clustering, seed_result, nng);
+	const size_t num_assigned_as_seed_or_neighbor = iscc_assign_seeds_and_neighbors(clustering, seed_result, nng, &nng_reader);
 	size_t total_assigned = num_assigned_as_seed_or_neighbor;
 
 	// Are we done?
 	if ((total_assigned == clustering->num_data_points) ||
 	        ((unassigned_method == SCC_UM_IGNORE) && (secondary_unassigned_method == SCC_UM_IGNORE))) {
+		iscc_free_row_reader(&nng_reader);
 		return iscc_no_error();
 	}
 
@@ -464,7 +585,10 @@ scc_ErrorCode iscc_make_nng_clusters_from_seeds(scc_Clustering* const clustering
 	if ((unassigned_method == SCC_UM_CLOSEST_ASSIGNED) ||
 	        (secondary_unassigned_method == SCC_UM_CLOSEST_ASSIGNED)) {
 		seed_or_neighbor = malloc(sizeof(scc_PointIndex[num_assigned_as_seed_or_neighbor]));
-		if (seed_or_neighbor == NULL) return iscc_make_error(SCC_ER_NO_MEMORY);
+		if (seed_or_neighbor == NULL) {
+			iscc_free_row_reader(&nng_reader);
+			return iscc_make_error(SCC_ER_NO_MEMORY);
+		}
 
 		scc_PointIndex* write_seed_or_neighbor = seed_or_neighbor;
 		assert(clustering->num_data_points <= ISCC_POINTINDEX_MAX);
@@ -482,7 +606,7 @@ scc_ErrorCode iscc_make_nng_clusters_from_seeds(scc_Clustering* const clustering
 	// (NNG already contains radius constraint.)
 	if ((unassigned_method == SCC_UM_ANY_NEIGHBOR) ||
 	        (nng_is_ordered && (unassigned_method == SCC_UM_CLOSEST_ASSIGNED))) {
-		total_assigned += iscc_assign_by_nng(clustering, nng);
+		total_assigned += iscc_assign_by_nng(clustering, nng, &nng_reader);
 
 		// Ignore remaining points if SCC_UM_ANY_NEIGHBOR
 		if (unassigned_method == SCC_UM_ANY_NEIGHBOR) {
@@ -492,65 +616,55 @@ scc_ErrorCode iscc_make_nng_clusters_from_seeds(scc_Clustering* const clustering
 		// Are we done?
 		if ((total_assigned == clustering->num_data_points) ||
 		        ((unassigned_method == SCC_UM_IGNORE) && (secondary_unassigned_method == SCC_UM_IGNORE))) {
+			iscc_free_row_reader(&nng_reader);
 			free(seed_or_neighbor);
 			return iscc_no_error();
 		}
 	}
 
 	// No need for nng any more
+	iscc_free_row_reader(&nng_reader);
 	iscc_free_digraph(nng);
-
-	scc_ErrorCode ec = SCC_ER_OK;
-	iscc_NNSearchObject* nn_assigned_search_object = NULL;
-	iscc_NNSearchObject* nn_seed_search_object = NULL;
+	iscc_AssignSearch assigned_search = { NULL, NULL, NULL, NULL };
+	iscc_AssignSearch seed_search = { NULL, NULL, NULL, NULL };
 
 	if ((unassigned_method == SCC_UM_CLOSEST_ASSIGNED) ||
 	        (secondary_unassigned_method == SCC_UM_CLOSEST_ASSIGNED)) {
 		assert(seed_or_neighbor != NULL);
-		if (!iscc_init_nn_search_object(data_set,
-		                                num_assigned_as_seed_or_neighbor,
-		                                seed_or_neighbor,
-		                                &nn_assigned_search_object)) {
-			ec = iscc_make_error(SCC_ER_DIST_SEARCH_ERROR);
-		}
+		ec = iscc_init_assign_search(data_set,
+		                             clustering->num_data_points,
+		                             num_assigned_as_seed_or_neighbor,
+		                             seed_or_neighbor,
+		                             shared_search_object,
+		                             &assigned_search);
 	}
 
-	if (ec != SCC_ER_OK) {
-		free(seed_or_neighbor);
-		return ec;
+	if ((ec == SCC_ER_OK) &&
+	        ((unassigned_method == SCC_UM_CLOSEST_SEED) ||
+	         (secondary_unassigned_method == SCC_UM_CLOSEST_SEED))) {
+		ec = iscc_init_assign_search(data_set,
+		                             clustering->num_data_points,
+		                             seed_result->count,
+		                             seed_result->seeds,
+		                             shared_search_object,
+		                             &seed_search);
 	}
 
-	if ((unassigned_method == SCC_UM_CLOSEST_SEED) ||
-	        (secondary_unassigned_method == SCC_UM_CLOSEST_SEED)) {
-		if (!iscc_init_nn_search_object(data_set,
-		                                seed_result->count,
-		                                seed_result->seeds,
-		                                &nn_seed_search_object)) {
-			ec = iscc_make_error(SCC_ER_DIST_SEARCH_ERROR);
-		}
+	free(seed_or_neighbor);
+
+	size_t num_to_assign = 0;
+	scc_PointIndex* to_assign = NULL;
+	if (ec == SCC_ER_OK) {
+		to_assign = malloc(sizeof(scc_PointIndex[clustering->num_data_points - total_assigned + 1]));
+		if (to_assign == NULL) ec = iscc_make_error(SCC_ER_NO_MEMORY);
 	}
 
 	if (ec != SCC_ER_OK) {
-		free(seed_or_neighbor);
-		if (nn_assigned_search_object != NULL) {
-			iscc_close_nn_search_object(&nn_assigned_search_object);
-		}
+		iscc_close_assign_search(data_set, shared_search_object, &assigned_search);
+		iscc_close_assign_search(data_set, shared_search_object, &seed_search);
 		return ec;
 	}
 
-	size_t num_to_assign = 0;
-	scc_PointIndex* const to_assign = malloc(sizeof(scc_PointIndex[clustering->num_data_points - total_assigned + 1]));
-	if (to_assign == NULL) {
-		free(seed_or_neighbor);
-		if (nn_assigned_search_object != NULL) {
-			iscc_close_nn_search_object(&nn_assigned_search_object);
-		}
-		if (nn_seed_search_object != NULL) {
-			iscc_close_nn_search_object(&nn_seed_search_object);
-		}
-		return iscc_make_error(SCC_ER_NO_MEMORY);
-	}
-
 	if (primary_data_points != NULL) {
 		for (size_t i = 0; i < len_primary_data_points; ++i) {
 			to_assign[num_to_assign] = primary_data_points[i];
@@ -567,14 +681,18 @@ scc_ErrorCode iscc_make_nng_clusters_from_seeds(scc_Clustering* const clustering
 	if (num_to_assign > 0) {
 		if (unassigned_method == SCC_UM_CLOSEST_ASSIGNED) {
 			ec = iscc_assign_by_nn_search(clustering,
-			                              nn_assigned_search_object,
+			                              data_set,
+			                              assigned_search.nn_search_object,
+			                              assigned_search.search_subset,
 			                              num_to_assign,
 			                              to_assign,
 			                              radius_constraint,
 			                              radius);
 		} else if (unassigned_method == SCC_UM_CLOSEST_SEED) {
 			ec = iscc_assign_by_nn_search(clustering,
-			                              nn_seed_search_object,
+			                              data_set,
+			                              seed_search.nn_search_object,
+			                              seed_search.search_subset,
 			                              num_to_assign,
 			                              to_assign,
 			                              radius_constraint,
@@ -582,19 +700,7 @@ scc_ErrorCode iscc_make_nng_clusters_from_seeds(scc_Clustering* const clustering
 		}
 	}
 
-	if (ec != SCC_ER_OK) {
-		free(seed_or_neighbor);
-		free(to_assign);
-		if (nn_assigned_search_object != NULL) {
-			iscc_close_nn_search_object(&nn_assigned_search_object);
-		}
-		if (nn_seed_search_object != NULL) {
-			iscc_close_nn_search_object(&nn_seed_search_object);
-		}
-		return ec;
-	}
-
-	if (secondary_unassigned_method != SCC_UM_IGNORE) {
+	if ((ec == SCC_ER_OK) && (secondary_unassigned_method != SCC_UM_IGNORE)) {
 		size_t num_to_assign = 0;
 		const scc_PointIndex num_data_points_pi = (scc_PointIndex) clustering->num_data_points;
 		for (scc_PointIndex i = 0; i < num_data_points_pi; ++i) {
@@ -605,14 +711,18 @@ scc_ErrorCode iscc_make_nng_clusters_from_seeds(scc_Clustering* const clustering
 		if (num_to_assign > 0) {
 			if (secondary_unassigned_method == SCC_UM_CLOSEST_ASSIGNED) {
 				ec = iscc_assign_by_nn_search(clustering,
-				                              nn_assigned_search_object,
+				                              data_set,
+				                              assigned_search.nn_search_object,
+				                              assigned_search.search_subset,
 				                              num_to_assign,
 				                              to_assign,
 				                              secondary_radius_constraint,
 				                              secondary_radius);
 			} else if (secondary_unassigned_method == SCC_UM_CLOSEST_SEED) {
 				ec = iscc_assign_by_nn_search(clustering,
-				                              nn_seed_search_object,
+				                              data_set,
+				                              seed_search.nn_search_object,
+				                              seed_search.search_subset,
 				                              num_to_assign,
 				                              to_assign,
 				                              secondary_radius_constraint,
@@ -621,16 +731,11 @@ scc_ErrorCode iscc_make_nng_clusters_from_seeds(scc_Clustering* const clustering
 		}
 	}
 
-	free(seed_or_neighbor);
 	free(to_assign);
-	if (nn_assigned_search_object != NULL) {
-		iscc_close_nn_search_object(&nn_assigned_search_object);
-	}
-	if (nn_seed_search_object != NULL) {
-		iscc_close_nn_search_object(&nn_seed_search_object);
-	}
+	iscc_close_assign_search(data_set, shared_search_object, &assigned_search);
+	iscc_close_assign_search(data_set, shared_search_object, &seed_search);
 
-	return iscc_no_error();
+	return ec;
 }
 
 
@@ -642,11 +747,14 @@ static scc_ErrorCode iscc_make_nng(void* const data_set,
                                    const size_t num_data_points,
                                    const size_t len_search_indices,
                                    const scc_PointIndex search_indices[const],
+                                   iscc_NNSearchObject* const shared_search_object,
+                                   const iscc_SearchSubset* const search_subset,
                                    const size_t len_query_indices,
                                    const scc_PointIndex query_indices[const],
                                    const uint32_t k,
                                    const bool radius_search,
                                    const double radius,
+                                   const uint32_t num_threads,
                                    size_t* const out_len_query_indices,
                                    scc_PointIndex out_query_indices[const],
                                    iscc_Digraph* const out_nng)
@@ -659,6 +767,23 @@ static scc_ErrorCode iscc_make_nng(void* const data_set,
 	assert(!radius_search || (radius > 0.0));
 	assert(out_nng != NULL);
 
+	// The shared search object covers all points, `search_subset` picks out the search points
+	if (shared_search_object != NULL) {
+		return iscc_make_nng_from_search_object(data_set,
+		                                        shared_search_object,
+		                                        search_subset,
+		                                        num_data_points,
+		                                        len_query_indices,
+		                                        query_indices,
+		                                        k,
+		                                        radius_search,
+		                                        radius,
+		                                        num_threads,
+		                                        out_len_query_indices,
+		                                        out_query_indices,
+		                                        out_nng);
+	}
+
 	iscc_NNSearchObject* nn_search_object;
 	if (!iscc_init_nn_search_object(data_set,
 	                                len_search_indices,
@@ -668,21 +793,24 @@ static scc_ErrorCode iscc_make_nng(void* const data_set,
 	}
 
 	scc_ErrorCode ec;
-	if ((ec = iscc_make_nng_from_search_object(nn_search_object,
+	if ((ec = iscc_make_nng_from_search_object(data_set,
+	                                           nn_search_object,
+	                                           NULL,
 	                                           num_data_points,
 	                                           len_query_indices,
 	                                           query_indices,
 	                                           k,
 	                                           radius_search,
 	                                           radius,
+	                                           num_threads,
 	                                           out_len_query_indices,
 	                                           out_query_indices,
 	                                           out_nng)) != SCC_ER_OK) {
-		iscc_close_nn_search_object(&nn_search_object);
+		iscc_close_nn_search_object(data_set, &nn_search_object);
 		return ec;
 	}
 
-	if (!iscc_close_nn_search_object(&nn_search_object)) {
+	if (!iscc_close_nn_search_object(data_set, &nn_search_object)) {
 		iscc_free_digraph(out_nng);
 		return iscc_make_error(SCC_ER_DIST_SEARCH_ERROR);
 	}
@@ -691,13 +819,16 @@ static scc_ErrorCode iscc_make_nng(void* const data_set,
 }
 
 
-static scc_ErrorCode iscc_make_nng_from_search_object(iscc_NNSearchObject* const nn_search_object,
+static scc_ErrorCode iscc_make_nng_from_search_object(void* const data_set,
+                                                      iscc_NNSearchObject* const nn_search_object,
+                                                      const iscc_SearchSubset* const search_subset,
                                                       const size_t num_data_points,
                                                       const size_t len_query_indices,
                                                       const scc_PointIndex query_indices[const],
                                                       const uint32_t k,
                                                       const bool radius_search,
                                                       const double radius,
+                                                      const uint32_t num_threads,
                                                       size_t* const out_len_query_indices,
                                                       scc_PointIndex out_query_indices[const],
                                                       iscc_Digraph* const out_nng)
@@ -721,67 +852,61 @@ static scc_ErrorCode iscc_make_nng_from_search_object(iscc_NNSearchObject* const
 		}
 	}
 
+	// Each ok query has exactly `k` arcs, so the NNG is stored in fixed-degree format
+	const bool all_tails = !radius_search && (query_indices == NULL) && (len_query_indices == num_data_points);
+
 	scc_ErrorCode ec;
-	if ((ec = iscc_init_digraph(num_data_points,
-	                            len_query_indices * k,
-	                            out_nng)) != SCC_ER_OK) {
+	if ((ec = iscc_init_fixed_digraph(num_data_points,
+	                                  k,
+	                                  all_tails,
+	                                  len_query_indices * k,
+	                                  out_nng)) != SCC_ER_OK) {
 		free(internal_out_query_indices);
 		return ec;
 	}
 
 	size_t num_ok_queries = 0;
-	if (!iscc_nearest_neighbor_search(nn_search_object,
-	                                  len_query_indices,
-	                                  query_indices,
-	                                  k,
-	                                  radius_search,
-	                                  radius,
-	                                  &num_ok_queries,
-	                                  dist_out_query_indices,
-	                                  out_nng->head)) {
+	if ((ec = iscc_chunked_nn_search(data_set,
+	                                 nn_search_object,
+	                                 search_subset,
+	                                 NULL,
+	                                 len_query_indices,
+	                                 query_indices,
+	                                 k,
+	                                 radius_search,
+	                                 radius,
+	                                 num_threads,
+	                                 &num_ok_queries,
+	                                 dist_out_query_indices,
+	                                 out_nng->head)) != SCC_ER_OK) {
 		free(internal_out_query_indices);
 		iscc_free_digraph(out_nng);
-		return iscc_make_error(SCC_ER_DIST_SEARCH_ERROR);
+		return ec;
 	}
 
-	iscc_ArcIndex* write_tail_ptr = out_nng->tail_ptr;
-	*write_tail_ptr = 0;
-	++write_tail_ptr;
-	const iscc_ArcIndex* const write_tail_ptr_stop = write_tail_ptr + num_data_points;
+	if (!all_tails) {
+		if (radius_search || query_indices != NULL) {
+			const scc_PointIndex* ok_q;
+			if (radius_search) {
+				assert(dist_out_query_indices != NULL);
+				ok_q = dist_out_query_indices;
+			} else {
+				assert(len_query_indices == num_ok_queries);
+				assert(query_indices != NULL);
+				ok_q = query_indices;
+			}
 
-	if (radius_search || query_indices != NULL) {
-		const scc_PointIndex* ok_q;
-		if (radius_search) {
-			assert(dist_out_query_indices != NULL);
-			ok_q = dist_out_query_indices;
+			const scc_PointIndex* const ok_q_stop = ok_q + num_ok_queries;
+			for (; ok_q < ok_q_stop; ++ok_q) {
+				iscc_bitset_set(out_nng->valid_tails, (size_t) *ok_q);
+			}
 		} else {
 			assert(len_query_indices == num_ok_queries);
-			assert(query_indices != NULL);
-			ok_q = query_indices;
-		}
-
-		scc_PointIndex i = 0;
-		const scc_PointIndex* const ok_q_stop = ok_q + num_ok_queries;
-		for (; ok_q < ok_q_stop; ++ok_q) {
-			for (; i < *ok_q; ++i) {
-				*write_tail_ptr = *(write_tail_ptr - 1);
-				++write_tail_ptr;
+			for (size_t q = 0; q < len_query_indices; ++q) {
+				iscc_bitset_set(out_nng->valid_tails, q);
 			}
-			*write_tail_ptr = *(write_tail_ptr - 1) + k;
-			++write_tail_ptr;
-			++i;
-		}
-	} else {
-		assert(!radius_search && query_indices == NULL);
-		assert(len_query_indices == num_ok_queries);
-		for (size_t q = 0; q < len_query_indices; ++q) {
-			*write_tail_ptr = *(write_tail_ptr - 1) + k;
-			++write_tail_ptr;
 		}
-	}
-
-	for (; write_tail_ptr < write_tail_ptr_stop; ++write_tail_ptr) {
-		*write_tail_ptr = *(write_tail_ptr - 1);
+		iscc_rank_fixed_digraph(out_nng);
 	}
 
 	if (internal_out_query_indices != NULL) {
@@ -806,6 +931,355 @@ static scc_ErrorCode iscc_make_nng_from_search_object(iscc_NNSearchObject* const
 }
 
 
+static scc_ErrorCode iscc_make_typed_nng(void* const data_set,
+                                         const size_t num_data_points,
+                                         const uint32_t size_constraint,
+                                         const uint_fast16_t num_types,
+                                         const uint32_t type_constraints[const],
+                                         const scc_TypeLabel type_labels[const],
+                                         const size_t len_primary_data_points,
+                                         const scc_PointIndex primary_data_points[const],
+                                         const bool radius_constraint,
+                                         const double radius,
+                                         const uint32_t num_threads,
+                                         iscc_NNSearchObject* const shared_search_object,
+                                         iscc_Digraph* const out_nng)
+{
+	assert(iscc_nn_search_supports_types(data_set));
+	assert(out_nng != NULL);
+
+	/* Each query's row holds its `type_constraints[t]` nearest neighbors of each type `t`,
+	 * followed by its nearest neighbors of any type not already in the row until the row
+	 * has `size_constraint` neighbors. Self-loops are then removed. The typed search breaks
+	 * ties within a type by latest point index, the order of the type groups from
+	 * `iscc_type_count`, and among all types by earliest point index. This is the same NNG as
+	 * searching each type separately and taking unions and differences of the results. */
+
+	scc_ErrorCode ec;
+	iscc_TypeCount tc;
+	if ((ec = iscc_type_count(num_data_points,
+	                          size_constraint,
+	                          num_types,
+	                          type_constraints,
+	                          type_labels,
+	                          &tc)) != SCC_ER_OK) {
+		return ec;
+	}
+	free(tc.type_group_size);
+	free(tc.point_store);
+	free(tc.type_groups);
+
+	const uint32_t additional_nn_needed = size_constraint - tc.sum_type_constraints;
+	const iscc_TypedNNQuery typed_query = {
+		.num_types = num_types,
+		.type_labels = type_labels,
+		.type_ks = type_constraints,
+		.k_all = (additional_nn_needed > 0) ? size_constraint : 0,
+	};
+	const uint32_t row_width = tc.sum_type_constraints + typed_query.k_all;
+	assert(row_width > 0);
+
+	const size_t num_queries = (primary_data_points == NULL) ? num_data_points : len_primary_data_points;
+	assert(num_queries > 0);
+	if (num_queries > SIZE_MAX / sizeof(scc_PointIndex) / row_width) {
+		return iscc_make_error_msg(SCC_ER_TOO_LARGE_PROBLEM, "Too many arcs in graph.");
+	}
+
+	scc_PointIndex* const ok_queries = malloc(sizeof(scc_PointIndex[num_queries]));
+	scc_PointIndex* const nn_rows = malloc(sizeof(scc_PointIndex[num_queries * row_width]));
+	if ((ok_queries == NULL) || (nn_rows == NULL)) {
+		free(ok_queries);
+		free(nn_rows);
+		return iscc_make_error(SCC_ER_NO_MEMORY);
+	}
+
+	iscc_NNSearchObject* nn_search_object = shared_search_object;
+	if ((nn_search_object == NULL) &&
+	        !iscc_init_nn_search_object(data_set, num_data_points, NULL, &nn_search_object)) {
+		free(ok_queries);
+		free(nn_rows);
+		return iscc_make_error(SCC_ER_DIST_SEARCH_ERROR);
+	}
+
+	size_t num_ok_queries = 0;
+	ec = iscc_chunked_nn_search(data_set,
+	                            nn_search_object,
+	                            NULL,
+	                            &typed_query,
+	                            num_queries,
+	                            primary_data_points,
+	                            row_width,
+	                            radius_constraint,
+	                            radius,
+	                            num_threads,
+	                            &num_ok_queries,
+	                            ok_queries,
+	                            nn_rows);
+
+	if ((shared_search_object == NULL) &&
+	        !iscc_close_nn_search_object(data_set, &nn_search_object) &&
+	        (ec == SCC_ER_OK)) {
+		ec = iscc_make_error(SCC_ER_DIST_SEARCH_ERROR);
+	}
+
+	if ((ec == SCC_ER_OK) && (num_ok_queries == 0)) {
+		ec = iscc_make_error_msg(SCC_ER_NO_SOLUTION, "Infeasible radius constraint.");
+	}
+
+	scc_PointIndex* row_markers = NULL;
+	if (ec == SCC_ER_OK) {
+		row_markers = malloc(sizeof(scc_PointIndex[num_data_points]));
+		if (row_markers == NULL) ec = iscc_make_error(SCC_ER_NO_MEMORY);
+	}
+
+	if (ec == SCC_ER_OK) {
+		ec = iscc_init_digraph(num_data_points, ((uintmax_t) num_ok_queries) * size_constraint, out_nng);
+	}
+
+	if (ec != SCC_ER_OK) {
+		free(ok_queries);
+		free(nn_rows);
+		free(row_markers);
+		return ec;
+	}
+
+	for (size_t v = 0; v < num_data_points; ++v) {
+		row_markers[v] = ISCC_POINTINDEX_MAX_PI;
+	}
+
+	// Ok queries are in query order, and primary data points are sorted
+	size_t arc_write = 0;
+	size_t next_tail = 0;
+	for (size_t q = 0; q < num_ok_queries; ++q) {
+		const scc_PointIndex v = ok_queries[q];
+		assert((q == 0) || (ok_queries[q - 1] < v));
+		for (; next_tail <= (size_t) v; ++next_tail) {
+			out_nng->tail_ptr[next_tail] = (iscc_ArcIndex) arc_write;
+		}
+		scc_PointIndex* const row = nn_rows + q * row_width;
+
+		// With identical data points, the search may not return the query itself. The NNG
+		// clustering functions require the query to be in its own type's neighbors.
+		const uint32_t self_k = type_constraints[type_labels[v]];
+		if (self_k > 0) {
+			uint32_t self_offset = 0;
+			for (scc_TypeLabel t = 0; t < type_labels[v]; ++t) {
+				self_offset += type_constraints[t];
+			}
+			scc_PointIndex* const self_list = row + self_offset;
+			uint32_t i = 0;
+			for (; (i < self_k) && (self_list[i] != v); ++i);
+			if (i == self_k) self_list[self_k - 1] = v;
+		}
+
+		for (uint32_t i = 0; i < tc.sum_type_constraints; ++i) {
+			row_markers[row[i]] = v;
+			if (row[i] != v) out_nng->head[arc_write++] = row[i];
+		}
+
+		uint32_t added = 0;
+		for (uint32_t i = tc.sum_type_constraints; (added < additional_nn_needed) && (i < row_width); ++i) {
+			if (row_markers[row[i]] != v) {
+				++added;
+				if (row[i] != v) out_nng->head[arc_write++] = row[i];
+			}
+		}
+	}
+	for (; next_tail <= num_data_points; ++next_tail) {
+		out_nng->tail_ptr[next_tail] = (iscc_ArcIndex) arc_write;
+	}
+
+	free(ok_queries);
+	free(nn_rows);
+	free(row_markers);
+
+	if ((ec = iscc_change_arc_storage(out_nng, arc_write)) != SCC_ER_OK) {
+		iscc_free_digraph(out_nng);
+		return ec;
+	}
+
+	#ifdef SCC_STABLE_NNG
+		iscc_sort_nng(out_nng);
+	#endif // ifdef SCC_STABLE_NNG
+
+	return iscc_no_error();
+}
+
+
+static inline bool iscc_search_query_chunk(void* const data_set,
+                                           iscc_NNSearchObject* const nn_search_object,
+                                           const iscc_SearchSubset* const search_subset,
+                                           const iscc_TypedNNQuery* const typed_query,
+                                           const size_t len_query_indices,
+                                           const scc_PointIndex query_indices[const],
+                                           const uint32_t k,
+                                           const bool radius_search,
+                                           const double radius,
+                                           size_t* const out_num_ok_queries,
+                                           scc_PointIndex out_query_indices[const],
+                                           scc_PointIndex out_nn_indices[const])
+{
+	if (typed_query != NULL) {
+		assert(search_subset == NULL);
+		return iscc_typed_nearest_neighbor_search(data_set,
+		                                          nn_search_object,
+		                                          typed_query,
+		                                          len_query_indices,
+		                                          query_indices,
+		                                          radius_search,
+		                                          radius,
+		                                          out_num_ok_queries,
+		                                          out_query_indices,
+		                                          out_nn_indices);
+	}
+	return iscc_filtered_nearest_neighbor_search(data_set,
+	                                             nn_search_object,
+	                                             search_subset,
+	                                             len_query_indices,
+	                                             query_indices,
+	                                             k,
+	                                             radius_search,
+	                                             radius,
+	                                             out_num_ok_queries,
+	                                             out_query_indices,
+	                                             out_nn_indices);
+}
+
+
+// With a `typed_query`, `k` is the width of its output rows
+static scc_ErrorCode iscc_chunked_nn_search(void* const data_set,
+                                            iscc_NNSearchObject* const nn_search_object,
+                                            const iscc_SearchSubset* const search_subset,
+                                            const iscc_TypedNNQuery* const typed_query,
+                                            const size_t len_query_indices,
+                                            const scc_PointIndex query_indices[const],
+                                            const uint32_t k,
+                                            const bool radius_search,
+                                            const double radius,
+                                            const uint32_t num_threads,
+                                            size_t* const out_num_ok_queries,
+                                            scc_PointIndex out_query_indices[const],
+                                            scc_PointIndex out_nn_indices[const])
+{
+	assert(nn_search_object != NULL);
+	assert(len_query_indices > 0);
+	assert(k > 0);
+	assert(out_num_ok_queries != NULL);
+	assert(out_nn_indices != NULL);
+
+	size_t use_threads = num_threads;
+	#ifdef _OPENMP
+		if (use_threads == 0) use_threads = (size_t) omp_get_max_threads();
+		if (use_threads > INT_MAX) use_threads = INT_MAX;
+	#endif // ifdef _OPENMP
+
+	size_t num_chunks = 1;
+	if ((use_threads > 1) && iscc_nn_search_is_reentrant(data_set)) {
+		num_chunks = use_threads * ISCC_NNG_CHUNKS_PER_THREAD;
+		const size_t max_chunks = 1 + (len_query_indices - 1) / ISCC_NNG_MIN_QUERY_CHUNK;
+		if (num_chunks > max_chunks) num_chunks = max_chunks;
+	}
+
+	if (num_chunks <= 1) {
+		if (!iscc_search_query_chunk(data_set,
+		                             nn_search_object,
+		                             search_subset,
+		                             typed_query,
+		                             len_query_indices,
+		                             query_indices,
+		                             k,
+		                             radius_search,
+		                             radius,
+		                             out_num_ok_queries,
+		                             out_query_indices,
+		                             out_nn_indices)) {
+			return iscc_make_error(SCC_ER_DIST_SEARCH_ERROR);
+		}
+		return iscc_no_error();
+	}
+
+	const size_t chunk_size = 1 + (len_query_indices - 1) / num_chunks;
+	num_chunks = 1 + (len_query_indices - 1) / chunk_size;
+	if (use_threads > num_chunks) use_threads = num_chunks;
+
+	// Chunks need explicit query indices
+	scc_PointIndex* all_query_indices = NULL;
+	const scc_PointIndex* chunk_query_source = query_indices;
+	if (query_indices == NULL) {
+		all_query_indices = malloc(sizeof(scc_PointIndex[len_query_indices]));
+		if (all_query_indices == NULL) return iscc_make_error(SCC_ER_NO_MEMORY);
+		for (size_t q = 0; q < len_query_indices; ++q) {
+			all_query_indices[q] = (scc_PointIndex) q;
+		}
+		chunk_query_source = all_query_indices;
+	}
+
+	size_t* const chunk_num_ok = malloc(sizeof(size_t[num_chunks]));
+	if (chunk_num_ok == NULL) {
+		free(all_query_indices);
+		return iscc_make_error(SCC_ER_NO_MEMORY);
+	}
+
+	// Each chunk writes into its own slice of the output arrays. `out_query_indices` may alias
+	// `query_indices`, but a chunk only writes to positions it has already read.
+	size_t num_failed_chunks = 0;
+	#ifdef _OPENMP
+		#pragma omp parallel for schedule(dynamic) num_threads((int) use_threads) reduction(+:num_failed_chunks)
+	#endif // ifdef _OPENMP
+	for (size_t c = 0; c < num_chunks; ++c) {
+		const size_t chunk_start = c * chunk_size;
+		size_t chunk_len = len_query_indices - chunk_start;
+		if (chunk_len > chunk_size) chunk_len = chunk_size;
+		chunk_num_ok[c] = 0;
+		if (!iscc_search_query_chunk(data_set,
+		                             nn_search_object,
+		                             search_subset,
+		                             typed_query,
+		                             chunk_len,
+		                             chunk_query_source + chunk_start,
+		                             k,
+		                             radius_search,
+		                             radius,
+		                             &chunk_num_ok[c],
+		                             (out_query_indices == NULL) ? NULL : out_query_indices + chunk_start,
+		                             out_nn_indices + chunk_start * k)) {
+			++num_failed_chunks;
+		}
+	}
+
+	free(all_query_indices);
+
+	if (num_failed_chunks > 0) {
+		free(chunk_num_ok);
+		return iscc_make_error(SCC_ER_DIST_SEARCH_ERROR);
+	}
+
+	// Compact the chunks in query order so that the result is identical to a single search
+	size_t num_ok_queries = 0;
+	for (size_t c = 0; c < num_chunks; ++c) {
+		const size_t chunk_start = c * chunk_size;
+		assert(num_ok_queries <= chunk_start);
+		if ((num_ok_queries < chunk_start) && (chunk_num_ok[c] > 0)) {
+			memmove(out_nn_indices + num_ok_queries * k,
+			        out_nn_indices + chunk_start * k,
+			        sizeof(scc_PointIndex[chunk_num_ok[c] * k]));
+			if (out_query_indices != NULL) {
+				memmove(out_query_indices + num_ok_queries,
+				        out_query_indices + chunk_start,
+				        sizeof(scc_PointIndex[chunk_num_ok[c]]));
+			}
+		}
+		num_ok_queries += chunk_num_ok[c];
+	}
+
+	free(chunk_num_ok);
+
+	*out_num_ok_queries = num_ok_queries;
+
+	return iscc_no_error();
+}
+
+
 static inline void iscc_ensure_self_match(iscc_Digraph* const nng,
                                           const size_t len_search_indices,
                                           const scc_PointIndex search_indices[const])
@@ -823,20 +1297,20 @@ static inline void iscc_ensure_self_match(iscc_Digraph* const nng,
 		assert(len_search_indices <= ISCC_POINTINDEX_MAX);
 		const scc_PointIndex len_search_indices_pi = (scc_PointIndex) len_search_indices; // If `scc_PointIndex` is signed.
 		for (scc_PointIndex search_point = 0; search_point < len_search_indices_pi; ++search_point) {
-			scc_PointIndex* v_arc = nng->head + nng->tail_ptr[search_point];
-			const scc_PointIndex* const v_arc_stop = nng->head + nng->tail_ptr[search_point + 1];
-			if ((*v_arc == search_point) || (v_arc == v_arc_stop)) continue;
-			for (++v_arc; (*v_arc != search_point) && (v_arc != v_arc_stop); ++v_arc);
+			scc_PointIndex* v_arc = nng->head + iscc_digraph_row_begin(nng, search_point);
+			const scc_PointIndex* const v_arc_stop = nng->head + iscc_digraph_row_end(nng, search_point);
+			if ((v_arc == v_arc_stop) || (*v_arc == search_point)) continue;
+			for (++v_arc; (v_arc != v_arc_stop) && (*v_arc != search_point); ++v_arc);
 			if (v_arc == v_arc_stop) *(v_arc - 1) = search_point;
 		}
 
 	} else if (search_indices != NULL) {
 		for (size_t s = 0; s < len_search_indices; ++s) {
 			const scc_PointIndex search_point = search_indices[s];
-			scc_PointIndex* v_arc = nng->head + nng->tail_ptr[search_point];
-			const scc_PointIndex* const v_arc_stop = nng->head + nng->tail_ptr[search_point + 1];
-			if ((*v_arc == search_point) || (v_arc == v_arc_stop)) continue;
-			for (++v_arc; (*v_arc != search_point) && (v_arc != v_arc_stop); ++v_arc);
+			scc_PointIndex* v_arc = nng->head + iscc_digraph_row_begin(nng, search_point);
+			const scc_PointIndex* const v_arc_stop = nng->head + iscc_digraph_row_end(nng, search_point);
+			if ((v_arc == v_arc_stop) || (*v_arc == search_point)) continue;
+			for (++v_arc; (v_arc != v_arc_stop) && (*v_arc != search_point); ++v_arc);
 			if (v_arc == v_arc_stop) *(v_arc - 1) = search_point;
 		}
 	}
@@ -912,7 +1386,8 @@ static scc_ErrorCode iscc_type_count(const size_t num_data_points,
 
 static size_t iscc_assign_seeds_and_neighbors(scc_Clustering* const clustering,
                                               const iscc_SeedResult* const seed_result,
-                                              iscc_Digraph* const nng)
+                                              iscc_Digraph* const nng,
+                                              iscc_DigraphRowReader* const nng_reader)
 {
 	assert(iscc_check_input_clustering(clustering));
 	assert(clustering->cluster_label != NULL);
@@ -936,13 +1411,15 @@ static size_t iscc_assign_seeds_and_neighbors(scc_Clustering* const clustering,
 		assert(clabel < SCC_CLABEL_MAX);
 		assert(clustering->cluster_label[*seed] == SCC_CLABEL_NA);
 
-		const scc_PointIndex* const s_arc_stop = nng->head + nng->tail_ptr[*seed + 1];
-		for (const scc_PointIndex* s_arc = nng->head + nng->tail_ptr[*seed];
+		size_t len_s_row;
+		const scc_PointIndex* const s_row = iscc_digraph_read_row(nng, (size_t) *seed, nng_reader, &len_s_row);
+		const scc_PointIndex* const s_arc_stop = s_row + len_s_row;
+		for (const scc_PointIndex* s_arc = s_row;
 		        s_arc != s_arc_stop; ++s_arc) {
 			assert(clustering->cluster_label[*s_arc] == SCC_CLABEL_NA);
 			clustering->cluster_label[*s_arc] = clabel;
 		}
-		num_assigned += (nng->tail_ptr[*seed + 1] - nng->tail_ptr[*seed]) + // Number of arcs from seed
+		num_assigned += len_s_row + // Number of arcs from seed
 		                    (clustering->cluster_label[*seed] == SCC_CLABEL_NA); // In the case of no seed self-loop
 		clustering->cluster_label[*seed] = clabel; // Assign seed last so seed `assert` work also in case of self-loops
 	}
@@ -954,31 +1431,36 @@ static size_t iscc_assign_seeds_and_neighbors(scc_Clustering* const clustering,
 
 
 static size_t iscc_assign_by_nng(scc_Clustering* const clustering,
-                                 iscc_Digraph* const nng)
+                                 iscc_Digraph* const nng,
+                                 iscc_DigraphRowReader* const nng_reader)
 {
 	assert(iscc_check_input_clustering(clustering));
 	assert(iscc_digraph_is_valid(nng));
 	assert(!iscc_digraph_is_empty(nng));
 
-	bool* const scratch = malloc(sizeof(bool[clustering->num_data_points]));
+	// Marks the points unassigned before this function; labels set below are not marked
+	const size_t num_data_points = clustering->num_data_points;
+	iscc_BitsetWord* const scratch = iscc_bitset_alloc(num_data_points);
 	if (scratch == NULL) return iscc_make_error(SCC_ER_NO_MEMORY);
-	for (size_t i = 0; i < clustering->num_data_points; ++i) {
-		scratch[i] = (clustering->cluster_label[i] == SCC_CLABEL_NA);
+	for (size_t i = 0; i < num_data_points; ++i) {
+		if (clustering->cluster_label[i] == SCC_CLABEL_NA) iscc_bitset_set(scratch, i);
 	}
 
 	size_t num_assigned_by_nng = 0;
-	for (size_t i = 0; i < clustering->num_data_points; ++i) {
-		if (scratch[i]) {
-			assert(clustering->cluster_label[i] == SCC_CLABEL_NA);
-			const scc_PointIndex* const v_arc_stop = nng->head + nng->tail_ptr[i + 1];
-			for (const scc_PointIndex* v_arc = nng->head + nng->tail_ptr[i];
-			        v_arc != v_arc_stop; ++v_arc) {
-				if (!scratch[*v_arc]) {
-					assert(clustering->cluster_label[*v_arc] != SCC_CLABEL_NA);
-					clustering->cluster_label[i] = clustering->cluster_label[*v_arc];
-					++num_assigned_by_nng;
-					break;
-				}
+	for (size_t i = iscc_bitset_next_set(scratch, num_data_points, 0);
+	        i < num_data_points;
+	        i = iscc_bitset_next_set(scratch, num_data_points, i + 1)) {
+		assert(clustering->cluster_label[i] == SCC_CLABEL_NA);
+		size_t len_v_row;
+		const scc_PointIndex* const v_row = iscc_digraph_read_row(nng, i, nng_reader, &len_v_row);
+		const scc_PointIndex* const v_arc_stop = v_row + len_v_row;
+		for (const scc_PointIndex* v_arc = v_row;
+		        v_arc != v_arc_stop; ++v_arc) {
+			if (!iscc_bitset_test(scratch, (size_t) *v_arc)) {
+				assert(clustering->cluster_label[*v_arc] != SCC_CLABEL_NA);
+				clustering->cluster_label[i] = clustering->cluster_label[*v_arc];
+				++num_assigned_by_nng;
+				break;
 			}
 		}
 	}
@@ -989,8 +1471,75 @@ static size_t iscc_assign_by_nng(scc_Clustering* const clustering,
 }
 
 
+static scc_ErrorCode iscc_init_assign_search(void* const data_set,
+                                             const size_t num_data_points,
+                                             const size_t len_search_points,
+                                             const scc_PointIndex search_points[const static len_search_points],
+                                             iscc_NNSearchObject* const shared_search_object,
+                                             iscc_AssignSearch* const out_assign_search)
+{
+	assert(len_search_points > 0);
+	assert(out_assign_search != NULL);
+
+	*out_assign_search = (iscc_AssignSearch) { NULL, NULL, NULL, NULL };
+
+	// `search_points` is freed before the search, so it is copied
+	out_assign_search->search_indices = malloc(sizeof(scc_PointIndex[len_search_points]));
+	if (out_assign_search->search_indices == NULL) return iscc_make_error(SCC_ER_NO_MEMORY);
+	memcpy(out_assign_search->search_indices, search_points, sizeof(scc_PointIndex[len_search_points]));
+
+	if (shared_search_object != NULL) {
+		out_assign_search->search_subset = malloc(sizeof(iscc_SearchSubset));
+		out_assign_search->search_ranks = malloc(sizeof(scc_PointIndex[num_data_points]));
+		if ((out_assign_search->search_subset == NULL) || (out_assign_search->search_ranks == NULL)) {
+			iscc_close_assign_search(data_set, shared_search_object, out_assign_search);
+			return iscc_make_error(SCC_ER_NO_MEMORY);
+		}
+		for (size_t i = 0; i < num_data_points; ++i) {
+			out_assign_search->search_ranks[i] = ISCC_POINTINDEX_MAX_PI;
+		}
+		for (size_t i = 0; i < len_search_points; ++i) {
+			out_assign_search->search_ranks[search_points[i]] = (scc_PointIndex) i;
+		}
+		*out_assign_search->search_subset = (iscc_SearchSubset) {
+			.points = out_assign_search->search_indices,
+			.ranks = out_assign_search->search_ranks,
+		};
+		out_assign_search->nn_search_object = shared_search_object;
+		return iscc_no_error();
+	}
+
+	if (!iscc_init_nn_search_object(data_set,
+	                                len_search_points,
+	                                out_assign_search->search_indices,
+	                                &out_assign_search->nn_search_object)) {
+		iscc_close_assign_search(data_set, shared_search_object, out_assign_search);
+		return iscc_make_error(SCC_ER_DIST_SEARCH_ERROR);
+	}
+
+	return iscc_no_error();
+}
+
+
+static void iscc_close_assign_search(void* const data_set,
+                                     iscc_NNSearchObject* const shared_search_object,
+                                     iscc_AssignSearch* const assign_search)
+{
+	if ((assign_search->nn_search_object != NULL) &&
+	        (assign_search->nn_search_object != shared_search_object)) {
+		iscc_close_nn_search_object(data_set, &assign_search->nn_search_object);
+	}
+	free(assign_search->search_subset);
+	free(assign_search->search_indices);
+	free(assign_search->search_ranks);
+	*assign_search = (iscc_AssignSearch) { NULL, NULL, NULL, NULL };
+}
+
+
 static scc_ErrorCode iscc_assign_by_nn_search(scc_Clustering* const clustering,
+                                              void* const data_set,
                                               iscc_NNSearchObject* const nn_search_object,
+                                              const iscc_SearchSubset* const search_subset,
                                               const size_t num_to_assign,
                                               scc_PointIndex to_assign[restrict const static num_to_assign],
                                               const bool radius_constraint,
@@ -1009,15 +1558,17 @@ static scc_ErrorCode iscc_assign_by_nn_search(scc_Clustering* const clustering,
 	}
 	scc_PointIndex* const out_nn_indices = malloc(sizeof(scc_PointIndex[num_to_assign]));
 
-	if (!iscc_nearest_neighbor_search(nn_search_object,
-	                                  num_to_assign,
-	                                  to_assign,
-	                                  1,
-	                                  radius_constraint,
-	                                  radius,
-	                                  &num_ok_queries,
-	                                  out_ok_query,
-	                                  out_nn_indices)) {
+	if (!iscc_filtered_nearest_neighbor_search(data_set,
+	                                           nn_search_object,
+	                                           search_subset,
+	                                           num_to_assign,
+	                                           to_assign,
+	                                           1,
+	                                           radius_constraint,
+	                                           radius,
+	                                           &num_ok_queries,
+	                                           out_ok_query,
+	                                           out_nn_indices)) {
 		free(out_nn_indices);
 		return iscc_make_error(SCC_ER_DIST_SEARCH_ERROR);
 	}
@@ -1052,9 +1603,9 @@ static int iscc_compare_PointIndex(const void* const a, const void* const b)
 static void iscc_sort_nng(iscc_Digraph* const nng)
 {
 	for (size_t v = 0; v < nng->vertices; ++v) {
-		const size_t count = nng->tail_ptr[v + 1] - nng->tail_ptr[v];
+		const size_t count = iscc_digraph_out_degree(nng, v);
 		if (count > 1) {
-			qsort(nng->head + nng->tail_ptr[v], count, sizeof(scc_PointIndex), iscc_compare_PointIndex);
+			qsort(nng->head + iscc_digraph_row_begin(nng, v), count, sizeof(scc_PointIndex), iscc_compare_PointIndex);
 		}
 	}
 }
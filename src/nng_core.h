@@ -25,6 +25,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "../include/scclust.h"
+#include "../include/scclust_spi.h"
 #include "digraph_core.h"
 #include "nng_findseeds.h"
 
@@ -33,6 +34,9 @@
 // Function prototypes
 // =============================================================================
 
+// `shared_search_object` may be NULL. Otherwise, it must be a search object over all data
+// points, made when `iscc_nn_search_supports_filter` is true, and it is then searched with
+// filters instead of making search objects for subsets of the points.
 scc_ErrorCode iscc_get_nng_with_size_constraint(void* data_set,
                                                 size_t num_data_points,
                                                 uint32_t size_constraint,
@@ -40,6 +44,8 @@ scc_ErrorCode iscc_get_nng_with_size_constraint(void* data_set,
                                                 const scc_PointIndex primary_data_points[],
                                                 bool radius_constraint,
                                                 double radius,
+                                                uint32_t num_threads,
+                                                iscc_NNSearchObject* shared_search_object,
                                                 iscc_Digraph* out_nng);
 
 
@@ -53,6 +59,8 @@ scc_ErrorCode iscc_get_nng_with_type_constraint(void* data_set,
                                                 const scc_PointIndex primary_data_points[],
                                                 bool radius_constraint,
                                                 double radius,
+                                                uint32_t num_threads,
+                                                iscc_NNSearchObject* shared_search_object,
                                                 iscc_Digraph* out_nng);
 
 
@@ -75,7 +83,8 @@ scc_ErrorCode iscc_make_nng_clusters_from_seeds(scc_Clustering* clustering,
                                                 const scc_PointIndex primary_data_points[],
                                                 scc_UnassignedMethod secondary_unassigned_method,
                                                 bool secondary_radius_constraint,
-                                                double secondary_radius);
+                                                double secondary_radius,
+                                                iscc_NNSearchObject* shared_search_object);
 
 
 #endif // ifndef SCC_NNG_CORE_HG
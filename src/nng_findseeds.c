@@ -21,18 +21,25 @@
 #include "nng_findseeds.h"
 
 #include <assert.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include "../include/scclust.h"
+#include "bitset.h"
 #include "digraph_core.h"
 #include "digraph_operations.h"
 #include "error.h"
 #include "scclust_types.h"
 
+#ifdef _OPENMP
+	#include <omp.h>
+#endif // ifdef _OPENMP
+
 
 // =============================================================================
-// Internal structs
+// Internal structs & variables
 // =============================================================================
 
 typedef struct iscc_fs_SortResult {
@@ -43,6 +50,17 @@ typedef struct iscc_fs_SortResult {
 } iscc_fs_SortResult;
 
 
+// Average number of arcs per vertex in the NNG from which the exclusion graph is
+// not materialized by `SCC_SM_EXCLUSION_ORDER` and `SCC_SM_EXCLUSION_UPDATING`
+#define ISCC_FS_IMPLICIT_EXCLUSION_MIN_ARCS 8
+
+
+// Vertex states in `iscc_findseeds_parallel`
+static const uint8_t ISCC_FS_UNDECIDED = 0;
+static const uint8_t ISCC_FS_SEED = 1;
+static const uint8_t ISCC_FS_EXCLUDED = 2;
+
+
 // =============================================================================
 // Static function prototypes
 // =============================================================================
@@ -58,27 +76,76 @@ static scc_ErrorCode iscc_findseeds_inwards(const iscc_Digraph* nng,
 
 static scc_ErrorCode iscc_findseeds_exclusion(const iscc_Digraph* nng,
                                               bool updating,
+                                              uint32_t num_threads,
                                               iscc_SeedResult* out_seeds);
 
 
+static scc_ErrorCode iscc_findseeds_exclusion_implicit(const iscc_Digraph* nng,
+                                                       bool updating,
+                                                       uint32_t num_threads,
+                                                       iscc_SeedResult* out_seeds);
+
+
+static scc_ErrorCode iscc_findseeds_parallel(const iscc_Digraph* nng,
+                                             bool exclusion,
+                                             uint32_t num_threads,
+                                             iscc_SeedResult* out_seeds);
+
+
 static scc_ErrorCode iscc_fs_exclusion_graph(const iscc_Digraph* nng,
                                              size_t len_not_excluded,
                                              const scc_PointIndex not_excluded[],
+                                             uint32_t num_threads,
                                              iscc_Digraph* out_dg);
 
 
+static inline size_t iscc_fs_exclusion_row(scc_PointIndex v,
+                                           const iscc_Digraph* nng,
+                                           const iscc_Digraph* nng_transpose,
+                                           iscc_DigraphRowReader* nng_reader,
+                                           iscc_DigraphRowReader* transpose_reader,
+                                           iscc_BitsetWord row_marks[restrict],
+                                           scc_PointIndex out_row[restrict]);
+
+
 static inline scc_ErrorCode iscc_fs_add_seed(scc_PointIndex s,
                                              iscc_SeedResult* seed_result);
 
 
 static inline bool iscc_fs_check_neighbors_marks(scc_PointIndex v,
-                                                 const iscc_Digraph*  nng,
-                                                 const bool marks[static nng->vertices]);
+                                                 const scc_PointIndex v_row[],
+                                                 size_t len_v_row,
+                                                 const iscc_BitsetWord marks[]);
 
 
 static inline void iscc_fs_mark_seed_neighbors(scc_PointIndex s,
-                                               const iscc_Digraph* nng,
-                                               bool marks[static nng->vertices]);
+                                               const scc_PointIndex s_row[],
+                                               size_t len_s_row,
+                                               iscc_BitsetWord marks[]);
+
+
+static inline uint64_t iscc_fs_mis_tiebreak(scc_PointIndex v);
+
+
+static inline bool iscc_fs_mis_before(scc_PointIndex u,
+                                      scc_PointIndex v,
+                                      const scc_PointIndex priority[]);
+
+
+static inline bool iscc_fs_mis_blocks(scc_PointIndex u,
+                                      scc_PointIndex v,
+                                      const scc_PointIndex priority[],
+                                      const uint8_t state[],
+                                      const bool round_seeds[]);
+
+
+static inline bool iscc_fs_mis_find_conflict(scc_PointIndex v,
+                                             const iscc_Digraph* first,
+                                             const iscc_Digraph* second,
+                                             iscc_DigraphRowReader readers[],
+                                             const scc_PointIndex priority[],
+                                             const uint8_t state[],
+                                             const bool round_seeds[]);
 
 
 static void iscc_fs_free_sort_result(iscc_fs_SortResult* sr);
@@ -89,6 +156,11 @@ static scc_ErrorCode iscc_fs_sort_by_inwards(const iscc_Digraph* nng,
                                              iscc_fs_SortResult* out_sort);
 
 
+static scc_ErrorCode iscc_fs_sort_by_count(size_t vertices,
+                                           bool make_indices,
+                                           iscc_fs_SortResult* out_sort);
+
+
 static inline void iscc_fs_decrease_v_in_sort(scc_PointIndex v_to_decrease,
                                               scc_PointIndex inwards_count[restrict],
                                               scc_PointIndex* vertex_index[restrict],
@@ -121,6 +193,7 @@ static inline void iscc_fs_debug_check_sort(const scc_PointIndex* current_pos,
 
 scc_ErrorCode iscc_find_seeds(const iscc_Digraph* const nng,
                               const scc_SeedMethod seed_method,
+                              const uint32_t num_threads,
                               iscc_SeedResult* const out_seeds)
 {
 	assert(iscc_digraph_is_valid(nng));
@@ -146,11 +219,19 @@ scc_ErrorCode iscc_find_seeds(const iscc_Digraph* const nng,
 			break;
 
 		case SCC_SM_EXCLUSION_ORDER:
-			ec = iscc_findseeds_exclusion(nng, false, out_seeds);
+			ec = iscc_findseeds_exclusion(nng, false, num_threads, out_seeds);
 			break;
 
 		case SCC_SM_EXCLUSION_UPDATING:
-			ec = iscc_findseeds_exclusion(nng, true, out_seeds);
+			ec = iscc_findseeds_exclusion(nng, true, num_threads, out_seeds);
+			break;
+
+		case SCC_SM_INWARDS_PARALLEL:
+			ec = iscc_findseeds_parallel(nng, false, num_threads, out_seeds);
+			break;
+
+		case SCC_SM_EXCLUSION_PARALLEL:
+			ec = iscc_findseeds_parallel(nng, true, num_threads, out_seeds);
 			break;
 
 		default:
@@ -189,31 +270,42 @@ static scc_ErrorCode iscc_findseeds_lexical(const iscc_Digraph* const nng,
 	assert(out_seeds->count == 0);
 	assert(out_seeds->seeds == NULL);
 
-	bool* const marks = calloc(nng->vertices, sizeof(bool));
+	scc_ErrorCode ec;
+	iscc_DigraphRowReader reader;
+	if ((ec = iscc_init_row_reader(nng, &reader)) != SCC_ER_OK) return ec;
+
+	iscc_BitsetWord* const marks = iscc_bitset_alloc(nng->vertices);
 	out_seeds->seeds = malloc(sizeof(scc_PointIndex[out_seeds->capacity]));
 	if ((marks == NULL) || (out_seeds->seeds == NULL)) {
+		iscc_free_row_reader(&reader);
 		free(marks);
 		free(out_seeds->seeds);
 		return iscc_make_error(SCC_ER_NO_MEMORY);
 	}
 
-	scc_ErrorCode ec;
 	assert(nng->vertices <= ISCC_POINTINDEX_MAX);
-	const scc_PointIndex vertices = (scc_PointIndex) nng->vertices; // If `scc_PointIndex` is signed
-	for (scc_PointIndex v = 0; v < vertices; ++v) {
-		if (iscc_fs_check_neighbors_marks(v, nng, marks)) {
-			assert(nng->tail_ptr[v] != nng->tail_ptr[v + 1]);
+	// Marked vertices cannot be seeds, so skip directly to the next unmarked one
+	for (size_t next_v = iscc_bitset_next_clear(marks, nng->vertices, 0);
+	        next_v < nng->vertices;
+	        next_v = iscc_bitset_next_clear(marks, nng->vertices, next_v + 1)) {
+		const scc_PointIndex v = (scc_PointIndex) next_v;
+		size_t len_v_row;
+		const scc_PointIndex* const v_row = iscc_digraph_read_row(nng, next_v, &reader, &len_v_row);
+		if (iscc_fs_check_neighbors_marks(v, v_row, len_v_row, marks)) {
+			assert(len_v_row > 0);
 
 			if ((ec = iscc_fs_add_seed(v, out_seeds)) != SCC_ER_OK) {
+				iscc_free_row_reader(&reader);
 				free(marks);
 				free(out_seeds->seeds);
 				return ec;
 			}
 
-			iscc_fs_mark_seed_neighbors(v, nng, marks);
+			iscc_fs_mark_seed_neighbors(v, v_row, len_v_row, marks);
 		}
 	}
 
+	iscc_free_row_reader(&reader);
 	free(marks);
 
 	return iscc_no_error();
@@ -236,11 +328,28 @@ static scc_ErrorCode iscc_findseeds_inwards(const iscc_Digraph* const nng,
 	iscc_fs_SortResult sort;
 	if ((ec = iscc_fs_sort_by_inwards(nng, updating, &sort)) != SCC_ER_OK) return ec;
 
-	bool* const marks = calloc(nng->vertices, sizeof(bool));
+	// Rows of seeds are read with the first reader, and rows of their neighbors with the second
+	iscc_DigraphRowReader readers[2];
+	ec = iscc_init_row_reader(nng, &readers[0]);
+	if (ec == SCC_ER_OK) {
+		ec = iscc_init_row_reader(nng, &readers[1]);
+		if (ec != SCC_ER_OK) iscc_free_row_reader(&readers[0]);
+	}
+	if (ec != SCC_ER_OK) {
+		iscc_fs_free_sort_result(&sort);
+		return ec;
+	}
+
+	// Only vertices with arcs can be seeds, so only their counts are decreased when updating
+	iscc_BitsetWord* const marks = iscc_bitset_alloc(nng->vertices);
+	iscc_BitsetWord* const has_arcs = updating ? iscc_digraph_tails_with_arcs(nng) : NULL;
 	out_seeds->seeds = malloc(sizeof(scc_PointIndex[out_seeds->capacity]));
-	if ((marks == NULL) || (out_seeds->seeds == NULL)) {
+	if ((marks == NULL) || (updating && (has_arcs == NULL)) || (out_seeds->seeds == NULL)) {
 		iscc_fs_free_sort_result(&sort);
+		iscc_free_row_reader(&readers[0]);
+		iscc_free_row_reader(&readers[1]);
 		free(marks);
+		free(has_arcs);
 		free(out_seeds->seeds);
 		return iscc_make_error(SCC_ER_NO_MEMORY);
 	}
@@ -253,40 +362,50 @@ static scc_ErrorCode iscc_findseeds_inwards(const iscc_Digraph* const nng,
 			if (updating) iscc_fs_debug_check_sort(sorted_v, sorted_v_stop - 1, sort.inwards_count);
 		#endif
 
-		if (iscc_fs_check_neighbors_marks(*sorted_v, nng, marks)) {
-			assert(nng->tail_ptr[*sorted_v] != nng->tail_ptr[*sorted_v + 1]);
+		// Marked vertices can neither become seeds nor affect the sort
+		if (iscc_bitset_test(marks, (size_t) *sorted_v)) continue;
+
+		size_t len_v_row;
+		const scc_PointIndex* const v_row = iscc_digraph_read_row(nng, (size_t) *sorted_v, &readers[0], &len_v_row);
+		const scc_PointIndex* const v_arc_stop = v_row + len_v_row;
+
+		if (iscc_fs_check_neighbors_marks(*sorted_v, v_row, len_v_row, marks)) {
+			assert(len_v_row > 0);
 
 			if ((ec = iscc_fs_add_seed(*sorted_v, out_seeds)) != SCC_ER_OK) {
 				iscc_fs_free_sort_result(&sort);
+				iscc_free_row_reader(&readers[0]);
+				iscc_free_row_reader(&readers[1]);
 				free(marks);
+				free(has_arcs);
 				free(out_seeds->seeds);
 				return ec;
 			}
 
-			iscc_fs_mark_seed_neighbors(*sorted_v, nng, marks);
+			iscc_fs_mark_seed_neighbors(*sorted_v, v_row, len_v_row, marks);
 
 			if (updating) {
-				const scc_PointIndex* const v_arc_stop = nng->head + nng->tail_ptr[*sorted_v + 1];
-				for (const scc_PointIndex* v_arc = nng->head + nng->tail_ptr[*sorted_v];
+				for (const scc_PointIndex* v_arc = v_row;
 				        v_arc != v_arc_stop; ++v_arc) {
 					if (sorted_v < sort.vertex_index[*v_arc]) {
-						const scc_PointIndex* const v_arc_arc_stop = nng->head + nng->tail_ptr[*v_arc + 1];
-						for (scc_PointIndex* v_arc_arc = nng->head + nng->tail_ptr[*v_arc];
+						size_t len_v_arc_row;
+						const scc_PointIndex* const v_arc_row = iscc_digraph_read_row(nng, (size_t) *v_arc, &readers[1], &len_v_arc_row);
+						const scc_PointIndex* const v_arc_arc_stop = v_arc_row + len_v_arc_row;
+						for (const scc_PointIndex* v_arc_arc = v_arc_row;
 						        v_arc_arc != v_arc_arc_stop; ++v_arc_arc) {
 							// Only decrease if vertex can be seed (i.e., not already assigned, not already considered and has arcs in nng)
-							if (!marks[*v_arc_arc] && (sorted_v < sort.vertex_index[*v_arc_arc]) && (nng->tail_ptr[*v_arc_arc] != nng->tail_ptr[*v_arc_arc + 1])) {
+							if (!iscc_bitset_test(marks, (size_t) *v_arc_arc) && (sorted_v < sort.vertex_index[*v_arc_arc]) && iscc_bitset_test(has_arcs, (size_t) *v_arc_arc)) {
 								iscc_fs_decrease_v_in_sort(*v_arc_arc, sort.inwards_count, sort.vertex_index, sort.bucket_index, sorted_v);
 							}
 						}
 					}
 				}
 			}
-		} else if (updating && !marks[*sorted_v]) {
-			const scc_PointIndex* const v_arc_stop = nng->head + nng->tail_ptr[*sorted_v + 1];
-			for (const scc_PointIndex* v_arc = nng->head + nng->tail_ptr[*sorted_v];
+		} else if (updating) {
+			for (const scc_PointIndex* v_arc = v_row;
 			        v_arc != v_arc_stop; ++v_arc) {
 				// Only decrease if vertex can be seed (i.e., not already assigned, not already considered and has arcs in nng)
-				if (!marks[*v_arc] && (sorted_v < sort.vertex_index[*v_arc]) && (nng->tail_ptr[*v_arc] != nng->tail_ptr[*v_arc + 1])) {
+				if (!iscc_bitset_test(marks, (size_t) *v_arc) && (sorted_v < sort.vertex_index[*v_arc]) && iscc_bitset_test(has_arcs, (size_t) *v_arc)) {
 					iscc_fs_decrease_v_in_sort(*v_arc, sort.inwards_count, sort.vertex_index, sort.bucket_index, sorted_v);
 				}
 			}
@@ -294,7 +413,10 @@ static scc_ErrorCode iscc_findseeds_inwards(const iscc_Digraph* const nng,
 	}
 
 	iscc_fs_free_sort_result(&sort);
+	iscc_free_row_reader(&readers[0]);
+	iscc_free_row_reader(&readers[1]);
 	free(marks);
+	free(has_arcs);
 
 	return iscc_no_error();
 }
@@ -302,6 +424,7 @@ static scc_ErrorCode iscc_findseeds_inwards(const iscc_Digraph* const nng,
 
 static scc_ErrorCode iscc_findseeds_exclusion(const iscc_Digraph* const nng,
                                               const bool updating,
+                                              const uint32_t num_threads,
                                               iscc_SeedResult* const out_seeds)
 {
 	assert(iscc_digraph_is_valid(nng));
@@ -312,7 +435,14 @@ static scc_ErrorCode iscc_findseeds_exclusion(const iscc_Digraph* const nng,
 	assert(out_seeds->count == 0);
 	assert(out_seeds->seeds == NULL);
 
-	bool* const not_excluded = malloc(sizeof(bool[nng->vertices]));
+	// The exclusion graph has roughly `k` times as many arcs as the NNG. When that
+	// is large, or when the NNG is compressed, its rows are derived when needed instead.
+	if (iscc_digraph_is_compressed(nng) ||
+	        ((iscc_digraph_num_arcs(nng) / nng->vertices) >= ISCC_FS_IMPLICIT_EXCLUSION_MIN_ARCS)) {
+		return iscc_findseeds_exclusion_implicit(nng, updating, num_threads, out_seeds);
+	}
+
+	iscc_BitsetWord* const not_excluded = iscc_digraph_tails_with_arcs(nng);
 	if (not_excluded == NULL) return iscc_make_error(SCC_ER_NO_MEMORY);
 
 	// FIX THIS
@@ -325,9 +455,9 @@ static scc_ErrorCode iscc_findseeds_exclusion(const iscc_Digraph* const nng,
 	assert(nng->vertices <= ISCC_POINTINDEX_MAX);
 	const scc_PointIndex vertices_pi = (scc_PointIndex) nng->vertices; // If `scc_PointIndex` is signed
 	for (scc_PointIndex v = 0; v < vertices_pi; ++v) {
-		not_excluded[v] = (nng->tail_ptr[v] != nng->tail_ptr[v + 1]);
+		const bool has_arcs = iscc_bitset_test(not_excluded, (size_t) v);
 		tmp_index_not_excluded[tmp_num_not_excluded] = v;
-		tmp_num_not_excluded += not_excluded[v];
+		tmp_num_not_excluded += has_arcs;
 	}
 	if (tmp_num_not_excluded == nng->vertices) {
 		tmp_num_not_excluded = 0;
@@ -342,7 +472,7 @@ static scc_ErrorCode iscc_findseeds_exclusion(const iscc_Digraph* const nng,
 
 	scc_ErrorCode ec;
 	iscc_Digraph exclusion_graph;
-	if ((ec = iscc_fs_exclusion_graph(nng, tmp_num_not_excluded, tmp_index_not_excluded, &exclusion_graph)) != SCC_ER_OK) {
+	if ((ec = iscc_fs_exclusion_graph(nng, tmp_num_not_excluded, tmp_index_not_excluded, num_threads, &exclusion_graph)) != SCC_ER_OK) {
 		free(not_excluded);
 		return ec;
 	}
@@ -375,8 +505,8 @@ static scc_ErrorCode iscc_findseeds_exclusion(const iscc_Digraph* const nng,
 			if (updating) iscc_fs_debug_check_sort(sorted_v, sorted_v_stop - 1, sort.inwards_count);
 		#endif
 
-		if (not_excluded[*sorted_v]) {
-			assert(nng->tail_ptr[*sorted_v] != nng->tail_ptr[*sorted_v + 1]);
+		if (iscc_bitset_test(not_excluded, (size_t) *sorted_v)) {
+			assert(iscc_digraph_out_degree(nng, *sorted_v) > 0);
 
 			if ((ec = iscc_fs_add_seed(*sorted_v, out_seeds)) != SCC_ER_OK) {
 				free(not_excluded);
@@ -386,13 +516,13 @@ static scc_ErrorCode iscc_findseeds_exclusion(const iscc_Digraph* const nng,
 				return ec;
 			}
 
-			not_excluded[*sorted_v] = false;
+			iscc_bitset_clear(not_excluded, (size_t) *sorted_v);
 
 			if (!updating) {
-				const scc_PointIndex* const ex_arc_stop = exclusion_graph.head + exclusion_graph.tail_ptr[*sorted_v + 1];
-				const scc_PointIndex* ex_arc = exclusion_graph.head + exclusion_graph.tail_ptr[*sorted_v];
+				const scc_PointIndex* const ex_arc_stop = exclusion_graph.head + iscc_digraph_row_end(&exclusion_graph, *sorted_v);
+				const scc_PointIndex* ex_arc = exclusion_graph.head + iscc_digraph_row_begin(&exclusion_graph, *sorted_v);
 				for (; ex_arc != ex_arc_stop; ++ex_arc) {
-					not_excluded[*ex_arc] = false;
+					iscc_bitset_clear(not_excluded, (size_t) *ex_arc);
 				}
 
 			} else {
@@ -402,25 +532,25 @@ static scc_ErrorCode iscc_findseeds_exclusion(const iscc_Digraph* const nng,
 				// to make two passes over the neighbors: one to exclude all neighbors that is not already excluded (and record them),
 				// and another to decrease the count on non-excluded neighbors' neighbors. As we never will return to the seed's edges,
 				// we use that as a scratch area.
-				scc_PointIndex* const ex_arc_start = exclusion_graph.head + exclusion_graph.tail_ptr[*sorted_v];
-				const scc_PointIndex* const ex_arc_stop = exclusion_graph.head + exclusion_graph.tail_ptr[*sorted_v + 1];
+				scc_PointIndex* const ex_arc_start = exclusion_graph.head + iscc_digraph_row_begin(&exclusion_graph, *sorted_v);
+				const scc_PointIndex* const ex_arc_stop = exclusion_graph.head + iscc_digraph_row_end(&exclusion_graph, *sorted_v);
 				const scc_PointIndex* ex_arc = ex_arc_start;
 				scc_PointIndex* write_arc = ex_arc_start;
 
 				for (; ex_arc != ex_arc_stop; ++ex_arc) {
-					if (not_excluded[*ex_arc]) {
+					if (iscc_bitset_test(not_excluded, (size_t) *ex_arc)) {
 						*write_arc = *ex_arc;
 						++write_arc;
 					}
-					not_excluded[*ex_arc] = false;
+					iscc_bitset_clear(not_excluded, (size_t) *ex_arc);
 				}
 
 				ex_arc = ex_arc_start;
 				for (; ex_arc != write_arc; ++ex_arc) {
-					const scc_PointIndex* const ex_arc_arc_stop = exclusion_graph.head + exclusion_graph.tail_ptr[*ex_arc + 1];
-					for (scc_PointIndex* ex_arc_arc = exclusion_graph.head + exclusion_graph.tail_ptr[*ex_arc];
+					const scc_PointIndex* const ex_arc_arc_stop = exclusion_graph.head + iscc_digraph_row_end(&exclusion_graph, *ex_arc);
+					for (scc_PointIndex* ex_arc_arc = exclusion_graph.head + iscc_digraph_row_begin(&exclusion_graph, *ex_arc);
 					        ex_arc_arc != ex_arc_arc_stop; ++ex_arc_arc) {
-						if (not_excluded[*ex_arc_arc]) {
+						if (iscc_bitset_test(not_excluded, (size_t) *ex_arc_arc)) {
 							iscc_fs_decrease_v_in_sort(*ex_arc_arc, sort.inwards_count, sort.vertex_index, sort.bucket_index, sorted_v);
 						}
 					}
@@ -437,6 +567,360 @@ static scc_ErrorCode iscc_findseeds_exclusion(const iscc_Digraph* const nng,
 }
 
 
+/* Same as `iscc_findseeds_exclusion` (and gives the same seeds), but the rows of the
+ * exclusion graph are derived from `nng` and its transpose when needed. The graph is
+ * never stored, so the extra memory is O(n + arcs in nng) rather than O(n k^2).
+ */
+static scc_ErrorCode iscc_findseeds_exclusion_implicit(const iscc_Digraph* const nng,
+                                                       const bool updating,
+                                                       const uint32_t num_threads,
+                                                       iscc_SeedResult* const out_seeds)
+{
+	assert(iscc_digraph_is_valid(nng));
+	assert(!iscc_digraph_is_empty(nng));
+	assert(nng->vertices > 1);
+	assert(out_seeds != NULL);
+	assert(out_seeds->capacity > 0);
+	assert(out_seeds->count == 0);
+	assert(out_seeds->seeds == NULL);
+
+	const size_t vertices = nng->vertices;
+	assert(vertices <= ISCC_POINTINDEX_MAX);
+	const scc_PointIndex vertices_pi = (scc_PointIndex) vertices; // If `scc_PointIndex` is signed
+
+	scc_ErrorCode ec;
+	iscc_Digraph nng_transpose;
+	if ((ec = iscc_digraph_transpose(nng, num_threads, &nng_transpose)) != SCC_ER_OK) return ec;
+	if (iscc_digraph_is_compressed(nng) && ((ec = iscc_digraph_compress(&nng_transpose)) != SCC_ER_OK)) {
+		iscc_free_digraph(&nng_transpose);
+		return ec;
+	}
+
+	iscc_DigraphRowReader nng_reader, transpose_reader;
+	ec = iscc_init_row_reader(nng, &nng_reader);
+	if (ec == SCC_ER_OK) {
+		ec = iscc_init_row_reader(&nng_transpose, &transpose_reader);
+		if (ec != SCC_ER_OK) iscc_free_row_reader(&nng_reader);
+	}
+	if (ec != SCC_ER_OK) {
+		iscc_free_digraph(&nng_transpose);
+		return ec;
+	}
+
+	iscc_fs_SortResult sort = {
+		.inwards_count = calloc(vertices, sizeof(scc_PointIndex)),
+		.sorted_vertices = malloc(sizeof(scc_PointIndex[vertices])),
+		.vertex_index = NULL,
+		.bucket_index = NULL,
+	};
+	iscc_BitsetWord* const not_excluded = iscc_digraph_tails_with_arcs(nng);
+	iscc_BitsetWord* const row_marks = iscc_bitset_alloc(vertices);
+	scc_PointIndex* const row = malloc(sizeof(scc_PointIndex[vertices]));
+	scc_PointIndex* const row_row = updating ? malloc(sizeof(scc_PointIndex[vertices])) : NULL;
+	if ((sort.inwards_count == NULL) || (sort.sorted_vertices == NULL) ||
+	        (not_excluded == NULL) || (row_marks == NULL) || (row == NULL) ||
+	        (updating && (row_row == NULL))) {
+		iscc_free_digraph(&nng_transpose);
+		iscc_free_row_reader(&nng_reader);
+		iscc_free_row_reader(&transpose_reader);
+		iscc_fs_free_sort_result(&sort);
+		free(not_excluded);
+		free(row_marks);
+		free(row);
+		free(row_row);
+		return iscc_make_error(SCC_ER_NO_MEMORY);
+	}
+
+	// Streaming pass for the inwards arc counts in the exclusion graph
+	for (scc_PointIndex v = 0; v < vertices_pi; ++v) {
+		const size_t len_row = iscc_fs_exclusion_row(v, nng, &nng_transpose, &nng_reader, &transpose_reader, row_marks, row);
+		// Rows are empty for vertices without arcs, but also when all arcs are loops
+		if (len_row > 0) iscc_bitset_set(not_excluded, (size_t) v);
+		for (size_t i = 0; i < len_row; ++i) {
+			++sort.inwards_count[row[i]];
+		}
+	}
+
+	if ((ec = iscc_fs_sort_by_count(vertices, updating, &sort)) != SCC_ER_OK) {
+		iscc_free_digraph(&nng_transpose);
+		iscc_free_row_reader(&nng_reader);
+		iscc_free_row_reader(&transpose_reader);
+		free(not_excluded);
+		free(row_marks);
+		free(row);
+		free(row_row);
+		return ec;
+	}
+
+	out_seeds->seeds = malloc(sizeof(scc_PointIndex[out_seeds->capacity]));
+	if (out_seeds->seeds == NULL) ec = iscc_make_error(SCC_ER_NO_MEMORY);
+
+	const scc_PointIndex* const sorted_v_stop = sort.sorted_vertices + vertices;
+	for (scc_PointIndex* sorted_v = sort.sorted_vertices;
+	        (ec == SCC_ER_OK) && (sorted_v != sorted_v_stop); ++sorted_v) {
+
+		#if defined(SCC_STABLE_FINDSEED) && !defined(NDEBUG)
+			if (updating) iscc_fs_debug_check_sort(sorted_v, sorted_v_stop - 1, sort.inwards_count);
+		#endif
+
+		if (!iscc_bitset_test(not_excluded, (size_t) *sorted_v)) continue;
+		assert(iscc_digraph_out_degree(nng, (size_t) *sorted_v) > 0);
+
+		if ((ec = iscc_fs_add_seed(*sorted_v, out_seeds)) != SCC_ER_OK) break;
+
+		iscc_bitset_clear(not_excluded, (size_t) *sorted_v);
+
+		const size_t len_row = iscc_fs_exclusion_row(*sorted_v, nng, &nng_transpose, &nng_reader, &transpose_reader, row_marks, row);
+		if (!updating) {
+			for (size_t i = 0; i < len_row; ++i) {
+				iscc_bitset_clear(not_excluded, (size_t) row[i]);
+			}
+
+		} else {
+			// As in `iscc_findseeds_exclusion`: first exclude the seed's neighbors (recording those
+			// not already excluded), then decrease the count of their non-excluded neighbors.
+			size_t len_newly_excluded = 0;
+			for (size_t i = 0; i < len_row; ++i) {
+				if (iscc_bitset_test(not_excluded, (size_t) row[i])) {
+					row[len_newly_excluded] = row[i];
+					++len_newly_excluded;
+				}
+				iscc_bitset_clear(not_excluded, (size_t) row[i]);
+			}
+
+			for (size_t i = 0; i < len_newly_excluded; ++i) {
+				const size_t len_row_row = iscc_fs_exclusion_row(row[i], nng, &nng_transpose, &nng_reader, &transpose_reader, row_marks, row_row);
+				for (size_t j = 0; j < len_row_row; ++j) {
+					if (iscc_bitset_test(not_excluded, (size_t) row_row[j])) {
+						iscc_fs_decrease_v_in_sort(row_row[j], sort.inwards_count, sort.vertex_index, sort.bucket_index, sorted_v);
+					}
+				}
+			}
+		}
+	}
+
+	iscc_free_digraph(&nng_transpose);
+	iscc_free_row_reader(&nng_reader);
+	iscc_free_row_reader(&transpose_reader);
+	iscc_fs_free_sort_result(&sort);
+	free(not_excluded);
+	free(row_marks);
+	free(row);
+	free(row_row);
+
+	if (ec != SCC_ER_OK) {
+		free(out_seeds->seeds);
+		out_seeds->seeds = NULL;
+		return ec;
+	}
+
+	return iscc_no_error();
+}
+
+
+/* Luby-style rounds with deterministic priorities. Two vertices are in conflict when
+ * their closed neighborhoods in `nng` intersect; the seeds must be a maximal independent
+ * set in this conflict graph (i.e., the exclusion graph). In each round, every undecided
+ * vertex that precedes all its undecided conflicting vertices becomes a seed, and the
+ * undecided vertices in conflict with the new seeds are excluded. The priorities are the
+ * inwards arc counts in `nng` or the edge counts in the exclusion graph, with ties broken
+ * by a hash of the vertex ID so that no long chains of ties arise in well-ordered data.
+ *
+ * Each round reads one array and writes the other, so vertices within a round can be
+ * processed in any order. The seeds do not depend on the number of threads.
+ */
+static scc_ErrorCode iscc_findseeds_parallel(const iscc_Digraph* const nng,
+                                             const bool exclusion,
+                                             const uint32_t num_threads,
+                                             iscc_SeedResult* const out_seeds)
+{
+	assert(iscc_digraph_is_valid(nng));
+	assert(!iscc_digraph_is_empty(nng));
+	assert(nng->vertices > 1);
+	assert(out_seeds != NULL);
+	assert(out_seeds->capacity > 0);
+	assert(out_seeds->count == 0);
+	assert(out_seeds->seeds == NULL);
+
+	#ifdef _OPENMP
+		int use_threads = omp_get_max_threads();
+		if (num_threads > 0) use_threads = (num_threads > INT_MAX) ? INT_MAX : (int) num_threads;
+	#else
+		(void) num_threads;
+	#endif // ifdef _OPENMP
+
+	const size_t vertices = nng->vertices;
+	assert(vertices <= ISCC_POINTINDEX_MAX);
+	const scc_PointIndex vertices_pi = (scc_PointIndex) vertices; // If `scc_PointIndex` is signed
+
+	uint8_t* const state = malloc(sizeof(uint8_t[vertices]));
+	// Not a bitset: threads write to neighboring entries concurrently
+	bool* const round_seeds = calloc(vertices, sizeof(bool));
+	scc_PointIndex* const active = malloc(sizeof(scc_PointIndex[vertices]));
+	iscc_BitsetWord* const has_arcs = iscc_digraph_tails_with_arcs(nng);
+	if ((state == NULL) || (round_seeds == NULL) || (active == NULL) || (has_arcs == NULL)) {
+		free(state);
+		free(round_seeds);
+		free(active);
+		free(has_arcs);
+		return iscc_make_error(SCC_ER_NO_MEMORY);
+	}
+
+	// Vertices without arcs in `nng` cannot be seeds
+	size_t len_active = 0;
+	for (scc_PointIndex v = 0; v < vertices_pi; ++v) {
+		if (iscc_bitset_test(has_arcs, (size_t) v)) {
+			state[v] = ISCC_FS_UNDECIDED;
+			active[len_active] = v;
+			++len_active;
+		} else {
+			state[v] = ISCC_FS_EXCLUDED;
+		}
+	}
+	free(has_arcs);
+
+	// Conflicts are found through `nng` and its transpose, unless the exclusion graph is
+	// materialized. Priorities are the inwards arc counts in `nng` or, with `exclusion`,
+	// the number of conflicts (i.e., the arcs in the exclusion graph).
+	scc_ErrorCode ec;
+	const bool materialize = exclusion && !iscc_digraph_is_compressed(nng);
+	iscc_Digraph conflict_graph;
+	if (materialize) {
+		const bool all_active = (len_active == vertices);
+		ec = iscc_fs_exclusion_graph(nng,
+		                             all_active ? 0 : len_active,
+		                             all_active ? NULL : active,
+		                             num_threads,
+		                             &conflict_graph);
+	} else {
+		ec = iscc_digraph_transpose(nng, num_threads, &conflict_graph);
+		if ((ec == SCC_ER_OK) && iscc_digraph_is_compressed(nng) &&
+		        ((ec = iscc_digraph_compress(&conflict_graph)) != SCC_ER_OK)) {
+			iscc_free_digraph(&conflict_graph);
+		}
+	}
+	if (ec != SCC_ER_OK) {
+		free(state);
+		free(round_seeds);
+		free(active);
+		return ec;
+	}
+
+	const iscc_Digraph* const first = materialize ? &conflict_graph : nng;
+	const iscc_Digraph* const second = materialize ? NULL : &conflict_graph;
+
+	// Two row readers per thread, as `iscc_fs_mis_find_conflict` reads rows from both graphs
+	#ifdef _OPENMP
+		const size_t num_readers = 2 * (size_t) use_threads;
+	#else
+		const size_t num_readers = 2;
+	#endif // ifdef _OPENMP
+	scc_PointIndex* const priority = calloc(vertices, sizeof(scc_PointIndex));
+	iscc_DigraphRowReader* const readers = calloc(num_readers, sizeof(iscc_DigraphRowReader));
+	if ((priority == NULL) || (readers == NULL)) ec = iscc_make_error(SCC_ER_NO_MEMORY);
+	for (size_t r = 0; (r < num_readers) && (ec == SCC_ER_OK); ++r) {
+		const bool read_second = ((r % 2) == 1) && (second != NULL);
+		ec = iscc_init_row_reader(read_second ? second : first, &readers[r]);
+	}
+
+	if (ec != SCC_ER_OK) {
+		// Nothing to do
+	} else if (materialize) {
+		for (scc_PointIndex v = 0; v < vertices_pi; ++v) {
+			priority[v] = (scc_PointIndex) iscc_digraph_out_degree(&conflict_graph, (size_t) v);
+		}
+	} else if (!exclusion) {
+		for (size_t v = 0; v < vertices; ++v) {
+			size_t len_v_row;
+			const scc_PointIndex* const v_row = iscc_digraph_read_row(nng, v, &readers[0], &len_v_row);
+			for (size_t i = 0; i < len_v_row; ++i) {
+				++priority[v_row[i]];
+			}
+		}
+	} else {
+		iscc_BitsetWord* const row_marks = iscc_bitset_alloc(vertices);
+		scc_PointIndex* const row = malloc(sizeof(scc_PointIndex[vertices]));
+		if ((row_marks == NULL) || (row == NULL)) {
+			ec = iscc_make_error(SCC_ER_NO_MEMORY);
+		} else {
+			for (scc_PointIndex v = 0; v < vertices_pi; ++v) {
+				priority[v] = (scc_PointIndex) iscc_fs_exclusion_row(v, nng, &conflict_graph, &readers[0], &readers[1], row_marks, row);
+			}
+		}
+		free(row_marks);
+		free(row);
+	}
+
+	out_seeds->seeds = malloc(sizeof(scc_PointIndex[out_seeds->capacity]));
+	if (out_seeds->seeds == NULL) ec = iscc_make_error(SCC_ER_NO_MEMORY);
+
+	while ((ec == SCC_ER_OK) && (len_active > 0)) {
+		#ifdef _OPENMP
+			#pragma omp parallel for schedule(guided) num_threads(use_threads)
+		#endif // ifdef _OPENMP
+		for (size_t i = 0; i < len_active; ++i) {
+			#ifdef _OPENMP
+				iscc_DigraphRowReader* const thread_readers = readers + 2 * ((size_t) omp_get_thread_num());
+			#else
+				iscc_DigraphRowReader* const thread_readers = readers;
+			#endif // ifdef _OPENMP
+			const scc_PointIndex v = active[i];
+			round_seeds[v] = !iscc_fs_mis_find_conflict(v, first, second, thread_readers, priority, state, NULL);
+		}
+
+		#ifdef _OPENMP
+			#pragma omp parallel for schedule(guided) num_threads(use_threads)
+		#endif // ifdef _OPENMP
+		for (size_t i = 0; i < len_active; ++i) {
+			#ifdef _OPENMP
+				iscc_DigraphRowReader* const thread_readers = readers + 2 * ((size_t) omp_get_thread_num());
+			#else
+				iscc_DigraphRowReader* const thread_readers = readers;
+			#endif // ifdef _OPENMP
+			const scc_PointIndex v = active[i];
+			if (round_seeds[v]) {
+				state[v] = ISCC_FS_SEED;
+			} else if (iscc_fs_mis_find_conflict(v, first, second, thread_readers, priority, state, round_seeds)) {
+				state[v] = ISCC_FS_EXCLUDED;
+			}
+		}
+
+		size_t write_active = 0;
+		for (size_t i = 0; (i < len_active) && (ec == SCC_ER_OK); ++i) {
+			const scc_PointIndex v = active[i];
+			if (state[v] == ISCC_FS_SEED) {
+				ec = iscc_fs_add_seed(v, out_seeds);
+			} else if (state[v] == ISCC_FS_UNDECIDED) {
+				active[write_active] = v;
+				++write_active;
+			}
+		}
+		assert((ec != SCC_ER_OK) || (write_active < len_active));
+		len_active = write_active;
+	}
+
+	if (readers != NULL) {
+		for (size_t r = 0; r < num_readers; ++r) {
+			iscc_free_row_reader(&readers[r]);
+		}
+	}
+	free(readers);
+	free(priority);
+	free(state);
+	free(round_seeds);
+	free(active);
+	iscc_free_digraph(&conflict_graph);
+
+	if (ec != SCC_ER_OK) {
+		free(out_seeds->seeds);
+		out_seeds->seeds = NULL;
+		return ec;
+	}
+
+	return iscc_no_error();
+}
+
+
 /*
 Exclusion graph does not give one arc optimality
 
@@ -457,6 +941,7 @@ bool iscc_findseeds_onearc_updating(const scc_Digraph* const nng, ...) {
 static scc_ErrorCode iscc_fs_exclusion_graph(const iscc_Digraph* const nng,
                                              const size_t len_not_excluded,
                                              const scc_PointIndex not_excluded[const],
+                                             const uint32_t num_threads,
                                              iscc_Digraph* const out_dg)
 {
 	assert(iscc_digraph_is_valid(nng));
@@ -466,12 +951,12 @@ static scc_ErrorCode iscc_fs_exclusion_graph(const iscc_Digraph* const nng,
 	scc_ErrorCode ec;
 
 	iscc_Digraph nng_transpose;
-	ec = iscc_digraph_transpose(nng, &nng_transpose);
+	ec = iscc_digraph_transpose(nng, num_threads, &nng_transpose);
 	if (ec != SCC_ER_OK) return ec;
 	assert(!iscc_digraph_is_empty(&nng_transpose));
 
 	iscc_Digraph nng_nng_transpose;
-	ec = iscc_adjacency_product(nng, &nng_transpose, true, &nng_nng_transpose);
+	ec = iscc_adjacency_product(nng, &nng_transpose, true, num_threads, &nng_nng_transpose);
 	iscc_free_digraph(&nng_transpose);
 	if (ec != SCC_ER_OK) return ec;
 
@@ -483,7 +968,7 @@ static scc_ErrorCode iscc_fs_exclusion_graph(const iscc_Digraph* const nng,
 	 * by calling `iscc_digraph_union_and_delete` with `not_excluded`.
 	 */
 	const iscc_Digraph nng_sum[2] = { *nng, nng_nng_transpose };
-	ec = iscc_digraph_union_and_delete(2, nng_sum, len_not_excluded, not_excluded, false, out_dg);
+	ec = iscc_digraph_union_and_delete(2, nng_sum, len_not_excluded, not_excluded, false, num_threads, out_dg);
 	iscc_free_digraph(&nng_nng_transpose);
 	if (ec != SCC_ER_OK) return ec;
 
@@ -491,6 +976,74 @@ static scc_ErrorCode iscc_fs_exclusion_graph(const iscc_Digraph* const nng,
 }
 
 
+/* Writes the arcs of `v` in the exclusion graph made by `iscc_fs_exclusion_graph` to
+ * `out_row`, in the same order, and returns their number. `row_marks` must be a cleared
+ * bitset, and is so again on return. `out_row` must have room for `nng->vertices` vertices.
+ */
+static inline size_t iscc_fs_exclusion_row(const scc_PointIndex v,
+                                           const iscc_Digraph* const nng,
+                                           const iscc_Digraph* const nng_transpose,
+                                           iscc_DigraphRowReader* const nng_reader,
+                                           iscc_DigraphRowReader* const transpose_reader,
+                                           iscc_BitsetWord row_marks[restrict const],
+                                           scc_PointIndex out_row[restrict const])
+{
+	size_t len_v_row;
+	const scc_PointIndex* const v_row = iscc_digraph_read_row(nng, (size_t) v, nng_reader, &len_v_row);
+
+	// Vertices without arcs cannot be seeds, and have no arcs in the exclusion graph
+	if (len_v_row == 0) return 0;
+
+	size_t len_row = 0;
+	iscc_bitset_set(row_marks, (size_t) v);
+
+	// Union of `nng` and `nng * transpose(nng)` (with loops forced in `nng`)
+	const scc_PointIndex* const v_arc_stop = v_row + len_v_row;
+	for (const scc_PointIndex* v_arc = v_row;
+	        v_arc != v_arc_stop; ++v_arc) {
+		if (!iscc_bitset_test(row_marks, (size_t) *v_arc)) {
+			iscc_bitset_set(row_marks, (size_t) *v_arc);
+			out_row[len_row] = *v_arc;
+			++len_row;
+		}
+	}
+
+	size_t len_v_trow;
+	const scc_PointIndex* const v_trow = iscc_digraph_read_row(nng_transpose, (size_t) v, transpose_reader, &len_v_trow);
+	const scc_PointIndex* const v_tarc_stop = v_trow + len_v_trow;
+	for (const scc_PointIndex* v_tarc = v_trow;
+	        v_tarc != v_tarc_stop; ++v_tarc) {
+		if (!iscc_bitset_test(row_marks, (size_t) *v_tarc)) {
+			iscc_bitset_set(row_marks, (size_t) *v_tarc);
+			out_row[len_row] = *v_tarc;
+			++len_row;
+		}
+	}
+
+	for (const scc_PointIndex* v_arc = v_row;
+	        v_arc != v_arc_stop; ++v_arc) {
+		size_t len_trow;
+		const scc_PointIndex* const trow = iscc_digraph_read_row(nng_transpose, (size_t) *v_arc, transpose_reader, &len_trow);
+		const scc_PointIndex* const tarc_stop = trow + len_trow;
+		for (const scc_PointIndex* tarc = trow;
+		        tarc != tarc_stop; ++tarc) {
+			if (!iscc_bitset_test(row_marks, (size_t) *tarc)) {
+				iscc_bitset_set(row_marks, (size_t) *tarc);
+				out_row[len_row] = *tarc;
+				++len_row;
+			}
+		}
+	}
+
+	iscc_bitset_clear(row_marks, (size_t) v);
+	for (size_t i = 0; i < len_row; ++i) {
+		iscc_bitset_clear(row_marks, (size_t) out_row[i]);
+	}
+
+	return len_row;
+}
+
+
 static inline scc_ErrorCode iscc_fs_add_seed(const scc_PointIndex s,
                                              iscc_SeedResult* const seed_result)
 {
@@ -519,17 +1072,18 @@ static inline scc_ErrorCode iscc_fs_add_seed(const scc_PointIndex s,
 
 
 static inline bool iscc_fs_check_neighbors_marks(const scc_PointIndex v,
-                                                 const iscc_Digraph* const nng,
-                                                 const bool marks[const static nng->vertices])
+                                                 const scc_PointIndex v_row[const],
+                                                 const size_t len_v_row,
+                                                 const iscc_BitsetWord marks[const])
 {
-	if (marks[v]) return false;
+	if (iscc_bitset_test(marks, (size_t) v)) return false;
+	if (len_v_row == 0) return false;
 
-	const scc_PointIndex* v_arc = nng->head + nng->tail_ptr[v];
-	const scc_PointIndex* const v_arc_stop = nng->head + nng->tail_ptr[v + 1];
-	if (v_arc == v_arc_stop) return false;
+	const scc_PointIndex* v_arc = v_row;
+	const scc_PointIndex* const v_arc_stop = v_row + len_v_row;
 
 	for (; v_arc != v_arc_stop; ++v_arc) {
-		if (marks[*v_arc]) return false;
+		if (iscc_bitset_test(marks, (size_t) *v_arc)) return false;
 	}
 
 	return true;
@@ -537,19 +1091,97 @@ static inline bool iscc_fs_check_neighbors_marks(const scc_PointIndex v,
 
 
 static inline void iscc_fs_mark_seed_neighbors(const scc_PointIndex s,
-                                               const iscc_Digraph* const nng,
-                                               bool marks[const static nng->vertices])
+                                               const scc_PointIndex s_row[const],
+                                               const size_t len_s_row,
+                                               iscc_BitsetWord marks[const])
 {
-	assert(!marks[s]);
+	assert(!iscc_bitset_test(marks, (size_t) s));
 
-	const scc_PointIndex* const s_arc_stop = nng->head + nng->tail_ptr[s + 1];
-	for (const scc_PointIndex* s_arc = nng->head + nng->tail_ptr[s];
+	const scc_PointIndex* const s_arc_stop = s_row + len_s_row;
+	for (const scc_PointIndex* s_arc = s_row;
 	        s_arc != s_arc_stop; ++s_arc) {
-		assert(!marks[*s_arc]);
-		marks[*s_arc] = true;
+		assert(!iscc_bitset_test(marks, (size_t) *s_arc));
+		iscc_bitset_set(marks, (size_t) *s_arc);
 	}
 
-	marks[s] = true; // Mark seed last, if there're self-loops
+	iscc_bitset_set(marks, (size_t) s); // Mark seed last, if there're self-loops
+}
+
+
+static inline uint64_t iscc_fs_mis_tiebreak(const scc_PointIndex v)
+{
+	// Bijective mix (splitmix64 finalizer), so no two vertices tie
+	uint64_t z = (uint64_t) v;
+	z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+	z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+	return z ^ (z >> 31);
+}
+
+
+static inline bool iscc_fs_mis_before(const scc_PointIndex u,
+                                      const scc_PointIndex v,
+                                      const scc_PointIndex priority[const])
+{
+	if (priority[u] != priority[v]) return (priority[u] < priority[v]);
+	return (iscc_fs_mis_tiebreak(u) < iscc_fs_mis_tiebreak(v));
+}
+
+
+// Without `round_seeds`, undecided vertices that precede `v` block it from becoming a seed.
+// With `round_seeds`, the seeds found in the current round block it.
+static inline bool iscc_fs_mis_blocks(const scc_PointIndex u,
+                                      const scc_PointIndex v,
+                                      const scc_PointIndex priority[const],
+                                      const uint8_t state[const],
+                                      const bool round_seeds[const])
+{
+	if (u == v) return false;
+	if (round_seeds != NULL) return round_seeds[u];
+	return (state[u] == ISCC_FS_UNDECIDED) && iscc_fs_mis_before(u, v, priority);
+}
+
+
+// The vertices in conflict with `v` are its arcs in `first` and, if `second` is not NULL,
+// the arcs in `second` of `v` and of the heads of its arcs in `first`. Rows of `first` are
+// read with `readers[0]` and rows of `second` with `readers[1]`.
+static inline bool iscc_fs_mis_find_conflict(const scc_PointIndex v,
+                                             const iscc_Digraph* const first,
+                                             const iscc_Digraph* const second,
+                                             iscc_DigraphRowReader readers[const],
+                                             const scc_PointIndex priority[const],
+                                             const uint8_t state[const],
+                                             const bool round_seeds[const])
+{
+	size_t len_v_row;
+	const scc_PointIndex* const v_row = iscc_digraph_read_row(first, (size_t) v, &readers[0], &len_v_row);
+	const scc_PointIndex* const v_arc_stop = v_row + len_v_row;
+	for (const scc_PointIndex* v_arc = v_row;
+	        v_arc != v_arc_stop; ++v_arc) {
+		if (iscc_fs_mis_blocks(*v_arc, v, priority, state, round_seeds)) return true;
+	}
+
+	if (second != NULL) {
+		size_t len_v_srow;
+		const scc_PointIndex* const v_srow = iscc_digraph_read_row(second, (size_t) v, &readers[1], &len_v_srow);
+		const scc_PointIndex* const v_sarc_stop = v_srow + len_v_srow;
+		for (const scc_PointIndex* v_sarc = v_srow;
+		        v_sarc != v_sarc_stop; ++v_sarc) {
+			if (iscc_fs_mis_blocks(*v_sarc, v, priority, state, round_seeds)) return true;
+		}
+
+		for (const scc_PointIndex* v_arc = v_row;
+		        v_arc != v_arc_stop; ++v_arc) {
+			size_t len_srow;
+			const scc_PointIndex* const srow = iscc_digraph_read_row(second, (size_t) *v_arc, &readers[1], &len_srow);
+			const scc_PointIndex* const sarc_stop = srow + len_srow;
+			for (const scc_PointIndex* sarc = srow;
+			        sarc != sarc_stop; ++sarc) {
+				if (iscc_fs_mis_blocks(*sarc, v, priority, state, round_seeds)) return true;
+			}
+		}
+	}
+
+	return false;
 }
 
 
@@ -587,10 +1219,37 @@ static scc_ErrorCode iscc_fs_sort_by_inwards(const iscc_Digraph* const nng,
 		return iscc_make_error(SCC_ER_NO_MEMORY);
 	}
 
-	const scc_PointIndex* const arc_stop = nng->head + nng->tail_ptr[vertices];
-	for (const scc_PointIndex* arc = nng->head; arc != arc_stop; ++arc) {
-		++out_sort->inwards_count[*arc];
+	iscc_DigraphRowReader reader;
+	scc_ErrorCode ec;
+	if ((ec = iscc_init_row_reader(nng, &reader)) != SCC_ER_OK) {
+		iscc_fs_free_sort_result(out_sort);
+		return ec;
+	}
+	for (size_t v = 0; v < vertices; ++v) {
+		size_t len_v_row;
+		const scc_PointIndex* const v_row = iscc_digraph_read_row(nng, v, &reader, &len_v_row);
+		for (size_t i = 0; i < len_v_row; ++i) {
+			++out_sort->inwards_count[v_row[i]];
+		}
 	}
+	iscc_free_row_reader(&reader);
+
+	return iscc_fs_sort_by_count(vertices, make_indices, out_sort);
+}
+
+
+// Bucket sorts the vertices by `sort->inwards_count`, which must be filled. `sort->sorted_vertices`
+// must be allocated. Frees `sort` on error.
+static scc_ErrorCode iscc_fs_sort_by_count(const size_t vertices,
+                                           const bool make_indices,
+                                           iscc_fs_SortResult* const out_sort)
+{
+	assert(vertices > 1);
+	assert(out_sort != NULL);
+	assert(out_sort->inwards_count != NULL);
+	assert(out_sort->sorted_vertices != NULL);
+	assert(out_sort->vertex_index == NULL);
+	assert(out_sort->bucket_index == NULL);
 
 	// Dynamic alloc is slightly faster but more error-prone
 	// Add if turns out to be bottleneck
@@ -22,6 +22,7 @@
 #define SCC_NNG_FINDSEEDS_HG
 
 #include <stddef.h>
+#include <stdint.h>
 #include "../include/scclust.h"
 #include "digraph_core.h"
 #include "scclust_types.h"
@@ -44,6 +45,7 @@ typedef struct iscc_SeedResult {
 
 scc_ErrorCode iscc_find_seeds(const iscc_Digraph* nng,
                               scc_SeedMethod seed_method,
+                              uint32_t num_threads,
                               iscc_SeedResult* out_seeds);
 
 
@@ -30,7 +30,7 @@
 // =============================================================================
 
 // See "dist_search.h" for definition
-iscc_dist_functions_struct iscc_dist_functions = {
+scc_DistFunctions iscc_dist_functions = {
 	.check_data_set = iscc_imp_check_data_set,
 	.num_data_points = iscc_imp_num_data_points,
 	.get_dist_matrix = iscc_imp_get_dist_matrix,
@@ -50,7 +50,7 @@ iscc_dist_functions_struct iscc_dist_functions = {
 
 bool scc_reset_dist_functions(void)
 {
-	iscc_dist_functions = (iscc_dist_functions_struct) {
+	iscc_dist_functions = (scc_DistFunctions) {
 		.check_data_set = iscc_imp_check_data_set,
 		.num_data_points = iscc_imp_num_data_points,
 		.get_dist_matrix = iscc_imp_get_dist_matrix,
@@ -43,7 +43,7 @@
  */
 static const scc_ClusteringStats ISCC_NULL_CLUSTERING_STATS = { 0, 0, 0, 0, 0, 0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
 
-static const int32_t ISCC_OPTIONS_STRUCT_VERSION = 722678001;
+static const int32_t ISCC_OPTIONS_STRUCT_VERSION = 722678002;
 
 
 // =============================================================================
@@ -71,6 +71,8 @@ scc_ClusterOptions scc_get_default_options(void)
 		.secondary_radius = SCC_RM_USE_SEED_RADIUS,
 		.secondary_supplied_radius = 0.0,
 		.batch_size = 0,
+		.num_threads = 0,
+		.compress_digraphs = false,
 	};
 }
 
@@ -373,7 +375,9 @@ scc_ErrorCode iscc_check_cluster_options(const scc_ClusterOptions* const options
 			(options->seed_method != SCC_SM_INWARDS_ORDER) &&
 			(options->seed_method != SCC_SM_INWARDS_UPDATING) &&
 			(options->seed_method != SCC_SM_EXCLUSION_ORDER) &&
-			(options->seed_method != SCC_SM_EXCLUSION_UPDATING)) {
+			(options->seed_method != SCC_SM_EXCLUSION_UPDATING) &&
+			(options->seed_method != SCC_SM_INWARDS_PARALLEL) &&
+			(options->seed_method != SCC_SM_EXCLUSION_PARALLEL)) {
 		return iscc_make_error_msg(SCC_ER_INVALID_INPUT, "Unknown seed method.");
 	}
 	if ((options->primary_data_points != NULL) && (options->len_primary_data_points == 0)) {
@@ -98,7 +98,10 @@ typedef enum scc_ErrorCode {
 /** Get latest scclust error.
  *
  *  Writes a description of the latest error prroduced by the library to the
- *  supplied buffer.
+ *  supplied buffer. Errors are recorded per thread, so the description refers
+ *  to the latest error in the calling thread. This requires a thread-local storage
+ *  class; with compilers that scclust does not recognize, the library must be built
+ *  with `ISCC_THREAD_LOCAL` defined as that class.
  *
  *  \param[in] len_error_message_buffer the length of the buffer #error_message_buffer.
  *  \param[out] error_message_buffer the buffer to write to.
@@ -181,6 +184,10 @@ typedef struct scc_DataSet scc_DataSet;
  *  \param[out] out_data_set double pointer to where to write the data set reference.
  *
  *  \return #scc_ErrorCode describing eventual error.
+ *
+ *  \note #data_matrix is not copied. It must not be modified or freed while the
+ *        data set is in use, as derived quantities (e.g., squared norms of the
+ *        data points) are cached when the data set is constructed.
  */
 scc_ErrorCode scc_init_data_set(uint64_t num_data_points,
                                 uint32_t num_dimensions,
@@ -189,6 +196,30 @@ scc_ErrorCode scc_init_data_set(uint64_t num_data_points,
                                 scc_DataSet** out_data_set);
 
 
+/** Construct new data set from single-precision raw data.
+ *
+ *  Creates a #scc_DataSet based on supplied raw data stored as `float`. The data
+ *  set behaves as one constructed by #scc_init_data_set with the same values
+ *  converted to `double`; distances are accumulated in double precision.
+ *
+ *  \param[in] num_data_points the number of data points in the data set.
+ *  \param[in] num_dimensions the number of dimensions for each data point.
+ *  \param[in] len_data_matrix the length of #data_matrix.
+ *  \param[in] data_matrix the raw data, ordered as in #scc_init_data_set.
+ *  \param[out] out_data_set double pointer to where to write the data set reference.
+ *
+ *  \return #scc_ErrorCode describing eventual error.
+ *
+ *  \note #data_matrix is not copied. It must not be modified or freed while the
+ *        data set is in use.
+ */
+scc_ErrorCode scc_init_data_set_f32(uint64_t num_data_points,
+                                    uint32_t num_dimensions,
+                                    size_t len_data_matrix,
+                                    const float data_matrix[],
+                                    scc_DataSet** out_data_set);
+
+
 /** Free data set.
  *
  *  Frees a #scc_DataSet previously allocated by #scc_init_data_set.
@@ -310,7 +341,24 @@ typedef enum scc_SeedMethod {
 	 *  and find seeds in ascending order by this count. Unlike the #SCC_SM_EXCLUSION_ORDER, this method updates the edge count after finding a
 	 *  seed so that only edges where the tails that still can become seeds are counted.
 	 */
-	SCC_SM_EXCLUSION_UPDATING
+	SCC_SM_EXCLUSION_UPDATING,
+
+	/** Find seeds in parallel rounds, prioritized by inwards pointing arcs.
+	 *
+	 *  Like #SCC_SM_INWARDS_ORDER, vertices with fewer inwards pointing arcs are preferred as seeds. Instead of considering
+	 *  one vertex at the time, this method finds seeds in rounds (as in Luby's algorithm for maximal independent sets): in each round,
+	 *  all vertices that are preferred over all other remaining vertices they exclude become seeds. Ties are broken by a fixed hash of
+	 *  the vertex IDs. The rounds are run in parallel when scclust is compiled with OpenMP (see `num_threads` in #scc_ClusterOptions).
+	 *  The seeds do not depend on the number of threads.
+	 */
+	SCC_SM_INWARDS_PARALLEL,
+
+	/** Find seeds in parallel rounds, prioritized by edge count in the exclusion graph.
+	 *
+	 *  Like #SCC_SM_EXCLUSION_ORDER, vertices with fewer edges in the exclusion graph are preferred as seeds. The seeds are found in
+	 *  parallel rounds as described for #SCC_SM_INWARDS_PARALLEL.
+	 */
+	SCC_SM_EXCLUSION_PARALLEL
 
 } scc_SeedMethod;
 
@@ -335,7 +383,7 @@ typedef struct scc_ClusterOptions {
 	/** scc_ClusterOptions struct version
 	 *
 	 *  \note
-	 *  This must be set to "722678001".
+	 *  This must be set to "722678002".
 	 */
 	int32_t options_version;
 	uint32_t size_constraint;
@@ -355,6 +403,24 @@ typedef struct scc_ClusterOptions {
 	scc_RadiusMethod secondary_radius;
 	double secondary_supplied_radius;
 	uint32_t batch_size;
+
+	/** Number of threads used to construct the nearest neighbor graph.
+	 *
+	 *  With #SCC_SM_BATCHES, the threads search the next batch while the current batch is assigned.
+	 *  Zero uses the OpenMP default. The option has no effect unless scclust is compiled
+	 *  with `--enable-openmp`. The derived clustering does not depend on this option.
+	 */
+	uint32_t num_threads;
+
+	/** Store the nearest neighbor graph compressed.
+	 *
+	 *  When `true`, the arcs of the nearest neighbor graph (and of digraphs derived from it when finding seeds)
+	 *  are stored delta and varint encoded, which typically uses a quarter of the memory or less. Reading the
+	 *  graph is somewhat slower. As the arcs are sorted by vertex ID when compressed, #SCC_SM_INWARDS_UPDATING,
+	 *  #SCC_SM_EXCLUSION_UPDATING and #SCC_UM_ANY_NEIGHBOR may break ties differently, and #SCC_UM_CLOSEST_ASSIGNED
+	 *  always uses a nearest neighbor search. The option has no effect with #SCC_SM_BATCHES.
+	 */
+	bool compress_digraphs;
 } scc_ClusterOptions;
 
 
@@ -372,6 +438,85 @@ scc_ErrorCode scc_hierarchical_clustering(void* data_set,
                                           scc_Clustering* out_clustering);
 
 
+// =============================================================================
+// Cluster tree object
+// =============================================================================
+
+/// Type used for the split trees of hierarchical clusterings
+typedef struct scc_ClusterTree scc_ClusterTree;
+
+
+/** Hierarchical clustering that keeps the split tree.
+ *
+ *  Derives the same clustering as #scc_hierarchical_clustering and records the splits
+ *  that made it in a #scc_ClusterTree. The tree can be cut with #scc_cut_cluster_tree
+ *  to get clusterings for larger size constraints without splitting the data again.
+ *
+ *  \param[in] data_set the data set to cluster.
+ *  \param[in] size_constraint the smallest size constraint the tree is used for.
+ *  \param[in] batch_assign as in #scc_hierarchical_clustering.
+ *  \param[in,out] out_clustering as in #scc_hierarchical_clustering.
+ *  \param[out] out_tree double pointer to where to write the tree reference.
+ *
+ *  \return #scc_ErrorCode describing eventual error.
+ */
+scc_ErrorCode scc_hierarchical_clustering_tree(void* data_set,
+                                               uint32_t size_constraint,
+                                               bool batch_assign,
+                                               scc_Clustering* out_clustering,
+                                               scc_ClusterTree** out_tree);
+
+
+/** Cut cluster tree.
+ *
+ *  Derives a clustering from a #scc_ClusterTree in linear time. Starting from the roots,
+ *  a node is replaced by its children as long as both children contain at least
+ *  #size_constraint data points. The remaining nodes are the clusters.
+ *
+ *  Cutting with the size constraint the tree was built with gives the clustering derived
+ *  when the tree was built. Larger size constraints give coarser clusterings that satisfy
+ *  the constraint, but they are generally not the same as the clustering that
+ *  #scc_hierarchical_clustering derives with the larger constraint, as the splits are those
+ *  made for the smaller constraint. Size constraints smaller than the one the tree was
+ *  built with give the same clustering as the tree's own constraint.
+ *
+ *  The roots are the clusters the tree was built from (a single root with all data points
+ *  unless the tree was built from an existing clustering). Roots are never merged, so if a
+ *  non-empty root has fewer than #size_constraint data points, no cut satisfies the
+ *  constraint and #SCC_ER_INVALID_INPUT is returned.
+ *
+ *  \param[in] tree the tree to cut.
+ *  \param[in] size_constraint the size constraint of the clustering.
+ *  \param[out] out_clustering clustering to write the labels to. Data points not in the tree
+ *                             are labeled #SCC_CLABEL_NA.
+ *
+ *  \return #scc_ErrorCode describing eventual error.
+ */
+scc_ErrorCode scc_cut_cluster_tree(const scc_ClusterTree* tree,
+                                   uint32_t size_constraint,
+                                   scc_Clustering* out_clustering);
+
+
+/** Free cluster tree.
+ *
+ *  Frees a #scc_ClusterTree previously allocated by #scc_hierarchical_clustering_tree.
+ *
+ *  \param[in,out] tree double pointer to a #scc_ClusterTree object to free.
+ */
+void scc_free_cluster_tree(scc_ClusterTree** tree);
+
+
+/** Check cluster tree.
+ *
+ *  Checks whether inputted cluster tree is properly initialized.
+ *
+ *  \param[in] tree pointer to a #scc_ClusterTree object to check.
+ *
+ *  \return \c true if #tree is initialized, otherwise \c false.
+ */
+bool scc_is_initialized_cluster_tree(const scc_ClusterTree* tree);
+
+
 // =============================================================================
 // Utility functions
 // =============================================================================
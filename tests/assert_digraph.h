@@ -58,8 +58,12 @@ void _assert_free_digraph(iscc_Digraph* test_dg,
 		print_error("%s is already freed\n", name_dg);
 		_fail(file, line);
 	} else {
-		for (size_t i = 0; i <= test_dg->vertices; ++i) test_dg->tail_ptr[i] = 1;
-		for (size_t i = 0; i < test_dg->max_arcs; ++i) test_dg->head[i] = 1;
+		if (test_dg->tail_ptr != NULL) {
+			for (size_t i = 0; i <= test_dg->vertices; ++i) test_dg->tail_ptr[i] = 1;
+		}
+		if (test_dg->head != NULL) {
+			for (size_t i = 0; i < test_dg->max_arcs; ++i) test_dg->head[i] = 1;
+		}
 	}
 	iscc_free_digraph(test_dg);
 }
@@ -131,11 +135,14 @@ void _assert_identical_digraph(const iscc_Digraph* test_dg1,
 	if (is_identical && test_dg1->vertices != test_dg2->vertices) is_identical = false;
 
 	if (is_identical) {
-		if (!test_dg1->tail_ptr != !test_dg2->tail_ptr) {
+		// Fixed-degree digraphs are identical to sparse matrices with the same row layout
+		const bool has_rows1 = (test_dg1->tail_ptr != NULL) || iscc_digraph_is_fixed(test_dg1);
+		const bool has_rows2 = (test_dg2->tail_ptr != NULL) || iscc_digraph_is_fixed(test_dg2);
+		if (has_rows1 != has_rows2) {
 			is_identical = false;
-		} else if (test_dg1->tail_ptr) {
+		} else if (has_rows1) {
 			for (size_t i = 0; i < test_dg1->vertices + 1; ++i) {
-				if (test_dg1->tail_ptr[i] != test_dg2->tail_ptr[i]) {
+				if (iscc_digraph_row_begin(test_dg1, i) != iscc_digraph_row_begin(test_dg2, i)) {
 					is_identical = false;
 					break;
 				}
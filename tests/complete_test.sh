@@ -17,7 +17,7 @@ run_tests()
 		exit 1
 	fi
 	cd ..
-	./run_tests.sh -k $1 $STRESS &> tmp_output_results
+	./run_tests.sh -k $1 $STRESS $OPENMP &> tmp_output_results
 	if [ "$?" != "0" ]; then
 		printf "${REDCOLOR}*** TEST SUITE FAILED, ABORTING:${NOCOLOR}\n"
 		printf "$(cat tmp_output_results)\n"
@@ -34,9 +34,15 @@ STANDARD_FLAGS="
 	--disable-documentation"
 
 STRESS=
+OPENMP=
 
 while [ "$1" != "" ]; do
 	case $1 in
+		-o )
+			printf "${REDCOLOR}Running OpenMP tests.${NOCOLOR}\n"
+			STANDARD_FLAGS="$STANDARD_FLAGS --enable-openmp"
+			OPENMP=-o
+			;;
 		-s )
 			printf "${REDCOLOR}Running stress tests.${NOCOLOR}\n"
 			STRESS=-s
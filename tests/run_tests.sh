@@ -14,6 +14,7 @@ run_test()
 
 STRESS="false"
 ANN="N"
+OPENMP="N"
 KEEP_SCC_BUILD="false"
 
 while [ "$1" != "" ]; do
@@ -24,6 +25,10 @@ while [ "$1" != "" ]; do
 			;;
 		-k )
 			KEEP_SCC_BUILD="true" ;;
+		-o )
+			OPENMP="Y"
+			printf "${REDCOLOR}Running OpenMP tests.${NOCOLOR}\n"
+			;;
 		-s )
 			STRESS="true"
 			printf "${REDCOLOR}Running stress tests.${NOCOLOR}\n"
@@ -40,13 +45,15 @@ make clean
 if [ "$KEEP_SCC_BUILD" = "false" ]; then
 	rm -rf scc_build
 fi
-make all ANN_SEARCH=$ANN
+make all ANN_SEARCH=$ANN OPENMP=$OPENMP
 
+run_test test_bitset
 run_test test_data_set
 run_test test_digraph_core
 run_test test_digraph_debug
 run_test test_digraph_operations_internal
 run_test test_digraph_operations
+run_test test_dist_kernels
 run_test test_dist_search
 run_test test_error
 run_test test_hierarchical_clustering_internal
@@ -61,6 +68,7 @@ run_test test_nng_core
 run_test test_nng_findseeds_internal
 run_test test_nng_findseeds_stable
 run_test test_nng_findseeds
+run_test test_openmp
 run_test test_scclust
 
 if [ "$STRESS" = "true" ]; then
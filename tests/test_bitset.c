@@ -0,0 +1,127 @@
+/* =============================================================================
+ * scclust -- A C library for size-constrained clustering
+ * https://github.com/fsavje/scclust
+ *
+ * Copyright (C) 2015-2017  Fredrik Savje -- http://fredriksavje.com
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see http://www.gnu.org/licenses/
+ * ========================================================================== */
+
+#include "init_test.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <src/bitset.h>
+
+
+void scc_ut_bitset_set_clear(void** state)
+{
+	(void) state;
+
+	assert_int_equal(iscc_bitset_num_words(0), 0);
+	assert_int_equal(iscc_bitset_num_words(1), 1);
+	assert_int_equal(iscc_bitset_num_words(64), 1);
+	assert_int_equal(iscc_bitset_num_words(65), 2);
+
+	iscc_BitsetWord* const bitset = iscc_bitset_alloc(130);
+	assert_non_null(bitset);
+	assert_int_equal(iscc_bitset_count(bitset, 130), 0);
+
+	iscc_bitset_set(bitset, 0);
+	iscc_bitset_set(bitset, 63);
+	iscc_bitset_set(bitset, 64);
+	iscc_bitset_set(bitset, 129);
+	iscc_bitset_assign(bitset, 100, true);
+	iscc_bitset_assign(bitset, 101, false);
+	for (size_t i = 0; i < 130; ++i) {
+		assert_int_equal(iscc_bitset_test(bitset, i), (i == 0) || (i == 63) || (i == 64) || (i == 100) || (i == 129));
+	}
+	assert_int_equal(iscc_bitset_count(bitset, 130), 5);
+
+	iscc_bitset_clear(bitset, 63);
+	iscc_bitset_assign(bitset, 100, false);
+	iscc_bitset_clear(bitset, 1);
+	assert_false(iscc_bitset_test(bitset, 63));
+	assert_false(iscc_bitset_test(bitset, 100));
+	assert_true(iscc_bitset_test(bitset, 64));
+	assert_int_equal(iscc_bitset_count(bitset, 130), 3);
+
+	free(bitset);
+
+	iscc_BitsetWord* const empty = iscc_bitset_alloc(0);
+	assert_non_null(empty);
+	free(empty);
+}
+
+
+void scc_ut_bitset_next(void** state)
+{
+	(void) state;
+
+	iscc_BitsetWord* const bitset = iscc_bitset_alloc(200);
+	assert_non_null(bitset);
+
+	assert_int_equal(iscc_bitset_next_set(bitset, 200, 0), 200);
+	assert_int_equal(iscc_bitset_next_clear(bitset, 200, 0), 0);
+	assert_int_equal(iscc_bitset_next_clear(bitset, 200, 199), 199);
+	assert_int_equal(iscc_bitset_next_clear(bitset, 200, 200), 200);
+
+	iscc_bitset_set(bitset, 3);
+	iscc_bitset_set(bitset, 130);
+	assert_int_equal(iscc_bitset_next_set(bitset, 200, 0), 3);
+	assert_int_equal(iscc_bitset_next_set(bitset, 200, 3), 3);
+	assert_int_equal(iscc_bitset_next_set(bitset, 200, 4), 130);
+	assert_int_equal(iscc_bitset_next_set(bitset, 200, 131), 200);
+	assert_int_equal(iscc_bitset_next_set(bitset, 200, 250), 200);
+
+	// Fill everything but 70 and the last bit
+	for (size_t i = 0; i < 199; ++i) {
+		if (i != 70) iscc_bitset_set(bitset, i);
+	}
+	assert_int_equal(iscc_bitset_next_clear(bitset, 200, 0), 70);
+	assert_int_equal(iscc_bitset_next_clear(bitset, 200, 71), 199);
+	iscc_bitset_set(bitset, 199);
+	assert_int_equal(iscc_bitset_next_clear(bitset, 200, 71), 200);
+	assert_int_equal(iscc_bitset_count(bitset, 200), 199);
+
+	// Visits exactly the set bits, in order
+	iscc_bitset_clear(bitset, 5);
+	iscc_bitset_clear(bitset, 128);
+	size_t visited = 0;
+	size_t prev = 0;
+	for (size_t i = iscc_bitset_next_set(bitset, 200, 0);
+	        i < 200;
+	        i = iscc_bitset_next_set(bitset, 200, i + 1)) {
+		assert_true(iscc_bitset_test(bitset, i));
+		assert_true((visited == 0) || (prev < i));
+		prev = i;
+		++visited;
+	}
+	assert_int_equal(visited, iscc_bitset_count(bitset, 200));
+
+	free(bitset);
+}
+
+
+int main(void)
+{
+	if(!scc_ut_init_tests()) return 1;
+
+	const struct CMUnitTest test_cases[] = {
+		cmocka_unit_test(scc_ut_bitset_set_clear),
+		cmocka_unit_test(scc_ut_bitset_next),
+	};
+
+	return cmocka_run_group_tests_name("bitset.h", test_cases, NULL, NULL);
+}
@@ -24,7 +24,9 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <include/scclust.h>
+#include <include/scclust_spi.h>
 #include <src/data_set_struct.h>
+#include <src/dist_search_imp.h>
 #include <src/scclust_types.h>
 #include "data_object_test.h"
 
@@ -147,6 +149,124 @@ void scc_ut_get_data_set(void** state)
 }
 
 
+void scc_ut_init_data_set_f32(void** state)
+{
+	(void) state;
+
+	float coord[10] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f };
+
+	assert_int_equal(scc_init_data_set_f32(5, 2, 10, coord, NULL), SCC_ER_INVALID_INPUT);
+
+	scc_DataSet* dso1;
+	scc_ErrorCode ec1 = scc_init_data_set_f32(0, 2, 10, coord, &dso1);
+	assert_null(dso1);
+	assert_int_equal(ec1, SCC_ER_INVALID_INPUT);
+
+	scc_DataSet* dso2;
+	scc_ErrorCode ec2 = scc_init_data_set_f32(5, 2, 8, coord, &dso2);
+	assert_null(dso2);
+	assert_int_equal(ec2, SCC_ER_INVALID_INPUT);
+
+	scc_DataSet* dso3;
+	scc_ErrorCode ec3 = scc_init_data_set_f32(5, 2, 10, NULL, &dso3);
+	assert_null(dso3);
+	assert_int_equal(ec3, SCC_ER_INVALID_INPUT);
+
+	scc_DataSet* dso4;
+	scc_ErrorCode ec4 = scc_init_data_set_f32(5, 2, 10, coord, &dso4);
+	assert_int_equal(ec4, SCC_ER_OK);
+	assert_non_null(dso4);
+	assert_int_equal(dso4->num_data_points, 5);
+	assert_int_equal(dso4->num_dimensions, 2);
+	assert_null(dso4->data_matrix);
+	assert_ptr_equal(dso4->data_matrix_f32, coord);
+	assert_true(scc_is_initialized_data_set(dso4));
+	assert_true(iscc_imp_check_data_set(dso4));
+	scc_free_data_set(&dso4);
+
+	// Clusterings of single-precision data match those of the same values in double precision
+	float coord_f32[300];
+	double coord_f64[300];
+	for (size_t i = 0; i < 300; ++i) {
+		coord_f32[i] = (float) coord1[i];
+		coord_f64[i] = (double) coord_f32[i];
+	}
+	scc_DataSet* dso_f32;
+	scc_DataSet* dso_f64;
+	assert_int_equal(scc_init_data_set_f32(100, 3, 300, coord_f32, &dso_f32), SCC_ER_OK);
+	assert_int_equal(scc_init_data_set(100, 3, 300, coord_f64, &dso_f64), SCC_ER_OK);
+
+	scc_ClusterOptions options = scc_get_default_options();
+	options.size_constraint = 3;
+	scc_Clabel labels_f32[100];
+	scc_Clabel labels_f64[100];
+	scc_ClusteringStats stats_f32;
+	scc_ClusteringStats stats_f64;
+
+	for (size_t hierarchical = 0; hierarchical < 2; ++hierarchical) {
+		scc_Clustering* cl_f32;
+		scc_Clustering* cl_f64;
+		assert_int_equal(scc_init_empty_clustering(100, labels_f32, &cl_f32), SCC_ER_OK);
+		assert_int_equal(scc_init_empty_clustering(100, labels_f64, &cl_f64), SCC_ER_OK);
+		if (hierarchical == 0) {
+			assert_int_equal(scc_sc_clustering(dso_f32, &options, cl_f32), SCC_ER_OK);
+			assert_int_equal(scc_sc_clustering(dso_f64, &options, cl_f64), SCC_ER_OK);
+		} else {
+			assert_int_equal(scc_hierarchical_clustering(dso_f32, 3, false, cl_f32), SCC_ER_OK);
+			assert_int_equal(scc_hierarchical_clustering(dso_f64, 3, false, cl_f64), SCC_ER_OK);
+		}
+		assert_memory_equal(labels_f32, labels_f64, sizeof(labels_f32));
+		assert_int_equal(scc_get_clustering_stats(dso_f32, cl_f32, &stats_f32), SCC_ER_OK);
+		assert_int_equal(scc_get_clustering_stats(dso_f64, cl_f64, &stats_f64), SCC_ER_OK);
+		assert_memory_equal(&stats_f32, &stats_f64, sizeof(scc_ClusteringStats));
+		scc_free_clustering(&cl_f32);
+		scc_free_clustering(&cl_f64);
+	}
+
+	scc_free_data_set(&dso_f32);
+	scc_free_data_set(&dso_f64);
+}
+
+
+void scc_ut_data_set_block_order(void** state)
+{
+	(void) state;
+
+	// Dimensions 32-39 vary the most, then dimensions 0-15
+	double* const coord = malloc(sizeof(double[10 * 40]));
+	for (size_t i = 0; i < 10; ++i) {
+		for (size_t d = 0; d < 40; ++d) {
+			const double scale = (d >= 32) ? 100.0 : ((d < 16) ? 10.0 : 1.0);
+			coord[i * 40 + d] = scale * (double) ((i * 7 + d) % 5);
+		}
+	}
+
+	scc_DataSet* dso1;
+	assert_int_equal(scc_init_data_set(10, 40, 400, coord, &dso1), SCC_ER_OK);
+	uint_fast16_t* const block_order1 = iscc_make_block_order(dso1, 10, NULL);
+	assert_non_null(block_order1);
+	assert_int_equal(block_order1[0], 2);
+	assert_int_equal(block_order1[1], 0);
+	assert_int_equal(block_order1[2], 1);
+	free(block_order1);
+
+	// Only the variance among the given points counts
+	for (size_t d = 0; d < 16; ++d) {
+		coord[5 * 40 + d] = 1000.0;
+	}
+	const scc_PointIndex points[3] = { 1, 5, 8 };
+	uint_fast16_t* const block_order2 = iscc_make_block_order(dso1, 3, points);
+	assert_non_null(block_order2);
+	assert_int_equal(block_order2[0], 0);
+	assert_int_equal(block_order2[1], 2);
+	assert_int_equal(block_order2[2], 1);
+	free(block_order2);
+	scc_free_data_set(&dso1);
+
+	free(coord);
+}
+
+
 void scc_ut_is_initialized_data_set(void** state)
 {
 	(void) state;
@@ -161,6 +281,152 @@ void scc_ut_is_initialized_data_set(void** state)
 }
 
 
+static size_t scc_ut_custom_calls = 0;
+
+
+static bool scc_ut_custom_check_data_set(void* const data_set)
+{
+	++scc_ut_custom_calls;
+	return iscc_imp_check_data_set(data_set);
+}
+
+
+static size_t scc_ut_global_calls = 0;
+
+
+static bool scc_ut_global_check_data_set(void* const data_set)
+{
+	++scc_ut_global_calls;
+	return iscc_imp_check_data_set(data_set);
+}
+
+
+static bool scc_ut_global_init_nn_search_object(void* const data_set,
+                                                const size_t len_search_indices,
+                                                const scc_PointIndex search_indices[const],
+                                                iscc_NNSearchObject** const out_nn_search_object)
+{
+	++scc_ut_global_calls;
+	return iscc_imp_init_nn_search_object(data_set, len_search_indices, search_indices, out_nn_search_object);
+}
+
+
+static size_t scc_ut_custom_num_data_points(void* const data_set)
+{
+	++scc_ut_custom_calls;
+	return iscc_imp_num_data_points(data_set);
+}
+
+
+static bool scc_ut_custom_init_nn_search_object(void* const data_set,
+                                                const size_t len_search_indices,
+                                                const scc_PointIndex search_indices[const],
+                                                iscc_NNSearchObject** const out_nn_search_object)
+{
+	++scc_ut_custom_calls;
+	return iscc_imp_init_nn_search_object(data_set, len_search_indices, search_indices, out_nn_search_object);
+}
+
+
+void scc_ut_init_custom_data_set(void** state)
+{
+	(void) state;
+
+	scc_DistFunctions dist_functions = {
+		.check_data_set = scc_ut_custom_check_data_set,
+		.num_data_points = scc_ut_custom_num_data_points,
+		.get_dist_matrix = iscc_imp_get_dist_matrix,
+		.get_dist_rows = iscc_imp_get_dist_rows,
+		.init_max_dist_object = iscc_imp_init_max_dist_object,
+		.get_max_dist = iscc_imp_get_max_dist,
+		.close_max_dist_object = iscc_imp_close_max_dist_object,
+		.init_nn_search_object = scc_ut_custom_init_nn_search_object,
+		.nearest_neighbor_search = iscc_imp_nearest_neighbor_search,
+		.close_nn_search_object = iscc_imp_close_nn_search_object,
+	};
+
+	scc_DataSet* dso1 = NULL;
+	assert_int_equal(scc_init_custom_data_set(&dist_functions, scc_ut_test_data_large, NULL), SCC_ER_INVALID_INPUT);
+	assert_int_equal(scc_init_custom_data_set(NULL, scc_ut_test_data_large, &dso1), SCC_ER_INVALID_INPUT);
+	assert_null(dso1);
+
+	scc_DistFunctions missing_functions = dist_functions;
+	missing_functions.get_max_dist = NULL;
+	assert_int_equal(scc_init_custom_data_set(&missing_functions, scc_ut_test_data_large, &dso1), SCC_ER_INVALID_INPUT);
+	assert_null(dso1);
+
+	scc_DataSet* dso2;
+	assert_int_equal(scc_init_custom_data_set(&dist_functions, scc_ut_test_data_large, &dso2), SCC_ER_OK);
+	assert_true(scc_is_initialized_data_set(dso2));
+	assert_false(iscc_imp_check_data_set(dso2));
+	assert_ptr_equal(dso2->dist_context, scc_ut_test_data_large);
+
+	// The table is copied
+	dist_functions.check_data_set = NULL;
+
+	scc_Clabel ref_labels[100];
+	scc_Clabel custom_labels[100];
+	scc_Clustering* cl;
+	scc_ClusterOptions options = scc_get_default_options();
+	options.size_constraint = 3;
+
+	scc_ut_custom_calls = 0;
+	scc_init_empty_clustering(100, ref_labels, &cl);
+	assert_int_equal(scc_sc_clustering(scc_ut_test_data_large, &options, cl), SCC_ER_OK);
+	scc_free_clustering(&cl);
+	assert_int_equal(scc_ut_custom_calls, 0);
+
+	scc_init_empty_clustering(100, custom_labels, &cl);
+	assert_int_equal(scc_sc_clustering(dso2, &options, cl), SCC_ER_OK);
+	scc_free_clustering(&cl);
+	assert_true(scc_ut_custom_calls > 0);
+	assert_memory_equal(custom_labels, ref_labels, 100 * sizeof(scc_Clabel));
+
+	scc_init_empty_clustering(100, ref_labels, &cl);
+	assert_int_equal(scc_hierarchical_clustering(scc_ut_test_data_large, 3, true, cl), SCC_ER_OK);
+	scc_free_clustering(&cl);
+
+	scc_init_empty_clustering(100, custom_labels, &cl);
+	assert_int_equal(scc_hierarchical_clustering(dso2, 3, true, cl), SCC_ER_OK);
+	scc_free_clustering(&cl);
+	assert_memory_equal(custom_labels, ref_labels, 100 * sizeof(scc_Clabel));
+
+	// Functions set for the whole process do not replace the data set's own functions
+	assert_true(scc_set_dist_functions(NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+	                                   scc_ut_global_init_nn_search_object,
+	                                   iscc_imp_nearest_neighbor_search,
+	                                   iscc_imp_close_nn_search_object));
+	scc_ut_custom_calls = 0;
+	scc_ut_global_calls = 0;
+	scc_init_empty_clustering(100, custom_labels, &cl);
+	assert_int_equal(scc_sc_clustering(dso2, &options, cl), SCC_ER_OK);
+	scc_free_clustering(&cl);
+	assert_true(scc_ut_custom_calls > 0);
+	assert_int_equal(scc_ut_global_calls, 0);
+
+	scc_init_empty_clustering(100, ref_labels, &cl);
+	assert_int_equal(scc_sc_clustering(scc_ut_test_data_large, &options, cl), SCC_ER_OK);
+	scc_free_clustering(&cl);
+	assert_true(scc_ut_global_calls > 0);
+	assert_true(scc_reset_dist_functions());
+	assert_memory_equal(custom_labels, ref_labels, 100 * sizeof(scc_Clabel));
+
+	// With a replaced `check_data_set`, data sets are not inspected and all use the global functions
+	assert_true(scc_set_dist_functions(scc_ut_global_check_data_set, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL));
+	scc_ut_custom_calls = 0;
+	scc_ut_global_calls = 0;
+	scc_init_empty_clustering(100, custom_labels, &cl);
+	assert_int_equal(scc_sc_clustering(dso2, &options, cl), SCC_ER_INVALID_INPUT);
+	scc_free_clustering(&cl);
+	assert_int_equal(scc_ut_custom_calls, 0);
+	assert_true(scc_ut_global_calls > 0);
+	assert_true(scc_reset_dist_functions());
+
+	scc_free_data_set(&dso2);
+	assert_null(dso2);
+}
+
+
 int main(void)
 {
 	if(!scc_ut_init_tests()) return 1;
@@ -168,7 +434,10 @@ int main(void)
 	const struct CMUnitTest test_cases[] = {
 		cmocka_unit_test(scc_ut_free_data_set),
 		cmocka_unit_test(scc_ut_get_data_set),
+		cmocka_unit_test(scc_ut_init_data_set_f32),
+		cmocka_unit_test(scc_ut_data_set_block_order),
 		cmocka_unit_test(scc_ut_is_initialized_data_set),
+		cmocka_unit_test(scc_ut_init_custom_data_set),
 	};
 
 	return cmocka_run_group_tests_name("data_set.c", test_cases, NULL, NULL);
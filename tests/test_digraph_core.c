@@ -227,11 +227,9 @@ void scc_ut_init_digraph(void** state)
 {
 	(void) state;
 
-	#if ISCC_M_ARCINDEX_MAX < UINTMAX_MAX
-		iscc_Digraph dg1;
-		scc_ErrorCode ec1 = iscc_init_digraph(100, ((uintmax_t) ISCC_ARCINDEX_MAX) + 1, &dg1);
-		assert_int_equal(ec1, SCC_ER_TOO_LARGE_PROBLEM);
-	#endif
+	iscc_Digraph dg1;
+	scc_ErrorCode ec1 = iscc_init_digraph(100, ((uintmax_t) SIZE_MAX / sizeof(scc_PointIndex)) + 1, &dg1);
+	assert_int_equal(ec1, SCC_ER_TOO_LARGE_PROBLEM);
 
 	iscc_Digraph dg3;
 	scc_ErrorCode ec3 = iscc_init_digraph(100, 1000, &dg3);
@@ -260,11 +258,9 @@ void scc_ut_empty_digraph(void** state)
 {
 	(void) state;
 
-	#if ISCC_M_ARCINDEX_MAX < UINTMAX_MAX
-		iscc_Digraph dg1;
-		scc_ErrorCode ec1 = iscc_empty_digraph(100, ((uintmax_t) ISCC_ARCINDEX_MAX) + 1, &dg1);
-		assert_int_equal(ec1, SCC_ER_TOO_LARGE_PROBLEM);
-	#endif
+	iscc_Digraph dg1;
+	scc_ErrorCode ec1 = iscc_empty_digraph(100, ((uintmax_t) SIZE_MAX / sizeof(scc_PointIndex)) + 1, &dg1);
+	assert_int_equal(ec1, SCC_ER_TOO_LARGE_PROBLEM);
 
 	iscc_Digraph dg3;
 	scc_ErrorCode ec3 = iscc_empty_digraph(100, 1000, &dg3);
@@ -311,16 +307,14 @@ void scc_ut_change_arc_storage(void** state)
 		.tail_ptr = tails,
 	};
 
-	#if ISCC_M_ARCINDEX_MAX < UINTMAX_MAX
-		assert_true(iscc_digraph_is_initialized(&dg));
-		scc_ErrorCode ec1 = iscc_change_arc_storage(&dg, ((uintmax_t) ISCC_ARCINDEX_MAX) + 1);
-		assert_int_equal(dg.vertices, 5);
-		assert_int_equal(dg.max_arcs, 10);
-		assert_non_null(dg.head);
-		assert_non_null(dg.tail_ptr);
-		assert_memory_equal(dg.tail_ptr, tails_ref, 6 * sizeof(iscc_ArcIndex));
-		assert_int_equal(ec1, SCC_ER_TOO_LARGE_PROBLEM);
-	#endif
+	assert_true(iscc_digraph_is_initialized(&dg));
+	scc_ErrorCode ec1 = iscc_change_arc_storage(&dg, ((uintmax_t) SIZE_MAX / sizeof(scc_PointIndex)) + 1);
+	assert_int_equal(dg.vertices, 5);
+	assert_int_equal(dg.max_arcs, 10);
+	assert_non_null(dg.head);
+	assert_non_null(dg.tail_ptr);
+	assert_memory_equal(dg.tail_ptr, tails_ref, 6 * sizeof(iscc_ArcIndex));
+	assert_int_equal(ec1, SCC_ER_TOO_LARGE_PROBLEM);
 
 	assert_true(iscc_digraph_is_initialized(&dg));
 	scc_ErrorCode ec3 = iscc_change_arc_storage(&dg, 10);
@@ -383,6 +377,279 @@ void scc_ut_change_arc_storage(void** state)
 }
 
 
+void scc_ut_fixed_digraph(void** state)
+{
+	(void) state;
+
+	iscc_Digraph dg1;
+	scc_ErrorCode ec1 = iscc_init_fixed_digraph(5, 2, true, 10, &dg1);
+	assert_int_equal(ec1, SCC_ER_OK);
+	assert_true(iscc_digraph_is_fixed(&dg1));
+	assert_null(dg1.tail_ptr);
+	assert_null(dg1.valid_tails);
+	assert_null(dg1.tail_rank);
+	for (size_t i = 0; i < 10; ++i) dg1.head[i] = (scc_PointIndex) (i % 5);
+	assert_true(iscc_digraph_is_valid(&dg1));
+	assert_false(iscc_digraph_is_empty(&dg1));
+	assert_int_equal(iscc_digraph_num_arcs(&dg1), 10);
+	for (size_t v = 0; v < 5; ++v) {
+		assert_int_equal(iscc_digraph_row_begin(&dg1, v), 2 * v);
+		assert_int_equal(iscc_digraph_row_end(&dg1, v), 2 * v + 2);
+		assert_int_equal(iscc_digraph_out_degree(&dg1, v), 2);
+	}
+	iscc_free_digraph(&dg1);
+	assert_memory_equal(&dg1, &ISCC_NULL_DIGRAPH, sizeof(iscc_Digraph));
+
+	// Tails 3, 64, 70 and 129 among 130 vertices
+	iscc_Digraph dg2;
+	scc_ErrorCode ec2 = iscc_init_fixed_digraph(130, 3, false, 12, &dg2);
+	assert_int_equal(ec2, SCC_ER_OK);
+	assert_non_null(dg2.valid_tails);
+	assert_non_null(dg2.tail_rank);
+	assert_true(iscc_digraph_is_empty(&dg2));
+	iscc_bitset_set(dg2.valid_tails, 3);
+	iscc_bitset_set(dg2.valid_tails, 64);
+	iscc_bitset_set(dg2.valid_tails, 70);
+	iscc_bitset_set(dg2.valid_tails, 129);
+	iscc_rank_fixed_digraph(&dg2);
+	for (size_t i = 0; i < 12; ++i) dg2.head[i] = (scc_PointIndex) (10 * i);
+	assert_true(iscc_digraph_is_valid(&dg2));
+	assert_int_equal(iscc_digraph_num_arcs(&dg2), 12);
+
+	const size_t ref_vertices[9] = { 3, 4, 63, 64, 65, 70, 71, 129, 130 };
+	const size_t ref_begin[9] = { 0, 3, 3, 3, 6, 6, 9, 9, 12 };
+	for (size_t i = 0; i < 9; ++i) {
+		assert_int_equal(iscc_digraph_row_begin(&dg2, ref_vertices[i]), ref_begin[i]);
+	}
+	assert_int_equal(iscc_digraph_out_degree(&dg2, 2), 0);
+	assert_int_equal(iscc_digraph_out_degree(&dg2, 70), 3);
+	assert_int_equal(iscc_digraph_row_end(&dg2, 71), iscc_digraph_row_begin(&dg2, 71));
+
+	// Broken rank
+	dg2.tail_rank[1] = 0;
+	assert_false(iscc_digraph_is_valid(&dg2));
+	iscc_rank_fixed_digraph(&dg2);
+
+	scc_ErrorCode ec3 = iscc_digraph_make_csr(&dg2);
+	assert_int_equal(ec3, SCC_ER_OK);
+	assert_false(iscc_digraph_is_fixed(&dg2));
+	assert_null(dg2.valid_tails);
+	assert_null(dg2.tail_rank);
+	assert_non_null(dg2.tail_ptr);
+	assert_true(iscc_digraph_is_valid(&dg2));
+	for (size_t v = 0; v <= 130; ++v) {
+		iscc_ArcIndex ref = 0;
+		if (v > 3) ref += 3;
+		if (v > 64) ref += 3;
+		if (v > 70) ref += 3;
+		if (v > 129) ref += 3;
+		assert_int_equal(dg2.tail_ptr[v], ref);
+	}
+	for (size_t i = 0; i < 12; ++i) assert_int_equal(dg2.head[i], 10 * i);
+	iscc_free_digraph(&dg2);
+}
+
+
+void scc_ut_compressed_digraph(void** state)
+{
+	(void) state;
+
+	// Rows with zero to three arcs, with gaps that need multi-byte varints
+	iscc_Digraph dg1;
+	scc_ErrorCode ec1 = iscc_init_digraph(300, 450, &dg1);
+	assert_int_equal(ec1, SCC_ER_OK);
+	scc_PointIndex ref_rows[300][3];
+	size_t num_arcs = 0;
+	dg1.tail_ptr[0] = 0;
+	for (size_t v = 0; v < 300; ++v) {
+		const size_t degree = v % 4;
+		for (size_t j = 0; j < degree; ++j) {
+			dg1.head[num_arcs] = (scc_PointIndex) ((v * 7 + (degree - j) * 97) % 300);
+			++num_arcs;
+		}
+		dg1.tail_ptr[v + 1] = (iscc_ArcIndex) num_arcs;
+		for (size_t j = 0; j < degree; ++j) ref_rows[v][j] = dg1.head[dg1.tail_ptr[v] + j];
+		for (size_t j = 1; j < degree; ++j) {
+			for (size_t k = j; (k > 0) && (ref_rows[v][k - 1] > ref_rows[v][k]); --k) {
+				const scc_PointIndex tmp = ref_rows[v][k];
+				ref_rows[v][k] = ref_rows[v][k - 1];
+				ref_rows[v][k - 1] = tmp;
+			}
+		}
+	}
+	assert_true(iscc_digraph_is_valid(&dg1));
+
+	scc_ErrorCode ec2 = iscc_digraph_compress(&dg1);
+	assert_int_equal(ec2, SCC_ER_OK);
+	assert_true(iscc_digraph_is_compressed(&dg1));
+	assert_false(iscc_digraph_is_fixed(&dg1));
+	assert_null(dg1.head);
+	assert_null(dg1.tail_ptr);
+	assert_non_null(dg1.packed_ptr);
+	assert_int_equal(dg1.max_out_degree, 3);
+	assert_true(iscc_digraph_is_valid(&dg1));
+	assert_false(iscc_digraph_is_empty(&dg1));
+	assert_int_equal(iscc_digraph_num_arcs(&dg1), num_arcs);
+	for (size_t v = 0; v < 300; ++v) {
+		assert_int_equal(iscc_digraph_out_degree(&dg1, v), v % 4);
+	}
+	iscc_BitsetWord* const tails1 = iscc_digraph_tails_with_arcs(&dg1);
+	assert_non_null(tails1);
+	for (size_t v = 0; v < 300; ++v) {
+		assert_int_equal(iscc_bitset_test(tails1, v), (v % 4) > 0);
+	}
+	free(tails1);
+
+	// Compressing again does nothing
+	scc_ErrorCode ec3 = iscc_digraph_compress(&dg1);
+	assert_int_equal(ec3, SCC_ER_OK);
+	assert_true(iscc_digraph_is_valid(&dg1));
+
+	iscc_DigraphRowReader reader;
+	scc_ErrorCode ec4 = iscc_init_row_reader(&dg1, &reader);
+	assert_int_equal(ec4, SCC_ER_OK);
+	assert_non_null(reader.row);
+
+	// Forwards, backwards and skipping rows
+	for (size_t v = 0; v < 300; ++v) {
+		size_t len_row;
+		const scc_PointIndex* const row = iscc_digraph_read_row(&dg1, v, &reader, &len_row);
+		assert_int_equal(len_row, v % 4);
+		for (size_t j = 0; j < len_row; ++j) assert_int_equal(row[j], ref_rows[v][j]);
+	}
+	for (size_t i = 0; i < 300; i += 7) {
+		const size_t v = 299 - i;
+		size_t len_row;
+		const scc_PointIndex* const row = iscc_digraph_read_row(&dg1, v, &reader, &len_row);
+		assert_int_equal(len_row, v % 4);
+		for (size_t j = 0; j < len_row; ++j) assert_int_equal(row[j], ref_rows[v][j]);
+	}
+	iscc_free_row_reader(&reader);
+	assert_null(reader.row);
+
+	// Broken offset
+	++dg1.packed_ptr[1];
+	assert_false(iscc_digraph_is_valid(&dg1));
+	--dg1.packed_ptr[1];
+	assert_true(iscc_digraph_is_valid(&dg1));
+
+	scc_ErrorCode ec5 = iscc_digraph_make_csr(&dg1);
+	assert_int_equal(ec5, SCC_ER_OK);
+	assert_false(iscc_digraph_is_compressed(&dg1));
+	assert_null(dg1.packed_ptr);
+	assert_true(iscc_digraph_is_valid(&dg1));
+	for (size_t v = 0; v < 300; ++v) {
+		assert_int_equal(dg1.tail_ptr[v + 1] - dg1.tail_ptr[v], v % 4);
+		for (size_t j = 0; j < v % 4; ++j) assert_int_equal(dg1.head[dg1.tail_ptr[v] + j], ref_rows[v][j]);
+	}
+	iscc_BitsetWord* const tails2 = iscc_digraph_tails_with_arcs(&dg1);
+	assert_non_null(tails2);
+	for (size_t v = 0; v < 300; ++v) {
+		assert_int_equal(iscc_bitset_test(tails2, v), (v % 4) > 0);
+	}
+	free(tails2);
+	iscc_free_digraph(&dg1);
+	assert_memory_equal(&dg1, &ISCC_NULL_DIGRAPH, sizeof(iscc_Digraph));
+
+	// Fixed-degree digraphs with loops
+	iscc_Digraph dg2;
+	scc_ErrorCode ec6 = iscc_init_fixed_digraph(5, 2, true, 10, &dg2);
+	assert_int_equal(ec6, SCC_ER_OK);
+	for (size_t i = 0; i < 10; ++i) dg2.head[i] = (scc_PointIndex) ((i % 2 == 0) ? (i / 2) : (4 - i / 2));
+	scc_ErrorCode ec7 = iscc_digraph_compress(&dg2);
+	assert_int_equal(ec7, SCC_ER_OK);
+	assert_true(iscc_digraph_is_valid(&dg2));
+	assert_int_equal(iscc_digraph_num_arcs(&dg2), 10);
+
+	iscc_DigraphRowReader reader2;
+	scc_ErrorCode ec8 = iscc_init_row_reader(&dg2, &reader2);
+	assert_int_equal(ec8, SCC_ER_OK);
+	for (size_t v = 0; v < 5; ++v) {
+		size_t len_row;
+		const scc_PointIndex* const row = iscc_digraph_read_row(&dg2, v, &reader2, &len_row);
+		assert_int_equal(len_row, 2);
+		const scc_PointIndex other = (scc_PointIndex) (4 - v);
+		assert_int_equal(row[0], (v < other) ? v : other);
+		assert_int_equal(row[1], (v < other) ? other : v);
+	}
+	iscc_free_row_reader(&reader2);
+	iscc_free_digraph(&dg2);
+}
+
+
+void scc_ut_segmented_digraph(void** state)
+{
+	(void) state;
+
+	// Vertex `v` has `v % 3` arcs, to `v + 1` and `v + 2` modulo 3000
+	iscc_Digraph dg1;
+	scc_ErrorCode ec1 = iscc_init_digraph(3000, 3000, &dg1);
+	assert_int_equal(ec1, SCC_ER_OK);
+	assert_null(dg1.segment_ptr);
+	size_t num_arcs = 0;
+	dg1.tail_ptr[0] = 0;
+	for (size_t v = 0; v < 3000; ++v) {
+		for (size_t i = 1; i <= v % 3; ++i) {
+			dg1.head[num_arcs] = (scc_PointIndex) ((v + i) % 3000);
+			++num_arcs;
+		}
+		dg1.tail_ptr[v + 1] = (iscc_ArcIndex) num_arcs;
+	}
+
+	scc_ErrorCode ec2 = iscc_digraph_segment(&dg1);
+	assert_int_equal(ec2, SCC_ER_OK);
+	assert_non_null(dg1.segment_ptr);
+	assert_true(iscc_digraph_is_valid(&dg1));
+	assert_int_equal(dg1.segment_ptr[0], 0);
+	assert_int_equal(dg1.segment_ptr[1], dg1.tail_ptr[ISCC_DIGRAPH_SEGMENT_ROWS]);
+	assert_int_equal(dg1.segment_ptr[2], dg1.tail_ptr[2 * ISCC_DIGRAPH_SEGMENT_ROWS]);
+	assert_int_equal(iscc_digraph_num_arcs(&dg1), num_arcs);
+	for (size_t v = 0; v < 3000; ++v) {
+		assert_int_equal(iscc_digraph_row_begin(&dg1, v), dg1.tail_ptr[v]);
+		assert_int_equal(iscc_digraph_out_degree(&dg1, v), v % 3);
+	}
+
+	// Broken segment offset
+	++dg1.segment_ptr[1];
+	assert_false(iscc_digraph_is_valid(&dg1));
+	--dg1.segment_ptr[1];
+	assert_true(iscc_digraph_is_valid(&dg1));
+
+	// Digraphs that can be indexed by `iscc_ArcIndex` are not segmented
+	scc_ErrorCode ec3 = iscc_change_arc_storage(&dg1, num_arcs);
+	assert_int_equal(ec3, SCC_ER_OK);
+	assert_null(dg1.segment_ptr);
+	assert_true(iscc_digraph_is_valid(&dg1));
+	iscc_free_digraph(&dg1);
+
+	#if ISCC_M_ARCINDEX_MAX < SIZE_MAX
+		// Offsets past `ISCC_ARCINDEX_MAX`. Only the row offsets are read, so no arcs are allocated.
+		const size_t segment1 = ((size_t) ISCC_ARCINDEX_MAX) - 10;
+		iscc_ArcIndex tails[2 * ISCC_DIGRAPH_SEGMENT_ROWS + 1];
+		size_t segments[3] = { 0, segment1, segment1 + 3 * ISCC_DIGRAPH_SEGMENT_ROWS };
+		iscc_Digraph dg2 = {
+			.vertices = 2 * ISCC_DIGRAPH_SEGMENT_ROWS,
+			.max_arcs = segments[2],
+			.head = NULL,
+			.tail_ptr = tails,
+			.segment_ptr = segments,
+		};
+		for (size_t v = 0; v < ISCC_DIGRAPH_SEGMENT_ROWS; ++v) {
+			tails[v] = (iscc_ArcIndex) (v * (segment1 / ISCC_DIGRAPH_SEGMENT_ROWS));
+		}
+		for (size_t v = ISCC_DIGRAPH_SEGMENT_ROWS; v <= 2 * ISCC_DIGRAPH_SEGMENT_ROWS; ++v) {
+			tails[v] = (iscc_ArcIndex) (segment1 + 3 * (v - ISCC_DIGRAPH_SEGMENT_ROWS));
+		}
+		assert_int_equal(iscc_digraph_num_arcs(&dg2), segment1 + 3 * ISCC_DIGRAPH_SEGMENT_ROWS);
+		assert_int_equal(iscc_digraph_row_end(&dg2, ISCC_DIGRAPH_SEGMENT_ROWS - 1), segment1);
+		for (size_t v = ISCC_DIGRAPH_SEGMENT_ROWS; v < 2 * ISCC_DIGRAPH_SEGMENT_ROWS; ++v) {
+			assert_int_equal(iscc_digraph_row_begin(&dg2, v), segment1 + 3 * (v - ISCC_DIGRAPH_SEGMENT_ROWS));
+			assert_int_equal(iscc_digraph_out_degree(&dg2, v), 3);
+		}
+	#endif
+}
+
+
 int main(void)
 {
 	if(!scc_ut_init_tests()) return 1;
@@ -395,6 +662,9 @@ int main(void)
 		cmocka_unit_test(scc_ut_init_digraph),
 		cmocka_unit_test(scc_ut_empty_digraph),
 		cmocka_unit_test(scc_ut_change_arc_storage),
+		cmocka_unit_test(scc_ut_fixed_digraph),
+		cmocka_unit_test(scc_ut_compressed_digraph),
+		cmocka_unit_test(scc_ut_segmented_digraph),
 	};
 
 	return cmocka_run_group_tests_name("digraph_core.c", test_cases, NULL, NULL);
@@ -22,6 +22,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <src/digraph_core.h>
 #include <src/digraph_debug.h>
 #include <src/digraph_operations.h>
@@ -97,6 +98,48 @@ void scc_ut_delete_loops(void** state)
 }
 
 
+void scc_ut_delete_loops_fixed(void** state)
+{
+	(void) state;
+
+	// Tails 0, 2 and 3, each with one self-loop
+	iscc_Digraph dg1;
+	assert_int_equal(iscc_init_fixed_digraph(5, 3, false, 9, &dg1), SCC_ER_OK);
+	iscc_bitset_set(dg1.valid_tails, 0);
+	iscc_bitset_set(dg1.valid_tails, 2);
+	iscc_bitset_set(dg1.valid_tails, 3);
+	iscc_rank_fixed_digraph(&dg1);
+	const scc_PointIndex head1[9] = { 1, 0, 4, 2, 1, 3, 0, 1, 3 };
+	for (size_t i = 0; i < 9; ++i) dg1.head[i] = head1[i];
+
+	// Row 1 has no self-loop
+	iscc_Digraph dg2;
+	assert_int_equal(iscc_init_fixed_digraph(3, 2, true, 6, &dg2), SCC_ER_OK);
+	const scc_PointIndex head2[6] = { 0, 2, 0, 2, 2, 1 };
+	for (size_t i = 0; i < 6; ++i) dg2.head[i] = head2[i];
+
+	assert_int_equal(iscc_delete_loops(&dg1), SCC_ER_OK);
+	assert_int_equal(iscc_delete_loops(&dg2), SCC_ER_OK);
+
+	iscc_Digraph ref1;
+	iscc_digraph_from_string(".#..#/...../.#.#./##.../...../", &ref1);
+	iscc_Digraph ref2;
+	iscc_digraph_from_string("..#/#.#/.#./", &ref2);
+
+	assert_true(iscc_digraph_is_fixed(&dg1));
+	assert_int_equal(dg1.fixed_degree, 2);
+	assert_valid_digraph(&dg1, 5);
+	assert_identical_digraph(&dg1, &ref1);
+	assert_false(iscc_digraph_is_fixed(&dg2));
+	assert_identical_digraph(&dg2, &ref2);
+
+	assert_free_digraph(&dg1);
+	assert_free_digraph(&dg2);
+	assert_free_digraph(&ref1);
+	assert_free_digraph(&ref2);
+}
+
+
 void scc_ut_digraph_union_and_delete(void** state)
 {
 	(void) state;
@@ -115,8 +158,8 @@ void scc_ut_digraph_union_and_delete(void** state)
 	const iscc_Digraph sum_12[2] = {ut_dg1, ut_dg2};
 	iscc_Digraph ut_make12_a;
 	iscc_Digraph ut_make12_a_ttk;
-	scc_ErrorCode ec1 = iscc_digraph_union_and_delete(2, sum_12, 0, NULL, false, &ut_make12_a);
-	scc_ErrorCode ec2 = iscc_digraph_union_and_delete(2, sum_12, 2, tails_to_keep1, false, &ut_make12_a_ttk);
+	scc_ErrorCode ec1 = iscc_digraph_union_and_delete(2, sum_12, 0, NULL, false, 1, &ut_make12_a);
+	scc_ErrorCode ec2 = iscc_digraph_union_and_delete(2, sum_12, 2, tails_to_keep1, false, 1, &ut_make12_a_ttk);
 	assert_int_equal(ec1, SCC_ER_OK);
 	assert_int_equal(ec2, SCC_ER_OK);
 	assert_valid_digraph(&ut_make12_a, 4);
@@ -134,8 +177,8 @@ void scc_ut_digraph_union_and_delete(void** state)
 	const iscc_Digraph sum_13[2] = {ut_dg1, ut_dg3};
 	iscc_Digraph ut_make13_a;
 	iscc_Digraph ut_make13_a_ttk;
-	scc_ErrorCode ec3 = iscc_digraph_union_and_delete(2, sum_13, 0, NULL, false, &ut_make13_a);
-	scc_ErrorCode ec4 = iscc_digraph_union_and_delete(2, sum_13, 2, tails_to_keep2, false, &ut_make13_a_ttk);
+	scc_ErrorCode ec3 = iscc_digraph_union_and_delete(2, sum_13, 0, NULL, false, 1, &ut_make13_a);
+	scc_ErrorCode ec4 = iscc_digraph_union_and_delete(2, sum_13, 2, tails_to_keep2, false, 1, &ut_make13_a_ttk);
 	assert_int_equal(ec3, SCC_ER_OK);
 	assert_int_equal(ec4, SCC_ER_OK);
 	assert_valid_digraph(&ut_make13_a, 4);
@@ -148,8 +191,8 @@ void scc_ut_digraph_union_and_delete(void** state)
 	const iscc_Digraph sum_31[2] = {ut_dg3, ut_dg1};
 	iscc_Digraph ut_make31_a;
 	iscc_Digraph ut_make31_a_ttk;
-	scc_ErrorCode ec5 = iscc_digraph_union_and_delete(2, sum_31, 0, NULL, false, &ut_make31_a);
-	scc_ErrorCode ec6 = iscc_digraph_union_and_delete(2, sum_31, 2, tails_to_keep3, false, &ut_make31_a_ttk);
+	scc_ErrorCode ec5 = iscc_digraph_union_and_delete(2, sum_31, 0, NULL, false, 1, &ut_make31_a);
+	scc_ErrorCode ec6 = iscc_digraph_union_and_delete(2, sum_31, 2, tails_to_keep3, false, 1, &ut_make31_a_ttk);
 	assert_int_equal(ec5, SCC_ER_OK);
 	assert_int_equal(ec6, SCC_ER_OK);
 	assert_valid_digraph(&ut_make31_a, 4);
@@ -165,8 +208,8 @@ void scc_ut_digraph_union_and_delete(void** state)
 	const iscc_Digraph sum_123[3] = {ut_dg1, ut_dg2, ut_dg3};
 	iscc_Digraph ut_make123;
 	iscc_Digraph ut_make123_ttk;
-	scc_ErrorCode ec7 = iscc_digraph_union_and_delete(3, sum_123, 0, NULL, false, &ut_make123);
-	scc_ErrorCode ec8 = iscc_digraph_union_and_delete(3, sum_123, 2, tails_to_keep1, false, &ut_make123_ttk);
+	scc_ErrorCode ec7 = iscc_digraph_union_and_delete(3, sum_123, 0, NULL, false, 1, &ut_make123);
+	scc_ErrorCode ec8 = iscc_digraph_union_and_delete(3, sum_123, 2, tails_to_keep1, false, 1, &ut_make123_ttk);
 	assert_int_equal(ec7, SCC_ER_OK);
 	assert_int_equal(ec8, SCC_ER_OK);
 	assert_valid_digraph(&ut_make123, 4);
@@ -179,8 +222,8 @@ void scc_ut_digraph_union_and_delete(void** state)
 	const iscc_Digraph sum_132[3] = {ut_dg1, ut_dg3, ut_dg2};
 	iscc_Digraph ut_make132;
 	iscc_Digraph ut_make132_ttk;
-	scc_ErrorCode ec9 = iscc_digraph_union_and_delete(3, sum_132, 0, NULL, false, &ut_make132);
-	scc_ErrorCode ec10 = iscc_digraph_union_and_delete(3, sum_132, 2, tails_to_keep2, false, &ut_make132_ttk);
+	scc_ErrorCode ec9 = iscc_digraph_union_and_delete(3, sum_132, 0, NULL, false, 1, &ut_make132);
+	scc_ErrorCode ec10 = iscc_digraph_union_and_delete(3, sum_132, 2, tails_to_keep2, false, 1, &ut_make132_ttk);
 	assert_int_equal(ec9, SCC_ER_OK);
 	assert_int_equal(ec10, SCC_ER_OK);
 	assert_valid_digraph(&ut_make132, 4);
@@ -193,8 +236,8 @@ void scc_ut_digraph_union_and_delete(void** state)
 	const iscc_Digraph sum_213[3] = {ut_dg2, ut_dg1, ut_dg3};
 	iscc_Digraph ut_make213;
 	iscc_Digraph ut_make213_ttk;
-	scc_ErrorCode ec11 = iscc_digraph_union_and_delete(3, sum_213, 0, NULL, false, &ut_make213);
-	scc_ErrorCode ec12 = iscc_digraph_union_and_delete(3, sum_213, 2, tails_to_keep3, false, &ut_make213_ttk);
+	scc_ErrorCode ec11 = iscc_digraph_union_and_delete(3, sum_213, 0, NULL, false, 1, &ut_make213);
+	scc_ErrorCode ec12 = iscc_digraph_union_and_delete(3, sum_213, 2, tails_to_keep3, false, 1, &ut_make213_ttk);
 	assert_int_equal(ec11, SCC_ER_OK);
 	assert_int_equal(ec12, SCC_ER_OK);
 	assert_valid_digraph(&ut_make213, 4);
@@ -207,8 +250,8 @@ void scc_ut_digraph_union_and_delete(void** state)
 	const iscc_Digraph sum_321[3] = {ut_dg3, ut_dg2, ut_dg1};
 	iscc_Digraph ut_make321;
 	iscc_Digraph ut_make321_ttk;
-	scc_ErrorCode ec13 = iscc_digraph_union_and_delete(3, sum_321, 0, NULL, false, &ut_make321);
-	scc_ErrorCode ec14 = iscc_digraph_union_and_delete(3, sum_321, 2, tails_to_keep1, false, &ut_make321_ttk);
+	scc_ErrorCode ec13 = iscc_digraph_union_and_delete(3, sum_321, 0, NULL, false, 1, &ut_make321);
+	scc_ErrorCode ec14 = iscc_digraph_union_and_delete(3, sum_321, 2, tails_to_keep1, false, 1, &ut_make321_ttk);
 	assert_int_equal(ec13, SCC_ER_OK);
 	assert_int_equal(ec14, SCC_ER_OK);
 	assert_valid_digraph(&ut_make321, 4);
@@ -263,8 +306,8 @@ void scc_ut_digraph_union_and_delete_empty(void** state)
 	const iscc_Digraph sum_45[2] = {ut_dg4, ut_dg5};
 	iscc_Digraph ut_make45;
 	iscc_Digraph ut_make45_ttk;
-	scc_ErrorCode ec15 = iscc_digraph_union_and_delete(2, sum_45, 0, NULL, false, &ut_make45);
-	scc_ErrorCode ec16 = iscc_digraph_union_and_delete(2, sum_45, 2, tails_to_keep4, false, &ut_make45_ttk);
+	scc_ErrorCode ec15 = iscc_digraph_union_and_delete(2, sum_45, 0, NULL, false, 1, &ut_make45);
+	scc_ErrorCode ec16 = iscc_digraph_union_and_delete(2, sum_45, 2, tails_to_keep4, false, 1, &ut_make45_ttk);
 	assert_int_equal(ec15, SCC_ER_OK);
 	assert_int_equal(ec16, SCC_ER_OK);
 	assert_valid_digraph(&ut_make45, 4);
@@ -279,8 +322,8 @@ void scc_ut_digraph_union_and_delete_empty(void** state)
 	const iscc_Digraph sum_46[2] = {ut_dg4, ut_dg6};
 	iscc_Digraph ut_make46;
 	iscc_Digraph ut_make46_ttk;
-	scc_ErrorCode ec17 = iscc_digraph_union_and_delete(2, sum_46, 0, NULL, false, &ut_make46);
-	scc_ErrorCode ec18 = iscc_digraph_union_and_delete(2, sum_46, 2, tails_to_keep4, false, &ut_make46_ttk);
+	scc_ErrorCode ec17 = iscc_digraph_union_and_delete(2, sum_46, 0, NULL, false, 1, &ut_make46);
+	scc_ErrorCode ec18 = iscc_digraph_union_and_delete(2, sum_46, 2, tails_to_keep4, false, 1, &ut_make46_ttk);
 	assert_int_equal(ec17, SCC_ER_OK);
 	assert_int_equal(ec18, SCC_ER_OK);
 	assert_valid_digraph(&ut_make46, 4);
@@ -295,8 +338,8 @@ void scc_ut_digraph_union_and_delete_empty(void** state)
 	const iscc_Digraph sum_54[2] = {ut_dg5, ut_dg4};
 	iscc_Digraph ut_make54;
 	iscc_Digraph ut_make54_ttk;
-	scc_ErrorCode ec19 = iscc_digraph_union_and_delete(2, sum_54, 0, NULL, false, &ut_make54);
-	scc_ErrorCode ec20 = iscc_digraph_union_and_delete(2, sum_54, 2, tails_to_keep4, false, &ut_make54_ttk);
+	scc_ErrorCode ec19 = iscc_digraph_union_and_delete(2, sum_54, 0, NULL, false, 1, &ut_make54);
+	scc_ErrorCode ec20 = iscc_digraph_union_and_delete(2, sum_54, 2, tails_to_keep4, false, 1, &ut_make54_ttk);
 	assert_int_equal(ec19, SCC_ER_OK);
 	assert_int_equal(ec20, SCC_ER_OK);
 	assert_valid_digraph(&ut_make54, 4);
@@ -311,8 +354,8 @@ void scc_ut_digraph_union_and_delete_empty(void** state)
 	const iscc_Digraph sum_64[2] = {ut_dg6, ut_dg4};
 	iscc_Digraph ut_make64;
 	iscc_Digraph ut_make64_ttk;
-	scc_ErrorCode ec21 = iscc_digraph_union_and_delete(2, sum_64, 0, NULL, false, &ut_make64);
-	scc_ErrorCode ec22 = iscc_digraph_union_and_delete(2, sum_64, 2, tails_to_keep4, false, &ut_make64_ttk);
+	scc_ErrorCode ec21 = iscc_digraph_union_and_delete(2, sum_64, 0, NULL, false, 1, &ut_make64);
+	scc_ErrorCode ec22 = iscc_digraph_union_and_delete(2, sum_64, 2, tails_to_keep4, false, 1, &ut_make64_ttk);
 	assert_int_equal(ec21, SCC_ER_OK);
 	assert_int_equal(ec22, SCC_ER_OK);
 	assert_valid_digraph(&ut_make64, 4);
@@ -327,8 +370,8 @@ void scc_ut_digraph_union_and_delete_empty(void** state)
 	const iscc_Digraph sum_56[2] = {ut_dg5, ut_dg6};
 	iscc_Digraph ut_make56;
 	iscc_Digraph ut_make56_ttk;
-	scc_ErrorCode ec23 = iscc_digraph_union_and_delete(2, sum_56, 0, NULL, false, &ut_make56);
-	scc_ErrorCode ec24 = iscc_digraph_union_and_delete(2, sum_56, 2, tails_to_keep4, false, &ut_make56_ttk);
+	scc_ErrorCode ec23 = iscc_digraph_union_and_delete(2, sum_56, 0, NULL, false, 1, &ut_make56);
+	scc_ErrorCode ec24 = iscc_digraph_union_and_delete(2, sum_56, 2, tails_to_keep4, false, 1, &ut_make56_ttk);
 	assert_int_equal(ec23, SCC_ER_OK);
 	assert_int_equal(ec24, SCC_ER_OK);
 	assert_valid_digraph(&ut_make56, 4);
@@ -343,8 +386,8 @@ void scc_ut_digraph_union_and_delete_empty(void** state)
 	const iscc_Digraph sum_65[2] = {ut_dg6, ut_dg5};
 	iscc_Digraph ut_make65;
 	iscc_Digraph ut_make65_ttk;
-	scc_ErrorCode ec25 = iscc_digraph_union_and_delete(2, sum_65, 0, NULL, false, &ut_make65);
-	scc_ErrorCode ec26 = iscc_digraph_union_and_delete(2, sum_65, 2, tails_to_keep4, false, &ut_make65_ttk);
+	scc_ErrorCode ec25 = iscc_digraph_union_and_delete(2, sum_65, 0, NULL, false, 1, &ut_make65);
+	scc_ErrorCode ec26 = iscc_digraph_union_and_delete(2, sum_65, 2, tails_to_keep4, false, 1, &ut_make65_ttk);
 	assert_int_equal(ec25, SCC_ER_OK);
 	assert_int_equal(ec26, SCC_ER_OK);
 	assert_valid_digraph(&ut_make65, 4);
@@ -359,8 +402,8 @@ void scc_ut_digraph_union_and_delete_empty(void** state)
 	const iscc_Digraph sum_55[2] = {ut_dg5, ut_dg5};
 	iscc_Digraph ut_make55;
 	iscc_Digraph ut_make55_ttk;
-	scc_ErrorCode ec27 = iscc_digraph_union_and_delete(2, sum_55, 0, NULL, false, &ut_make55);
-	scc_ErrorCode ec28 = iscc_digraph_union_and_delete(2, sum_55, 2, tails_to_keep4, false, &ut_make55_ttk);
+	scc_ErrorCode ec27 = iscc_digraph_union_and_delete(2, sum_55, 0, NULL, false, 1, &ut_make55);
+	scc_ErrorCode ec28 = iscc_digraph_union_and_delete(2, sum_55, 2, tails_to_keep4, false, 1, &ut_make55_ttk);
 	assert_int_equal(ec27, SCC_ER_OK);
 	assert_int_equal(ec28, SCC_ER_OK);
 	assert_valid_digraph(&ut_make55, 4);
@@ -375,8 +418,8 @@ void scc_ut_digraph_union_and_delete_empty(void** state)
 	const iscc_Digraph sum_66[2] = {ut_dg6, ut_dg6};
 	iscc_Digraph ut_make66;
 	iscc_Digraph ut_make66_ttk;
-	scc_ErrorCode ec29 = iscc_digraph_union_and_delete(2, sum_66, 0, NULL, false, &ut_make66);
-	scc_ErrorCode ec30 = iscc_digraph_union_and_delete(2, sum_66, 2, tails_to_keep4, false, &ut_make66_ttk);
+	scc_ErrorCode ec29 = iscc_digraph_union_and_delete(2, sum_66, 0, NULL, false, 1, &ut_make66);
+	scc_ErrorCode ec30 = iscc_digraph_union_and_delete(2, sum_66, 2, tails_to_keep4, false, 1, &ut_make66_ttk);
 	assert_int_equal(ec29, SCC_ER_OK);
 	assert_int_equal(ec30, SCC_ER_OK);
 	assert_valid_digraph(&ut_make66, 4);
@@ -437,8 +480,8 @@ void scc_ut_digraph_union_and_delete_single(void** state)
 	const iscc_Digraph sum_7[1] = {ut_dg7};
 	iscc_Digraph ut_make7;
 	iscc_Digraph ut_make7_ttk;
-	scc_ErrorCode ec31 = iscc_digraph_union_and_delete(1, sum_7, 0, NULL, false, &ut_make7);
-	scc_ErrorCode ec32 = iscc_digraph_union_and_delete(1, sum_7, 2, tails_to_keep5, false, &ut_make7_ttk);
+	scc_ErrorCode ec31 = iscc_digraph_union_and_delete(1, sum_7, 0, NULL, false, 1, &ut_make7);
+	scc_ErrorCode ec32 = iscc_digraph_union_and_delete(1, sum_7, 2, tails_to_keep5, false, 1, &ut_make7_ttk);
 	assert_int_equal(ec31, SCC_ER_OK);
 	assert_int_equal(ec32, SCC_ER_OK);
 	assert_valid_digraph(&ut_make7, 4);
@@ -476,8 +519,8 @@ void scc_ut_digraph_union_and_delete_keep_loops(void** state)
 	const iscc_Digraph sum_12[2] = {ut_dg1, ut_dg2};
 	iscc_Digraph ut_make12_a;
 	iscc_Digraph ut_make12_a_ttk;
-	scc_ErrorCode ec1 = iscc_digraph_union_and_delete(2, sum_12, 0, NULL, true, &ut_make12_a);
-	scc_ErrorCode ec2 = iscc_digraph_union_and_delete(2, sum_12, 2, tails_to_keep1, true, &ut_make12_a_ttk);
+	scc_ErrorCode ec1 = iscc_digraph_union_and_delete(2, sum_12, 0, NULL, true, 1, &ut_make12_a);
+	scc_ErrorCode ec2 = iscc_digraph_union_and_delete(2, sum_12, 2, tails_to_keep1, true, 1, &ut_make12_a_ttk);
 	assert_int_equal(ec1, SCC_ER_OK);
 	assert_int_equal(ec2, SCC_ER_OK);
 	assert_valid_digraph(&ut_make12_a, 4);
@@ -495,8 +538,8 @@ void scc_ut_digraph_union_and_delete_keep_loops(void** state)
 	const iscc_Digraph sum_13[2] = {ut_dg1, ut_dg3};
 	iscc_Digraph ut_make13_a;
 	iscc_Digraph ut_make13_a_ttk;
-	scc_ErrorCode ec3 = iscc_digraph_union_and_delete(2, sum_13, 0, NULL, true, &ut_make13_a);
-	scc_ErrorCode ec4 = iscc_digraph_union_and_delete(2, sum_13, 2, tails_to_keep2, true, &ut_make13_a_ttk);
+	scc_ErrorCode ec3 = iscc_digraph_union_and_delete(2, sum_13, 0, NULL, true, 1, &ut_make13_a);
+	scc_ErrorCode ec4 = iscc_digraph_union_and_delete(2, sum_13, 2, tails_to_keep2, true, 1, &ut_make13_a_ttk);
 	assert_int_equal(ec3, SCC_ER_OK);
 	assert_int_equal(ec4, SCC_ER_OK);
 	assert_valid_digraph(&ut_make13_a, 4);
@@ -509,8 +552,8 @@ void scc_ut_digraph_union_and_delete_keep_loops(void** state)
 	const iscc_Digraph sum_31[2] = {ut_dg3, ut_dg1};
 	iscc_Digraph ut_make31_a;
 	iscc_Digraph ut_make31_a_ttk;
-	scc_ErrorCode ec5 = iscc_digraph_union_and_delete(2, sum_31, 0, NULL, true, &ut_make31_a);
-	scc_ErrorCode ec6 = iscc_digraph_union_and_delete(2, sum_31, 2, tails_to_keep3, true, &ut_make31_a_ttk);
+	scc_ErrorCode ec5 = iscc_digraph_union_and_delete(2, sum_31, 0, NULL, true, 1, &ut_make31_a);
+	scc_ErrorCode ec6 = iscc_digraph_union_and_delete(2, sum_31, 2, tails_to_keep3, true, 1, &ut_make31_a_ttk);
 	assert_int_equal(ec5, SCC_ER_OK);
 	assert_int_equal(ec6, SCC_ER_OK);
 	assert_valid_digraph(&ut_make31_a, 4);
@@ -526,8 +569,8 @@ void scc_ut_digraph_union_and_delete_keep_loops(void** state)
 	const iscc_Digraph sum_123[3] = {ut_dg1, ut_dg2, ut_dg3};
 	iscc_Digraph ut_make123;
 	iscc_Digraph ut_make123_ttk;
-	scc_ErrorCode ec7 = iscc_digraph_union_and_delete(3, sum_123, 0, NULL, true, &ut_make123);
-	scc_ErrorCode ec8 = iscc_digraph_union_and_delete(3, sum_123, 2, tails_to_keep1, true, &ut_make123_ttk);
+	scc_ErrorCode ec7 = iscc_digraph_union_and_delete(3, sum_123, 0, NULL, true, 1, &ut_make123);
+	scc_ErrorCode ec8 = iscc_digraph_union_and_delete(3, sum_123, 2, tails_to_keep1, true, 1, &ut_make123_ttk);
 	assert_int_equal(ec7, SCC_ER_OK);
 	assert_int_equal(ec8, SCC_ER_OK);
 	assert_valid_digraph(&ut_make123, 4);
@@ -540,8 +583,8 @@ void scc_ut_digraph_union_and_delete_keep_loops(void** state)
 	const iscc_Digraph sum_132[3] = {ut_dg1, ut_dg3, ut_dg2};
 	iscc_Digraph ut_make132;
 	iscc_Digraph ut_make132_ttk;
-	scc_ErrorCode ec9 = iscc_digraph_union_and_delete(3, sum_132, 0, NULL, true, &ut_make132);
-	scc_ErrorCode ec10 = iscc_digraph_union_and_delete(3, sum_132, 2, tails_to_keep2, true, &ut_make132_ttk);
+	scc_ErrorCode ec9 = iscc_digraph_union_and_delete(3, sum_132, 0, NULL, true, 1, &ut_make132);
+	scc_ErrorCode ec10 = iscc_digraph_union_and_delete(3, sum_132, 2, tails_to_keep2, true, 1, &ut_make132_ttk);
 	assert_int_equal(ec9, SCC_ER_OK);
 	assert_int_equal(ec10, SCC_ER_OK);
 	assert_valid_digraph(&ut_make132, 4);
@@ -554,8 +597,8 @@ void scc_ut_digraph_union_and_delete_keep_loops(void** state)
 	const iscc_Digraph sum_213[3] = {ut_dg2, ut_dg1, ut_dg3};
 	iscc_Digraph ut_make213;
 	iscc_Digraph ut_make213_ttk;
-	scc_ErrorCode ec11 = iscc_digraph_union_and_delete(3, sum_213, 0, NULL, true, &ut_make213);
-	scc_ErrorCode ec12 = iscc_digraph_union_and_delete(3, sum_213, 2, tails_to_keep3, true, &ut_make213_ttk);
+	scc_ErrorCode ec11 = iscc_digraph_union_and_delete(3, sum_213, 0, NULL, true, 1, &ut_make213);
+	scc_ErrorCode ec12 = iscc_digraph_union_and_delete(3, sum_213, 2, tails_to_keep3, true, 1, &ut_make213_ttk);
 	assert_int_equal(ec11, SCC_ER_OK);
 	assert_int_equal(ec12, SCC_ER_OK);
 	assert_valid_digraph(&ut_make213, 4);
@@ -568,8 +611,8 @@ void scc_ut_digraph_union_and_delete_keep_loops(void** state)
 	const iscc_Digraph sum_321[3] = {ut_dg3, ut_dg2, ut_dg1};
 	iscc_Digraph ut_make321;
 	iscc_Digraph ut_make321_ttk;
-	scc_ErrorCode ec13 = iscc_digraph_union_and_delete(3, sum_321, 0, NULL, true, &ut_make321);
-	scc_ErrorCode ec14 = iscc_digraph_union_and_delete(3, sum_321, 2, tails_to_keep1, true, &ut_make321_ttk);
+	scc_ErrorCode ec13 = iscc_digraph_union_and_delete(3, sum_321, 0, NULL, true, 1, &ut_make321);
+	scc_ErrorCode ec14 = iscc_digraph_union_and_delete(3, sum_321, 2, tails_to_keep1, true, 1, &ut_make321_ttk);
 	assert_int_equal(ec13, SCC_ER_OK);
 	assert_int_equal(ec14, SCC_ER_OK);
 	assert_valid_digraph(&ut_make321, 4);
@@ -624,8 +667,8 @@ void scc_ut_digraph_union_and_delete_keep_loops_empty(void** state)
 	const iscc_Digraph sum_45[2] = {ut_dg4, ut_dg5};
 	iscc_Digraph ut_make45;
 	iscc_Digraph ut_make45_ttk;
-	scc_ErrorCode ec15 = iscc_digraph_union_and_delete(2, sum_45, 0, NULL, true, &ut_make45);
-	scc_ErrorCode ec16 = iscc_digraph_union_and_delete(2, sum_45, 2, tails_to_keep4, true, &ut_make45_ttk);
+	scc_ErrorCode ec15 = iscc_digraph_union_and_delete(2, sum_45, 0, NULL, true, 1, &ut_make45);
+	scc_ErrorCode ec16 = iscc_digraph_union_and_delete(2, sum_45, 2, tails_to_keep4, true, 1, &ut_make45_ttk);
 	assert_int_equal(ec15, SCC_ER_OK);
 	assert_int_equal(ec16, SCC_ER_OK);
 	assert_valid_digraph(&ut_make45, 4);
@@ -640,8 +683,8 @@ void scc_ut_digraph_union_and_delete_keep_loops_empty(void** state)
 	const iscc_Digraph sum_46[2] = {ut_dg4, ut_dg6};
 	iscc_Digraph ut_make46;
 	iscc_Digraph ut_make46_ttk;
-	scc_ErrorCode ec17 = iscc_digraph_union_and_delete(2, sum_46, 0, NULL, true, &ut_make46);
-	scc_ErrorCode ec18 = iscc_digraph_union_and_delete(2, sum_46, 2, tails_to_keep4, true, &ut_make46_ttk);
+	scc_ErrorCode ec17 = iscc_digraph_union_and_delete(2, sum_46, 0, NULL, true, 1, &ut_make46);
+	scc_ErrorCode ec18 = iscc_digraph_union_and_delete(2, sum_46, 2, tails_to_keep4, true, 1, &ut_make46_ttk);
 	assert_int_equal(ec17, SCC_ER_OK);
 	assert_int_equal(ec18, SCC_ER_OK);
 	assert_valid_digraph(&ut_make46, 4);
@@ -656,8 +699,8 @@ void scc_ut_digraph_union_and_delete_keep_loops_empty(void** state)
 	const iscc_Digraph sum_54[2] = {ut_dg5, ut_dg4};
 	iscc_Digraph ut_make54;
 	iscc_Digraph ut_make54_ttk;
-	scc_ErrorCode ec19 = iscc_digraph_union_and_delete(2, sum_54, 0, NULL, true, &ut_make54);
-	scc_ErrorCode ec20 = iscc_digraph_union_and_delete(2, sum_54, 2, tails_to_keep4, true, &ut_make54_ttk);
+	scc_ErrorCode ec19 = iscc_digraph_union_and_delete(2, sum_54, 0, NULL, true, 1, &ut_make54);
+	scc_ErrorCode ec20 = iscc_digraph_union_and_delete(2, sum_54, 2, tails_to_keep4, true, 1, &ut_make54_ttk);
 	assert_int_equal(ec19, SCC_ER_OK);
 	assert_int_equal(ec20, SCC_ER_OK);
 	assert_valid_digraph(&ut_make54, 4);
@@ -672,8 +715,8 @@ void scc_ut_digraph_union_and_delete_keep_loops_empty(void** state)
 	const iscc_Digraph sum_64[2] = {ut_dg6, ut_dg4};
 	iscc_Digraph ut_make64;
 	iscc_Digraph ut_make64_ttk;
-	scc_ErrorCode ec21 = iscc_digraph_union_and_delete(2, sum_64, 0, NULL, true, &ut_make64);
-	scc_ErrorCode ec22 = iscc_digraph_union_and_delete(2, sum_64, 2, tails_to_keep4, true, &ut_make64_ttk);
+	scc_ErrorCode ec21 = iscc_digraph_union_and_delete(2, sum_64, 0, NULL, true, 1, &ut_make64);
+	scc_ErrorCode ec22 = iscc_digraph_union_and_delete(2, sum_64, 2, tails_to_keep4, true, 1, &ut_make64_ttk);
 	assert_int_equal(ec21, SCC_ER_OK);
 	assert_int_equal(ec22, SCC_ER_OK);
 	assert_valid_digraph(&ut_make64, 4);
@@ -688,8 +731,8 @@ void scc_ut_digraph_union_and_delete_keep_loops_empty(void** state)
 	const iscc_Digraph sum_56[2] = {ut_dg5, ut_dg6};
 	iscc_Digraph ut_make56;
 	iscc_Digraph ut_make56_ttk;
-	scc_ErrorCode ec23 = iscc_digraph_union_and_delete(2, sum_56, 0, NULL, true, &ut_make56);
-	scc_ErrorCode ec24 = iscc_digraph_union_and_delete(2, sum_56, 2, tails_to_keep4, true, &ut_make56_ttk);
+	scc_ErrorCode ec23 = iscc_digraph_union_and_delete(2, sum_56, 0, NULL, true, 1, &ut_make56);
+	scc_ErrorCode ec24 = iscc_digraph_union_and_delete(2, sum_56, 2, tails_to_keep4, true, 1, &ut_make56_ttk);
 	assert_int_equal(ec23, SCC_ER_OK);
 	assert_int_equal(ec24, SCC_ER_OK);
 	assert_valid_digraph(&ut_make56, 4);
@@ -704,8 +747,8 @@ void scc_ut_digraph_union_and_delete_keep_loops_empty(void** state)
 	const iscc_Digraph sum_65[2] = {ut_dg6, ut_dg5};
 	iscc_Digraph ut_make65;
 	iscc_Digraph ut_make65_ttk;
-	scc_ErrorCode ec25 = iscc_digraph_union_and_delete(2, sum_65, 0, NULL, true, &ut_make65);
-	scc_ErrorCode ec26 = iscc_digraph_union_and_delete(2, sum_65, 2, tails_to_keep4, true, &ut_make65_ttk);
+	scc_ErrorCode ec25 = iscc_digraph_union_and_delete(2, sum_65, 0, NULL, true, 1, &ut_make65);
+	scc_ErrorCode ec26 = iscc_digraph_union_and_delete(2, sum_65, 2, tails_to_keep4, true, 1, &ut_make65_ttk);
 	assert_int_equal(ec25, SCC_ER_OK);
 	assert_int_equal(ec26, SCC_ER_OK);
 	assert_valid_digraph(&ut_make65, 4);
@@ -720,8 +763,8 @@ void scc_ut_digraph_union_and_delete_keep_loops_empty(void** state)
 	const iscc_Digraph sum_55[2] = {ut_dg5, ut_dg5};
 	iscc_Digraph ut_make55;
 	iscc_Digraph ut_make55_ttk;
-	scc_ErrorCode ec27 = iscc_digraph_union_and_delete(2, sum_55, 0, NULL, true, &ut_make55);
-	scc_ErrorCode ec28 = iscc_digraph_union_and_delete(2, sum_55, 2, tails_to_keep4, true, &ut_make55_ttk);
+	scc_ErrorCode ec27 = iscc_digraph_union_and_delete(2, sum_55, 0, NULL, true, 1, &ut_make55);
+	scc_ErrorCode ec28 = iscc_digraph_union_and_delete(2, sum_55, 2, tails_to_keep4, true, 1, &ut_make55_ttk);
 	assert_int_equal(ec27, SCC_ER_OK);
 	assert_int_equal(ec28, SCC_ER_OK);
 	assert_valid_digraph(&ut_make55, 4);
@@ -736,8 +779,8 @@ void scc_ut_digraph_union_and_delete_keep_loops_empty(void** state)
 	const iscc_Digraph sum_66[2] = {ut_dg6, ut_dg6};
 	iscc_Digraph ut_make66;
 	iscc_Digraph ut_make66_ttk;
-	scc_ErrorCode ec29 = iscc_digraph_union_and_delete(2, sum_66, 0, NULL, true, &ut_make66);
-	scc_ErrorCode ec30 = iscc_digraph_union_and_delete(2, sum_66, 2, tails_to_keep4, true, &ut_make66_ttk);
+	scc_ErrorCode ec29 = iscc_digraph_union_and_delete(2, sum_66, 0, NULL, true, 1, &ut_make66);
+	scc_ErrorCode ec30 = iscc_digraph_union_and_delete(2, sum_66, 2, tails_to_keep4, true, 1, &ut_make66_ttk);
 	assert_int_equal(ec29, SCC_ER_OK);
 	assert_int_equal(ec30, SCC_ER_OK);
 	assert_valid_digraph(&ut_make66, 4);
@@ -798,8 +841,8 @@ void scc_ut_digraph_union_and_delete_keep_loops_single(void** state)
 	const iscc_Digraph sum_7[1] = {ut_dg7};
 	iscc_Digraph ut_make7;
 	iscc_Digraph ut_make7_ttk;
-	scc_ErrorCode ec31 = iscc_digraph_union_and_delete(1, sum_7, 0, NULL, true, &ut_make7);
-	scc_ErrorCode ec32 = iscc_digraph_union_and_delete(1, sum_7, 2, tails_to_keep5, true, &ut_make7_ttk);
+	scc_ErrorCode ec31 = iscc_digraph_union_and_delete(1, sum_7, 0, NULL, true, 1, &ut_make7);
+	scc_ErrorCode ec32 = iscc_digraph_union_and_delete(1, sum_7, 2, tails_to_keep5, true, 1, &ut_make7_ttk);
 	assert_int_equal(ec31, SCC_ER_OK);
 	assert_int_equal(ec32, SCC_ER_OK);
 	assert_valid_digraph(&ut_make7, 4);
@@ -1084,17 +1127,17 @@ void scc_ut_digraph_transpose(void** state)
 	iscc_empty_digraph(4, 0, &control6);
 
 	iscc_Digraph res1;
-	scc_ErrorCode ec1 = iscc_digraph_transpose(&ut_dg1, &res1);
+	scc_ErrorCode ec1 = iscc_digraph_transpose(&ut_dg1, 1, &res1);
 	iscc_Digraph res2;
-	scc_ErrorCode ec2 = iscc_digraph_transpose(&ut_dg2, &res2);
+	scc_ErrorCode ec2 = iscc_digraph_transpose(&ut_dg2, 1, &res2);
 	iscc_Digraph res3;
-	scc_ErrorCode ec3 = iscc_digraph_transpose(&ut_dg3, &res3);
+	scc_ErrorCode ec3 = iscc_digraph_transpose(&ut_dg3, 1, &res3);
 	iscc_Digraph res4;
-	scc_ErrorCode ec4 = iscc_digraph_transpose(&ut_dg4, &res4);
+	scc_ErrorCode ec4 = iscc_digraph_transpose(&ut_dg4, 1, &res4);
 	iscc_Digraph res5;
-	scc_ErrorCode ec5 = iscc_digraph_transpose(&ut_dg5, &res5);
+	scc_ErrorCode ec5 = iscc_digraph_transpose(&ut_dg5, 1, &res5);
 	iscc_Digraph res6;
-	scc_ErrorCode ec6 = iscc_digraph_transpose(&ut_dg6, &res6);
+	scc_ErrorCode ec6 = iscc_digraph_transpose(&ut_dg6, 1, &res6);
 
 	assert_int_equal(ec1, SCC_ER_OK);
 	assert_int_equal(ec2, SCC_ER_OK);
@@ -1138,6 +1181,53 @@ void scc_ut_digraph_transpose(void** state)
 }
 
 
+void scc_ut_digraph_transpose_compressed(void** state)
+{
+	(void) state;
+
+	iscc_Digraph ut_dg1;
+	iscc_digraph_from_string("##.#/..#./.###/#.../", &ut_dg1);
+	iscc_Digraph ut_dg2;
+	iscc_digraph_from_string("..../..../..../..../", &ut_dg2);
+	assert_int_equal(iscc_digraph_compress(&ut_dg1), SCC_ER_OK);
+	assert_int_equal(iscc_digraph_compress(&ut_dg2), SCC_ER_OK);
+
+	iscc_Digraph control1;
+	iscc_digraph_from_string("#..#/#.#./.##./#.#./", &control1);
+	iscc_Digraph control2;
+	iscc_empty_digraph(4, 0, &control2);
+
+	// Compressed digraphs are always transposed serially
+	iscc_Digraph res1;
+	scc_ErrorCode ec1 = iscc_digraph_transpose(&ut_dg1, 1, &res1);
+	iscc_Digraph res2;
+	scc_ErrorCode ec2 = iscc_digraph_transpose(&ut_dg1, 4, &res2);
+	iscc_Digraph res3;
+	scc_ErrorCode ec3 = iscc_digraph_transpose(&ut_dg2, 1, &res3);
+
+	assert_int_equal(ec1, SCC_ER_OK);
+	assert_int_equal(ec2, SCC_ER_OK);
+	assert_int_equal(ec3, SCC_ER_OK);
+
+	assert_valid_digraph(&res1, 4);
+	assert_valid_digraph(&res2, 4);
+	assert_valid_digraph(&res3, 4);
+	assert_false(iscc_digraph_is_compressed(&res1));
+
+	assert_equal_digraph(&res1, &control1);
+	assert_equal_digraph(&res2, &control1);
+	assert_equal_digraph(&res3, &control2);
+
+	assert_free_digraph(&ut_dg1);
+	assert_free_digraph(&ut_dg2);
+	assert_free_digraph(&control1);
+	assert_free_digraph(&control2);
+	assert_free_digraph(&res1);
+	assert_free_digraph(&res2);
+	assert_free_digraph(&res3);
+}
+
+
 void scc_ut_adjacency_product(void** state)
 {
 	(void) state;
@@ -1154,7 +1244,7 @@ void scc_ut_adjacency_product(void** state)
 	iscc_Digraph control1;
 	iscc_digraph_from_string(".#.#./..#../...#./.#.../..#../", &control1);
 	iscc_Digraph prod1;
-	scc_ErrorCode ec1 = iscc_adjacency_product(&dg1, &dg1, false, &prod1);
+	scc_ErrorCode ec1 = iscc_adjacency_product(&dg1, &dg1, false, 1, &prod1);
 	assert_int_equal(ec1, SCC_ER_OK);
 	assert_valid_digraph(&prod1, 5);
 	assert_equal_digraph(&prod1, &control1);
@@ -1162,9 +1252,9 @@ void scc_ut_adjacency_product(void** state)
 	iscc_Digraph control2;
 	iscc_digraph_from_string(".#.#./..##./.#.#./.##../..##./", &control2);
 	iscc_Digraph prod2;
-	scc_ErrorCode ec2 = iscc_adjacency_product(&dg1, &dg1, true, &prod2);
+	scc_ErrorCode ec2 = iscc_adjacency_product(&dg1, &dg1, true, 1, &prod2);
 	iscc_Digraph prod2alt;
-	scc_ErrorCode ec2alt = iscc_adjacency_product(&dg1_f, &dg1, false, &prod2alt);
+	scc_ErrorCode ec2alt = iscc_adjacency_product(&dg1_f, &dg1, false, 1, &prod2alt);
 	assert_int_equal(ec2, SCC_ER_OK);
 	assert_int_equal(ec2alt, SCC_ER_OK);
 	assert_valid_digraph(&prod2, 5);
@@ -1175,7 +1265,7 @@ void scc_ut_adjacency_product(void** state)
 	iscc_Digraph control3;
 	iscc_digraph_from_string(".###./..#../...#./.#.../.##../", &control3);
 	iscc_Digraph prod3;
-	scc_ErrorCode ec3 = iscc_adjacency_product(&dg1, &prod2, false, &prod3);
+	scc_ErrorCode ec3 = iscc_adjacency_product(&dg1, &prod2, false, 1, &prod3);
 	assert_int_equal(ec3, SCC_ER_OK);
 	assert_valid_digraph(&prod3, 5);
 	assert_equal_digraph(&prod3, &control3);
@@ -1183,9 +1273,9 @@ void scc_ut_adjacency_product(void** state)
 	iscc_Digraph control4;
 	iscc_digraph_from_string(".###./..##./.#.#./.##../.###./", &control4);
 	iscc_Digraph prod4;
-	scc_ErrorCode ec4 = iscc_adjacency_product(&dg1, &prod2, true, &prod4);
+	scc_ErrorCode ec4 = iscc_adjacency_product(&dg1, &prod2, true, 1, &prod4);
 	iscc_Digraph prod4alt;
-	scc_ErrorCode ec4alt = iscc_adjacency_product(&dg1_f, &prod2, false, &prod4alt);
+	scc_ErrorCode ec4alt = iscc_adjacency_product(&dg1_f, &prod2, false, 1, &prod4alt);
 	assert_int_equal(ec4, SCC_ER_OK);
 	assert_int_equal(ec4alt, SCC_ER_OK);
 	assert_valid_digraph(&prod4, 5);
@@ -1196,7 +1286,7 @@ void scc_ut_adjacency_product(void** state)
 	iscc_Digraph control5;
 	iscc_digraph_from_string("..##./..#../...#./...../..#../", &control5);
 	iscc_Digraph prod5;
-	scc_ErrorCode ec5 = iscc_adjacency_product(&dg1, &dg2, false, &prod5);
+	scc_ErrorCode ec5 = iscc_adjacency_product(&dg1, &dg2, false, 1, &prod5);
 	assert_int_equal(ec5, SCC_ER_OK);
 	assert_valid_digraph(&prod5, 5);
 	assert_equal_digraph(&prod5, &control5);
@@ -1204,9 +1294,9 @@ void scc_ut_adjacency_product(void** state)
 	iscc_Digraph control6;
 	iscc_digraph_from_string("..##./..##./...#./..#../#.#../", &control6);
 	iscc_Digraph prod6;
-	scc_ErrorCode ec6 = iscc_adjacency_product(&dg1, &dg2, true, &prod6);
+	scc_ErrorCode ec6 = iscc_adjacency_product(&dg1, &dg2, true, 1, &prod6);
 	iscc_Digraph prod6alt;
-	scc_ErrorCode ec6alt = iscc_adjacency_product(&dg1_f, &dg2, false, &prod6alt);
+	scc_ErrorCode ec6alt = iscc_adjacency_product(&dg1_f, &dg2, false, 1, &prod6alt);
 	assert_int_equal(ec6, SCC_ER_OK);
 	assert_int_equal(ec6alt, SCC_ER_OK);
 	assert_valid_digraph(&prod6, 5);
@@ -1217,7 +1307,7 @@ void scc_ut_adjacency_product(void** state)
 	iscc_Digraph control7;
 	iscc_digraph_from_string(".#.../..#../...../.#.../##.../", &control7);
 	iscc_Digraph prod7;
-	scc_ErrorCode ec7 = iscc_adjacency_product(&dg2, &dg1, false, &prod7);
+	scc_ErrorCode ec7 = iscc_adjacency_product(&dg2, &dg1, false, 1, &prod7);
 	assert_int_equal(ec7, SCC_ER_OK);
 	assert_valid_digraph(&prod7, 5);
 	assert_equal_digraph(&prod7, &control7);
@@ -1225,9 +1315,9 @@ void scc_ut_adjacency_product(void** state)
 	iscc_Digraph control8;
 	iscc_digraph_from_string(".#.../..##./.#.../.##../##.#./", &control8);
 	iscc_Digraph prod8;
-	scc_ErrorCode ec8 = iscc_adjacency_product(&dg2, &dg1, true, &prod8);
+	scc_ErrorCode ec8 = iscc_adjacency_product(&dg2, &dg1, true, 1, &prod8);
 	iscc_Digraph prod8alt;
-	scc_ErrorCode ec8alt = iscc_adjacency_product(&dg2_f, &dg1, false, &prod8alt);
+	scc_ErrorCode ec8alt = iscc_adjacency_product(&dg2_f, &dg1, false, 1, &prod8alt);
 	assert_int_equal(ec8, SCC_ER_OK);
 	assert_int_equal(ec8alt, SCC_ER_OK);
 	assert_valid_digraph(&prod8, 5);
@@ -1262,12 +1352,90 @@ void scc_ut_adjacency_product(void** state)
 }
 
 
+static void scc_ut_random_digraph(const size_t vertices,
+                                  const size_t max_out_degree,
+                                  iscc_Digraph* const out_dg)
+{
+	assert_int_equal(iscc_init_digraph(vertices, vertices * max_out_degree, out_dg), SCC_ER_OK);
+	out_dg->tail_ptr[0] = 0;
+	iscc_ArcIndex arcs = 0;
+	for (size_t v = 0; v < vertices; ++v) {
+		const size_t out_degree = (size_t) rand() % (max_out_degree + 1);
+		for (size_t i = 0; i < out_degree; ++i) {
+			out_dg->head[arcs] = (scc_PointIndex) ((size_t) rand() % vertices);
+			++arcs;
+		}
+		out_dg->tail_ptr[v + 1] = arcs;
+	}
+}
+
+
+void scc_ut_digraph_operations_threads(void** state)
+{
+	(void) state;
+
+	// Large enough to be split between threads
+	const size_t vertices = 5000;
+	iscc_Digraph dg1;
+	iscc_Digraph dg2;
+	scc_ut_random_digraph(vertices, 6, &dg1);
+	scc_ut_random_digraph(vertices, 3, &dg2);
+
+	scc_PointIndex tails_to_keep[5000];
+	size_t len_tails_to_keep = 0;
+	for (scc_PointIndex v = 0; v < (scc_PointIndex) vertices; ++v) {
+		if (rand() % 3 != 0) {
+			tails_to_keep[len_tails_to_keep] = v;
+			++len_tails_to_keep;
+		}
+	}
+
+	for (uint32_t num_threads = 2; num_threads <= 5; num_threads += 3) {
+		iscc_Digraph ref_dg;
+		iscc_Digraph test_dg;
+
+		assert_int_equal(iscc_digraph_transpose(&dg1, 1, &ref_dg), SCC_ER_OK);
+		assert_int_equal(iscc_digraph_transpose(&dg1, num_threads, &test_dg), SCC_ER_OK);
+		assert_identical_digraph(&ref_dg, &test_dg);
+		iscc_free_digraph(&ref_dg);
+		iscc_free_digraph(&test_dg);
+
+		const iscc_Digraph sum_12[2] = {dg1, dg2};
+		for (int keep_self_loops = 0; keep_self_loops < 2; ++keep_self_loops) {
+			assert_int_equal(iscc_digraph_union_and_delete(2, sum_12, 0, NULL, keep_self_loops, 1, &ref_dg), SCC_ER_OK);
+			assert_int_equal(iscc_digraph_union_and_delete(2, sum_12, 0, NULL, keep_self_loops, num_threads, &test_dg), SCC_ER_OK);
+			assert_identical_digraph(&ref_dg, &test_dg);
+			iscc_free_digraph(&ref_dg);
+			iscc_free_digraph(&test_dg);
+
+			assert_int_equal(iscc_digraph_union_and_delete(2, sum_12, len_tails_to_keep, tails_to_keep, keep_self_loops, 1, &ref_dg), SCC_ER_OK);
+			assert_int_equal(iscc_digraph_union_and_delete(2, sum_12, len_tails_to_keep, tails_to_keep, keep_self_loops, num_threads, &test_dg), SCC_ER_OK);
+			assert_identical_digraph(&ref_dg, &test_dg);
+			iscc_free_digraph(&ref_dg);
+			iscc_free_digraph(&test_dg);
+		}
+
+		for (int force_loops = 0; force_loops < 2; ++force_loops) {
+			assert_int_equal(iscc_adjacency_product(&dg1, &dg2, force_loops, 1, &ref_dg), SCC_ER_OK);
+			assert_int_equal(iscc_adjacency_product(&dg1, &dg2, force_loops, num_threads, &test_dg), SCC_ER_OK);
+			assert_identical_digraph(&ref_dg, &test_dg);
+			iscc_free_digraph(&ref_dg);
+			iscc_free_digraph(&test_dg);
+		}
+	}
+
+	iscc_free_digraph(&dg1);
+	iscc_free_digraph(&dg2);
+}
+
+
 int main(void)
 {
 	if(!scc_ut_init_tests()) return 1;
 
 	const struct CMUnitTest test_cases[] = {
 		cmocka_unit_test(scc_ut_delete_loops),
+		cmocka_unit_test(scc_ut_delete_loops_fixed),
 		cmocka_unit_test(scc_ut_digraph_union_and_delete),
 		cmocka_unit_test(scc_ut_digraph_union_and_delete_empty),
 		cmocka_unit_test(scc_ut_digraph_union_and_delete_single),
@@ -1276,7 +1444,9 @@ int main(void)
 		cmocka_unit_test(scc_ut_digraph_union_and_delete_keep_loops_single),
 		cmocka_unit_test(scc_ut_digraph_difference),
 		cmocka_unit_test(scc_ut_digraph_transpose),
+		cmocka_unit_test(scc_ut_digraph_transpose_compressed),
 		cmocka_unit_test(scc_ut_adjacency_product),
+		cmocka_unit_test(scc_ut_digraph_operations_threads),
 	};
 
 	return cmocka_run_group_tests_name("digraph_operations.c", test_cases, NULL, NULL);
@@ -854,7 +854,7 @@ void scc_ut_do_adjacency_product(void** state)
 
 	const uint64_t count_ref1 = 6;
 	iscc_Digraph prod1;
-	iscc_adjacency_product(&dg1, &dg1, false, &prod1);
+	iscc_adjacency_product(&dg1, &dg1, false, 1, &prod1);
 	const uint64_t count1 = iscc_do_adjacency_product(&dg1, &dg1, row_markers, false, false, NULL, NULL);
 	assert_valid_digraph(&prod1, 5);
 	assert_int_equal(count1, count_ref1);
@@ -862,10 +862,10 @@ void scc_ut_do_adjacency_product(void** state)
 
 	const uint64_t count_ref2 = 10;
 	iscc_Digraph prod2;
-	iscc_adjacency_product(&dg1, &dg1, true, &prod2);
+	iscc_adjacency_product(&dg1, &dg1, true, 1, &prod2);
 	const uint64_t count2 = iscc_do_adjacency_product(&dg1, &dg1, row_markers, true, false, NULL, NULL);
 	iscc_Digraph prod2alt;
-	iscc_adjacency_product(&dg1_f, &dg1, false, &prod2alt);
+	iscc_adjacency_product(&dg1_f, &dg1, false, 1, &prod2alt);
 	const uint64_t count2alt = iscc_do_adjacency_product(&dg1_f, &dg1, row_markers, false, false, NULL, NULL);
 	assert_valid_digraph(&prod2, 5);
 	assert_valid_digraph(&prod2alt, 5);
@@ -876,7 +876,7 @@ void scc_ut_do_adjacency_product(void** state)
 
 	const uint64_t count_ref3 = 8;
 	iscc_Digraph prod3;
-	iscc_adjacency_product(&dg1, &prod2, false, &prod3);
+	iscc_adjacency_product(&dg1, &prod2, false, 1, &prod3);
 	const uint64_t count3 = iscc_do_adjacency_product(&dg1, &prod2, row_markers, false, false, NULL, NULL);
 	assert_valid_digraph(&prod3, 5);
 	assert_int_equal(count3, count_ref3);
@@ -884,10 +884,10 @@ void scc_ut_do_adjacency_product(void** state)
 
 	const uint64_t count_ref4 = 12;
 	iscc_Digraph prod4;
-	iscc_adjacency_product(&dg1, &prod2, true, &prod4);
+	iscc_adjacency_product(&dg1, &prod2, true, 1, &prod4);
 	const uint64_t count4 = iscc_do_adjacency_product(&dg1, &prod2, row_markers, true, false, NULL, NULL);
 	iscc_Digraph prod4alt;
-	iscc_adjacency_product(&dg1_f, &prod2, false, &prod4alt);
+	iscc_adjacency_product(&dg1_f, &prod2, false, 1, &prod4alt);
 	const uint64_t count4alt = iscc_do_adjacency_product(&dg1_f, &prod2, row_markers, false, false, NULL, NULL);
 	assert_valid_digraph(&prod4, 5);
 	assert_valid_digraph(&prod4alt, 5);
@@ -898,7 +898,7 @@ void scc_ut_do_adjacency_product(void** state)
 
 	const uint64_t count_ref5 = 5;
 	iscc_Digraph prod5;
-	iscc_adjacency_product(&dg1, &dg2, false, &prod5);
+	iscc_adjacency_product(&dg1, &dg2, false, 1, &prod5);
 	const uint64_t count5 = iscc_do_adjacency_product(&dg1, &dg2, row_markers, false, false, NULL, NULL);
 	assert_valid_digraph(&prod5, 5);
 	assert_int_equal(count5, count_ref5);
@@ -906,10 +906,10 @@ void scc_ut_do_adjacency_product(void** state)
 
 	const uint64_t count_ref6 = 8;
 	iscc_Digraph prod6;
-	iscc_adjacency_product(&dg1, &dg2, true, &prod6);
+	iscc_adjacency_product(&dg1, &dg2, true, 1, &prod6);
 	const uint64_t count6 = iscc_do_adjacency_product(&dg1, &dg2, row_markers, true, false, NULL, NULL);
 	iscc_Digraph prod6alt;
-	iscc_adjacency_product(&dg1_f, &dg2, false, &prod6alt);
+	iscc_adjacency_product(&dg1_f, &dg2, false, 1, &prod6alt);
 	const uint64_t count6alt = iscc_do_adjacency_product(&dg1_f, &dg2, row_markers, false, false, NULL, NULL);
 	assert_valid_digraph(&prod6, 5);
 	assert_valid_digraph(&prod6alt, 5);
@@ -920,7 +920,7 @@ void scc_ut_do_adjacency_product(void** state)
 
 	const uint64_t count_ref7 = 5;
 	iscc_Digraph prod7;
-	iscc_adjacency_product(&dg2, &dg1, false, &prod7);
+	iscc_adjacency_product(&dg2, &dg1, false, 1, &prod7);
 	const uint64_t count7 = iscc_do_adjacency_product(&dg2, &dg1, row_markers, false, false, NULL, NULL);
 	assert_valid_digraph(&prod7, 5);
 	assert_int_equal(count7, count_ref7);
@@ -928,10 +928,10 @@ void scc_ut_do_adjacency_product(void** state)
 
 	const uint64_t count_ref8 = 9;
 	iscc_Digraph prod8;
-	iscc_adjacency_product(&dg2, &dg1, true, &prod8);
+	iscc_adjacency_product(&dg2, &dg1, true, 1, &prod8);
 	const uint64_t count8 = iscc_do_adjacency_product(&dg2, &dg1, row_markers, true, false, NULL, NULL);
 	iscc_Digraph prod8alt;
-	iscc_adjacency_product(&dg2_f, &dg1, false, &prod8alt);
+	iscc_adjacency_product(&dg2_f, &dg1, false, 1, &prod8alt);
 	const uint64_t count8alt = iscc_do_adjacency_product(&dg2_f, &dg1, row_markers, false, false, NULL, NULL);
 	assert_valid_digraph(&prod8, 5);
 	assert_valid_digraph(&prod8alt, 5);
@@ -0,0 +1,181 @@
+/* =============================================================================
+ * scclust -- A C library for size-constrained clustering
+ * https://github.com/fsavje/scclust
+ *
+ * Copyright (C) 2015-2017  Fredrik Savje -- http://fredriksavje.com
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see http://www.gnu.org/licenses/
+ * ========================================================================== */
+
+#include "init_test.h"
+#include <float.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <src/dist_kernels.h>
+
+
+void scc_ut_sq_dist_sequential(void** state)
+{
+	(void) state;
+
+	const double data1[5] = { 1.0, 2.0, 3.0, 4.0, 5.0 };
+	const double data2[5] = { 2.0, 0.0, 3.0, 1.0, -5.0 };
+
+	assert_true(fabs(iscc_sq_dist_sequential(data1, data2, 1) - 1.0) < DBL_EPSILON);
+	assert_true(fabs(iscc_sq_dist_sequential(data1, data2, 2) - 5.0) < DBL_EPSILON);
+	assert_true(fabs(iscc_sq_dist_sequential(data1, data2, 5) - 114.0) < DBL_EPSILON);
+	assert_true(fabs(iscc_sq_dist_sequential(data1, data1, 5)) < DBL_EPSILON);
+}
+
+
+void scc_ut_sq_dist_kernel(void** state)
+{
+	(void) state;
+
+	double data1[76];
+	double data2[76];
+	for (size_t i = 0; i < 76; ++i) {
+		data1[i] = ((double) rand() / RAND_MAX) * 200.0 - 100.0;
+		data2[i] = ((double) rand() / RAND_MAX) * 200.0 - 100.0;
+	}
+
+	assert_non_null(iscc_sq_dist_kernel);
+	for (size_t num_dimensions = 1; num_dimensions <= 73; ++num_dimensions) {
+		const double ref = iscc_sq_dist_sequential(data1, data2, num_dimensions);
+		const double res = iscc_sq_dist_kernel(data1, data2, num_dimensions);
+		assert_true(fabs(res - ref) <= ((double) num_dimensions) * DBL_EPSILON * ref);
+		// Offsets check unaligned loads
+		const double ref_off = iscc_sq_dist_sequential(data1 + 1, data2 + 3, num_dimensions - 1);
+		const double res_off = iscc_sq_dist_kernel(data1 + 1, data2 + 3, num_dimensions - 1);
+		assert_true(fabs(res_off - ref_off) <= ((double) num_dimensions) * DBL_EPSILON * ref_off);
+		assert_true(iscc_sq_dist_kernel(data1, data1, num_dimensions) < DBL_EPSILON);
+	}
+}
+
+
+void scc_ut_dot_block_kernel(void** state)
+{
+	(void) state;
+
+	double data[8][61];
+	for (size_t i = 0; i < 8; ++i) {
+		for (size_t d = 0; d < 61; ++d) {
+			data[i][d] = ((double) rand() / RAND_MAX) * 200.0 - 100.0;
+		}
+	}
+	const double* const rows1[ISCC_DOT_BLOCK] = { data[0], data[1], data[2], data[2] };
+	const double* const rows2[ISCC_DOT_BLOCK] = { data[4] + 1, data[5], data[6], data[7] };
+
+	assert_non_null(iscc_dot_block_kernel);
+	for (size_t num_dimensions = 1; num_dimensions <= 60; ++num_dimensions) {
+		double ref[ISCC_DOT_BLOCK][ISCC_DOT_BLOCK];
+		double res[ISCC_DOT_BLOCK][ISCC_DOT_BLOCK];
+		iscc_dot_block_sequential(rows1, rows2, num_dimensions, ref);
+		iscc_dot_block_kernel(rows1, rows2, num_dimensions, res);
+		for (size_t i = 0; i < ISCC_DOT_BLOCK; ++i) {
+			for (size_t j = 0; j < ISCC_DOT_BLOCK; ++j) {
+				double sum_abs = 0.0;
+				for (size_t d = 0; d < num_dimensions; ++d) {
+					sum_abs += fabs(rows1[i][d] * rows2[j][d]);
+				}
+				assert_true(fabs(res[i][j] - ref[i][j]) <= ((double) num_dimensions) * DBL_EPSILON * sum_abs);
+			}
+		}
+	}
+
+	double ref[ISCC_DOT_BLOCK][ISCC_DOT_BLOCK];
+	iscc_dot_block_sequential(rows1, rows2, 3, ref);
+	double tmp_dot = 0.0;
+	for (size_t d = 0; d < 3; ++d) {
+		tmp_dot += data[1][d] * data[5][d];
+	}
+	assert_true(fabs(ref[1][1] - tmp_dot) < DBL_EPSILON);
+}
+
+
+void scc_ut_sq_dist_kernel_f32(void** state)
+{
+	(void) state;
+
+	float data1_f32[76];
+	float data2_f32[76];
+	double data1[76];
+	double data2[76];
+	for (size_t i = 0; i < 76; ++i) {
+		data1_f32[i] = (float) (((double) rand() / RAND_MAX) * 200.0 - 100.0);
+		data2_f32[i] = (float) (((double) rand() / RAND_MAX) * 200.0 - 100.0);
+		data1[i] = (double) data1_f32[i];
+		data2[i] = (double) data2_f32[i];
+	}
+
+	assert_non_null(iscc_sq_dist_kernel_f32);
+	for (size_t num_dimensions = 1; num_dimensions <= 73; ++num_dimensions) {
+		const double ref = iscc_sq_dist_sequential(data1, data2, num_dimensions);
+		assert_true(fabs(iscc_sq_dist_sequential_f32(data1_f32, data2_f32, num_dimensions) - ref) < DBL_EPSILON);
+		// Same summation order as the double-precision kernel
+		const double res = iscc_sq_dist_kernel_f32(data1_f32, data2_f32, num_dimensions);
+		assert_true(fabs(res - iscc_sq_dist_kernel(data1, data2, num_dimensions)) < DBL_EPSILON);
+		const double res_off = iscc_sq_dist_kernel_f32(data1_f32 + 1, data2_f32 + 3, num_dimensions - 1);
+		assert_true(fabs(res_off - iscc_sq_dist_kernel(data1 + 1, data2 + 3, num_dimensions - 1)) < DBL_EPSILON);
+	}
+}
+
+
+void scc_ut_dot_block_kernel_f32(void** state)
+{
+	(void) state;
+
+	float data_f32[8][61];
+	double data[8][61];
+	for (size_t i = 0; i < 8; ++i) {
+		for (size_t d = 0; d < 61; ++d) {
+			data_f32[i][d] = (float) (((double) rand() / RAND_MAX) * 200.0 - 100.0);
+			data[i][d] = (double) data_f32[i][d];
+		}
+	}
+	const float* const rows1_f32[ISCC_DOT_BLOCK] = { data_f32[0], data_f32[1], data_f32[2], data_f32[2] };
+	const float* const rows2_f32[ISCC_DOT_BLOCK] = { data_f32[4] + 1, data_f32[5], data_f32[6], data_f32[7] };
+	const double* const rows1[ISCC_DOT_BLOCK] = { data[0], data[1], data[2], data[2] };
+	const double* const rows2[ISCC_DOT_BLOCK] = { data[4] + 1, data[5], data[6], data[7] };
+
+	assert_non_null(iscc_dot_block_kernel_f32);
+	for (size_t num_dimensions = 1; num_dimensions <= 60; ++num_dimensions) {
+		double ref[ISCC_DOT_BLOCK][ISCC_DOT_BLOCK];
+		double res[ISCC_DOT_BLOCK][ISCC_DOT_BLOCK];
+		iscc_dot_block_sequential(rows1, rows2, num_dimensions, ref);
+		iscc_dot_block_sequential_f32(rows1_f32, rows2_f32, num_dimensions, res);
+		assert_memory_equal(res, ref, sizeof(ref));
+		iscc_dot_block_kernel(rows1, rows2, num_dimensions, ref);
+		iscc_dot_block_kernel_f32(rows1_f32, rows2_f32, num_dimensions, res);
+		assert_memory_equal(res, ref, sizeof(ref));
+	}
+}
+
+
+int main(void)
+{
+	if(!scc_ut_init_tests()) return 1;
+
+	const struct CMUnitTest test_cases[] = {
+		cmocka_unit_test(scc_ut_sq_dist_sequential),
+		cmocka_unit_test(scc_ut_sq_dist_kernel),
+		cmocka_unit_test(scc_ut_dot_block_kernel),
+		cmocka_unit_test(scc_ut_sq_dist_kernel_f32),
+		cmocka_unit_test(scc_ut_dot_block_kernel_f32),
+	};
+
+	return cmocka_run_group_tests_name("dist_kernels.c", test_cases, NULL, NULL);
+}
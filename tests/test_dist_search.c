@@ -19,8 +19,12 @@
  * ========================================================================== */
 
 #include "init_test.h"
+#include <math.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <src/bitset.h>
 #include <src/dist_search.h>
 #include <src/scclust_types.h>
 #include "data_object_test.h"
@@ -392,6 +396,90 @@ void scc_ut_get_dist_rows(void** state)
 }
 
 
+static double scc_ut_direct_dist(const double* const data,
+                                 const size_t num_dimensions,
+                                 const size_t index1,
+                                 const size_t index2)
+{
+	double tmp_dist = 0.0;
+	for (size_t d = 0; d < num_dimensions; ++d) {
+		const double diff = data[index1 * num_dimensions + d] - data[index2 * num_dimensions + d];
+		tmp_dist += diff * diff;
+	}
+	return sqrt(tmp_dist);
+}
+
+
+void scc_ut_get_dist_blocked(void** state)
+{
+	(void) state;
+
+	// Points far from the origin and pairs of near-duplicates
+	// to check the cancellation guard
+	double* const coords = malloc(sizeof(double[150 * 50]));
+	for (size_t i = 0; i < 150 * 50; ++i) {
+		coords[i] = 1000.0 + ((double) rand() / RAND_MAX);
+	}
+	for (size_t i = 0; i < 10; ++i) {
+		for (size_t d = 0; d < 50; ++d) {
+			coords[(2 * i + 1) * 50 + d] = coords[(2 * i) * 50 + d] + ((d == i) ? 1e-5 : 0.0);
+		}
+	}
+
+	scc_DataSet* data_set;
+	assert_int_equal(scc_init_data_set(150, 50, 150 * 50, coords, &data_set), SCC_ER_OK);
+
+	scc_PointIndex indices[101];
+	for (size_t i = 0; i < 101; ++i) {
+		indices[i] = (scc_PointIndex) ((i * 3) % 150);
+	}
+	indices[1] = 1;
+	indices[2] = 0;
+
+	double* const output_dists = malloc(sizeof(double[150 * 101]));
+
+	assert_true(iscc_get_dist_rows(data_set, 7, indices, 101, indices, output_dists));
+	for (size_t q = 0; q < 7; ++q) {
+		for (size_t c = 0; c < 101; ++c) {
+			const double ref = scc_ut_direct_dist(coords, 50, (size_t) indices[q], (size_t) indices[c]);
+			assert_true(fabs(output_dists[q * 101 + c] - ref) <= 1e-7 * (ref + 1e-3));
+		}
+	}
+
+	assert_true(iscc_get_dist_rows(data_set, 150, NULL, 2, NULL, output_dists));
+	for (size_t q = 0; q < 150; ++q) {
+		for (size_t c = 0; c < 2; ++c) {
+			const double ref = scc_ut_direct_dist(coords, 50, q, c);
+			assert_true(fabs(output_dists[q * 2 + c] - ref) <= 1e-7 * (ref + 1e-3));
+		}
+	}
+
+	assert_true(iscc_get_dist_matrix(data_set, 101, indices, output_dists));
+	size_t pos = 0;
+	for (size_t p1 = 0; p1 < 101; ++p1) {
+		for (size_t p2 = p1 + 1; p2 < 101; ++p2) {
+			const double ref = scc_ut_direct_dist(coords, 50, (size_t) indices[p1], (size_t) indices[p2]);
+			assert_true(fabs(output_dists[pos] - ref) <= 1e-7 * (ref + 1e-3));
+			++pos;
+		}
+	}
+
+	assert_true(iscc_get_dist_matrix(data_set, 20, NULL, output_dists));
+	pos = 0;
+	for (size_t p1 = 0; p1 < 20; ++p1) {
+		for (size_t p2 = p1 + 1; p2 < 20; ++p2) {
+			const double ref = scc_ut_direct_dist(coords, 50, p1, p2);
+			assert_true(fabs(output_dists[pos] - ref) <= 1e-7 * (ref + 1e-3));
+			++pos;
+		}
+	}
+
+	scc_free_data_set(&data_set);
+	free(coords);
+	free(output_dists);
+}
+
+
 void scc_ut_init_close_max_dist_object(void** state)
 {
 	(void) state;
@@ -402,22 +490,22 @@ void scc_ut_init_close_max_dist_object(void** state)
 	iscc_MaxDistObject* tmp_mdo1;
 	assert_true(iscc_init_max_dist_object(scc_ut_test_data_large, 10, cols1, &tmp_mdo1));
 	assert_non_null(tmp_mdo1);
-	assert_true(iscc_close_max_dist_object(&tmp_mdo1));
+	assert_true(iscc_close_max_dist_object(scc_ut_test_data_large, &tmp_mdo1));
 
 	iscc_MaxDistObject* tmp_mdo2;
 	assert_true(iscc_init_max_dist_object(scc_ut_test_data_small, 5, cols2, &tmp_mdo2));
 	assert_non_null(tmp_mdo2);
-	assert_true(iscc_close_max_dist_object(&tmp_mdo2));
+	assert_true(iscc_close_max_dist_object(scc_ut_test_data_small, &tmp_mdo2));
 
 	iscc_MaxDistObject* tmp_mdo3;
 	assert_true(iscc_init_max_dist_object(scc_ut_test_data_large, 100, NULL, &tmp_mdo3));
 	assert_non_null(tmp_mdo3);
-	assert_true(iscc_close_max_dist_object(&tmp_mdo3));
+	assert_true(iscc_close_max_dist_object(scc_ut_test_data_large, &tmp_mdo3));
 
 	iscc_MaxDistObject* tmp_mdo4;
 	assert_true(iscc_init_max_dist_object(scc_ut_test_data_small, 15, NULL, &tmp_mdo4));
 	assert_non_null(tmp_mdo4);
-	assert_true(iscc_close_max_dist_object(&tmp_mdo4));
+	assert_true(iscc_close_max_dist_object(scc_ut_test_data_small, &tmp_mdo4));
 }
 
 
@@ -444,7 +532,7 @@ void scc_ut_get_max_dist(void** state)
 	double out_dist1a[5];
 	const scc_PointIndex ref_ids1a[5] = { 2, 8, 18, 8, 8 };
 	const double ref_dist1a[5] = { 91.6847440822232, 114.066080913592, 134.211257779602, 88.5155733560544, 89.0981520167977 };
-	assert_true(iscc_get_max_dist(max_dist_object1, 5, query1a, out_ids1a, out_dist1a));
+	assert_true(iscc_get_max_dist(scc_ut_test_data_large, max_dist_object1, 5, query1a, out_ids1a, out_dist1a));
 	for (size_t i = 0; i < 5; ++i) {
 		assert_int_equal(out_ids1a[i], ref_ids1a[i]);
 		assert_double_equal(out_dist1a[i], ref_dist1a[i]);
@@ -455,7 +543,7 @@ void scc_ut_get_max_dist(void** state)
 	double out_dist1b[10];
 	const scc_PointIndex ref_ids1b[10] = { 18, 18, 2, 8, 18, 8, 6, 2, 2, 8 };
 	const double ref_dist1b[10] = { 104.711936990853, 107.348747109315, 103.030113211531, 88.5155733560544, 109.855909481972, 112.319962391295, 99.1929186473983, 110.973348201933, 102.888740019999, 105.937617713061 };
-	assert_true(iscc_get_max_dist(max_dist_object1, 10, query1b, out_ids1b, out_dist1b));
+	assert_true(iscc_get_max_dist(scc_ut_test_data_large, max_dist_object1, 10, query1b, out_ids1b, out_dist1b));
 	for (size_t i = 0; i < 10; ++i) {
 		assert_int_equal(out_ids1b[i], ref_ids1b[i]);
 		assert_double_equal(out_dist1b[i], ref_dist1b[i]);
@@ -466,7 +554,7 @@ void scc_ut_get_max_dist(void** state)
 	double out_dist1c[2];
 	const scc_PointIndex ref_ids1c[2] = { 2, 6 };
 	const double ref_dist1c[2] = { 111.298252778194, 103.103243517457 };
-	assert_true(iscc_get_max_dist(max_dist_object1, 2, query1c, out_ids1c, out_dist1c));
+	assert_true(iscc_get_max_dist(scc_ut_test_data_large, max_dist_object1, 2, query1c, out_ids1c, out_dist1c));
 	for (size_t i = 0; i < 2; ++i) {
 		assert_int_equal(out_ids1c[i], ref_ids1c[i]);
 		assert_double_equal(out_dist1c[i], ref_dist1c[i]);
@@ -477,13 +565,13 @@ void scc_ut_get_max_dist(void** state)
 	double out_dist1d[5];
 	const scc_PointIndex ref_ids1d[5] = { 2, 18, 2, 2, 8 };
 	const double ref_dist1d[5] = { 94.9376054228144, 129.299653842619, 94.9376054228144, 136.662934653369, 92.9856686886153 };
-	assert_true(iscc_get_max_dist(max_dist_object1, 5, query1d, out_ids1d, out_dist1d));
+	assert_true(iscc_get_max_dist(scc_ut_test_data_large, max_dist_object1, 5, query1d, out_ids1d, out_dist1d));
 	for (size_t i = 0; i < 5; ++i) {
 		assert_int_equal(out_ids1d[i], ref_ids1d[i]);
 		assert_double_equal(out_dist1d[i], ref_dist1d[i]);
 	}
 
-	assert_true(iscc_close_max_dist_object(&max_dist_object1));
+	assert_true(iscc_close_max_dist_object(scc_ut_test_data_large, &max_dist_object1));
 
 
 	iscc_MaxDistObject* max_dist_object2;
@@ -492,8 +580,8 @@ void scc_ut_get_max_dist(void** state)
 	double out_dist2[5];
 	const double ref_dist2[5] = { 92.6949329193194, 96.3082633651233, 81.8214565347695, 96.3082633651233, 96.3082633651233 };
 	assert_true(iscc_init_max_dist_object(scc_ut_test_data_large, 5, mat2, &max_dist_object2));
-	assert_true(iscc_get_max_dist(max_dist_object2, 5, mat2, out_ids2, out_dist2));
-	assert_true(iscc_close_max_dist_object(&max_dist_object2));
+	assert_true(iscc_get_max_dist(scc_ut_test_data_large, max_dist_object2, 5, mat2, out_ids2, out_dist2));
+	assert_true(iscc_close_max_dist_object(scc_ut_test_data_large, &max_dist_object2));
 	// 11 and 38 are identical, returning any is fine.
 	assert_int_equal(out_ids2[0], 2);
 	assert_int_equal(out_ids2[1], 2);
@@ -513,8 +601,8 @@ void scc_ut_get_max_dist(void** state)
 	const scc_PointIndex ref_ids3[1] = { 88 };
 	const double ref_dist3[1] = { 79.9294467929955 };
 	assert_true(iscc_init_max_dist_object(scc_ut_test_data_large, 1, search3, &max_dist_object3));
-	assert_true(iscc_get_max_dist(max_dist_object3, 1, query3, out_ids3, out_dist3));
-	assert_true(iscc_close_max_dist_object(&max_dist_object3));
+	assert_true(iscc_get_max_dist(scc_ut_test_data_large, max_dist_object3, 1, query3, out_ids3, out_dist3));
+	assert_true(iscc_close_max_dist_object(scc_ut_test_data_large, &max_dist_object3));
 	for (size_t i = 0; i < 1; ++i) {
 		assert_int_equal(out_ids3[i], ref_ids3[i]);
 		assert_double_equal(out_dist3[i], ref_dist3[i]);
@@ -542,8 +630,8 @@ void scc_ut_get_max_dist(void** state)
 	                                 43.9221536500751, 35.9049322852337, 87.042732996262, 61.9735234341632, 13.6444075684181, 80.3257916246034, 88.5654819721503, 104.014478170404, 51.0577336761235,
 	                                 70.5053309917733, 69.5416205540842, 85.0096115614713, 87.6064633674381, 30.320632592006, 83.7188283835717, 68.1390037052728, 70.7534045907538, 57.5336073602082 };
 	assert_true(iscc_init_max_dist_object(scc_ut_test_data_large, 1, search4a, &max_dist_object4a));
-	assert_true(iscc_get_max_dist(max_dist_object4a, 100, NULL, out_ids4a, out_dist4a));
-	assert_true(iscc_close_max_dist_object(&max_dist_object4a));
+	assert_true(iscc_get_max_dist(scc_ut_test_data_large, max_dist_object4a, 100, NULL, out_ids4a, out_dist4a));
+	assert_true(iscc_close_max_dist_object(scc_ut_test_data_large, &max_dist_object4a));
 	for (size_t i = 0; i < 100; ++i) {
 		assert_int_equal(out_ids4a[i], ref_ids4a[i]);
 		assert_double_equal(out_dist4a[i], ref_dist4a[i]);
@@ -568,8 +656,8 @@ void scc_ut_get_max_dist(void** state)
 	                                 88.5654819721503, 104.014478170404, 97.4451436923349, 70.5053309917733, 69.5416205540842, 85.0096115614713, 87.6064633674381, 40.8066614881894, 83.7188283835717, 101.994228745573, 70.7534045907538,
 	                                 57.5336073602082 };
 	assert_true(iscc_init_max_dist_object(scc_ut_test_data_large, 2, search4b, &max_dist_object4b));
-	assert_true(iscc_get_max_dist(max_dist_object4b, 100, NULL, out_ids4b, out_dist4b));
-	assert_true(iscc_close_max_dist_object(&max_dist_object4b));
+	assert_true(iscc_get_max_dist(scc_ut_test_data_large, max_dist_object4b, 100, NULL, out_ids4b, out_dist4b));
+	assert_true(iscc_close_max_dist_object(scc_ut_test_data_large, &max_dist_object4b));
 	for (size_t i = 0; i < 100; ++i) {
 		assert_int_equal(out_ids4b[i], ref_ids4b[i]);
 		assert_double_equal(out_dist4b[i], ref_dist4b[i]);
@@ -588,8 +676,8 @@ void scc_ut_get_max_dist(void** state)
 	                                68.6913235698893, 94.3852698622746, 84.9890005159453, 81.8319851390179, 106.136260122573, 44.9650121226702, 63.2279425085851, 60.7619276211456, 92.4041325836564, 66.3226608419616, 93.3489419233617,
 	                                75.3650060229711, 71.4399722186021, 63.1810306723375, 55.1257670661323, 43.0018892035719, 95.0049395241898 };
 	assert_true(iscc_init_max_dist_object(scc_ut_test_data_large, 2, search4c, &max_dist_object4c));
-	assert_true(iscc_get_max_dist(max_dist_object4c, 50, NULL, out_ids4c, out_dist4c));
-	assert_true(iscc_close_max_dist_object(&max_dist_object4c));
+	assert_true(iscc_get_max_dist(scc_ut_test_data_large, max_dist_object4c, 50, NULL, out_ids4c, out_dist4c));
+	assert_true(iscc_close_max_dist_object(scc_ut_test_data_large, &max_dist_object4c));
 	for (size_t i = 0; i < 50; ++i) {
 		assert_int_equal(out_ids4c[i], ref_ids4c[i]);
 		assert_double_equal(out_dist4c[i], ref_dist4c[i]);
@@ -603,8 +691,8 @@ void scc_ut_get_max_dist(void** state)
 	const scc_PointIndex ref_ids5a[1] = { 65 };
 	const double ref_dist5a[1] = { 122.813376509683 };
 	assert_true(iscc_init_max_dist_object(scc_ut_test_data_large, 100, NULL, &max_dist_object5a));
-	assert_true(iscc_get_max_dist(max_dist_object5a, 1, query5a, out_ids5a, out_dist5a));
-	assert_true(iscc_close_max_dist_object(&max_dist_object5a));
+	assert_true(iscc_get_max_dist(scc_ut_test_data_large, max_dist_object5a, 1, query5a, out_ids5a, out_dist5a));
+	assert_true(iscc_close_max_dist_object(scc_ut_test_data_large, &max_dist_object5a));
 	for (size_t i = 0; i < 1; ++i) {
 		assert_int_equal(out_ids5a[i], ref_ids5a[i]);
 		assert_double_equal(out_dist5a[i], ref_dist5a[i]);
@@ -618,8 +706,8 @@ void scc_ut_get_max_dist(void** state)
 	const scc_PointIndex ref_ids5b[2] = { 65, 78 };
 	const double ref_dist5b[2] = { 122.813376509683, 138.537037001061 };
 	assert_true(iscc_init_max_dist_object(scc_ut_test_data_large, 100, NULL, &max_dist_object5b));
-	assert_true(iscc_get_max_dist(max_dist_object5b, 2, query5b, out_ids5b, out_dist5b));
-	assert_true(iscc_close_max_dist_object(&max_dist_object5b));
+	assert_true(iscc_get_max_dist(scc_ut_test_data_large, max_dist_object5b, 2, query5b, out_ids5b, out_dist5b));
+	assert_true(iscc_close_max_dist_object(scc_ut_test_data_large, &max_dist_object5b));
 	for (size_t i = 0; i < 2; ++i) {
 		assert_int_equal(out_ids5b[i], ref_ids5b[i]);
 		assert_double_equal(out_dist5b[i], ref_dist5b[i]);
@@ -633,8 +721,8 @@ void scc_ut_get_max_dist(void** state)
 	const scc_PointIndex ref_ids5c[2] = { 8, 1 };
 	const double ref_dist5c[2] = { 112.319962391295, 125.728509166853 };
 	assert_true(iscc_init_max_dist_object(scc_ut_test_data_large, 50, NULL, &max_dist_object5c));
-	assert_true(iscc_get_max_dist(max_dist_object5c, 2, query5c, out_ids5c, out_dist5c));
-	assert_true(iscc_close_max_dist_object(&max_dist_object5c));
+	assert_true(iscc_get_max_dist(scc_ut_test_data_large, max_dist_object5c, 2, query5c, out_ids5c, out_dist5c));
+	assert_true(iscc_close_max_dist_object(scc_ut_test_data_large, &max_dist_object5c));
 	for (size_t i = 0; i < 2; ++i) {
 		assert_int_equal(out_ids5c[i], ref_ids5c[i]);
 		assert_double_equal(out_dist5c[i], ref_dist5c[i]);
@@ -647,8 +735,8 @@ void scc_ut_get_max_dist(void** state)
 	const scc_PointIndex ref_ids6a[15] = { 11, 11, 11, 8, 11, 8, 11, 11, 11, 8, 11, 8, 11, 11, 11 };
 	const double ref_dist6a[15] = { 3.58315665, 3.00969014, 1.89136131, 2.49713655, 2.60823233, 2.80010865, 2.27447368, 3.20502098, 3.6729032, 2.15541392, 2.1953311, 3.6729032, 2.25532768, 2.53344395, 2.31132769 };
 	assert_true(iscc_init_max_dist_object(scc_ut_test_data_small, 15, NULL, &max_dist_object6a));
-	assert_true(iscc_get_max_dist(max_dist_object6a, 15, NULL, out_ids6a, out_dist6a));
-	assert_true(iscc_close_max_dist_object(&max_dist_object6a));
+	assert_true(iscc_get_max_dist(scc_ut_test_data_small, max_dist_object6a, 15, NULL, out_ids6a, out_dist6a));
+	assert_true(iscc_close_max_dist_object(scc_ut_test_data_small, &max_dist_object6a));
 	for (size_t i = 0; i < 15; ++i) {
 		assert_int_equal(out_ids6a[i], ref_ids6a[i]);
 		assert_double_equal(out_dist6a[i], ref_dist6a[i]);
@@ -661,8 +749,8 @@ void scc_ut_get_max_dist(void** state)
 	const scc_PointIndex ref_ids6b[10] = { 11, 11, 11, 8, 11, 8, 11, 11, 11, 8 };
 	const double ref_dist6b[10] = { 3.58315665, 3.00969014, 1.89136131, 2.49713655, 2.60823233, 2.80010865, 2.27447368, 3.20502098, 3.6729032, 2.15541392 };
 	assert_true(iscc_init_max_dist_object(scc_ut_test_data_small, 15, NULL, &max_dist_object6b));
-	assert_true(iscc_get_max_dist(max_dist_object6b, 10, NULL, out_ids6b, out_dist6b));
-	assert_true(iscc_close_max_dist_object(&max_dist_object6b));
+	assert_true(iscc_get_max_dist(scc_ut_test_data_small, max_dist_object6b, 10, NULL, out_ids6b, out_dist6b));
+	assert_true(iscc_close_max_dist_object(scc_ut_test_data_small, &max_dist_object6b));
 	for (size_t i = 0; i < 10; ++i) {
 		assert_int_equal(out_ids6b[i], ref_ids6b[i]);
 		assert_double_equal(out_dist6b[i], ref_dist6b[i]);
@@ -675,8 +763,8 @@ void scc_ut_get_max_dist(void** state)
 	const scc_PointIndex ref_ids6c[15] = { 5, 5, 8, 8, 5, 8, 5, 5, 5, 8, 8, 8, 8, 5, 5 };
 	const double ref_dist6c[15] = { 2.7103621, 2.13689559, 1.78154189, 2.49713655, 1.73543778, 2.80010865, 1.40167913, 2.33222643, 2.80010865, 2.15541392, 1.4775721, 3.6729032, 1.41757552, 1.6606494, 1.43853314 };
 	assert_true(iscc_init_max_dist_object(scc_ut_test_data_small, 10, NULL, &max_dist_object6c));
-	assert_true(iscc_get_max_dist(max_dist_object6c, 15, NULL, out_ids6c, out_dist6c));
-	assert_true(iscc_close_max_dist_object(&max_dist_object6c));
+	assert_true(iscc_get_max_dist(scc_ut_test_data_small, max_dist_object6c, 15, NULL, out_ids6c, out_dist6c));
+	assert_true(iscc_close_max_dist_object(scc_ut_test_data_small, &max_dist_object6c));
 	for (size_t i = 0; i < 15; ++i) {
 		assert_int_equal(out_ids6c[i], ref_ids6c[i]);
 		assert_double_equal(out_dist6c[i], ref_dist6c[i]);
@@ -689,8 +777,8 @@ void scc_ut_get_max_dist(void** state)
 	const scc_PointIndex ref_ids6d[10] = { 5, 5, 8, 8, 5, 8, 5, 5, 5, 8 };
 	const double ref_dist6d[10] = { 2.7103621, 2.13689559, 1.78154189, 2.49713655, 1.73543778, 2.80010865, 1.40167913, 2.33222643, 2.80010865, 2.15541392 };
 	assert_true(iscc_init_max_dist_object(scc_ut_test_data_small, 10, NULL, &max_dist_object6d));
-	assert_true(iscc_get_max_dist(max_dist_object6d, 10, NULL, out_ids6d, out_dist6d));
-	assert_true(iscc_close_max_dist_object(&max_dist_object6d));
+	assert_true(iscc_get_max_dist(scc_ut_test_data_small, max_dist_object6d, 10, NULL, out_ids6d, out_dist6d));
+	assert_true(iscc_close_max_dist_object(scc_ut_test_data_small, &max_dist_object6d));
 	for (size_t i = 0; i < 10; ++i) {
 		assert_int_equal(out_ids6d[i], ref_ids6d[i]);
 		assert_double_equal(out_dist6d[i], ref_dist6d[i]);
@@ -708,22 +796,22 @@ void scc_ut_init_close_nn_search_object(void** state)
 	iscc_NNSearchObject* tmp_nnso1;
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_large, 10, search1, &tmp_nnso1));
 	assert_non_null(tmp_nnso1);
-	assert_true(iscc_close_nn_search_object(&tmp_nnso1));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_large, &tmp_nnso1));
 
 	iscc_NNSearchObject* tmp_nnso2;
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_small, 5, search2, &tmp_nnso2));
 	assert_non_null(tmp_nnso2);
-	assert_true(iscc_close_nn_search_object(&tmp_nnso2));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_small, &tmp_nnso2));
 
 	iscc_NNSearchObject* tmp_nnso3;
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_large, 100, NULL, &tmp_nnso3));
 	assert_non_null(tmp_nnso3);
-	assert_true(iscc_close_nn_search_object(&tmp_nnso3));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_large, &tmp_nnso3));
 
 	iscc_NNSearchObject* tmp_nnso4;
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_small, 15, NULL, &tmp_nnso4));
 	assert_non_null(tmp_nnso4);
-	assert_true(iscc_close_nn_search_object(&tmp_nnso4));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_small, &tmp_nnso4));
 }
 
 
@@ -753,7 +841,7 @@ void scc_ut_nearest_neighbor_search(void** state)
 	const scc_PointIndex query1a[5] = { 0, 1, 2, 3, 4 };
 	scc_PointIndex out_nn_indices1a[10];
 	const scc_PointIndex ref_nn_indices1a[10] = { 0, 10, 4, 12, 2, 14, 4, 12, 4, 12 };
-	assert_true(iscc_nearest_neighbor_search(nn_search_object1, 5, query1a,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object1, 5, query1a,
                                             2, false, 0.0,
                                             &out_ok_queries1a, NULL, out_nn_indices1a));
 	assert_memory_equal(out_nn_indices1a, ref_nn_indices1a, 10 * sizeof(scc_PointIndex));
@@ -764,7 +852,7 @@ void scc_ut_nearest_neighbor_search(void** state)
 	const scc_PointIndex query1b[10] = { 3, 6, 9, 15, 19, 20, 23, 33, 88, 90 };
 	scc_PointIndex out_nn_indices1b[30];
 	const scc_PointIndex ref_nn_indices1b[30] = { 4, 12, 0, 6, 12, 16, 2, 4, 14, 4, 12, 2, 14, 2, 16, 14, 2, 4, 8, 10, 16, 4, 12, 6, 0, 14, 10, 8, 10, 0 };
-	assert_true(iscc_nearest_neighbor_search(nn_search_object1, 10, query1b,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object1, 10, query1b,
                                             3, false, 0.0,
                                             &out_ok_queries1b, NULL, out_nn_indices1b));
 	assert_memory_equal(out_nn_indices1b, ref_nn_indices1b, 30 * sizeof(scc_PointIndex));
@@ -775,13 +863,13 @@ void scc_ut_nearest_neighbor_search(void** state)
 	const scc_PointIndex query1c[2] = { 43, 99 };
 	scc_PointIndex out_nn_indices1c[4];
 	const scc_PointIndex ref_nn_indices1c[4] = { 0, 10, 18, 10 };
-	assert_true(iscc_nearest_neighbor_search(nn_search_object1, 2, query1c,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object1, 2, query1c,
                                             2, false, 0.0,
                                             &out_ok_queries1c, NULL, out_nn_indices1c));
 	assert_memory_equal(out_nn_indices1c, ref_nn_indices1c, 4 * sizeof(scc_PointIndex));
 	assert_int_equal(out_ok_queries1c, 2);
 
-	assert_true(iscc_close_nn_search_object(&nn_search_object1));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object1));
 
 
 	iscc_NNSearchObject* nn_search_object2;
@@ -792,7 +880,7 @@ void scc_ut_nearest_neighbor_search(void** state)
 	size_t out_ok_queries2a = 12340;
 	scc_PointIndex out_nn_indices2a[15];
 	const scc_PointIndex ref_nn_indices2a[15] = { 2, 44, 54, ISCC_POINTINDEX_MAX_PI, ISCC_POINTINDEX_MAX_PI, 54, ISCC_POINTINDEX_MAX_PI, ISCC_POINTINDEX_MAX_PI, 54, 44, 2, 54, 54, ISCC_POINTINDEX_MAX_PI, ISCC_POINTINDEX_MAX_PI };
-	assert_true(iscc_nearest_neighbor_search(nn_search_object2, 5, query2,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object2, 5, query2,
                                             3, false, 0.0,
                                             &out_ok_queries2a, NULL, out_nn_indices2a));
 	assert_int_equal(out_ok_queries2a, 5);
@@ -811,7 +899,7 @@ void scc_ut_nearest_neighbor_search(void** state)
 	size_t out_ok_queries2b = 12340;
 	scc_PointIndex out_nn_indices2b[10];
 	const scc_PointIndex ref_nn_indices2b[10] = { 2, 44, ISCC_POINTINDEX_MAX_PI, ISCC_POINTINDEX_MAX_PI, ISCC_POINTINDEX_MAX_PI, ISCC_POINTINDEX_MAX_PI, 44, 2, 54, ISCC_POINTINDEX_MAX_PI };
-	assert_true(iscc_nearest_neighbor_search(nn_search_object2, 5, query2,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object2, 5, query2,
                                             2, false, 0.0,
                                             &out_ok_queries2b, NULL, out_nn_indices2b));
 	assert_int_equal(out_ok_queries2b, 5);
@@ -826,7 +914,7 @@ void scc_ut_nearest_neighbor_search(void** state)
 	out_nn_indices2b[5] = out_nn_indices2b[9] = ISCC_POINTINDEX_MAX_PI;
 	assert_memory_equal(out_nn_indices2b, ref_nn_indices2b, 10 * sizeof(scc_PointIndex));
 
-	assert_true(iscc_close_nn_search_object(&nn_search_object2));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object2));
 
 
 	size_t out_ok_queries4b = 12340;
@@ -837,10 +925,10 @@ void scc_ut_nearest_neighbor_search(void** state)
 	                                          76, 76, 76, 76, 76, 76, 33, 33, 33, 76, 33, 76, 33, 33, 76, 33, 76, 33, 76, 76, 76, 33, 33, 33, 76, 33, 33, 76, 76, 76, 76, 76, 76, 33, 76,
 	                                          33, 76, 33, 33, 33, 76, 76, 33, 33, 33, 76, 33, 33, 76, 33, 33, 76, 33, 33, 33, 76, 33, 33, 33, 33, 76, 33, 76, 33, 33 };
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_large, 2, search4b, &nn_search_object4b));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object4b, 100, NULL,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object4b, 100, NULL,
                                             1, false, 0.0,
                                             &out_ok_queries4b, NULL, out_nn_indices4b));
-	assert_true(iscc_close_nn_search_object(&nn_search_object4b));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object4b));
 	assert_memory_equal(out_nn_indices4b, ref_nn_indices4b, 100 * sizeof(scc_PointIndex));
 	assert_int_equal(out_ok_queries4b, 100);
 
@@ -852,10 +940,10 @@ void scc_ut_nearest_neighbor_search(void** state)
 	const scc_PointIndex ref_nn_indices4c[50] = { 76, 33, 33, 33, 33, 33, 76, 76, 76, 33, 76, 76, 76, 76, 76, 33, 76, 76, 76, 76, 76, 33, 76, 76, 76, 76, 33, 76, 76, 33, 33, 76, 33, 33, 76, 76, 76, 76,
 	                                         76, 76, 76, 33, 33, 33, 76, 33, 76, 33, 33, 76 };
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_large, 2, search4c, &nn_search_object4c));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object4c, 50, NULL,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object4c, 50, NULL,
                                             1, false, 0.0,
                                             &out_ok_queries4c, NULL, out_nn_indices4c));
-	assert_true(iscc_close_nn_search_object(&nn_search_object4c));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object4c));
 	assert_memory_equal(out_nn_indices4c, ref_nn_indices4c, 50 * sizeof(scc_PointIndex));
 	assert_int_equal(out_ok_queries4c, 50);
 
@@ -866,10 +954,10 @@ void scc_ut_nearest_neighbor_search(void** state)
 	scc_PointIndex out_nn_indices5a[5];
 	const scc_PointIndex ref_nn_indices5a[5] = { 15, 50, 96, 1, 73 };
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_large, 100, NULL, &nn_search_object5a));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object5a, 1, query5a,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object5a, 1, query5a,
                                             5, false, 0.0,
                                             &out_ok_queries5a, NULL, out_nn_indices5a));
-	assert_true(iscc_close_nn_search_object(&nn_search_object5a));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object5a));
 	assert_memory_equal(out_nn_indices5a, ref_nn_indices5a, 5 * sizeof(scc_PointIndex));
 	assert_int_equal(out_ok_queries5a, 1);
 
@@ -880,10 +968,10 @@ void scc_ut_nearest_neighbor_search(void** state)
 	scc_PointIndex out_nn_indices5b[8];
 	const scc_PointIndex ref_nn_indices5b[8] = { 15, 50, 96, 1, 65, 8, 97, 63 };
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_large, 100, NULL, &nn_search_object5b));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object5b, 2, query5b,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object5b, 2, query5b,
                                             4, false, 0.0,
                                             &out_ok_queries5b, NULL, out_nn_indices5b));
-	assert_true(iscc_close_nn_search_object(&nn_search_object5b));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object5b));
 	assert_memory_equal(out_nn_indices5b, ref_nn_indices5b, 8 * sizeof(scc_PointIndex));
 	assert_int_equal(out_ok_queries5b, 2);
 
@@ -894,10 +982,10 @@ void scc_ut_nearest_neighbor_search(void** state)
 	scc_PointIndex out_nn_indices5c[6];
 	const scc_PointIndex ref_nn_indices5c[6] = { 15, 1, 42, 8, 10, 27 };
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_large, 50, NULL, &nn_search_object5c));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object5c, 2, query5c,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object5c, 2, query5c,
                                             3, false, 0.0,
                                             &out_ok_queries5c, NULL, out_nn_indices5c));
-	assert_true(iscc_close_nn_search_object(&nn_search_object5c));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object5c));
 	assert_memory_equal(out_nn_indices5c, ref_nn_indices5c, 6 * sizeof(scc_PointIndex));
 	assert_int_equal(out_ok_queries5c, 2);
 
@@ -907,10 +995,10 @@ void scc_ut_nearest_neighbor_search(void** state)
 	scc_PointIndex out_nn_indices6a[30];
 	const scc_PointIndex ref_nn_indices6a[30] = { 0, 8, 1, 7, 2, 10, 3, 5, 4, 13, 5, 3, 6, 12, 7, 1, 8, 0, 9, 3, 10, 12, 11, 5, 12, 6, 13, 4, 14, 6 };
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_small, 15, NULL, &nn_search_object6a));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object6a, 15, NULL,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_small, nn_search_object6a, 15, NULL,
                                             2, false, 0.0,
                                             &out_ok_queries6a, NULL, out_nn_indices6a));
-	assert_true(iscc_close_nn_search_object(&nn_search_object6a));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_small, &nn_search_object6a));
 	assert_memory_equal(out_nn_indices6a, ref_nn_indices6a, 30 * sizeof(scc_PointIndex));
 	assert_int_equal(out_ok_queries6a, 15);
 
@@ -920,10 +1008,10 @@ void scc_ut_nearest_neighbor_search(void** state)
 	scc_PointIndex out_nn_indices6b[20];
 	const scc_PointIndex ref_nn_indices6b[20] = { 0, 8, 1, 7, 2, 10, 3, 5, 4, 13, 5, 3, 6, 12, 7, 1, 8, 0, 9, 3 };
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_small, 15, NULL, &nn_search_object6b));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object6b, 10, NULL,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_small, nn_search_object6b, 10, NULL,
                                             2, false, 0.0,
                                             &out_ok_queries6b, NULL, out_nn_indices6b));
-	assert_true(iscc_close_nn_search_object(&nn_search_object6b));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_small, &nn_search_object6b));
 	assert_memory_equal(out_nn_indices6b, ref_nn_indices6b, 20 * sizeof(scc_PointIndex));
 	assert_int_equal(out_ok_queries6b, 10);
 
@@ -933,10 +1021,10 @@ void scc_ut_nearest_neighbor_search(void** state)
 	scc_PointIndex out_nn_indices6c[30];
 	const scc_PointIndex ref_nn_indices6c[30] = { 0, 8, 1, 7, 2, 9, 3, 5, 4, 6, 5, 3, 6, 4, 7, 1, 8, 0, 9, 3, 6, 2, 5, 3, 6, 4, 4, 6, 6, 4 };
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_small, 10, NULL, &nn_search_object6c));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object6c, 15, NULL,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_small, nn_search_object6c, 15, NULL,
                                             2, false, 0.0,
                                             &out_ok_queries6c, NULL, out_nn_indices6c));
-	assert_true(iscc_close_nn_search_object(&nn_search_object6c));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_small, &nn_search_object6c));
 	assert_memory_equal(out_nn_indices6c, ref_nn_indices6c, 30 * sizeof(scc_PointIndex));
 	assert_int_equal(out_ok_queries6c, 15);
 
@@ -946,10 +1034,10 @@ void scc_ut_nearest_neighbor_search(void** state)
 	scc_PointIndex out_nn_indices6d[20];
 	const scc_PointIndex ref_nn_indices6d[20] = { 0, 8, 1, 7, 2, 9, 3, 5, 4, 6, 5, 3, 6, 4, 7, 1, 8, 0, 9, 3 };
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_small, 10, NULL, &nn_search_object6d));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object6d, 10, NULL,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_small, nn_search_object6d, 10, NULL,
                                             2, false, 0.0,
                                             &out_ok_queries6d, NULL, out_nn_indices6d));
-	assert_true(iscc_close_nn_search_object(&nn_search_object6d));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_small, &nn_search_object6d));
 	assert_memory_equal(out_nn_indices6d, ref_nn_indices6d, 20 * sizeof(scc_PointIndex));
 	assert_int_equal(out_ok_queries6d, 10);
 }
@@ -995,7 +1083,7 @@ void scc_ut_nearest_neighbor_search_radius(void** state)
 	scc_PointIndex out_nn_indices1a[10];
 	const scc_PointIndex ref_indicators1a[1] = { 0 };
 	const scc_PointIndex ref_nn_indices1a[2] = { 0, 10 };
-	assert_true(iscc_nearest_neighbor_search(nn_search_object1, 5, query1a,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object1, 5, query1a,
                                             2, true, 35.0,
                                             &num_out_indicators1a, out_indicators1a, out_nn_indices1a));
 	assert_int_equal(num_out_indicators1a, 1);
@@ -1009,7 +1097,7 @@ void scc_ut_nearest_neighbor_search_radius(void** state)
 	const scc_PointIndex ref_indicators1b[7] = { 6, 9, 19, 20, 23, 88, 90 };
 	scc_PointIndex out_nn_indices1b[30];
 	const scc_PointIndex ref_nn_indices1b[21] = { 6, 12, 16, 2, 4, 14, 14, 2, 16, 14, 2, 4, 8, 10, 16, 0, 14, 10, 8, 10, 0 };
-	assert_true(iscc_nearest_neighbor_search(nn_search_object1, 10, query1b,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object1, 10, query1b,
                                             3, true, 50.0,
                                             &num_out_indicators1b, out_indicators1b, out_nn_indices1b));
 	assert_memory_equal(out_nn_indices1b, ref_nn_indices1b, 21 * sizeof(scc_PointIndex));
@@ -1023,14 +1111,14 @@ void scc_ut_nearest_neighbor_search_radius(void** state)
 	const scc_PointIndex ref_indicators1c[2] = { 43, 99 };
 	scc_PointIndex out_nn_indices1c[4];
 	const scc_PointIndex ref_nn_indices1c[4] = { 0, 10, 18, 10 };
-	assert_true(iscc_nearest_neighbor_search(nn_search_object1, 2, query1c,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object1, 2, query1c,
                                             2, true, 40.0,
                                             &num_out_indicators1c, out_indicators1c, out_nn_indices1c));
 	assert_int_equal(num_out_indicators1c, 2);
 	assert_memory_equal(out_indicators1c, ref_indicators1c, 2 * sizeof(scc_PointIndex));
 	assert_memory_equal(out_nn_indices1c, ref_nn_indices1c, 4 * sizeof(scc_PointIndex));
 
-	assert_true(iscc_close_nn_search_object(&nn_search_object1));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object1));
 
 
 	const scc_PointIndex query2[5] = { 2, 11, 38, 44, 54 };
@@ -1043,7 +1131,7 @@ void scc_ut_nearest_neighbor_search_radius(void** state)
 	const scc_PointIndex ref_indicators2a[3] = { 11, 38, 54 };
 	scc_PointIndex out_nn_indices2a[15];
 	const scc_PointIndex ref_nn_indices2a[9] = { ISCC_POINTINDEX_MAX_PI, ISCC_POINTINDEX_MAX_PI, 54, ISCC_POINTINDEX_MAX_PI, ISCC_POINTINDEX_MAX_PI, 54, 54, ISCC_POINTINDEX_MAX_PI, ISCC_POINTINDEX_MAX_PI };
-	assert_true(iscc_nearest_neighbor_search(nn_search_object2, 5, query2,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object2, 5, query2,
                                             3, true, 30.0,
                                             &num_out_indicators2a, out_indicators2a, out_nn_indices2a));
 	assert_int_equal(num_out_indicators2a, 3);
@@ -1065,7 +1153,7 @@ void scc_ut_nearest_neighbor_search_radius(void** state)
 	const scc_PointIndex ref_indicators2b[3] = { 11, 38, 54 };
 	scc_PointIndex out_nn_indices2b[10];
 	const scc_PointIndex ref_nn_indices2b[6] = { ISCC_POINTINDEX_MAX_PI, ISCC_POINTINDEX_MAX_PI, ISCC_POINTINDEX_MAX_PI, ISCC_POINTINDEX_MAX_PI, 54, ISCC_POINTINDEX_MAX_PI };
-	assert_true(iscc_nearest_neighbor_search(nn_search_object2, 5, query2,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object2, 5, query2,
                                             2, true, 35.0,
                                             &num_out_indicators2b, out_indicators2b, out_nn_indices2b));
 	assert_int_equal(num_out_indicators2b, 3);
@@ -1080,7 +1168,7 @@ void scc_ut_nearest_neighbor_search_radius(void** state)
 	out_nn_indices2b[3] = out_nn_indices2b[5] = ISCC_POINTINDEX_MAX_PI;
 	assert_memory_equal(out_nn_indices2b, ref_nn_indices2b, 6 * sizeof(scc_PointIndex));
 
-	assert_true(iscc_close_nn_search_object(&nn_search_object2));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object2));
 
 
 	size_t num_out_indicators4b = 123456;
@@ -1091,10 +1179,10 @@ void scc_ut_nearest_neighbor_search_radius(void** state)
 	scc_PointIndex out_nn_indices4b[100];
 	const scc_PointIndex ref_nn_indices4b[14] = { 76, 76, 33, 33, 76, 33, 76, 33, 33, 76, 76, 33, 33, 76 };
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_large, 2, search4b, &nn_search_object4b));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object4b, 100, NULL,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object4b, 100, NULL,
                                             1, true, 20.0,
                                             &num_out_indicators4b, out_indicators4b, out_nn_indices4b));
-	assert_true(iscc_close_nn_search_object(&nn_search_object4b));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object4b));
 	assert_int_equal(num_out_indicators4b, 14);
 	assert_memory_equal(out_indicators4b, ref_indicators4b, 14 * sizeof(scc_PointIndex));
 	assert_memory_equal(out_nn_indices4b, ref_nn_indices4b, 14 * sizeof(scc_PointIndex));
@@ -1108,12 +1196,12 @@ void scc_ut_nearest_neighbor_search_radius(void** state)
 	scc_PointIndex out_nn_indices4c[100];
 	const scc_PointIndex ref_nn_indices4c[10] = { 76, 33, 76, 33, 76, 33, 76, 33, 33, 76 };
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_large, 2, search4c, &nn_search_object4c));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object4c, 50, NULL,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object4c, 50, NULL,
                                             2, true, 50.0,
                                             &num_out_indicators4c, out_indicators4c, out_nn_indices4c));
 	assert_int_equal(num_out_indicators4c, 5);
 	assert_memory_equal(out_indicators4c, ref_indicators4c, 5 * sizeof(scc_PointIndex));
-	assert_true(iscc_close_nn_search_object(&nn_search_object4c));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object4c));
 	assert_memory_equal(out_nn_indices4c, ref_nn_indices4c, 10 * sizeof(scc_PointIndex));
 
 
@@ -1122,11 +1210,11 @@ void scc_ut_nearest_neighbor_search_radius(void** state)
 	iscc_NNSearchObject* nn_search_object5a;
 	scc_PointIndex out_nn_indices5a[5];
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_large, 100, NULL, &nn_search_object5a));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object5a, 1, query5a,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object5a, 1, query5a,
                                             5, true, 20.0,
                                             &num_out_indicators5a, query5a, out_nn_indices5a));
 	assert_int_equal(num_out_indicators5a, 0);
-	assert_true(iscc_close_nn_search_object(&nn_search_object5a));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object5a));
 
 
 	scc_PointIndex query5b[2] = { 15, 65 };
@@ -1136,12 +1224,12 @@ void scc_ut_nearest_neighbor_search_radius(void** state)
 	scc_PointIndex out_nn_indices5b[8];
 	const scc_PointIndex ref_nn_indices5b[4] = { 15, 50, 96, 1 };
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_large, 100, NULL, &nn_search_object5b));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object5b, 2, query5b,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object5b, 2, query5b,
                                             4, true, 20.5,
                                             &num_out_indicators5b, query5b, out_nn_indices5b));
 	assert_int_equal(num_out_indicators5b, 1);
 	assert_memory_equal(query5b, ref_indicators5b, 1 * sizeof(scc_PointIndex));
-	assert_true(iscc_close_nn_search_object(&nn_search_object5b));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object5b));
 	assert_memory_equal(out_nn_indices5b, ref_nn_indices5b, 4 * sizeof(scc_PointIndex));
 
 
@@ -1152,12 +1240,12 @@ void scc_ut_nearest_neighbor_search_radius(void** state)
 	scc_PointIndex out_nn_indices5c[6];
 	const scc_PointIndex ref_nn_indices5c[3] = { 15, 1, 42 };
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_large, 50, NULL, &nn_search_object5c));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object5c, 2, query5c,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object5c, 2, query5c,
                                             3, true, 30.0,
                                             &num_out_indicators5c, query5c, out_nn_indices5c));
 	assert_int_equal(num_out_indicators5c, 1);
 	assert_memory_equal(query5c, ref_indicators5c, 1 * sizeof(scc_PointIndex));
-	assert_true(iscc_close_nn_search_object(&nn_search_object5c));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object5c));
 	assert_memory_equal(out_nn_indices5c, ref_nn_indices5c, 3 * sizeof(scc_PointIndex));
 
 
@@ -1169,10 +1257,10 @@ void scc_ut_nearest_neighbor_search_radius(void** state)
 	iscc_NNSearchObject* nn_search_object5d;
 	scc_PointIndex out_nn_indices5d[3];
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_large, 100, NULL, &nn_search_object5d));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object5d, 100, query5d,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object5d, 100, query5d,
                                             3, true, 0.1,
                                             &num_out_indicators5d, out_indicators5d, out_nn_indices5d));
-	assert_true(iscc_close_nn_search_object(&nn_search_object5d));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object5d));
 	assert_int_equal(num_out_indicators5d, 0);
 
 
@@ -1183,11 +1271,11 @@ void scc_ut_nearest_neighbor_search_radius(void** state)
 	iscc_NNSearchObject* nn_search_object5e;
 	scc_PointIndex out_nn_indices5e[10];
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_large, 100, NULL, &nn_search_object5e));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object5e, 100, query5e,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_large, nn_search_object5e, 100, query5e,
                                             3, true, 0.1,
                                             &num_out_indicators5e, query5e, out_nn_indices5e));
 	assert_int_equal(num_out_indicators5e, 0);
-	assert_true(iscc_close_nn_search_object(&nn_search_object5e));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object5e));
 
 
 	size_t num_out_indicators6a = 1245;
@@ -1197,12 +1285,12 @@ void scc_ut_nearest_neighbor_search_radius(void** state)
 	scc_PointIndex out_nn_indices6a[30];
 	const scc_PointIndex ref_nn_indices6a[20] = { 0, 8, 1, 7, 4, 13, 6, 12, 7, 1, 8, 0, 10, 12, 12, 6, 13, 4, 14, 6 };
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_small, 15, NULL, &nn_search_object6a));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object6a, 15, NULL,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_small, nn_search_object6a, 15, NULL,
                                             2, true, 0.2,
                                             &num_out_indicators6a, out_indicators6a, out_nn_indices6a));
 	assert_int_equal(num_out_indicators6a, 10);
 	assert_memory_equal(out_indicators6a, ref_indicators6a, 10 * sizeof(scc_PointIndex));
-	assert_true(iscc_close_nn_search_object(&nn_search_object6a));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_small, &nn_search_object6a));
 	assert_memory_equal(out_nn_indices6a, ref_nn_indices6a, 20 * sizeof(scc_PointIndex));
 
 
@@ -1213,12 +1301,12 @@ void scc_ut_nearest_neighbor_search_radius(void** state)
 	scc_PointIndex out_nn_indices6b[20];
 	const scc_PointIndex ref_nn_indices6b[8] = { 0, 8, 4, 13, 6, 12, 8, 0 };
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_small, 15, NULL, &nn_search_object6b));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object6b, 10, NULL,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_small, nn_search_object6b, 10, NULL,
                                             2, true, 0.1,
                                             &num_out_indicators6b, out_indicators6b, out_nn_indices6b));
 	assert_int_equal(num_out_indicators6b, 4);
 	assert_memory_equal(out_indicators6b, ref_indicators6b, 4 * sizeof(scc_PointIndex));
-	assert_true(iscc_close_nn_search_object(&nn_search_object6b));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_small, &nn_search_object6b));
 	assert_memory_equal(out_nn_indices6b, ref_nn_indices6b, 8 * sizeof(scc_PointIndex));
 
 
@@ -1229,12 +1317,12 @@ void scc_ut_nearest_neighbor_search_radius(void** state)
 	scc_PointIndex out_nn_indices6c[30];
 	const scc_PointIndex ref_nn_indices6c[12] = { 0, 8, 1, 7, 7, 1, 8, 0, 4, 6, 6, 4 };
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_small, 10, NULL, &nn_search_object6c));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object6c, 15, NULL,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_small, nn_search_object6c, 15, NULL,
                                             2, true, 0.3,
                                             &num_out_indicators6c, out_indicators6c, out_nn_indices6c));
 	assert_int_equal(num_out_indicators6c, 6);
 	assert_memory_equal(out_indicators6c, ref_indicators6c, 6 * sizeof(scc_PointIndex));
-	assert_true(iscc_close_nn_search_object(&nn_search_object6c));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_small, &nn_search_object6c));
 	assert_memory_equal(out_nn_indices6c, ref_nn_indices6c, 12 * sizeof(scc_PointIndex));
 
 
@@ -1245,16 +1333,425 @@ void scc_ut_nearest_neighbor_search_radius(void** state)
 	scc_PointIndex out_nn_indices6d[20];
 	const scc_PointIndex ref_nn_indices6d[8] = { 0, 8, 1, 7, 7, 1, 8, 0 };
 	assert_true(iscc_init_nn_search_object(scc_ut_test_data_small, 10, NULL, &nn_search_object6d));
-	assert_true(iscc_nearest_neighbor_search(nn_search_object6d, 10, NULL,
+	assert_true(iscc_nearest_neighbor_search(scc_ut_test_data_small, nn_search_object6d, 10, NULL,
                                             2, true, 0.2,
                                             &num_out_indicators6d, out_indicators6d, out_nn_indices6d));
-	assert_true(iscc_close_nn_search_object(&nn_search_object6d));
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_small, &nn_search_object6d));
 	assert_int_equal(num_out_indicators6d, 4);
 	assert_memory_equal(out_indicators6d, ref_indicators6d, 4 * sizeof(scc_PointIndex));
 	assert_memory_equal(out_nn_indices6d, ref_nn_indices6d, 8 * sizeof(scc_PointIndex));
 }
 
 
+static void scc_ut_brute_force_nn(const scc_DataSet* const data_set,
+                                  const size_t len_search_indices,
+                                  const scc_PointIndex search_indices[const],
+                                  const size_t query,
+                                  const uint32_t k,
+                                  const double radius_sq,
+                                  size_t* const out_found,
+                                  scc_PointIndex out_nn_indices[const])
+{
+	double* const dists = malloc(sizeof(double[k]));
+	size_t found = 0;
+	for (size_t s = 0; s < len_search_indices; ++s) {
+		const size_t point = (search_indices == NULL) ? s : (size_t) search_indices[s];
+		double tmp_dist = 0.0;
+		for (uint_fast16_t d = 0; d < data_set->num_dimensions; ++d) {
+			const double diff = data_set->data_matrix[query * data_set->num_dimensions + d] -
+			                    data_set->data_matrix[point * data_set->num_dimensions + d];
+			tmp_dist += diff * diff;
+		}
+		if (tmp_dist > radius_sq) continue;
+		size_t i = found;
+		if (found == k) {
+			if (!(tmp_dist < dists[k - 1])) continue;
+			--i;
+		} else {
+			++found;
+		}
+		for (; (i > 0) && (tmp_dist < dists[i - 1]); --i) {
+			dists[i] = dists[i - 1];
+			out_nn_indices[i] = out_nn_indices[i - 1];
+		}
+		dists[i] = tmp_dist;
+		out_nn_indices[i] = (scc_PointIndex) point;
+	}
+	*out_found = found;
+	free(dists);
+}
+
+
+void scc_ut_nearest_neighbor_search_tree(void** state)
+{
+	(void) state;
+
+	// Points on a coarse grid so that many distances are tied. With a grid step that is not
+	// exactly representable, cell and point distances differ by rounding on cell boundaries.
+	double* const coords = malloc(sizeof(double[3000]));
+	scc_DataSet grid_data = {
+		.num_data_points = 1000,
+		.num_dimensions = 3,
+		.data_matrix = coords,
+		.data_set_version = 722328001,
+	};
+
+	scc_PointIndex search_indices[300];
+	for (size_t i = 0; i < 300; ++i) {
+		search_indices[i] = (scc_PointIndex) ((i * 7) % 1000);
+	}
+
+	scc_PointIndex ref_nn_indices[7];
+	scc_PointIndex* const out_query_indices = malloc(sizeof(scc_PointIndex[1000]));
+	scc_PointIndex* const out_nn_indices = malloc(sizeof(scc_PointIndex[7000]));
+
+	const double grid_steps[2] = { 1.0, 0.1 };
+	for (size_t g = 0; g < 2; ++g) {
+		for (size_t i = 0; i < 3000; ++i) {
+			coords[i] = grid_steps[g] * (double) (rand() % 12);
+		}
+		const double radius = 1.5 * grid_steps[g];
+
+		for (uint32_t k = 1; k <= 7; k += 3) {
+			for (int use_search = 0; use_search < 2; ++use_search) {
+				for (int radius_search = 0; radius_search < 2; ++radius_search) {
+					const size_t len_search = use_search ? 300 : 1000;
+					const scc_PointIndex* const search = use_search ? search_indices : NULL;
+
+					iscc_NNSearchObject* nn_search_object;
+					assert_true(iscc_init_nn_search_object(&grid_data, len_search, search, &nn_search_object));
+					size_t num_ok_queries = 12340;
+					assert_true(iscc_nearest_neighbor_search(&grid_data, nn_search_object, 1000, NULL,
+					                                         k, (radius_search == 1), radius,
+					                                         &num_ok_queries, out_query_indices, out_nn_indices));
+					assert_true(iscc_close_nn_search_object(&grid_data, &nn_search_object));
+
+					size_t ok_queries = 0;
+					for (size_t q = 0; q < 1000; ++q) {
+						size_t found;
+						scc_ut_brute_force_nn(&grid_data, len_search, search, q, k,
+						                      radius_search ? radius * radius : HUGE_VAL,
+						                      &found, ref_nn_indices);
+						if (found < k) continue;
+						assert_true(ok_queries < num_ok_queries);
+						assert_int_equal(out_query_indices[ok_queries], q);
+						assert_memory_equal(out_nn_indices + ok_queries * k, ref_nn_indices, k * sizeof(scc_PointIndex));
+						++ok_queries;
+					}
+					assert_int_equal(num_ok_queries, ok_queries);
+				}
+			}
+		}
+	}
+
+	free(coords);
+	free(out_query_indices);
+	free(out_nn_indices);
+}
+
+
+void scc_ut_nearest_neighbor_search_large_k(void** state)
+{
+	(void) state;
+
+	// Grids in 2 dimensions (searched by tree) and 20 dimensions (searched by brute force)
+	double* const coords = malloc(sizeof(double[20000]));
+	scc_PointIndex search_indices[300];
+	for (size_t i = 0; i < 300; ++i) {
+		search_indices[i] = (scc_PointIndex) ((i * 7) % 1000);
+	}
+
+	scc_PointIndex ref_nn_indices[250];
+	scc_PointIndex* const out_query_indices = malloc(sizeof(scc_PointIndex[1000]));
+	scc_PointIndex* const out_nn_indices = malloc(sizeof(scc_PointIndex[250000]));
+
+	for (uint_fast16_t num_dimensions = 2; num_dimensions <= 20; num_dimensions += 18) {
+		for (size_t i = 0; i < 1000 * num_dimensions; ++i) {
+			coords[i] = (double) (rand() % ((num_dimensions == 2) ? 12 : 3));
+		}
+		scc_DataSet grid_data = {
+			.num_data_points = 1000,
+			.num_dimensions = num_dimensions,
+			.data_matrix = coords,
+			.data_set_version = 722328001,
+		};
+		const double radius = (num_dimensions == 2) ? 4.0 : 4.5;
+
+		for (uint32_t k = 128; k <= 250; k += 122) {
+			for (int use_search = 0; use_search < 2; ++use_search) {
+				for (int radius_search = 0; radius_search < 2; ++radius_search) {
+					const size_t len_search = use_search ? 300 : 1000;
+					const scc_PointIndex* const search = use_search ? search_indices : NULL;
+
+					iscc_NNSearchObject* nn_search_object;
+					assert_true(iscc_init_nn_search_object(&grid_data, len_search, search, &nn_search_object));
+					size_t num_ok_queries = 12340;
+					assert_true(iscc_nearest_neighbor_search(&grid_data, nn_search_object, 1000, NULL,
+					                                         k, (radius_search == 1), radius,
+					                                         &num_ok_queries, out_query_indices, out_nn_indices));
+					assert_true(iscc_close_nn_search_object(&grid_data, &nn_search_object));
+
+					size_t ok_queries = 0;
+					for (size_t q = 0; q < 1000; ++q) {
+						size_t found;
+						scc_ut_brute_force_nn(&grid_data, len_search, search, q, k,
+						                      radius_search ? radius * radius : HUGE_VAL,
+						                      &found, ref_nn_indices);
+						if (found < k) continue;
+						assert_true(ok_queries < num_ok_queries);
+						assert_int_equal(out_query_indices[ok_queries], q);
+						assert_memory_equal(out_nn_indices + ok_queries * k, ref_nn_indices, k * sizeof(scc_PointIndex));
+						++ok_queries;
+					}
+					assert_int_equal(num_ok_queries, ok_queries);
+				}
+			}
+		}
+	}
+
+	free(coords);
+	free(out_query_indices);
+	free(out_nn_indices);
+}
+
+
+void scc_ut_nearest_neighbor_search_bounded(void** state)
+{
+	(void) state;
+
+	// Wide data where some dimensions vary much more than others, so that
+	// most candidates are rejected after a few blocks of dimensions
+	double* const coords = malloc(sizeof(double[1000 * 70]));
+	for (size_t i = 0; i < 1000 * 70; ++i) {
+		const double scale = ((i % 70) >= 50) ? 10.0 : 1.0;
+		coords[i] = scale * (double) (rand() % 4);
+	}
+	scc_DataSet* data_set;
+	assert_int_equal(scc_init_data_set(1000, 70, 1000 * 70, coords, &data_set), SCC_ER_OK);
+
+	scc_PointIndex search_indices[300];
+	for (size_t i = 0; i < 300; ++i) {
+		search_indices[i] = (scc_PointIndex) ((i * 7) % 1000);
+	}
+
+	scc_PointIndex ref_nn_indices[7];
+	scc_PointIndex* const out_query_indices = malloc(sizeof(scc_PointIndex[1000]));
+	scc_PointIndex* const out_nn_indices = malloc(sizeof(scc_PointIndex[7000]));
+
+	for (uint32_t k = 1; k <= 7; k += 3) {
+		for (int use_search = 0; use_search < 2; ++use_search) {
+			for (int radius_search = 0; radius_search < 2; ++radius_search) {
+				const size_t len_search = use_search ? 300 : 1000;
+				const scc_PointIndex* const search = use_search ? search_indices : NULL;
+				const double radius = 50.0;
+
+				iscc_NNSearchObject* nn_search_object;
+				assert_true(iscc_init_nn_search_object(data_set, len_search, search, &nn_search_object));
+				size_t num_ok_queries = 12340;
+				assert_true(iscc_nearest_neighbor_search(data_set, nn_search_object, 1000, NULL,
+				                                         k, (radius_search == 1), radius,
+				                                         &num_ok_queries, out_query_indices, out_nn_indices));
+				assert_true(iscc_close_nn_search_object(data_set, &nn_search_object));
+
+				size_t ok_queries = 0;
+				for (size_t q = 0; q < 1000; ++q) {
+					size_t found;
+					scc_ut_brute_force_nn(data_set, len_search, search, q, k,
+					                      radius_search ? radius * radius : HUGE_VAL,
+					                      &found, ref_nn_indices);
+					if (found < k) continue;
+					assert_true(ok_queries < num_ok_queries);
+					assert_int_equal(out_query_indices[ok_queries], q);
+					assert_memory_equal(out_nn_indices + ok_queries * k, ref_nn_indices, k * sizeof(scc_PointIndex));
+					++ok_queries;
+				}
+				assert_int_equal(num_ok_queries, ok_queries);
+			}
+		}
+	}
+
+	scc_free_data_set(&data_set);
+	free(coords);
+	free(out_query_indices);
+	free(out_nn_indices);
+}
+
+
+void scc_ut_typed_nearest_neighbor_search(void** state)
+{
+	(void) state;
+
+	double* const coords = malloc(sizeof(double[2000]));
+	scc_TypeLabel type_labels[1000];
+	for (size_t i = 0; i < 1000; ++i) {
+		coords[2 * i] = (double) (rand() % 12);
+		coords[2 * i + 1] = (double) (rand() % 12);
+		type_labels[i] = (scc_TypeLabel) (rand() % 3);
+	}
+	scc_DataSet grid_data = {
+		.num_data_points = 1000,
+		.num_dimensions = 2,
+		.data_matrix = coords,
+		.data_set_version = 722328001,
+	};
+
+	scc_PointIndex search_indices[300];
+	for (size_t i = 0; i < 300; ++i) {
+		search_indices[i] = (scc_PointIndex) ((i * 7) % 1000);
+	}
+
+	const uint32_t type_ks[3] = { 2, 0, 3 };
+	scc_PointIndex type_search_indices[1000];
+	scc_PointIndex ref_nn_indices[5];
+	scc_PointIndex* const out_query_indices = malloc(sizeof(scc_PointIndex[1000]));
+	scc_PointIndex* const out_nn_indices = malloc(sizeof(scc_PointIndex[10000]));
+
+	for (uint32_t k_all = 0; k_all <= 5; k_all += 5) {
+		const uint32_t row_width = 5 + k_all;
+		const iscc_TypedNNQuery typed_query = {
+			.num_types = 3,
+			.type_labels = type_labels,
+			.type_ks = type_ks,
+			.k_all = k_all,
+		};
+		for (int use_search = 0; use_search < 2; ++use_search) {
+			for (int radius_search = 0; radius_search < 2; ++radius_search) {
+				const size_t len_search = use_search ? 300 : 1000;
+				const scc_PointIndex* const search = use_search ? search_indices : NULL;
+				const double radius = 2.5;
+
+				iscc_NNSearchObject* nn_search_object;
+				assert_true(iscc_init_nn_search_object(&grid_data, len_search, search, &nn_search_object));
+				size_t num_ok_queries = 12340;
+				assert_true(iscc_nn_search_supports_types(&grid_data));
+				assert_true(iscc_typed_nearest_neighbor_search(&grid_data, nn_search_object, &typed_query,
+				                                               1000, NULL, (radius_search == 1), radius,
+				                                               &num_ok_queries, out_query_indices, out_nn_indices));
+				assert_true(iscc_close_nn_search_object(&grid_data, &nn_search_object));
+
+				size_t ok_queries = 0;
+				for (size_t q = 0; q < 1000; ++q) {
+					bool query_ok = true;
+					size_t row_offset = 0;
+					for (uint_fast16_t t = 0; t <= 3; ++t) {
+						const uint32_t k = (t < 3) ? type_ks[t] : k_all;
+						if (k == 0) continue;
+						// Ties go to the latest search position within a type and to the earliest among all types
+						size_t len_type_search = 0;
+						for (size_t i = 0; i < len_search; ++i) {
+							const size_t s = (t == 3) ? i : len_search - 1 - i;
+							const scc_PointIndex point = (search == NULL) ? (scc_PointIndex) s : search[s];
+							if ((t == 3) || (type_labels[point] == (scc_TypeLabel) t)) {
+								type_search_indices[len_type_search++] = point;
+							}
+						}
+						size_t found;
+						scc_ut_brute_force_nn(&grid_data, len_type_search, type_search_indices, q, k,
+						                      radius_search ? radius * radius : HUGE_VAL,
+						                      &found, ref_nn_indices);
+						if (found < k) {
+							query_ok = false;
+							break;
+						}
+						if (ok_queries < num_ok_queries) {
+							assert_memory_equal(out_nn_indices + ok_queries * row_width + row_offset,
+							                    ref_nn_indices, k * sizeof(scc_PointIndex));
+						}
+						row_offset += k;
+					}
+					if (!query_ok) continue;
+					assert_true(ok_queries < num_ok_queries);
+					assert_int_equal(out_query_indices[ok_queries], q);
+					++ok_queries;
+				}
+				assert_int_equal(num_ok_queries, ok_queries);
+				if (radius_search == 0) assert_int_equal(num_ok_queries, 1000);
+			}
+		}
+	}
+
+	free(coords);
+	free(out_query_indices);
+	free(out_nn_indices);
+}
+
+
+void scc_ut_tombstoned_nearest_neighbor_search(void** state)
+{
+	(void) state;
+
+	double* const coords = malloc(sizeof(double[2000]));
+	for (size_t i = 0; i < 1000; ++i) {
+		coords[2 * i] = (double) (rand() % 12);
+		coords[2 * i + 1] = (double) (rand() % 12);
+	}
+	scc_DataSet grid_data = {
+		.num_data_points = 1000,
+		.num_dimensions = 2,
+		.data_matrix = coords,
+		.data_set_version = 722328001,
+	};
+
+	scc_PointIndex search_indices[300];
+	for (size_t i = 0; i < 300; ++i) {
+		search_indices[i] = (scc_PointIndex) ((i * 7) % 1000);
+	}
+
+	const uint32_t k = 4;
+	scc_PointIndex ref_nn_indices[4];
+	iscc_BitsetWord* const tombstones = iscc_bitset_alloc(1000);
+	scc_PointIndex* const out_query_indices = malloc(sizeof(scc_PointIndex[1000]));
+	scc_PointIndex* const out_nn_indices = malloc(sizeof(scc_PointIndex[4000]));
+	assert_true(iscc_nn_search_supports_tombstones(&grid_data));
+
+	// Searches with the tree (1000 and 300 search points) and by scanning (6 search points)
+	const size_t len_searches[3] = { 1000, 300, 6 };
+	for (int tombstone_share = 1; tombstone_share < 10; tombstone_share += 4) {
+		for (size_t i = 0; i < 1000; ++i) {
+			iscc_bitset_assign(tombstones, i, (rand() % 10 < tombstone_share));
+		}
+		for (int use_search = 0; use_search < 3; ++use_search) {
+			for (int radius_search = 0; radius_search < 2; ++radius_search) {
+				const size_t len_search = len_searches[use_search];
+				const scc_PointIndex* const search = (use_search == 0) ? NULL : search_indices;
+				const double radius = 2.5;
+
+				iscc_NNSearchObject* nn_search_object;
+				assert_true(iscc_init_nn_search_object(&grid_data, len_search, search, &nn_search_object));
+				size_t num_ok_queries = 12340;
+				assert_true(iscc_tombstoned_nearest_neighbor_search(&grid_data, nn_search_object, tombstones,
+				                                                    1000, NULL, k, (radius_search == 1), radius,
+				                                                    &num_ok_queries, out_query_indices, out_nn_indices));
+				assert_true(iscc_close_nn_search_object(&grid_data, &nn_search_object));
+
+				size_t ok_queries = 0;
+				for (size_t q = 0; q < 1000; ++q) {
+					size_t found;
+					scc_ut_brute_force_nn(&grid_data, len_search, search, q, k,
+					                      radius_search ? radius * radius : HUGE_VAL,
+					                      &found, ref_nn_indices);
+					bool query_ok = (found == k);
+					for (size_t i = 0; query_ok && (i < k); ++i) {
+						query_ok = !iscc_bitset_test(tombstones, (size_t) ref_nn_indices[i]);
+					}
+					if (!query_ok) continue;
+					assert_true(ok_queries < num_ok_queries);
+					assert_int_equal(out_query_indices[ok_queries], q);
+					assert_memory_equal(out_nn_indices + ok_queries * k, ref_nn_indices, k * sizeof(scc_PointIndex));
+					++ok_queries;
+				}
+				assert_int_equal(num_ok_queries, ok_queries);
+			}
+		}
+	}
+
+	free(coords);
+	free(tombstones);
+	free(out_query_indices);
+	free(out_nn_indices);
+}
+
+
 int main(void)
 {
 	if(!scc_ut_init_tests()) return 1;
@@ -1264,11 +1761,17 @@ int main(void)
 		cmocka_unit_test(scc_ut_num_data_points),
 		cmocka_unit_test(scc_ut_get_dist_matrix),
 		cmocka_unit_test(scc_ut_get_dist_rows),
+		cmocka_unit_test(scc_ut_get_dist_blocked),
 		cmocka_unit_test(scc_ut_init_close_max_dist_object),
 		cmocka_unit_test(scc_ut_get_max_dist),
 		cmocka_unit_test(scc_ut_init_close_nn_search_object),
 		cmocka_unit_test(scc_ut_nearest_neighbor_search),
 		cmocka_unit_test(scc_ut_nearest_neighbor_search_radius),
+		cmocka_unit_test(scc_ut_nearest_neighbor_search_tree),
+		cmocka_unit_test(scc_ut_nearest_neighbor_search_large_k),
+		cmocka_unit_test(scc_ut_nearest_neighbor_search_bounded),
+		cmocka_unit_test(scc_ut_typed_nearest_neighbor_search),
+		cmocka_unit_test(scc_ut_tombstoned_nearest_neighbor_search),
 	};
 
 	return cmocka_run_group_tests_name("dist_search.c", test_cases, NULL, NULL);
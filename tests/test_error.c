@@ -19,6 +19,7 @@
  * ========================================================================== */
 
 #include "init_test.h"
+#include <pthread.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -49,13 +50,13 @@ void scc_ut_get_error_message(void** state)
 	bool err_res4 = scc_get_latest_error(buffer_size, text_buffer);
 	assert_true(err_res4);
 	assert_int_equal(ec4, SCC_ER_INVALID_INPUT);
-	assert_string_equal(text_buffer, "(scclust:test_error.c:48) Function parameters are invalid.");
+	assert_string_equal(text_buffer, "(scclust:test_error.c:49) Function parameters are invalid.");
 
 	scc_ErrorCode ec4b = iscc_make_error_msg(SCC_ER_INVALID_INPUT, "Test message 12345.");
 	bool err_res4b = scc_get_latest_error(buffer_size, text_buffer);
 	assert_true(err_res4b);
 	assert_int_equal(ec4b, SCC_ER_INVALID_INPUT);
-	assert_string_equal(text_buffer, "(scclust:test_error.c:54) Test message 12345.");
+	assert_string_equal(text_buffer, "(scclust:test_error.c:55) Test message 12345.");
 
 	iscc_reset_error();
 	bool err_res5 = scc_get_latest_error(buffer_size, text_buffer);
@@ -112,12 +113,79 @@ void scc_ut_get_error_message(void** state)
 }
 
 
+static void* scc_ut_make_error_in_thread(void* const arg)
+{
+	char* const text_buffer = arg;
+	iscc_make_error__(SCC_ER_NO_MEMORY, NULL, "thread.c", 9);
+	scc_get_latest_error(256, text_buffer);
+	return NULL;
+}
+
+
+void scc_ut_thread_local_error(void** state)
+{
+	(void) state;
+
+	const size_t buffer_size = 256;
+	char text_buffer[buffer_size];
+	char thread_text_buffer[buffer_size];
+
+	iscc_make_error__(SCC_ER_INVALID_INPUT, NULL, "main.c", 1);
+
+	pthread_t thread;
+	assert_int_equal(pthread_create(&thread, NULL, scc_ut_make_error_in_thread, thread_text_buffer), 0);
+	assert_int_equal(pthread_join(thread, NULL), 0);
+	assert_string_equal(thread_text_buffer, "(scclust:thread.c:9) Cannot allocate required memory.");
+
+	bool err_res = scc_get_latest_error(buffer_size, text_buffer);
+	assert_true(err_res);
+	assert_string_equal(text_buffer, "(scclust:main.c:1) Function parameters are invalid.");
+
+	iscc_reset_error();
+}
+
+
+static void* scc_ut_get_error_state_in_thread(void* const arg)
+{
+	iscc_ErrorState* const error_state = arg;
+	iscc_make_error__(SCC_ER_DIST_SEARCH_ERROR, "Thread message 13579.", "thread.c", 10);
+	*error_state = iscc_get_error_state();
+	return NULL;
+}
+
+
+void scc_ut_restore_error_state(void** state)
+{
+	(void) state;
+
+	const size_t buffer_size = 256;
+	char text_buffer[buffer_size];
+
+	iscc_make_error__(SCC_ER_INVALID_INPUT, NULL, "main.c", 1);
+
+	iscc_ErrorState error_state;
+	pthread_t thread;
+	assert_int_equal(pthread_create(&thread, NULL, scc_ut_get_error_state_in_thread, &error_state), 0);
+	assert_int_equal(pthread_join(thread, NULL), 0);
+
+	scc_ErrorCode ec = iscc_restore_error_state(error_state);
+	assert_int_equal(ec, SCC_ER_DIST_SEARCH_ERROR);
+	bool err_res = scc_get_latest_error(buffer_size, text_buffer);
+	assert_true(err_res);
+	assert_string_equal(text_buffer, "(scclust:thread.c:10) Thread message 13579.");
+
+	iscc_reset_error();
+}
+
+
 int main(void)
 {
 	if(!scc_ut_init_tests()) return 1;
 
 	const struct CMUnitTest test_cases[] = {
 		cmocka_unit_test(scc_ut_get_error_message),
+		cmocka_unit_test(scc_ut_thread_local_error),
+		cmocka_unit_test(scc_ut_restore_error_state),
 	};
 
 	return cmocka_run_group_tests_name("error.c", test_cases, NULL, NULL);
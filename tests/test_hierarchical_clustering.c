@@ -208,12 +208,114 @@ void scc_ut_hierarchical_clustering(void** state)
 }
 
 
+void scc_ut_hierarchical_clustering_tree(void** state)
+{
+	(void) state;
+
+	scc_ClusterTree* tree = NULL;
+	scc_Clustering* cl_ref;
+	scc_Clustering* cl_tree;
+	scc_Clustering* cl_cut;
+
+	for (int batch_assign = 0; batch_assign < 2; ++batch_assign) {
+		scc_init_empty_clustering(100, NULL, &cl_ref);
+		assert_int_equal(scc_hierarchical_clustering(scc_ut_test_data_large, 2, (batch_assign == 1), cl_ref), SCC_ER_OK);
+
+		scc_init_empty_clustering(100, NULL, &cl_tree);
+		assert_int_equal(scc_hierarchical_clustering_tree(scc_ut_test_data_large, 2, (batch_assign == 1), cl_tree, &tree), SCC_ER_OK);
+		assert_true(scc_is_initialized_cluster_tree(tree));
+		assert_int_equal(cl_tree->num_clusters, cl_ref->num_clusters);
+		assert_memory_equal(cl_tree->cluster_label, cl_ref->cluster_label, 100 * sizeof(scc_Clabel));
+
+		// Cutting with the tree's own constraint gives the same clustering
+		scc_init_empty_clustering(100, NULL, &cl_cut);
+		assert_int_equal(scc_cut_cluster_tree(tree, 2, cl_cut), SCC_ER_OK);
+		assert_int_equal(cl_cut->num_clusters, cl_ref->num_clusters);
+		assert_memory_equal(cl_cut->cluster_label, cl_ref->cluster_label, 100 * sizeof(scc_Clabel));
+		scc_free_clustering(&cl_cut);
+
+		size_t prev_num_clusters = cl_ref->num_clusters;
+		const uint32_t cut_constraints[4] = { 3, 5, 10, 30 };
+		for (size_t c = 0; c < 4; ++c) {
+			scc_init_empty_clustering(100, NULL, &cl_cut);
+			assert_int_equal(scc_cut_cluster_tree(tree, cut_constraints[c], cl_cut), SCC_ER_OK);
+			assert_true(cl_cut->num_clusters <= prev_num_clusters);
+			prev_num_clusters = cl_cut->num_clusters;
+
+			scc_ClusterOptions options = scc_get_default_options();
+			options.size_constraint = cut_constraints[c];
+			bool cut_is_OK = false;
+			assert_int_equal(scc_check_clustering(cl_cut, &options, &cut_is_OK), SCC_ER_OK);
+			assert_true(cut_is_OK);
+
+			// Clusters of the cut are unions of clusters from the tree's own constraint
+			scc_Clabel coarse_label[100];
+			for (size_t i = 0; i < 100; ++i) coarse_label[i] = SCC_CLABEL_NA;
+			for (size_t i = 0; i < 100; ++i) {
+				const scc_Clabel fine = cl_ref->cluster_label[i];
+				if (coarse_label[fine] == SCC_CLABEL_NA) coarse_label[fine] = cl_cut->cluster_label[i];
+				assert_int_equal(coarse_label[fine], cl_cut->cluster_label[i]);
+			}
+			scc_free_clustering(&cl_cut);
+		}
+
+		scc_free_clustering(&cl_ref);
+		scc_free_clustering(&cl_tree);
+		scc_free_cluster_tree(&tree);
+		assert_null(tree);
+	}
+
+	// Trees can start from existing clusterings, and unassigned points stay unassigned
+	scc_Clabel cluster_label[100];
+	for (size_t i = 0; i < 100; ++i) {
+		cluster_label[i] = (i % 7 == 0) ? SCC_CLABEL_NA : (scc_Clabel) (i % 2);
+	}
+	scc_init_existing_clustering(100, 2, cluster_label, true, &cl_ref);
+	assert_int_equal(scc_hierarchical_clustering(scc_ut_test_data_large, 10, true, cl_ref), SCC_ER_OK);
+	scc_init_existing_clustering(100, 2, cluster_label, true, &cl_tree);
+	assert_int_equal(scc_hierarchical_clustering_tree(scc_ut_test_data_large, 10, true, cl_tree, &tree), SCC_ER_OK);
+	assert_memory_equal(cl_tree->cluster_label, cl_ref->cluster_label, 100 * sizeof(scc_Clabel));
+
+	scc_init_empty_clustering(100, NULL, &cl_cut);
+	assert_int_equal(scc_cut_cluster_tree(tree, 10, cl_cut), SCC_ER_OK);
+	assert_int_equal(cl_cut->num_clusters, cl_ref->num_clusters);
+	assert_memory_equal(cl_cut->cluster_label, cl_ref->cluster_label, 100 * sizeof(scc_Clabel));
+	assert_int_equal(scc_cut_cluster_tree(tree, 40, cl_cut), SCC_ER_OK);
+	assert_int_equal(cl_cut->num_clusters, 2);
+	// The roots are labeled last to first, as in `scc_hierarchical_clustering`
+	for (size_t i = 0; i < 100; ++i) {
+		const scc_Clabel ref_label = (cluster_label[i] == SCC_CLABEL_NA) ? SCC_CLABEL_NA : (scc_Clabel) (1 - cluster_label[i]);
+		assert_int_equal(cl_cut->cluster_label[i], ref_label);
+	}
+
+	// The roots have 42 and 43 points, so no cut satisfies larger constraints
+	assert_int_equal(scc_cut_cluster_tree(tree, 42, cl_cut), SCC_ER_OK);
+	assert_int_equal(scc_cut_cluster_tree(tree, 43, cl_cut), SCC_ER_INVALID_INPUT);
+	assert_int_equal(scc_cut_cluster_tree(tree, 50, cl_cut), SCC_ER_INVALID_INPUT);
+
+	assert_int_equal(scc_cut_cluster_tree(tree, 1, cl_cut), SCC_ER_INVALID_INPUT);
+	assert_int_equal(scc_cut_cluster_tree(tree, 101, cl_cut), SCC_ER_NO_SOLUTION);
+	assert_int_equal(scc_cut_cluster_tree(NULL, 10, cl_cut), SCC_ER_INVALID_INPUT);
+	assert_int_equal(scc_cut_cluster_tree(tree, 10, NULL), SCC_ER_INVALID_INPUT);
+	assert_int_equal(scc_hierarchical_clustering_tree(scc_ut_test_data_large, 10, true, cl_cut, NULL), SCC_ER_INVALID_INPUT);
+
+	scc_free_clustering(&cl_ref);
+	scc_free_clustering(&cl_tree);
+	scc_free_clustering(&cl_cut);
+	scc_free_cluster_tree(&tree);
+	scc_free_cluster_tree(&tree);
+	scc_free_cluster_tree(NULL);
+	assert_false(scc_is_initialized_cluster_tree(tree));
+}
+
+
 int main(void)
 {
 	if(!scc_ut_init_tests()) return 1;
 
 	const struct CMUnitTest test_cases[] = {
 		cmocka_unit_test(scc_ut_hierarchical_clustering),
+		cmocka_unit_test(scc_ut_hierarchical_clustering_tree),
 	};
 
 	return cmocka_run_group_tests_name("hierarchical_clustering.c", test_cases, NULL, NULL);
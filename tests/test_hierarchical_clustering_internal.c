@@ -183,9 +183,17 @@ void scc_ut_hi_run_hierarchical_clustering(void** state)
 		.pointindex_array1 = malloc(sizeof(scc_PointIndex[100])),
 		.pointindex_array2 = malloc(sizeof(scc_PointIndex[100])),
 		.dist_array = malloc(sizeof(double[200])),
-		.vertex_markers = calloc(100, sizeof(uint_fast16_t)),
-		.edge_store1 = malloc(sizeof(iscc_hi_DistanceEdge[100])),
-		.edge_store2 = malloc(sizeof(iscc_hi_DistanceEdge[100])),
+		.vertex_markers = calloc(100, sizeof(uint16_t)),
+		.edge_list1 = {
+			.heads = malloc(sizeof(scc_PointIndex[100])),
+			.dists = malloc(sizeof(double[100])),
+		},
+		.edge_list2 = {
+			.heads = malloc(sizeof(scc_PointIndex[100])),
+			.dists = malloc(sizeof(double[100])),
+		},
+		.heads_scratch = malloc(sizeof(scc_PointIndex[100])),
+		.dists_scratch = malloc(sizeof(double[100])),
 	};
 
 	scc_Clustering cl1 = {
@@ -197,7 +205,7 @@ void scc_ut_hi_run_hierarchical_clustering(void** state)
 	};
 	iscc_hi_ClusterStack cl_stack1;
 	iscc_hi_empty_cl_stack(100, &cl_stack1);
-	scc_ErrorCode ec1 = iscc_hi_run_hierarchical_clustering(&cl_stack1, &cl1, scc_ut_test_data_large, &wa, 20, true);
+	scc_ErrorCode ec1 = iscc_hi_run_hierarchical_clustering(&cl_stack1, &cl1, scc_ut_test_data_large, &wa, 20, true, NULL);
 	assert_int_equal(ec1, SCC_ER_OK);
 	scc_Clabel ref_label1[100] = { 2, 3, 3, 2, 2, 3, 0, 0, 4, 3, 2, 1, 1, 0, 4, 3, 0, 2, 0, 4, 3, 1, 3,
 	                               0, 0, 0, 4, 0, 4, 0, 3, 4, 3, 1, 0, 0, 3, 4, 1, 0, 3, 2, 1, 2, 2, 2,
@@ -225,7 +233,7 @@ void scc_ut_hi_run_hierarchical_clustering(void** state)
 	};
 	iscc_hi_ClusterStack cl_stack2;
 	iscc_hi_empty_cl_stack(100, &cl_stack2);
-	scc_ErrorCode ec2 = iscc_hi_run_hierarchical_clustering(&cl_stack2, &cl2, scc_ut_test_data_large, &wa, 20, false);
+	scc_ErrorCode ec2 = iscc_hi_run_hierarchical_clustering(&cl_stack2, &cl2, scc_ut_test_data_large, &wa, 20, false, NULL);
 	assert_int_equal(ec2, SCC_ER_OK);
 	scc_Clabel ref_label2[100] = { 3, 0, 2, 3, 3, 2, 1, 1, 3, 2, 3, 0, 1, 0, 2, 2, 1, 3, 0, 2, 2, 0, 1, 1, 0, 1, 2, 1, 2, 0,
 	                               2, 2, 2, 0, 1, 1, 2, 2, 0, 0, 3, 3, 0, 3, 3, 0, 1, 3, 0, 2, 0, 2, 2, 2, 0, 0, 2, 0, 2, 1,
@@ -261,7 +269,7 @@ void scc_ut_hi_run_hierarchical_clustering(void** state)
 	iscc_hi_ClusterStack cl_stack3;
 	iscc_hi_init_cl_stack(&cl3, &cl_stack3, &size_largest_cluster3);
 	assert_int_equal(size_largest_cluster3, 50);
-	scc_ErrorCode ec3 = iscc_hi_run_hierarchical_clustering(&cl_stack3, &cl3, scc_ut_test_data_large, &wa, 20, true);
+	scc_ErrorCode ec3 = iscc_hi_run_hierarchical_clustering(&cl_stack3, &cl3, scc_ut_test_data_large, &wa, 20, true, NULL);
 	assert_int_equal(ec3, SCC_ER_OK);
 	scc_Clabel ref_label3[100] = { 1, 1, 3, 3, 3, 0, 0, 2, 0, 0, 3, 1, 2, 2, 3, 1, 0, 3, 1, 0, 0, 2, 1, 1, 1,
 	                               0, 1, 2, 0, 2, 3, 0, 0, 1, 2, 0, 3, 2, 1, 1, 1, 3, 2, 3, 1, 2, 2, 2, 1, 0,
@@ -296,7 +304,7 @@ void scc_ut_hi_run_hierarchical_clustering(void** state)
 	iscc_hi_ClusterStack cl_stack4;
 	iscc_hi_init_cl_stack(&cl4, &cl_stack4, &size_largest_cluster4);
 	assert_int_equal(size_largest_cluster4, 50);
-	scc_ErrorCode ec4 = iscc_hi_run_hierarchical_clustering(&cl_stack4, &cl4, scc_ut_test_data_large, &wa, 20, false);
+	scc_ErrorCode ec4 = iscc_hi_run_hierarchical_clustering(&cl_stack4, &cl4, scc_ut_test_data_large, &wa, 20, false, NULL);
 	assert_int_equal(ec4, SCC_ER_OK);
 	scc_Clabel ref_label4[100] = { 1, 0, 3, 3, 3, 0, 0, 2, 0, 0, 3, 0, 2, 2, 3, 1, 0, 3, 1, 0, 0, 2, 1, 1, 1,
 	                               0, 0, 2, 0, 2, 3, 0, 0, 1, 2, 0, 3, 3, 0, 0, 1, 3, 2, 3, 1, 2, 2, 2, 0, 0,
@@ -314,8 +322,112 @@ void scc_ut_hi_run_hierarchical_clustering(void** state)
 	free(wa.pointindex_array2);
 	free(wa.dist_array);
 	free(wa.vertex_markers);
-	free(wa.edge_store1);
-	free(wa.edge_store2);
+	free(wa.edge_list1.heads);
+	free(wa.edge_list1.dists);
+	free(wa.edge_list2.heads);
+	free(wa.edge_list2.dists);
+	free(wa.heads_scratch);
+	free(wa.dists_scratch);
+}
+
+
+void scc_ut_hi_run_parallel_hierarchical_clustering(void** state)
+{
+	(void) state;
+
+	// Random points, compared with the serial run
+	const size_t num_data_points = 20000;
+	double* const coords = malloc(sizeof(double[2 * num_data_points]));
+	for (size_t i = 0; i < 2 * num_data_points; ++i) {
+		coords[i] = (double) rand() / RAND_MAX;
+	}
+	scc_DataSet* data_set;
+	assert_int_equal(scc_init_data_set(num_data_points, 2, 2 * num_data_points, coords, &data_set), SCC_ER_OK);
+
+	iscc_hi_WorkArea wa = {
+		.pointindex_array1 = malloc(sizeof(scc_PointIndex[100])),
+		.pointindex_array2 = malloc(sizeof(scc_PointIndex[100])),
+		.dist_array = malloc(sizeof(double[2 * num_data_points])),
+		.vertex_markers = NULL,
+		.edge_list1 = {
+			.heads = malloc(sizeof(scc_PointIndex[num_data_points])),
+			.dists = malloc(sizeof(double[num_data_points])),
+		},
+		.edge_list2 = {
+			.heads = malloc(sizeof(scc_PointIndex[num_data_points])),
+			.dists = malloc(sizeof(double[num_data_points])),
+		},
+		.heads_scratch = malloc(sizeof(scc_PointIndex[num_data_points])),
+		.dists_scratch = malloc(sizeof(double[num_data_points])),
+	};
+	scc_Clabel* const serial_label = malloc(sizeof(scc_Clabel[num_data_points]));
+	scc_Clabel* const parallel_label = malloc(sizeof(scc_Clabel[num_data_points]));
+
+	for (int batch_assign = 0; batch_assign < 2; ++batch_assign) {
+		for (uint32_t size_constraint = 2; size_constraint <= 8; size_constraint *= 2) {
+			wa.vertex_markers = calloc(num_data_points, sizeof(uint16_t));
+			scc_Clustering serial_cl = {
+				.num_data_points = num_data_points,
+				.num_clusters = 0,
+				.cluster_label = serial_label,
+				.external_labels = true,
+				.clustering_version = ISCC_CLUSTERING_STRUCT_VERSION,
+			};
+			iscc_hi_ClusterStack serial_stack;
+			assert_int_equal(iscc_hi_empty_cl_stack(num_data_points, &serial_stack), SCC_ER_OK);
+			scc_ClusterTree* serial_tree = NULL;
+			assert_int_equal(iscc_hi_init_cluster_tree(&serial_stack, num_data_points, size_constraint, &serial_tree), SCC_ER_OK);
+			assert_int_equal(iscc_hi_run_hierarchical_clustering(&serial_stack, &serial_cl, data_set, &wa,
+			                                                     size_constraint, (batch_assign == 1), serial_tree), SCC_ER_OK);
+			free(serial_stack.clusters);
+			free(serial_stack.pointindex_store);
+			free(wa.vertex_markers);
+
+			scc_Clustering parallel_cl = {
+				.num_data_points = num_data_points,
+				.num_clusters = 0,
+				.cluster_label = parallel_label,
+				.external_labels = true,
+				.clustering_version = ISCC_CLUSTERING_STRUCT_VERSION,
+			};
+			iscc_hi_ClusterStack parallel_stack;
+			assert_int_equal(iscc_hi_empty_cl_stack(num_data_points, &parallel_stack), SCC_ER_OK);
+			scc_ClusterTree* parallel_tree = NULL;
+			assert_int_equal(iscc_hi_init_cluster_tree(&parallel_stack, num_data_points, size_constraint, &parallel_tree), SCC_ER_OK);
+			assert_int_equal(iscc_hi_run_parallel_hierarchical_clustering(&parallel_stack, &parallel_cl, data_set,
+			                                                              size_constraint, (batch_assign == 1), 4, parallel_tree), SCC_ER_OK);
+			assert_int_equal(parallel_stack.items, 0);
+			assert_int_equal(iscc_hi_order_tree_nodes(parallel_tree), SCC_ER_OK);
+			free(parallel_stack.clusters);
+			free(parallel_stack.pointindex_store);
+
+			assert_int_equal(serial_cl.num_clusters, parallel_cl.num_clusters);
+			assert_memory_equal(serial_label, parallel_label, num_data_points * sizeof(scc_Clabel));
+
+			// The parallel splits are renumbered in the serial order
+			assert_int_equal(serial_tree->num_nodes, 2 * serial_cl.num_clusters - 1);
+			assert_int_equal(serial_tree->num_nodes, parallel_tree->num_nodes);
+			assert_memory_equal(serial_tree->node_first, parallel_tree->node_first, serial_tree->num_nodes * sizeof(size_t));
+			assert_memory_equal(serial_tree->node_size, parallel_tree->node_size, serial_tree->num_nodes * sizeof(size_t));
+			assert_memory_equal(serial_tree->node_child, parallel_tree->node_child, serial_tree->num_nodes * sizeof(size_t));
+			scc_free_cluster_tree(&serial_tree);
+			scc_free_cluster_tree(&parallel_tree);
+		}
+	}
+
+	free(wa.pointindex_array1);
+	free(wa.pointindex_array2);
+	free(wa.dist_array);
+	free(wa.edge_list1.heads);
+	free(wa.edge_list1.dists);
+	free(wa.edge_list2.heads);
+	free(wa.edge_list2.dists);
+	free(wa.heads_scratch);
+	free(wa.dists_scratch);
+	free(serial_label);
+	free(parallel_label);
+	scc_free_data_set(&data_set);
+	free(coords);
 }
 
 
@@ -388,9 +500,17 @@ void scc_ut_hi_break_cluster_into_two(void** state)
 		.pointindex_array1 = malloc(sizeof(scc_PointIndex[100])),
 		.pointindex_array2 = malloc(sizeof(scc_PointIndex[100])),
 		.dist_array = malloc(sizeof(double[100])),
-		.vertex_markers = calloc(100, sizeof(uint_fast16_t)),
-		.edge_store1 = malloc(sizeof(iscc_hi_DistanceEdge[40])),
-		.edge_store2 = malloc(sizeof(iscc_hi_DistanceEdge[40])),
+		.vertex_markers = calloc(100, sizeof(uint16_t)),
+		.edge_list1 = {
+			.heads = malloc(sizeof(scc_PointIndex[40])),
+			.dists = malloc(sizeof(double[40])),
+		},
+		.edge_list2 = {
+			.heads = malloc(sizeof(scc_PointIndex[40])),
+			.dists = malloc(sizeof(double[40])),
+		},
+		.heads_scratch = malloc(sizeof(scc_PointIndex[40])),
+		.dists_scratch = malloc(sizeof(double[40])),
 	};
 
 	scc_PointIndex members1[10] = { 2, 4, 6, 8, 10, 12, 14, 16, 18, 20 };
@@ -545,8 +665,12 @@ void scc_ut_hi_break_cluster_into_two(void** state)
 	free(wa.pointindex_array2);
 	free(wa.dist_array);
 	free(wa.vertex_markers);
-	free(wa.edge_store1);
-	free(wa.edge_store2);
+	free(wa.edge_list1.heads);
+	free(wa.edge_list1.dists);
+	free(wa.edge_list2.heads);
+	free(wa.edge_list2.dists);
+	free(wa.heads_scratch);
+	free(wa.dists_scratch);
 }
 
 
@@ -554,11 +678,11 @@ void scc_ut_hi_get_next_marker(void** state)
 {
 	(void) state;
 
-	const uint_fast16_t vertex_markers_ref[20] = { 0, 2, 3, 4, 0,
+	const uint16_t vertex_markers_ref[20] = { 0, 2, 3, 4, 0,
 	                                               6, 0, 8, 0, 10,
 	                                               11, 12, 13, 14, 15,
 	                                               16, 17, 18, 0, 20 };
-	uint_fast16_t vertex_markers[20] = { 0, 2, 3, 4, 0,
+	uint16_t vertex_markers[20] = { 0, 2, 3, 4, 0,
 	                                     6, 0, 8, 0, 10,
 	                                     11, 12, 13, 14, 15,
 	                                     16, 17, 18, 0, 20 };
@@ -571,40 +695,40 @@ void scc_ut_hi_get_next_marker(void** state)
 		.members = mems,
 	};
 
-	uint_fast16_t next_marker1 = iscc_hi_get_next_marker(&cl_item, vertex_markers);
+	uint16_t next_marker1 = iscc_hi_get_next_marker(&cl_item, vertex_markers);
 	assert_int_equal(next_marker1, 1);
 	assert_int_equal(cl_item.size, 5);
 	assert_int_equal(cl_item.marker, 1);
 	assert_memory_equal(mems, mems_ref, 5 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, vertex_markers_ref, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, vertex_markers_ref, 20 * sizeof(uint16_t));
 
-	uint_fast16_t next_marker2 = iscc_hi_get_next_marker(&cl_item, vertex_markers);
+	uint16_t next_marker2 = iscc_hi_get_next_marker(&cl_item, vertex_markers);
 	assert_int_equal(next_marker2, 2);
 	assert_int_equal(cl_item.size, 5);
 	assert_int_equal(cl_item.marker, 2);
 	assert_memory_equal(mems, mems_ref, 5 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, vertex_markers_ref, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, vertex_markers_ref, 20 * sizeof(uint16_t));
 
 	vertex_markers[0] = 4;
 	vertex_markers[4] = 3;
 	vertex_markers[6] = 2;
 	vertex_markers[8] = 8;
 	vertex_markers[18] = 4;
-	cl_item.marker = UINT_FAST16_MAX;
+	cl_item.marker = UINT16_MAX;
 
-	uint_fast16_t next_marker3 = iscc_hi_get_next_marker(&cl_item, vertex_markers);
+	uint16_t next_marker3 = iscc_hi_get_next_marker(&cl_item, vertex_markers);
 	assert_int_equal(next_marker3, 1);
 	assert_int_equal(cl_item.size, 5);
 	assert_int_equal(cl_item.marker, 1);
 	assert_memory_equal(mems, mems_ref, 5 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, vertex_markers_ref, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, vertex_markers_ref, 20 * sizeof(uint16_t));
 
-	uint_fast16_t next_marker4 = iscc_hi_get_next_marker(&cl_item, vertex_markers);
+	uint16_t next_marker4 = iscc_hi_get_next_marker(&cl_item, vertex_markers);
 	assert_int_equal(next_marker4, 2);
 	assert_int_equal(cl_item.size, 5);
 	assert_int_equal(cl_item.marker, 2);
 	assert_memory_equal(mems, mems_ref, 5 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, vertex_markers_ref, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, vertex_markers_ref, 20 * sizeof(uint16_t));
 }
 
 
@@ -623,92 +747,123 @@ void scc_ut_hi_get_next_k_nn(void** state)
 		.pointindex_array1 = NULL,
 		.pointindex_array2 = NULL,
 		.dist_array = malloc(sizeof(double[20])),
-		.vertex_markers = calloc(100, sizeof(uint_fast16_t)),
-		.edge_store1 = malloc(sizeof(iscc_hi_DistanceEdge[10])),
-		.edge_store2 = malloc(sizeof(iscc_hi_DistanceEdge[10])),
+		.vertex_markers = calloc(100, sizeof(uint16_t)),
+		.edge_list1 = {
+			.heads = malloc(sizeof(scc_PointIndex[10])),
+			.dists = malloc(sizeof(double[10])),
+		},
+		.edge_list2 = {
+			.heads = malloc(sizeof(scc_PointIndex[10])),
+			.dists = malloc(sizeof(double[10])),
+		},
+		.heads_scratch = malloc(sizeof(scc_PointIndex[10])),
+		.dists_scratch = malloc(sizeof(double[10])),
 	};
 
 	assert_int_equal(iscc_hi_populate_edge_lists(&cl, scc_ut_test_data_large, 6, 16, &wa), SCC_ER_OK);
 
 	scc_PointIndex out_dist_array0[4];
 	const scc_PointIndex ref_dist_array0[4] = { 12, 16, 18, 4 };
-	iscc_hi_DistanceEdge* prev_dist0 = iscc_hi_get_next_k_nn(wa.edge_store1, 4, wa.vertex_markers, 1, out_dist_array0);
+	const size_t next0 = iscc_hi_get_next_k_nn(&wa.edge_list1, 4, wa.vertex_markers, 1, out_dist_array0);
 	assert_memory_equal(out_dist_array0, ref_dist_array0, 4 * sizeof(scc_PointIndex));
-	assert_int_equal(prev_dist0->head, 4);
-	assert_double_equal(prev_dist0->distance, 72.125847);
-	assert_ptr_equal(prev_dist0->next_dist, prev_dist0 + 1);
+	assert_int_equal(next0, 3);
+	assert_int_equal(wa.edge_list1.heads[next0], 4);
+	assert_double_equal(wa.edge_list1.dists[next0], 72.125847);
+	assert_int_equal(wa.edge_list1.first, 0);
 
+	wa.edge_list1.first = 2;
 	scc_PointIndex out_dist_array1[4];
 	const scc_PointIndex ref_dist_array1[4] = { 18, 4, 10, 14 };
-	iscc_hi_DistanceEdge* prev_dist1 = iscc_hi_get_next_k_nn(&wa.edge_store1[2], 4, wa.vertex_markers, 1, out_dist_array1);
+	const size_t next1 = iscc_hi_get_next_k_nn(&wa.edge_list1, 4, wa.vertex_markers, 1, out_dist_array1);
 	assert_memory_equal(out_dist_array1, ref_dist_array1, 4 * sizeof(scc_PointIndex));
-	assert_int_equal(prev_dist1->head, 14);
-	assert_double_equal(prev_dist1->distance, 80.566800);
-	assert_ptr_equal(prev_dist1->next_dist, prev_dist1 + 1);
+	assert_int_equal(next1, 5);
+	assert_int_equal(wa.edge_list1.heads[next1], 14);
+	assert_double_equal(wa.edge_list1.dists[next1], 80.566800);
+	assert_int_equal(wa.edge_list1.first, 2);
 
 	wa.vertex_markers[18] = 1;
 	wa.vertex_markers[4] = 1;
 	wa.vertex_markers[8] = 1;
 
+	// Assigned points that are passed over are removed from the list
+	wa.edge_list1.first = 0;
 	scc_PointIndex out_dist_arrayY[4];
 	const scc_PointIndex ref_dist_arrayY[4] = { 12, 16, 10, 14 };
-	iscc_hi_DistanceEdge* prev_distY = iscc_hi_get_next_k_nn(wa.edge_store1, 4, wa.vertex_markers, 1, out_dist_arrayY);
+	const size_t nextY = iscc_hi_get_next_k_nn(&wa.edge_list1, 4, wa.vertex_markers, 1, out_dist_arrayY);
 	assert_memory_equal(out_dist_arrayY, ref_dist_arrayY, 4 * sizeof(scc_PointIndex));
-	assert_int_equal(prev_distY->head, 14);
-	assert_double_equal(prev_distY->distance, 80.566800);
-	assert_ptr_equal(prev_distY->next_dist, prev_distY + 1);
+	assert_int_equal(nextY, 5);
+	assert_int_equal(wa.edge_list1.heads[nextY], 14);
+	assert_double_equal(wa.edge_list1.dists[nextY], 80.566800);
+	assert_int_equal(wa.edge_list1.first, 2);
+	assert_memory_equal(&wa.edge_list1.heads[2], ref_dist_arrayY, 4 * sizeof(scc_PointIndex));
 
 	scc_PointIndex out_dist_arrayX[2];
 	const scc_PointIndex ref_dist_arrayX[2] = { 12, 16 };
-	iscc_hi_DistanceEdge* prev_distX = iscc_hi_get_next_k_nn(wa.edge_store1, 2, wa.vertex_markers, 1, out_dist_arrayX);
+	const size_t nextX = iscc_hi_get_next_k_nn(&wa.edge_list1, 2, wa.vertex_markers, 1, out_dist_arrayX);
 	assert_memory_equal(out_dist_arrayX, ref_dist_arrayX, 2 * sizeof(scc_PointIndex));
-	assert_int_equal(prev_distX->head, 16);
-	assert_double_equal(prev_distX->distance, 43.918798);
-	assert_ptr_equal(prev_distX->next_dist, prev_distX + 3);
+	assert_int_equal(nextX, 3);
+	assert_int_equal(wa.edge_list1.heads[nextX], 16);
+	assert_double_equal(wa.edge_list1.dists[nextX], 43.918798);
+	assert_int_equal(wa.edge_list1.first, 2);
+
+	wa.vertex_markers[12] = 1;
+	wa.vertex_markers[16] = 1;
 
 	scc_PointIndex out_dist_array2[4];
 	const scc_PointIndex ref_dist_array2[4] = { 10, 14, 20, 2 };
-	iscc_hi_DistanceEdge* prev_dist2 = iscc_hi_get_next_k_nn(&wa.edge_store1[2], 4, wa.vertex_markers, 1, out_dist_array2);
+	const size_t next2 = iscc_hi_get_next_k_nn(&wa.edge_list1, 4, wa.vertex_markers, 1, out_dist_array2);
 	assert_memory_equal(out_dist_array2, ref_dist_array2, 4 * sizeof(scc_PointIndex));
-	assert_int_equal(prev_dist2->head, 2);
-	assert_double_equal(prev_dist2->distance, 103.030113);
-	assert_null(prev_dist2->next_dist);
+	assert_int_equal(next2, 8);
+	assert_int_equal(wa.edge_list1.heads[next2], 2);
+	assert_double_equal(wa.edge_list1.dists[next2], 103.030113);
+	assert_int_equal(wa.edge_list1.first, 5);
+	assert_memory_equal(&wa.edge_list1.heads[5], ref_dist_array2, 4 * sizeof(scc_PointIndex));
 
 	wa.vertex_markers[20] = 1;
 
-	scc_PointIndex out_dist_array3[4];
-	const scc_PointIndex ref_dist_array3[4] = { 16, 10, 14, 2 };
-	iscc_hi_DistanceEdge* prev_dist3 = iscc_hi_get_next_k_nn(&wa.edge_store1[1], 4, wa.vertex_markers, 1, out_dist_array3);
-	assert_memory_equal(out_dist_array3, ref_dist_array3, 4 * sizeof(scc_PointIndex));
-	assert_int_equal(prev_dist3->head, 2);
-	assert_double_equal(prev_dist3->distance, 103.030113);
-	assert_null(prev_dist3->next_dist);
-
-
+	scc_PointIndex out_dist_array3[3];
+	const scc_PointIndex ref_dist_array3[3] = { 10, 14, 2 };
+	const size_t next3 = iscc_hi_get_next_k_nn(&wa.edge_list1, 3, wa.vertex_markers, 1, out_dist_array3);
+	assert_memory_equal(out_dist_array3, ref_dist_array3, 3 * sizeof(scc_PointIndex));
+	assert_int_equal(next3, 8);
+	assert_int_equal(wa.edge_list1.heads[next3], 2);
+	assert_double_equal(wa.edge_list1.dists[next3], 103.030113);
+	assert_int_equal(wa.edge_list1.first, 6);
+	assert_memory_equal(&wa.edge_list1.heads[6], ref_dist_array3, 3 * sizeof(scc_PointIndex));
+
+	wa.edge_list2.first = 4;
 	scc_PointIndex out_dist_array4[1];
 	const scc_PointIndex ref_dist_array4[1] = { 8 };
-	iscc_hi_DistanceEdge* prev_dist4 = iscc_hi_get_next_k_nn(&wa.edge_store2[4], 1, wa.vertex_markers, 2, out_dist_array4);
+	const size_t next4 = iscc_hi_get_next_k_nn(&wa.edge_list2, 1, wa.vertex_markers, 2, out_dist_array4);
 	assert_memory_equal(out_dist_array4, ref_dist_array4, 1 * sizeof(scc_PointIndex));
-	assert_int_equal(prev_dist4->head, 8);
-	assert_double_equal(prev_dist4->distance, 62.616031);
-	assert_ptr_equal(prev_dist4->next_dist, prev_dist4 + 1);
+	assert_int_equal(next4, 4);
+	assert_int_equal(wa.edge_list2.heads[next4], 8);
+	assert_double_equal(wa.edge_list2.dists[next4], 62.616031);
+	assert_int_equal(wa.edge_list2.first, 4);
 
 	wa.vertex_markers[4] = 2;
 	wa.vertex_markers[14] = 2;
 	wa.vertex_markers[20] = 2;
 
+	wa.edge_list2.first = 2;
 	scc_PointIndex out_dist_array5[3];
 	const scc_PointIndex ref_dist_array5[3] = { 8, 10, 2 };
-	iscc_hi_DistanceEdge* prev_dist5 = iscc_hi_get_next_k_nn(&wa.edge_store2[2], 3, wa.vertex_markers, 2, out_dist_array5);
+	const size_t next5 = iscc_hi_get_next_k_nn(&wa.edge_list2, 3, wa.vertex_markers, 2, out_dist_array5);
 	assert_memory_equal(out_dist_array5, ref_dist_array5, 3 * sizeof(scc_PointIndex));
-	assert_int_equal(prev_dist5->head, 2);
-	assert_double_equal(prev_dist5->distance, 83.120587);
-	assert_ptr_equal(prev_dist5->next_dist, prev_dist5 + 1);
+	assert_int_equal(next5, 7);
+	assert_int_equal(wa.edge_list2.heads[next5], 2);
+	assert_double_equal(wa.edge_list2.dists[next5], 83.120587);
+	assert_int_equal(wa.edge_list2.first, 5);
+	assert_int_equal(wa.edge_list2.heads[8], 18);
 
 	free(wa.dist_array);
 	free(wa.vertex_markers);
-	free(wa.edge_store1);
-	free(wa.edge_store2);
+	free(wa.edge_list1.heads);
+	free(wa.edge_list1.dists);
+	free(wa.edge_list2.heads);
+	free(wa.edge_list2.dists);
+	free(wa.heads_scratch);
+	free(wa.dists_scratch);
 }
 
 
@@ -727,114 +882,82 @@ void scc_ut_hi_get_next_dist(void** state)
 		.pointindex_array1 = NULL,
 		.pointindex_array2 = NULL,
 		.dist_array = malloc(sizeof(double[10])),
-		.vertex_markers = calloc(100, sizeof(uint_fast16_t)),
-		.edge_store1 = malloc(sizeof(iscc_hi_DistanceEdge[5])),
-		.edge_store2 = malloc(sizeof(iscc_hi_DistanceEdge[5])),
+		.vertex_markers = calloc(100, sizeof(uint16_t)),
+		.edge_list1 = {
+			.heads = malloc(sizeof(scc_PointIndex[5])),
+			.dists = malloc(sizeof(double[5])),
+		},
+		.edge_list2 = {
+			.heads = malloc(sizeof(scc_PointIndex[5])),
+			.dists = malloc(sizeof(double[5])),
+		},
+		.heads_scratch = malloc(sizeof(scc_PointIndex[5])),
+		.dists_scratch = malloc(sizeof(double[5])),
 	};
 
 	assert_int_equal(iscc_hi_populate_edge_lists(&cl, scc_ut_test_data_large, 6, 4, &wa), SCC_ER_OK);
 
-	assert_int_equal(wa.edge_store1[1].head, 4);
-	assert_double_equal(wa.edge_store1[1].distance, 72.125847);
-	assert_int_equal(wa.edge_store1[2].head, 10);
-	assert_double_equal(wa.edge_store1[2].distance, 76.285875);
-	assert_int_equal(wa.edge_store1[3].head, 8);
-	assert_double_equal(wa.edge_store1[3].distance, 82.249050);
-	assert_int_equal(wa.edge_store1[4].head, 2);
-	assert_double_equal(wa.edge_store1[4].distance, 103.030113);
-	for (size_t i = 0; i < 4; ++i) {
-		assert_ptr_equal(wa.edge_store1[i].next_dist, &wa.edge_store1[i + 1]);
-    }
-    assert_null(wa.edge_store1[4].next_dist);
-
-	assert_int_equal(wa.edge_store2[1].head, 2);
-	assert_double_equal(wa.edge_store2[1].distance, 63.103580);
-	assert_int_equal(wa.edge_store2[2].head, 10);
-	assert_double_equal(wa.edge_store2[2].distance, 67.606177);
-	assert_int_equal(wa.edge_store2[3].head, 6);
-	assert_double_equal(wa.edge_store2[3].distance, 72.125847);
-	assert_int_equal(wa.edge_store2[4].head, 8);
-	assert_double_equal(wa.edge_store2[4].distance, 89.098152);
-	for (size_t i = 0; i < 4; ++i) {
-		assert_ptr_equal(wa.edge_store2[i].next_dist, &wa.edge_store2[i + 1]);
-    }
-    assert_null(wa.edge_store2[4].next_dist);
+	const scc_PointIndex ref_heads1[4] = { 4, 10, 8, 2 };
+	const double ref_dists1[4] = { 72.125847, 76.285875, 82.249050, 103.030113 };
+	const scc_PointIndex ref_heads2[4] = { 2, 10, 6, 8 };
+	const double ref_dists2[4] = { 63.103580, 67.606177, 72.125847, 89.098152 };
 
+	assert_int_equal(wa.edge_list1.first, 0);
+	assert_int_equal(wa.edge_list1.len, 4);
+	assert_int_equal(wa.edge_list2.first, 0);
+	assert_int_equal(wa.edge_list2.len, 4);
+	for (size_t i = 0; i < 4; ++i) {
+		assert_int_equal(wa.edge_list1.heads[i], ref_heads1[i]);
+		assert_double_equal(wa.edge_list1.dists[i], ref_dists1[i]);
+		assert_int_equal(wa.edge_list2.heads[i], ref_heads2[i]);
+		assert_double_equal(wa.edge_list2.dists[i], ref_dists2[i]);
+	}
 
-    iscc_hi_DistanceEdge* next0 = iscc_hi_get_next_dist(wa.edge_store1, wa.vertex_markers, 1);
-	assert_int_equal(next0->head, 4);
-	assert_double_equal(next0->distance, 72.125847);
-	assert_ptr_equal(next0->next_dist, &wa.edge_store1[2]);
+	assert_int_equal(iscc_hi_get_next_dist(&wa.edge_list1, wa.vertex_markers, 1), 0);
+	assert_int_equal(wa.edge_list1.first, 0);
 
-	iscc_hi_DistanceEdge* next1 = iscc_hi_get_next_dist(&wa.edge_store1[2], wa.vertex_markers, 1);
-	assert_int_equal(next1->head, 8);
-	assert_double_equal(next1->distance, 82.249050);
-	assert_ptr_equal(next1->next_dist, &wa.edge_store1[4]);
+	wa.edge_list1.first = 2;
+	assert_int_equal(iscc_hi_get_next_dist(&wa.edge_list1, wa.vertex_markers, 1), 2);
+	assert_int_equal(wa.edge_list1.first, 2);
 
-	iscc_hi_DistanceEdge* next2 = iscc_hi_get_next_dist(&wa.edge_store1[3], wa.vertex_markers, 1);
-	assert_int_equal(next2->head, 2);
-	assert_double_equal(next2->distance, 103.030113);
-	assert_null(next2->next_dist);
+	wa.edge_list1.first = 3;
+	assert_int_equal(iscc_hi_get_next_dist(&wa.edge_list1, wa.vertex_markers, 1), 3);
+	assert_int_equal(wa.edge_list1.first, 3);
 
 	wa.vertex_markers[8] = 1;
 
-	iscc_hi_DistanceEdge* next3 = iscc_hi_get_next_dist(&wa.edge_store1[2], wa.vertex_markers, 1);
-	assert_int_equal(next3->head, 2);
-	assert_double_equal(next3->distance, 103.030113);
-	assert_null(next3->next_dist);
-
-	iscc_hi_DistanceEdge* next4 = iscc_hi_get_next_dist(&wa.edge_store1[2], wa.vertex_markers, 1);
-	assert_int_equal(next4->head, 2);
-	assert_double_equal(next4->distance, 103.030113);
-	assert_null(next4->next_dist);
-
-	assert_int_equal(wa.edge_store1[1].head, 4);
-	assert_double_equal(wa.edge_store1[1].distance, 72.125847);
-	assert_int_equal(wa.edge_store1[2].head, 10);
-	assert_double_equal(wa.edge_store1[2].distance, 76.285875);
-	assert_int_equal(wa.edge_store1[3].head, 8);
-	assert_double_equal(wa.edge_store1[3].distance, 82.249050);
-	assert_int_equal(wa.edge_store1[4].head, 2);
-	assert_double_equal(wa.edge_store1[4].distance, 103.030113);
-
-	assert_ptr_equal(wa.edge_store1[0].next_dist, &wa.edge_store1[1]);
-	assert_ptr_equal(wa.edge_store1[1].next_dist, &wa.edge_store1[2]);
-	assert_ptr_equal(wa.edge_store1[2].next_dist, &wa.edge_store1[4]);
-	assert_ptr_equal(wa.edge_store1[3].next_dist, &wa.edge_store1[4]);
-	assert_null(wa.edge_store1[4].next_dist);
+	wa.edge_list1.first = 2;
+	assert_int_equal(iscc_hi_get_next_dist(&wa.edge_list1, wa.vertex_markers, 1), 3);
+	assert_int_equal(wa.edge_list1.first, 3);
+
+	assert_int_equal(iscc_hi_get_next_dist(&wa.edge_list1, wa.vertex_markers, 1), 3);
+	assert_int_equal(wa.edge_list1.first, 3);
 
 	wa.vertex_markers[2] = 1;
 	wa.vertex_markers[10] = 1;
 
-	iscc_hi_DistanceEdge* next5 = iscc_hi_get_next_dist(wa.edge_store2, wa.vertex_markers, 1);
-	assert_int_equal(next5->head, 6);
-	assert_double_equal(next5->distance, 72.125847);
-	assert_ptr_equal(next5->next_dist, &wa.edge_store2[4]);
-
-	iscc_hi_DistanceEdge* next6 = iscc_hi_get_next_dist(wa.edge_store2, wa.vertex_markers, 1);
-	assert_int_equal(next6->head, 6);
-	assert_double_equal(next6->distance, 72.125847);
-	assert_ptr_equal(next6->next_dist, &wa.edge_store2[4]);
-
-	assert_int_equal(wa.edge_store2[1].head, 2);
-	assert_double_equal(wa.edge_store2[1].distance, 63.103580);
-	assert_int_equal(wa.edge_store2[2].head, 10);
-	assert_double_equal(wa.edge_store2[2].distance, 67.606177);
-	assert_int_equal(wa.edge_store2[3].head, 6);
-	assert_double_equal(wa.edge_store2[3].distance, 72.125847);
-	assert_int_equal(wa.edge_store2[4].head, 8);
-	assert_double_equal(wa.edge_store2[4].distance, 89.098152);
-
-	assert_ptr_equal(wa.edge_store2[0].next_dist, &wa.edge_store2[3]);
-	assert_ptr_equal(wa.edge_store2[1].next_dist, &wa.edge_store2[2]);
-	assert_ptr_equal(wa.edge_store2[2].next_dist, &wa.edge_store2[3]);
-	assert_ptr_equal(wa.edge_store2[3].next_dist, &wa.edge_store2[4]);
-	assert_null(wa.edge_store2[4].next_dist);
+	assert_int_equal(iscc_hi_get_next_dist(&wa.edge_list2, wa.vertex_markers, 1), 2);
+	assert_int_equal(wa.edge_list2.first, 2);
+
+	assert_int_equal(iscc_hi_get_next_dist(&wa.edge_list2, wa.vertex_markers, 1), 2);
+	assert_int_equal(wa.edge_list2.first, 2);
+
+	// Skipping points does not move them
+	for (size_t i = 0; i < 4; ++i) {
+		assert_int_equal(wa.edge_list1.heads[i], ref_heads1[i]);
+		assert_double_equal(wa.edge_list1.dists[i], ref_dists1[i]);
+		assert_int_equal(wa.edge_list2.heads[i], ref_heads2[i]);
+		assert_double_equal(wa.edge_list2.dists[i], ref_dists2[i]);
+	}
 
 	free(wa.dist_array);
 	free(wa.vertex_markers);
-	free(wa.edge_store1);
-	free(wa.edge_store2);
+	free(wa.edge_list1.heads);
+	free(wa.edge_list1.dists);
+	free(wa.edge_list2.heads);
+	free(wa.edge_list2.dists);
+	free(wa.heads_scratch);
+	free(wa.dists_scratch);
 }
 
 
@@ -842,7 +965,7 @@ void scc_ut_hi_move_point_to_cluster1(void** state)
 {
 	(void) state;
 
-	uint_fast16_t* vertex_markers = calloc(20, sizeof(uint_fast16_t));
+	uint16_t* vertex_markers = calloc(20, sizeof(uint16_t));
 	scc_PointIndex* members = calloc(20, sizeof(scc_PointIndex));
 	members[0] = 4;
 	members[1] = 1;
@@ -857,7 +980,7 @@ void scc_ut_hi_move_point_to_cluster1(void** state)
 		.members = members,
 	};
 
-	uint_fast16_t* ref_vertex_markers = calloc(20, sizeof(uint_fast16_t));
+	uint16_t* ref_vertex_markers = calloc(20, sizeof(uint16_t));
 	scc_PointIndex* ref_members = calloc(20, sizeof(scc_PointIndex));
 	ref_members[0] = 4;
 	ref_members[1] = 1;
@@ -870,7 +993,7 @@ void scc_ut_hi_move_point_to_cluster1(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, members);
 	assert_memory_equal(cl.members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 
 	ref_members[3] = 11;
@@ -880,7 +1003,7 @@ void scc_ut_hi_move_point_to_cluster1(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, members);
 	assert_memory_equal(cl.members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 	ref_members[4] = 3;
 	ref_vertex_markers[3] = 1;
@@ -889,7 +1012,7 @@ void scc_ut_hi_move_point_to_cluster1(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, members);
 	assert_memory_equal(cl.members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 	ref_members[5] = 6;
 	ref_vertex_markers[6] = 1;
@@ -898,7 +1021,7 @@ void scc_ut_hi_move_point_to_cluster1(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, members);
 	assert_memory_equal(cl.members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 	ref_members[6] = 10;
 	ref_vertex_markers[10] = 1;
@@ -907,7 +1030,7 @@ void scc_ut_hi_move_point_to_cluster1(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, members);
 	assert_memory_equal(cl.members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 	ref_members[7] = 14;
 	ref_vertex_markers[14] = 1;
@@ -916,7 +1039,7 @@ void scc_ut_hi_move_point_to_cluster1(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, members);
 	assert_memory_equal(cl.members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 	scc_PointIndex end_members[8] = { 4, 1, 2, 11, 3, 6, 10, 14 };
 	assert_int_equal(cl.size, 8);
@@ -934,7 +1057,7 @@ void scc_ut_hi_move_point_to_cluster2(void** state)
 {
 	(void) state;
 
-	uint_fast16_t* vertex_markers = calloc(20, sizeof(uint_fast16_t));
+	uint16_t* vertex_markers = calloc(20, sizeof(uint16_t));
 	scc_PointIndex* members = calloc(20, sizeof(scc_PointIndex));
 	members[19] = 4;
 	members[18] = 1;
@@ -949,7 +1072,7 @@ void scc_ut_hi_move_point_to_cluster2(void** state)
 		.members = &members[17],
 	};
 
-	uint_fast16_t* ref_vertex_markers = calloc(20, sizeof(uint_fast16_t));
+	uint16_t* ref_vertex_markers = calloc(20, sizeof(uint16_t));
 	scc_PointIndex* ref_members = calloc(20, sizeof(scc_PointIndex));
 	ref_members[19] = 4;
 	ref_members[18] = 1;
@@ -962,7 +1085,7 @@ void scc_ut_hi_move_point_to_cluster2(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, &members[17]);
 	assert_memory_equal(members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 
 	ref_members[16] = 11;
@@ -972,7 +1095,7 @@ void scc_ut_hi_move_point_to_cluster2(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, &members[16]);
 	assert_memory_equal(members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 	ref_members[15] = 3;
 	ref_vertex_markers[3] = 1;
@@ -981,7 +1104,7 @@ void scc_ut_hi_move_point_to_cluster2(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, &members[15]);
 	assert_memory_equal(members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 	ref_members[14] = 6;
 	ref_vertex_markers[6] = 1;
@@ -990,7 +1113,7 @@ void scc_ut_hi_move_point_to_cluster2(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, &members[14]);
 	assert_memory_equal(members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 	ref_members[13] = 10;
 	ref_vertex_markers[10] = 1;
@@ -999,7 +1122,7 @@ void scc_ut_hi_move_point_to_cluster2(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, &members[13]);
 	assert_memory_equal(members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 	ref_members[12] = 14;
 	ref_vertex_markers[14] = 1;
@@ -1008,7 +1131,7 @@ void scc_ut_hi_move_point_to_cluster2(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, &members[12]);
 	assert_memory_equal(members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 	scc_PointIndex end_members[8] = { 14, 10, 6, 3, 11, 2, 1, 4 };
 	assert_int_equal(cl.size, 8);
@@ -1026,7 +1149,7 @@ void scc_ut_hi_move_array_to_cluster1(void** state)
 {
 	(void) state;
 
-	uint_fast16_t* vertex_markers = calloc(20, sizeof(uint_fast16_t));
+	uint16_t* vertex_markers = calloc(20, sizeof(uint16_t));
 	scc_PointIndex* members = calloc(20, sizeof(scc_PointIndex));
 	members[0] = 4;
 	members[1] = 1;
@@ -1041,7 +1164,7 @@ void scc_ut_hi_move_array_to_cluster1(void** state)
 		.members = members,
 	};
 
-	uint_fast16_t* ref_vertex_markers = calloc(20, sizeof(uint_fast16_t));
+	uint16_t* ref_vertex_markers = calloc(20, sizeof(uint16_t));
 	scc_PointIndex* ref_members = calloc(20, sizeof(scc_PointIndex));
 	ref_members[0] = 4;
 	ref_members[1] = 1;
@@ -1054,7 +1177,7 @@ void scc_ut_hi_move_array_to_cluster1(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, members);
 	assert_memory_equal(cl.members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 	ref_members[3] = 11;
 	ref_members[4] = 3;
@@ -1066,7 +1189,7 @@ void scc_ut_hi_move_array_to_cluster1(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, members);
 	assert_memory_equal(cl.members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 	ref_members[5] = 6;
 	ref_vertex_markers[6] = 1;
@@ -1076,7 +1199,7 @@ void scc_ut_hi_move_array_to_cluster1(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, members);
 	assert_memory_equal(cl.members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 	ref_members[6] = 10;
 	ref_members[7] = 14;
@@ -1090,7 +1213,7 @@ void scc_ut_hi_move_array_to_cluster1(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, members);
 	assert_memory_equal(cl.members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 	scc_PointIndex end_members[9] = { 4, 1, 2, 11, 3, 6, 10, 14, 17 };
 	assert_int_equal(cl.size, 9);
@@ -1108,7 +1231,7 @@ void scc_ut_hi_move_array_to_cluster2(void** state)
 {
 	(void) state;
 
-	uint_fast16_t* vertex_markers = calloc(20, sizeof(uint_fast16_t));
+	uint16_t* vertex_markers = calloc(20, sizeof(uint16_t));
 	scc_PointIndex* members = calloc(20, sizeof(scc_PointIndex));
 	members[19] = 4;
 	members[18] = 1;
@@ -1123,7 +1246,7 @@ void scc_ut_hi_move_array_to_cluster2(void** state)
 		.members = &members[17],
 	};
 
-	uint_fast16_t* ref_vertex_markers = calloc(20, sizeof(uint_fast16_t));
+	uint16_t* ref_vertex_markers = calloc(20, sizeof(uint16_t));
 	scc_PointIndex* ref_members = calloc(20, sizeof(scc_PointIndex));
 	ref_members[19] = 4;
 	ref_members[18] = 1;
@@ -1136,7 +1259,7 @@ void scc_ut_hi_move_array_to_cluster2(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, &members[17]);
 	assert_memory_equal(members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 	ref_members[16] = 11;
 	ref_members[15] = 3;
@@ -1148,7 +1271,7 @@ void scc_ut_hi_move_array_to_cluster2(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, &members[15]);
 	assert_memory_equal(members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 	ref_members[14] = 6;
 	ref_vertex_markers[6] = 1;
@@ -1158,7 +1281,7 @@ void scc_ut_hi_move_array_to_cluster2(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, &members[14]);
 	assert_memory_equal(members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 	ref_members[13] = 10;
 	ref_members[12] = 14;
@@ -1172,7 +1295,7 @@ void scc_ut_hi_move_array_to_cluster2(void** state)
 	assert_int_equal(cl.marker, 1);
 	assert_ptr_equal(cl.members, &members[11]);
 	assert_memory_equal(members, ref_members, 20 * sizeof(scc_PointIndex));
-	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint_fast16_t));
+	assert_memory_equal(vertex_markers, ref_vertex_markers, 20 * sizeof(uint16_t));
 
 	scc_PointIndex end_members[9] = { 17, 14, 10, 6, 3, 11, 2, 1, 4 };
 	assert_int_equal(cl.size, 9);
@@ -1194,9 +1317,9 @@ void scc_ut_hi_find_centers(void** state)
 		.pointindex_array1 = malloc(sizeof(scc_PointIndex[100])),
 		.pointindex_array2 = malloc(sizeof(scc_PointIndex[100])),
 		.dist_array = malloc(sizeof(double[100])),
-		.vertex_markers = calloc(100, sizeof(uint_fast16_t)),
-		.edge_store1 = NULL,
-		.edge_store2 = NULL,
+		.vertex_markers = calloc(100, sizeof(uint16_t)),
+		.edge_list1 = { .heads = NULL, .dists = NULL },
+		.edge_list2 = { .heads = NULL, .dists = NULL },
 	};
 
 	scc_PointIndex ref_members1[10] = { 2, 4, 6, 8, 10, 12, 14, 16, 18, 20 };
@@ -1279,9 +1402,9 @@ void scc_ut_hi_find_centers_second(void** state)
 		.pointindex_array1 = malloc(sizeof(scc_PointIndex[100])),
 		.pointindex_array2 = malloc(sizeof(scc_PointIndex[100])),
 		.dist_array = malloc(sizeof(double[100])),
-		.vertex_markers = calloc(100, sizeof(uint_fast16_t)),
-		.edge_store1 = NULL,
-		.edge_store2 = NULL,
+		.vertex_markers = calloc(100, sizeof(uint16_t)),
+		.edge_list1 = { .heads = NULL, .dists = NULL },
+		.edge_list2 = { .heads = NULL, .dists = NULL },
 	};
 
 	scc_PointIndex members1[40] = { 34, 42, 78, 27, 99, 67, 29, 18, 92, 25,
@@ -1323,38 +1446,46 @@ void scc_ut_hi_populate_edge_lists(void** state)
 		.pointindex_array2 = NULL,
 		.dist_array = malloc(sizeof(double[8])),
 		.vertex_markers = NULL,
-		.edge_store1 = malloc(sizeof(iscc_hi_DistanceEdge[4])),
-		.edge_store2 = malloc(sizeof(iscc_hi_DistanceEdge[4])),
+		.edge_list1 = {
+			.heads = malloc(sizeof(scc_PointIndex[4])),
+			.dists = malloc(sizeof(double[4])),
+		},
+		.edge_list2 = {
+			.heads = malloc(sizeof(scc_PointIndex[4])),
+			.dists = malloc(sizeof(double[4])),
+		},
+		.heads_scratch = malloc(sizeof(scc_PointIndex[4])),
+		.dists_scratch = malloc(sizeof(double[4])),
 	};
 
 	scc_ErrorCode ec = iscc_hi_populate_edge_lists(&cl, scc_ut_test_data_large, 10, 5, &wa);
 	assert_int_equal(ec, SCC_ER_OK);
 
-	assert_int_equal(wa.edge_store1[1].head, 3);
-	assert_double_equal(wa.edge_store1[1].distance, 65.042314);
-	assert_int_equal(wa.edge_store1[2].head, 5);
-	assert_double_equal(wa.edge_store1[2].distance, 82.967209);
-	assert_int_equal(wa.edge_store1[3].head, 2);
-	assert_double_equal(wa.edge_store1[3].distance, 102.986773);
-	for (size_t i = 0; i < 3; ++i) {
-		assert_ptr_equal(wa.edge_store1[i].next_dist, &wa.edge_store1[i + 1]);
-    }
-    assert_null(wa.edge_store1[3].next_dist);
-
-	assert_int_equal(wa.edge_store2[1].head, 2);
-	assert_double_equal(wa.edge_store2[1].distance, 21.423179);
-	assert_int_equal(wa.edge_store2[2].head, 3);
-	assert_double_equal(wa.edge_store2[2].distance, 52.901061);
-	assert_int_equal(wa.edge_store2[3].head, 10);
-	assert_double_equal(wa.edge_store2[3].distance, 82.967209);
-	for (size_t i = 0; i < 3; ++i) {
-		assert_ptr_equal(wa.edge_store2[i].next_dist, &wa.edge_store2[i + 1]);
-    }
-    assert_null(wa.edge_store2[3].next_dist);
+	assert_int_equal(wa.edge_list1.first, 0);
+	assert_int_equal(wa.edge_list1.len, 3);
+	assert_int_equal(wa.edge_list1.heads[0], 3);
+	assert_double_equal(wa.edge_list1.dists[0], 65.042314);
+	assert_int_equal(wa.edge_list1.heads[1], 5);
+	assert_double_equal(wa.edge_list1.dists[1], 82.967209);
+	assert_int_equal(wa.edge_list1.heads[2], 2);
+	assert_double_equal(wa.edge_list1.dists[2], 102.986773);
+
+	assert_int_equal(wa.edge_list2.first, 0);
+	assert_int_equal(wa.edge_list2.len, 3);
+	assert_int_equal(wa.edge_list2.heads[0], 2);
+	assert_double_equal(wa.edge_list2.dists[0], 21.423179);
+	assert_int_equal(wa.edge_list2.heads[1], 3);
+	assert_double_equal(wa.edge_list2.dists[1], 52.901061);
+	assert_int_equal(wa.edge_list2.heads[2], 10);
+	assert_double_equal(wa.edge_list2.dists[2], 82.967209);
 
     free(wa.dist_array);
-    free(wa.edge_store1);
-    free(wa.edge_store2);
+    free(wa.edge_list1.heads);
+    free(wa.edge_list1.dists);
+    free(wa.edge_list2.heads);
+    free(wa.edge_list2.dists);
+    free(wa.heads_scratch);
+    free(wa.dists_scratch);
 }
 
 
@@ -1372,61 +1503,76 @@ void scc_ut_hi_sort_edge_list(void** state)
 
 	double output_dists[10] = { 10.4, 1.4, 6.2, 5.2, 0.0, 1.2, 9.5, 3.3, 9.6, 3.1 };
 
-	iscc_hi_DistanceEdge* const edge_store = malloc(sizeof(iscc_hi_DistanceEdge[10]));
-
-	iscc_hi_sort_edge_list(&ci, 9, output_dists, edge_store);
-
-	assert_int_equal(edge_store[1].head, 4);
-	assert_double_equal(edge_store[1].distance, 1.2);
-	assert_int_equal(edge_store[2].head, 6);
-	assert_double_equal(edge_store[2].distance, 1.4);
-	assert_int_equal(edge_store[3].head, 14);
-	assert_double_equal(edge_store[3].distance, 3.1);
-	assert_int_equal(edge_store[4].head, 12);
-	assert_double_equal(edge_store[4].distance, 3.3);
-	assert_int_equal(edge_store[5].head, 8);
-	assert_double_equal(edge_store[5].distance, 5.2);
-	assert_int_equal(edge_store[6].head, 3);
-	assert_double_equal(edge_store[6].distance, 6.2);
-	assert_int_equal(edge_store[7].head, 10);
-	assert_double_equal(edge_store[7].distance, 9.5);
-	assert_int_equal(edge_store[8].head, 13);
-	assert_double_equal(edge_store[8].distance, 9.6);
-	assert_int_equal(edge_store[9].head, 1);
-	assert_double_equal(edge_store[9].distance, 10.4);
+	iscc_hi_EdgeList edge_list = {
+		.heads = malloc(sizeof(scc_PointIndex[10])),
+		.dists = malloc(sizeof(double[10])),
+	};
+
+	iscc_hi_sort_edge_list(&ci, 9, output_dists, &edge_list, NULL, NULL);
 
+	const scc_PointIndex ref_heads[9] = { 4, 6, 14, 12, 8, 3, 10, 13, 1 };
+	const double ref_dists[9] = { 1.2, 1.4, 3.1, 3.3, 5.2, 6.2, 9.5, 9.6, 10.4 };
+
+	assert_int_equal(edge_list.first, 0);
+	assert_int_equal(edge_list.len, 9);
 	for (size_t i = 0; i < 9; ++i) {
-		assert_ptr_equal(edge_store[i].next_dist, &edge_store[i + 1]);
-    }
-    assert_null(edge_store[9].next_dist);
+		assert_int_equal(edge_list.heads[i], ref_heads[i]);
+		assert_double_equal(edge_list.dists[i], ref_dists[i]);
+	}
 
-    free(edge_store);
+	free(edge_list.heads);
+	free(edge_list.dists);
 }
 
 
-void scc_ut_hi_compare_dist_edges(void** state)
+void scc_ut_hi_sort_edge_list_radix(void** state)
 {
 	(void) state;
 
-	iscc_hi_DistanceEdge d1 = {
-		.head = 1,
-		.distance = 0.5,
-		.next_dist = NULL,
-	};
-	iscc_hi_DistanceEdge d2 = {
-		.head = 2,
-		.distance = 0.5,
-		.next_dist = NULL,
+	scc_PointIndex mem[1000];
+	double output_dists[1000];
+	for (size_t i = 0; i < 1000; ++i) {
+		mem[i] = (scc_PointIndex) (3 * i);
+		output_dists[i] = (i % 7 == 0) ? 2.0e6 * (double) (rand() % 5) : 0.25 * (double) (rand() % 50);
+	}
+	output_dists[10] = -0.0;
+	output_dists[20] = 0.0;
+	output_dists[30] = -0.0;
+
+	iscc_hi_ClusterItem ci = {
+		.size = 1000,
+		.marker = 0,
+		.members = mem,
 	};
-	iscc_hi_DistanceEdge d3 = {
-		.head = 3,
-		.distance = 2.5,
-		.next_dist = NULL,
+
+	iscc_hi_EdgeList edge_list = {
+		.heads = malloc(sizeof(scc_PointIndex[1000])),
+		.dists = malloc(sizeof(double[1000])),
 	};
+	scc_PointIndex* const heads_scratch = malloc(sizeof(scc_PointIndex[999]));
+	double* const dists_scratch = malloc(sizeof(double[999]));
+
+	iscc_hi_sort_edge_list(&ci, 15, output_dists, &edge_list, heads_scratch, dists_scratch);
+
+	assert_int_equal(edge_list.first, 0);
+	assert_int_equal(edge_list.len, 999);
+
+	// Sorted by distance, and ties keep the order of the members
+	for (size_t i = 0; i < 998; ++i) {
+		assert_true(edge_list.dists[i] <= edge_list.dists[i + 1]);
+		if (!(edge_list.dists[i] < edge_list.dists[i + 1])) {
+			assert_true(edge_list.heads[i] < edge_list.heads[i + 1]);
+		}
+	}
+	for (size_t i = 0; i < 999; ++i) {
+		assert_int_not_equal(edge_list.heads[i], 15);
+		assert_double_equal(edge_list.dists[i], output_dists[edge_list.heads[i] / 3]);
+	}
 
-	assert_int_equal(iscc_hi_compare_dist_edges(&d1, &d2), 0);
-	assert_int_equal(iscc_hi_compare_dist_edges(&d1, &d3), -1);
-	assert_int_equal(iscc_hi_compare_dist_edges(&d3, &d2), 1);
+	free(edge_list.heads);
+	free(edge_list.dists);
+	free(heads_scratch);
+	free(dists_scratch);
 }
 
 
@@ -1439,8 +1585,8 @@ int main(void)
 		cmocka_unit_test(scc_ut_hi_init_cl_stack),
 		cmocka_unit_test(scc_ut_hi_push_to_stack),
 		cmocka_unit_test(scc_ut_hi_get_next_marker),
-		cmocka_unit_test(scc_ut_hi_compare_dist_edges),
 		cmocka_unit_test(scc_ut_hi_sort_edge_list),
+		cmocka_unit_test(scc_ut_hi_sort_edge_list_radix),
 		cmocka_unit_test(scc_ut_hi_populate_edge_lists),
 		cmocka_unit_test(scc_ut_hi_get_next_dist),
 		cmocka_unit_test(scc_ut_hi_get_next_k_nn),
@@ -1452,6 +1598,7 @@ int main(void)
 		cmocka_unit_test(scc_ut_hi_find_centers_second),
 		cmocka_unit_test(scc_ut_hi_break_cluster_into_two),
 		cmocka_unit_test(scc_ut_hi_run_hierarchical_clustering),
+		cmocka_unit_test(scc_ut_hi_run_parallel_hierarchical_clustering),
 	};
 
 	return cmocka_run_group_tests_name("internal hierarchical_clustering.c", test_cases, NULL, NULL);
@@ -25,7 +25,7 @@
 #include "data_object_test.h"
 
 
-static const int32_t ISCC_UT_OPTIONS_STRUCT_VERSION = 722678001;
+static const int32_t ISCC_UT_OPTIONS_STRUCT_VERSION = 722678002;
 
 
 void iscc_run_nonval_tests(scc_SeedMethod seed_method,
@@ -6690,6 +6690,47 @@ void scc_ut_nng_clustering_with_types_nonval(void** state)
 }
 
 
+void scc_ut_nng_clustering_compressed(void** state)
+{
+	(void) state;
+
+	const scc_SeedMethod seed_methods[7] = { SCC_SM_LEXICAL, SCC_SM_INWARDS_ORDER, SCC_SM_EXCLUSION_ORDER,
+	                                         SCC_SM_INWARDS_PARALLEL, SCC_SM_EXCLUSION_PARALLEL,
+	                                         SCC_SM_INWARDS_UPDATING, SCC_SM_EXCLUSION_UPDATING };
+	const scc_UnassignedMethod unassigned_methods[3] = { SCC_UM_IGNORE, SCC_UM_CLOSEST_ASSIGNED, SCC_UM_CLOSEST_SEED };
+
+	for (size_t m = 0; m < 7; ++m) {
+		for (size_t u = 0; u < 3; ++u) {
+			scc_ClusterOptions options = scc_get_default_options();
+			options.size_constraint = 3;
+			options.seed_method = seed_methods[m];
+			options.primary_unassigned_method = unassigned_methods[u];
+
+			scc_Clustering* cl1;
+			scc_Clustering* cl2;
+			scc_init_empty_clustering(100, NULL, &cl1);
+			scc_init_empty_clustering(100, NULL, &cl2);
+			assert_int_equal(scc_sc_clustering(&scc_ut_test_data_large_struct, &options, cl1), SCC_ER_OK);
+			options.compress_digraphs = true;
+			assert_int_equal(scc_sc_clustering(&scc_ut_test_data_large_struct, &options, cl2), SCC_ER_OK);
+
+			// Seeds do not depend on the order of the arcs unless the counts are updated
+			if ((m < 5) && (unassigned_methods[u] != SCC_UM_CLOSEST_ASSIGNED)) {
+				assert_int_equal(cl1->num_clusters, cl2->num_clusters);
+				assert_memory_equal(cl1->cluster_label, cl2->cluster_label, 100 * sizeof(scc_Clabel));
+			}
+
+			bool cl_is_OK;
+			assert_int_equal(scc_check_clustering(cl2, &options, &cl_is_OK), SCC_ER_OK);
+			assert_true(cl_is_OK);
+
+			scc_free_clustering(&cl1);
+			scc_free_clustering(&cl2);
+		}
+	}
+}
+
+
 int main(void)
 {
 	if(!scc_ut_init_tests()) return 1;
@@ -6699,6 +6740,7 @@ int main(void)
 		cmocka_unit_test(scc_ut_nng_clustering_nonval),
 		cmocka_unit_test(scc_ut_nng_clustering_with_types),
 		cmocka_unit_test(scc_ut_nng_clustering_with_types_nonval),
+		cmocka_unit_test(scc_ut_nng_clustering_compressed),
 	};
 
 	return cmocka_run_group_tests_name("nng_clustering.c", test_cases, NULL, NULL);
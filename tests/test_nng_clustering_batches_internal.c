@@ -19,13 +19,17 @@
  * ========================================================================== */
 
 #include "init_test.h"
+#include <stdlib.h>
+#include <string.h>
 #include <include/scclust.h>
+#include <include/scclust_spi.h>
 #include <src/clustering_struct.h>
+#include <src/dist_search_imp.h>
 #include <src/nng_batch_clustering.h>
 #include <src/scclust_types.h>
 #include "data_object_test.h"
 
-static const int32_t ISCC_UT_OPTIONS_STRUCT_VERSION = 722678001;
+static const int32_t ISCC_UT_OPTIONS_STRUCT_VERSION = 722678002;
 
 void iscc_run_nonval_tests_batches(scc_UnassignedMethod unassigned_method,
                                    bool radius_constraint,
@@ -144,65 +148,65 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 3,
-	                                SCC_UM_IGNORE, false, 0.0, 0, NULL, 10);
+	                                SCC_UM_IGNORE, false, 0.0, 0, NULL, 10, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	scc_free_clustering(&cl);
 
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 3,
-	                                SCC_UM_IGNORE, false, 0.0, 0, NULL, 10);
+	                                SCC_UM_IGNORE, false, 0.0, 0, NULL, 10, 1);
 	assert_int_equal(ec, SCC_ER_INVALID_INPUT);
 
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_small_struct, 3,
-	                                SCC_UM_IGNORE, false, 0.0, 0, NULL, 10);
+	                                SCC_UM_IGNORE, false, 0.0, 0, NULL, 10, 1);
 	assert_int_equal(ec, SCC_ER_INVALID_INPUT);
 	scc_free_clustering(&cl);
 
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 1,
-	                                SCC_UM_IGNORE, false, 0.0, 0, NULL, 10);
+	                                SCC_UM_IGNORE, false, 0.0, 0, NULL, 10, 1);
 	assert_int_equal(ec, SCC_ER_INVALID_INPUT);
 	scc_free_clustering(&cl);
 
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 101,
-	                                SCC_UM_IGNORE, false, 0.0, 0, NULL, 10);
+	                                SCC_UM_IGNORE, false, 0.0, 0, NULL, 10, 1);
 	assert_int_equal(ec, SCC_ER_NO_SOLUTION);
 	scc_free_clustering(&cl);
 
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 3,
-	                                100, false, 0.0, 0, NULL, 10);
+	                                100, false, 0.0, 0, NULL, 10, 1);
 	assert_int_equal(ec, SCC_ER_INVALID_INPUT);
 	scc_free_clustering(&cl);
 
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 3,
-	                                SCC_UM_CLOSEST_ASSIGNED, false, 0.0, 0, NULL, 10);
+	                                SCC_UM_CLOSEST_ASSIGNED, false, 0.0, 0, NULL, 10, 1);
 	assert_int_equal(ec, SCC_ER_INVALID_INPUT);
 	scc_free_clustering(&cl);
 
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 3,
-	                                SCC_UM_CLOSEST_SEED, false, 0.0, 0, NULL, 10);
+	                                SCC_UM_CLOSEST_SEED, false, 0.0, 0, NULL, 10, 1);
 	assert_int_equal(ec, SCC_ER_INVALID_INPUT);
 	scc_free_clustering(&cl);
 
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 3,
-	                                SCC_UM_IGNORE, true, 0.0, 0, NULL, 10);
+	                                SCC_UM_IGNORE, true, 0.0, 0, NULL, 10, 1);
 	assert_int_equal(ec, SCC_ER_INVALID_INPUT);
 	scc_free_clustering(&cl);
 
 	scc_init_existing_clustering(100, 10, external_cluster_labels, false, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 3,
-	                                SCC_UM_IGNORE, false, 0.0, 0, NULL, 10);
+	                                SCC_UM_IGNORE, false, 0.0, 0, NULL, 10, 1);
 	assert_int_equal(ec, SCC_ER_NOT_IMPLEMENTED);
 	scc_free_clustering(&cl);
 
 	scc_init_empty_clustering(100, NULL, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 3,
-	                                SCC_UM_IGNORE, true, 1.0, 0, NULL, 10);
+	                                SCC_UM_IGNORE, true, 1.0, 0, NULL, 10, 1);
 	assert_int_equal(ec, SCC_ER_NO_SOLUTION);
 	scc_free_clustering(&cl);
 
@@ -214,7 +218,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 3,
 	                                SCC_UM_IGNORE, false, 0.0,
-	                                0, NULL, 0);
+	                                0, NULL, 0, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -244,7 +248,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 2,
 	                                SCC_UM_IGNORE, false, 0.0,
-	                                0, NULL, 10);
+	                                0, NULL, 10, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -274,7 +278,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 10,
 	                                SCC_UM_IGNORE, false, 0.0,
-	                                0, NULL, 1);
+	                                0, NULL, 1, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -306,7 +310,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 3,
 	                                SCC_UM_ANY_NEIGHBOR, false, 0.0,
-	                                0, NULL, 0);
+	                                0, NULL, 0, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -326,7 +330,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 2,
 	                                SCC_UM_ANY_NEIGHBOR, false, 0.0,
-	                                0, NULL, 10);
+	                                0, NULL, 10, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -346,7 +350,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 10,
 	                                SCC_UM_ANY_NEIGHBOR, false, 0.0,
-	                                0, NULL, 1);
+	                                0, NULL, 1, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -368,7 +372,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 3,
 	                                SCC_UM_IGNORE, true, 20.0,
-	                                0, NULL, 0);
+	                                0, NULL, 0, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -398,7 +402,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 2,
 	                                SCC_UM_IGNORE, true, 20.0,
-	                                0, NULL, 10);
+	                                0, NULL, 10, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -428,7 +432,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 10,
 	                                SCC_UM_IGNORE, true, 30.0,
-	                                0, NULL, 1);
+	                                0, NULL, 1, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -460,7 +464,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 3,
 	                                SCC_UM_ANY_NEIGHBOR, true, 20.0,
-	                                0, NULL, 0);
+	                                0, NULL, 0, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -480,7 +484,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 2,
 	                                SCC_UM_ANY_NEIGHBOR, true, 20.0,
-	                                0, NULL, 10);
+	                                0, NULL, 10, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -500,7 +504,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 10,
 	                                SCC_UM_ANY_NEIGHBOR, true, 30.0,
-	                                0, NULL, 1);
+	                                0, NULL, 1, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -522,7 +526,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 3,
 	                                SCC_UM_IGNORE, false, 0.0,
-	                                len_primary_data_points, primary_data_points, 0);
+	                                len_primary_data_points, primary_data_points, 0, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -552,7 +556,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 2,
 	                                SCC_UM_IGNORE, false, 0.0,
-	                                len_primary_data_points, primary_data_points, 10);
+	                                len_primary_data_points, primary_data_points, 10, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -582,7 +586,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 10,
 	                                SCC_UM_IGNORE, false, 0.0,
-	                                len_primary_data_points, primary_data_points, 1);
+	                                len_primary_data_points, primary_data_points, 1, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -614,7 +618,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 3,
 	                                SCC_UM_ANY_NEIGHBOR, false, 0.0,
-	                                len_primary_data_points, primary_data_points, 0);
+	                                len_primary_data_points, primary_data_points, 0, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -634,7 +638,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 2,
 	                                SCC_UM_ANY_NEIGHBOR, false, 0.0,
-	                                len_primary_data_points, primary_data_points, 10);
+	                                len_primary_data_points, primary_data_points, 10, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -654,7 +658,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 10,
 	                                SCC_UM_ANY_NEIGHBOR, false, 0.0,
-	                                len_primary_data_points, primary_data_points, 1);
+	                                len_primary_data_points, primary_data_points, 1, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -676,7 +680,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 3,
 	                                SCC_UM_IGNORE, true, 20.0,
-	                                len_primary_data_points, primary_data_points, 0);
+	                                len_primary_data_points, primary_data_points, 0, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -706,7 +710,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 2,
 	                                SCC_UM_IGNORE, true, 20.0,
-	                                len_primary_data_points, primary_data_points, 10);
+	                                len_primary_data_points, primary_data_points, 10, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -736,7 +740,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 10,
 	                                SCC_UM_IGNORE, true, 30.0,
-	                                len_primary_data_points, primary_data_points, 1);
+	                                len_primary_data_points, primary_data_points, 1, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -768,7 +772,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 3,
 	                                SCC_UM_ANY_NEIGHBOR, true, 20.0,
-	                                len_primary_data_points, primary_data_points, 0);
+	                                len_primary_data_points, primary_data_points, 0, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -788,7 +792,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 2,
 	                                SCC_UM_ANY_NEIGHBOR, true, 20.0,
-	                                len_primary_data_points, primary_data_points, 10);
+	                                len_primary_data_points, primary_data_points, 10, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -808,7 +812,7 @@ void scc_ut_nng_clustering_batches_internal(void** state)
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 10,
 	                                SCC_UM_ANY_NEIGHBOR, true, 30.0,
-	                                len_primary_data_points, primary_data_points, 1);
+	                                len_primary_data_points, primary_data_points, 1, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -845,6 +849,125 @@ void scc_ut_nng_clustering_batches_nonval_internal(void** state)
 }
 
 
+void scc_ut_nng_clustering_batches_pipelined(void** state)
+{
+	(void) state;
+
+	// Coarse grid with many ties, compared with the serial batches
+	double* const coords = malloc(sizeof(double[4000]));
+	for (size_t i = 0; i < 4000; ++i) {
+		coords[i] = (double) (rand() % 30);
+	}
+	scc_DataSet* data_set;
+	assert_int_equal(scc_init_data_set(2000, 2, 4000, coords, &data_set), SCC_ER_OK);
+
+	scc_PointIndex primary_data_points[1000];
+	for (size_t i = 0; i < 1000; ++i) {
+		primary_data_points[i] = (scc_PointIndex) (2 * i + (size_t) (rand() % 2));
+	}
+
+	const uint32_t batch_sizes[4] = { 1, 37, 500, 0 };
+	for (size_t b = 0; b < 4; ++b) {
+		for (int unassigned = 0; unassigned < 2; ++unassigned) {
+			for (int radius_constraint = 0; radius_constraint < 2; ++radius_constraint) {
+				for (int primary = 0; primary < 2; ++primary) {
+					const scc_UnassignedMethod unassigned_method = unassigned ? SCC_UM_ANY_NEIGHBOR : SCC_UM_IGNORE;
+					const size_t len_primary = primary ? 1000 : 0;
+					const scc_PointIndex* const primary_points = primary ? primary_data_points : NULL;
+
+					scc_Clustering* cl_serial;
+					scc_init_empty_clustering(2000, NULL, &cl_serial);
+					assert_int_equal(scc_nng_clustering_batches(cl_serial, data_set, 4,
+					                                            unassigned_method, (radius_constraint == 1), 2.0,
+					                                            len_primary, primary_points, batch_sizes[b], 1), SCC_ER_OK);
+
+					scc_Clustering* cl_pipelined;
+					scc_init_empty_clustering(2000, NULL, &cl_pipelined);
+					assert_int_equal(scc_nng_clustering_batches(cl_pipelined, data_set, 4,
+					                                            unassigned_method, (radius_constraint == 1), 2.0,
+					                                            len_primary, primary_points, batch_sizes[b], 4), SCC_ER_OK);
+
+					assert_int_equal(cl_serial->num_clusters, cl_pipelined->num_clusters);
+					assert_memory_equal(cl_serial->cluster_label, cl_pipelined->cluster_label, 2000 * sizeof(scc_Clabel));
+
+					scc_free_clustering(&cl_serial);
+					scc_free_clustering(&cl_pipelined);
+				}
+			}
+		}
+	}
+
+	scc_free_data_set(&data_set);
+	free(coords);
+}
+
+
+static bool scc_ut_failing_nearest_neighbor_search(iscc_NNSearchObject* const nn_search_object,
+                                                   const size_t len_query_indices,
+                                                   const scc_PointIndex query_indices[const],
+                                                   const uint32_t k,
+                                                   const bool radius_search,
+                                                   const double radius,
+                                                   size_t* const out_num_ok_queries,
+                                                   scc_PointIndex out_query_indices[const],
+                                                   scc_PointIndex out_nn_indices[const])
+{
+	(void) nn_search_object;
+	(void) len_query_indices;
+	(void) query_indices;
+	(void) k;
+	(void) radius_search;
+	(void) radius;
+	(void) out_num_ok_queries;
+	(void) out_query_indices;
+	(void) out_nn_indices;
+	return false;
+}
+
+
+void scc_ut_nng_clustering_batches_pipelined_error(void** state)
+{
+	(void) state;
+
+	const scc_DistFunctions dist_functions = {
+		.check_data_set = iscc_imp_check_data_set,
+		.num_data_points = iscc_imp_num_data_points,
+		.get_dist_matrix = iscc_imp_get_dist_matrix,
+		.get_dist_rows = iscc_imp_get_dist_rows,
+		.init_max_dist_object = iscc_imp_init_max_dist_object,
+		.get_max_dist = iscc_imp_get_max_dist,
+		.close_max_dist_object = iscc_imp_close_max_dist_object,
+		.init_nn_search_object = iscc_imp_init_nn_search_object,
+		.nearest_neighbor_search = scc_ut_failing_nearest_neighbor_search,
+		.close_nn_search_object = iscc_imp_close_nn_search_object,
+	};
+
+	scc_DataSet* data_set;
+	assert_int_equal(scc_init_custom_data_set(&dist_functions, scc_ut_test_data_large, &data_set), SCC_ER_OK);
+
+	char error_message[255];
+	scc_Clustering* cl;
+	scc_init_empty_clustering(100, NULL, &cl);
+
+	// Earlier error on the calling thread that must be replaced
+	assert_int_equal(scc_nng_clustering_batches(cl, data_set, 1,
+	                                            SCC_UM_IGNORE, false, 0.0,
+	                                            0, NULL, 10, 4), SCC_ER_INVALID_INPUT);
+	assert_true(scc_get_latest_error(255, error_message));
+	assert_non_null(strstr(error_message, "Size constraint must be 2 or greater."));
+
+	assert_int_equal(scc_nng_clustering_batches(cl, data_set, 3,
+	                                            SCC_UM_IGNORE, false, 0.0,
+	                                            0, NULL, 10, 4), SCC_ER_DIST_SEARCH_ERROR);
+	assert_true(scc_get_latest_error(255, error_message));
+	assert_non_null(strstr(error_message, "nng_batch_clustering.c"));
+	assert_non_null(strstr(error_message, "Failed to calculate distances."));
+
+	scc_free_clustering(&cl);
+	scc_free_data_set(&data_set);
+}
+
+
 int main(void)
 {
 	if(!scc_ut_init_tests()) return 1;
@@ -852,6 +975,8 @@ int main(void)
 	const struct CMUnitTest test_cases[] = {
 		cmocka_unit_test(scc_ut_nng_clustering_batches_internal),
 		cmocka_unit_test(scc_ut_nng_clustering_batches_nonval_internal),
+		cmocka_unit_test(scc_ut_nng_clustering_batches_pipelined),
+		cmocka_unit_test(scc_ut_nng_clustering_batches_pipelined_error),
 	};
 
 	return cmocka_run_group_tests_name("nng_clustering_batches_internal.c", test_cases, NULL, NULL);
@@ -873,7 +998,7 @@ void iscc_run_nonval_tests_batches(const scc_UnassignedMethod unassigned_method,
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 3,
 	                                unassigned_method, radius_constraint, radius,
-	                                len_primary_data_points, primary_data_points, 10);
+	                                len_primary_data_points, primary_data_points, 10, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -889,7 +1014,7 @@ void iscc_run_nonval_tests_batches(const scc_UnassignedMethod unassigned_method,
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 3,
 	                                unassigned_method, radius_constraint, radius,
-	                                len_primary_data_points, primary_data_points, 0);
+	                                len_primary_data_points, primary_data_points, 0, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -905,7 +1030,7 @@ void iscc_run_nonval_tests_batches(const scc_UnassignedMethod unassigned_method,
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 3,
 	                                unassigned_method, radius_constraint, radius,
-	                                len_primary_data_points, primary_data_points, 1);
+	                                len_primary_data_points, primary_data_points, 1, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -921,7 +1046,7 @@ void iscc_run_nonval_tests_batches(const scc_UnassignedMethod unassigned_method,
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 2,
 	                                unassigned_method, radius_constraint, radius,
-	                                len_primary_data_points, primary_data_points, 10);
+	                                len_primary_data_points, primary_data_points, 10, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -937,7 +1062,7 @@ void iscc_run_nonval_tests_batches(const scc_UnassignedMethod unassigned_method,
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 2,
 	                                unassigned_method, radius_constraint, radius,
-	                                len_primary_data_points, primary_data_points, 0);
+	                                len_primary_data_points, primary_data_points, 0, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -953,7 +1078,7 @@ void iscc_run_nonval_tests_batches(const scc_UnassignedMethod unassigned_method,
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 2,
 	                                unassigned_method, radius_constraint, radius,
-	                                len_primary_data_points, primary_data_points, 1);
+	                                len_primary_data_points, primary_data_points, 1, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -969,7 +1094,7 @@ void iscc_run_nonval_tests_batches(const scc_UnassignedMethod unassigned_method,
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 10,
 	                                unassigned_method, radius_constraint, radius,
-	                                len_primary_data_points, primary_data_points, 10);
+	                                len_primary_data_points, primary_data_points, 10, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -985,7 +1110,7 @@ void iscc_run_nonval_tests_batches(const scc_UnassignedMethod unassigned_method,
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 10,
 	                                unassigned_method, radius_constraint, radius,
-	                                len_primary_data_points, primary_data_points, 0);
+	                                len_primary_data_points, primary_data_points, 0, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -1001,7 +1126,7 @@ void iscc_run_nonval_tests_batches(const scc_UnassignedMethod unassigned_method,
 	scc_init_empty_clustering(100, external_cluster_labels, &cl);
 	ec = scc_nng_clustering_batches(cl, &scc_ut_test_data_large_struct, 10,
 	                                unassigned_method, radius_constraint, radius,
-	                                len_primary_data_points, primary_data_points, 1);
+	                                len_primary_data_points, primary_data_points, 1, 1);
 	assert_int_equal(ec, SCC_ER_OK);
 	assert_int_equal(cl->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl->num_data_points, 100);
@@ -24,7 +24,7 @@
 #include "data_object_test.h"
 
 
-#define ISCC_UT_OPTIONS_STRUCT_VERSION 722678001
+#define ISCC_UT_OPTIONS_STRUCT_VERSION 722678002
 
 static scc_ClusterOptions iscc_translate_options(const uint32_t size_constraint,
                                                  const scc_SeedMethod seed_method,
@@ -95,7 +95,7 @@ void scc_ut_make_clustering_from_nng(void** state)
 	                                                  SCC_UM_CLOSEST_ASSIGNED, false, 0.0, false,
 	                                                  10, primary_data_points, SCC_UM_IGNORE, false, 0.0);
 	scc_ErrorCode ec1 = iscc_make_clustering_from_nng(cl1, &scc_ut_test_data_small_struct,
-	                                                  &nng1, &options);
+	                                                  &nng1, &options, NULL);
 	const scc_Clabel ref_cluster_label1[15] = { 0, 0, 1, 1, 2,   M, 0, M, 2, M,   1, 1, 2, 1, 0 };
 	assert_int_equal(ec1, SCC_ER_OK);
 	assert_int_equal(cl1->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -134,7 +134,7 @@ void scc_ut_make_clustering_from_nng(void** state)
 	                                                  SCC_UM_CLOSEST_ASSIGNED, false, 0.0, false,
 	                                                  10, primary_data_points, SCC_UM_IGNORE, false, 0.0);
 	scc_ErrorCode ec2 = iscc_make_clustering_from_nng(cl2, &scc_ut_test_data_small_struct,
-	                                                  &nng2, &options);
+	                                                  &nng2, &options, NULL);
 	const scc_Clabel ref_cluster_label2[15] = { 0, 0, 1, 1, 2,   M, 0, M, 2, M,   1, 1, 2, 1, 0 };
 	assert_int_equal(ec2, SCC_ER_OK);
 	assert_int_equal(cl2->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -171,7 +171,7 @@ void scc_ut_make_clustering_from_nng(void** state)
 	                                                  SCC_UM_CLOSEST_SEED, false, 0.0, SCC_RM_USE_ESTIMATED,
 	                                                  10, primary_data_points, SCC_UM_CLOSEST_SEED, SCC_RM_USE_ESTIMATED, 0.0);
 	scc_ErrorCode ec3 = iscc_make_clustering_from_nng(cl3, &scc_ut_test_data_small_struct,
-	                                                  &nng3, &options);
+	                                                  &nng3, &options, NULL);
 	const scc_Clabel ref_cluster_label3[15] = { 0, 0, 1, 1, 2,   1, 0, 0, 2, 1,   1, M, 2, 1, 2 };
 	assert_int_equal(ec3, SCC_ER_OK);
 	assert_int_equal(cl3->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -208,7 +208,7 @@ void scc_ut_make_clustering_from_nng(void** state)
 	                                                  SCC_UM_CLOSEST_ASSIGNED, false, 0.0, false,
 	                                                  10, primary_data_points, SCC_UM_CLOSEST_SEED, SCC_RM_USE_ESTIMATED, 0.0);
 	scc_ErrorCode ec4 = iscc_make_clustering_from_nng(cl4, &scc_ut_test_data_small_struct,
-	                                                  &nng4, &options);
+	                                                  &nng4, &options, NULL);
 	const scc_Clabel ref_cluster_label4[15] = { 0, 0, 1, 1, 2,   1, 0, 0, 2, 1,   1, 1, 2, 1, 0 };
 	assert_int_equal(ec4, SCC_ER_OK);
 	assert_int_equal(cl4->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -245,7 +245,7 @@ void scc_ut_make_clustering_from_nng(void** state)
 	                                                  SCC_UM_CLOSEST_SEED, false, 0.0, SCC_RM_USE_ESTIMATED,
 	                                                  10, primary_data_points, SCC_UM_IGNORE, false, 0.0);
 	scc_ErrorCode ec5 = iscc_make_clustering_from_nng(cl5, &scc_ut_test_data_small_struct,
-	                                                  &nng5, &options);
+	                                                  &nng5, &options, NULL);
 	const scc_Clabel ref_cluster_label5[15] = { 0, 0, 1, 1, 2,   M, 0, M, 2, M,   1, M, 2, 1, 2 };
 	assert_int_equal(ec5, SCC_ER_OK);
 	assert_int_equal(cl5->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
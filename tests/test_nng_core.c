@@ -24,7 +24,9 @@
 #include <stdlib.h>
 #include <src/clustering_struct.h>
 #include <src/digraph_debug.h>
+#include <src/dist_search.h>
 #include <src/nng_core.h>
+#include <src/nng_findseeds.h>
 #include "assert_digraph.h"
 #include "data_object_test.h"
 #include "double_assert.h"
@@ -38,7 +40,7 @@ void scc_ut_get_nng_with_size_constraint(void** state)
 
 	iscc_Digraph out_nng1;
 	scc_ErrorCode ec1 = iscc_get_nng_with_size_constraint(&scc_ut_test_data_small_struct,
-	                                                      15, 3, 0, NULL, false, 0.0, &out_nng1);
+	                                                      15, 3, 0, NULL, false, 0.0, 1, NULL, &out_nng1);
 	iscc_Digraph ref_nng1;
 	iscc_digraph_from_string("..... ..##. ...../"
 	                         "....# ..#.. ...../"
@@ -65,7 +67,7 @@ void scc_ut_get_nng_with_size_constraint(void** state)
 
 	iscc_Digraph out_nng2;
 	scc_ErrorCode ec2 = iscc_get_nng_with_size_constraint(&scc_ut_test_data_small_struct,
-	                                                      15, 3, 0, NULL, true, 0.2, &out_nng2);
+	                                                      15, 3, 0, NULL, true, 0.2, 1, NULL, &out_nng2);
 	iscc_Digraph ref_nng2;
 	iscc_digraph_from_string("..... ..... ...../"
 	                         "..... ..... ...../"
@@ -92,7 +94,7 @@ void scc_ut_get_nng_with_size_constraint(void** state)
 
 	iscc_Digraph out_nng3;
 	scc_ErrorCode ec3 = iscc_get_nng_with_size_constraint(&scc_ut_test_data_small_struct,
-	                                                      15, 3, 10, primary_data_points, false, 0.0, &out_nng3);
+	                                                      15, 3, 10, primary_data_points, false, 0.0, 1, NULL, &out_nng3);
 	iscc_Digraph ref_nng3;
 	iscc_digraph_from_string("..... ..##. ...../"
 	                         "....# ..#.. ...../"
@@ -119,7 +121,7 @@ void scc_ut_get_nng_with_size_constraint(void** state)
 
 	iscc_Digraph out_nng4;
 	scc_ErrorCode ec4 = iscc_get_nng_with_size_constraint(&scc_ut_test_data_small_struct,
-	                                                      15, 3, 10, primary_data_points, true, 0.2, &out_nng4);
+	                                                      15, 3, 10, primary_data_points, true, 0.2, 1, NULL, &out_nng4);
 	iscc_Digraph ref_nng4;
 	iscc_digraph_from_string("..... ..... ...../"
 	                         "..... ..... ...../"
@@ -146,7 +148,7 @@ void scc_ut_get_nng_with_size_constraint(void** state)
 
 	iscc_Digraph out_nng5;
 	scc_ErrorCode ec5 = iscc_get_nng_with_size_constraint(&scc_ut_test_data_small_struct,
-	                                                      15, 2, 0, NULL, false, 0.0, &out_nng5);
+	                                                      15, 2, 0, NULL, false, 0.0, 1, NULL, &out_nng5);
 	iscc_Digraph ref_nng5;
 	iscc_digraph_from_string("..... ...#. ...../"
 	                         "..... ..#.. ...../"
@@ -173,7 +175,7 @@ void scc_ut_get_nng_with_size_constraint(void** state)
 
 	iscc_Digraph out_nng6;
 	scc_ErrorCode ec6 = iscc_get_nng_with_size_constraint(&scc_ut_test_data_small_struct,
-	                                                      15, 2, 0, NULL, true, 0.2, &out_nng6);
+	                                                      15, 2, 0, NULL, true, 0.2, 1, NULL, &out_nng6);
 	iscc_Digraph ref_nng6;
 	iscc_digraph_from_string("..... ...#. ...../"
 	                         "..... ..#.. ...../"
@@ -200,7 +202,7 @@ void scc_ut_get_nng_with_size_constraint(void** state)
 
 	iscc_Digraph out_nng7;
 	scc_ErrorCode ec7 = iscc_get_nng_with_size_constraint(&scc_ut_test_data_small_struct,
-	                                                      15, 2, 10, primary_data_points, false, 0.0, &out_nng7);
+	                                                      15, 2, 10, primary_data_points, false, 0.0, 1, NULL, &out_nng7);
 	iscc_Digraph ref_nng7;
 	iscc_digraph_from_string("..... ...#. ...../"
 	                         "..... ..#.. ...../"
@@ -227,7 +229,7 @@ void scc_ut_get_nng_with_size_constraint(void** state)
 
 	iscc_Digraph out_nng8;
 	scc_ErrorCode ec8 = iscc_get_nng_with_size_constraint(&scc_ut_test_data_small_struct,
-	                                                      15, 2, 10, primary_data_points, true, 0.2, &out_nng8);
+	                                                      15, 2, 10, primary_data_points, true, 0.2, 1, NULL, &out_nng8);
 	iscc_Digraph ref_nng8;
 	iscc_digraph_from_string("..... ...#. ...../"
 	                         "..... ..#.. ...../"
@@ -253,7 +255,7 @@ void scc_ut_get_nng_with_size_constraint(void** state)
 
 	iscc_Digraph out_nng9;
 	scc_ErrorCode ec9 = iscc_get_nng_with_size_constraint(&scc_ut_test_data_small_struct,
-	                                                      15, 3, 0, NULL, true, 0.01, &out_nng9);
+	                                                      15, 3, 0, NULL, true, 0.01, 1, NULL, &out_nng9);
 	assert_int_equal(ec9, SCC_ER_NO_SOLUTION);
 }
 
@@ -277,7 +279,7 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec1 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 2,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      0, NULL, false, 0.0, &out_nng1);
+	                                                      0, NULL, false, 0.0, 1, NULL, &out_nng1);
 	iscc_Digraph ref_nng1;
 	iscc_digraph_from_string("..... ...#. ...../"
 	                         "..... ..... ...#./"
@@ -306,7 +308,7 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec2 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 2,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      0, NULL, true, 0.3, &out_nng2);
+	                                                      0, NULL, true, 0.3, 1, NULL, &out_nng2);
 	iscc_Digraph ref_nng2;
 	iscc_digraph_from_string("..... ...#. ...../"
 	                         "..... ..... ...../"
@@ -335,7 +337,7 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec3 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 2,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      10, primary_data_points, false, 0.0, &out_nng3);
+	                                                      10, primary_data_points, false, 0.0, 1, NULL, &out_nng3);
 	iscc_Digraph ref_nng3;
 	iscc_digraph_from_string("..... ...#. ...../"
 	                         "..... ..... ...#./"
@@ -364,7 +366,7 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec4 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 2,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      10, primary_data_points, true, 0.3, &out_nng4);
+	                                                      10, primary_data_points, true, 0.3, 1, NULL, &out_nng4);
 	iscc_Digraph ref_nng4;
 	iscc_digraph_from_string("..... ...#. ...../"
 	                         "..... ..... ...../"
@@ -393,7 +395,7 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec5 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      0, NULL, false, 0.0, &out_nng5);
+	                                                      0, NULL, false, 0.0, 1, NULL, &out_nng5);
 	iscc_Digraph ref_nng5;
 	iscc_digraph_from_string("..... ..##. ...../"
 	                         "..... ..#.. ...#./"
@@ -422,7 +424,7 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec6 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      0, NULL, true, 0.3, &out_nng6);
+	                                                      0, NULL, true, 0.3, 1, NULL, &out_nng6);
 	iscc_Digraph ref_nng6;
 	iscc_digraph_from_string("..... ..... ...../"
 	                         "..... ..... ...../"
@@ -451,7 +453,7 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec7 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      10, primary_data_points, false, 0.0, &out_nng7);
+	                                                      10, primary_data_points, false, 0.0, 1, NULL, &out_nng7);
 	iscc_Digraph ref_nng7;
 	iscc_digraph_from_string("..... ..##. ...../"
 	                         "..... ..#.. ...#./"
@@ -480,7 +482,7 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec8 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      10, primary_data_points, true, 0.3, &out_nng8);
+	                                                      10, primary_data_points, true, 0.3, 1, NULL, &out_nng8);
 	iscc_Digraph ref_nng8;
 	iscc_digraph_from_string("..... ..... ...../"
 	                         "..... ..... ...../"
@@ -509,7 +511,7 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec9 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      3, type_constraints_three, type_labels_three,
-	                                                      0, NULL, false, 0.0, &out_nng9);
+	                                                      0, NULL, false, 0.0, 1, NULL, &out_nng9);
 	iscc_Digraph ref_nng9;
 	iscc_digraph_from_string("....# ..... ...#./"
 	                         "#...# ..... ...#./"
@@ -538,7 +540,7 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec10 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      3, type_constraints_three, type_labels_three,
-	                                                      0, NULL, true, 0.5, &out_nng10);
+	                                                      0, NULL, true, 0.5, 1, NULL, &out_nng10);
 	iscc_Digraph ref_nng10;
 	iscc_digraph_from_string("..... ..... ...../"
 	                         "..... ..... ...../"
@@ -567,7 +569,7 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec11 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      3, type_constraints_three, type_labels_three,
-	                                                      10, primary_data_points, false, 0.0, &out_nng11);
+	                                                      10, primary_data_points, false, 0.0, 1, NULL, &out_nng11);
 	iscc_Digraph ref_nng11;
 	iscc_digraph_from_string("....# ..... ...#./"
 	                         "#...# ..... ...#./"
@@ -596,7 +598,7 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec12 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      3, type_constraints_three, type_labels_three,
-	                                                      10, primary_data_points, true, 0.5, &out_nng12);
+	                                                      10, primary_data_points, true, 0.5, 1, NULL, &out_nng12);
 	iscc_Digraph ref_nng12;
 	iscc_digraph_from_string("..... ..... ...../"
 	                         "..... ..... ...../"
@@ -625,7 +627,7 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec13 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                       15, 4,
 	                                                       3, type_constraints_three, type_labels_three,
-	                                                       0, NULL, false, 0.0, &out_nng13);
+	                                                       0, NULL, false, 0.0, 1, NULL, &out_nng13);
 	iscc_Digraph ref_nng13;
 	iscc_digraph_from_string("....# ...#. ...#./"
 	                         "#...# ..... ...#./"
@@ -654,7 +656,7 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec14 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                       15, 4,
 	                                                       3, type_constraints_three, type_labels_three,
-	                                                       0, NULL, true, 0.5, &out_nng14);
+	                                                       0, NULL, true, 0.5, 1, NULL, &out_nng14);
 	iscc_Digraph ref_nng14;
 	iscc_digraph_from_string("..... ..... ...../"
 	                         "..... ..... ...../"
@@ -683,7 +685,7 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec15 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                       15, 4,
 	                                                       3, type_constraints_three, type_labels_three,
-	                                                       10, primary_data_points, false, 0.0, &out_nng15);
+	                                                       10, primary_data_points, false, 0.0, 1, NULL, &out_nng15);
 	iscc_Digraph ref_nng15;
 	iscc_digraph_from_string("....# ...#. ...#./"
 	                         "#...# ..... ...#./"
@@ -712,7 +714,7 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec16 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                       15, 4,
 	                                                       3, type_constraints_three, type_labels_three,
-	                                                       10, primary_data_points, true, 0.5, &out_nng16);
+	                                                       10, primary_data_points, true, 0.5, 1, NULL, &out_nng16);
 	iscc_Digraph ref_nng16;
 	iscc_digraph_from_string("..... ..... ...../"
 	                         "..... ..... ...../"
@@ -741,7 +743,7 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec17 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 2,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      0, NULL, true, 1.0, &out_nng17);
+	                                                      0, NULL, true, 1.0, 1, NULL, &out_nng17);
 	assert_int_equal(ec17, SCC_ER_OK);
 	iscc_free_digraph(&out_nng17);
 
@@ -749,7 +751,7 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec18 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 2,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      0, NULL, true, 0.01, &out_nng18);
+	                                                      0, NULL, true, 0.01, 1, NULL, &out_nng18);
 	assert_int_equal(ec18, SCC_ER_NO_SOLUTION);
 
 
@@ -760,7 +762,7 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec19 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 2,
 	                                                      2, type_constraints_two_mod, type_labels_two,
-	                                                      7, primary_data_points_mod, true, 0.04, &out_nng19);
+	                                                      7, primary_data_points_mod, true, 0.04, 1, NULL, &out_nng19);
 	assert_int_equal(ec19, SCC_ER_OK);
 	iscc_free_digraph(&out_nng19);
 
@@ -768,26 +770,173 @@ void scc_ut_get_nng_with_type_constraint(void** state)
 	scc_ErrorCode ec20 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 2,
 	                                                      2, type_constraints_two_mod, type_labels_two,
-	                                                      7, primary_data_points_mod, true, 0.03, &out_nng20);
+	                                                      7, primary_data_points_mod, true, 0.03, 1, NULL, &out_nng20);
 	assert_int_equal(ec20, SCC_ER_NO_SOLUTION);
 
 	iscc_Digraph out_nng21;
 	scc_ErrorCode ec21 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      2, type_constraints_two_mod, type_labels_two,
-	                                                      7, primary_data_points_mod, true, 0.04, &out_nng21);
+	                                                      7, primary_data_points_mod, true, 0.04, 1, NULL, &out_nng21);
 	assert_int_equal(ec21, SCC_ER_NO_SOLUTION);
 
 	iscc_Digraph out_nng22;
 	scc_ErrorCode ec22 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      2, type_constraints_two_mod, type_labels_two,
-	                                                      7, primary_data_points_mod, true, 0.06, &out_nng22);
+	                                                      7, primary_data_points_mod, true, 0.06, 1, NULL, &out_nng22);
 	assert_int_equal(ec22, SCC_ER_OK);
 	iscc_free_digraph(&out_nng22);
 }
 
 
+void scc_ut_get_nng_multiple_threads(void** state)
+{
+	(void) state;
+
+	scc_PointIndex primary_data_points[50];
+	for (scc_PointIndex i = 0; i < 50; ++i) {
+		primary_data_points[i] = 2 * i + 1;
+	}
+
+	const uint32_t type_constraints[3] = { 1, 0, 2 };
+	scc_TypeLabel type_labels[100];
+	for (size_t i = 0; i < 100; ++i) {
+		type_labels[i] = (scc_TypeLabel) (i % 3);
+	}
+
+	for (uint32_t num_threads = 2; num_threads <= 8; num_threads *= 2) {
+		iscc_Digraph out_nng1a;
+		iscc_Digraph out_nng1b;
+		scc_ErrorCode ec1a = iscc_get_nng_with_size_constraint(scc_ut_test_data_large,
+		                                                       100, 3, 0, NULL, false, 0.0, 1, NULL, &out_nng1a);
+		scc_ErrorCode ec1b = iscc_get_nng_with_size_constraint(scc_ut_test_data_large,
+		                                                       100, 3, 0, NULL, false, 0.0, num_threads, NULL, &out_nng1b);
+		assert_int_equal(ec1a, SCC_ER_OK);
+		assert_int_equal(ec1b, SCC_ER_OK);
+		assert_identical_digraph(&out_nng1a, &out_nng1b);
+		iscc_free_digraph(&out_nng1a);
+		iscc_free_digraph(&out_nng1b);
+
+		iscc_Digraph out_nng2a;
+		iscc_Digraph out_nng2b;
+		scc_ErrorCode ec2a = iscc_get_nng_with_size_constraint(scc_ut_test_data_large,
+		                                                       100, 4, 0, NULL, true, 15.0, 1, NULL, &out_nng2a);
+		scc_ErrorCode ec2b = iscc_get_nng_with_size_constraint(scc_ut_test_data_large,
+		                                                       100, 4, 0, NULL, true, 15.0, num_threads, NULL, &out_nng2b);
+		assert_int_equal(ec2a, SCC_ER_OK);
+		assert_int_equal(ec2b, SCC_ER_OK);
+		assert_identical_digraph(&out_nng2a, &out_nng2b);
+		iscc_free_digraph(&out_nng2a);
+		iscc_free_digraph(&out_nng2b);
+
+		iscc_Digraph out_nng3a;
+		iscc_Digraph out_nng3b;
+		scc_ErrorCode ec3a = iscc_get_nng_with_size_constraint(scc_ut_test_data_large,
+		                                                       100, 3, 50, primary_data_points, true, 15.0, 1, NULL, &out_nng3a);
+		scc_ErrorCode ec3b = iscc_get_nng_with_size_constraint(scc_ut_test_data_large,
+		                                                       100, 3, 50, primary_data_points, true, 15.0, num_threads, NULL, &out_nng3b);
+		assert_int_equal(ec3a, SCC_ER_OK);
+		assert_int_equal(ec3b, SCC_ER_OK);
+		assert_identical_digraph(&out_nng3a, &out_nng3b);
+		iscc_free_digraph(&out_nng3a);
+		iscc_free_digraph(&out_nng3b);
+
+		iscc_Digraph out_nng4a;
+		iscc_Digraph out_nng4b;
+		scc_ErrorCode ec4a = iscc_get_nng_with_type_constraint(scc_ut_test_data_large,
+		                                                       100, 4,
+		                                                       3, type_constraints, type_labels,
+		                                                       0, NULL, true, 25.0, 1, NULL, &out_nng4a);
+		scc_ErrorCode ec4b = iscc_get_nng_with_type_constraint(scc_ut_test_data_large,
+		                                                       100, 4,
+		                                                       3, type_constraints, type_labels,
+		                                                       0, NULL, true, 25.0, num_threads, NULL, &out_nng4b);
+		assert_int_equal(ec4a, SCC_ER_OK);
+		assert_int_equal(ec4b, SCC_ER_OK);
+		assert_identical_digraph(&out_nng4a, &out_nng4b);
+		iscc_free_digraph(&out_nng4a);
+		iscc_free_digraph(&out_nng4b);
+	}
+}
+
+
+void scc_ut_get_nng_shared_search_object(void** state)
+{
+	(void) state;
+
+	assert_true(iscc_nn_search_supports_filter(scc_ut_test_data_large));
+	iscc_NNSearchObject* shared_search_object;
+	assert_true(iscc_init_nn_search_object(scc_ut_test_data_large, 100, NULL, &shared_search_object));
+
+	const uint32_t type_constraints[3] = { 1, 0, 2 };
+	scc_TypeLabel type_labels[100];
+	for (size_t i = 0; i < 100; ++i) {
+		type_labels[i] = (scc_TypeLabel) (i % 3);
+	}
+
+	iscc_Digraph out_nng1a;
+	iscc_Digraph out_nng1b;
+	scc_ErrorCode ec1a = iscc_get_nng_with_type_constraint(scc_ut_test_data_large,
+	                                                       100, 4,
+	                                                       3, type_constraints, type_labels,
+	                                                       0, NULL, false, 0.0, 1, NULL, &out_nng1a);
+	scc_ErrorCode ec1b = iscc_get_nng_with_type_constraint(scc_ut_test_data_large,
+	                                                       100, 4,
+	                                                       3, type_constraints, type_labels,
+	                                                       0, NULL, false, 0.0, 1, shared_search_object, &out_nng1b);
+	assert_int_equal(ec1a, SCC_ER_OK);
+	assert_int_equal(ec1b, SCC_ER_OK);
+	assert_identical_digraph(&out_nng1a, &out_nng1b);
+
+	iscc_SeedResult seed_result = {
+		.capacity = 1 + (100 / 4),
+		.count = 0,
+		.seeds = NULL,
+	};
+	assert_int_equal(iscc_find_seeds(&out_nng1a, SCC_SM_LEXICAL, 1, &seed_result), SCC_ER_OK);
+
+	const scc_UnassignedMethod unassigned_methods[2] = { SCC_UM_CLOSEST_ASSIGNED, SCC_UM_CLOSEST_SEED };
+	for (size_t m = 0; m < 2; ++m) {
+		iscc_Digraph nng2a;
+		iscc_Digraph nng2b;
+		assert_int_equal(iscc_get_nng_with_type_constraint(scc_ut_test_data_large,
+		                                                   100, 4,
+		                                                   3, type_constraints, type_labels,
+		                                                   0, NULL, false, 0.0, 1, NULL, &nng2a), SCC_ER_OK);
+		assert_int_equal(iscc_get_nng_with_type_constraint(scc_ut_test_data_large,
+		                                                   100, 4,
+		                                                   3, type_constraints, type_labels,
+		                                                   0, NULL, false, 0.0, 1, NULL, &nng2b), SCC_ER_OK);
+		scc_Clabel cluster_labels2a[100];
+		scc_Clabel cluster_labels2b[100];
+		scc_Clustering* cl2a;
+		scc_Clustering* cl2b;
+		assert_int_equal(scc_init_empty_clustering(100, cluster_labels2a, &cl2a), SCC_ER_OK);
+		assert_int_equal(scc_init_empty_clustering(100, cluster_labels2b, &cl2b), SCC_ER_OK);
+		scc_ErrorCode ec2a = iscc_make_nng_clusters_from_seeds(cl2a, scc_ut_test_data_large, &seed_result, &nng2a, false,
+		                                                       unassigned_methods[m], true, 10.0,
+		                                                       0, NULL, unassigned_methods[1 - m], false, 0.0, NULL);
+		scc_ErrorCode ec2b = iscc_make_nng_clusters_from_seeds(cl2b, scc_ut_test_data_large, &seed_result, &nng2b, false,
+		                                                       unassigned_methods[m], true, 10.0,
+		                                                       0, NULL, unassigned_methods[1 - m], false, 0.0, shared_search_object);
+		assert_int_equal(ec2a, SCC_ER_OK);
+		assert_int_equal(ec2b, SCC_ER_OK);
+		assert_int_equal(cl2a->num_clusters, cl2b->num_clusters);
+		assert_memory_equal(cluster_labels2a, cluster_labels2b, 100 * sizeof(scc_Clabel));
+		scc_free_clustering(&cl2a);
+		scc_free_clustering(&cl2b);
+		iscc_free_digraph(&nng2a);
+		iscc_free_digraph(&nng2b);
+	}
+
+	free(seed_result.seeds);
+	iscc_free_digraph(&out_nng1a);
+	iscc_free_digraph(&out_nng1b);
+	assert_true(iscc_close_nn_search_object(scc_ut_test_data_large, &shared_search_object));
+}
+
+
 void scc_ut_estimate_avg_seed_dist(void** state)
 {
 	(void) state;
@@ -897,7 +1046,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec1 = iscc_make_nng_clusters_from_seeds(cl1, &scc_ut_test_data_small_struct,
 	                                                      &sr1, &nng1, true,
 	                                                      SCC_UM_ANY_NEIGHBOR, false, 0.0,
-	                                                      0, NULL, SCC_UM_IGNORE, false, 0.0);
+	                                                      0, NULL, SCC_UM_IGNORE, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label1[15] = { 0, 1, 2, 3, 4, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4 };
 	assert_int_equal(ec1, SCC_ER_OK);
 	assert_int_equal(cl1->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -941,7 +1090,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec2 = iscc_make_nng_clusters_from_seeds(cl2, &scc_ut_test_data_small_struct,
 	                                                      &sr2, &nng2, true,
 	                                                      SCC_UM_IGNORE, false, 0.0,
-	                                                      0, NULL, SCC_UM_IGNORE, false, 0.0);
+	                                                      0, NULL, SCC_UM_IGNORE, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label2[15] = { 0, M, 1, 2, 3, 0, 0, M, M, 1, 1, 2, 2, 3, 3 };
 	assert_int_equal(ec2, SCC_ER_OK);
 	assert_int_equal(cl2->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -985,7 +1134,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec3 = iscc_make_nng_clusters_from_seeds(cl3, &scc_ut_test_data_small_struct,
 	                                                      &sr3, &nng3, true,
 	                                                      SCC_UM_ANY_NEIGHBOR, false, 0.0,
-	                                                      0, NULL, SCC_UM_IGNORE, false, 0.0);
+	                                                      0, NULL, SCC_UM_IGNORE, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label3[15] = { 0, 1, 0, 2, 3,   1, 0, 1, 3, 3,   2, 3, 1, 2, 1 };
 	assert_int_equal(ec3, SCC_ER_OK);
 	assert_int_equal(cl3->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1029,7 +1178,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec3a = iscc_make_nng_clusters_from_seeds(cl3a, &scc_ut_test_data_small_struct,
 	                                                      &sr3a, &nng3a, true,
 	                                                      SCC_UM_ANY_NEIGHBOR, false, 0.0,
-	                                                      0, NULL, SCC_UM_IGNORE, false, 0.0);
+	                                                      0, NULL, SCC_UM_IGNORE, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label3a[15] = { 0, 1, 0, 2, 3,   1, 0, M, 3, 3,   2, 3, 1, 2, M };
 	assert_int_equal(ec3a, SCC_ER_OK);
 	assert_int_equal(cl3a->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1073,7 +1222,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec4 = iscc_make_nng_clusters_from_seeds(cl4, &scc_ut_test_data_small_struct,
 	                                                      &sr4, &nng4, true,
 	                                                      SCC_UM_CLOSEST_ASSIGNED, false, 0.0,
-	                                                      0, NULL, SCC_UM_IGNORE, false, 0.0);
+	                                                      0, NULL, SCC_UM_IGNORE, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label4[15] = { 0, 1, 0, 2, 3,   1, 0, 1, 3, 3,   2, 3, 1, 2, 1 };
 	assert_int_equal(ec4, SCC_ER_OK);
 	assert_int_equal(cl4->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1117,7 +1266,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec4a = iscc_make_nng_clusters_from_seeds(cl4a, &scc_ut_test_data_small_struct,
 	                                                      &sr4a, &nng4a, true,
 	                                                      SCC_UM_CLOSEST_ASSIGNED, false, 0.0,
-	                                                      0, NULL, SCC_UM_IGNORE, false, 0.0);
+	                                                      0, NULL, SCC_UM_IGNORE, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label4a[15] = { 0, 1, 0, 2, 2,   1, 0, 1, 3, 3,   2, 3, 1, 2, 1 };
 	assert_int_equal(ec4a, SCC_ER_OK);
 	assert_int_equal(cl4a->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1161,7 +1310,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec5 = iscc_make_nng_clusters_from_seeds(cl5, &scc_ut_test_data_small_struct,
 	                                                      &sr5, &nng5, false,
 	                                                      SCC_UM_CLOSEST_ASSIGNED, false, 0.0,
-	                                                      0, NULL, SCC_UM_IGNORE, false, 0.0);
+	                                                      0, NULL, SCC_UM_IGNORE, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label5[15] = { 0, 1, 0, 2, 2,   1, 0, 1, 3, 3,   2, 3, 1, 2, 0 };
 	assert_int_equal(ec5, SCC_ER_OK);
 	assert_int_equal(cl5->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1205,7 +1354,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec5a = iscc_make_nng_clusters_from_seeds(cl5a, &scc_ut_test_data_small_struct,
 	                                                      &sr5a, &nng5a, false,
 	                                                      SCC_UM_CLOSEST_ASSIGNED, true, 0.1,
-	                                                      0, NULL, SCC_UM_IGNORE, false, 0.0);
+	                                                      0, NULL, SCC_UM_IGNORE, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label5a[15] = { 0, 1, 0, 2, 2,   1, 0, M, 3, 3,   2, 3, 1, 2, 0 };
 	assert_int_equal(ec5a, SCC_ER_OK);
 	assert_int_equal(cl5a->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1249,7 +1398,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec6 = iscc_make_nng_clusters_from_seeds(cl6, &scc_ut_test_data_small_struct,
 	                                                      &sr6, &nng6, true,
 	                                                      SCC_UM_CLOSEST_SEED, false, 0.0,
-	                                                      0, NULL, SCC_UM_IGNORE, false, 0.0);
+	                                                      0, NULL, SCC_UM_IGNORE, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label6[15] = { 0, 1, 0, 2, 0,   1, 0, 3, 3, 3,   2, 3, 1, 2, 0 };
 	assert_int_equal(ec6, SCC_ER_OK);
 	assert_int_equal(cl6->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1293,7 +1442,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec7 = iscc_make_nng_clusters_from_seeds(cl7, &scc_ut_test_data_small_struct,
 	                                                      &sr7, &nng7, true,
 	                                                      SCC_UM_IGNORE, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_IGNORE, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_IGNORE, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label7[15] = { 1, 1, M, M, 2,   M, 1, M, 2, M,   M, 0, 2, 0, 0 };
 	assert_int_equal(ec7, SCC_ER_OK);
 	assert_int_equal(cl7->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1337,7 +1486,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec7a = iscc_make_nng_clusters_from_seeds(cl7a, &scc_ut_test_data_small_struct,
 	                                                      &sr7a, &nng7a, true,
 	                                                      SCC_UM_IGNORE, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label7a[15] = { 1, 1, 2, 2, 2,   0, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec7a, SCC_ER_OK);
 	assert_int_equal(cl7a->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1381,7 +1530,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec7b = iscc_make_nng_clusters_from_seeds(cl7b, &scc_ut_test_data_small_struct,
 	                                                      &sr7b, &nng7b, true,
 	                                                      SCC_UM_IGNORE, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, true, 0.75);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, true, 0.75, NULL);
 	const scc_Clabel ref_cluster_label7b[15] = { 1, 1, 2, M, 2,   M, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec7b, SCC_ER_OK);
 	assert_int_equal(cl7b->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1425,7 +1574,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec7c = iscc_make_nng_clusters_from_seeds(cl7c, &scc_ut_test_data_small_struct,
 	                                                      &sr7c, &nng7c, true,
 	                                                      SCC_UM_IGNORE, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label7c[15] = { 1, 1, 2, 0, 2,   0, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec7c, SCC_ER_OK);
 	assert_int_equal(cl7c->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1469,7 +1618,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec7d = iscc_make_nng_clusters_from_seeds(cl7d, &scc_ut_test_data_small_struct,
 	                                                      &sr7d, &nng7d, true,
 	                                                      SCC_UM_IGNORE, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, true, 0.75);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, true, 0.75, NULL);
 	const scc_Clabel ref_cluster_label7d[15] = { 1, 1, 2, M, 2,   M, 1, 1, 2, M,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec7d, SCC_ER_OK);
 	assert_int_equal(cl7d->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1513,7 +1662,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec8 = iscc_make_nng_clusters_from_seeds(cl8, &scc_ut_test_data_small_struct,
 	                                                      &sr8, &nng8, true,
 	                                                      SCC_UM_ANY_NEIGHBOR, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_IGNORE, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_IGNORE, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label8[15] = { 1, 1, 1, 0, 2,   M, 1, M, 2, M,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec8, SCC_ER_OK);
 	assert_int_equal(cl8->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1557,7 +1706,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec8a = iscc_make_nng_clusters_from_seeds(cl8a, &scc_ut_test_data_small_struct,
 	                                                      &sr8a, &nng8a, true,
 	                                                      SCC_UM_ANY_NEIGHBOR, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label8a[15] = { 1, 1, 1, 0, 2,   0, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec8a, SCC_ER_OK);
 	assert_int_equal(cl8a->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1601,7 +1750,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec8b = iscc_make_nng_clusters_from_seeds(cl8b, &scc_ut_test_data_small_struct,
 	                                                      &sr8b, &nng8b, true,
 	                                                      SCC_UM_ANY_NEIGHBOR, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, true, 0.75);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, true, 0.75, NULL);
 	const scc_Clabel ref_cluster_label8b[15] = { 1, 1, 1, 0, 2,   M, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec8b, SCC_ER_OK);
 	assert_int_equal(cl8b->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1645,7 +1794,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec8c = iscc_make_nng_clusters_from_seeds(cl8c, &scc_ut_test_data_small_struct,
 	                                                      &sr8c, &nng8c, true,
 	                                                      SCC_UM_ANY_NEIGHBOR, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label8c[15] = { 1, 1, 1, 0, 2,   0, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec8c, SCC_ER_OK);
 	assert_int_equal(cl8c->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1689,7 +1838,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec8d = iscc_make_nng_clusters_from_seeds(cl8d, &scc_ut_test_data_small_struct,
 	                                                      &sr8d, &nng8d, true,
 	                                                      SCC_UM_ANY_NEIGHBOR, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, true, 0.75);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, true, 0.75, NULL);
 	const scc_Clabel ref_cluster_label8d[15] = { 1, 1, 1, 0, 2,   M, 1, 1, 2, M,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec8d, SCC_ER_OK);
 	assert_int_equal(cl8d->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1733,7 +1882,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec9 = iscc_make_nng_clusters_from_seeds(cl9, &scc_ut_test_data_small_struct,
 	                                                      &sr9, &nng9, true,
 	                                                      SCC_UM_CLOSEST_ASSIGNED, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_IGNORE, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_IGNORE, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label9[15] = { 1, 1, 1, 0, 2,   M, 1, M, 2, M,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec9, SCC_ER_OK);
 	assert_int_equal(cl9->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1777,7 +1926,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec9a = iscc_make_nng_clusters_from_seeds(cl9a, &scc_ut_test_data_small_struct,
 	                                                      &sr9a, &nng9a, true,
 	                                                      SCC_UM_CLOSEST_ASSIGNED, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label9a[15] = { 1, 1, 1, 0, 2,   0, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec9a, SCC_ER_OK);
 	assert_int_equal(cl9a->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1821,7 +1970,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec9b = iscc_make_nng_clusters_from_seeds(cl9b, &scc_ut_test_data_small_struct,
 	                                                      &sr9b, &nng9b, true,
 	                                                      SCC_UM_CLOSEST_ASSIGNED, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, true, 0.75);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, true, 0.75, NULL);
 	const scc_Clabel ref_cluster_label9b[15] = { 1, 1, 1, 0, 2,   M, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec9b, SCC_ER_OK);
 	assert_int_equal(cl9b->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1865,7 +2014,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec9c = iscc_make_nng_clusters_from_seeds(cl9c, &scc_ut_test_data_small_struct,
 	                                                      &sr9c, &nng9c, true,
 	                                                      SCC_UM_CLOSEST_ASSIGNED, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label9c[15] = { 1, 1, 1, 0, 2,   0, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec9c, SCC_ER_OK);
 	assert_int_equal(cl9c->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1909,7 +2058,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec9d = iscc_make_nng_clusters_from_seeds(cl9d, &scc_ut_test_data_small_struct,
 	                                                      &sr9d, &nng9d, true,
 	                                                      SCC_UM_CLOSEST_ASSIGNED, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, true, 0.75);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, true, 0.75, NULL);
 	const scc_Clabel ref_cluster_label9d[15] = { 1, 1, 1, 0, 2,   M, 1, 1, 2, M,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec9d, SCC_ER_OK);
 	assert_int_equal(cl9d->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1953,7 +2102,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec10 = iscc_make_nng_clusters_from_seeds(cl10, &scc_ut_test_data_small_struct,
 	                                                      &sr10, &nng10, false,
 	                                                      SCC_UM_CLOSEST_ASSIGNED, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_IGNORE, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_IGNORE, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label10[15] = { 1, 1, 2, 2, 2,   M, 1, M, 2, M,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec10, SCC_ER_OK);
 	assert_int_equal(cl10->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -1997,7 +2146,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec10a = iscc_make_nng_clusters_from_seeds(cl10a, &scc_ut_test_data_small_struct,
 	                                                      &sr10a, &nng10a, false,
 	                                                      SCC_UM_CLOSEST_ASSIGNED, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label10a[15] = { 1, 1, 2, 2, 2,   0, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec10a, SCC_ER_OK);
 	assert_int_equal(cl10a->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -2041,7 +2190,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec10b = iscc_make_nng_clusters_from_seeds(cl10b, &scc_ut_test_data_small_struct,
 	                                                      &sr10b, &nng10b, false,
 	                                                      SCC_UM_CLOSEST_ASSIGNED, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, true, 0.75);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, true, 0.75, NULL);
 	const scc_Clabel ref_cluster_label10b[15] = { 1, 1, 2, 2, 2,   M, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec10b, SCC_ER_OK);
 	assert_int_equal(cl10b->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -2085,7 +2234,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec10c = iscc_make_nng_clusters_from_seeds(cl10c, &scc_ut_test_data_small_struct,
 	                                                      &sr10c, &nng10c, false,
 	                                                      SCC_UM_CLOSEST_ASSIGNED, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label10c[15] = { 1, 1, 2, 2, 2,   0, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec10c, SCC_ER_OK);
 	assert_int_equal(cl10c->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -2129,7 +2278,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec10d = iscc_make_nng_clusters_from_seeds(cl10d, &scc_ut_test_data_small_struct,
 	                                                      &sr10d, &nng10d, false,
 	                                                      SCC_UM_CLOSEST_ASSIGNED, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, true, 0.75);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, true, 0.75, NULL);
 	const scc_Clabel ref_cluster_label10d[15] = { 1, 1, 2, 2, 2,   M, 1, 1, 2, M,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec10d, SCC_ER_OK);
 	assert_int_equal(cl10d->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -2173,7 +2322,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec11 = iscc_make_nng_clusters_from_seeds(cl11, &scc_ut_test_data_small_struct,
 	                                                      &sr11, &nng11, false,
 	                                                      SCC_UM_CLOSEST_ASSIGNED, true, 0.5,
-	                                                      10, primary_data_points, SCC_UM_IGNORE, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_IGNORE, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label11[15] = { 1, 1, 2, M, 2,   M, 1, M, 2, M,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec11, SCC_ER_OK);
 	assert_int_equal(cl11->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -2217,7 +2366,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec11a = iscc_make_nng_clusters_from_seeds(cl11a, &scc_ut_test_data_small_struct,
 	                                                      &sr11a, &nng11a, false,
 	                                                      SCC_UM_CLOSEST_ASSIGNED, true, 0.5,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label11a[15] = { 1, 1, 2, 2, 2,   0, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec11a, SCC_ER_OK);
 	assert_int_equal(cl11a->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -2261,7 +2410,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec11b = iscc_make_nng_clusters_from_seeds(cl11b, &scc_ut_test_data_small_struct,
 	                                                      &sr11b, &nng11b, false,
 	                                                      SCC_UM_CLOSEST_ASSIGNED, true, 0.5,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, true, 0.75);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, true, 0.75, NULL);
 	const scc_Clabel ref_cluster_label11b[15] = { 1, 1, 2, M, 2,   M, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec11b, SCC_ER_OK);
 	assert_int_equal(cl11b->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -2305,7 +2454,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec11c = iscc_make_nng_clusters_from_seeds(cl11c, &scc_ut_test_data_small_struct,
 	                                                      &sr11c, &nng11c, false,
 	                                                      SCC_UM_CLOSEST_ASSIGNED, true, 0.5,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label11c[15] = { 1, 1, 2, 0, 2,   0, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec11c, SCC_ER_OK);
 	assert_int_equal(cl11c->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -2349,7 +2498,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec11d = iscc_make_nng_clusters_from_seeds(cl11d, &scc_ut_test_data_small_struct,
 	                                                      &sr11d, &nng11d, false,
 	                                                      SCC_UM_CLOSEST_ASSIGNED, true, 0.5,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, true, 0.75);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, true, 0.75, NULL);
 	const scc_Clabel ref_cluster_label11d[15] = { 1, 1, 2, M, 2,   M, 1, 1, 2, M,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec11d, SCC_ER_OK);
 	assert_int_equal(cl11d->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -2393,7 +2542,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec12 = iscc_make_nng_clusters_from_seeds(cl12, &scc_ut_test_data_small_struct,
 	                                                      &sr12, &nng12, false,
 	                                                      SCC_UM_CLOSEST_SEED, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_IGNORE, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_IGNORE, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label12[15] = { 1, 1, 2, 0, 2,   M, 1, M, 2, M,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec12, SCC_ER_OK);
 	assert_int_equal(cl12->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -2437,7 +2586,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec12a = iscc_make_nng_clusters_from_seeds(cl12a, &scc_ut_test_data_small_struct,
 	                                                      &sr12a, &nng12a, false,
 	                                                      SCC_UM_CLOSEST_SEED, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label12a[15] = { 1, 1, 2, 0, 2,   0, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec12a, SCC_ER_OK);
 	assert_int_equal(cl12a->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -2481,7 +2630,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec12b = iscc_make_nng_clusters_from_seeds(cl12b, &scc_ut_test_data_small_struct,
 	                                                      &sr12b, &nng12b, false,
 	                                                      SCC_UM_CLOSEST_SEED, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, true, 0.75);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, true, 0.75, NULL);
 	const scc_Clabel ref_cluster_label12b[15] = { 1, 1, 2, 0, 2,   M, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec12b, SCC_ER_OK);
 	assert_int_equal(cl12b->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -2525,7 +2674,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec12c = iscc_make_nng_clusters_from_seeds(cl12c, &scc_ut_test_data_small_struct,
 	                                                      &sr12c, &nng12c, false,
 	                                                      SCC_UM_CLOSEST_SEED, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label12c[15] = { 1, 1, 2, 0, 2,   0, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec12c, SCC_ER_OK);
 	assert_int_equal(cl12c->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -2569,7 +2718,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec12d = iscc_make_nng_clusters_from_seeds(cl12d, &scc_ut_test_data_small_struct,
 	                                                      &sr12d, &nng12d, false,
 	                                                      SCC_UM_CLOSEST_SEED, false, 0.0,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, true, 0.75);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, true, 0.75, NULL);
 	const scc_Clabel ref_cluster_label12d[15] = { 1, 1, 2, 0, 2,   M, 1, 1, 2, M,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec12d, SCC_ER_OK);
 	assert_int_equal(cl12d->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -2613,7 +2762,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec13 = iscc_make_nng_clusters_from_seeds(cl13, &scc_ut_test_data_small_struct,
 	                                                      &sr13, &nng13, false,
 	                                                      SCC_UM_CLOSEST_SEED, true, 0.5,
-	                                                      10, primary_data_points, SCC_UM_IGNORE, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_IGNORE, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label13[15] = { 1, 1, M, M, 2,   M, 1, M, 2, M,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec13, SCC_ER_OK);
 	assert_int_equal(cl13->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -2657,7 +2806,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec13a = iscc_make_nng_clusters_from_seeds(cl13a, &scc_ut_test_data_small_struct,
 	                                                      &sr13a, &nng13a, false,
 	                                                      SCC_UM_CLOSEST_SEED, true, 0.5,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label13a[15] = { 1, 1, 2, 2, 2,   0, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec13a, SCC_ER_OK);
 	assert_int_equal(cl13a->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -2701,7 +2850,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec13b = iscc_make_nng_clusters_from_seeds(cl13b, &scc_ut_test_data_small_struct,
 	                                                      &sr13b, &nng13b, false,
 	                                                      SCC_UM_CLOSEST_SEED, true, 0.5,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, true, 0.75);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_ASSIGNED, true, 0.75, NULL);
 	const scc_Clabel ref_cluster_label13b[15] = { 1, 1, 2, M, 2,   M, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec13b, SCC_ER_OK);
 	assert_int_equal(cl13b->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -2745,7 +2894,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec13c = iscc_make_nng_clusters_from_seeds(cl13c, &scc_ut_test_data_small_struct,
 	                                                      &sr13c, &nng13c, false,
 	                                                      SCC_UM_CLOSEST_SEED, true, 0.5,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, false, 0.0);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, false, 0.0, NULL);
 	const scc_Clabel ref_cluster_label13c[15] = { 1, 1, 2, 0, 2,   0, 1, 1, 2, 2,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec13c, SCC_ER_OK);
 	assert_int_equal(cl13c->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -2789,7 +2938,7 @@ void scc_ut_make_nng_clusters_from_seeds(void** state)
 	scc_ErrorCode ec13d = iscc_make_nng_clusters_from_seeds(cl13d, &scc_ut_test_data_small_struct,
 	                                                      &sr13d, &nng13d, false,
 	                                                      SCC_UM_CLOSEST_SEED, true, 0.5,
-	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, true, 0.75);
+	                                                      10, primary_data_points, SCC_UM_CLOSEST_SEED, true, 0.75, NULL);
 	const scc_Clabel ref_cluster_label13d[15] = { 1, 1, 2, M, 2,   M, 1, 1, 2, M,   2, 0, 2, 0, 0 };
 	assert_int_equal(ec13d, SCC_ER_OK);
 	assert_int_equal(cl13d->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
@@ -2812,6 +2961,8 @@ int main(void)
 	const struct CMUnitTest test_cases[] = {
 		cmocka_unit_test(scc_ut_get_nng_with_size_constraint),
 		cmocka_unit_test(scc_ut_get_nng_with_type_constraint),
+		cmocka_unit_test(scc_ut_get_nng_multiple_threads),
+		cmocka_unit_test(scc_ut_get_nng_shared_search_object),
 		cmocka_unit_test(scc_ut_estimate_avg_seed_dist),
 		cmocka_unit_test(scc_ut_make_nng_clusters_from_seeds),
 	};
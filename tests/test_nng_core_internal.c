@@ -40,10 +40,10 @@ void scc_ut_make_nng(void** state)
 	iscc_Digraph ref_nng1b;
 	iscc_digraph_from_pieces(100, 30, ref_nn_ref1b, ref_nn_indices1b, &ref_nng1b);
 	iscc_Digraph out_nng1b;
-	scc_ErrorCode ec1b = iscc_make_nng(scc_ut_test_data_large, 100, 10, search1,
+	scc_ErrorCode ec1b = iscc_make_nng(scc_ut_test_data_large, 100, 10, search1, NULL, NULL,
                                       10, query1b,
                                       3, false, 0.0,
-                                      NULL, NULL, &out_nng1b);
+                                      1, NULL, NULL, &out_nng1b);
 	assert_int_equal(ec1b, SCC_ER_OK);
 	assert_equal_digraph(&out_nng1b, &ref_nng1b);
 	iscc_free_digraph(&out_nng1b);
@@ -59,10 +59,10 @@ void scc_ut_make_nng(void** state)
 	iscc_Digraph ref_nng1c;
 	iscc_digraph_from_pieces(100, 4, ref_nn_ref1c, ref_nn_indices1c, &ref_nng1c);
 	iscc_Digraph out_nng1c;
-	scc_ErrorCode ec1c = iscc_make_nng(scc_ut_test_data_large, 100, 10, search1,
+	scc_ErrorCode ec1c = iscc_make_nng(scc_ut_test_data_large, 100, 10, search1, NULL, NULL,
                                       2, query1c,
                                       2, false, 0.0,
-                                      NULL, NULL, &out_nng1c);
+                                      1, NULL, NULL, &out_nng1c);
 	assert_int_equal(ec1c, SCC_ER_OK);
 	assert_equal_digraph(&out_nng1c, &ref_nng1c);
 	iscc_free_digraph(&out_nng1c);
@@ -79,10 +79,10 @@ void scc_ut_make_nng(void** state)
 	iscc_Digraph ref_nng4b;
 	iscc_digraph_from_pieces(100, 100, ref_nn_ref4b, ref_nn_indices4b, &ref_nng4b);
 	iscc_Digraph out_nng4b;
-	scc_ErrorCode ec4b = iscc_make_nng(scc_ut_test_data_large, 100, 2, search4b,
+	scc_ErrorCode ec4b = iscc_make_nng(scc_ut_test_data_large, 100, 2, search4b, NULL, NULL,
                                       100, NULL,
                                       1, false, 0.0,
-                                      NULL, NULL, &out_nng4b);
+                                      1, NULL, NULL, &out_nng4b);
 	assert_int_equal(ec4b, SCC_ER_OK);
 	assert_equal_digraph(&out_nng4b, &ref_nng4b);
 	iscc_free_digraph(&out_nng4b);
@@ -96,10 +96,10 @@ void scc_ut_make_nng(void** state)
 	iscc_Digraph ref_nng5a;
 	iscc_digraph_from_pieces(100, 5, ref_nn_ref5a, ref_nn_indices5a, &ref_nng5a);
 	iscc_Digraph out_nng5a;
-	scc_ErrorCode ec5a = iscc_make_nng(scc_ut_test_data_large, 100, 100, NULL,
+	scc_ErrorCode ec5a = iscc_make_nng(scc_ut_test_data_large, 100, 100, NULL, NULL, NULL,
                                       1, query5a,
                                       5, false, 0.0,
-                                      NULL, NULL, &out_nng5a);
+                                      1, NULL, NULL, &out_nng5a);
 	assert_int_equal(ec5a, SCC_ER_OK);
 	assert_equal_digraph(&out_nng5a, &ref_nng5a);
 	iscc_free_digraph(&out_nng5a);
@@ -113,10 +113,10 @@ void scc_ut_make_nng(void** state)
 	iscc_Digraph ref_nng5b;
 	iscc_digraph_from_pieces(100, 8, ref_nn_ref5b, ref_nn_indices5b, &ref_nng5b);
 	iscc_Digraph out_nng5b;
-	scc_ErrorCode ec5b = iscc_make_nng(scc_ut_test_data_large, 100, 100, NULL,
+	scc_ErrorCode ec5b = iscc_make_nng(scc_ut_test_data_large, 100, 100, NULL, NULL, NULL,
                                       2, query5b,
                                       4, false, 0.0,
-                                      NULL, NULL, &out_nng5b);
+                                      1, NULL, NULL, &out_nng5b);
 	assert_int_equal(ec5b, SCC_ER_OK);
 	assert_equal_digraph(&out_nng5b, &ref_nng5b);
 	iscc_free_digraph(&out_nng5b);
@@ -130,10 +130,10 @@ void scc_ut_make_nng(void** state)
 	iscc_Digraph ref_nng5c;
 	iscc_digraph_from_pieces(100, 6, ref_nn_ref5c, ref_nn_indices5c, &ref_nng5c);
 	iscc_Digraph out_nng5c;
-	scc_ErrorCode ec5c = iscc_make_nng(scc_ut_test_data_large, 100, 50, NULL,
+	scc_ErrorCode ec5c = iscc_make_nng(scc_ut_test_data_large, 100, 50, NULL, NULL, NULL,
                                       2, query5c,
                                       3, false, 0.0,
-                                      NULL, NULL, &out_nng5c);
+                                      1, NULL, NULL, &out_nng5c);
 	assert_int_equal(ec5c, SCC_ER_OK);
 	assert_equal_digraph(&out_nng5c, &ref_nng5c);
 	iscc_free_digraph(&out_nng5c);
@@ -145,10 +145,10 @@ void scc_ut_make_nng(void** state)
 	iscc_Digraph ref_nng6a;
 	iscc_digraph_from_pieces(15, 30, ref_nn_ref6a, ref_nn_indices6a, &ref_nng6a);
 	iscc_Digraph out_nng6a;
-	scc_ErrorCode ec6a = iscc_make_nng(scc_ut_test_data_small, 15, 15, NULL,
+	scc_ErrorCode ec6a = iscc_make_nng(scc_ut_test_data_small, 15, 15, NULL, NULL, NULL,
                                       15, NULL,
                                       2, false, 0.0,
-                                      NULL, NULL, &out_nng6a);
+                                      1, NULL, NULL, &out_nng6a);
 	assert_int_equal(ec6a, SCC_ER_OK);
 	assert_equal_digraph(&out_nng6a, &ref_nng6a);
 	iscc_free_digraph(&out_nng6a);
@@ -160,10 +160,10 @@ void scc_ut_make_nng(void** state)
 	iscc_Digraph ref_nng6c;
 	iscc_digraph_from_pieces(15, 30, ref_nn_ref6c, ref_nn_indices6c, &ref_nng6c);
 	iscc_Digraph out_nng6c;
-	scc_ErrorCode ec6c = iscc_make_nng(scc_ut_test_data_small, 15, 10, NULL,
+	scc_ErrorCode ec6c = iscc_make_nng(scc_ut_test_data_small, 15, 10, NULL, NULL, NULL,
                                       15, NULL,
                                       2, false, 0.0,
-                                      NULL, NULL, &out_nng6c);
+                                      1, NULL, NULL, &out_nng6c);
 	assert_int_equal(ec6c, SCC_ER_OK);
 	assert_equal_digraph(&out_nng6c, &ref_nng6c);
 	iscc_free_digraph(&out_nng6c);
@@ -175,10 +175,10 @@ void scc_ut_make_nng(void** state)
 	iscc_Digraph ref_nng6d;
 	iscc_digraph_from_pieces(10, 20, ref_nn_ref6d, ref_nn_indices6d, &ref_nng6d);
 	iscc_Digraph out_nng6d;
-	scc_ErrorCode ec6d = iscc_make_nng(scc_ut_test_data_small, 10, 10, NULL,
+	scc_ErrorCode ec6d = iscc_make_nng(scc_ut_test_data_small, 10, 10, NULL, NULL, NULL,
                                       10, NULL,
                                       2, false, 0.0,
-                                      NULL, NULL, &out_nng6d);
+                                      1, NULL, NULL, &out_nng6d);
 	assert_int_equal(ec6d, SCC_ER_OK);
 	assert_equal_digraph(&out_nng6d, &ref_nng6d);
 	iscc_free_digraph(&out_nng6d);
@@ -200,10 +200,10 @@ void scc_ut_make_nng_radius(void** state)
 	iscc_Digraph ref_nng1b;
 	iscc_digraph_from_pieces(100, 21, ref_nn_ref1b, ref_nn_indices1b, &ref_nng1b);
 	iscc_Digraph out_nng1b;
-	scc_ErrorCode ec1b = iscc_make_nng(scc_ut_test_data_large, 100, 10, search1,
+	scc_ErrorCode ec1b = iscc_make_nng(scc_ut_test_data_large, 100, 10, search1, NULL, NULL,
                                       10, query1b,
                                       3, true, 50.0,
-                                      NULL, NULL, &out_nng1b);
+                                      1, NULL, NULL, &out_nng1b);
 	assert_int_equal(ec1b, SCC_ER_OK);
 	assert_equal_digraph(&out_nng1b, &ref_nng1b);
 	iscc_free_digraph(&out_nng1b);
@@ -220,10 +220,10 @@ void scc_ut_make_nng_radius(void** state)
 	iscc_Digraph ref_nng1c;
 	iscc_digraph_from_pieces(100, 4, ref_nn_ref1c, ref_nn_indices1c, &ref_nng1c);
 	iscc_Digraph out_nng1c;
-	scc_ErrorCode ec1c = iscc_make_nng(scc_ut_test_data_large, 100, 10, search1,
+	scc_ErrorCode ec1c = iscc_make_nng(scc_ut_test_data_large, 100, 10, search1, NULL, NULL,
                                       2, query1c,
                                       2, true, 40.0,
-                                      &out_num_query1c, out_indicators1c, &out_nng1c);
+                                      1, &out_num_query1c, out_indicators1c, &out_nng1c);
 	assert_int_equal(ec1c, SCC_ER_OK);
 	assert_equal_digraph(&out_nng1c, &ref_nng1c);
 	assert_int_equal(out_num_query1c, 2);
@@ -242,10 +242,10 @@ void scc_ut_make_nng_radius(void** state)
 	iscc_Digraph ref_nng4b;
 	iscc_digraph_from_pieces(100, 14, ref_nn_ref4b, ref_nn_indices4b, &ref_nng4b);
 	iscc_Digraph out_nng4b;
-	scc_ErrorCode ec4b = iscc_make_nng(scc_ut_test_data_large, 100, 2, search4b,
+	scc_ErrorCode ec4b = iscc_make_nng(scc_ut_test_data_large, 100, 2, search4b, NULL, NULL,
                                       100, NULL,
                                       1, true, 20.0,
-                                      &out_num_query4b, out_indicators4b, &out_nng4b);
+                                      1, &out_num_query4b, out_indicators4b, &out_nng4b);
 	assert_int_equal(ec4b, SCC_ER_OK);
 	assert_equal_digraph(&out_nng4b, &ref_nng4b);
 	assert_int_equal(out_num_query4b, 14);
@@ -259,10 +259,10 @@ void scc_ut_make_nng_radius(void** state)
 	iscc_Digraph ref_nng5a;
 	iscc_empty_digraph(100, 0, &ref_nng5a);
 	iscc_Digraph out_nng5a;
-	scc_ErrorCode ec5a = iscc_make_nng(scc_ut_test_data_large, 100, 100, NULL,
+	scc_ErrorCode ec5a = iscc_make_nng(scc_ut_test_data_large, 100, 100, NULL, NULL, NULL,
                                       num_query5a, query5a,
                                       5, true, 20.0,
-                                      &num_query5a, query5a, &out_nng5a);
+                                      1, &num_query5a, query5a, &out_nng5a);
 	assert_int_equal(ec5a, SCC_ER_OK);
 	assert_equal_digraph(&out_nng5a, &ref_nng5a);
 	assert_int_equal(num_query5a, 0);
@@ -279,10 +279,10 @@ void scc_ut_make_nng_radius(void** state)
 	iscc_Digraph ref_nng5b;
 	iscc_digraph_from_pieces(100, 4, ref_nn_ref5b, ref_nn_indices5b, &ref_nng5b);
 	iscc_Digraph out_nng5b;
-	scc_ErrorCode ec5b = iscc_make_nng(scc_ut_test_data_large, 100, 100, NULL,
+	scc_ErrorCode ec5b = iscc_make_nng(scc_ut_test_data_large, 100, 100, NULL, NULL, NULL,
                                       num_query5b, query5b,
                                       4, true, 20.5,
-                                      &num_query5b, query5b, &out_nng5b);
+                                      1, &num_query5b, query5b, &out_nng5b);
 	assert_int_equal(ec5b, SCC_ER_OK);
 	assert_equal_digraph(&out_nng5b, &ref_nng5b);
 	assert_int_equal(num_query5b, 1);
@@ -298,10 +298,10 @@ void scc_ut_make_nng_radius(void** state)
 	iscc_Digraph ref_nng5c;
 	iscc_digraph_from_pieces(100, 3, ref_nn_ref5c, ref_nn_indices5c, &ref_nng5c);
 	iscc_Digraph out_nng5c;
-	scc_ErrorCode ec5c = iscc_make_nng(scc_ut_test_data_large, 100, 50, NULL,
+	scc_ErrorCode ec5c = iscc_make_nng(scc_ut_test_data_large, 100, 50, NULL, NULL, NULL,
                                       2, query5c,
                                       3, true, 30.0,
-                                      NULL, NULL, &out_nng5c);
+                                      1, NULL, NULL, &out_nng5c);
 	assert_int_equal(ec5c, SCC_ER_OK);
 	assert_equal_digraph(&out_nng5c, &ref_nng5c);
 	iscc_free_digraph(&out_nng5c);
@@ -323,16 +323,18 @@ void scc_ut_make_nng_radius(void** state)
 	                                      0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
 	                                      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
 	iscc_Digraph out_nng5d;
-	scc_ErrorCode ec5d = iscc_make_nng(scc_ut_test_data_large, 100, 100, NULL,
+	scc_ErrorCode ec5d = iscc_make_nng(scc_ut_test_data_large, 100, 100, NULL, NULL, NULL,
                                       100, query5d,
                                       3, true, 0.1,
-                                      NULL, NULL, &out_nng5d);
+                                      1, NULL, NULL, &out_nng5d);
 	assert_int_equal(ec5d, SCC_ER_OK);
 	assert_int_equal(out_nng5d.vertices, 100);
 	assert_int_equal(out_nng5d.max_arcs, 0);
 	assert_null(out_nng5d.head);
-	assert_non_null(out_nng5d.tail_ptr);
-	assert_memory_equal(out_nng5d.tail_ptr, ref_nn_ref5d, 101 * sizeof(iscc_ArcIndex));
+	assert_true(iscc_digraph_is_fixed(&out_nng5d));
+	for (size_t v = 0; v <= 100; ++v) {
+		assert_int_equal(iscc_digraph_row_begin(&out_nng5d, v), ref_nn_ref5d[v]);
+	}
 	iscc_free_digraph(&out_nng5d);
 
 
@@ -352,16 +354,18 @@ void scc_ut_make_nng_radius(void** state)
 	                                      0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
 	                                      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
 	iscc_Digraph out_nng5e;
-	scc_ErrorCode ec5e = iscc_make_nng(scc_ut_test_data_large, 100, 100, NULL,
+	scc_ErrorCode ec5e = iscc_make_nng(scc_ut_test_data_large, 100, 100, NULL, NULL, NULL,
                                       num_query5e, query5e,
                                       3, true, 0.1,
-                                      &num_query5e, query5e, &out_nng5e);
+                                      1, &num_query5e, query5e, &out_nng5e);
 	assert_int_equal(ec5e, SCC_ER_OK);
 	assert_int_equal(out_nng5e.vertices, 100);
 	assert_int_equal(out_nng5e.max_arcs, 0);
 	assert_null(out_nng5e.head);
-	assert_non_null(out_nng5e.tail_ptr);
-	assert_memory_equal(out_nng5e.tail_ptr, ref_nn_ref5e, 101 * sizeof(iscc_ArcIndex));
+	assert_true(iscc_digraph_is_fixed(&out_nng5e));
+	for (size_t v = 0; v <= 100; ++v) {
+		assert_int_equal(iscc_digraph_row_begin(&out_nng5e, v), ref_nn_ref5e[v]);
+	}
 	iscc_free_digraph(&out_nng5e);
 	assert_int_equal(num_query5e, 0);
 
@@ -374,10 +378,10 @@ void scc_ut_make_nng_radius(void** state)
 	iscc_Digraph ref_nng6a;
 	iscc_digraph_from_pieces(15, 20, ref_nn_ref6a, ref_nn_indices6a, &ref_nng6a);
 	iscc_Digraph out_nng6a;
-	scc_ErrorCode ec6a = iscc_make_nng(scc_ut_test_data_small, 15, 15, NULL,
+	scc_ErrorCode ec6a = iscc_make_nng(scc_ut_test_data_small, 15, 15, NULL, NULL, NULL,
                                       15, NULL,
                                       2, true, 0.2,
-                                      &num_query6a, out_indicators6a, &out_nng6a);
+                                      1, &num_query6a, out_indicators6a, &out_nng6a);
 	assert_int_equal(ec6a, SCC_ER_OK);
 	assert_equal_digraph(&out_nng6a, &ref_nng6a);
 	assert_int_equal(num_query6a, 10);
@@ -394,10 +398,10 @@ void scc_ut_make_nng_radius(void** state)
 	iscc_Digraph ref_nng6c;
 	iscc_digraph_from_pieces(15, 12, ref_nn_ref6c, ref_nn_indices6c, &ref_nng6c);
 	iscc_Digraph out_nng6c;
-	scc_ErrorCode ec6c = iscc_make_nng(scc_ut_test_data_small, 15, 10, NULL,
+	scc_ErrorCode ec6c = iscc_make_nng(scc_ut_test_data_small, 15, 10, NULL, NULL, NULL,
                                       15, NULL,
                                       2, true, 0.3,
-                                      &num_query6c, out_indicators6c, &out_nng6c);
+                                      1, &num_query6c, out_indicators6c, &out_nng6c);
 	assert_int_equal(ec6c, SCC_ER_OK);
 	assert_equal_digraph(&out_nng6c, &ref_nng6c);
 	assert_int_equal(num_query6c, 6);
@@ -414,10 +418,10 @@ void scc_ut_make_nng_radius(void** state)
 	iscc_Digraph ref_nng6d;
 	iscc_digraph_from_pieces(10, 8, ref_nn_ref6d, ref_nn_indices6d, &ref_nng6d);
 	iscc_Digraph out_nng6d;
-	scc_ErrorCode ec6d = iscc_make_nng(scc_ut_test_data_small, 10, 10, NULL,
+	scc_ErrorCode ec6d = iscc_make_nng(scc_ut_test_data_small, 10, 10, NULL, NULL, NULL,
                                       10, NULL,
                                       2, true, 0.2,
-                                      &num_query6d, out_indicators6d, &out_nng6d);
+                                      1, &num_query6d, out_indicators6d, &out_nng6d);
 	assert_int_equal(ec6d, SCC_ER_OK);
 	assert_equal_digraph(&out_nng6d, &ref_nng6d);
 	assert_int_equal(num_query6d, 4);
@@ -443,10 +447,10 @@ void scc_ut_make_nng_from_search_object(void** state)
 	iscc_Digraph ref_nng1b;
 	iscc_digraph_from_pieces(100, 30, ref_nn_ref1b, ref_nn_indices1b, &ref_nng1b);
 	iscc_Digraph out_nng1b;
-	scc_ErrorCode ec1b = iscc_make_nng_from_search_object(nn_search_object1, 100,
+	scc_ErrorCode ec1b = iscc_make_nng_from_search_object(scc_ut_test_data_large, nn_search_object1, NULL, 100,
 	                                                      10, query1b,
 	                                                      3, false, 0.0,
-	                                                      NULL, NULL, &out_nng1b);
+	                                                      1, NULL, NULL, &out_nng1b);
 	assert_int_equal(ec1b, SCC_ER_OK);
 	assert_equal_digraph(&out_nng1b, &ref_nng1b);
 	iscc_free_digraph(&out_nng1b);
@@ -461,16 +465,16 @@ void scc_ut_make_nng_from_search_object(void** state)
 	iscc_Digraph ref_nng1c;
 	iscc_digraph_from_pieces(100, 4, ref_nn_ref1c, ref_nn_indices1c, &ref_nng1c);
 	iscc_Digraph out_nng1c;
-	scc_ErrorCode ec1c = iscc_make_nng_from_search_object(nn_search_object1, 100,
+	scc_ErrorCode ec1c = iscc_make_nng_from_search_object(scc_ut_test_data_large, nn_search_object1, NULL, 100,
 	                                                      2, query1c,
 	                                                      2, false, 0.0,
-	                                                      NULL, NULL, &out_nng1c);
+	                                                      1, NULL, NULL, &out_nng1c);
 	assert_int_equal(ec1c, SCC_ER_OK);
 	assert_equal_digraph(&out_nng1c, &ref_nng1c);
 	iscc_free_digraph(&out_nng1c);
 	iscc_free_digraph(&ref_nng1c);
 
-	iscc_close_nn_search_object(&nn_search_object1);
+	iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object1);
 
 
 	scc_PointIndex search4b[2] = { 76, 33 };
@@ -485,11 +489,11 @@ void scc_ut_make_nng_from_search_object(void** state)
 	iscc_Digraph out_nng4b;
 	iscc_NNSearchObject* nn_search_object4b;
 	iscc_init_nn_search_object(scc_ut_test_data_large, 2, search4b, &nn_search_object4b);
-	scc_ErrorCode ec4b = iscc_make_nng_from_search_object(nn_search_object4b, 100,
+	scc_ErrorCode ec4b = iscc_make_nng_from_search_object(scc_ut_test_data_large, nn_search_object4b, NULL, 100,
 	                                                      100, NULL,
 	                                                      1, false, 0.0,
-	                                                      NULL, NULL, &out_nng4b);
-	iscc_close_nn_search_object(&nn_search_object4b);
+	                                                      1, NULL, NULL, &out_nng4b);
+	iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object4b);
 	assert_int_equal(ec4b, SCC_ER_OK);
 	assert_equal_digraph(&out_nng4b, &ref_nng4b);
 	iscc_free_digraph(&out_nng4b);
@@ -505,11 +509,11 @@ void scc_ut_make_nng_from_search_object(void** state)
 	iscc_Digraph out_nng5a;
 	iscc_NNSearchObject* nn_search_object5a;
 	iscc_init_nn_search_object(scc_ut_test_data_large, 100, NULL, &nn_search_object5a);
-	scc_ErrorCode ec5a = iscc_make_nng_from_search_object(nn_search_object5a, 100,
+	scc_ErrorCode ec5a = iscc_make_nng_from_search_object(scc_ut_test_data_large, nn_search_object5a, NULL, 100,
 	                                                      1, query5a,
 	                                                      5, false, 0.0,
-	                                                      NULL, NULL, &out_nng5a);
-	iscc_close_nn_search_object(&nn_search_object5a);
+	                                                      1, NULL, NULL, &out_nng5a);
+	iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object5a);
 	assert_int_equal(ec5a, SCC_ER_OK);
 	assert_equal_digraph(&out_nng5a, &ref_nng5a);
 	iscc_free_digraph(&out_nng5a);
@@ -525,11 +529,11 @@ void scc_ut_make_nng_from_search_object(void** state)
 	iscc_Digraph out_nng5b;
 	iscc_NNSearchObject* nn_search_object5b;
 	iscc_init_nn_search_object(scc_ut_test_data_large, 100, NULL, &nn_search_object5b);
-	scc_ErrorCode ec5b = iscc_make_nng_from_search_object(nn_search_object5b, 100,
+	scc_ErrorCode ec5b = iscc_make_nng_from_search_object(scc_ut_test_data_large, nn_search_object5b, NULL, 100,
 	                                                      2, query5b,
 	                                                      4, false, 0.0,
-	                                                      NULL, NULL, &out_nng5b);
-	iscc_close_nn_search_object(&nn_search_object5b);
+	                                                      1, NULL, NULL, &out_nng5b);
+	iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object5b);
 	assert_int_equal(ec5b, SCC_ER_OK);
 	assert_equal_digraph(&out_nng5b, &ref_nng5b);
 	iscc_free_digraph(&out_nng5b);
@@ -545,11 +549,11 @@ void scc_ut_make_nng_from_search_object(void** state)
 	iscc_Digraph out_nng5c;
 	iscc_NNSearchObject* nn_search_object5c;
 	iscc_init_nn_search_object(scc_ut_test_data_large, 50, NULL, &nn_search_object5c);
-	scc_ErrorCode ec5c = iscc_make_nng_from_search_object(nn_search_object5c, 100,
+	scc_ErrorCode ec5c = iscc_make_nng_from_search_object(scc_ut_test_data_large, nn_search_object5c, NULL, 100,
 	                                                      2, query5c,
 	                                                      3, false, 0.0,
-	                                                      NULL, NULL, &out_nng5c);
-	iscc_close_nn_search_object(&nn_search_object5c);
+	                                                      1, NULL, NULL, &out_nng5c);
+	iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object5c);
 	assert_int_equal(ec5c, SCC_ER_OK);
 	assert_equal_digraph(&out_nng5c, &ref_nng5c);
 	iscc_free_digraph(&out_nng5c);
@@ -563,11 +567,11 @@ void scc_ut_make_nng_from_search_object(void** state)
 	iscc_Digraph out_nng6a;
 	iscc_NNSearchObject* nn_search_object6a;
 	iscc_init_nn_search_object(scc_ut_test_data_small, 15, NULL, &nn_search_object6a);
-	scc_ErrorCode ec6a = iscc_make_nng_from_search_object(nn_search_object6a, 15,
+	scc_ErrorCode ec6a = iscc_make_nng_from_search_object(scc_ut_test_data_small, nn_search_object6a, NULL, 15,
 	                                                      15, NULL,
 	                                                      2, false, 0.0,
-	                                                      NULL, NULL, &out_nng6a);
-	iscc_close_nn_search_object(&nn_search_object6a);
+	                                                      1, NULL, NULL, &out_nng6a);
+	iscc_close_nn_search_object(scc_ut_test_data_small, &nn_search_object6a);
 	assert_int_equal(ec6a, SCC_ER_OK);
 	assert_equal_digraph(&out_nng6a, &ref_nng6a);
 	iscc_free_digraph(&out_nng6a);
@@ -581,11 +585,11 @@ void scc_ut_make_nng_from_search_object(void** state)
 	iscc_Digraph out_nng6c;
 	iscc_NNSearchObject* nn_search_object6c;
 	iscc_init_nn_search_object(scc_ut_test_data_small, 10, NULL, &nn_search_object6c);
-	scc_ErrorCode ec6c = iscc_make_nng_from_search_object(nn_search_object6c, 15,
+	scc_ErrorCode ec6c = iscc_make_nng_from_search_object(scc_ut_test_data_small, nn_search_object6c, NULL, 15,
 	                                                      15, NULL,
 	                                                      2, false, 0.0,
-	                                                      NULL, NULL, &out_nng6c);
-	iscc_close_nn_search_object(&nn_search_object6c);
+	                                                      1, NULL, NULL, &out_nng6c);
+	iscc_close_nn_search_object(scc_ut_test_data_small, &nn_search_object6c);
 	assert_int_equal(ec6c, SCC_ER_OK);
 	assert_equal_digraph(&out_nng6c, &ref_nng6c);
 	iscc_free_digraph(&out_nng6c);
@@ -599,11 +603,11 @@ void scc_ut_make_nng_from_search_object(void** state)
 	iscc_Digraph out_nng6d;
 	iscc_NNSearchObject* nn_search_object6d;
 	iscc_init_nn_search_object(scc_ut_test_data_small, 10, NULL, &nn_search_object6d);
-	scc_ErrorCode ec6d = iscc_make_nng_from_search_object(nn_search_object6d, 10,
+	scc_ErrorCode ec6d = iscc_make_nng_from_search_object(scc_ut_test_data_small, nn_search_object6d, NULL, 10,
 	                                                      10, NULL,
 	                                                      2, false, 0.0,
-	                                                      NULL, NULL, &out_nng6d);
-	iscc_close_nn_search_object(&nn_search_object6d);
+	                                                      1, NULL, NULL, &out_nng6d);
+	iscc_close_nn_search_object(scc_ut_test_data_small, &nn_search_object6d);
 	assert_int_equal(ec6d, SCC_ER_OK);
 	assert_equal_digraph(&out_nng6d, &ref_nng6d);
 	iscc_free_digraph(&out_nng6d);
@@ -627,10 +631,10 @@ void scc_ut_make_nng_from_search_object_radius(void** state)
 	iscc_Digraph ref_nng1b;
 	iscc_digraph_from_pieces(100, 21, ref_nn_ref1b, ref_nn_indices1b, &ref_nng1b);
 	iscc_Digraph out_nng1b;
-	scc_ErrorCode ec1b = iscc_make_nng_from_search_object(nn_search_object1, 100,
+	scc_ErrorCode ec1b = iscc_make_nng_from_search_object(scc_ut_test_data_large, nn_search_object1, NULL, 100,
 	                                                      10, query1b,
 	                                                      3, true, 50.0,
-	                                                      NULL, NULL, &out_nng1b);
+	                                                      1, NULL, NULL, &out_nng1b);
 	assert_int_equal(ec1b, SCC_ER_OK);
 	assert_equal_digraph(&out_nng1b, &ref_nng1b);
 	iscc_free_digraph(&out_nng1b);
@@ -647,10 +651,10 @@ void scc_ut_make_nng_from_search_object_radius(void** state)
 	iscc_Digraph ref_nng1c;
 	iscc_digraph_from_pieces(100, 4, ref_nn_ref1c, ref_nn_indices1c, &ref_nng1c);
 	iscc_Digraph out_nng1c;
-	scc_ErrorCode ec1c = iscc_make_nng_from_search_object(nn_search_object1, 100,
+	scc_ErrorCode ec1c = iscc_make_nng_from_search_object(scc_ut_test_data_large, nn_search_object1, NULL, 100,
 	                                                      2, query1c,
 	                                                      2, true, 40.0,
-	                                                      &num_out_indicators1c, out_indicators1c, &out_nng1c);
+	                                                      1, &num_out_indicators1c, out_indicators1c, &out_nng1c);
 	assert_int_equal(ec1c, SCC_ER_OK);
 	assert_equal_digraph(&out_nng1c, &ref_nng1c);
 	assert_int_equal(num_out_indicators1c, 2);
@@ -658,7 +662,7 @@ void scc_ut_make_nng_from_search_object_radius(void** state)
 	iscc_free_digraph(&out_nng1c);
 	iscc_free_digraph(&ref_nng1c);
 
-	iscc_close_nn_search_object(&nn_search_object1);
+	iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object1);
 
 
 	scc_PointIndex search4b[2] = { 76, 33 };
@@ -673,11 +677,11 @@ void scc_ut_make_nng_from_search_object_radius(void** state)
 	iscc_Digraph out_nng4b;
 	iscc_NNSearchObject* nn_search_object4b;
 	iscc_init_nn_search_object(scc_ut_test_data_large, 2, search4b, &nn_search_object4b);
-	scc_ErrorCode ec4b = iscc_make_nng_from_search_object(nn_search_object4b, 100,
+	scc_ErrorCode ec4b = iscc_make_nng_from_search_object(scc_ut_test_data_large, nn_search_object4b, NULL, 100,
 	                                                      100, NULL,
 	                                                      1, true, 20.0,
-	                                                      &num_out_indicators4b, out_indicators4b, &out_nng4b);
-	iscc_close_nn_search_object(&nn_search_object4b);
+	                                                      1, &num_out_indicators4b, out_indicators4b, &out_nng4b);
+	iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object4b);
 	assert_int_equal(ec4b, SCC_ER_OK);
 	assert_equal_digraph(&out_nng4b, &ref_nng4b);
 	assert_int_equal(num_out_indicators4b, 14);
@@ -693,11 +697,11 @@ void scc_ut_make_nng_from_search_object_radius(void** state)
 	iscc_Digraph out_nng5a;
 	iscc_NNSearchObject* nn_search_object5a;
 	iscc_init_nn_search_object(scc_ut_test_data_large, 100, NULL, &nn_search_object5a);
-	scc_ErrorCode ec5a = iscc_make_nng_from_search_object(nn_search_object5a, 100,
+	scc_ErrorCode ec5a = iscc_make_nng_from_search_object(scc_ut_test_data_large, nn_search_object5a, NULL, 100,
 	                                                      num_query5a, query5a,
 	                                                      5, true, 20.0,
-	                                                      &num_query5a, query5a, &out_nng5a);
-	iscc_close_nn_search_object(&nn_search_object5a);
+	                                                      1, &num_query5a, query5a, &out_nng5a);
+	iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object5a);
 	assert_int_equal(ec5a, SCC_ER_OK);
 	assert_equal_digraph(&out_nng5a, &ref_nng5a);
 	assert_int_equal(num_query5a, 0);
@@ -716,11 +720,11 @@ void scc_ut_make_nng_from_search_object_radius(void** state)
 	iscc_Digraph out_nng5b;
 	iscc_NNSearchObject* nn_search_object5b;
 	iscc_init_nn_search_object(scc_ut_test_data_large, 100, NULL, &nn_search_object5b);
-	scc_ErrorCode ec5b = iscc_make_nng_from_search_object(nn_search_object5b, 100,
+	scc_ErrorCode ec5b = iscc_make_nng_from_search_object(scc_ut_test_data_large, nn_search_object5b, NULL, 100,
 	                                                      num_query5b, query5b,
 	                                                      4, true, 20.5,
-	                                                      &num_query5b, query5b, &out_nng5b);
-	iscc_close_nn_search_object(&nn_search_object5b);
+	                                                      1, &num_query5b, query5b, &out_nng5b);
+	iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object5b);
 	assert_int_equal(ec5b, SCC_ER_OK);
 	assert_equal_digraph(&out_nng5b, &ref_nng5b);
 	assert_int_equal(num_query5b, 1);
@@ -738,11 +742,11 @@ void scc_ut_make_nng_from_search_object_radius(void** state)
 	iscc_Digraph out_nng5c;
 	iscc_NNSearchObject* nn_search_object5c;
 	iscc_init_nn_search_object(scc_ut_test_data_large, 50, NULL, &nn_search_object5c);
-	scc_ErrorCode ec5c = iscc_make_nng_from_search_object(nn_search_object5c, 100,
+	scc_ErrorCode ec5c = iscc_make_nng_from_search_object(scc_ut_test_data_large, nn_search_object5c, NULL, 100,
 	                                                      2, query5c,
 	                                                      3, true, 30.0,
-	                                                      NULL, NULL, &out_nng5c);
-	iscc_close_nn_search_object(&nn_search_object5c);
+	                                                      1, NULL, NULL, &out_nng5c);
+	iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object5c);
 	assert_int_equal(ec5c, SCC_ER_OK);
 	assert_equal_digraph(&out_nng5c, &ref_nng5c);
 	iscc_free_digraph(&out_nng5c);
@@ -765,17 +769,19 @@ void scc_ut_make_nng_from_search_object_radius(void** state)
 	iscc_Digraph out_nng5d;
 	iscc_NNSearchObject* nn_search_object5d;
 	iscc_init_nn_search_object(scc_ut_test_data_large, 100, NULL, &nn_search_object5d);
-	scc_ErrorCode ec5d = iscc_make_nng_from_search_object(nn_search_object5d, 100,
+	scc_ErrorCode ec5d = iscc_make_nng_from_search_object(scc_ut_test_data_large, nn_search_object5d, NULL, 100,
 	                                                      100, query5d,
 	                                                      3, true, 0.1,
-	                                                      NULL, NULL, &out_nng5d);
-	iscc_close_nn_search_object(&nn_search_object5d);
+	                                                      1, NULL, NULL, &out_nng5d);
+	iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object5d);
 	assert_int_equal(ec5d, SCC_ER_OK);
 	assert_int_equal(out_nng5d.vertices, 100);
 	assert_int_equal(out_nng5d.max_arcs, 0);
 	assert_null(out_nng5d.head);
-	assert_non_null(out_nng5d.tail_ptr);
-	assert_memory_equal(out_nng5d.tail_ptr, ref_nn_ref5d, 101 * sizeof(iscc_ArcIndex));
+	assert_true(iscc_digraph_is_fixed(&out_nng5d));
+	for (size_t v = 0; v <= 100; ++v) {
+		assert_int_equal(iscc_digraph_row_begin(&out_nng5d, v), ref_nn_ref5d[v]);
+	}
 	iscc_free_digraph(&out_nng5d);
 
 
@@ -796,17 +802,19 @@ void scc_ut_make_nng_from_search_object_radius(void** state)
 	iscc_Digraph out_nng5e;
 	iscc_NNSearchObject* nn_search_object5e;
 	iscc_init_nn_search_object(scc_ut_test_data_large, 100, NULL, &nn_search_object5e);
-	scc_ErrorCode ec5e = iscc_make_nng_from_search_object(nn_search_object5e, 100,
+	scc_ErrorCode ec5e = iscc_make_nng_from_search_object(scc_ut_test_data_large, nn_search_object5e, NULL, 100,
 	                                                      num_query5e, query5e,
 	                                                      3, true, 0.1,
-	                                                      &num_query5e, query5e, &out_nng5e);
-	iscc_close_nn_search_object(&nn_search_object5e);
+	                                                      1, &num_query5e, query5e, &out_nng5e);
+	iscc_close_nn_search_object(scc_ut_test_data_large, &nn_search_object5e);
 	assert_int_equal(ec5e, SCC_ER_OK);
 	assert_int_equal(out_nng5e.vertices, 100);
 	assert_int_equal(out_nng5e.max_arcs, 0);
 	assert_null(out_nng5e.head);
-	assert_non_null(out_nng5e.tail_ptr);
-	assert_memory_equal(out_nng5e.tail_ptr, ref_nn_ref5e, 101 * sizeof(iscc_ArcIndex));
+	assert_true(iscc_digraph_is_fixed(&out_nng5e));
+	for (size_t v = 0; v <= 100; ++v) {
+		assert_int_equal(iscc_digraph_row_begin(&out_nng5e, v), ref_nn_ref5e[v]);
+	}
 	iscc_free_digraph(&out_nng5e);
 	assert_int_equal(num_query5e, 0);
 
@@ -821,11 +829,11 @@ void scc_ut_make_nng_from_search_object_radius(void** state)
 	iscc_Digraph out_nng6a;
 	iscc_NNSearchObject* nn_search_object6a;
 	iscc_init_nn_search_object(scc_ut_test_data_small, 15, NULL, &nn_search_object6a);
-	scc_ErrorCode ec6a = iscc_make_nng_from_search_object(nn_search_object6a, 15,
+	scc_ErrorCode ec6a = iscc_make_nng_from_search_object(scc_ut_test_data_small, nn_search_object6a, NULL, 15,
 	                                                      15, NULL,
 	                                                      2, true, 0.2,
-	                                                      &num_out_indicators6a, out_indicators6a, &out_nng6a);
-	iscc_close_nn_search_object(&nn_search_object6a);
+	                                                      1, &num_out_indicators6a, out_indicators6a, &out_nng6a);
+	iscc_close_nn_search_object(scc_ut_test_data_small, &nn_search_object6a);
 	assert_int_equal(ec6a, SCC_ER_OK);
 	assert_equal_digraph(&out_nng6a, &ref_nng6a);
 	assert_int_equal(num_out_indicators6a, 10);
@@ -844,11 +852,11 @@ void scc_ut_make_nng_from_search_object_radius(void** state)
 	iscc_Digraph out_nng6c;
 	iscc_NNSearchObject* nn_search_object6c;
 	iscc_init_nn_search_object(scc_ut_test_data_small, 10, NULL, &nn_search_object6c);
-	scc_ErrorCode ec6c = iscc_make_nng_from_search_object(nn_search_object6c, 15,
+	scc_ErrorCode ec6c = iscc_make_nng_from_search_object(scc_ut_test_data_small, nn_search_object6c, NULL, 15,
 	                                                      15, NULL,
 	                                                      2, true, 0.3,
-	                                                      &num_out_indicators6c, out_indicators6c, &out_nng6c);
-	iscc_close_nn_search_object(&nn_search_object6c);
+	                                                      1, &num_out_indicators6c, out_indicators6c, &out_nng6c);
+	iscc_close_nn_search_object(scc_ut_test_data_small, &nn_search_object6c);
 	assert_int_equal(ec6c, SCC_ER_OK);
 	assert_equal_digraph(&out_nng6c, &ref_nng6c);
 	assert_int_equal(num_out_indicators6c, 6);
@@ -866,11 +874,11 @@ void scc_ut_make_nng_from_search_object_radius(void** state)
 	iscc_Digraph out_nng6d;
 	iscc_NNSearchObject* nn_search_object6d;
 	iscc_init_nn_search_object(scc_ut_test_data_small, 10, NULL, &nn_search_object6d);
-	scc_ErrorCode ec6d = iscc_make_nng_from_search_object(nn_search_object6d, 10,
+	scc_ErrorCode ec6d = iscc_make_nng_from_search_object(scc_ut_test_data_small, nn_search_object6d, NULL, 10,
 	                                                      10, NULL,
 	                                                      2, true, 0.2,
-	                                                      &num_out_indicators6d, out_indicators6d, &out_nng6d);
-	iscc_close_nn_search_object(&nn_search_object6d);
+	                                                      1, &num_out_indicators6d, out_indicators6d, &out_nng6d);
+	iscc_close_nn_search_object(scc_ut_test_data_small, &nn_search_object6d);
 	assert_int_equal(ec6d, SCC_ER_OK);
 	assert_equal_digraph(&out_nng6d, &ref_nng6d);
 	assert_int_equal(num_out_indicators6d, 4);
@@ -1060,7 +1068,10 @@ void scc_ut_assign_seeds_and_neighbors(void** state)
 	scc_Clustering* cl1;
 	assert_int_equal(scc_init_empty_clustering(10, external_cluster_labels, &cl1), SCC_ER_OK);
 	const scc_Clabel ref_cluster_label1[10] = { 0, 0, 1, 1, 1, 0, M, 2, 2, 2 };
-	size_t num_assigned1 = iscc_assign_seeds_and_neighbors(cl1, &sr1, &nng1);
+	iscc_DigraphRowReader reader1;
+	assert_int_equal(iscc_init_row_reader(&nng1, &reader1), SCC_ER_OK);
+	size_t num_assigned1 = iscc_assign_seeds_and_neighbors(cl1, &sr1, &nng1, &reader1);
+	iscc_free_row_reader(&reader1);
 	assert_int_equal(num_assigned1, 9);
 	assert_int_equal(cl1->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl1->num_data_points, 10);
@@ -1094,7 +1105,10 @@ void scc_ut_assign_seeds_and_neighbors(void** state)
 	scc_Clustering* cl2;
 	assert_int_equal(scc_init_empty_clustering(10, external_cluster_labels, &cl2), SCC_ER_OK);
 	const scc_Clabel ref_cluster_label2[10] = { 0, 0, M, 0, M, 0, M, 1, 1, 1 };
-	size_t num_assigned2 = iscc_assign_seeds_and_neighbors(cl2, &sr2, &nng2);
+	iscc_DigraphRowReader reader2;
+	assert_int_equal(iscc_init_row_reader(&nng2, &reader2), SCC_ER_OK);
+	size_t num_assigned2 = iscc_assign_seeds_and_neighbors(cl2, &sr2, &nng2, &reader2);
+	iscc_free_row_reader(&reader2);
 	assert_int_equal(num_assigned2, 7);
 	assert_int_equal(cl2->clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(cl2->num_data_points, 10);
@@ -1143,7 +1157,10 @@ void scc_ut_assign_by_nng(void** state)
 	                         "..... ..... #.##./"
 	                         ".#.#. #..#. ..#../"
 	                         "..#.. ###.. ..##./", &nng1);
-	size_t num_assigned1 = iscc_assign_by_nng(&clust1, &nng1);
+	iscc_DigraphRowReader reader1;
+	assert_int_equal(iscc_init_row_reader(&nng1, &reader1), SCC_ER_OK);
+	size_t num_assigned1 = iscc_assign_by_nng(&clust1, &nng1, &reader1);
+	iscc_free_row_reader(&reader1);
 	assert_int_equal(num_assigned1, 5);
 	assert_int_equal(clust1.clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(clust1.num_data_points, 15);
@@ -1182,7 +1199,10 @@ void scc_ut_assign_by_nng(void** state)
 	                         "..... ..... #.##./"
 	                         "..... ..#.# ...#./"
 	                         "..#.. ###.. ..##./", &nng2);
-	size_t num_assigned2 = iscc_assign_by_nng(&clust2, &nng2);
+	iscc_DigraphRowReader reader2;
+	assert_int_equal(iscc_init_row_reader(&nng2, &reader2), SCC_ER_OK);
+	size_t num_assigned2 = iscc_assign_by_nng(&clust2, &nng2, &reader2);
+	iscc_free_row_reader(&reader2);
 	assert_int_equal(num_assigned2, 3);
 	assert_int_equal(clust2.clustering_version, ISCC_CLUSTERING_STRUCT_VERSION);
 	assert_int_equal(clust2.num_data_points, 15);
@@ -1215,8 +1235,9 @@ void scc_ut_assign_by_nn_search(void** state)
 	assert_true(iscc_init_nn_search_object(&scc_ut_test_data_small_struct, 5, search_indices1, &nn_search_object1));
 	scc_PointIndex to_assign1[3] = { 5, 7, 9 };
 	scc_ErrorCode ec1 = iscc_assign_by_nn_search(&clust1,
+	                                             &scc_ut_test_data_small_struct,
 	                                             nn_search_object1,
-	                                             3,
+	                                             NULL, 3,
 	                                             to_assign1,
 	                                             false,
 	                                             0.0);
@@ -1227,7 +1248,7 @@ void scc_ut_assign_by_nn_search(void** state)
 	const scc_Clabel ref_cl_labels1[15] = { 0, 1, 2, 3, 4, 3, 4, 1, 3, 3, 2, M, 1, M, 0 };
 	assert_memory_equal(clust1.cluster_label, ref_cl_labels1, 15 * sizeof(scc_Clabel));
 	assert_true(clust1.external_labels);
-	assert_true(iscc_close_nn_search_object(&nn_search_object1));
+	assert_true(iscc_close_nn_search_object(&scc_ut_test_data_small_struct, &nn_search_object1));
 
 
 	scc_Clabel cl_labels2[15] = { 0, 1, 2, 3, 4,
@@ -1245,8 +1266,9 @@ void scc_ut_assign_by_nn_search(void** state)
 	assert_true(iscc_init_nn_search_object(&scc_ut_test_data_small_struct, 5, search_indices2, &nn_search_object2));
 	scc_PointIndex to_assign2[3] = { 5, 7, 9 };
 	scc_ErrorCode ec2 = iscc_assign_by_nn_search(&clust2,
+	                                             &scc_ut_test_data_small_struct,
 	                                             nn_search_object2,
-	                                             3,
+	                                             NULL, 3,
 	                                             to_assign2,
 	                                             true,
 	                                             0.3);
@@ -1257,7 +1279,7 @@ void scc_ut_assign_by_nn_search(void** state)
 	const scc_Clabel ref_cl_labels2[15] = { 0, 1, 2, 3, 4, M, 4, 1, 3, M, 2, M, 1, M, 0 };
 	assert_memory_equal(clust2.cluster_label, ref_cl_labels2, 15 * sizeof(scc_Clabel));
 	assert_true(clust2.external_labels);
-	assert_true(iscc_close_nn_search_object(&nn_search_object2));
+	assert_true(iscc_close_nn_search_object(&scc_ut_test_data_small_struct, &nn_search_object2));
 
 
 	scc_Clabel cl_labels3[15] = { 4, 1, 3, 2, 0,
@@ -1275,8 +1297,9 @@ void scc_ut_assign_by_nn_search(void** state)
 	assert_true(iscc_init_nn_search_object(&scc_ut_test_data_small_struct, 10, search_indices3, &nn_search_object3));
 	scc_PointIndex to_assign3[5] = { 5, 6, 7, 8, 9 };
 	scc_ErrorCode ec3 = iscc_assign_by_nn_search(&clust3,
+	                                             &scc_ut_test_data_small_struct,
 	                                             nn_search_object3,
-	                                             5,
+	                                             NULL, 5,
 	                                             to_assign3,
 	                                             false,
 	                                             0.0);
@@ -1287,7 +1310,7 @@ void scc_ut_assign_by_nn_search(void** state)
 	const scc_Clabel ref_cl_labels3[15] = { 4, 1, 3, 2, 0, 2, 4, 1, 4, 2, 2, 1, 4, 3, 0 };
 	assert_memory_equal(clust3.cluster_label, ref_cl_labels3, 15 * sizeof(scc_Clabel));
 	assert_true(clust3.external_labels);
-	assert_true(iscc_close_nn_search_object(&nn_search_object3));
+	assert_true(iscc_close_nn_search_object(&scc_ut_test_data_small_struct, &nn_search_object3));
 
 
 	scc_Clabel cl_labels4[15] = { 4, 1, 3, 2, 0,
@@ -1305,8 +1328,9 @@ void scc_ut_assign_by_nn_search(void** state)
 	assert_true(iscc_init_nn_search_object(&scc_ut_test_data_small_struct, 10, search_indices4, &nn_search_object4));
 	scc_PointIndex to_assign4[5] = { 5, 6, 7, 8, 9 };
 	scc_ErrorCode ec4 = iscc_assign_by_nn_search(&clust4,
+	                                             &scc_ut_test_data_small_struct,
 	                                             nn_search_object4,
-	                                             5,
+	                                             NULL, 5,
 	                                             to_assign4,
 	                                             true,
 	                                             0.2);
@@ -1317,7 +1341,7 @@ void scc_ut_assign_by_nn_search(void** state)
 	const scc_Clabel ref_cl_labels4[15] = { 4, 1, 3, 2, 0, M, 4, 1, 4, M, 2, 1, 4, 3, 0 };
 	assert_memory_equal(clust4.cluster_label, ref_cl_labels4, 15 * sizeof(scc_Clabel));
 	assert_true(clust4.external_labels);
-	assert_true(iscc_close_nn_search_object(&nn_search_object4));
+	assert_true(iscc_close_nn_search_object(&scc_ut_test_data_small_struct, &nn_search_object4));
 }
 
 
@@ -66,7 +66,7 @@ void scc_ut_get_nng_with_size_constraint_stable(void** state)
 
 	iscc_Digraph out_nng1;
 	scc_ErrorCode ec1 = iscc_get_nng_with_size_constraint(&scc_ut_test_data_small_struct,
-	                                                      15, 3, 0, NULL, false, 0.0, &out_nng1);
+	                                                      15, 3, 0, NULL, false, 0.0, 1, NULL, &out_nng1);
 	iscc_Digraph ref_nng1;
 	iscc_digraph_from_string("..... ..##. ...../"
 	                         "....# ..#.. ...../"
@@ -93,7 +93,7 @@ void scc_ut_get_nng_with_size_constraint_stable(void** state)
 
 	iscc_Digraph out_nng2;
 	scc_ErrorCode ec2 = iscc_get_nng_with_size_constraint(&scc_ut_test_data_small_struct,
-	                                                      15, 3, 0, NULL, true, 0.2, &out_nng2);
+	                                                      15, 3, 0, NULL, true, 0.2, 1, NULL, &out_nng2);
 	iscc_Digraph ref_nng2;
 	iscc_digraph_from_string("..... ..... ...../"
 	                         "..... ..... ...../"
@@ -120,7 +120,7 @@ void scc_ut_get_nng_with_size_constraint_stable(void** state)
 
 	iscc_Digraph out_nng3;
 	scc_ErrorCode ec3 = iscc_get_nng_with_size_constraint(&scc_ut_test_data_small_struct,
-	                                                      15, 3, 10, primary_data_points, false, 0.0, &out_nng3);
+	                                                      15, 3, 10, primary_data_points, false, 0.0, 1, NULL, &out_nng3);
 	iscc_Digraph ref_nng3;
 	iscc_digraph_from_string("..... ..##. ...../"
 	                         "....# ..#.. ...../"
@@ -147,7 +147,7 @@ void scc_ut_get_nng_with_size_constraint_stable(void** state)
 
 	iscc_Digraph out_nng4;
 	scc_ErrorCode ec4 = iscc_get_nng_with_size_constraint(&scc_ut_test_data_small_struct,
-	                                                      15, 3, 10, primary_data_points, true, 0.2, &out_nng4);
+	                                                      15, 3, 10, primary_data_points, true, 0.2, 1, NULL, &out_nng4);
 	iscc_Digraph ref_nng4;
 	iscc_digraph_from_string("..... ..... ...../"
 	                         "..... ..... ...../"
@@ -174,7 +174,7 @@ void scc_ut_get_nng_with_size_constraint_stable(void** state)
 
 	iscc_Digraph out_nng5;
 	scc_ErrorCode ec5 = iscc_get_nng_with_size_constraint(&scc_ut_test_data_small_struct,
-	                                                      15, 2, 0, NULL, false, 0.0, &out_nng5);
+	                                                      15, 2, 0, NULL, false, 0.0, 1, NULL, &out_nng5);
 	iscc_Digraph ref_nng5;
 	iscc_digraph_from_string("..... ...#. ...../"
 	                         "..... ..#.. ...../"
@@ -201,7 +201,7 @@ void scc_ut_get_nng_with_size_constraint_stable(void** state)
 
 	iscc_Digraph out_nng6;
 	scc_ErrorCode ec6 = iscc_get_nng_with_size_constraint(&scc_ut_test_data_small_struct,
-	                                                      15, 2, 0, NULL, true, 0.2, &out_nng6);
+	                                                      15, 2, 0, NULL, true, 0.2, 1, NULL, &out_nng6);
 	iscc_Digraph ref_nng6;
 	iscc_digraph_from_string("..... ...#. ...../"
 	                         "..... ..#.. ...../"
@@ -228,7 +228,7 @@ void scc_ut_get_nng_with_size_constraint_stable(void** state)
 
 	iscc_Digraph out_nng7;
 	scc_ErrorCode ec7 = iscc_get_nng_with_size_constraint(&scc_ut_test_data_small_struct,
-	                                                      15, 2, 10, primary_data_points, false, 0.0, &out_nng7);
+	                                                      15, 2, 10, primary_data_points, false, 0.0, 1, NULL, &out_nng7);
 	iscc_Digraph ref_nng7;
 	iscc_digraph_from_string("..... ...#. ...../"
 	                         "..... ..#.. ...../"
@@ -255,7 +255,7 @@ void scc_ut_get_nng_with_size_constraint_stable(void** state)
 
 	iscc_Digraph out_nng8;
 	scc_ErrorCode ec8 = iscc_get_nng_with_size_constraint(&scc_ut_test_data_small_struct,
-	                                                      15, 2, 10, primary_data_points, true, 0.2, &out_nng8);
+	                                                      15, 2, 10, primary_data_points, true, 0.2, 1, NULL, &out_nng8);
 	iscc_Digraph ref_nng8;
 	iscc_digraph_from_string("..... ...#. ...../"
 	                         "..... ..#.. ...../"
@@ -281,7 +281,7 @@ void scc_ut_get_nng_with_size_constraint_stable(void** state)
 
 	iscc_Digraph out_nng9;
 	scc_ErrorCode ec9 = iscc_get_nng_with_size_constraint(&scc_ut_test_data_small_struct,
-	                                                      15, 3, 0, NULL, true, 0.01, &out_nng9);
+	                                                      15, 3, 0, NULL, true, 0.01, 1, NULL, &out_nng9);
 	assert_int_equal(ec9, SCC_ER_NO_SOLUTION);
 }
 
@@ -305,7 +305,7 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec1 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 2,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      0, NULL, false, 0.0, &out_nng1);
+	                                                      0, NULL, false, 0.0, 1, NULL, &out_nng1);
 	iscc_Digraph ref_nng1;
 	iscc_digraph_from_string("..... ...#. ...../"
 	                         "..... ..... ...#./"
@@ -334,7 +334,7 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec2 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 2,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      0, NULL, true, 0.3, &out_nng2);
+	                                                      0, NULL, true, 0.3, 1, NULL, &out_nng2);
 	iscc_Digraph ref_nng2;
 	iscc_digraph_from_string("..... ...#. ...../"
 	                         "..... ..... ...../"
@@ -363,7 +363,7 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec3 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 2,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      10, primary_data_points, false, 0.0, &out_nng3);
+	                                                      10, primary_data_points, false, 0.0, 1, NULL, &out_nng3);
 	iscc_Digraph ref_nng3;
 	iscc_digraph_from_string("..... ...#. ...../"
 	                         "..... ..... ...#./"
@@ -392,7 +392,7 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec4 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 2,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      10, primary_data_points, true, 0.3, &out_nng4);
+	                                                      10, primary_data_points, true, 0.3, 1, NULL, &out_nng4);
 	iscc_Digraph ref_nng4;
 	iscc_digraph_from_string("..... ...#. ...../"
 	                         "..... ..... ...../"
@@ -421,7 +421,7 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec5 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      0, NULL, false, 0.0, &out_nng5);
+	                                                      0, NULL, false, 0.0, 1, NULL, &out_nng5);
 	iscc_Digraph ref_nng5;
 	iscc_digraph_from_string("..... ..##. ...../"
 	                         "..... ..#.. ...#./"
@@ -450,7 +450,7 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec6 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      0, NULL, true, 0.3, &out_nng6);
+	                                                      0, NULL, true, 0.3, 1, NULL, &out_nng6);
 	iscc_Digraph ref_nng6;
 	iscc_digraph_from_string("..... ..... ...../"
 	                         "..... ..... ...../"
@@ -479,7 +479,7 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec7 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      10, primary_data_points, false, 0.0, &out_nng7);
+	                                                      10, primary_data_points, false, 0.0, 1, NULL, &out_nng7);
 	iscc_Digraph ref_nng7;
 	iscc_digraph_from_string("..... ..##. ...../"
 	                         "..... ..#.. ...#./"
@@ -508,7 +508,7 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec8 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      10, primary_data_points, true, 0.3, &out_nng8);
+	                                                      10, primary_data_points, true, 0.3, 1, NULL, &out_nng8);
 	iscc_Digraph ref_nng8;
 	iscc_digraph_from_string("..... ..... ...../"
 	                         "..... ..... ...../"
@@ -537,7 +537,7 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec9 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      3, type_constraints_three, type_labels_three,
-	                                                      0, NULL, false, 0.0, &out_nng9);
+	                                                      0, NULL, false, 0.0, 1, NULL, &out_nng9);
 	iscc_Digraph ref_nng9;
 	iscc_digraph_from_string("....# ..... ...#./"
 	                         "#...# ..... ...#./"
@@ -566,7 +566,7 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec10 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      3, type_constraints_three, type_labels_three,
-	                                                      0, NULL, true, 0.5, &out_nng10);
+	                                                      0, NULL, true, 0.5, 1, NULL, &out_nng10);
 	iscc_Digraph ref_nng10;
 	iscc_digraph_from_string("..... ..... ...../"
 	                         "..... ..... ...../"
@@ -595,7 +595,7 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec11 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      3, type_constraints_three, type_labels_three,
-	                                                      10, primary_data_points, false, 0.0, &out_nng11);
+	                                                      10, primary_data_points, false, 0.0, 1, NULL, &out_nng11);
 	iscc_Digraph ref_nng11;
 	iscc_digraph_from_string("....# ..... ...#./"
 	                         "#...# ..... ...#./"
@@ -624,7 +624,7 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec12 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      3, type_constraints_three, type_labels_three,
-	                                                      10, primary_data_points, true, 0.5, &out_nng12);
+	                                                      10, primary_data_points, true, 0.5, 1, NULL, &out_nng12);
 	iscc_Digraph ref_nng12;
 	iscc_digraph_from_string("..... ..... ...../"
 	                         "..... ..... ...../"
@@ -653,7 +653,7 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec13 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                       15, 4,
 	                                                       3, type_constraints_three, type_labels_three,
-	                                                       0, NULL, false, 0.0, &out_nng13);
+	                                                       0, NULL, false, 0.0, 1, NULL, &out_nng13);
 	iscc_Digraph ref_nng13;
 	iscc_digraph_from_string("....# ...#. ...#./"
 	                         "#...# ..... ...#./"
@@ -682,7 +682,7 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec14 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                       15, 4,
 	                                                       3, type_constraints_three, type_labels_three,
-	                                                       0, NULL, true, 0.5, &out_nng14);
+	                                                       0, NULL, true, 0.5, 1, NULL, &out_nng14);
 	iscc_Digraph ref_nng14;
 	iscc_digraph_from_string("..... ..... ...../"
 	                         "..... ..... ...../"
@@ -711,7 +711,7 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec15 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                       15, 4,
 	                                                       3, type_constraints_three, type_labels_three,
-	                                                       10, primary_data_points, false, 0.0, &out_nng15);
+	                                                       10, primary_data_points, false, 0.0, 1, NULL, &out_nng15);
 	iscc_Digraph ref_nng15;
 	iscc_digraph_from_string("....# ...#. ...#./"
 	                         "#...# ..... ...#./"
@@ -740,7 +740,7 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec16 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                       15, 4,
 	                                                       3, type_constraints_three, type_labels_three,
-	                                                       10, primary_data_points, true, 0.5, &out_nng16);
+	                                                       10, primary_data_points, true, 0.5, 1, NULL, &out_nng16);
 	iscc_Digraph ref_nng16;
 	iscc_digraph_from_string("..... ..... ...../"
 	                         "..... ..... ...../"
@@ -769,7 +769,7 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec17 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 2,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      0, NULL, true, 1.0, &out_nng17);
+	                                                      0, NULL, true, 1.0, 1, NULL, &out_nng17);
 	assert_int_equal(ec17, SCC_ER_OK);
 	iscc_free_digraph(&out_nng17);
 
@@ -777,7 +777,7 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec18 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 2,
 	                                                      2, type_constraints_two, type_labels_two,
-	                                                      0, NULL, true, 0.01, &out_nng18);
+	                                                      0, NULL, true, 0.01, 1, NULL, &out_nng18);
 	assert_int_equal(ec18, SCC_ER_NO_SOLUTION);
 
 
@@ -788,7 +788,7 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec19 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 2,
 	                                                      2, type_constraints_two_mod, type_labels_two,
-	                                                      7, primary_data_points_mod, true, 0.04, &out_nng19);
+	                                                      7, primary_data_points_mod, true, 0.04, 1, NULL, &out_nng19);
 	assert_int_equal(ec19, SCC_ER_OK);
 	iscc_free_digraph(&out_nng19);
 
@@ -796,21 +796,21 @@ void scc_ut_get_nng_with_type_constraint_stable(void** state)
 	scc_ErrorCode ec20 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 2,
 	                                                      2, type_constraints_two_mod, type_labels_two,
-	                                                      7, primary_data_points_mod, true, 0.03, &out_nng20);
+	                                                      7, primary_data_points_mod, true, 0.03, 1, NULL, &out_nng20);
 	assert_int_equal(ec20, SCC_ER_NO_SOLUTION);
 
 	iscc_Digraph out_nng21;
 	scc_ErrorCode ec21 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      2, type_constraints_two_mod, type_labels_two,
-	                                                      7, primary_data_points_mod, true, 0.04, &out_nng21);
+	                                                      7, primary_data_points_mod, true, 0.04, 1, NULL, &out_nng21);
 	assert_int_equal(ec21, SCC_ER_NO_SOLUTION);
 
 	iscc_Digraph out_nng22;
 	scc_ErrorCode ec22 = iscc_get_nng_with_type_constraint(&scc_ut_test_data_small_struct,
 	                                                      15, 3,
 	                                                      2, type_constraints_two_mod, type_labels_two,
-	                                                      7, primary_data_points_mod, true, 0.06, &out_nng22);
+	                                                      7, primary_data_points_mod, true, 0.06, 1, NULL, &out_nng22);
 	assert_int_equal(ec22, SCC_ER_OK);
 	iscc_free_digraph(&out_nng22);
 }
@@ -19,7 +19,9 @@
  * ========================================================================== */
 
 #include "init_test.h"
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdlib.h>
 #include <include/scclust.h>
 #include <src/digraph_core.h>
 #include <src/digraph_debug.h>
@@ -62,7 +64,7 @@ void scc_ut_find_seeds(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec1 = iscc_find_seeds(&nng, SCC_SM_LEXICAL, &sr1);
+	scc_ErrorCode ec1 = iscc_find_seeds(&nng, SCC_SM_LEXICAL, 1, &sr1);
 	assert_int_equal(ec1, SCC_ER_OK);
 	assert_int_equal(sr1.count, 5);
 	assert_int_equal(sr1.capacity, sr1.count);
@@ -75,7 +77,7 @@ void scc_ut_find_seeds(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec2 = iscc_find_seeds(&nng, SCC_SM_INWARDS_ORDER, &sr2);
+	scc_ErrorCode ec2 = iscc_find_seeds(&nng, SCC_SM_INWARDS_ORDER, 1, &sr2);
 	assert_int_equal(ec2, SCC_ER_OK);
 	assert_int_equal(sr2.count, 5);
 	assert_int_equal(sr2.capacity, sr2.count);
@@ -88,7 +90,7 @@ void scc_ut_find_seeds(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec3 = iscc_find_seeds(&nng, SCC_SM_INWARDS_UPDATING, &sr3);
+	scc_ErrorCode ec3 = iscc_find_seeds(&nng, SCC_SM_INWARDS_UPDATING, 1, &sr3);
 	assert_int_equal(ec3, SCC_ER_OK);
 	assert_int_equal(sr3.count, 5);
 	assert_int_equal(sr3.capacity, sr3.count);
@@ -101,7 +103,7 @@ void scc_ut_find_seeds(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec3alt = iscc_find_seeds(&nng, SCC_SM_INWARDS_UPDATING, &sr3alt);
+	scc_ErrorCode ec3alt = iscc_find_seeds(&nng, SCC_SM_INWARDS_UPDATING, 1, &sr3alt);
 	assert_int_equal(ec3alt, SCC_ER_OK);
 	assert_int_equal(sr3alt.count, 5);
 	assert_int_equal(sr3alt.capacity, sr3alt.count);
@@ -114,7 +116,7 @@ void scc_ut_find_seeds(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec4 = iscc_find_seeds(&nng, SCC_SM_EXCLUSION_ORDER, &sr4);
+	scc_ErrorCode ec4 = iscc_find_seeds(&nng, SCC_SM_EXCLUSION_ORDER, 1, &sr4);
 	assert_int_equal(ec4, SCC_ER_OK);
 	assert_int_equal(sr4.count, 4);
 	assert_int_equal(sr4.capacity, sr4.count);
@@ -127,7 +129,7 @@ void scc_ut_find_seeds(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec5 = iscc_find_seeds(&nng, SCC_SM_EXCLUSION_UPDATING, &sr5);
+	scc_ErrorCode ec5 = iscc_find_seeds(&nng, SCC_SM_EXCLUSION_UPDATING, 1, &sr5);
 	assert_int_equal(ec5, SCC_ER_OK);
 	assert_int_equal(sr5.count, 5);
 	assert_int_equal(sr5.capacity, sr5.count);
@@ -175,7 +177,7 @@ void scc_ut_find_seeds_withdiag(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec1 = iscc_find_seeds(&nng, SCC_SM_LEXICAL, &sr1);
+	scc_ErrorCode ec1 = iscc_find_seeds(&nng, SCC_SM_LEXICAL, 1, &sr1);
 	assert_int_equal(ec1, SCC_ER_OK);
 	assert_int_equal(sr1.count, 5);
 	assert_int_equal(sr1.capacity, sr1.count);
@@ -188,7 +190,7 @@ void scc_ut_find_seeds_withdiag(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec2 = iscc_find_seeds(&nng, SCC_SM_INWARDS_ORDER, &sr2);
+	scc_ErrorCode ec2 = iscc_find_seeds(&nng, SCC_SM_INWARDS_ORDER, 1, &sr2);
 	assert_int_equal(ec2, SCC_ER_OK);
 	assert_int_equal(sr2.count, 5);
 	assert_int_equal(sr2.capacity, sr2.count);
@@ -201,7 +203,7 @@ void scc_ut_find_seeds_withdiag(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec3 = iscc_find_seeds(&nng, SCC_SM_INWARDS_UPDATING, &sr3);
+	scc_ErrorCode ec3 = iscc_find_seeds(&nng, SCC_SM_INWARDS_UPDATING, 1, &sr3);
 	assert_int_equal(ec3, SCC_ER_OK);
 	assert_int_equal(sr3.count, 5);
 	assert_int_equal(sr3.capacity, sr3.count);
@@ -214,7 +216,7 @@ void scc_ut_find_seeds_withdiag(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec3alt = iscc_find_seeds(&nng, SCC_SM_INWARDS_UPDATING, &sr3alt);
+	scc_ErrorCode ec3alt = iscc_find_seeds(&nng, SCC_SM_INWARDS_UPDATING, 1, &sr3alt);
 	assert_int_equal(ec3alt, SCC_ER_OK);
 	assert_int_equal(sr3alt.count, 5);
 	assert_int_equal(sr3alt.capacity, sr3alt.count);
@@ -227,7 +229,7 @@ void scc_ut_find_seeds_withdiag(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec4 = iscc_find_seeds(&nng, SCC_SM_EXCLUSION_ORDER, &sr4);
+	scc_ErrorCode ec4 = iscc_find_seeds(&nng, SCC_SM_EXCLUSION_ORDER, 1, &sr4);
 	assert_int_equal(ec4, SCC_ER_OK);
 	assert_int_equal(sr4.count, 4);
 	assert_int_equal(sr4.capacity, sr4.count);
@@ -240,7 +242,7 @@ void scc_ut_find_seeds_withdiag(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec5 = iscc_find_seeds(&nng, SCC_SM_EXCLUSION_UPDATING, &sr5);
+	scc_ErrorCode ec5 = iscc_find_seeds(&nng, SCC_SM_EXCLUSION_UPDATING, 1, &sr5);
 	assert_int_equal(ec5, SCC_ER_OK);
 	assert_int_equal(sr5.count, 5);
 	assert_int_equal(sr5.capacity, sr5.count);
@@ -257,6 +259,178 @@ void scc_ut_find_seeds_withdiag(void** state)
 }
 
 
+static void scc_ut_check_parallel_seeds(const iscc_Digraph* const nng,
+                                        const scc_SeedMethod seed_method)
+{
+	iscc_SeedResult sr1 = {
+		.capacity = 1,
+		.count = 0,
+		.seeds = NULL,
+	};
+	iscc_SeedResult sr4 = {
+		.capacity = 1,
+		.count = 0,
+		.seeds = NULL,
+	};
+	assert_int_equal(iscc_find_seeds(nng, seed_method, 1, &sr1), SCC_ER_OK);
+	assert_int_equal(iscc_find_seeds(nng, seed_method, 4, &sr4), SCC_ER_OK);
+	assert_int_equal(sr1.count, sr4.count);
+	assert_memory_equal(sr1.seeds, sr4.seeds, sr1.count * sizeof(scc_PointIndex));
+
+	// Seeds have arcs and disjoint closed neighborhoods
+	bool* const marks = calloc(nng->vertices, sizeof(bool));
+	for (size_t i = 0; i < sr1.count; ++i) {
+		const scc_PointIndex s = sr1.seeds[i];
+		assert_true(nng->tail_ptr[s] != nng->tail_ptr[s + 1]);
+		assert_false(marks[s]);
+		for (size_t a = nng->tail_ptr[s]; a < nng->tail_ptr[s + 1]; ++a) {
+			assert_false(marks[nng->head[a]]);
+		}
+		for (size_t a = nng->tail_ptr[s]; a < nng->tail_ptr[s + 1]; ++a) {
+			marks[nng->head[a]] = true;
+		}
+		marks[s] = true;
+	}
+
+	// No further seed can be added
+	for (size_t v = 0; v < nng->vertices; ++v) {
+		if (nng->tail_ptr[v] == nng->tail_ptr[v + 1]) continue;
+		bool excluded = marks[v];
+		for (size_t a = nng->tail_ptr[v]; a < nng->tail_ptr[v + 1]; ++a) {
+			excluded = excluded || marks[nng->head[a]];
+		}
+		assert_true(excluded);
+	}
+
+	free(marks);
+	free(sr1.seeds);
+	free(sr4.seeds);
+}
+
+
+void scc_ut_find_seeds_parallel(void** state)
+{
+	(void) state;
+
+	iscc_Digraph nng1;
+	iscc_digraph_from_string(".#..#............./"
+	                         "#...#............./"
+	                         "....#..#........../"
+	                         "#...#............./"
+	                         ".#.#............../"
+	                         "..#.....#........./"
+	                         "...#.....#......../"
+	                         "......#.#........./"
+	                         ".....#.....#....../"
+	                         "..........#.....#./"
+	                         ".......#.....#..../"
+	                         "........#.#......./"
+	                         "...............##./"
+	                         "..............#..#/"
+	                         ".............#...#/"
+	                         ".........#..#...../"
+	                         ".............##.../"
+	                         "..............#.#./",
+	                         &nng1);
+	scc_ut_check_parallel_seeds(&nng1, SCC_SM_INWARDS_PARALLEL);
+	scc_ut_check_parallel_seeds(&nng1, SCC_SM_EXCLUSION_PARALLEL);
+	iscc_free_digraph(&nng1);
+
+	// Pseudo-random graph where every tenth vertex lacks arcs
+	const size_t vertices2 = 2000;
+	iscc_Digraph nng2;
+	assert_int_equal(iscc_init_digraph(vertices2, 3 * vertices2, &nng2), SCC_ER_OK);
+	uint32_t lcg = 12345;
+	iscc_ArcIndex num_arcs = 0;
+	nng2.tail_ptr[0] = 0;
+	for (size_t v = 0; v < vertices2; ++v) {
+		if ((v % 10) != 9) {
+			for (size_t a = 0; a < 3; ++a) {
+				lcg = lcg * 1664525u + 1013904223u;
+				nng2.head[num_arcs] = (scc_PointIndex) ((lcg >> 8) % vertices2);
+				++num_arcs;
+			}
+		}
+		nng2.tail_ptr[v + 1] = num_arcs;
+	}
+	scc_ut_check_parallel_seeds(&nng2, SCC_SM_INWARDS_PARALLEL);
+	scc_ut_check_parallel_seeds(&nng2, SCC_SM_EXCLUSION_PARALLEL);
+	iscc_free_digraph(&nng2);
+}
+
+
+void scc_ut_find_seeds_compressed(void** state)
+{
+	(void) state;
+
+	// Pseudo-random graphs where every tenth vertex lacks arcs, with 3 and 10 arcs per vertex
+	const size_t vertices = 2000;
+	for (size_t k = 3; k <= 10; k += 7) {
+		iscc_Digraph nng;
+		assert_int_equal(iscc_init_digraph(vertices, k * vertices, &nng), SCC_ER_OK);
+		uint32_t lcg = 12345;
+		iscc_ArcIndex num_arcs = 0;
+		nng.tail_ptr[0] = 0;
+		for (size_t v = 0; v < vertices; ++v) {
+			if ((v % 10) != 9) {
+				for (size_t a = 0; a < k; ++a) {
+					lcg = lcg * 1664525u + 1013904223u;
+					nng.head[num_arcs] = (scc_PointIndex) ((v + 1 + 100 * a + (lcg >> 8) % 100) % vertices);
+					++num_arcs;
+				}
+			}
+			nng.tail_ptr[v + 1] = num_arcs;
+		}
+
+		iscc_Digraph compressed_nng;
+		assert_int_equal(iscc_copy_digraph(&nng, &compressed_nng), SCC_ER_OK);
+		assert_int_equal(iscc_digraph_compress(&compressed_nng), SCC_ER_OK);
+
+		// Only the updating methods depend on the order of the arcs
+		const scc_SeedMethod seed_methods[7] = { SCC_SM_LEXICAL, SCC_SM_INWARDS_ORDER, SCC_SM_EXCLUSION_ORDER,
+		                                         SCC_SM_INWARDS_PARALLEL, SCC_SM_EXCLUSION_PARALLEL,
+		                                         SCC_SM_INWARDS_UPDATING, SCC_SM_EXCLUSION_UPDATING };
+		for (size_t m = 0; m < 7; ++m) {
+			iscc_SeedResult sr1 = {
+				.capacity = 1,
+				.count = 0,
+				.seeds = NULL,
+			};
+			iscc_SeedResult sr2 = {
+				.capacity = 1,
+				.count = 0,
+				.seeds = NULL,
+			};
+			assert_int_equal(iscc_find_seeds(&nng, seed_methods[m], 4, &sr1), SCC_ER_OK);
+			assert_int_equal(iscc_find_seeds(&compressed_nng, seed_methods[m], 4, &sr2), SCC_ER_OK);
+			if (m < 5) {
+				assert_int_equal(sr1.count, sr2.count);
+				assert_memory_equal(sr1.seeds, sr2.seeds, sr1.count * sizeof(scc_PointIndex));
+			}
+
+			// Seeds have arcs and disjoint closed neighborhoods
+			bool* const marks = calloc(vertices, sizeof(bool));
+			for (size_t i = 0; i < sr2.count; ++i) {
+				const scc_PointIndex s = sr2.seeds[i];
+				assert_true(nng.tail_ptr[s] != nng.tail_ptr[s + 1]);
+				assert_false(marks[s]);
+				for (size_t a = nng.tail_ptr[s]; a < nng.tail_ptr[s + 1]; ++a) {
+					assert_false(marks[nng.head[a]]);
+					marks[nng.head[a]] = true;
+				}
+				marks[s] = true;
+			}
+			free(marks);
+			free(sr1.seeds);
+			free(sr2.seeds);
+		}
+
+		iscc_free_digraph(&nng);
+		iscc_free_digraph(&compressed_nng);
+	}
+}
+
+
 int main(void)
 {
 	if(!scc_ut_init_tests()) return 1;
@@ -264,6 +438,8 @@ int main(void)
 	const struct CMUnitTest test_cases[] = {
 		cmocka_unit_test(scc_ut_find_seeds),
 		cmocka_unit_test(scc_ut_find_seeds_withdiag),
+		cmocka_unit_test(scc_ut_find_seeds_parallel),
+		cmocka_unit_test(scc_ut_find_seeds_compressed),
 	};
 
 	return cmocka_run_group_tests_name("nng_findseeds.c", test_cases, NULL, NULL);
@@ -23,6 +23,7 @@
 #include <src/digraph_core.h>
 #include <src/digraph_operations.h>
 #include <src/digraph_debug.h>
+#include <src/bitset.h>
 #include <src/nng_findseeds.c>
 #include <src/scclust_types.h>
 #include "assert_digraph.h"
@@ -153,7 +154,7 @@ void scc_ut_findseeds_exclusion(void** state)
 	};
 	scc_PointIndex fp_seeds1[4] = {0, 4, 2, 7};
 
-	scc_ErrorCode ec1 = iscc_findseeds_exclusion(&nng1, false, &sr1);
+	scc_ErrorCode ec1 = iscc_findseeds_exclusion(&nng1, false, 1, &sr1);
 	assert_int_equal(ec1, SCC_ER_OK);
 	assert_int_equal(sr1.capacity, 10);
 	assert_int_equal(sr1.count, 4);
@@ -181,7 +182,70 @@ void scc_ut_findseeds_exclusion(void** state)
 	};
 	scc_PointIndex fp_seeds2[4] = {0, 2, 4, 9};
 
-	scc_ErrorCode ec2 = iscc_findseeds_exclusion(&nng2, true, &sr2);
+	scc_ErrorCode ec2 = iscc_findseeds_exclusion(&nng2, true, 1, &sr2);
+	assert_int_equal(ec2, SCC_ER_OK);
+	assert_int_equal(sr2.capacity, 10);
+	assert_int_equal(sr2.count, 4);
+	assert_non_null(sr2.seeds);
+	assert_memory_equal(sr2.seeds, fp_seeds2, 4 * sizeof(scc_PointIndex));
+
+	free(sr2.seeds);
+	iscc_free_digraph(&nng2);
+}
+
+
+void scc_ut_findseeds_exclusion_implicit(void** state)
+{
+	(void) state;
+
+	iscc_Digraph nng1;
+	iscc_digraph_from_string("...#....../"
+	                         "...#....../"
+	                         ".#......../"
+	                         ".#......../"
+	                         ".....#..../"
+	                         ".#......../"
+	                         "....#...../"
+	                         "......#.../"
+	                         "......#.../"
+	                         "......#.../",
+	                         &nng1);
+	iscc_SeedResult sr1 = {
+		.capacity = 10,
+		.count = 0,
+		.seeds = NULL,
+	};
+	scc_PointIndex fp_seeds1[4] = {0, 4, 2, 7};
+
+	scc_ErrorCode ec1 = iscc_findseeds_exclusion_implicit(&nng1, false, 1, &sr1);
+	assert_int_equal(ec1, SCC_ER_OK);
+	assert_int_equal(sr1.capacity, 10);
+	assert_int_equal(sr1.count, 4);
+	assert_non_null(sr1.seeds);
+	assert_memory_equal(sr1.seeds, fp_seeds1, 4 * sizeof(scc_PointIndex));
+	free(sr1.seeds);
+	iscc_free_digraph(&nng1);
+
+	iscc_Digraph nng2;
+	iscc_digraph_from_string("...#. ...../"
+	                         "...#. ...../"
+	                         ".#... ...../"
+	                         ".#... ...../"
+	                         "..... #..../"
+	                         ".#... ...../"
+	                         "....# ...../"
+	                         "..... .#.../"
+	                         "..... .#.../"
+	                         "..... .#.../",
+	                         &nng2);
+	iscc_SeedResult sr2 = {
+		.capacity = 10,
+		.count = 0,
+		.seeds = NULL,
+	};
+	scc_PointIndex fp_seeds2[4] = {0, 2, 4, 9};
+
+	scc_ErrorCode ec2 = iscc_findseeds_exclusion_implicit(&nng2, true, 1, &sr2);
 	assert_int_equal(ec2, SCC_ER_OK);
 	assert_int_equal(sr2.capacity, 10);
 	assert_int_equal(sr2.count, 4);
@@ -314,7 +378,7 @@ void scc_ut_findseeds_exclusion_withdiag(void** state)
 	};
 	scc_PointIndex fp_seeds1[4] = {0, 4, 2, 7};
 
-	scc_ErrorCode ec1 = iscc_findseeds_exclusion(&nng1, false, &sr1);
+	scc_ErrorCode ec1 = iscc_findseeds_exclusion(&nng1, false, 1, &sr1);
 	assert_int_equal(ec1, SCC_ER_OK);
 	assert_int_equal(sr1.capacity, 10);
 	assert_int_equal(sr1.count, 4);
@@ -342,7 +406,7 @@ void scc_ut_findseeds_exclusion_withdiag(void** state)
 	};
 	scc_PointIndex fp_seeds2[4] = {0, 2, 4, 9};
 
-	scc_ErrorCode ec2 = iscc_findseeds_exclusion(&nng2, true, &sr2);
+	scc_ErrorCode ec2 = iscc_findseeds_exclusion(&nng2, true, 1, &sr2);
 	assert_int_equal(ec2, SCC_ER_OK);
 	assert_int_equal(sr2.capacity, 10);
 	assert_int_equal(sr2.count, 4);
@@ -475,7 +539,7 @@ void scc_ut_findseeds_exclusion_caliper(void** state)
 	};
 	scc_PointIndex fp_seeds1[3] = {2, 8, 6};
 
-	scc_ErrorCode ec1 = iscc_findseeds_exclusion(&nng1, false, &sr1);
+	scc_ErrorCode ec1 = iscc_findseeds_exclusion(&nng1, false, 1, &sr1);
 	assert_int_equal(ec1, SCC_ER_OK);
 	assert_int_equal(sr1.capacity, 10);
 	assert_int_equal(sr1.count, 3);
@@ -503,7 +567,7 @@ void scc_ut_findseeds_exclusion_caliper(void** state)
 	};
 	scc_PointIndex fp_seeds2[3] = {2, 8, 6};
 
-	scc_ErrorCode ec2 = iscc_findseeds_exclusion(&nng2, true, &sr2);
+	scc_ErrorCode ec2 = iscc_findseeds_exclusion(&nng2, true, 1, &sr2);
 	assert_int_equal(ec2, SCC_ER_OK);
 	assert_int_equal(sr2.capacity, 10);
 	assert_int_equal(sr2.count, 3);
@@ -636,7 +700,7 @@ void scc_ut_findseeds_exclusion_caliper_withdiag(void** state)
 	};
 	scc_PointIndex fp_seeds1[3] = {2, 8, 6};
 
-	scc_ErrorCode ec1 = iscc_findseeds_exclusion(&nng1, false, &sr1);
+	scc_ErrorCode ec1 = iscc_findseeds_exclusion(&nng1, false, 1, &sr1);
 	assert_int_equal(ec1, SCC_ER_OK);
 	assert_int_equal(sr1.capacity, 10);
 	assert_int_equal(sr1.count, 3);
@@ -664,7 +728,7 @@ void scc_ut_findseeds_exclusion_caliper_withdiag(void** state)
 	};
 	scc_PointIndex fp_seeds2[3] = {2, 8, 6};
 
-	scc_ErrorCode ec2 = iscc_findseeds_exclusion(&nng2, true, &sr2);
+	scc_ErrorCode ec2 = iscc_findseeds_exclusion(&nng2, true, 1, &sr2);
 	assert_int_equal(ec2, SCC_ER_OK);
 	assert_int_equal(sr2.capacity, 10);
 	assert_int_equal(sr2.count, 3);
@@ -797,7 +861,7 @@ void scc_ut_findseeds_exclusion_caliper_selfpointing_withdiag(void** state)
 	};
 	scc_PointIndex fp_seeds1[4] = {0, 5, 8, 6};
 
-	scc_ErrorCode ec1 = iscc_findseeds_exclusion(&nng1, false, &sr1);
+	scc_ErrorCode ec1 = iscc_findseeds_exclusion(&nng1, false, 1, &sr1);
 	assert_int_equal(ec1, SCC_ER_OK);
 	assert_int_equal(sr1.capacity, 10);
 	assert_int_equal(sr1.count, 4);
@@ -825,7 +889,7 @@ void scc_ut_findseeds_exclusion_caliper_selfpointing_withdiag(void** state)
 	};
 	scc_PointIndex fp_seeds2[4] = {0, 5, 8, 6};
 
-	scc_ErrorCode ec2 = iscc_findseeds_exclusion(&nng2, true, &sr2);
+	scc_ErrorCode ec2 = iscc_findseeds_exclusion(&nng2, true, 1, &sr2);
 	assert_int_equal(ec2, SCC_ER_OK);
 	assert_int_equal(sr2.capacity, 10);
 	assert_int_equal(sr2.count, 4);
@@ -882,7 +946,7 @@ void scc_ut_fs_exclusion_graph(void** state)
 	                         ".........#..###.#./",
 	                         &exg);
 	iscc_Digraph exclusion_graph;
-	scc_ErrorCode ec1 = iscc_fs_exclusion_graph(&nng, 0, NULL, &exclusion_graph);
+	scc_ErrorCode ec1 = iscc_fs_exclusion_graph(&nng, 0, NULL, 1, &exclusion_graph);
 	assert_int_equal(ec1, SCC_ER_OK);
 	assert_equal_digraph(&exg, &exclusion_graph);
 	iscc_free_digraph(&nng);
@@ -915,7 +979,7 @@ void scc_ut_fs_exclusion_graph(void** state)
 	                         "..#.. ..##./",
 	                         &exg2);
 	iscc_Digraph exclusion_graph2;
-	scc_ErrorCode ec2 = iscc_fs_exclusion_graph(&nng2, 0, NULL, &exclusion_graph2);
+	scc_ErrorCode ec2 = iscc_fs_exclusion_graph(&nng2, 0, NULL, 1, &exclusion_graph2);
 	assert_int_equal(ec2, SCC_ER_OK);
 	assert_equal_digraph(&exg2, &exclusion_graph2);
 	iscc_free_digraph(&nng2);
@@ -963,7 +1027,7 @@ void scc_ut_fs_exclusion_graph(void** state)
 	                         ".........#..###.#./",
 	                         &exg3);
 	iscc_Digraph exclusion_graph3;
-	scc_ErrorCode ec3 = iscc_fs_exclusion_graph(&nng3, 0, NULL, &exclusion_graph3);
+	scc_ErrorCode ec3 = iscc_fs_exclusion_graph(&nng3, 0, NULL, 1, &exclusion_graph3);
 	assert_int_equal(ec3, SCC_ER_OK);
 	assert_equal_digraph(&exg3, &exclusion_graph3);
 	iscc_free_digraph(&nng3);
@@ -996,7 +1060,7 @@ void scc_ut_fs_exclusion_graph(void** state)
 	                         "..#.. ..##./",
 	                         &exg4);
 	iscc_Digraph exclusion_graph4;
-	scc_ErrorCode ec4 = iscc_fs_exclusion_graph(&nng4, 0, NULL, &exclusion_graph4);
+	scc_ErrorCode ec4 = iscc_fs_exclusion_graph(&nng4, 0, NULL, 1, &exclusion_graph4);
 	assert_int_equal(ec4, SCC_ER_OK);
 	assert_equal_digraph(&exg4, &exclusion_graph4);
 	iscc_free_digraph(&nng4);
@@ -1046,7 +1110,7 @@ void scc_ut_fs_exclusion_graph(void** state)
 	                         "................../",
 	                         &exg5);
 	iscc_Digraph exclusion_graph5;
-	scc_ErrorCode ec5 = iscc_fs_exclusion_graph(&nng5, 9, keep_vertex5, &exclusion_graph5);
+	scc_ErrorCode ec5 = iscc_fs_exclusion_graph(&nng5, 9, keep_vertex5, 1, &exclusion_graph5);
 	assert_int_equal(ec5, SCC_ER_OK);
 	assert_equal_digraph(&exg5, &exclusion_graph5);
 	iscc_free_digraph(&nng5);
@@ -1080,7 +1144,7 @@ void scc_ut_fs_exclusion_graph(void** state)
 	                         "..... ...../",
 	                         &exg6);
 	iscc_Digraph exclusion_graph6;
-	scc_ErrorCode ec6 = iscc_fs_exclusion_graph(&nng6, 6, keep_vertex6, &exclusion_graph6);
+	scc_ErrorCode ec6 = iscc_fs_exclusion_graph(&nng6, 6, keep_vertex6, 1, &exclusion_graph6);
 	assert_int_equal(ec6, SCC_ER_OK);
 	assert_equal_digraph(&exg6, &exclusion_graph6);
 	iscc_free_digraph(&nng6);
@@ -1089,6 +1153,80 @@ void scc_ut_fs_exclusion_graph(void** state)
 }
 
 
+void scc_ut_fs_exclusion_row(void** state)
+{
+	(void) state;
+
+	iscc_Digraph nng;
+	iscc_digraph_from_string("##..#............./"
+	                         "#...#............./"
+	                         "....#..#........../"
+	                         "#...#............./"
+	                         ".#.#............../"
+	                         "..#.....#........./"
+	                         "...#.....#......../"
+	                         "......#.#........./"
+	                         ".....#.....#....../"
+	                         "..........#.....#./"
+	                         ".......#.....#..../"
+	                         "........#.#......./"
+	                         "................../"
+	                         "..............#..#/"
+	                         ".............#...#/"
+	                         ".........#..#...../"
+	                         ".............##.../"
+	                         "..............#.#./",
+	                         &nng);
+	const scc_PointIndex not_excluded[17] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 14, 15, 16, 17 };
+	iscc_Digraph exg;
+	assert_int_equal(iscc_fs_exclusion_graph(&nng, 17, not_excluded, 1, &exg), SCC_ER_OK);
+
+	iscc_Digraph nng_transpose;
+	assert_int_equal(iscc_digraph_transpose(&nng, 1, &nng_transpose), SCC_ER_OK);
+
+	iscc_DigraphRowReader nng_reader, transpose_reader;
+	assert_int_equal(iscc_init_row_reader(&nng, &nng_reader), SCC_ER_OK);
+	assert_int_equal(iscc_init_row_reader(&nng_transpose, &transpose_reader), SCC_ER_OK);
+
+	iscc_BitsetWord row_marks[1] = { 0 };
+	scc_PointIndex row[18];
+	for (scc_PointIndex v = 0; v < 18; ++v) {
+		const size_t len_row = iscc_fs_exclusion_row(v, &nng, &nng_transpose, &nng_reader, &transpose_reader, row_marks, row);
+		assert_int_equal(len_row, exg.tail_ptr[v + 1] - exg.tail_ptr[v]);
+		if (len_row > 0) {
+			assert_memory_equal(row, exg.head + exg.tail_ptr[v], len_row * sizeof(scc_PointIndex));
+		}
+		assert_int_equal(row_marks[0], 0);
+	}
+
+	// Compressed rows are sorted, so only the sets of vertices are the same
+	iscc_free_row_reader(&nng_reader);
+	iscc_free_row_reader(&transpose_reader);
+	assert_int_equal(iscc_digraph_compress(&nng), SCC_ER_OK);
+	assert_int_equal(iscc_digraph_compress(&nng_transpose), SCC_ER_OK);
+	assert_int_equal(iscc_init_row_reader(&nng, &nng_reader), SCC_ER_OK);
+	assert_int_equal(iscc_init_row_reader(&nng_transpose, &transpose_reader), SCC_ER_OK);
+
+	for (scc_PointIndex v = 0; v < 18; ++v) {
+		const size_t len_row = iscc_fs_exclusion_row(v, &nng, &nng_transpose, &nng_reader, &transpose_reader, row_marks, row);
+		assert_int_equal(len_row, exg.tail_ptr[v + 1] - exg.tail_ptr[v]);
+		for (size_t i = 0; i < len_row; ++i) {
+			iscc_bitset_set(row_marks, (size_t) row[i]);
+		}
+		for (iscc_ArcIndex a = exg.tail_ptr[v]; a < exg.tail_ptr[v + 1]; ++a) {
+			assert_true(iscc_bitset_test(row_marks, (size_t) exg.head[a]));
+		}
+		row_marks[0] = 0;
+	}
+
+	iscc_free_row_reader(&nng_reader);
+	iscc_free_row_reader(&transpose_reader);
+	iscc_free_digraph(&nng);
+	iscc_free_digraph(&exg);
+	iscc_free_digraph(&nng_transpose);
+}
+
+
 void scc_ut_fs_add_seed(void** state)
 {
 	(void) state;
@@ -1212,6 +1350,38 @@ void scc_ut_fs_add_seed(void** state)
 }
 
 
+static void scc_ut_assert_marks(const iscc_BitsetWord marks[const],
+                                const bool ref_marks[const static 7])
+{
+	for (size_t i = 0; i < 7; ++i) {
+		assert_int_equal(iscc_bitset_test(marks, i), ref_marks[i]);
+	}
+	assert_int_equal(marks[0] >> 7, 0);
+}
+
+
+static bool scc_ut_check_neighbors_marks(const scc_PointIndex v,
+                                         const iscc_Digraph* const nng,
+                                         const iscc_BitsetWord marks[const])
+{
+	return iscc_fs_check_neighbors_marks(v,
+	                                     nng->head + nng->tail_ptr[v],
+	                                     nng->tail_ptr[v + 1] - nng->tail_ptr[v],
+	                                     marks);
+}
+
+
+static void scc_ut_mark_seed_neighbors(const scc_PointIndex s,
+                                       const iscc_Digraph* const nng,
+                                       iscc_BitsetWord marks[const])
+{
+	iscc_fs_mark_seed_neighbors(s,
+	                            nng->head + nng->tail_ptr[s],
+	                            nng->tail_ptr[s + 1] - nng->tail_ptr[s],
+	                            marks);
+}
+
+
 void scc_ut_fs_check_neighbors_marks(void** state)
 {
 	(void) state;
@@ -1226,15 +1396,17 @@ void scc_ut_fs_check_neighbors_marks(void** state)
 	                         "......./",
 	                         &nng);
 
-	bool marks[7] = {true, false, false, false, true, false, false};
+	iscc_BitsetWord marks[1] = { 0 };
+	iscc_bitset_set(marks, 0);
+	iscc_bitset_set(marks, 4);
 
-	assert_false(iscc_fs_check_neighbors_marks(0, &nng, marks));
-	assert_false(iscc_fs_check_neighbors_marks(1, &nng, marks));
-	assert_false(iscc_fs_check_neighbors_marks(2, &nng, marks));
-	assert_true(iscc_fs_check_neighbors_marks(3, &nng, marks));
-	assert_false(iscc_fs_check_neighbors_marks(4, &nng, marks));
-	assert_true(iscc_fs_check_neighbors_marks(5, &nng, marks));
-	assert_false(iscc_fs_check_neighbors_marks(6, &nng, marks));
+	assert_false(scc_ut_check_neighbors_marks(0, &nng, marks));
+	assert_false(scc_ut_check_neighbors_marks(1, &nng, marks));
+	assert_false(scc_ut_check_neighbors_marks(2, &nng, marks));
+	assert_true(scc_ut_check_neighbors_marks(3, &nng, marks));
+	assert_false(scc_ut_check_neighbors_marks(4, &nng, marks));
+	assert_true(scc_ut_check_neighbors_marks(5, &nng, marks));
+	assert_false(scc_ut_check_neighbors_marks(6, &nng, marks));
 
 	iscc_free_digraph(&nng);
 }
@@ -1254,15 +1426,17 @@ void scc_ut_fs_check_neighbors_marks_withdiag(void** state)
 	                         "......./",
 	                         &nng);
 
-	bool marks[7] = {true, false, false, false, true, false, false};
+	iscc_BitsetWord marks[1] = { 0 };
+	iscc_bitset_set(marks, 0);
+	iscc_bitset_set(marks, 4);
 
-	assert_false(iscc_fs_check_neighbors_marks(0, &nng, marks));
-	assert_false(iscc_fs_check_neighbors_marks(1, &nng, marks));
-	assert_false(iscc_fs_check_neighbors_marks(2, &nng, marks));
-	assert_true(iscc_fs_check_neighbors_marks(3, &nng, marks));
-	assert_false(iscc_fs_check_neighbors_marks(4, &nng, marks));
-	assert_true(iscc_fs_check_neighbors_marks(5, &nng, marks));
-	assert_false(iscc_fs_check_neighbors_marks(6, &nng, marks));
+	assert_false(scc_ut_check_neighbors_marks(0, &nng, marks));
+	assert_false(scc_ut_check_neighbors_marks(1, &nng, marks));
+	assert_false(scc_ut_check_neighbors_marks(2, &nng, marks));
+	assert_true(scc_ut_check_neighbors_marks(3, &nng, marks));
+	assert_false(scc_ut_check_neighbors_marks(4, &nng, marks));
+	assert_true(scc_ut_check_neighbors_marks(5, &nng, marks));
+	assert_false(scc_ut_check_neighbors_marks(6, &nng, marks));
 
 	iscc_free_digraph(&nng);
 }
@@ -1282,41 +1456,51 @@ void scc_ut_fs_mark_seed_neighbors(void** state)
 	                         "......./",
 	                         &nng);
 
-	bool stc_marks[7] = {false, false, false, false, false, false, false};
+	iscc_BitsetWord stc_marks[1] = { 0 };
 
-	iscc_fs_mark_seed_neighbors(0, &nng, stc_marks);
+	scc_ut_mark_seed_neighbors(0, &nng, stc_marks);
 	bool ref_marks0[7] = {true, false, true, true, false, false, true};
-	assert_memory_equal(stc_marks, ref_marks0, 7 * sizeof(bool));
+	scc_ut_assert_marks(stc_marks, ref_marks0);
 
-	stc_marks[0] = stc_marks[2] = stc_marks[3] = stc_marks[6] = false;
+	iscc_bitset_clear(stc_marks, 0);
+	iscc_bitset_clear(stc_marks, 2);
+	iscc_bitset_clear(stc_marks, 3);
+	iscc_bitset_clear(stc_marks, 6);
 
-	iscc_fs_mark_seed_neighbors(1, &nng, stc_marks);
+	scc_ut_mark_seed_neighbors(1, &nng, stc_marks);
 	bool ref_marks1[7] = {false, true, true, false, true, false, true};
-	assert_memory_equal(stc_marks, ref_marks1, 7 * sizeof(bool));
+	scc_ut_assert_marks(stc_marks, ref_marks1);
 
-	stc_marks[2] = stc_marks[4] = stc_marks[6] = false;
+	iscc_bitset_clear(stc_marks, 2);
+	iscc_bitset_clear(stc_marks, 4);
+	iscc_bitset_clear(stc_marks, 6);
 
-	iscc_fs_mark_seed_neighbors(2, &nng, stc_marks);
+	scc_ut_mark_seed_neighbors(2, &nng, stc_marks);
 	bool ref_marks2[7] = {true, true, true, false, true, false, true};
-	assert_memory_equal(stc_marks, ref_marks2, 7 * sizeof(bool));
+	scc_ut_assert_marks(stc_marks, ref_marks2);
 
-	stc_marks[0] = stc_marks[1] = stc_marks[2] = stc_marks[4] = stc_marks[6] = false;
+	iscc_bitset_clear(stc_marks, 0);
+	iscc_bitset_clear(stc_marks, 1);
+	iscc_bitset_clear(stc_marks, 2);
+	iscc_bitset_clear(stc_marks, 4);
+	iscc_bitset_clear(stc_marks, 6);
 
-	iscc_fs_mark_seed_neighbors(5, &nng, stc_marks);
+	scc_ut_mark_seed_neighbors(5, &nng, stc_marks);
 	bool ref_marks5[7] = {false, false, true, false, false, true, false};
-	assert_memory_equal(stc_marks, ref_marks5, 7 * sizeof(bool));
+	scc_ut_assert_marks(stc_marks, ref_marks5);
 
-	stc_marks[2] = stc_marks[5] = false;
+	iscc_bitset_clear(stc_marks, 2);
+	iscc_bitset_clear(stc_marks, 5);
 
-	iscc_fs_mark_seed_neighbors(3, &nng, stc_marks);
+	scc_ut_mark_seed_neighbors(3, &nng, stc_marks);
 	bool ref_marks3[7] = {false, false, true, true, false, true, true};
-	assert_memory_equal(stc_marks, ref_marks3, 7 * sizeof(bool));
+	scc_ut_assert_marks(stc_marks, ref_marks3);
 
-	stc_marks[6] = false;
+	iscc_bitset_clear(stc_marks, 6);
 
-	iscc_fs_mark_seed_neighbors(6, &nng, stc_marks);
+	scc_ut_mark_seed_neighbors(6, &nng, stc_marks);
 	bool ref_marks6[7] = {false, false, true, true, false, true, true};
-	assert_memory_equal(stc_marks, ref_marks6, 7 * sizeof(bool));
+	scc_ut_assert_marks(stc_marks, ref_marks6);
 
 	iscc_free_digraph(&nng);
 }
@@ -1336,41 +1520,51 @@ void scc_ut_fs_mark_seed_neighbors_withdiag(void** state)
 	                         "......#/",
 	                         &nng);
 
-	bool stc_marks[7] = {false, false, false, false, false, false, false};
+	iscc_BitsetWord stc_marks[1] = { 0 };
 
-	iscc_fs_mark_seed_neighbors(0, &nng, stc_marks);
+	scc_ut_mark_seed_neighbors(0, &nng, stc_marks);
 	bool ref_marks0[7] = {true, false, true, true, false, false, true};
-	assert_memory_equal(stc_marks, ref_marks0, 7 * sizeof(bool));
+	scc_ut_assert_marks(stc_marks, ref_marks0);
 
-	stc_marks[0] = stc_marks[2] = stc_marks[3] = stc_marks[6] = false;
+	iscc_bitset_clear(stc_marks, 0);
+	iscc_bitset_clear(stc_marks, 2);
+	iscc_bitset_clear(stc_marks, 3);
+	iscc_bitset_clear(stc_marks, 6);
 
-	iscc_fs_mark_seed_neighbors(1, &nng, stc_marks);
+	scc_ut_mark_seed_neighbors(1, &nng, stc_marks);
 	bool ref_marks1[7] = {false, true, true, false, true, false, true};
-	assert_memory_equal(stc_marks, ref_marks1, 7 * sizeof(bool));
+	scc_ut_assert_marks(stc_marks, ref_marks1);
 
-	stc_marks[2] = stc_marks[4] = stc_marks[6] = false;
+	iscc_bitset_clear(stc_marks, 2);
+	iscc_bitset_clear(stc_marks, 4);
+	iscc_bitset_clear(stc_marks, 6);
 
-	iscc_fs_mark_seed_neighbors(2, &nng, stc_marks);
+	scc_ut_mark_seed_neighbors(2, &nng, stc_marks);
 	bool ref_marks2[7] = {true, true, true, false, true, false, true};
-	assert_memory_equal(stc_marks, ref_marks2, 7 * sizeof(bool));
+	scc_ut_assert_marks(stc_marks, ref_marks2);
 
-	stc_marks[0] = stc_marks[1] = stc_marks[2] = stc_marks[4] = stc_marks[6] = false;
+	iscc_bitset_clear(stc_marks, 0);
+	iscc_bitset_clear(stc_marks, 1);
+	iscc_bitset_clear(stc_marks, 2);
+	iscc_bitset_clear(stc_marks, 4);
+	iscc_bitset_clear(stc_marks, 6);
 
-	iscc_fs_mark_seed_neighbors(5, &nng, stc_marks);
+	scc_ut_mark_seed_neighbors(5, &nng, stc_marks);
 	bool ref_marks5[7] = {false, false, true, false, false, true, false};
-	assert_memory_equal(stc_marks, ref_marks5, 7 * sizeof(bool));
+	scc_ut_assert_marks(stc_marks, ref_marks5);
 
-	stc_marks[2] = stc_marks[5] = false;
+	iscc_bitset_clear(stc_marks, 2);
+	iscc_bitset_clear(stc_marks, 5);
 
-	iscc_fs_mark_seed_neighbors(3, &nng, stc_marks);
+	scc_ut_mark_seed_neighbors(3, &nng, stc_marks);
 	bool ref_marks3[7] = {false, false, true, true, false, true, true};
-	assert_memory_equal(stc_marks, ref_marks3, 7 * sizeof(bool));
+	scc_ut_assert_marks(stc_marks, ref_marks3);
 
-	stc_marks[6] = false;
+	iscc_bitset_clear(stc_marks, 6);
 
-	iscc_fs_mark_seed_neighbors(6, &nng, stc_marks);
+	scc_ut_mark_seed_neighbors(6, &nng, stc_marks);
 	bool ref_marks6[7] = {false, false, true, true, false, true, true};
-	assert_memory_equal(stc_marks, ref_marks6, 7 * sizeof(bool));
+	scc_ut_assert_marks(stc_marks, ref_marks6);
 
 	iscc_free_digraph(&nng);
 }
@@ -1664,6 +1858,7 @@ int main(void)
 		cmocka_unit_test(scc_ut_findseeds_lexical),
 		cmocka_unit_test(scc_ut_findseeds_inwards),
 		cmocka_unit_test(scc_ut_findseeds_exclusion),
+		cmocka_unit_test(scc_ut_findseeds_exclusion_implicit),
 		cmocka_unit_test(scc_ut_findseeds_lexical_withdiag),
 		cmocka_unit_test(scc_ut_findseeds_inwards_withdiag),
 		cmocka_unit_test(scc_ut_findseeds_exclusion_withdiag),
@@ -1677,6 +1872,7 @@ int main(void)
 		cmocka_unit_test(scc_ut_findseeds_inwards_caliper_selfpointing_withdiag),
 		cmocka_unit_test(scc_ut_findseeds_exclusion_caliper_selfpointing_withdiag),
 		cmocka_unit_test(scc_ut_fs_exclusion_graph),
+		cmocka_unit_test(scc_ut_fs_exclusion_row),
 		cmocka_unit_test(scc_ut_fs_add_seed),
 		cmocka_unit_test(scc_ut_fs_check_neighbors_marks),
 		cmocka_unit_test(scc_ut_fs_check_neighbors_marks_withdiag),
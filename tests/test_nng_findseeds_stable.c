@@ -110,7 +110,7 @@ void scc_ut_find_seeds_stable(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec1 = iscc_find_seeds(&nng, SCC_SM_LEXICAL, &sr1);
+	scc_ErrorCode ec1 = iscc_find_seeds(&nng, SCC_SM_LEXICAL, 1, &sr1);
 	assert_int_equal(ec1, SCC_ER_OK);
 	assert_int_equal(sr1.count, 5);
 	assert_int_equal(sr1.capacity, sr1.count);
@@ -123,7 +123,7 @@ void scc_ut_find_seeds_stable(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec2 = iscc_find_seeds(&nng, SCC_SM_INWARDS_ORDER, &sr2);
+	scc_ErrorCode ec2 = iscc_find_seeds(&nng, SCC_SM_INWARDS_ORDER, 1, &sr2);
 	assert_int_equal(ec2, SCC_ER_OK);
 	assert_int_equal(sr2.count, 5);
 	assert_int_equal(sr2.capacity, sr2.count);
@@ -136,7 +136,7 @@ void scc_ut_find_seeds_stable(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec3alt = iscc_find_seeds(&nng, SCC_SM_INWARDS_UPDATING, &sr3alt);
+	scc_ErrorCode ec3alt = iscc_find_seeds(&nng, SCC_SM_INWARDS_UPDATING, 1, &sr3alt);
 	assert_int_equal(ec3alt, SCC_ER_OK);
 	assert_int_equal(sr3alt.count, 5);
 	assert_int_equal(sr3alt.capacity, sr3alt.count);
@@ -149,7 +149,7 @@ void scc_ut_find_seeds_stable(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec4 = iscc_find_seeds(&nng, SCC_SM_EXCLUSION_ORDER, &sr4);
+	scc_ErrorCode ec4 = iscc_find_seeds(&nng, SCC_SM_EXCLUSION_ORDER, 1, &sr4);
 	assert_int_equal(ec4, SCC_ER_OK);
 	assert_int_equal(sr4.count, 4);
 	assert_int_equal(sr4.capacity, sr4.count);
@@ -162,7 +162,7 @@ void scc_ut_find_seeds_stable(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec5 = iscc_find_seeds(&nng, SCC_SM_EXCLUSION_UPDATING, &sr5);
+	scc_ErrorCode ec5 = iscc_find_seeds(&nng, SCC_SM_EXCLUSION_UPDATING, 1, &sr5);
 	assert_int_equal(ec5, SCC_ER_OK);
 	assert_int_equal(sr5.count, 5);
 	assert_int_equal(sr5.capacity, sr5.count);
@@ -209,7 +209,7 @@ void scc_ut_find_seeds_stable_withdiag(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec1 = iscc_find_seeds(&nng, SCC_SM_LEXICAL, &sr1);
+	scc_ErrorCode ec1 = iscc_find_seeds(&nng, SCC_SM_LEXICAL, 1, &sr1);
 	assert_int_equal(ec1, SCC_ER_OK);
 	assert_int_equal(sr1.count, 5);
 	assert_int_equal(sr1.capacity, sr1.count);
@@ -222,7 +222,7 @@ void scc_ut_find_seeds_stable_withdiag(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec2 = iscc_find_seeds(&nng, SCC_SM_INWARDS_ORDER, &sr2);
+	scc_ErrorCode ec2 = iscc_find_seeds(&nng, SCC_SM_INWARDS_ORDER, 1, &sr2);
 	assert_int_equal(ec2, SCC_ER_OK);
 	assert_int_equal(sr2.count, 5);
 	assert_int_equal(sr2.capacity, sr2.count);
@@ -235,7 +235,7 @@ void scc_ut_find_seeds_stable_withdiag(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec3alt = iscc_find_seeds(&nng, SCC_SM_INWARDS_UPDATING, &sr3alt);
+	scc_ErrorCode ec3alt = iscc_find_seeds(&nng, SCC_SM_INWARDS_UPDATING, 1, &sr3alt);
 	assert_int_equal(ec3alt, SCC_ER_OK);
 	assert_int_equal(sr3alt.count, 5);
 	assert_int_equal(sr3alt.capacity, sr3alt.count);
@@ -248,7 +248,7 @@ void scc_ut_find_seeds_stable_withdiag(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec4 = iscc_find_seeds(&nng, SCC_SM_EXCLUSION_ORDER, &sr4);
+	scc_ErrorCode ec4 = iscc_find_seeds(&nng, SCC_SM_EXCLUSION_ORDER, 1, &sr4);
 	assert_int_equal(ec4, SCC_ER_OK);
 	assert_int_equal(sr4.count, 4);
 	assert_int_equal(sr4.capacity, sr4.count);
@@ -261,7 +261,7 @@ void scc_ut_find_seeds_stable_withdiag(void** state)
 		.count = 0,
 		.seeds = NULL,
 	};
-	scc_ErrorCode ec5 = iscc_find_seeds(&nng, SCC_SM_EXCLUSION_UPDATING, &sr5);
+	scc_ErrorCode ec5 = iscc_find_seeds(&nng, SCC_SM_EXCLUSION_UPDATING, 1, &sr5);
 	assert_int_equal(ec5, SCC_ER_OK);
 	assert_int_equal(sr5.count, 5);
 	assert_int_equal(sr5.capacity, sr5.count);
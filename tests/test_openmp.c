@@ -0,0 +1,246 @@
+/* =============================================================================
+ * scclust -- A C library for size-constrained clustering
+ * https://github.com/fsavje/scclust
+ *
+ * Copyright (C) 2015-2017  Fredrik Savje -- http://fredriksavje.com
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see http://www.gnu.org/licenses/
+ * ========================================================================== */
+
+// Compares serial and threaded runs. The tests pass trivially unless built
+// with `make OPENMP=Y` (or `./run_tests.sh -o`).
+
+#include "init_test.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <include/scclust.h>
+#include <src/clustering_struct.h>
+#include <src/digraph_debug.h>
+#include <src/nng_core.h>
+#include "assert_digraph.h"
+#include "rand.h"
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif // ifdef _OPENMP
+
+static const uint32_t SCC_UT_NUM_THREADS = 4;
+static const uint32_t SCC_UT_DATA_DIMENSION = 3;
+
+
+static scc_DataSet* scc_ut_random_data_set(const size_t num_data_points,
+                                           double** const out_data_matrix)
+{
+	const size_t len_data_matrix = SCC_UT_DATA_DIMENSION * num_data_points;
+	*out_data_matrix = malloc(sizeof(double[len_data_matrix]));
+	scc_rand_double_array(0, 100, len_data_matrix, *out_data_matrix);
+	scc_DataSet* data_set;
+	assert_int_equal(scc_init_data_set(num_data_points, SCC_UT_DATA_DIMENSION, len_data_matrix, *out_data_matrix, &data_set), SCC_ER_OK);
+	return data_set;
+}
+
+
+static void scc_ut_assert_same_sc_clustering(void* const data_set,
+                                             const size_t num_data_points,
+                                             scc_ClusterOptions options)
+{
+	scc_Clustering* cl_serial;
+	scc_Clustering* cl_threaded;
+	assert_int_equal(scc_init_empty_clustering(num_data_points, NULL, &cl_serial), SCC_ER_OK);
+	assert_int_equal(scc_init_empty_clustering(num_data_points, NULL, &cl_threaded), SCC_ER_OK);
+
+	options.num_threads = 1;
+	assert_int_equal(scc_sc_clustering(data_set, &options, cl_serial), SCC_ER_OK);
+	options.num_threads = SCC_UT_NUM_THREADS;
+	assert_int_equal(scc_sc_clustering(data_set, &options, cl_threaded), SCC_ER_OK);
+
+	assert_int_equal(cl_serial->num_clusters, cl_threaded->num_clusters);
+	assert_memory_equal(cl_serial->cluster_label, cl_threaded->cluster_label, num_data_points * sizeof(scc_Clabel));
+
+	scc_free_clustering(&cl_serial);
+	scc_free_clustering(&cl_threaded);
+}
+
+
+void scc_ut_openmp_nng(void** state)
+{
+	(void) state;
+
+	srand(123456789);
+	const size_t num_data_points = 5000;
+	double* data_matrix;
+	scc_DataSet* data_set = scc_ut_random_data_set(num_data_points, &data_matrix);
+
+	scc_TypeLabel* const type_labels = malloc(sizeof(scc_TypeLabel[num_data_points]));
+	scc_PointIndex* const primary_data_points = malloc(sizeof(scc_PointIndex[num_data_points]));
+	size_t len_primary_data_points = 0;
+	for (size_t i = 0; i < num_data_points; ++i) {
+		type_labels[i] = (scc_TypeLabel) (rand() % 3);
+		if (rand() % 3 != 0) {
+			primary_data_points[len_primary_data_points] = (scc_PointIndex) i;
+			++len_primary_data_points;
+		}
+	}
+	const uint32_t type_constraints[3] = { 1, 0, 2 };
+
+	for (int radius_constraint = 0; radius_constraint < 2; ++radius_constraint) {
+		iscc_Digraph nng_serial;
+		iscc_Digraph nng_threaded;
+
+		assert_int_equal(iscc_get_nng_with_size_constraint(data_set, num_data_points, 5,
+		                                                   0, NULL, (radius_constraint == 1), 6.0,
+		                                                   1, NULL, &nng_serial), SCC_ER_OK);
+		assert_int_equal(iscc_get_nng_with_size_constraint(data_set, num_data_points, 5,
+		                                                   0, NULL, (radius_constraint == 1), 6.0,
+		                                                   SCC_UT_NUM_THREADS, NULL, &nng_threaded), SCC_ER_OK);
+		assert_identical_digraph(&nng_serial, &nng_threaded);
+		iscc_free_digraph(&nng_serial);
+		iscc_free_digraph(&nng_threaded);
+
+		assert_int_equal(iscc_get_nng_with_size_constraint(data_set, num_data_points, 5,
+		                                                   len_primary_data_points, primary_data_points,
+		                                                   (radius_constraint == 1), 6.0,
+		                                                   1, NULL, &nng_serial), SCC_ER_OK);
+		assert_int_equal(iscc_get_nng_with_size_constraint(data_set, num_data_points, 5,
+		                                                   len_primary_data_points, primary_data_points,
+		                                                   (radius_constraint == 1), 6.0,
+		                                                   SCC_UT_NUM_THREADS, NULL, &nng_threaded), SCC_ER_OK);
+		assert_identical_digraph(&nng_serial, &nng_threaded);
+		iscc_free_digraph(&nng_serial);
+		iscc_free_digraph(&nng_threaded);
+
+		assert_int_equal(iscc_get_nng_with_type_constraint(data_set, num_data_points, 5,
+		                                                   3, type_constraints, type_labels,
+		                                                   0, NULL, (radius_constraint == 1), 8.0,
+		                                                   1, NULL, &nng_serial), SCC_ER_OK);
+		assert_int_equal(iscc_get_nng_with_type_constraint(data_set, num_data_points, 5,
+		                                                   3, type_constraints, type_labels,
+		                                                   0, NULL, (radius_constraint == 1), 8.0,
+		                                                   SCC_UT_NUM_THREADS, NULL, &nng_threaded), SCC_ER_OK);
+		assert_identical_digraph(&nng_serial, &nng_threaded);
+		iscc_free_digraph(&nng_serial);
+		iscc_free_digraph(&nng_threaded);
+	}
+
+	free(type_labels);
+	free(primary_data_points);
+	scc_free_data_set(&data_set);
+	free(data_matrix);
+}
+
+
+void scc_ut_openmp_sc_clustering(void** state)
+{
+	(void) state;
+
+	srand(123456789);
+	const size_t num_data_points = 20000;
+	double* data_matrix;
+	scc_DataSet* data_set = scc_ut_random_data_set(num_data_points, &data_matrix);
+
+	scc_TypeLabel* const type_labels = malloc(sizeof(scc_TypeLabel[num_data_points]));
+	for (size_t i = 0; i < num_data_points; ++i) {
+		type_labels[i] = (scc_TypeLabel) (rand() % 3);
+	}
+	const uint32_t type_constraints[3] = { 1, 1, 1 };
+
+	// The parallel seed methods find seeds in rounds of maximal independent sets, and the
+	// exclusion methods build exclusion graphs with the parallel digraph operations
+	const scc_SeedMethod seed_methods[5] = {
+		SCC_SM_LEXICAL,
+		SCC_SM_EXCLUSION_ORDER,
+		SCC_SM_INWARDS_PARALLEL,
+		SCC_SM_EXCLUSION_PARALLEL,
+		SCC_SM_BATCHES,
+	};
+
+	for (size_t m = 0; m < 5; ++m) {
+		for (int use_types = 0; use_types < 2; ++use_types) {
+			if ((seed_methods[m] == SCC_SM_BATCHES) && (use_types == 1)) continue;
+			scc_ClusterOptions options = scc_get_default_options();
+			options.size_constraint = 4;
+			options.seed_method = seed_methods[m];
+			options.primary_unassigned_method = SCC_UM_CLOSEST_SEED;
+			if (use_types == 1) {
+				options.num_types = 3;
+				options.type_constraints = type_constraints;
+				options.len_type_labels = num_data_points;
+				options.type_labels = type_labels;
+			}
+			if (seed_methods[m] == SCC_SM_BATCHES) {
+				// Small batches so that several batches are searched ahead
+				options.primary_unassigned_method = SCC_UM_ANY_NEIGHBOR;
+				options.batch_size = 500;
+			}
+			scc_ut_assert_same_sc_clustering(data_set, num_data_points, options);
+		}
+	}
+
+	free(type_labels);
+	scc_free_data_set(&data_set);
+	free(data_matrix);
+}
+
+
+void scc_ut_openmp_hierarchical_clustering(void** state)
+{
+	(void) state;
+
+	// Clusters are only split in parallel tasks when there are at least
+	// twice `ISCC_HI_MIN_TASK_SIZE` (4096) data points
+	srand(123456789);
+	const size_t num_data_points = 12000;
+	double* data_matrix;
+	scc_DataSet* data_set = scc_ut_random_data_set(num_data_points, &data_matrix);
+
+	for (int batch_assign = 0; batch_assign < 2; ++batch_assign) {
+		scc_Clustering* cl_serial;
+		scc_Clustering* cl_threaded;
+		assert_int_equal(scc_init_empty_clustering(num_data_points, NULL, &cl_serial), SCC_ER_OK);
+		assert_int_equal(scc_init_empty_clustering(num_data_points, NULL, &cl_threaded), SCC_ER_OK);
+
+		#ifdef _OPENMP
+			omp_set_num_threads(1);
+		#endif // ifdef _OPENMP
+		assert_int_equal(scc_hierarchical_clustering(data_set, 3, (batch_assign == 1), cl_serial), SCC_ER_OK);
+		#ifdef _OPENMP
+			omp_set_num_threads((int) SCC_UT_NUM_THREADS);
+		#endif // ifdef _OPENMP
+		assert_int_equal(scc_hierarchical_clustering(data_set, 3, (batch_assign == 1), cl_threaded), SCC_ER_OK);
+
+		assert_int_equal(cl_serial->num_clusters, cl_threaded->num_clusters);
+		assert_memory_equal(cl_serial->cluster_label, cl_threaded->cluster_label, num_data_points * sizeof(scc_Clabel));
+
+		scc_free_clustering(&cl_serial);
+		scc_free_clustering(&cl_threaded);
+	}
+
+	scc_free_data_set(&data_set);
+	free(data_matrix);
+}
+
+
+int main(void)
+{
+	if(!scc_ut_init_tests()) return 1;
+
+	const struct CMUnitTest test_cases[] = {
+		cmocka_unit_test(scc_ut_openmp_nng),
+		cmocka_unit_test(scc_ut_openmp_sc_clustering),
+		cmocka_unit_test(scc_ut_openmp_hierarchical_clustering),
+	};
+
+	return cmocka_run_group_tests_name("openmp", test_cases, NULL, NULL);
+}